@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/1_structure.dir/examples/1_structure.cpp.o"
+  "CMakeFiles/1_structure.dir/examples/1_structure.cpp.o.d"
+  "bin/1_structure"
+  "bin/1_structure.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/1_structure.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
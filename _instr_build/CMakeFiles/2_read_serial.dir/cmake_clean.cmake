@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/2_read_serial.dir/examples/2_read_serial.cpp.o"
+  "CMakeFiles/2_read_serial.dir/examples/2_read_serial.cpp.o.d"
+  "bin/2_read_serial"
+  "bin/2_read_serial.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/2_read_serial.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
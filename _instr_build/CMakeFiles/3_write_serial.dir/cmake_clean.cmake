@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/3_write_serial.dir/examples/3_write_serial.cpp.o"
+  "CMakeFiles/3_write_serial.dir/examples/3_write_serial.cpp.o.d"
+  "bin/3_write_serial"
+  "bin/3_write_serial.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/3_write_serial.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
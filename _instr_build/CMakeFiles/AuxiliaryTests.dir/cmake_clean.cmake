@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/AuxiliaryTests.dir/test/AuxiliaryTest.cpp.o"
+  "CMakeFiles/AuxiliaryTests.dir/test/AuxiliaryTest.cpp.o.d"
+  "bin/AuxiliaryTests"
+  "bin/AuxiliaryTests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/AuxiliaryTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
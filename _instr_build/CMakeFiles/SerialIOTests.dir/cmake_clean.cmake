@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SerialIOTests.dir/test/SerialIOTest.cpp.o"
+  "CMakeFiles/SerialIOTests.dir/test/SerialIOTest.cpp.o.d"
+  "bin/SerialIOTests"
+  "bin/SerialIOTests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SerialIOTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
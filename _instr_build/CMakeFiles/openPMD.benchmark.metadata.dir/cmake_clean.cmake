@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/openPMD.benchmark.metadata.dir/benchmarks/metadata.cpp.o"
+  "CMakeFiles/openPMD.benchmark.metadata.dir/benchmarks/metadata.cpp.o.d"
+  "bin/openPMD.benchmark.metadata"
+  "bin/openPMD.benchmark.metadata.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/openPMD.benchmark.metadata.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
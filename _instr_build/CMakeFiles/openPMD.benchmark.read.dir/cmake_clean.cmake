@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/openPMD.benchmark.read.dir/benchmarks/read.cpp.o"
+  "CMakeFiles/openPMD.benchmark.read.dir/benchmarks/read.cpp.o.d"
+  "bin/openPMD.benchmark.read"
+  "bin/openPMD.benchmark.read.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/openPMD.benchmark.read.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
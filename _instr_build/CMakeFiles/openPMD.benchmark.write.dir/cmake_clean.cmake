@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/openPMD.benchmark.write.dir/benchmarks/write.cpp.o"
+  "CMakeFiles/openPMD.benchmark.write.dir/benchmarks/write.cpp.o.d"
+  "bin/openPMD.benchmark.write"
+  "bin/openPMD.benchmark.write.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/openPMD.benchmark.write.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,45 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/Dataset.cpp" "CMakeFiles/openPMD.dir/src/Dataset.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/Dataset.cpp.o.d"
+  "/root/repo/src/Datatype.cpp" "CMakeFiles/openPMD.dir/src/Datatype.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/Datatype.cpp.o.d"
+  "/root/repo/src/Decomposition.cpp" "CMakeFiles/openPMD.dir/src/Decomposition.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/Decomposition.cpp.o.d"
+  "/root/repo/src/IO/ADIOS/ADIOS1IOHandler.cpp" "CMakeFiles/openPMD.dir/src/IO/ADIOS/ADIOS1IOHandler.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IO/ADIOS/ADIOS1IOHandler.cpp.o.d"
+  "/root/repo/src/IO/ADIOS/ADIOS2IOHandler.cpp" "CMakeFiles/openPMD.dir/src/IO/ADIOS/ADIOS2IOHandler.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IO/ADIOS/ADIOS2IOHandler.cpp.o.d"
+  "/root/repo/src/IO/ADIOS/ParallelADIOS1IOHandler.cpp" "CMakeFiles/openPMD.dir/src/IO/ADIOS/ParallelADIOS1IOHandler.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IO/ADIOS/ParallelADIOS1IOHandler.cpp.o.d"
+  "/root/repo/src/IO/AbstractIOHandler.cpp" "CMakeFiles/openPMD.dir/src/IO/AbstractIOHandler.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IO/AbstractIOHandler.cpp.o.d"
+  "/root/repo/src/IO/DrainQueue.cpp" "CMakeFiles/openPMD.dir/src/IO/DrainQueue.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IO/DrainQueue.cpp.o.d"
+  "/root/repo/src/IO/HDF5/HDF5IOHandler.cpp" "CMakeFiles/openPMD.dir/src/IO/HDF5/HDF5IOHandler.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IO/HDF5/HDF5IOHandler.cpp.o.d"
+  "/root/repo/src/IO/HDF5/ParallelHDF5IOHandler.cpp" "CMakeFiles/openPMD.dir/src/IO/HDF5/ParallelHDF5IOHandler.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IO/HDF5/ParallelHDF5IOHandler.cpp.o.d"
+  "/root/repo/src/IO/IOStatistics.cpp" "CMakeFiles/openPMD.dir/src/IO/IOStatistics.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IO/IOStatistics.cpp.o.d"
+  "/root/repo/src/IO/TaskQueue.cpp" "CMakeFiles/openPMD.dir/src/IO/TaskQueue.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IO/TaskQueue.cpp.o.d"
+  "/root/repo/src/Iteration.cpp" "CMakeFiles/openPMD.dir/src/Iteration.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/Iteration.cpp.o.d"
+  "/root/repo/src/IterationEncoding.cpp" "CMakeFiles/openPMD.dir/src/IterationEncoding.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/IterationEncoding.cpp.o.d"
+  "/root/repo/src/Mesh.cpp" "CMakeFiles/openPMD.dir/src/Mesh.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/Mesh.cpp.o.d"
+  "/root/repo/src/ParticlePatches.cpp" "CMakeFiles/openPMD.dir/src/ParticlePatches.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/ParticlePatches.cpp.o.d"
+  "/root/repo/src/ParticleSpecies.cpp" "CMakeFiles/openPMD.dir/src/ParticleSpecies.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/ParticleSpecies.cpp.o.d"
+  "/root/repo/src/Record.cpp" "CMakeFiles/openPMD.dir/src/Record.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/Record.cpp.o.d"
+  "/root/repo/src/RecordComponent.cpp" "CMakeFiles/openPMD.dir/src/RecordComponent.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/RecordComponent.cpp.o.d"
+  "/root/repo/src/Series.cpp" "CMakeFiles/openPMD.dir/src/Series.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/Series.cpp.o.d"
+  "/root/repo/src/backend/Attributable.cpp" "CMakeFiles/openPMD.dir/src/backend/Attributable.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/backend/Attributable.cpp.o.d"
+  "/root/repo/src/backend/BaseRecordComponent.cpp" "CMakeFiles/openPMD.dir/src/backend/BaseRecordComponent.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/backend/BaseRecordComponent.cpp.o.d"
+  "/root/repo/src/backend/GenericPatchData.cpp" "CMakeFiles/openPMD.dir/src/backend/GenericPatchData.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/backend/GenericPatchData.cpp.o.d"
+  "/root/repo/src/backend/MeshRecordComponent.cpp" "CMakeFiles/openPMD.dir/src/backend/MeshRecordComponent.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/backend/MeshRecordComponent.cpp.o.d"
+  "/root/repo/src/backend/PatchRecord.cpp" "CMakeFiles/openPMD.dir/src/backend/PatchRecord.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/backend/PatchRecord.cpp.o.d"
+  "/root/repo/src/backend/PatchRecordComponent.cpp" "CMakeFiles/openPMD.dir/src/backend/PatchRecordComponent.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/backend/PatchRecordComponent.cpp.o.d"
+  "/root/repo/src/backend/Writable.cpp" "CMakeFiles/openPMD.dir/src/backend/Writable.cpp.o" "gcc" "CMakeFiles/openPMD.dir/src/backend/Writable.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,63 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/openPMD.dir/src/Dataset.cpp.o"
+  "CMakeFiles/openPMD.dir/src/Dataset.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/Datatype.cpp.o"
+  "CMakeFiles/openPMD.dir/src/Datatype.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/Decomposition.cpp.o"
+  "CMakeFiles/openPMD.dir/src/Decomposition.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IO/ADIOS/ADIOS1IOHandler.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IO/ADIOS/ADIOS1IOHandler.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IO/ADIOS/ADIOS2IOHandler.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IO/ADIOS/ADIOS2IOHandler.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IO/ADIOS/ParallelADIOS1IOHandler.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IO/ADIOS/ParallelADIOS1IOHandler.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IO/AbstractIOHandler.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IO/AbstractIOHandler.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IO/DrainQueue.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IO/DrainQueue.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IO/HDF5/HDF5IOHandler.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IO/HDF5/HDF5IOHandler.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IO/HDF5/ParallelHDF5IOHandler.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IO/HDF5/ParallelHDF5IOHandler.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IO/IOStatistics.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IO/IOStatistics.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IO/TaskQueue.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IO/TaskQueue.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/Iteration.cpp.o"
+  "CMakeFiles/openPMD.dir/src/Iteration.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/IterationEncoding.cpp.o"
+  "CMakeFiles/openPMD.dir/src/IterationEncoding.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/Mesh.cpp.o"
+  "CMakeFiles/openPMD.dir/src/Mesh.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/ParticlePatches.cpp.o"
+  "CMakeFiles/openPMD.dir/src/ParticlePatches.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/ParticleSpecies.cpp.o"
+  "CMakeFiles/openPMD.dir/src/ParticleSpecies.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/Record.cpp.o"
+  "CMakeFiles/openPMD.dir/src/Record.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/RecordComponent.cpp.o"
+  "CMakeFiles/openPMD.dir/src/RecordComponent.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/Series.cpp.o"
+  "CMakeFiles/openPMD.dir/src/Series.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/backend/Attributable.cpp.o"
+  "CMakeFiles/openPMD.dir/src/backend/Attributable.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/backend/BaseRecordComponent.cpp.o"
+  "CMakeFiles/openPMD.dir/src/backend/BaseRecordComponent.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/backend/GenericPatchData.cpp.o"
+  "CMakeFiles/openPMD.dir/src/backend/GenericPatchData.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/backend/MeshRecordComponent.cpp.o"
+  "CMakeFiles/openPMD.dir/src/backend/MeshRecordComponent.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/backend/PatchRecord.cpp.o"
+  "CMakeFiles/openPMD.dir/src/backend/PatchRecord.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/backend/PatchRecordComponent.cpp.o"
+  "CMakeFiles/openPMD.dir/src/backend/PatchRecordComponent.cpp.o.d"
+  "CMakeFiles/openPMD.dir/src/backend/Writable.cpp.o"
+  "CMakeFiles/openPMD.dir/src/backend/Writable.cpp.o.d"
+  "lib/libopenPMD.a"
+  "lib/libopenPMD.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/openPMD.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
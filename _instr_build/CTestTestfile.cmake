@@ -0,0 +1,12 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_instr_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(Serial.Core "/root/repo/_instr_build/bin/CoreTests")
+set_tests_properties(Serial.Core PROPERTIES  WORKING_DIRECTORY "/root/repo/_instr_build/bin" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;459;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Serial.Auxiliary "/root/repo/_instr_build/bin/AuxiliaryTests")
+set_tests_properties(Serial.Auxiliary PROPERTIES  WORKING_DIRECTORY "/root/repo/_instr_build/bin" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;459;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(Serial.SerialIO "/root/repo/_instr_build/bin/SerialIOTests")
+set_tests_properties(Serial.SerialIO PROPERTIES  WORKING_DIRECTORY "/root/repo/_instr_build/bin" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;459;add_test;/root/repo/CMakeLists.txt;0;")
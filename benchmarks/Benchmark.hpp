@@ -0,0 +1,379 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <openPMD/openPMD.hpp>
+
+#if openPMD_HAVE_MPI
+#   include <mpi.h>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace openPMD
+{
+namespace benchmark
+{
+/** One point of the parameter sweep.
+ */
+struct Case
+{
+    std::string backend;    //!< filename extension selecting the backend, e.g. "h5" or "bp"
+    std::string encoding;   //!< "group" or "file"
+    uint64_t chunk;         //!< elements (double) written per rank and record component
+    uint64_t records;       //!< record components per iteration
+    uint64_t iterations;
+};  //Case
+
+/** Measured phases of one Case, in seconds (maximum over all ranks).
+ *
+ * Metadata operations are the creation (or opening) of iterations and datasets
+ * plus all explicitly set (or parsed) attributes.
+ */
+struct Result
+{
+    uint64_t bytes = 0;
+    double seconds = 0.;
+    uint64_t metadataOps = 0;
+    double metadataSeconds = 0.;
+};  //Result
+
+/** Parameter lists of the sweep, each given as a comma separated list on the command line.
+ */
+struct Sweep
+{
+    std::vector< std::string > backends{"h5", "bp"};
+    std::vector< std::string > encodings{"group", "file"};
+    std::vector< uint64_t > chunks{uint64_t(1) << 10, uint64_t(1) << 20};
+    std::vector< uint64_t > records{1, 16};
+    std::vector< uint64_t > iterations{4};
+    std::string directory = "../samples/benchmarks/";
+
+    std::vector< Case > cases() const
+    {
+        std::vector< Case > ret;
+        for( auto const& b : backends )
+            for( auto const& e : encodings )
+                for( auto c : chunks )
+                    for( auto r : records )
+                        for( auto i : iterations )
+                            ret.push_back(Case{b, e, c, r, i});
+        return ret;
+    }
+};  //Sweep
+
+inline std::vector< std::string >
+split(std::string const& list)
+{
+    std::vector< std::string > ret;
+    std::istringstream in(list);
+    std::string item;
+    while( std::getline(in, item, ',') )
+        if( !item.empty() )
+            ret.push_back(item);
+    return ret;
+}
+
+inline std::vector< uint64_t >
+splitNumbers(std::string const& list)
+{
+    std::vector< uint64_t > ret;
+    for( auto const& item : split(list) )
+        ret.push_back(std::stoull(item));
+    return ret;
+}
+
+/** Parse options of the form --name=a,b,c.
+ *
+ * @throws  std::runtime_error  On unknown options.
+ */
+inline Sweep
+parse(int argc, char* argv[])
+{
+    Sweep s;
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg(argv[i]);
+        auto pos = arg.find('=');
+        std::string key = arg.substr(0, pos);
+        std::string value = pos == std::string::npos ? std::string() : arg.substr(pos + 1);
+        if( key == "--backend" )
+            s.backends = split(value);
+        else if( key == "--encoding" )
+            s.encodings = split(value);
+        else if( key == "--chunk" )
+            s.chunks = splitNumbers(value);
+        else if( key == "--records" )
+            s.records = splitNumbers(value);
+        else if( key == "--iterations" )
+            s.iterations = splitNumbers(value);
+        else if( key == "--dir" )
+            s.directory = value.empty() || value.back() == '/' ? value : value + '/';
+        else
+            throw std::runtime_error("Unknown option " + arg + "\n"
+                                     "Usage: " + std::string(argv[0]) + " [--backend=h5,bp] [--encoding=group,file]"
+                                     " [--chunk=N,...] [--records=N,...] [--iterations=N,...] [--dir=path]");
+    }
+    return s;
+}
+
+/** Rank and size of the communicator all Series of the benchmark are created with (0 and 1 without MPI).
+ */
+struct Context
+{
+    int rank = 0;
+    int size = 1;
+#if openPMD_HAVE_MPI
+    MPI_Comm comm = MPI_COMM_WORLD;
+#endif
+
+    Context()
+    {
+#if openPMD_HAVE_MPI
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &size);
+#endif
+    }
+
+    void barrier() const
+    {
+#if openPMD_HAVE_MPI
+        MPI_Barrier(comm);
+#endif
+    }
+
+    double maximum(double local) const
+    {
+#if openPMD_HAVE_MPI
+        double global;
+        MPI_Allreduce(&local, &global, 1, MPI_DOUBLE, MPI_MAX, comm);
+        return global;
+#else
+        return local;
+#endif
+    }
+
+    Series create(std::string const& path) const
+    {
+#if openPMD_HAVE_MPI
+        return Series::create(path, comm);
+#else
+        return Series::create(path);
+#endif
+    }
+
+    Series read(std::string const& path) const
+    {
+#if openPMD_HAVE_MPI
+        return Series::read(path, comm);
+#else
+        return Series::read(path);
+#endif
+    }
+};  //Context
+
+/** Wall time since construction, synchronized over all ranks.
+ */
+class Timer
+{
+public:
+    explicit Timer(Context const& ctx)
+            : m_ctx(ctx)
+    {
+        m_ctx.barrier();
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    double seconds() const
+    {
+        std::chrono::duration< double > d = std::chrono::steady_clock::now() - m_start;
+        return m_ctx.maximum(d.count());
+    }
+
+private:
+    Context const& m_ctx;
+    std::chrono::steady_clock::time_point m_start;
+};  //Timer
+
+inline std::string
+seriesPath(Sweep const& s, Case const& c)
+{
+    std::ostringstream name;
+    name << s.directory << "bench_" << c.records << "r_" << c.chunk << "c_"
+         << (c.encoding == "file" ? "%T" : "all") << '.' << c.backend;
+    return name.str();
+}
+
+inline std::string
+recordName(uint64_t r)
+{
+    return "field_" + std::to_string(r);
+}
+
+/** Write one Series: every rank stores a contiguous slice of chunk elements into each 1D record component.
+ *
+ * Metadata (iterations, datasets and their attributes) and data are flushed separately to time them independently.
+ */
+inline Result
+write(Context const& ctx, Sweep const& s, Case const& c)
+{
+    Result res;
+    uint64_t const global = c.chunk * static_cast< uint64_t >(ctx.size);
+    uint64_t const offset = c.chunk * static_cast< uint64_t >(ctx.rank);
+    std::shared_ptr< double > data(new double[c.chunk], [](double* p){ delete[] p; });
+    for( uint64_t i = 0; i < c.chunk; ++i )
+        data.get()[i] = static_cast< double >(offset + i);
+
+    Series series = ctx.create(seriesPath(s, c));
+    {
+        Timer t(ctx);
+        for( uint64_t it = 0; it < c.iterations; ++it )
+        {
+            Iteration& iteration = series.iterations[it];
+            iteration.setTime(static_cast< double >(it));
+            iteration.setDt(1.);
+            res.metadataOps += 3;
+            for( uint64_t r = 0; r < c.records; ++r )
+            {
+                MeshRecordComponent& rc = iteration.meshes[recordName(r)][MeshRecordComponent::SCALAR];
+                rc.resetDataset(Dataset(Datatype::DOUBLE, {global}));
+                rc.setUnitSI(1.);
+                res.metadataOps += 2;
+            }
+        }
+        series.flush();
+        res.metadataSeconds = t.seconds();
+    }
+    {
+        Timer t(ctx);
+        for( uint64_t it = 0; it < c.iterations; ++it )
+            for( uint64_t r = 0; r < c.records; ++r )
+                series.iterations[it].meshes[recordName(r)][MeshRecordComponent::SCALAR].storeChunk({offset}, {c.chunk}, data);
+        series.flush();
+        res.seconds = t.seconds();
+    }
+    res.bytes = global * c.records * c.iterations * sizeof(double);
+    return res;
+}
+
+/** Read a Series written by write(): parse its structure, then load the slice of every rank from each record component.
+ */
+inline Result
+read(Context const& ctx, Sweep const& s, Case const& c)
+{
+    Result res;
+    uint64_t const offset = c.chunk * static_cast< uint64_t >(ctx.rank);
+
+    std::unique_ptr< Series > series;
+    {
+        Timer t(ctx);
+        series.reset(new Series(ctx.read(seriesPath(s, c))));
+        for( auto& it : series->iterations )
+        {
+            /* accessing an iteration by its index parses it, even when reading fileBased Series lazily */
+            Iteration& iteration = series->iterations[it.first];
+            res.metadataOps += 1 + iteration.numAttributes();
+            for( auto& m : iteration.meshes )
+                for( auto& rc : m.second )
+                    res.metadataOps += 1 + rc.second.numAttributes();
+        }
+        res.metadataSeconds = t.seconds();
+    }
+    {
+        Timer t(ctx);
+        std::vector< std::shared_ptr< double > > chunks;
+        for( auto& it : series->iterations )
+            for( auto& m : it.second.meshes )
+                for( auto& rc : m.second )
+                    chunks.push_back(rc.second.loadChunk< double >({offset}, {c.chunk}));
+        series->flush();
+        res.seconds = t.seconds();
+    }
+    res.bytes = c.chunk * static_cast< uint64_t >(ctx.size) * c.records * c.iterations * sizeof(double);
+    return res;
+}
+
+/** Print one result as a line of JSON (only on rank 0).
+ */
+inline void
+report(Context const& ctx, std::string const& benchmark, Case const& c, Result const& r)
+{
+    if( ctx.rank != 0 )
+        return;
+    auto rate = [](double amount, double seconds){ return seconds > 0. ? amount / seconds : 0.; };
+    std::cout << "{\"benchmark\": \"" << benchmark << "\""
+              << ", \"backend\": \"" << c.backend << "\""
+              << ", \"encoding\": \"" << c.encoding << "\""
+              << ", \"ranks\": " << ctx.size
+              << ", \"chunk\": " << c.chunk
+              << ", \"records\": " << c.records
+              << ", \"iterations\": " << c.iterations
+              << ", \"bytes\": " << r.bytes
+              << ", \"seconds\": " << r.seconds
+              << ", \"GBps\": " << rate(static_cast< double >(r.bytes) * 1e-9, r.seconds)
+              << ", \"metadata_ops\": " << r.metadataOps
+              << ", \"metadata_seconds\": " << r.metadataSeconds
+              << ", \"metadata_ops_per_s\": " << rate(static_cast< double >(r.metadataOps), r.metadataSeconds)
+              << "}" << std::endl;
+}
+
+/** Quote a message as the contents of a JSON string on a single line.
+ */
+inline std::string
+escape(std::string const& message)
+{
+    std::string escaped;
+    for( char ch : message )
+    {
+        if( ch == '"' || ch == '\\' )
+            escaped += '\\';
+        escaped += ch == '\n' ? ' ' : ch;
+    }
+    return escaped;
+}
+
+/** Report a Case that could not be run, e.g. because its backend is not available in this build.
+ */
+inline void
+skip(Context const& ctx, std::string const& benchmark, Case const& c, std::string const& reason)
+{
+    if( ctx.rank != 0 )
+        return;
+    std::cout << "{\"benchmark\": \"" << benchmark << "\""
+              << ", \"backend\": \"" << c.backend << "\""
+              << ", \"encoding\": \"" << c.encoding << "\""
+              << ", \"ranks\": " << ctx.size
+              << ", \"chunk\": " << c.chunk
+              << ", \"records\": " << c.records
+              << ", \"iterations\": " << c.iterations
+              << ", \"skipped\": \"" << escape(reason) << "\""
+              << "}" << std::endl;
+}
+} // benchmark
+} // openPMD
@@ -0,0 +1,290 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+
+using namespace openPMD;
+
+namespace
+{
+/** Bytes currently allocated on the heap through operator new, counted by the replacements below. */
+std::atomic< std::size_t > heapBytes{0};
+/** Space in front of each allocation holding its size, keeping the allocation aligned. */
+constexpr std::size_t heapHeader = alignof(std::max_align_t);
+} // namespace
+
+void*
+operator new(std::size_t size)
+{
+    void* p = std::malloc(size + heapHeader);
+    if( !p )
+        throw std::bad_alloc();
+    *static_cast< std::size_t* >(p) = size;
+    heapBytes += size;
+    return static_cast< char* >(p) + heapHeader;
+}
+
+void*
+operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+    try
+    {
+        return operator new(size);
+    } catch( std::bad_alloc const& )
+    {
+        return nullptr;
+    }
+}
+
+void
+operator delete(void* p) noexcept
+{
+    if( !p )
+        return;
+    char* base = static_cast< char* >(p) - heapHeader;
+    heapBytes -= *reinterpret_cast< std::size_t* >(base);
+    std::free(base);
+}
+
+void
+operator delete(void* p, std::nothrow_t const&) noexcept
+{
+    operator delete(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+namespace
+{
+/** Shape of the hierarchy and the backends it is flushed to, each list given comma separated on the command line.
+ */
+struct Options
+{
+    std::vector< std::string > backends{"dummy", "h5"};
+    std::vector< uint64_t > records{10000};
+    std::vector< uint64_t > attributes{4};
+    uint64_t iterations = 1;
+    uint64_t repeat = 3;
+    std::string directory = "../samples/benchmarks/";
+};  //Options
+
+Options
+parse(int argc, char* argv[])
+{
+    Options o;
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg(argv[i]);
+        auto pos = arg.find('=');
+        std::string key = arg.substr(0, pos);
+        std::string value = pos == std::string::npos ? std::string() : arg.substr(pos + 1);
+        if( key == "--backend" )
+            o.backends = benchmark::split(value);
+        else if( key == "--records" )
+            o.records = benchmark::splitNumbers(value);
+        else if( key == "--attributes" )
+            o.attributes = benchmark::splitNumbers(value);
+        else if( key == "--iterations" )
+            o.iterations = std::stoull(value);
+        else if( key == "--repeat" )
+            o.repeat = std::max< uint64_t >(std::stoull(value), 1u);
+        else if( key == "--dir" )
+            o.directory = value.empty() || value.back() == '/' ? value : value + '/';
+        else
+            throw std::runtime_error("Unknown option " + arg + "\n"
+                                     "Usage: " + std::string(argv[0]) + " [--backend=dummy,h5] [--records=N,...]"
+                                     " [--attributes=N,...] [--iterations=N] [--repeat=N] [--dir=path]");
+    }
+    return o;
+}
+
+/** Wall times of the phases of one repetition, in seconds.
+ *
+ * build:   creating all records and setting their attributes, without any IO
+ * flush:   the first flush of the whole hierarchy
+ * reflush: flushing again after changing one attribute of every record
+ * parse:   re-opening the file and parsing the whole hierarchy (not for the dummy backend)
+ *
+ * The heap memory held by the hierarchy after building it is recorded along with the times.
+ */
+struct Phases
+{
+    double build = 0.;
+    double flush = 0.;
+    double reflush = 0.;
+    double parse = 0.;
+    std::size_t buildBytes = 0;
+};  //Phases
+
+Phases
+run(benchmark::Context const& ctx, Options const& o, std::string const& backend, uint64_t records, uint64_t attributes)
+{
+    Phases p;
+    std::string const path = o.directory + "metadata_" + std::to_string(records) + "r_"
+                             + std::to_string(attributes) + "a." + backend;
+    {
+        Series series = ctx.create(path);
+        std::size_t const heapBefore = heapBytes;
+        {
+            benchmark::Timer t(ctx);
+            for( uint64_t it = 0; it < o.iterations; ++it )
+            {
+                Iteration& iteration = series.iterations[it];
+                for( uint64_t r = 0; r < records; ++r )
+                {
+                    Mesh& mesh = iteration.meshes[benchmark::recordName(r)];
+                    for( uint64_t a = 0; a < attributes; ++a )
+                        mesh.setAttribute("custom_" + std::to_string(a), static_cast< double >(a));
+                    MeshRecordComponent& rc = mesh[MeshRecordComponent::SCALAR];
+                    rc.resetDataset(Dataset(Datatype::DOUBLE, {1}));
+                    rc.makeConstant(static_cast< double >(r));
+                }
+            }
+            p.build = t.seconds();
+        }
+        p.buildBytes = heapBytes - heapBefore;
+        {
+            benchmark::Timer t(ctx);
+            series.flush();
+            p.flush = t.seconds();
+        }
+        {
+            benchmark::Timer t(ctx);
+            for( uint64_t it = 0; it < o.iterations; ++it )
+                for( auto& mesh : series.iterations[it].meshes )
+                    mesh.second.setAttribute("custom_0", -1.);
+            series.flush();
+            p.reflush = t.seconds();
+        }
+    }
+    if( backend == "dummy" )
+        return p;
+
+    benchmark::Timer t(ctx);
+    Series series = ctx.read(path);
+    uint64_t parsed = 0;
+    for( auto& it : series.iterations )
+        for( auto& mesh : it.second.meshes )
+            parsed += mesh.second.numAttributes();
+    p.parse = t.seconds();
+    if( parsed < records * o.iterations * attributes )
+        throw std::runtime_error("Parsed fewer attributes than written to " + path);
+    return p;
+}
+
+void
+report(benchmark::Context const& ctx, std::string const& backend, uint64_t records, uint64_t attributes,
+       uint64_t iterations, std::string const& phase, double seconds, std::size_t bytes = 0)
+{
+    if( ctx.rank != 0 )
+        return;
+    /* objects touched per phase: every record with its scalar component */
+    double const objects = static_cast< double >(records * iterations * 2u);
+    std::cout << "{\"benchmark\": \"metadata\""
+              << ", \"backend\": \"" << backend << "\""
+              << ", \"ranks\": " << ctx.size
+              << ", \"records\": " << records
+              << ", \"attributes\": " << attributes
+              << ", \"iterations\": " << iterations
+              << ", \"phase\": \"" << phase << "\""
+              << ", \"seconds\": " << seconds
+              << ", \"ns_per_object\": " << (objects > 0. ? seconds * 1e9 / objects : 0.);
+    if( bytes > 0 )
+        std::cout << ", \"bytes_per_object\": " << (objects > 0. ? static_cast< double >(bytes) / objects : 0.);
+    std::cout << "}" << std::endl;
+}
+} // namespace
+
+/** Time the frontend and metadata path alone: building, flushing and parsing hierarchies of many small records.
+ *
+ * Flushing to the dummy backend measures the CPU overhead of the object model without any IO,
+ * the difference to HDF5 is the cost of the backend. Each phase reports the fastest of all repetitions,
+ * the build phase also the heap memory per object of the built hierarchy.
+ */
+int main(int argc, char *argv[])
+{
+#if openPMD_HAVE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+    int ret = 0;
+    {
+        benchmark::Context ctx;
+        try
+        {
+            Options o = parse(argc, argv);
+            for( auto const& backend : o.backends )
+                for( auto records : o.records )
+                    for( auto attributes : o.attributes )
+                    {
+                        Phases best;
+                        best.build = best.flush = best.reflush = best.parse = std::numeric_limits< double >::max();
+                        try
+                        {
+                            for( uint64_t r = 0; r < o.repeat; ++r )
+                            {
+                                Phases p = run(ctx, o, backend, records, attributes);
+                                best.build = std::min(best.build, p.build);
+                                best.flush = std::min(best.flush, p.flush);
+                                best.reflush = std::min(best.reflush, p.reflush);
+                                best.parse = std::min(best.parse, p.parse);
+                                best.buildBytes = p.buildBytes;
+                            }
+                        } catch( std::exception const& e )
+                        {
+                            if( ctx.rank == 0 )
+                                std::cout << "{\"benchmark\": \"metadata\", \"backend\": \"" << backend << "\""
+                                          << ", \"records\": " << records << ", \"attributes\": " << attributes
+                                          << ", \"skipped\": \"" << benchmark::escape(e.what()) << "\"}" << std::endl;
+                            continue;
+                        }
+                        report(ctx, backend, records, attributes, o.iterations, "build", best.build, best.buildBytes);
+                        report(ctx, backend, records, attributes, o.iterations, "flush", best.flush);
+                        report(ctx, backend, records, attributes, o.iterations, "reflush", best.reflush);
+                        if( backend != "dummy" )
+                            report(ctx, backend, records, attributes, o.iterations, "parse", best.parse);
+                    }
+        } catch( std::exception const& e )
+        {
+            if( ctx.rank == 0 )
+                std::cerr << e.what() << std::endl;
+            ret = 1;
+        }
+    }
+#if openPMD_HAVE_MPI
+    MPI_Finalize();
+#endif
+    return ret;
+}
@@ -0,0 +1,66 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Benchmark.hpp"
+
+#include <exception>
+#include <iostream>
+
+
+using namespace openPMD;
+
+/** Sweep over backends, iteration encodings, chunk sizes, numbers of records and iterations,
+ * printing one line of JSON per case. The number of ranks is the size of MPI_COMM_WORLD.
+ */
+int main(int argc, char *argv[])
+{
+#if openPMD_HAVE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+    int ret = 0;
+    {
+        benchmark::Context ctx;
+        try
+        {
+            benchmark::Sweep sweep = benchmark::parse(argc, argv);
+            for( auto const& c : sweep.cases() )
+            {
+                try
+                {
+                    /* the input is prepared by an untimed write of the same case */
+                    benchmark::write(ctx, sweep, c);
+                    benchmark::report(ctx, "read", c, benchmark::read(ctx, sweep, c));
+                } catch( std::exception const& e )
+                {
+                    benchmark::skip(ctx, "read", c, e.what());
+                }
+            }
+        } catch( std::exception const& e )
+        {
+            if( ctx.rank == 0 )
+                std::cerr << e.what() << std::endl;
+            ret = 1;
+        }
+    }
+#if openPMD_HAVE_MPI
+    MPI_Finalize();
+#endif
+    return ret;
+}
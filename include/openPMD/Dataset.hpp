@@ -13,17 +13,144 @@ namespace openPMD
 using Extent = std::vector< std::uint64_t >;
 using Offset = std::vector< std::uint64_t >;
 
+/** Raw data chunk cache a backend keeps per open dataset (currently HDF5 only, see H5Pset_chunk_cache).
+ */
+struct ChunkCache
+{
+    std::size_t bytes = 0;      //!< size of the cache, 0 to size it from the chunk shape of the dataset
+    std::size_t slots = 0;      //!< number of hash table slots, 0 to derive it from bytes and the chunk size
+    double preemption = 0.75;   //!< preference in [0, 1] for evicting chunks that have been read or written completely
+};  //ChunkCache
+
+/** Time at which a backend allocates the storage of a dataset (currently HDF5 only, see H5Pset_alloc_time).
+ */
+enum class AllocationTime
+{
+    DEFAULT,        //!< the one of the Series (see Series::setAllocation), or else of the backend
+    EARLY,          //!< all storage when the dataset is created
+    INCREMENTAL,    //!< storage of each chunk when it is first written
+    LATE            //!< all storage when the dataset is first written
+};  //AllocationTime
+
+/** Time at which a backend writes fill values into newly allocated storage (currently HDF5 only, see H5Pset_fill_time).
+ */
+enum class FillTime
+{
+    DEFAULT,        //!< the one of the Series (see Series::setAllocation), or else of the backend
+    NEVER,          //!< never, elements that have been allocated but not written hold undefined values
+    ALLOCATION      //!< whenever storage is allocated, so elements that have not been written read as 0
+};  //FillTime
+
+/** Allocation of the storage of a dataset, see Dataset::setAllocation.
+ */
+struct Allocation
+{
+    AllocationTime time = AllocationTime::DEFAULT;
+    FillTime fill = FillTime::DEFAULT;
+};  //Allocation
+
+/** Way the ranks of a parallel Series transfer the chunks of a dataset (currently parallel HDF5 only, see H5Pset_dxpl_mpio).
+ */
+enum class Transfer
+{
+    DEFAULT,        //!< the one of the Series (see ParallelHDF5Options::transfer)
+    COLLECTIVE,     //!< all ranks write together, ranks with fewer chunks take part with empty selections
+    INDEPENDENT     //!< every rank writes its chunks on its own, without waiting for the others
+};  //Transfer
+
 class Dataset
 {
     friend class RecordComponent;
 
 public:
+    /** Expected way of accessing a Dataset, used to choose its chunk shape.
+     */
+    enum class AccessPattern
+    {
+        BLOCKS,     //!< rectangular blocks spanning all dimensions
+        SLICES      //!< slices at single indices of the slowest varying dimension (e.g. planes of a 3D field)
+    };  //AccessPattern
+
     Dataset(Datatype, Extent);
 
     Dataset& extend(Extent newExtent);
     Dataset& setChunkSize(std::vector< size_t > const&);
-    Dataset& setCompression(std::string const&, uint8_t const);
+    /** Choose the chunk size from the extent, the size of the datatype and the expected access pattern.
+     *
+     * @param   targetChunkBytes    Approximate size in bytes of a single chunk.
+     * @param   pattern             Expected access pattern.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setAutoChunking(size_t targetChunkBytes = size_t(1) << 20,
+                             AccessPattern pattern = AccessPattern::BLOCKS);
+    /** Compress the data written to this Dataset.
+     *
+     * Besides the built-in deflate ("zlib", "gzip", "deflate", level 0-9), the registered HDF5 filter plugins
+     * "blosc" (byte-shuffled, compressor selected as "blosc-blosclz", "blosc-lz4", "blosc-lz4hc", "blosc-zlib" or "blosc-zstd", level 0-9),
+     * "lz4" (level ignored) and "zstd" (level 1-22) are supported if found in HDF5_PLUGIN_PATH.
+     * Blosc compresses in parallel with the number of threads given in the environment variable BLOSC_NTHREADS.
+     *
+     * @param   format  Name of the compression format.
+     * @param   level   Compression level (format dependent).
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setCompression(std::string const& format, uint8_t const level);
+    /** Compress the data written to this Dataset with an error-bounded lossy codec.
+     *
+     * Supported are the HDF5 filter plugins (if found in HDF5_PLUGIN_PATH) and ADIOS2 operators (if ADIOS2 provides them)
+     * "zfp" with the modes "accuracy" (absolute error bound), "rate" (bits per value) and "precision" (bit planes kept), and
+     * "sz" with the modes "abs" (absolute error bound), "rel" (error bound relative to the value range)
+     * and "pw_rel" (point-wise relative error bound).
+     * Only floating point datasets are compressed lossily, others (e.g. particle ids) are stored without compression.
+     *
+     * @param   format      Name of the codec.
+     * @param   mode        Meaning of parameter (codec dependent).
+     * @param   parameter   Error bound, rate or precision.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setCompression(std::string const& format, std::string const& mode, double parameter);
     Dataset& setCustomTransform(std::string const&);
+    /** Size the raw data chunk cache used while this Dataset is open, instead of the one of the Series (see Series::setChunkCache).
+     *
+     * A cache holding all chunks touched by one access avoids decompressing the same chunk repeatedly,
+     * e.g. for strided reads across compressed chunks.
+     *
+     * @param   bytes       Size of the cache in bytes, 0 to size it from the chunk shape.
+     * @param   slots       Number of hash table slots, 0 to derive it from bytes and the chunk size.
+     * @param   preemption  Preference in [0, 1] for evicting fully read or written chunks.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setChunkCache(std::size_t bytes, std::size_t slots = 0, double preemption = 0.75);
+    /** Choose when the storage of this Dataset is allocated and filled, instead of the defaults of the Series (see Series::setAllocation).
+     *
+     * Early allocation with fill values writes the whole dataset once before any data,
+     * which is only worth it if not all of it will be written.
+     *
+     * @param   time    Time of allocation, DEFAULT to keep the one of the Series.
+     * @param   fill    Time fill values are written, DEFAULT to keep the one of the Series.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setAllocation(AllocationTime time, FillTime fill = FillTime::DEFAULT);
+    /** Declare the extent of this Dataset final, instead of keeping it extendable.
+     *
+     * Datasets of fixed size are stored without chunks (and their index) where the backend allows it,
+     * e.g. contiguously in HDF5, so they are read with a single access and can be mapped into memory (see RecordComponent::mapChunk),
+     * or in the object header if they are very small. Compressed datasets are still chunked.
+     * A dataset of fixed size can not be extended (or appended to) once it has been written.
+     *
+     * @param   fixed   True for a final extent, false for an extendable (chunked) dataset, the default.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setFixedSize(bool fixed = true);
+    /** Choose how the ranks of a parallel Series write the chunks of this Dataset, instead of the default of the Series.
+     *
+     * Independent transfer suits load-imbalanced data (e.g. particles), as ranks do not wait for the slowest one
+     * with every chunk, collective transfer lets MPI-IO aggregate the chunks of all ranks into large accesses.
+     *
+     * @param   transfer    Transfer of the chunks, DEFAULT to keep the one of the Series.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setTransfer(Transfer transfer);
 
     Extent extent;
     Datatype dtype;
@@ -31,5 +158,9 @@ public:
     Extent chunkSize;
     std::string compression;
     std::string transform;
+    ChunkCache chunkCache;
+    Allocation allocation;
+    bool fixedSize = false;
+    Transfer transfer = Transfer::DEFAULT;
 };
 } // openPMD
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -157,6 +158,46 @@ determineDatatype(std::shared_ptr< T >)
 
     return DT::UNDEFINED;
 }
+
+/** Size of a single value of a fundamental (i.e. non-vector, non-string) Datatype.
+ *
+ * @param   d   Fundamental Datatype.
+ * @return  Number of bytes used by one value of d.
+ */
+inline size_t
+toBytes(Datatype d)
+{
+    using DT = Datatype;
+    switch( d )
+    {
+        case DT::CHAR:
+            return sizeof(char);
+        case DT::UCHAR:
+            return sizeof(unsigned char);
+        case DT::INT16:
+            return sizeof(int16_t);
+        case DT::INT32:
+            return sizeof(int32_t);
+        case DT::INT64:
+            return sizeof(int64_t);
+        case DT::UINT16:
+            return sizeof(uint16_t);
+        case DT::UINT32:
+            return sizeof(uint32_t);
+        case DT::UINT64:
+            return sizeof(uint64_t);
+        case DT::FLOAT:
+            return sizeof(float);
+        case DT::DOUBLE:
+            return sizeof(double);
+        case DT::LONG_DOUBLE:
+            return sizeof(long double);
+        case DT::BOOL:
+            return sizeof(bool);
+        default:
+            throw std::runtime_error("Datatype has no fixed size");
+    }
+}
 } // openPMD
 
 namespace std
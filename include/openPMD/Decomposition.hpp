@@ -0,0 +1,60 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "openPMD/backend/PatchPosition.hpp"
+#include "openPMD/Dataset.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+namespace openPMD
+{
+class ParticleSpecies;
+class RecordComponent;
+
+/** Split the particles of a species into one contiguous range per reading rank with balanced particle numbers.
+ *
+ * A range ends at a boundary of the particle patches (see ParticlePatches::position) if that keeps it within
+ * tolerance of the balanced particle number, otherwise the patch is split.
+ * Without patches, the particles are split evenly.
+ *
+ * @param   numRanks    Number of reading ranks, e.g. the size of their MPI communicator.
+ * @param   tolerance   Allowed deviation of a range boundary from the balanced one for the sake of locality,
+ *                      relative to the balanced particle number per rank.
+ * @return  Number and offset of the particles of every rank, valid for all record components of the species.
+ */
+std::vector< PatchPosition > decompose(ParticleSpecies&, uint64_t numRanks, double tolerance = 0.1);
+
+/** Split a dataset (e.g. a component of a Mesh) into one block per reading rank.
+ *
+ * Block boundaries are aligned to the chunks the dataset is stored in (see RecordComponent::getChunkSize),
+ * so that no chunk is read by more than one rank.
+ * Ranks are distributed over the dimensions with most chunks first.
+ * If there are fewer chunks than ranks, the remaining ranks are assigned empty blocks.
+ *
+ * @param   numRanks    Number of reading ranks, e.g. the size of their MPI communicator.
+ * @return  Offset and extent of the block of every rank, in row-major order of the block grid.
+ */
+std::vector< std::pair< Offset, Extent > > decompose(RecordComponent&, uint64_t numRanks);
+} // openPMD
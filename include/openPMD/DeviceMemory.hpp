@@ -0,0 +1,54 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "openPMD/auxiliary/BufferPool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+
+namespace openPMD
+{
+/** Access to the memory of an accelerator (e.g. a GPU) for chunks stored from or loaded into device pointers.
+ *
+ * The library does not depend on a device runtime, the application provides the copies,
+ * e.g. cudaMemcpyAsync on the stream of the simulation followed by cudaStreamSynchronize.
+ * Chunks pass through host buffers of staging, which should hold page-locked memory
+ * (e.g. a BufferPool of cudaMallocHost and cudaFreeHost) so the copies run at full bandwidth
+ * and are not allocated again for every chunk.
+ *
+ * @see RecordComponent::storeChunk(Offset, Extent, T const*, DeviceMemory const&)
+ * @see RecordComponent::loadChunk(Offset const&, Extent const&, T*, DeviceMemory const&, double)
+ */
+struct DeviceMemory
+{
+    /** Copy bytes from device to host memory, returns once the copy has completed. */
+    std::function< void(void* host, void const* device, std::size_t bytes) > toHost;
+    /** Copy bytes from host to device memory, returns once the copy has completed. */
+    std::function< void(void* device, void const* host, std::size_t bytes) > toDevice;
+    /** Pool of host buffers for the copies, the one of the Series (or plain allocation) if empty. */
+    std::shared_ptr< auxiliary::BufferPool > staging;
+    /** Size in bytes up to which stored chunks are copied to the host at once (at least one row of the first dimension). */
+    std::size_t slabBytes = std::size_t(64) << 20;
+};  //DeviceMemory
+} // openPMD
@@ -21,44 +21,141 @@
 #pragma once
 
 #include "openPMD/IO/AbstractIOHandler.hpp"
+#include "openPMD/IO/ADIOS/ADIOS1Transport.hpp"
 
+#if openPMD_HAVE_ADIOS1
+#   if !openPMD_HAVE_MPI && !defined(_NOMPI)
+#       define _NOMPI 1
+#   endif
+#   include <adios.h>
+#   include <adios_read.h>
+#endif
+
+#include <cstdint>
+#include <functional>
 #include <future>
+#include <map>
 #include <memory>
+#include <queue>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 namespace openPMD
 {
-#if defined(openPMD_HAVE_ADIOS1)
+#if openPMD_HAVE_ADIOS1
 class ADIOS1IOHandler;
 
 class ADIOS1IOHandlerImpl
 {
 public:
     ADIOS1IOHandlerImpl(AbstractIOHandler*);
+    ADIOS1IOHandlerImpl(AbstractIOHandler*, MPI_Comm);
     virtual ~ADIOS1IOHandlerImpl();
 
+    /** Execute all operations in queue, then hand the pending output of all files to ADIOS1
+     * (which writes it once the file is closed) and perform all scheduled reads.
+     */
     virtual std::future< void > flush();
+    /** Execute the provided tasks according to FIFO, removing each one after its completion.
+     *
+     * Dataset reads and writes are only scheduled, they complete in the next call to perform().
+     */
+    void process(std::queue< IOTask >&);
+
+    virtual void createFile(Writable*, Parameter< Operation::CREATE_FILE > const&);
+    virtual void createPath(Writable*, Parameter< Operation::CREATE_PATH > const&);
+    virtual void createDataset(Writable*, Parameter< Operation::CREATE_DATASET > const&);
+    virtual void extendDataset(Writable*, Parameter< Operation::EXTEND_DATASET > const&);
+    virtual void openFile(Writable*, Parameter< Operation::OPEN_FILE > const&);
+    virtual void closeFile(Writable*, Parameter< Operation::CLOSE_FILE > const&);
+    virtual void advance(Writable*, Parameter< Operation::ADVANCE > &);
+    virtual void openPath(Writable*, Parameter< Operation::OPEN_PATH > const&);
+    virtual void openDataset(Writable*, Parameter< Operation::OPEN_DATASET > &);
+    virtual void deleteFile(Writable*, Parameter< Operation::DELETE_FILE > const&);
+    virtual void deletePath(Writable*, Parameter< Operation::DELETE_PATH > const&);
+    virtual void deleteDataset(Writable*, Parameter< Operation::DELETE_DATASET > const&);
+    virtual void deleteAttribute(Writable*, Parameter< Operation::DELETE_ATT > const&);
+    virtual void writeDataset(Writable*, Parameter< Operation::WRITE_DATASET > const&);
+    virtual void writeAttribute(Writable*, Parameter< Operation::WRITE_ATT > const&);
+    virtual void writeAttributes(Writable*, Parameter< Operation::WRITE_ATTS > const&);
+    virtual void readDataset(Writable*, Parameter< Operation::READ_DATASET > &);
+    virtual void readAttribute(Writable*, Parameter< Operation::READ_ATT > &);
+    virtual void readAttributes(Writable*, Parameter< Operation::READ_ATTS > &);
+    virtual void listPaths(Writable*, Parameter< Operation::LIST_PATHS > &);
+    virtual void listDatasets(Writable*, Parameter< Operation::LIST_DATASETS > &);
+    virtual void listAttributes(Writable*, Parameter< Operation::LIST_ATTS > &);
+
+    /** Chunk of a dataset waiting for the next write of its file.
+     */
+    struct Chunk
+    {
+        std::string name;
+        Datatype dtype;
+        Offset offset;
+        Extent extent;
+        std::shared_ptr< void > data;
+    };
+
+    /** Read operation waiting for the next adios_perform_reads of its file.
+     */
+    struct PendingGet
+    {
+        /* post-processing after the data has arrived (e.g. conversion and scaling) */
+        std::function< void() > finish;
+        std::shared_ptr< std::promise< void > > done;
+    };
+
+    /** One ADIOS1 file, either opened for reading or written through an ADIOS1 group.
+     */
+    struct File
+    {
+        /* output, the file is opened by the first flush that writes into it and stays open until it is closed,
+         * attributes are only defined right before closing so that each of them is written once with its final value */
+        int64_t group = 0;
+        int64_t fd = 0;
+        bool open = false;
+        std::map< std::string, std::pair< Datatype, Extent > > datasets;
+        std::map< std::string, Attribute > attributes;
+        std::vector< Chunk > chunks;
+
+        /* input */
+        ADIOS_FILE* reader = nullptr;
+        std::vector< ADIOS_SELECTION* > selections;
+        std::vector< PendingGet > gets;
+    };
+
+    /** Write pending output of a file and perform its scheduled reads.
+     */
+    void perform(std::string const& name, File&);
+    /** Open a file for writing, once for the whole lifetime of the file.
+     */
+    void open(std::string const& name, File&);
+    /** Look up the file an object resides in.
+     *
+     * @throws  std::runtime_error  If neither the object nor any of its parents belong to an open file.
+     */
+    File& fileOf(Writable*);
+    /** Name of the file an object resides in.
+     */
+    std::string const& fileNameOf(Writable*);
+    /** Full names of all variables of a file, taken from the file when reading and from the definitions when writing.
+     */
+    std::vector< std::string > variableNames(File const&) const;
+    /** Full names of all attributes of a file, taken from the file when reading and from the definitions when writing.
+     */
+    std::vector< std::string > attributeNames(File const&) const;
+    /** Write all pending output and attributes of a file and close it.
+     */
+    void closeFile(std::string const& name, File&);
+
+    MPI_Comm m_comm;
+    ADIOS1Transport m_transport;
 
-    using ArgumentMap = std::map< std::string, ParameterArgument >;
-    virtual void createFile(Writable*, ArgumentMap const&);
-    virtual void createPath(Writable*, ArgumentMap const&);
-    virtual void createDataset(Writable*, ArgumentMap const&);
-    virtual void extendDataset(Writable*, ArgumentMap const&);
-    virtual void openFile(Writable*, ArgumentMap const&);
-    virtual void openPath(Writable*, ArgumentMap const&);
-    virtual void openDataset(Writable*, ArgumentMap &);
-    virtual void deleteFile(Writable*, ArgumentMap const&);
-    virtual void deletePath(Writable*, ArgumentMap const&);
-    virtual void deleteDataset(Writable*, ArgumentMap const&);
-    virtual void deleteAttribute(Writable*, ArgumentMap const&);
-    virtual void writeDataset(Writable*, ArgumentMap const&);
-    virtual void writeAttribute(Writable*, ArgumentMap const&);
-    virtual void readDataset(Writable*, ArgumentMap &);
-    virtual void readAttribute(Writable*, ArgumentMap &);
-    virtual void listPaths(Writable*, ArgumentMap &);
-    virtual void listDatasets(Writable*, ArgumentMap &);
-    virtual void listAttributes(Writable*, ArgumentMap &);
+    std::map< std::string, File > m_files;
+    std::unordered_map< Writable*, std::string > m_fileNames;
 
     AbstractIOHandler* m_handler;
 };  //ADIOS1IOHandlerImpl
@@ -75,7 +172,7 @@ public:
     ADIOS1IOHandler(std::string const& path, AccessType);
     virtual ~ADIOS1IOHandler();
 
-    std::future< void > flush();
+    std::future< void > flush() override;
 
 private:
     std::unique_ptr< ADIOS1IOHandlerImpl > m_impl;
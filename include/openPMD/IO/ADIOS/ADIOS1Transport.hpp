@@ -0,0 +1,54 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <string>
+
+
+namespace openPMD
+{
+/** Transport method used to write ADIOS1 files.
+ *
+ * @see "Transport methods" in the ADIOS 1.x user manual for all methods and their parameters.
+ */
+struct ADIOS1Transport
+{
+    /** Name of the ADIOS1 method (e.g. "POSIX", "MPI", "MPI_AGGREGATE"). */
+    std::string method;
+    /** Semicolon separated parameters passed to the method (e.g. "num_aggregators=64;num_ost=32"). */
+    std::string parameters;
+
+    /** Transport through a subset of ranks that collect and write the data of all others.
+     *
+     * @param   numAggregators  Number of ranks writing to the filesystem.
+     * @param   numOST          Number of Lustre object storage targets to stripe over, 0 to let ADIOS1 decide.
+     */
+    static ADIOS1Transport aggregate(unsigned int numAggregators, unsigned int numOST = 0)
+    {
+        ADIOS1Transport t;
+        t.method = "MPI_AGGREGATE";
+        t.parameters = "num_aggregators=" + std::to_string(numAggregators);
+        if( numOST > 0 )
+            t.parameters += ";num_ost=" + std::to_string(numOST);
+        return t;
+    }
+};  //ADIOS1Transport
+} // openPMD
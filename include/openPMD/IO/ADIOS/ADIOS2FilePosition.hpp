@@ -1,14 +1,43 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
 #pragma once
 
-#include "openPMDIO/AbstractFilePosition.hpp"
+#include "openPMD/IO/AbstractFilePosition.hpp"
+
+#include <string>
 
 
 namespace openPMD
 {
+/** Position of an object inside an ADIOS2 file.
+ *
+ * ADIOS2 has no notion of groups, objects are identified by their '/'-separated path.
+ * The location is relative to the position of the parent object.
+ */
 struct ADIOS2FilePosition : public AbstractFilePosition
 {
-    ADIOS2FilePosition()
+    ADIOS2FilePosition(std::string const& s)
+            : location{s}
     { }
 
+    std::string location;
 };  //ADIOS2FilePosition
 } // openPMD
@@ -22,9 +22,18 @@
 
 #include "openPMD/IO/AbstractIOHandler.hpp"
 
+#if defined(openPMD_HAVE_ADIOS2)
+#   include <adios2.h>
+#endif
+
+#include <functional>
 #include <future>
+#include <map>
 #include <memory>
+#include <queue>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace openPMD
@@ -35,30 +44,107 @@ class ADIOS2IOHandler;
 class ADIOS2IOHandlerImpl
 {
 public:
-    ADIOS2IOHandlerImpl(AbstractIOHandler*);
+    /**
+     * @param   engineType  ADIOS2 engine for all files, either a file engine ("BP4")
+     *                      or a staging engine ("SST", "SSC") streaming one step per flush().
+     */
+    ADIOS2IOHandlerImpl(AbstractIOHandler*, std::string engineType);
+#if openPMD_HAVE_MPI
+    ADIOS2IOHandlerImpl(AbstractIOHandler*, MPI_Comm, std::string engineType);
+#endif
     virtual ~ADIOS2IOHandlerImpl();
 
+    /** Enqueue all operations in queue with the ADIOS2 engines,
+     * then execute all deferred Puts and Gets with one PerformPuts/PerformGets per open file.
+     * Streams opened for writing finish their current step, i.e. every flush() yields one step.
+     */
     virtual std::future< void > flush();
+    /** Execute the provided tasks according to FIFO, removing each one after its completion.
+     *
+     * Dataset reads and writes are only deferred, they complete in the next call to perform().
+     */
+    void process(std::queue< IOTask >&);
+
+    virtual void createFile(Writable*, Parameter< Operation::CREATE_FILE > const&);
+    virtual void createPath(Writable*, Parameter< Operation::CREATE_PATH > const&);
+    virtual void createDataset(Writable*, Parameter< Operation::CREATE_DATASET > const&);
+    virtual void extendDataset(Writable*, Parameter< Operation::EXTEND_DATASET > const&);
+    virtual void openFile(Writable*, Parameter< Operation::OPEN_FILE > const&);
+    virtual void closeFile(Writable*, Parameter< Operation::CLOSE_FILE > const&);
+    virtual void advance(Writable*, Parameter< Operation::ADVANCE > &);
+    virtual void openPath(Writable*, Parameter< Operation::OPEN_PATH > const&);
+    virtual void openDataset(Writable*, Parameter< Operation::OPEN_DATASET > &);
+    virtual void deleteFile(Writable*, Parameter< Operation::DELETE_FILE > const&);
+    virtual void deletePath(Writable*, Parameter< Operation::DELETE_PATH > const&);
+    virtual void deleteDataset(Writable*, Parameter< Operation::DELETE_DATASET > const&);
+    virtual void deleteAttribute(Writable*, Parameter< Operation::DELETE_ATT > const&);
+    virtual void writeDataset(Writable*, Parameter< Operation::WRITE_DATASET > const&);
+    virtual void writeAttribute(Writable*, Parameter< Operation::WRITE_ATT > const&);
+    virtual void writeAttributes(Writable*, Parameter< Operation::WRITE_ATTS > const&);
+    virtual void readDataset(Writable*, Parameter< Operation::READ_DATASET > &);
+    virtual void readAttribute(Writable*, Parameter< Operation::READ_ATT > &);
+    virtual void readAttributes(Writable*, Parameter< Operation::READ_ATTS > &);
+    virtual void listPaths(Writable*, Parameter< Operation::LIST_PATHS > &);
+    virtual void listDatasets(Writable*, Parameter< Operation::LIST_DATASETS > &);
+    virtual void listAttributes(Writable*, Parameter< Operation::LIST_ATTS > &);
 
-    using ArgumentMap = std::map< std::string, ParameterArgument >;
-    virtual void createFile(Writable*, ArgumentMap const&);
-    virtual void createPath(Writable*, ArgumentMap const&);
-    virtual void createDataset(Writable*, ArgumentMap const&);
-    virtual void extendDataset(Writable*, ArgumentMap const&);
-    virtual void openFile(Writable*, ArgumentMap const&);
-    virtual void openPath(Writable*, ArgumentMap const&);
-    virtual void openDataset(Writable*, ArgumentMap &);
-    virtual void deleteFile(Writable*, ArgumentMap const&);
-    virtual void deletePath(Writable*, ArgumentMap const&);
-    virtual void deleteDataset(Writable*, ArgumentMap const&);
-    virtual void deleteAttribute(Writable*, ArgumentMap const&);
-    virtual void writeDataset(Writable*, ArgumentMap const&);
-    virtual void writeAttribute(Writable*, ArgumentMap const&);
-    virtual void readDataset(Writable*, ArgumentMap &);
-    virtual void readAttribute(Writable*, ArgumentMap &);
-    virtual void listPaths(Writable*, ArgumentMap &);
-    virtual void listDatasets(Writable*, ArgumentMap &);
-    virtual void listAttributes(Writable*, ArgumentMap &);
+    /** Read operation waiting for the next PerformGets of its engine.
+     */
+    struct PendingGet
+    {
+        /* post-processing after the data has arrived (e.g. conversion and scaling) */
+        std::function< void() > finish;
+        std::shared_ptr< std::promise< void > > done;
+    };
+
+    /** One open ADIOS2 file with its IO object and engine.
+     */
+    struct File
+    {
+        adios2::IO io;
+        adios2::Engine engine;
+        bool reading;
+        bool stepOpen;
+        /* data handed to deferred Puts, kept alive until the next PerformPuts */
+        std::vector< std::shared_ptr< void > > puts;
+        std::vector< PendingGet > gets;
+    };
+
+    /** Execute all deferred operations of a file.
+     */
+    void perform(File&);
+    /** Start a new step in a stream opened for writing, unless one is already open.
+     */
+    void beginStep(File&);
+    /** Execute all deferred operations of a file, finish its current step and close its engine.
+     */
+    void closeEngine(File&);
+    /** Close the engine of an open file and forget all objects residing in it.
+     *
+     * The IO object of the file is emptied and re-used if the file is opened again.
+     */
+    void releaseFile(std::string const& name);
+    /** Look up the file an object resides in.
+     *
+     * @throws  std::runtime_error  If neither the object nor any of its parents belong to an open file.
+     */
+    File& fileOf(Writable*);
+    /** Name of the file an object resides in.
+     */
+    std::string const& fileNameOf(Writable*);
+    /** Compress a floating point variable with the lossy codec described by a compression string of Dataset::setCompression.
+     *
+     * Other compression formats and datatypes are ignored with a warning, as are codecs ADIOS2 has not been built with.
+     */
+    void addOperation(adios2::IO&, std::string const& varName, Datatype, std::string const& compression);
+
+    adios2::ADIOS m_ADIOS;
+    std::string m_engineType;
+    std::string m_fileSuffix;
+    bool m_streaming;
+
+    std::map< std::string, File > m_files;
+    std::unordered_map< Writable*, std::string > m_fileNames;
 
     AbstractIOHandler* m_handler;
 };  //ADIOS2IOHandlerImpl
@@ -72,10 +158,13 @@ class ADIOS2IOHandler : public AbstractIOHandler
     friend class ADIOS2IOHandlerImpl;
 
 public:
-    ADIOS2IOHandler(std::string const& path, AccessType);
+    ADIOS2IOHandler(std::string const& path, AccessType, std::string const& engineType = "BP4");
+#if openPMD_HAVE_MPI
+    ADIOS2IOHandler(std::string const& path, AccessType, MPI_Comm, std::string const& engineType = "BP4");
+#endif
     virtual ~ADIOS2IOHandler();
 
-    std::future< void > flush();
+    std::future< void > flush() override;
 
 private:
     std::unique_ptr< ADIOS2IOHandlerImpl > m_impl;
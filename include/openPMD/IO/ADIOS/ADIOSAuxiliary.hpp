@@ -0,0 +1,111 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "openPMD/Datatype.hpp"
+#include "openPMD/IO/AbstractIOHandler.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+
+namespace openPMD
+{
+/** Invoke action.template call< T >() with the C++ type T used to store a dataset of Datatype dt.
+ */
+template< typename Action >
+inline void
+switchDatasetType(Datatype dt, Action& action)
+{
+    using DT = Datatype;
+    switch( dt )
+    {
+        case DT::CHAR:
+            action.template call< char >();
+            break;
+        case DT::UCHAR:
+        case DT::BOOL:
+            action.template call< unsigned char >();
+            break;
+        case DT::INT16:
+            action.template call< int16_t >();
+            break;
+        case DT::INT32:
+            action.template call< int32_t >();
+            break;
+        case DT::INT64:
+            action.template call< int64_t >();
+            break;
+        case DT::UINT16:
+            action.template call< uint16_t >();
+            break;
+        case DT::UINT32:
+            action.template call< uint32_t >();
+            break;
+        case DT::UINT64:
+            action.template call< uint64_t >();
+            break;
+        case DT::FLOAT:
+            action.template call< float >();
+            break;
+        case DT::DOUBLE:
+            action.template call< double >();
+            break;
+        case DT::LONG_DOUBLE:
+            action.template call< long double >();
+            break;
+        default:
+            throw unsupported_data_error("Datatype not supported by ADIOS backends");
+    }
+}
+
+/** Convert data staged in its stored type S into the requested type.
+ *
+ * Dispatch with switchDatasetType on the requested Datatype,
+ * finish then performs the conversion (and scaling) once the staged data has been read.
+ */
+template< typename S >
+struct ConvertData
+{
+    std::shared_ptr< S > source;
+    void* target;
+    std::size_t numPoints;
+    double scale;
+    std::function< void() > finish;
+
+    template< typename T >
+    void call()
+    {
+        std::shared_ptr< S > src = source;
+        T* dst = static_cast< T* >(target);
+        std::size_t n = numPoints;
+        double f = scale;
+        finish = [src, dst, n, f]()
+        {
+            S const* s = src.get();
+            for( std::size_t i = 0; i < n; ++i )
+                dst[i] = static_cast< T >(f == 1. ? s[i] : s[i] * f);
+        };
+    }
+};  //ConvertData
+} // openPMD
@@ -43,7 +43,6 @@ public:
     virtual ~ParallelADIOS1IOHandlerImpl();
 
     MPI_Comm m_mpiComm;
-    MPI_Info m_mpiInfo;
 };  //ParallelADIOS1IOHandlerImpl
 #else
 class ParallelADIOS1IOHandlerImpl
@@ -53,7 +52,7 @@ class ParallelADIOS1IOHandlerImpl
 class ParallelADIOS1IOHandler : public AbstractIOHandler
 {
 public:
-#if openPMD_HAVE_ADIOS1 && openPMD_HAVE_MPI
+#if openPMD_HAVE_MPI
     ParallelADIOS1IOHandler(std::string const& path, AccessType, MPI_Comm);
 #else
     ParallelADIOS1IOHandler(std::string const& path, AccessType);
@@ -62,6 +61,12 @@ public:
 
     std::future< void > flush() override;
 
+    /** Select the method used to write all files of this handler that have not been written yet.
+     *
+     * Defaults to "MPI" without parameters.
+     */
+    void setTransport(ADIOS1Transport const&);
+
 private:
     std::unique_ptr< ParallelADIOS1IOHandlerImpl > m_impl;
 };  //ParallelADIOS1IOHandler
@@ -20,9 +20,13 @@
  */
 #pragma once
 
+#include "openPMD/auxiliary/BufferPool.hpp"
 #include "openPMD/IO/AccessType.hpp"
 #include "openPMD/IO/Format.hpp"
+#include "openPMD/IO/IOStatistics.hpp"
 #include "openPMD/IO/IOTask.hpp"
+#include "openPMD/IO/TaskQueue.hpp"
+#include "openPMD/IO/WriteStaging.hpp"
 
 #if openPMD_HAVE_MPI
 #   include <mpi.h>
@@ -31,6 +35,7 @@
 #include <stdexcept>
 #include <memory>
 #include <future>
+#include <mutex>
 #include <queue>
 #include <string>
 
@@ -105,6 +110,8 @@ public:
     virtual ~AbstractIOHandler();
 
     /** Add provided task to queue according to FIFO.
+     *
+     * Lock-free, may be called from several threads at the same time, also while the queue is flushed.
      *
      * @param   iotask  Task to be executed after all previously enqueued IOTasks complete.
      */
@@ -114,10 +121,34 @@ public:
      * @return  Future indicating the completion state of the operation for backends that decide to implement this operation asynchronously.
      */
     virtual std::future< void > flush() = 0;
+    /** Hand all operations in queue to the backend without waiting for their completion.
+     *
+     * Operations enqueued after this call are not part of the handed batch.
+     * The default implementation processes the queue synchronously.
+     *
+     * @return  Future that becomes ready once all operations in the handed batch have completed
+     *          (or holds the exception that interrupted them).
+     */
+    virtual std::future< void > flushAsync();
 
     std::string const directory;
     AccessType const accessType;
-    std::queue< IOTask > m_work;
+    /** Tasks handed to enqueue(), consumed by flush(). */
+    TaskQueue m_work;
+    /** Serializes the consumers of m_work and guards staging, held for the whole duration of a flush. */
+    std::recursive_mutex m_workMutex;
+    /** Optional source of buffers allocated by the API (e.g. for loaded chunks), plain allocation is used if empty. */
+    std::shared_ptr< auxiliary::BufferPool > bufferPool;
+    /** Per-Operation count, bytes and wall time of all processed tasks (empty unless built with openPMD_USE_INSTRUMENTATION). */
+    IOStatistics statistics;
+    /** Memory budget and bookkeeping of chunks that are registered but not yet handed to the backend. */
+    WriteStaging staging;
+    /** Chunk cache of all datasets without one of their own, sized from their chunk shape if empty. */
+    ChunkCache chunkCache;
+    /** Allocation of all datasets created without one of their own, the default of the backend if DEFAULT. */
+    Allocation allocation;
+    /** Reuse groups and compatible datasets that already exist in the file instead of creating them, see Series::setOverwriteMode. */
+    bool overwrite = false;
 };  //AbstractIOHandler
 
 
@@ -0,0 +1,94 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+
+namespace openPMD
+{
+/** Progress of moving the files of a Series from its staging directory to their final directory.
+ */
+struct DrainStatus
+{
+    std::size_t pendingFiles;   //!< files handed over that have not reached the final directory yet
+    std::size_t drainedFiles;   //!< files that have been moved to the final directory
+    std::uint64_t pendingBytes; //!< bytes of the pending files that have not been copied yet
+    std::uint64_t drainedBytes; //!< bytes copied to the final directory so far
+};  //DrainStatus
+
+/** Moves closed files from a fast staging directory (e.g. node-local NVMe or a burst buffer)
+ *  to their final directory on a dedicated thread.
+ *
+ * Files (or directories, e.g. of ADIOS2) are moved one after another in the order they are handed over.
+ * Each one is copied next to its destination under a temporary name and renamed when complete,
+ * so readers of the final directory never see a partial file. The staged copy is removed afterwards.
+ */
+class DrainQueue
+{
+public:
+    DrainQueue(std::string stagingDirectory, std::string targetDirectory);
+    DrainQueue(DrainQueue const&) = delete;
+    DrainQueue& operator=(DrainQueue const&) = delete;
+    /** Waits until all files have been moved, errors are reported on std::cerr. */
+    ~DrainQueue();
+
+    /** Move a file or directory once all previously added ones have been moved.
+     *
+     * @param   name    Path relative to both the staging and the target directory.
+     */
+    void add(std::string const& name);
+    /** Wait until all added files have been moved.
+     *
+     * @throws  std::runtime_error  If moving a file failed since the last call, the file is left in the staging directory.
+     */
+    void await();
+    DrainStatus status() const;
+
+    std::string const& stagingDirectory() const { return m_staging; }
+    std::string const& targetDirectory() const { return m_target; }
+
+private:
+    void work();
+    void move(std::string const& name);
+
+    std::string const m_staging;
+    std::string const m_target;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque< std::pair< std::string, std::uint64_t > > m_pending;   /* name and staged size */
+    std::uint64_t m_current = 0;    /* bytes of the file being moved that are still counted as pending */
+    bool m_busy = false;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+    DrainStatus m_status{0, 0, 0, 0};
+    std::thread m_worker;
+};  //DrainQueue
+} // openPMD
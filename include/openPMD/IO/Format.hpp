@@ -30,6 +30,8 @@ enum class Format
     HDF5,
     ADIOS1,
     ADIOS2,
+    ADIOS2_SST, //!< ADIOS2 staging through the network, without touching the filesystem
+    ADIOS2_SSC, //!< ADIOS2 staging through MPI, writer and reader have to share MPI_COMM_WORLD
     DUMMY
 };  //Format
 } // openPMD
@@ -27,7 +27,8 @@
 
 #include <hdf5.h>
 
-#include <stack>
+#include <memory>
+#include <string>
 
 
 namespace openPMD
@@ -216,25 +217,52 @@ getH5DataSpace(Attribute const& att)
     }
 }
 
+/** Absolute path of a Writable (or of its parent, if the Writable has not been written) inside its file.
+ *
+ * @return  Empty if neither has been written, e.g. for the Series before its file is created.
+ */
 inline std::string
 concrete_h5_file_position(Writable* w)
 {
-    std::stack< Writable* > hierarchy;
     if( !w->abstractFilePosition )
         w = w->parent;
-    while( w )
-    {
-        hierarchy.push(w);
-        w = w->parent;
-    }
+    if( !w || !w->abstractFilePosition )
+        return std::string();
+    return static_cast< HDF5FilePosition* >(w->abstractFilePosition.get())->path;
+}
 
-    std::string pos;
-    while( !hierarchy.empty() )
-    {
-        pos += std::dynamic_pointer_cast< HDF5FilePosition >(hierarchy.top()->abstractFilePosition)->location;
-        hierarchy.pop();
-    }
+/** Position of an object at a location relative to its parent, resolving its absolute path once.
+ */
+inline std::shared_ptr< HDF5FilePosition >
+make_h5_file_position(std::string const& location, Writable* parent)
+{
+    if( !parent )
+        return std::make_shared< HDF5FilePosition >(location);
+    return std::make_shared< HDF5FilePosition >(location, concrete_h5_file_position(parent));
+}
 
-    return auxiliary::replace_all(pos, "//", "/");
+/** Type of the object linked as name in loc, e.g. while iterating the links of a group.
+ *
+ * Only the basic object information is requested where the library supports it,
+ * so the header messages of the object (e.g. the number of its attributes) are not read.
+ *
+ * @return  H5O_TYPE_UNKNOWN if the link can not be resolved (e.g. a dangling soft link).
+ */
+inline H5O_type_t
+h5_object_type(hid_t loc, char const* name)
+{
+#if H5_VERSION_GE(1, 12, 0)
+    H5O_info2_t object_info;
+    herr_t status = H5Oget_info_by_name3(loc, name, &object_info, H5O_INFO_BASIC, H5P_DEFAULT);
+#elif H5_VERSION_GE(1, 10, 3)
+    H5O_info_t object_info;
+    herr_t status = H5Oget_info_by_name2(loc, name, &object_info, H5O_INFO_BASIC, H5P_DEFAULT);
+#else
+    H5O_info_t object_info;
+    herr_t status = H5Oget_info_by_name(loc, name, &object_info, H5P_DEFAULT);
+#endif
+    if( status < 0 )
+        return H5O_TYPE_UNKNOWN;
+    return object_info.type;
 }
 } // openPMD
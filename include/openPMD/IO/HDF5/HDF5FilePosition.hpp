@@ -20,17 +20,33 @@
  */
 #pragma once
 
+#include "openPMD/auxiliary/StringManip.hpp"
 #include "openPMD/IO/AbstractFilePosition.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
 
 namespace openPMD
 {
 struct HDF5FilePosition : public AbstractFilePosition
 {
     HDF5FilePosition(std::string const& s)
-            : location{s}
+            : path{s},
+              locationOffset{0}
+    { }
+    HDF5FilePosition(std::string const& s, std::string const& parentPath)
+            : path{auxiliary::replace_all(parentPath + s, "//", "/")},
+              locationOffset{std::min(parentPath.size(), path.size())}
     { }
 
-    std::string location;
+    /** Location relative to the parent object. */
+    std::string location() const { return path.substr(locationOffset); }
+
+    /** Absolute path inside the file, resolved once on creation. */
+    std::string path;
+    /** Start of the location in path, which is not stored separately as every object holds a position. */
+    std::size_t locationOffset;
 };  //HDF5FilePosition
 } // openPMD
@@ -21,16 +21,26 @@
 #pragma once
 
 #include "openPMD/IO/AbstractIOHandler.hpp"
+#include "openPMD/IO/HDF5/HDF5Options.hpp"
 
 #if defined(openPMD_HAVE_HDF5)
 #   include <hdf5.h>
 #endif
 
+#include <array>
+#include <condition_variable>
 #include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 
 namespace openPMD
@@ -45,34 +55,245 @@ public:
     virtual ~HDF5IOHandlerImpl();
 
     virtual std::future< void > flush();
+    /** Execute the provided tasks according to FIFO, removing each one after its completion.
+     */
+    void process(std::queue< IOTask >&);
+    /** Called once all tasks handed to process() have been executed, e.g. to issue writes that have been deferred.
+     */
+    virtual void completeBatch();
+    /** Called instead of completeBatch() once a task handed to process() has failed, must not throw.
+     */
+    virtual void abortBatch();
+    /** Apply options to all files opened or created from now on.
+     */
+    void setOptions(HDF5Options const&);
 
-    using ArgumentMap = std::map< std::string, ParameterArgument >;
-    virtual void createFile(Writable*, ArgumentMap const&);
-    virtual void createPath(Writable*, ArgumentMap const&);
-    virtual void createDataset(Writable*, ArgumentMap const&);
-    virtual void extendDataset(Writable*, ArgumentMap const&);
-    virtual void openFile(Writable*, ArgumentMap const&);
-    virtual void openPath(Writable*, ArgumentMap const&);
-    virtual void openDataset(Writable*, ArgumentMap &);
-    virtual void deleteFile(Writable*, ArgumentMap const&);
-    virtual void deletePath(Writable*, ArgumentMap const&);
-    virtual void deleteDataset(Writable*, ArgumentMap const&);
-    virtual void deleteAttribute(Writable*, ArgumentMap const&);
-    virtual void writeDataset(Writable*, ArgumentMap const&);
-    virtual void writeAttribute(Writable*, ArgumentMap const&);
-    virtual void readDataset(Writable*, ArgumentMap &);
-    virtual void readAttribute(Writable*, ArgumentMap &);
-    virtual void listPaths(Writable*, ArgumentMap &);
-    virtual void listDatasets(Writable*, ArgumentMap &);
-    virtual void listAttributes(Writable*, ArgumentMap &);
+    virtual void createFile(Writable*, Parameter< Operation::CREATE_FILE > const&);
+    virtual void createPath(Writable*, Parameter< Operation::CREATE_PATH > const&);
+    virtual void createDataset(Writable*, Parameter< Operation::CREATE_DATASET > const&);
+    virtual void extendDataset(Writable*, Parameter< Operation::EXTEND_DATASET > const&);
+    virtual void openFile(Writable*, Parameter< Operation::OPEN_FILE > const&);
+    virtual void closeFile(Writable*, Parameter< Operation::CLOSE_FILE > const&);
+    virtual void advance(Writable*, Parameter< Operation::ADVANCE > &);
+    virtual void openPath(Writable*, Parameter< Operation::OPEN_PATH > const&);
+    virtual void openDataset(Writable*, Parameter< Operation::OPEN_DATASET > &);
+    virtual void deleteFile(Writable*, Parameter< Operation::DELETE_FILE > const&);
+    virtual void deletePath(Writable*, Parameter< Operation::DELETE_PATH > const&);
+    virtual void deleteDataset(Writable*, Parameter< Operation::DELETE_DATASET > const&);
+    virtual void deleteAttribute(Writable*, Parameter< Operation::DELETE_ATT > const&);
+    virtual void writeDataset(Writable*, Parameter< Operation::WRITE_DATASET > const&);
+    virtual void writeAttribute(Writable*, Parameter< Operation::WRITE_ATT > const&);
+    virtual void writeAttributes(Writable*, Parameter< Operation::WRITE_ATTS > const&);
+    virtual void readDataset(Writable*, Parameter< Operation::READ_DATASET > &);
+    /** Map a chunk of a contiguous (or single-chunk), unfiltered dataset from a file opened as read only into memory.
+     *
+     * Leaves the view empty if the chunk is not a single contiguous range of the file or needs type conversion.
+     */
+    virtual void mapDataset(Writable*, Parameter< Operation::MAP_DATASET > &);
+    virtual void readAttribute(Writable*, Parameter< Operation::READ_ATT > &);
+    virtual void readAttributes(Writable*, Parameter< Operation::READ_ATTS > &);
+    virtual void listPaths(Writable*, Parameter< Operation::LIST_PATHS > &);
+    virtual void listDatasets(Writable*, Parameter< Operation::LIST_DATASETS > &);
+    virtual void listAttributes(Writable*, Parameter< Operation::LIST_ATTS > &);
+    /** Write a chunk with the given dataset transfer property (see writeDataset). */
+    void writeChunk(Writable*, Parameter< Operation::WRITE_DATASET > const&, hid_t transferProperty);
+    /** Write a chunk into an open dataset, selecting its offset and extent in the file space of the dataset. */
+    void writeChunk(hid_t dataset, hid_t filespace, Parameter< Operation::WRITE_DATASET > const&, hid_t transferProperty);
+
+    /** Open dataset together with its file dataspace, re-used across IOTasks on the same Writable.
+     */
+    struct DatasetHandle
+    {
+        /* keeps the position alive, so a new Writable at the same address can not match */
+        std::shared_ptr< AbstractFilePosition > position;
+        hid_t file;
+        hid_t dataset;
+        hid_t dataspace;
+        ChunkCache cache;   /* requested chunk cache the dataset has been opened with */
+        std::list< Writable* >::iterator lru;
+    };
+
+    /** Obtain the (possibly cached) open dataset backing a Writable.
+     *
+     * @param   writable    Writable corresponding to a dataset that has already been written or opened.
+     * @param   file        HDF5 file containing the dataset.
+     * @param   cache       Chunk cache of the dataset (the one of the handler if empty), nullptr if any cache will do.
+     * @return  Reference to the cached handle, valid until the next call to any dataset handle function.
+     */
+    DatasetHandle& datasetHandle(Writable* writable, hid_t file, ChunkCache const* cache = nullptr);
+    /** Close the cached dataset corresponding to a Writable (if there is one).
+     */
+    void releaseDatasetHandle(Writable*);
+    /** Close all cached datasets.
+     */
+    void releaseDatasetHandles();
+    /** Close all cached datasets residing in a file.
+     */
+    void releaseDatasetHandles(hid_t file);
+    /** Prepare an existing dataset for reuse in overwrite mode, instead of creating it.
+     *
+     * @param   fixedSize   The dataset is requested with a final extent of dims (see Dataset::setFixedSize).
+     * @return  True if group holds a dataset of the datatype and dimensionality as name, which has been resized to dims
+     *          (or already has the fixed size dims). Otherwise, anything linked as name has been removed
+     *          and the dataset has to be created.
+     */
+    bool reuseDataset(hid_t group, std::string const& name, Datatype dtype, std::vector< hsize_t > const& dims, bool fixedSize);
+    /** Groups and datasets directly below one group, each in increasing order of their names.
+     */
+    struct GroupListing
+    {
+        std::vector< std::string > paths;
+        std::vector< std::string > datasets;
+    };
+
+    /** Obtain the (possibly cached) links of a group, classified in a single pass over the group.
+     *
+     * @param   writable    Writable corresponding to a group that has already been written or opened.
+     * @param   file        HDF5 file containing the group.
+     * @return  Reference to the cached listing, valid until the structure of the file changes.
+     */
+    GroupListing const& groupListing(Writable* writable, hid_t file);
+    /** Forget all cached listings of groups residing in a file, e.g. after creating or deleting objects in it.
+     */
+    void releaseGroupListings(hid_t file);
+    /** Observe the changes of another writer to a file opened as read only, by reopening it.
+     *
+     * Cached listings, dataset handles and the metadata snapshot of the file are dropped,
+     * all objects residing in it are moved to the new file id.
+     *
+     * @return  The id of the file to be used from now on.
+     */
+    hid_t refreshFile(hid_t file);
+
+    /** Create a dataset access property with the requested chunk cache,
+     *  or if its size is 0 with one large enough for one slab along the slowest dimension.
+     *
+     * @return  H5P_DEFAULT if the default chunk cache suffices, otherwise a property to be closed by the caller.
+     */
+    hid_t chunkCacheProperty(hid_t dataset, hid_t dataspace, ChunkCache const& cache);
+
+    /** Build the creation properties of files and groups for the requested attribute storage.
+     *
+     * @throws  std::runtime_error  If the thresholds are invalid.
+     */
+    void setAttributeStorage(HDF5AttributeStorage const&);
+    /** Apply the requested attribute storage to the creation property of an object, e.g. of a dataset.
+     */
+    void applyAttributeStorage(hid_t objectCreationProperty) const;
+    /** Write one attribute to an open object.
+     *
+     * @param   node        Open group or dataset.
+     * @param   writable    Writable corresponding to node, used for error messages.
+     */
+    void writeAttributeValue(hid_t node, Writable* writable, Parameter< Operation::WRITE_ATT > const&);
+
+    /** Native HDF5 type of dataset elements in memory.
+     *
+     * @throws  std::runtime_error  If values of the datatype can not be stored in datasets.
+     * @return  Type owned by the handler, not to be closed by the caller.
+     */
+    hid_t memoryType(Datatype);
+    /** HDF5 type an attribute value is stored with, strings sized to the (longest) string of the value.
+     *
+     * @throws  std::runtime_error  If the datatype is not part of the openPMD standard.
+     * @return  Type owned by the handler, not to be closed by the caller.
+     */
+    hid_t attributeType(Attribute const&);
+    /** Fixed-length string type, created on first use of each length. */
+    hid_t stringType(std::size_t length);
+
+    /** Results of the metadata reads of one file, see HDF5Options::metadataSnapshots.
+     */
+    struct Snapshot
+    {
+        std::string path;   /* of the snapshot file */
+        int64_t modified;   /* modification time of the HDF5 file */
+        uint64_t size;      /* size of the HDF5 file */
+        std::map< std::string, std::string > entries;   /* serialized results by operation, location and name */
+        bool dirty;         /* entries have been added since loading */
+    };
+    /** Attach the snapshot of an HDF5 file opened as read only, loading it if it matches the file.
+     */
+    void openSnapshot(hid_t file, std::string const& name);
+    /** Write a snapshot that gained entries, ignoring failures as snapshots are only a cache.
+     */
+    void saveSnapshot(Snapshot&);
+    /** Answer a metadata read from the snapshot of its file, or execute and record it.
+     *
+     * @return  False if the task is no metadata read or its file has no snapshot, i.e. it still has to be executed.
+     */
+    bool snapshotted(IOTask&);
+    /** Attach a path or dataset to its parent without accessing the file, e.g. when its opening is replayed.
+     */
+    void replayOpen(Writable*, std::string name);
+
+    /** Hand the memory image of an in-memory file to a background write, see HDF5Options::persistThreads.
+     */
+    void persistImage(hid_t file);
+    /** Wait for the background writes of memory images, of all files or only of the one with the given name.
+     *
+     * @throws  std::runtime_error  If writing an image failed.
+     */
+    void awaitImages(std::string const& name = std::string());
+
+    /** Write a region aligned to the chunks of a deflate-compressed dataset chunk by chunk, see HDF5Options::filterThreads.
+     *
+     * The chunks are compressed by m_filterThreads threads while the calling thread writes them raw.
+     *
+     * @param   memoryType  Native type of the elements of data.
+     * @return  False (without writing anything) if the dataset is not only deflate-compressed,
+     *          the region is not aligned to its chunks or the elements need type conversion.
+     */
+    bool writeChunksDirect(hid_t dataset, hid_t memoryType, Offset const&, Extent const&, void const* data);
+    /** Read a region aligned to the chunks of a deflate-compressed dataset chunk by chunk, see writeChunksDirect.
+     *
+     * The calling thread reads the raw chunks while m_filterThreads threads decompress them into data.
+     *
+     * @return  False (without reading anything) under the conditions of writeChunksDirect,
+     *          or if not all chunks of the region have been written.
+     */
+    bool readChunksDirect(hid_t dataset, hid_t memoryType, Offset const&, Extent const&, void* data);
+
+    /** Serializes calls into an HDF5 library that is not thread-safe, even across handlers
+     *  (e.g. IO threads and the workers of Series::openIterations). Unused if HDF5 is thread-safe.
+     */
+    static std::mutex& libraryMutex();
+
+    /** Decode an open HDF5 attribute.
+     *
+     * @throws  unsupported_data_error  If the attribute type is not part of the openPMD standard.
+     */
+    Attribute readAttributeValue(hid_t attr_id, std::string const& attr_name, Writable* writable);
 
     std::unordered_map< Writable*, hid_t > m_fileIDs;
     std::unordered_set< hid_t > m_openFileIDs;
 
+    std::unordered_map< Writable*, DatasetHandle > m_datasetHandles;
+    std::list< Writable* > m_datasetHandleLRU; /* most recently used first */
+    std::size_t m_maxDatasetHandles;
+    std::size_t m_maxChunkCacheBytes;
+
+    std::map< std::pair< hid_t, std::string >, GroupListing > m_groupListings;
+
     hid_t m_datasetTransferProperty;
     hid_t m_fileAccessProperty;
+    hid_t m_fileCreationProperty;
+    hid_t m_groupCreationProperty;
+    HDF5AttributeStorage m_attributeStorage;
 
     hid_t m_H5T_BOOL_ENUM;
+    /* native types of all fixed-size Datatypes (vectors by their elements), built on construction, -1 for strings */
+    std::array< hid_t, static_cast< std::size_t >(Datatype::BOOL) + 1 > m_H5Types;
+    std::unordered_map< std::size_t, hid_t > m_stringTypes;
+
+    bool m_persistOnFlush; /* write in-memory files to disk after processing tasks */
+    unsigned int m_persistThreads; /* 0 if in-memory files are written by the HDF5 backing store */
+    std::list< std::pair< std::string, std::future< void > > > m_pendingImages; /* background writes, oldest first */
+    unsigned int m_filterThreads; /* 0 if chunks are only filtered by HDF5 */
+    Allocation m_defaultAllocation; /* of datasets without one of their own or of the Series, DEFAULT for the one of HDF5 */
+    bool m_metadataSnapshots;
+    std::map< std::string, Snapshot > m_snapshots;          /* by path of the HDF5 file */
+    std::unordered_map< hid_t, Snapshot* > m_fileSnapshots; /* of open files */
 
     AbstractIOHandler* m_handler;
 };  //HDF5IOHandlerImpl
@@ -88,8 +309,36 @@ public:
     virtual ~HDF5IOHandler();
 
     std::future< void > flush() override;
+    /** Hand all operations in queue to a dedicated IO thread.
+     *
+     * The thread is started on first use and processes batches in the order they were handed over.
+     * Any subsequent call to flush() blocks until all previously handed batches have completed.
+     */
+    std::future< void > flushAsync() override;
+
+    /** Apply options to all files opened or created from now on.
+     */
+    void setOptions(HDF5Options const&);
+    HDF5Options const& options() const;
 
 private:
+    struct Batch
+    {
+        std::queue< IOTask > tasks;
+        std::promise< void > done;
+    };
+
+    void wait();
+    void work();
+
     std::unique_ptr< HDF5IOHandlerImpl > m_impl;
+    HDF5Options m_options;
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::queue< Batch > m_batches;
+    bool m_busy;
+    bool m_stop;
 };  //HDF5IOHandler
 } // openPMD
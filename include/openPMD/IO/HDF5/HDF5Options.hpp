@@ -0,0 +1,89 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+
+
+namespace openPMD
+{
+/** Storage of the attributes of groups and datasets created from now on (including the root group of new files).
+ */
+struct HDF5AttributeStorage
+{
+    /** Keep all attributes in dense storage (a fractal heap indexed by a B-tree) instead of the object header,
+     * e.g. for objects carrying many or large attributes. Overrides the thresholds below.
+     */
+    bool dense = false;
+    /** Maximum number of attributes kept in the object header before moving them to dense storage,
+     * and minimum number of attributes in dense storage before moving them back (see H5Pset_attr_phase_change).
+     * The HDF5 defaults (8 and 6) if both are 0, minDense must not exceed maxCompact.
+     */
+    unsigned int maxCompact = 0;
+    unsigned int minDense = 0;
+    /** Track and index the order in which attributes are created, so tools can list them in that order.
+     */
+    bool trackCreationOrder = false;
+};  //HDF5AttributeStorage
+
+/** Options of serial HDF5 Series.
+ */
+struct HDF5Options
+{
+    /** Keep every file in memory while it is open (HDF5 core driver).
+     * Written files are persisted to disk in one sequential write when they are closed,
+     * files opened for reading are loaded into memory in one read.
+     * Suited for small files made of many objects, e.g. diagnostics.
+     */
+    bool inMemory = false;
+    /** Bytes by which the memory image of a file grows, 1 MiB if 0. Only used with inMemory.
+     */
+    uint64_t memoryIncrement = 0;
+    /** Also write the modified parts of in-memory files to disk at the end of each flush,
+     * instead of only when they are closed. Only used with inMemory.
+     */
+    bool persistOnFlush = false;
+    /** Number of threads writing the memory images of closed files to disk, 0 to let HDF5 write them while closing.
+     * Only used with inMemory and without persistOnFlush.
+     * Files closed one after another (e.g. the iterations of a fileBased Series) are then written concurrently,
+     * while HDF5 continues with the following operations. Re-opening a file waits for its write,
+     * all writes are complete once the Series is destroyed.
+     */
+    unsigned int persistThreads = 0;
+    /** Cache the results of all metadata reads (structure, extents, datatypes and attributes) of files opened as read only
+     * in a binary snapshot next to each file, in the directory .openPMD-snapshots.
+     * On re-opening a file whose modification time and size match its snapshot, the metadata is taken from the snapshot
+     * instead of traversing the file. Snapshots are updated when files are closed, failures to write them are ignored.
+     */
+    bool metadataSnapshots = false;
+    /** Number of threads compressing and decompressing the chunks of deflate-compressed datasets, 0 to let HDF5 filter them.
+     * HDF5 runs filters on a single thread inside each write and read. With threads, writes and reads of regions
+     * aligned to the chunks of a dataset compressed only with deflate (e.g. Dataset::setCompression("zlib", 4))
+     * are split into its chunks, which are compressed or decompressed by the threads while the calling thread
+     * moves them to and from the file raw (H5Dwrite_chunk, H5Dread_chunk). The files are the same either way.
+     * All other writes and reads are filtered by HDF5. Requires HDF5 1.10.3 and zlib, ignored otherwise.
+     */
+    unsigned int filterThreads = 0;
+    /** Storage of the attributes of created groups and datasets.
+     */
+    HDF5AttributeStorage attributeStorage;
+};  //HDF5Options
+} // openPMD
@@ -21,15 +21,24 @@
 #pragma once
 
 #include "openPMD/IO/AbstractIOHandler.hpp"
+#include "openPMD/IO/HDF5/ParallelHDF5Options.hpp"
 
 #if openPMD_HAVE_HDF5 && openPMD_HAVE_MPI
+#   include "openPMD/auxiliary/Serialization.hpp"
 #   include "openPMD/IO/HDF5/HDF5IOHandler.hpp"
 #   include <mpi.h>
 #endif
 
+#include <condition_variable>
 #include <future>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 
 namespace openPMD
@@ -43,8 +52,136 @@ public:
     ParallelHDF5IOHandlerImpl(AbstractIOHandler*, MPI_Comm);
     virtual ~ParallelHDF5IOHandlerImpl();
 
+    void setOptions(ParallelHDF5Options const&);
+
+    /** Process all operations in queue.
+     *
+     * If metadata is broadcast, consecutive metadata reads are executed only by the metadata readers,
+     * which then broadcast their results, all other operations are executed by all ranks.
+     */
+    std::future< void > flush() override;
+    /** @return True if metadata reads are executed by the metadata readers only. */
+    bool broadcastsMetadata() const;
+
+    void createFile(Writable*, Parameter< Operation::CREATE_FILE > const&) override;
+    /** Issue the deferred writes to the file before closing it, see completeBatch(), and write the index of a subfile. */
+    void closeFile(Writable*, Parameter< Operation::CLOSE_FILE > const&) override;
+    /** In a subfile, create the dataset without any storage, its regions are stored by completeBatch(). */
+    void createDataset(Writable*, Parameter< Operation::CREATE_DATASET > const&) override;
+    void extendDataset(Writable*, Parameter< Operation::EXTEND_DATASET > const&) override;
+    /** Write a chunk independently, or defer it to completeBatch() if it is transferred collectively or written to a subfile. */
+    void writeDataset(Writable*, Parameter< Operation::WRITE_DATASET > const&) override;
+    /** Issue the deferred writes of all ranks in the same order (collective over the communicator),
+     * then update the index of modified subfiles.
+     *
+     * Ranks that deferred fewer collective writes to a dataset than others take part with empty selections.
+     */
+    void completeBatch() override;
+    /** Announce the failure of this rank in place of its collective writes (collective over the communicator).
+     *
+     * No rank issues the collective writes of a batch that has failed on any rank.
+     */
+    void abortBatch() override;
+    void openPath(Writable*, Parameter< Operation::OPEN_PATH > const&) override;
+    void openDataset(Writable*, Parameter< Operation::OPEN_DATASET > &) override;
+    void readAttribute(Writable*, Parameter< Operation::READ_ATT > &) override;
+    void readAttributes(Writable*, Parameter< Operation::READ_ATTS > &) override;
+    void listPaths(Writable*, Parameter< Operation::LIST_PATHS > &) override;
+    void listDatasets(Writable*, Parameter< Operation::LIST_DATASETS > &) override;
+    void listAttributes(Writable*, Parameter< Operation::LIST_ATTS > &) override;
+
     MPI_Comm m_mpiComm;
     MPI_Info m_mpiInfo;
+
+private:
+    struct DeferredWrite
+    {
+        Writable* writable;
+        Parameter< Operation::WRITE_DATASET > parameters;
+        hid_t transferProperty;
+        std::string storage;    /* dataset of a subfile holding the chunk, at the offset of the parameters */
+    };
+    /* by file name and dataset path, an order shared by all ranks */
+    using DeferredWrites = std::map< std::pair< std::string, std::string >, std::vector< DeferredWrite > >;
+
+    /** @return The file holding the dataset of a Writable. */
+    hid_t fileOf(Writable*) const;
+    /** Take part in count collective writes to a dataset with empty selections, if its file is open on this rank.
+     */
+    void writeEmpty(std::string const& fileName, std::string const& path, uint64_t count);
+    /** Agree with all ranks whether any of them has failed, then exchange and issue the deferred writes unless one has.
+     *
+     * @throws  std::runtime_error  If another rank has failed, once all ranks know about it.
+     */
+    void settleBatch(bool failed);
+    /** Store the deferred writes to subfiles in datasets of their subfiles (collective over each group).
+     *
+     * Per batch and dataset, each group creates one dataset in its subfile, covering the bounding box
+     * of the regions written by the group. Writes transferred collectively are added to collective,
+     * all others are issued right away.
+     */
+    void storeInSubfiles(DeferredWrites&& subfileWrites, DeferredWrites& collective);
+    /** Issue the deferred collective writes of all ranks in the same order (collective over the communicator).
+     */
+    void writeCollectively(DeferredWrites const&);
+    /** Write a chunk into the dataset of a subfile storing it. */
+    void writeStored(DeferredWrite const&);
+    /** Write the index of all subfiles modified by any rank since the last time (collective over the communicator).
+     * Subfiles are closed for the index to be written and opened again.
+     */
+    void indexSubfiles();
+
+    /** Run a metadata read, on metadata readers record its outputs (or its error), on all other ranks replay those.
+     */
+    template< typename F_Execute, typename F_Store, typename F_Load >
+    void broadcastable(F_Execute, F_Store, F_Load);
+
+    /** Region of a dataset written by this rank, and where it is stored in the subfile. */
+    struct StoredRegion
+    {
+        Offset offset;
+        Extent extent;
+        std::string storage;    /* dataset of the subfile */
+        Offset storageOffset;
+        Extent storageExtent;   /* of the whole storage dataset */
+    };
+    /** Datasets of a subfile hold no data, it is stored in regions of datasets of their own.
+     */
+    struct Subfile
+    {
+        std::string index;  /* path of the index file */
+        std::string name;   /* path of the subfile relative to the directory of the index */
+        /* extent of each dataset in the index, and whether it is fixed, by absolute dataset path */
+        std::map< std::string, std::pair< Extent, bool > > extents;
+        std::map< std::string, std::vector< StoredRegion > > regions;
+        uint64_t storages = 0;  /* number of datasets created to store regions */
+        bool modified = true;   /* since the index has been written */
+    };
+    /** Collectively gather the written regions of all ranks and let the first rank write the index file.
+     * All subfiles must have been closed.
+     */
+    void writeSubfileIndex(Subfile const&);
+
+    bool m_broadcastMetadata;
+    /* ranks receiving the metadata of one reader, with the reader as rank 0 */
+    MPI_Comm m_metadataComm;
+    int m_metadataRank;
+    auxiliary::Serializer m_metadataLog;
+    auxiliary::Deserializer m_metadataReplay;
+
+    /* ranks writing the same subfile, MPI_COMM_NULL if not writing subfiles */
+    MPI_Comm m_subfileComm;
+    int m_subfileIndex;
+    std::map< hid_t, Subfile > m_subfiles;
+
+    Transfer m_defaultTransfer;
+    hid_t m_independentTransferProperty;
+    /* collective writes of the current batch */
+    DeferredWrites m_collectiveWrites;
+    /* all writes to datasets of subfiles of the current batch */
+    DeferredWrites m_subfileWrites;
+    /* the ranks have exchanged the outcome of the batch, a failure from here on needs no announcement */
+    bool m_batchSettling;
 };  //ParallelHDF5IOHandlerImpl
 #else
 class ParallelHDF5IOHandlerImpl
@@ -62,8 +199,36 @@ public:
     virtual ~ParallelHDF5IOHandler();
 
     std::future< void > flush() override;
+    /** Hand all operations in queue to a dedicated IO thread, which executes the collective operations of them.
+     *
+     * Requires MPI to be initialized with MPI_THREAD_MULTIPLE, so the application may keep communicating
+     * while the IO thread writes. Otherwise, and for batches containing metadata reads broadcast
+     * from the metadata readers, the operations are processed before returning.
+     * Any subsequent call to flush() blocks until all previously handed batches have completed.
+     */
+    std::future< void > flushAsync() override;
+
+    /** Must be set before the first operation, i.e. on construction of the Series.
+     */
+    void setOptions(ParallelHDF5Options const&);
 
 private:
+    struct Batch
+    {
+        std::queue< IOTask > tasks;
+        std::promise< void > done;
+    };
+
+    void wait();
+    void work();
+
     std::unique_ptr< ParallelHDF5IOHandlerImpl > m_impl;
+
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::queue< Batch > m_batches;
+    bool m_busy;
+    bool m_stop;
 };  //ParallelHDF5IOHandler
 } // openPMD
@@ -0,0 +1,107 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "openPMD/Dataset.hpp"
+#include "openPMD/IO/HDF5/HDF5Options.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+
+namespace openPMD
+{
+/** Options of parallel HDF5 Series.
+ */
+struct ParallelHDF5Options
+{
+    /** Ranks that traverse the hierarchy and read the attributes of a file opened as read only.
+     */
+    enum class MetadataReaders
+    {
+        ALL,            //!< every rank reads all metadata from the file
+        ONE,            //!< the first rank reads the metadata and broadcasts it to all others
+        ONE_PER_NODE    //!< the first rank on each shared-memory node reads the metadata and broadcasts it to its node
+    };  //MetadataReaders
+
+    /** With any setting but ALL, each flush of the Series is collective over its communicator.
+     * Ranks only open datasets themselves when they read data from them.
+     */
+    MetadataReaders metadataReaders = MetadataReaders::ALL;
+
+    /** Perform all metadata reads collectively, i.e. one rank reads and broadcasts inside HDF5 (HDF5 1.10+).
+     * Can not be combined with metadataReaders other than ALL.
+     */
+    bool collectiveMetadataOps = false;
+    /** Write metadata to the file with collective MPI-IO calls instead of independent ones (HDF5 1.10+).
+     */
+    bool collectiveMetadataWrite = false;
+    /** Align all file objects of at least alignmentThreshold bytes to multiples of alignment bytes,
+     * e.g. to the stripe size of the file system. No alignment if 0.
+     */
+    uint64_t alignment = 0;
+    uint64_t alignmentThreshold = 0;
+    /** Minimum size in bytes of the blocks allocated for metadata, the HDF5 default (2 KiB) if 0.
+     */
+    uint64_t metadataBlockSize = 0;
+    /** Initial size in bytes of the metadata cache of each open file, the HDF5 default if 0.
+     */
+    uint64_t metadataCacheSize = 0;
+    /** MPI-IO hints the files are opened with, e.g. {{"cb_nodes", "16"}, {"striping_factor", "64"}}.
+     */
+    std::map< std::string, std::string > mpiHints;
+
+    /** Groups of ranks that write a shared subfile when creating a Series.
+     */
+    enum class Subfiles
+    {
+        NONE,       //!< all ranks write to the file itself
+        PER_NODE,   //!< the ranks of each shared-memory node write one subfile
+        PER_GROUP   //!< each ranksPerSubfile consecutive ranks write one subfile
+    };  //Subfiles
+
+    /** With any setting but NONE, each group of ranks writes its data to a subfile of its own (N-to-M output),
+     * stored as <name>_subfiles/<group>.h5 next to the file. Each group stores the regions it writes in a flush
+     * in datasets spanning only these regions. At the end of every flush and on closing the file, the first rank
+     * writes the file itself as a small index whose datasets are HDF5 virtual datasets mapping the regions of
+     * all groups to their subfiles, so the Series is read just like any other (HDF5 1.10+).
+     * Ignored when reading, not supported when modifying an existing Series.
+     */
+    Subfiles subfiles = Subfiles::NONE;
+    uint32_t ranksPerSubfile = 0;
+
+    /** Storage of the attributes of created groups and datasets.
+     */
+    HDF5AttributeStorage attributeStorage;
+
+    /** Transfer of the chunks of datasets that keep Transfer::DEFAULT (see Dataset::setTransfer).
+     *
+     * With COLLECTIVE, collective chunks are written at the end of each flush, in the same order on all ranks:
+     * a rank that wrote fewer chunks into a dataset than others (or none) takes part with empty selections,
+     * so ranks without data (e.g. particles) need not issue empty stores themselves.
+     * Flushing a Series opened for writing is then collective over its communicator.
+     * With INDEPENDENT, flushes do not synchronize the ranks, chunks of datasets set to COLLECTIVE
+     * are written in place and all ranks have to write them in lockstep.
+     */
+    Transfer transfer = Transfer::COLLECTIVE;
+};  //ParallelHDF5Options
+} // openPMD
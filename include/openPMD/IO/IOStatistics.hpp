@@ -0,0 +1,208 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "openPMD/IO/IOTask.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace openPMD
+{
+/** Accumulated measurements of all IO operations of one type.
+ */
+struct OperationStatistics
+{
+    static constexpr std::size_t numBins = 32;
+
+    uint64_t count = 0;
+    /** Size of the dataset chunks transferred (only counted for WRITE_DATASET, READ_DATASET and MAP_DATASET). */
+    uint64_t bytes = 0;
+    /** Cumulative wall time in seconds. */
+    double seconds = 0.;
+    /** Wall time distribution: bin 0 counts operations below one microsecond, bin i those in [2^(i-1), 2^i) microseconds. */
+    std::array< uint64_t, numBins > histogram{};
+};  //OperationStatistics
+
+/** Per-Operation statistics of a backend, recorded while processing its task queue.
+ *
+ * Optionally, every processed task is additionally traced as an event with the times it has been enqueued,
+ * dispatched to and completed by the backend (see startTrace()).
+ *
+ * Only available if openPMD-api is built with openPMD_USE_INSTRUMENTATION=ON,
+ * otherwise all measurements are no-ops and no statistics are recorded.
+ * Backends that defer transfers (e.g. ADIOS) only account for scheduling the transfer in its Operation.
+ */
+class IOStatistics
+{
+public:
+    /** Location of a Writable inside its file, as computed by the backend (e.g. concrete_h5_file_position). */
+    using Position = std::string (*)(Writable*);
+
+    /** Scope of one processed IOTask, records its wall time on destruction.
+     */
+    class Measurement
+    {
+    public:
+#if openPMD_HAVE_INSTRUMENTATION
+        Measurement(IOStatistics* statistics, IOTask const& task, uint64_t bytes, Position position)
+                : m_statistics{statistics},
+                  m_operation{task.operation},
+                  m_bytes{bytes},
+                  m_enqueued{task.enqueued},
+                  m_start{std::chrono::steady_clock::now()},
+                  m_writable{task.writable},
+                  m_position{position}
+        { }
+        Measurement(Measurement&& other)
+                : m_statistics{other.m_statistics},
+                  m_operation{other.m_operation},
+                  m_bytes{other.m_bytes},
+                  m_enqueued{other.m_enqueued},
+                  m_start{other.m_start},
+                  m_writable{other.m_writable},
+                  m_position{other.m_position}
+        {
+            other.m_statistics = nullptr;
+        }
+        ~Measurement()
+        {
+            if( !m_statistics )
+                return;
+            auto const end = std::chrono::steady_clock::now();
+            /* resolved once the task has run, so objects it has just created have their position */
+            if( m_statistics->m_tracing && m_position )
+            {
+                try
+                {
+                    m_path = m_position(m_writable);
+                } catch( ... )
+                { }
+            }
+            m_statistics->record(*this, end);
+        }
+
+    private:
+        friend class IOStatistics;
+
+        IOStatistics* m_statistics;
+        Operation m_operation;
+        uint64_t m_bytes;
+        std::chrono::steady_clock::time_point m_enqueued;
+        std::chrono::steady_clock::time_point m_start;
+        Writable* m_writable;
+        Position m_position;
+        std::string m_path;
+#else
+        Measurement() = default;
+        Measurement(Measurement&&) = default;
+        /* user-provided, so an unused guard does not warn in builds without instrumentation */
+        ~Measurement() { }
+#endif
+    };  //Measurement
+
+    IOStatistics() = default;
+    IOStatistics(IOStatistics const&) = delete;
+    IOStatistics& operator=(IOStatistics const&) = delete;
+    /** Writes a trace that has not been stopped yet. */
+    ~IOStatistics();
+
+    /** Start measuring the processing of a task.
+     *
+     * @param   position    Computes the location of the task's Writable for traced events once the task has run, may be empty.
+     */
+    Measurement measure(IOTask const& task, Position position = nullptr)
+    {
+#if openPMD_HAVE_INSTRUMENTATION
+        return Measurement(this, task, transferredBytes(task), position);
+#else
+        (void)task;
+        (void)position;
+        return Measurement();
+#endif
+    }
+
+    /**
+     * @return  Copy of the statistics of all Operations that have been processed at least once.
+     */
+    std::map< Operation, OperationStatistics > snapshot() const;
+    /** Discard all statistics recorded so far.
+     */
+    void reset();
+
+    /** Start tracing all processed tasks, replacing a trace that is currently recorded.
+     *
+     * The trace is written in Chrome trace event format (viewable with Perfetto, chrome://tracing or converted for Vampir),
+     * with one complete event per task spanning from its dispatch to its completion.
+     * The time the task has been enqueued, its location in the file (the parent location for objects that are being created)
+     * and the transferred bytes are attached as arguments.
+     *
+     * @param   filename    File the trace is written to when tracing stops.
+     * @param   pid         Process id of all events, e.g. the MPI rank.
+     * @throws  std::runtime_error  If openPMD-api is built without openPMD_USE_INSTRUMENTATION.
+     */
+    void startTrace(std::string const& filename, int pid = 0);
+    /** Write the current trace and stop tracing (no-op if no trace is recorded).
+     */
+    void stopTrace();
+
+private:
+    struct Event
+    {
+        Operation operation;
+        std::string path;
+        uint64_t bytes;
+        std::chrono::steady_clock::time_point enqueued;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+        std::thread::id thread;
+    };  //Event
+
+    static uint64_t transferredBytes(IOTask const&);
+#if openPMD_HAVE_INSTRUMENTATION
+    void record(Measurement&, std::chrono::steady_clock::time_point end);
+#endif
+
+    mutable std::mutex m_mutex;
+    std::map< Operation, OperationStatistics > m_operations;
+
+    std::atomic< bool > m_tracing{false};
+    std::string m_traceFile;
+    int m_tracePid = 0;
+    std::chrono::steady_clock::time_point m_traceStart;
+    std::vector< Event > m_events;
+};  //IOStatistics
+} // openPMD
+
+namespace std
+{
+    ostream&
+    operator<<(ostream&, openPMD::Operation);
+} // std
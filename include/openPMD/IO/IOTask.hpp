@@ -1,54 +1,34 @@
 #pragma once
 
-#include "openPMD/auxiliary/Variadic.hpp"
 #include "openPMD/backend/Attribute.hpp"
 #include "openPMD/backend/Writable.hpp"
 #include "openPMD/Dataset.hpp"
 
-#include <memory>
+#if openPMD_HAVE_INSTRUMENTATION
+#   include <chrono>
+#endif
+#include <functional>
+#include <future>
+#include <list>
 #include <map>
+#include <memory>
+#include <queue>
 #include <vector>
 #include <string>
+#include <utility>
 
 
 namespace openPMD
 {
-/** Concrete datatype of an object available at runtime.
- */
-enum class ArgumentDatatype : int
-{
-    STRING = 0,
-    VEC_UINT64,
-    PTR_VOID,
-    SHARED_PTR_VOID,
-    DATATYPE,
-    ATT_RESOURCE,
-    SHARED_PTR_EXTENT,
-    SHARED_PTR_DATATYPE,
-    SHARED_PTR_ATT_RESOURCE,
-    SHARED_PTR_VEC_STRING,
-
-    UNDEFINED
-};
-using ParameterArgument = auxiliary::Variadic< ArgumentDatatype,
-                                    std::string,
-                                    std::vector< uint64_t >,
-                                    void*,
-                                    std::shared_ptr< void >,
-                                    Datatype,
-                                    Attribute::resource,
-                                    std::shared_ptr< Extent >,
-                                    std::shared_ptr< Datatype >,
-                                    std::shared_ptr< Attribute::resource >,
-                                    std::shared_ptr< std::vector< std::string > > >;
-
 /** Type of IO operation between logical and persistent data.
  */
 enum class Operation
 {
     CREATE_FILE,
     OPEN_FILE,
+    CLOSE_FILE,
     DELETE_FILE,
+    ADVANCE,
 
     CREATE_PATH,
     OPEN_PATH,
@@ -61,14 +41,41 @@ enum class Operation
     DELETE_DATASET,
     WRITE_DATASET,
     READ_DATASET,
+    MAP_DATASET,
     LIST_DATASETS,
 
     DELETE_ATT,
     WRITE_ATT,
     READ_ATT,
-    LIST_ATTS
+    READ_ATTS,
+    LIST_ATTS,
+
+    /* appended, as snapshots of metadata reads are keyed by the numeric operation */
+    WRITE_ATTS
 };  //Operation
 
+/** Result of moving a stream to its next step.
+ */
+enum class AdvanceStatus
+{
+    OK,     //!< the next step is available
+    OVER    //!< there are no further steps (e.g. the writer has closed the stream, or the file is not a stream)
+};  //AdvanceStatus
+
+
+/** @brief Common base of all Parameter types.
+ *
+ * Allows an IOTask to own the typed Parameter of any Operation without
+ * converting it into a generic representation.
+ */
+struct AbstractParameter
+{
+    virtual ~AbstractParameter() = default;
+
+    /** Create an owning copy of the most derived Parameter.
+     */
+    virtual std::unique_ptr< AbstractParameter > clone() const = 0;
+};  //AbstractParameter
 
 /** @brief Typesafe description of all required Arguments for a specified Operation.
  *
@@ -79,146 +86,353 @@ enum class Operation
  * @tparam  Operation   Type of Operation to be executed.
  */
 template< Operation >
-struct Parameter
-{ };
+struct Parameter : public AbstractParameter
+{
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter(*this));
+    }
+};
 
 template<>
-struct Parameter< Operation::CREATE_FILE >
+struct Parameter< Operation::CREATE_FILE > : public AbstractParameter
 {
     std::string name;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::CREATE_FILE >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::OPEN_FILE >
+struct Parameter< Operation::OPEN_FILE > : public AbstractParameter
 {
     std::string name;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::OPEN_FILE >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::DELETE_FILE >
+struct Parameter< Operation::CLOSE_FILE > : public AbstractParameter
+{
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::CLOSE_FILE >(*this));
+    }
+};
+
+template<>
+struct Parameter< Operation::DELETE_FILE > : public AbstractParameter
 {
     std::string name;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::DELETE_FILE >(*this));
+    }
+};
+
+/** @brief Finish the current step of a streamed file and wait for the next one.
+ */
+template<>
+struct Parameter< Operation::ADVANCE > : public AbstractParameter
+{
+    std::shared_ptr< AdvanceStatus > status
+            = std::make_shared< AdvanceStatus >(AdvanceStatus::OVER);
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::ADVANCE >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::CREATE_PATH >
+struct Parameter< Operation::CREATE_PATH > : public AbstractParameter
 {
     std::string path;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::CREATE_PATH >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::OPEN_PATH >
+struct Parameter< Operation::OPEN_PATH > : public AbstractParameter
 {
     std::string path;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::OPEN_PATH >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::DELETE_PATH >
+struct Parameter< Operation::DELETE_PATH > : public AbstractParameter
 {
     std::string path;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::DELETE_PATH >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::LIST_PATHS >
+struct Parameter< Operation::LIST_PATHS > : public AbstractParameter
 {
     std::shared_ptr< std::vector< std::string > > paths
             = std::make_shared< std::vector< std::string > >();
+    /* observe paths added to the file since it has been opened, instead of answering from cached listings */
+    bool refresh = false;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::LIST_PATHS >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::CREATE_DATASET >
+struct Parameter< Operation::CREATE_DATASET > : public AbstractParameter
 {
     std::string name;
     Extent extent;
-    Datatype dtype;
+    Datatype dtype = Datatype::UNDEFINED;
     Extent chunkSize;
     std::string compression;
     std::string transform;
+    /** Allocation of the dataset (see Dataset::setAllocation), the one of the handler if DEFAULT. */
+    Allocation allocation;
+    /** The extent is final, so the dataset need not be chunked (see Dataset::setFixedSize). */
+    bool fixedSize = false;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::CREATE_DATASET >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::EXTEND_DATASET >
+struct Parameter< Operation::EXTEND_DATASET > : public AbstractParameter
 {
     std::string name;
     Extent extent;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::EXTEND_DATASET >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::OPEN_DATASET >
+struct Parameter< Operation::OPEN_DATASET > : public AbstractParameter
 {
     std::string name;
     std::shared_ptr< Datatype > dtype
             = std::make_shared< Datatype >();
     std::shared_ptr< Extent > extent
             = std::make_shared< Extent >();
+    /** Shape of the chunks the dataset is stored in, stays empty if the dataset is not chunked. */
+    std::shared_ptr< Extent > chunkSize
+            = std::make_shared< Extent >();
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::OPEN_DATASET >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::DELETE_DATASET >
+struct Parameter< Operation::DELETE_DATASET > : public AbstractParameter
 {
     std::string name;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::DELETE_DATASET >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::WRITE_DATASET >
+struct Parameter< Operation::WRITE_DATASET > : public AbstractParameter
 {
     Extent extent;
     Offset offset;
-    Datatype dtype;
+    Datatype dtype = Datatype::UNDEFINED;
     std::shared_ptr< void > data;
+    /** Distance in values between consecutive values of the chunk in data, e.g. the size of a struct for one member of an array of structs. */
+    std::size_t memoryStride = 1;
+    /** Shape of the buffer data points to if the chunk is only a part of it (e.g. the interior of a patch with guard cells), empty otherwise. */
+    Extent memoryExtent;
+    /** Offset of the chunk inside a buffer of shape memoryExtent. */
+    Offset memoryOffset;
+    /** Chunk cache of the dataset (see Dataset::setChunkCache), the one of the handler if empty. */
+    ChunkCache chunkCache;
+    /** Transfer of the chunk by the ranks of a parallel Series (see Dataset::setTransfer). */
+    Transfer transfer = Transfer::DEFAULT;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::WRITE_DATASET >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::READ_DATASET >
+struct Parameter< Operation::READ_DATASET > : public AbstractParameter
 {
     Extent extent;
     Offset offset;
-    Datatype dtype;
+    /** Distance between the selected blocks in every dimension, empty to read the whole region. */
+    Extent stride;
+    /** Size of the selected blocks in every dimension, empty for single elements. Only used with a stride. */
+    Extent block;
+    /** Boxes (offset, extent) read one after another into data instead of the region above, empty if not used. */
+    std::vector< std::pair< Offset, Extent > > regions;
+    /** Coordinates (one value per dimension for every element) of single elements read one after another into data
+     *  instead of the region above, empty if not used. */
+    std::vector< uint64_t > points;
+    /** Chunk cache of the dataset (see Dataset::setChunkCache), the one of the handler if empty. */
+    ChunkCache chunkCache;
+    Datatype dtype = Datatype::UNDEFINED;
     void* data = nullptr;
+    /** Distance in values between consecutive values read into data, e.g. the size of a struct for one member of an array of structs. */
+    std::size_t memoryStride = 1;
+    /** Reverse the order of the dimensions of the (selected) chunk in data, i.e. store it column-major. */
+    bool transpose = false;
+    /** Factor applied to every value while reading (e.g. for unitSI conversion). */
+    double scale = 1.;
+    /** Optional owner of data, kept alive until the Operation has completed. */
+    std::shared_ptr< void > buffer;
+    /** Optional step run once data has been read, before done is fulfilled (e.g. a copy of data to device memory). */
+    std::function< void() > finish;
+    /** Optional notification, fulfilled once data has been read (or the read has failed). */
+    std::shared_ptr< std::promise< void > > done;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::READ_DATASET >(*this));
+    }
+};
+
+template<>
+struct Parameter< Operation::MAP_DATASET > : public AbstractParameter
+{
+    Extent extent;
+    Offset offset;
+    Datatype dtype = Datatype::UNDEFINED;
+    /** Read-only view of the chunk inside the memory-mapped file, stays empty if the backend can not map the chunk. */
+    std::shared_ptr< std::shared_ptr< void const > > view
+            = std::make_shared< std::shared_ptr< void const > >();
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::MAP_DATASET >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::LIST_DATASETS >
+struct Parameter< Operation::LIST_DATASETS > : public AbstractParameter
 {
     std::shared_ptr< std::vector< std::string > > datasets
             = std::make_shared< std::vector< std::string > >();
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::LIST_DATASETS >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::DELETE_ATT >
+struct Parameter< Operation::DELETE_ATT > : public AbstractParameter
 {
     std::string name;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::DELETE_ATT >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::WRITE_ATT >
+struct Parameter< Operation::WRITE_ATT > : public AbstractParameter
 {
     Attribute::resource resource;
     std::string name;
-    Datatype dtype;
+    Datatype dtype = Datatype::UNDEFINED;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::WRITE_ATT >(*this));
+    }
+};
+
+/** @brief Bulk write of attributes of one object.
+ *
+ * Equivalent to one WRITE_ATT per attribute in the given order,
+ * but lets backends access the object only once.
+ */
+template<>
+struct Parameter< Operation::WRITE_ATTS > : public AbstractParameter
+{
+    std::vector< Parameter< Operation::WRITE_ATT > > attributes;
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::WRITE_ATTS >(*this));
+    }
 };
 
 template<>
-struct Parameter< Operation::READ_ATT >
+struct Parameter< Operation::READ_ATT > : public AbstractParameter
 {
     std::string name;
     std::shared_ptr< Datatype > dtype
             = std::make_shared< Datatype >();
     std::shared_ptr< Attribute::resource > resource
             = std::make_shared< Attribute::resource >();
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::READ_ATT >(*this));
+    }
 };
 
+/** @brief Bulk read of all attributes of one object.
+ *
+ * Attributes of unsupported (non-standard) types are not read,
+ * but reported in skipped together with the reason.
+ */
 template<>
-struct Parameter< Operation::LIST_ATTS >
+struct Parameter< Operation::READ_ATTS > : public AbstractParameter
+{
+    std::shared_ptr< std::map< std::string, Attribute > > attributes
+            = std::make_shared< std::map< std::string, Attribute > >();
+    std::shared_ptr< std::map< std::string, std::string > > skipped
+            = std::make_shared< std::map< std::string, std::string > >();
+
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::READ_ATTS >(*this));
+    }
+};
+
+template<>
+struct Parameter< Operation::LIST_ATTS > : public AbstractParameter
 {
     std::shared_ptr< std::vector< std::string > > attributes
             = std::make_shared< std::vector< std::string > >();
-};
 
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< Operation::LIST_ATTS >(*this));
+    }
+};
 
-template< Operation o >
-std::map< std::string, ParameterArgument >
-structToMap(Parameter< o > const&);
 
 /** @brief Self-contained description of a single IO operation.
  *
@@ -242,11 +456,46 @@ public:
            Parameter< op > const& p)
             : writable{w},
               operation{op},
-              parameter{structToMap(p)}
+              parameter{p.clone()}
+    { }
+    /** Constructor for self-contained description of single IO operation, taking over the contents of an expiring Parameter.
+     *
+     * @tparam  op  Type of Operation to be executed.
+     * @param   w   Writable indicating the location of the object being operated on.
+     * @param   p   Parameter object supplying all required input parameters, moved into the task (e.g. to avoid copying attribute values).
+     */
+    template< Operation op >
+    IOTask(Writable* w,
+           Parameter< op >&& p)
+            : writable{w},
+              operation{op},
+              parameter{std::make_shared< Parameter< op > >(std::move(p))}
     { }
 
+    /** Typed access to the Parameter this task was constructed with.
+     *
+     * @tparam  op  Type of Operation this task was constructed for (must match operation).
+     */
+    template< Operation op >
+    Parameter< op >&
+    getParameter() const
+    {
+        return *static_cast< Parameter< op >* >(parameter.get());
+    }
+
     Writable* writable;
     Operation operation;
-    std::map< std::string, ParameterArgument > parameter;
+    std::shared_ptr< AbstractParameter > parameter;
+#if openPMD_HAVE_INSTRUMENTATION
+    /** Time the task has been handed to AbstractIOHandler::enqueue(). */
+    std::chrono::steady_clock::time_point enqueued = std::chrono::steady_clock::now();
+#endif
 };  //IOTask
+
+/** Tasks pending on one object, e.g. the chunks staged by a record component.
+ *
+ * Backed by a list, which unlike the default std::deque does not allocate while empty,
+ * as every component of large hierarchies holds one.
+ */
+using IOTaskQueue = std::queue< IOTask, std::list< IOTask > >;
 } // openPMD
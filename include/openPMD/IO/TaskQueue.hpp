@@ -0,0 +1,69 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "openPMD/IO/IOTask.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <queue>
+
+
+namespace openPMD
+{
+/** Queue of IOTasks filled by any number of threads and drained by one consumer at a time.
+ *
+ * Pushing is lock-free: tasks are prepended to an atomic list of pending tasks,
+ * which the consumer takes over as a whole and moves behind the tasks it has not processed yet.
+ */
+class TaskQueue
+{
+public:
+    TaskQueue() = default;
+    TaskQueue(TaskQueue const&) = delete;
+    TaskQueue& operator=(TaskQueue const&) = delete;
+    ~TaskQueue();
+
+    /** Add a task behind all previously pushed ones, may be called from any thread at any time.
+     */
+    void push(IOTask);
+    /** Take over all tasks pushed so far (consumer only).
+     *
+     * @return  All outstanding tasks in FIFO order, to be processed and popped in place.
+     *          Tasks left in it stay ahead of the ones pushed later and are returned again by the next call.
+     */
+    std::queue< IOTask >& collect();
+    /** Number of tasks pushed and not popped yet (consumer only), tasks pushed concurrently may or may not be counted.
+     */
+    std::size_t size() const;
+
+private:
+    struct Node
+    {
+        IOTask task;
+        Node* next;
+    };
+
+    std::atomic< Node* > m_pushed{nullptr};    /* most recently pushed first */
+    std::atomic< std::size_t > m_numPushed{0}; /* length of the list of m_pushed, counted ahead of linking */
+    std::queue< IOTask > m_collected;
+};  //TaskQueue
+} // openPMD
@@ -0,0 +1,94 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace openPMD
+{
+class Writable;
+
+/** How chunks registered with RecordComponent::storeChunk are held until they are written.
+ */
+enum class StagingMode
+{
+    REFERENCE,  //!< keep a reference to the user buffer, which must not be modified until it is written
+    COPY        //!< copy the chunk, the user buffer can be re-used right away
+};  //StagingMode
+
+/** Snapshot of the chunks of a Series that have not been written yet.
+ */
+struct StagingStatus
+{
+    std::size_t budget;         //!< bytes that trigger an automatic flush, 0 if unlimited
+    std::size_t stagedBytes;    //!< bytes of chunks registered since the last flush
+    std::size_t stagedChunks;   //!< number of chunks registered since the last flush
+    std::uint64_t autoFlushes;  //!< number of flushes triggered by exceeding the budget
+    bool flushing;              //!< true while the data of an automatic or asynchronous flush is still being written
+};  //StagingStatus
+
+/** Chunks staged for one record component.
+ */
+struct PendingComponent
+{
+    std::string path;       //!< position in the object model, e.g. "iterations/100/meshes/E/x"
+    std::size_t bytes;      //!< bytes of its chunks registered since the last flush
+    std::size_t chunks;     //!< number of those chunks
+};  //PendingComponent
+
+/** Snapshot of the work the next flush of a Series performs.
+ */
+struct PendingWrites
+{
+    std::size_t stagedBytes;    //!< bytes of chunks registered since the last flush
+    std::size_t stagedChunks;   //!< number of those chunks, each handed to the backend as (at most) one write
+    std::size_t queuedTasks;    //!< other operations already enqueued, e.g. creation of groups, attributes and reads
+    std::vector< PendingComponent > largest;    //!< components holding the most staged bytes, most first
+};  //PendingWrites
+
+/** Budget and bookkeeping of staged chunks, shared by all objects of a Series through their IOHandler.
+ */
+struct WriteStaging
+{
+    std::size_t budget = 0;
+    StagingMode mode = StagingMode::REFERENCE;
+    /** Write the chunk data of every flush in the background, see Series::setAsyncWrites. */
+    bool async = false;
+    std::size_t bytes = 0;
+    std::size_t chunks = 0;
+    /** Part of bytes and chunks staged by each record component, entries are removed when it is flushed. */
+    struct Staged
+    {
+        std::size_t bytes = 0;
+        std::size_t chunks = 0;
+    };
+    std::unordered_map< Writable const*, Staged > components;
+    std::uint64_t autoFlushes = 0;
+    /** Completion of the data handed to the backend by the last automatic or asynchronous flush. */
+    std::future< void > inFlight;
+};  //WriteStaging
+} // openPMD
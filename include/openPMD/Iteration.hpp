@@ -20,14 +20,20 @@
  */
 #pragma once
 
+#include "openPMD/auxiliary/FlatMap.hpp"
 #include "openPMD/backend/Attributable.hpp"
 #include "openPMD/backend/Container.hpp"
 #include "openPMD/Mesh.hpp"
 #include "openPMD/ParticleSpecies.hpp"
 
+#include <string>
+#include <vector>
+
 
 namespace openPMD
 {
+class Series;
+
 /** @brief  Logical compilation of data from one snapshot (e.g. a single simulation cycle).
  *
  * @see https://github.com/openPMD/openPMD-standard/blob/latest/STANDARD.md#required-attributes-for-the-basepath
@@ -41,6 +47,7 @@ class Iteration : public Attributable
     >
     friend class Container;
     friend class Series;
+    friend class IterationContainer;
 
 public:
     Iteration(Iteration const&);
@@ -86,18 +93,129 @@ public:
      */
     Iteration& setTimeUnitSI(double timeUnitSI);
 
+    /** Parse this iteration from its file, if it has only been registered so far.
+     *
+     * Iterations of a fileBased Series opened for reading are only registered by the index in their file name.
+     * The file of such an iteration is opened and parsed the first time it is accessed through
+     * IterationContainer::operator[], IterationContainer::at() or IterationContainer::find(),
+     * when it is reached while iterating the container, or explicitly by calling this function.
+     * Calling this function on an iteration that is already parsed has no effect.
+     * If chunks have been registered with Series::prefetch, they are loaded ahead for the following iteration.
+     *
+     * @return  Reference to this iteration.
+     */
+    Iteration& open();
+    /** Close the file of this iteration and release all contained meshes and particles.
+     *
+     * In a Series opened for reading, the iteration stays registered in its Series and can be opened again.
+     * Modifications that have not been flushed are discarded.
+     *
+     * In a Series opened for writing, the Series is flushed first and, for fileBased iteration encoding,
+     * the file of this iteration is closed. The iteration is not visited by subsequent flushes
+     * and can not be accessed again through its Series, so the memory and flush time of a writer
+     * only depend on the iterations that are still open.
+     *
+     * @throw   std::runtime_error  If the iteration belongs to a groupBased Series opened for reading.
+     * @return  Reference to this iteration.
+     */
+    Iteration& close();
+    /** Execute all required remaining IO operations to write this iteration.
+     *
+     * Unlike Series::flush(), no other iteration of the Series is visited.
+     * Modified attributes of the Series are written along with this iteration.
+     * Series::flush() only visits iterations that contain modified objects either,
+     * so use this function if the iteration to be written is known anyway.
+     *
+     * @throw   std::runtime_error  If the iteration has been closed.
+     * @return  Reference to this iteration.
+     */
+    Iteration& flush();
+    /**
+     * @return  true if the contents of this iteration are available (i.e. it is not only registered by its index).
+     */
+    bool parsed() const;
+    /**
+     * @return  true if this iteration has been closed in a Series opened for writing.
+     */
+    bool closed() const;
+
     Container< Mesh > meshes;
     Container< ParticleSpecies > particles; //particleSpecies?
 
 private:
     Iteration();
 
+    uint64_t m_index;       /* key of this iteration in the iterations of its Series, set on registration */
+    std::string m_fileName; /* only set for iterations of a fileBased Series opened for reading */
+    bool m_parsed;
+    bool m_closed;
+    bool m_prefetched;  /* chunks registered with Series::prefetch have been requested */
+
     void flushFileBased(uint64_t);
     void flushGroupBased(uint64_t);
-    void flush();
+    void flushContents();
+    void trimAppended();
+    /** Location of every record component relative to this iteration, see Series::setCheckpointMode. */
+    std::vector< std::string > checkpointLayout() const;
+    void parse();
+    /** @throws std::runtime_error If this iteration is not contained in the iterations of a Series. */
+    Series* series() const;
+    void readFile(Writable* file, Writable* iterationsGroup, uint64_t index);
     void read();
+    /** Open all record components listed in a checkpoint layout in a single batch, without reading their attributes. */
+    void readCheckpoint(std::vector< std::string > const& layout);
+    std::string childName(Writable const* child) const override;
 };  //Iteration
 
+namespace detail
+{
+/* iterations registered while reading are parsed on first access,
+ * closed ones in a Series opened for writing are left as they are */
+template<>
+inline void
+openElement< Iteration >(Iteration& i)
+{
+    if( !i.closed() )
+        i.open();
+}
+} // detail
+
+/** @brief Container of all iterations in a Series.
+ *
+ * Like the other containers, accessing an iteration through operator[], at() or find(),
+ * or dereferencing an iterator of the container, opens it (see detail::openElement):
+ * an iteration that has only been registered so far is parsed from its file (see Iteration::open()).
+ * Iterating the container thus parses one iteration after the other, not all of them up front.
+ * Const access leaves registered iterations unparsed, so that their state can be inspected.
+ * Series with tens of thousands of iterations are common, so iterations are
+ * kept in a sorted flat map instead of a node-based tree.
+ */
+class IterationContainer : public Container< Iteration, uint64_t, auxiliary::FlatMap< uint64_t, Iteration > >
+{
+    using BaseContainer = Container< Iteration, uint64_t, auxiliary::FlatMap< uint64_t, Iteration > >;
+
+public:
+    using const_iterator = auxiliary::FlatMap< uint64_t, Iteration >::const_iterator;
+
+    virtual ~IterationContainer() { }
+
+    using BaseContainer::begin;
+    const_iterator begin() const noexcept { return m_container.begin(); }
+    const_iterator cbegin() const noexcept { return m_container.cbegin(); }
+    using BaseContainer::end;
+    const_iterator end() const noexcept { return m_container.end(); }
+    const_iterator cend() const noexcept { return m_container.cend(); }
+
+    using BaseContainer::find;
+    const_iterator find(key_type const& key) const { return m_container.find(key); }
+
+    mapped_type& at(key_type const& key);
+    mapped_type const& at(key_type const& key) const;
+
+    mapped_type& operator[](key_type const& key) override;
+    mapped_type& operator[](key_type&& key) override;
+};  //IterationContainer
+
 extern template
 float
 Iteration::time< float >() const;
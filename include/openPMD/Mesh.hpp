@@ -5,6 +5,10 @@
 #include "openPMD/backend/MeshRecordComponent.hpp"
 
 #include <array>
+#include <future>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 #include <string>
 
@@ -154,6 +158,35 @@ public:
     template< typename T >
     Mesh& setTimeOffset(T timeOffset);
 
+    /** Register a chunk of a component to be written on the next flush, given in the requested memory layout.
+     *
+     * If order differs from Mesh::dataOrder, offset, extent and data are given in reversed order of the dimensions
+     * with respect to the dataset, e.g. a Fortran array A(nx, ny, nz) for a mesh stored in DataOrder::C,
+     * and the chunk is transposed into a staging buffer (chunks are always copied in this case).
+     * Otherwise this is the same as RecordComponent::storeChunk().
+     *
+     * @param   component   Name of the component, RecordComponent::SCALAR for scalar meshes.
+     */
+    template< typename T >
+    void storeChunk(std::string const& component, Offset, Extent, std::shared_ptr< T > data, DataOrder order);
+    /** Register a deferred read of a chunk of a component into memory of the requested layout.
+     *
+     * If order differs from Mesh::dataOrder, offset and extent are given and data is filled in reversed order
+     * of the dimensions with respect to the dataset, so e.g. C++ readers of meshes written in DataOrder::F
+     * index chunks in the order of the axisLabels. The chunk is transposed by the backend after reading it (currently HDF5 only).
+     * Otherwise this is the same as RecordComponent::loadChunk().
+     *
+     * @param   component   Name of the component, RecordComponent::SCALAR for scalar meshes.
+     * @return  Future that becomes ready once data has been filled (or holds the exception that interrupted the read).
+     */
+    template< typename T >
+    std::future< void > loadChunk(std::string const& component,
+                                  Offset const&,
+                                  Extent const&,
+                                  std::shared_ptr< T > data,
+                                  DataOrder order,
+                                  double targetUnitSI = std::numeric_limits< double >::quiet_NaN());
+
 private:
     Mesh();
 
@@ -161,6 +194,15 @@ private:
     void read() override;
 }; // Mesh
 
+namespace detail
+{
+/* meshes listed while reading are opened on first access */
+template<>
+inline void
+openElement< Mesh >(Mesh& m)
+{ m.open(); }
+} // detail
+
 template< typename T >
 inline std::vector< T >
 Mesh::gridSpacing() const
@@ -170,6 +212,63 @@ template< typename T >
 inline T
 Mesh::timeOffset() const
 { return readFloatingpoint< T >("timeOffset"); }
+
+template< typename T >
+inline void
+Mesh::storeChunk(std::string const& component, Offset o, Extent e, std::shared_ptr< T > data, DataOrder order)
+{
+    MeshRecordComponent& rc = at(component);
+    if( order == dataOrder() || e.size() < 2 )
+    {
+        rc.storeChunk(std::move(o), std::move(e), std::move(data));
+        return;
+    }
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during chunk store.");
+
+    /* HDF5 selections can not reorder dimensions, so the chunk is transposed into a buffer of the order of the dataset */
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : e )
+        numPoints *= dimensionSize;
+    auto buffer = auxiliary::allocatePtr(determineDatatype< T >(), numPoints, rc.IOHandler->bufferPool.get());
+    auxiliary::transpose(buffer.get(), data.get(), sizeof(T), e);
+    std::function< void(void*) > del = buffer.get_deleter();
+    std::shared_ptr< T > transposed(static_cast< T* >(buffer.release()), [del](T* p){ del(p); });
+    rc.storeChunk(Offset(o.rbegin(), o.rend()), Extent(e.rbegin(), e.rend()), std::move(transposed));
+}
+
+template< typename T >
+inline std::future< void >
+Mesh::loadChunk(std::string const& component, Offset const& o, Extent const& e, std::shared_ptr< T > data, DataOrder order, double targetUnitSI)
+{
+    MeshRecordComponent& rc = at(component);
+    Offset const fileOffset(o.rbegin(), o.rend());
+    Extent const fileExtent(e.rbegin(), e.rend());
+    if( order == dataOrder() || e.size() < 2 )
+        return rc.loadChunk(o, e, data, targetUnitSI);
+    /* all values of constant components are equal, so their order does not matter */
+    if( rc.m_isConstant )
+        return rc.loadChunk(fileOffset, fileExtent, data, targetUnitSI);
+
+    rc.verifyChunk(determineDatatype< T >(), fileOffset, fileExtent);
+    double const scale = rc.scaleFactor(targetUnitSI);
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during deferred chunk loading.");
+
+    auto done = std::make_shared< std::promise< void > >();
+    Parameter< Operation::READ_DATASET > dRead;
+    dRead.offset = fileOffset;
+    dRead.extent = fileExtent;
+    dRead.transpose = true;
+    dRead.dtype = determineDatatype< T >();
+    dRead.chunkCache = rc.m_dataset.chunkCache;
+    dRead.data = data.get();
+    dRead.scale = scale;
+    dRead.buffer = std::static_pointer_cast< void >(data);
+    dRead.done = done;
+    rc.IOHandler->enqueue(IOTask(&rc, dRead));
+    return done->get_future();
+}
 } // openPMD
 
 namespace std
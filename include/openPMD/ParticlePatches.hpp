@@ -4,6 +4,10 @@
 #include "openPMD/backend/Container.hpp"
 #include "openPMD/backend/PatchRecord.hpp"
 
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 
@@ -17,7 +21,42 @@ public:
     mapped_type& operator[](key_type const&) override;
     mapped_type& operator[](key_type&&) override;
 
-private:
+    /** @return Number of patches read from file.
+     */
+    size_t numPatches() const;
+    /** @return Number and offset of the particles in a patch, identical for all record components of the species.
+     *
+     * @throws std::out_of_range    If patch >= numPatches().
+     */
+    PatchPosition const& position(size_t patch) const;
+    /** Find all patches overlapping a spatial region.
+     *
+     * A patch covers [offset, offset + extent) per component of the patch records "offset" and "extent".
+     *
+     * @param   region  Half-open interval [lower, upper) per component of "offset" (e.g. "x"),
+     *                  in the same units as the stored patch offsets. Components not listed are not restricted.
+     * @return  Indices of all overlapping patches, in ascending order.
+     */
+    std::vector< size_t > select(std::map< std::string, std::pair< double, double > > const& region) const;
+
+    /** Define one patch of the table written on the next flush.
+     *
+     * In a parallel Series, ranks may each define a different subset of the patches,
+     * but all must pass the same numPatches and the same components in bounds.
+     *
+     * @param   patch       Index of the patch, less than numPatches.
+     * @param   numPatches  Total number of patches in the table.
+     * @param   position    Number and offset of the particles in the patch.
+     * @param   bounds      Optional spatial bounds [lower, upper) of the patch per component (e.g. "x"),
+     *                      stored in the patch records "offset" and "extent".
+     * @return  Reference to modified particle patches.
+     */
+    ParticlePatches& storePatch(uint64_t patch,
+                                uint64_t numPatches,
+                                PatchPosition const& position,
+                                std::map< std::string, std::pair< double, double > > const& bounds = {});
+
+protected:
     void read();
 
     std::vector< PatchPosition > m_patchPositions;
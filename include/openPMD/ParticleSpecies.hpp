@@ -3,9 +3,19 @@
 #include "openPMD/backend/Attributable.hpp"
 #include "openPMD/backend/Container.hpp"
 #include "openPMD/ParticlePatches.hpp"
+#include "openPMD/ReadFilter.hpp"
 #include "openPMD/Record.hpp"
 
+#if openPMD_HAVE_MPI
+#   include <mpi.h>
+#endif
+
+#include <cstddef>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 
 namespace openPMD
@@ -18,14 +28,186 @@ class ParticleSpecies : public Container< Record >
 
 public:
     ParticlePatches particlePatches;
+    /** Ranges of values per block of the record components with a block index (see RecordComponent::setBlockIndex).
+     *
+     * Mirrors the records of the species, every component holds the (minimum, maximum) of each block in a row
+     * and the attribute "blockSize".
+     */
+    Container< Record > blockIndex;
+
+#if openPMD_HAVE_MPI
+    /** Collectively define the local particles of every rank in comm as one patch (see ParticlePatches::storePatch).
+     *
+     * Patch i holds the particles of rank i, their offset in the species is computed with MPI_Exscan.
+     *
+     * @param   numParticles    Number of particles stored by this rank.
+     * @param   bounds          Optional spatial bounds [lower, upper) of the particles of this rank per component,
+     *                          all ranks must pass the same components.
+     * @return  Offset of the particles of this rank in all record components, to be used in storeChunk.
+     */
+    uint64_t storeLocalPatch(MPI_Comm comm,
+                             uint64_t numParticles,
+                             std::map< std::string, std::pair< double, double > > const& bounds = {});
+#endif
+
+    /** Register deferred reads of only the particles in one patch (see ParticlePatches::position).
+     *
+     * @return  Per record component (keyed "record/component", or "record" for scalar records)
+     *          a buffer of particlePatches.position(patch).numParticles values, filled on the next Series::flush().
+     */
+    template< typename T >
+    std::map< std::string, std::shared_ptr< T > > loadPatch(size_t patch);
+    /** Register deferred reads of the particles in several patches, concatenated in the given order.
+     */
+    template< typename T >
+    std::map< std::string, std::shared_ptr< T > > loadPatches(std::vector< size_t > const& patches);
+    /** Register deferred reads of the particles in all patches overlapping a spatial region (see ParticlePatches::select).
+     */
+    template< typename T >
+    std::map< std::string, std::shared_ptr< T > > loadPatches(std::map< std::string, std::pair< double, double > > const& region);
+
+    /** Find all blocks of a record component that may hold values in a range, using its block index.
+     *
+     * Consecutive blocks are merged, the result can be passed to RecordComponent::loadChunks()
+     * to read only the candidates for a predicate such as momentum/x > p0 in a single task.
+     *
+     * @param   component   Record component, "record/component" or "record" for scalar records.
+     * @param   range       Half-open interval [lower, upper) of values.
+     * @return  Offset and extent of every selected run of blocks, in ascending order.
+     * @throws  std::runtime_error  If the component has no block index.
+     */
+    std::vector< std::pair< Offset, Extent > > selectBlocks(std::string const& component,
+                                                           std::pair< double, double > const& range);
+
+    /** Find all particles whose values of every listed record component lie in a half-open interval [lower, upper).
+     *
+     * Blocks excluded by the block index of a component (see selectBlocks) are not read.
+     * The remaining particles are loaded as double in batches of up to batchSize particles per component,
+     * each batch with one multi-region read per component, and the predicate is evaluated on the batch by workers threads.
+     *
+     * @param   ranges      Interval per record component ("record/component" or "record" for scalar records),
+     *                      all components must be one-dimensional with the same extent.
+     * @param   workers     Number of threads evaluating the predicate, 0 for one per hardware thread.
+     * @param   batchSize   Maximum number of particles per component held in memory at once.
+     * @return  Indices of all selected particles, in ascending order.
+     */
+    std::vector< uint64_t > selectParticles(std::map< std::string, std::pair< double, double > > const& ranges,
+                                            unsigned int workers = 0,
+                                            uint64_t batchSize = uint64_t(1) << 20);
+    /** Register deferred reads of only the selected particles (e.g. from selectParticles) of all record components.
+     *
+     * Consecutive indices are merged, so every component is read with a single multi-region read (see RecordComponent::loadChunks).
+     *
+     * @return  Per record component (keyed "record/component", or "record" for scalar records)
+     *          a buffer of indices.size() values in the order of indices, filled on the next Series::flush().
+     */
+    template< typename T >
+    std::map< std::string, std::shared_ptr< T > > loadParticles(std::vector< uint64_t > const& indices);
 
 private:
     ParticleSpecies();
 
-    void read();
+    /** @return Record component named "record/component" or "record" for scalar records.
+     *  @throws std::runtime_error  If the species does not hold the component.
+     */
+    RecordComponent& component(std::string const&);
+
+    /** @param  filter  Records it excludes are skipped. */
+    void read(ReadFilter const& filter = ReadFilter());
+    void readRecords(Container< Record >&, ReadFilter const&);
     void flush(std::string const &) override;
+    std::string childName(Writable const* child) const override;
 };
 
+
+template< typename T >
+inline std::map< std::string, std::shared_ptr< T > >
+ParticleSpecies::loadPatch(size_t patch)
+{
+    return loadPatches< T >(std::vector< size_t >{patch});
+}
+
+template< typename T >
+inline std::map< std::string, std::shared_ptr< T > >
+ParticleSpecies::loadPatches(std::vector< size_t > const& patches)
+{
+    uint64_t numParticles = 0;
+    for( size_t patch : patches )
+        numParticles += particlePatches.position(patch).numParticles;
+
+    std::map< std::string, std::shared_ptr< T > > ret;
+    for( auto& record : *this )
+    {
+        for( auto& component : record.second )
+        {
+            if( !component.second.written )
+                continue;
+
+            auto buffer = auxiliary::allocatePtr(determineDatatype< T >(),
+                                                 numParticles,
+                                                 IOHandler->bufferPool.get());
+            std::function< void(void*) > del = buffer.get_deleter();
+            std::shared_ptr< T > data(static_cast< T* >(buffer.release()),
+                                      [del](T* p){ del(p); });
+
+            uint64_t filled = 0;
+            for( size_t patch : patches )
+            {
+                PatchPosition const& pos = particlePatches.position(patch);
+                if( pos.numParticles == 0 )
+                    continue;
+                component.second.loadChunk({pos.numParticlesOffset},
+                                           {pos.numParticles},
+                                           std::shared_ptr< T >(data, data.get() + filled));
+                filled += pos.numParticles;
+            }
+
+            std::string name = record.first;
+            if( component.first != RecordComponent::SCALAR )
+                name += '/' + component.first;
+            ret.emplace(std::move(name), std::move(data));
+        }
+    }
+    return ret;
+}
+
+template< typename T >
+inline std::map< std::string, std::shared_ptr< T > >
+ParticleSpecies::loadPatches(std::map< std::string, std::pair< double, double > > const& region)
+{
+    return loadPatches< T >(particlePatches.select(region));
+}
+
+template< typename T >
+inline std::map< std::string, std::shared_ptr< T > >
+ParticleSpecies::loadParticles(std::vector< uint64_t > const& indices)
+{
+    std::vector< std::pair< Offset, Extent > > runs;
+    for( uint64_t index : indices )
+    {
+        if( !runs.empty() && runs.back().first[0] + runs.back().second[0] == index )
+            ++runs.back().second[0];
+        else
+            runs.push_back({{index}, {1}});
+    }
+
+    std::map< std::string, std::shared_ptr< T > > ret;
+    for( auto& record : *this )
+    {
+        for( auto& component : record.second )
+        {
+            if( !component.second.written )
+                continue;
+
+            std::string name = record.first;
+            if( component.first != RecordComponent::SCALAR )
+                name += '/' + component.first;
+            ret.emplace(std::move(name), component.second.template loadChunks< T >(runs));
+        }
+    }
+    return ret;
+}
+
 template<>
 Container< ParticleSpecies >::mapped_type&
 Container< ParticleSpecies >::operator[](Container< ParticleSpecies >::key_type const& key);
@@ -0,0 +1,79 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+
+namespace openPMD
+{
+/** Part of a Series that is read, e.g. to read only the fields of a Series that also holds many particle species.
+ *
+ * Excluded iterations, meshes, particle species and records are never opened and their attributes are not parsed,
+ * they are missing from the containers of the Series as if they had not been written.
+ * Include lists name the objects that are read, an empty list includes all of them.
+ *
+ * @see Series::read(std::string const&, ReadFilter const&, AccessType)
+ */
+struct ReadFilter
+{
+    /** Names of the meshes read (e.g. "E"). */
+    std::vector< std::string > meshes;
+    /** Names of the particle species read (e.g. "electrons"). */
+    std::vector< std::string > species;
+    /** Names of the records read in each particle species (e.g. "position"), particlePatches are always read. */
+    std::vector< std::string > records;
+    /** Read no meshes at all, regardless of the list of meshes. */
+    bool skipMeshes = false;
+    /** Read no particle species at all, regardless of the list of species. */
+    bool skipParticles = false;
+    /** Indices of the iterations read, [firstIteration, lastIteration]. */
+    uint64_t firstIteration = 0;
+    uint64_t lastIteration = std::numeric_limits< uint64_t >::max();
+
+    bool includesIteration(uint64_t index) const
+    {
+        return index >= firstIteration && index <= lastIteration;
+    }
+    bool includesMesh(std::string const& name) const
+    {
+        return !skipMeshes && included(meshes, name);
+    }
+    bool includesSpecies(std::string const& name) const
+    {
+        return !skipParticles && included(species, name);
+    }
+    bool includesRecord(std::string const& name) const
+    {
+        return included(records, name);
+    }
+
+private:
+    static bool included(std::vector< std::string > const& names, std::string const& name)
+    {
+        return names.empty() || std::find(names.begin(), names.end(), name) != names.end();
+    }
+};  //ReadFilter
+} // openPMD
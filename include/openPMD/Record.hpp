@@ -3,9 +3,13 @@
 #include "openPMD/backend/BaseRecord.hpp"
 #include "openPMD/RecordComponent.hpp"
 
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <string>
+#include <vector>
 
 
 namespace openPMD
@@ -27,13 +31,50 @@ public:
     template< typename T >
     Record& setTimeOffset(T);
 
+    /** Register the same chunk of several components (e.g. x, y and z) to be written on the next flush.
+     *
+     * Offset and extent are checked once for all components, which have to share their datatype and extent.
+     * The chunks are staged together like in RecordComponent::storeChunk(),
+     * so the staging budget is only checked once and all of them are written in the same flush.
+     *
+     * @param   data    Chunk data by name of the component.
+     * @return  Reference to this record.
+     */
+    template< typename T >
+    Record& storeComponents(Offset const&, Extent const&, std::map< std::string, std::shared_ptr< T > > const& data);
+    /** Register deferred reads of the same chunk of several components into one buffer allocated by the API.
+     *
+     * The buffer is obtained in a single allocation (from the BufferPool of the Series if one is set)
+     * and holds the chunks of all components one after another.
+     *
+     * @param   components  Names of the components to read, all components if empty.
+     * @return  Chunk by name of the component, each sharing ownership of the common buffer, filled after the next flush.
+     */
+    template< typename T >
+    std::map< std::string, std::shared_ptr< T > > loadComponents(Offset const&,
+                                                                 Extent const&,
+                                                                 std::vector< std::string > const& components = {},
+                                                                 double targetUnitSI = std::numeric_limits< double >::quiet_NaN());
+
 private:
     Record();
 
+    /** @throw std::runtime_error  If the chunk does not reside inside the first component or the extents of the components differ. */
+    void verifyComponents(std::vector< RecordComponent* > const&, Offset const&, Extent const&);
+
     void flush(std::string const&) override;
     void read() override;
 };  //Record
 
+namespace detail
+{
+/* records listed while reading are opened on first access */
+template<>
+inline void
+openElement< Record >(Record& r)
+{ r.open(); }
+} // detail
+
 
 template< typename T >
 inline T
@@ -49,4 +90,85 @@ Record::setTimeOffset(T to)
     setAttribute("timeOffset", to);
     return *this;
 }
+
+template< typename T >
+inline Record&
+Record::storeComponents(Offset const& o, Extent const& e, std::map< std::string, std::shared_ptr< T > > const& data)
+{
+    Datatype const dtype = determineDatatype< T >();
+    std::vector< RecordComponent* > components;
+    components.reserve(data.size());
+    for( auto const& chunk : data )
+    {
+        RecordComponent& rc = at(chunk.first);
+        if( rc.m_isConstant )
+            throw std::runtime_error("Chunks can not be written for a constant RecordComponent.");
+        if( rc.getDatatype() != dtype )
+            throw std::runtime_error("Datatypes of chunk and dataset do not match.");
+        components.push_back(&rc);
+    }
+    verifyComponents(components, o, e);
+
+    /* stage all chunks before another thread may flush the Series */
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    auto rc = components.begin();
+    for( auto const& chunk : data )
+    {
+        Parameter< Operation::WRITE_DATASET > dWrite;
+        dWrite.offset = o;
+        dWrite.extent = e;
+        dWrite.dtype = dtype;
+        dWrite.chunkCache = (*rc)->m_dataset.chunkCache;
+        dWrite.data = std::static_pointer_cast< void >(chunk.second);
+        (*rc++)->stageChunk(std::move(dWrite), false);
+    }
+    if( !components.empty() )
+        components.front()->flushOverBudget();
+    return *this;
+}
+
+template< typename T >
+inline std::map< std::string, std::shared_ptr< T > >
+Record::loadComponents(Offset const& o, Extent const& e, std::vector< std::string > const& names, double targetUnitSI)
+{
+    Datatype const dtype = determineDatatype< T >();
+    std::vector< std::pair< std::string, RecordComponent* > > components;
+    if( names.empty() )
+        for( auto& comp : *this )
+            components.emplace_back(comp.first, &comp.second);
+    else
+        for( auto const& name : names )
+            components.emplace_back(name, &at(name));
+    std::vector< RecordComponent* > verified;
+    verified.reserve(components.size());
+    for( auto const& comp : components )
+    {
+        comp.second->verifyDatatype(dtype);
+        verified.push_back(comp.second);
+    }
+    verifyComponents(verified, o, e);
+
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : e )
+        numPoints *= dimensionSize;
+
+    auto buffer = auxiliary::allocatePtr(dtype,
+                                         numPoints * components.size(),
+                                         IOHandler->bufferPool.get());
+    std::function< void(void*) > del = buffer.get_deleter();
+    std::shared_ptr< T > all(static_cast< T* >(buffer.release()),
+                             [del](T* p){ del(p); });
+
+    std::map< std::string, std::shared_ptr< T > > ret;
+    T* part = all.get();
+    for( auto const& comp : components )
+    {
+        /* aliasing keeps the common buffer alive as long as any of its parts */
+        std::shared_ptr< T > data(all, part);
+        comp.second->loadChunk(o, e, data, targetUnitSI);
+        ret.emplace(comp.first, std::move(data));
+        part += numPoints;
+    }
+    return ret;
+}
 } // openPMD
@@ -1,20 +1,66 @@
 #pragma once
 
+#include "openPMD/auxiliary/Memory.hpp"
 #include "openPMD/backend/BaseRecordComponent.hpp"
 #include "openPMD/Dataset.hpp"
+#include "openPMD/DeviceMemory.hpp"
 
+#if openPMD_HAVE_MPI
+#   include <mpi.h>
+#endif
+
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <future>
 #include <memory>
 #include <limits>
 #include <queue>
 #include <string>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 
 namespace openPMD
 {
+/** Chunk of a constant record component: a single value repeated over an extent, without storing the repetitions.
+ */
+template< typename T >
+class ConstantView
+{
+public:
+    ConstantView(T value, Extent extent)
+            : m_value{value},
+              m_extent{std::move(extent)}
+    { }
+
+    T value() const { return m_value; }
+    Extent const& extent() const { return m_extent; }
+    /**
+     * @return  Number of elements in the chunk.
+     */
+    std::size_t size() const
+    {
+        std::size_t numPoints = 1;
+        for( auto const& dimensionSize : m_extent )
+            numPoints *= dimensionSize;
+        return numPoints;
+    }
+    T operator[](std::size_t) const { return m_value; }
+
+private:
+    T m_value;
+    Extent m_extent;
+};  //ConstantView
+
+template< typename T >
+class TypedRecordComponent;
+
 class RecordComponent : public BaseRecordComponent
 {
+    template< typename T >
+    friend class TypedRecordComponent;
     template<
             typename T,
             typename T_key,
@@ -23,6 +69,7 @@ class RecordComponent : public BaseRecordComponent
     friend class Container;
     friend class Iteration;
     friend class ParticleSpecies;
+    friend class Series;
     template< typename T_elem >
     friend class BaseRecord;
     friend class Record;
@@ -38,71 +85,603 @@ public:
 
     RecordComponent& setUnitSI(double);
 
+    /** Define the datatype and extent of the dataset of this component.
+     *
+     * @throws  std::runtime_error  If the component has been written, unless the Series is in overwrite mode (see Series::setOverwriteMode).
+     */
     RecordComponent& resetDataset(Dataset);
+    /** Size the raw data chunk cache used for this component from now on (see Dataset::setChunkCache).
+     *
+     * Unlike resetDataset(), this is possible for components that have been written or read already.
+     *
+     * @return  Reference to modified component.
+     */
+    RecordComponent& setChunkCache(std::size_t bytes, std::size_t slots = 0, double preemption = 0.75);
+    /** Choose how the ranks of a parallel Series write the chunks of this component from the next flush on (see Dataset::setTransfer).
+     *
+     * Unlike resetDataset(), this is possible for components that have been written already.
+     *
+     * @return  Reference to modified component.
+     */
+    RecordComponent& setTransfer(Transfer);
 
     uint8_t getDimensionality();
     Extent getExtent();
+    /** @return Shape of the chunks the dataset is stored in (may exceed the extent of a dataset that is still growing).
+     */
+    Extent getChunkSize();
 
     template< typename T >
     RecordComponent& makeConstant(T);
 
+    /** Obtain a view of this component with the element type fixed to T.
+     *
+     * All checks that do not depend on a chunk are performed once here, see TypedRecordComponent.
+     *
+     * @param   targetUnitSI    If not NaN, values loaded through the view are scaled by unitSI()/targetUnitSI.
+     * @throw   std::runtime_error  If T can not be converted from the stored datatype.
+     */
+    template< typename T >
+    TypedRecordComponent< T > typed(double targetUnitSI = std::numeric_limits< double >::quiet_NaN());
+
+    /** Read a chunk into memory, converting from the stored to the requested numeric type if they differ.
+     *
+     * @param   targetUnitSI    If not NaN, values are scaled by unitSI()/targetUnitSI in the same pass as the read.
+     *                          Integer results are truncated after scaling.
+     */
     template< typename T >
     void loadChunk(Offset const&,
                    Extent const&,
                    std::unique_ptr< T[] >&,
                    Allocation = Allocation::AUTO,
                    double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of a chunk into user-owned memory.
+     *
+     * No IO is performed until the next Series::flush() (or Series::flushAsync()),
+     * so reads registered across several components can be issued together.
+     * The buffer is kept alive until the read has completed and must not be accessed before.
+     * Reads of distinct components may be registered from several threads at the same time.
+     *
+     * @param   data    Pre-allocated buffer of at least as many elements as the chunk contains.
+     * @return  Future that becomes ready once data has been filled (or holds the exception that interrupted the read).
+     */
+    template< typename T >
+    std::future< void > loadChunk(Offset const&,
+                                  Extent const&,
+                                  std::shared_ptr< T >,
+                                  double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of a chunk into one member of user-owned structs (array-of-structs layout).
+     *
+     * The values are stored every sizeof(S) bytes, starting at the member of the first struct,
+     * so no intermediate buffer is needed (HDF5 scatters them through a strided memory selection).
+     *
+     * @param   data    Pre-allocated buffer of at least as many structs as the chunk contains.
+     * @param   member  Member of S receiving the values of this component, e.g. &Particle::x.
+     * @return  Future that becomes ready once data has been filled (or holds the exception that interrupted the read).
+     */
+    template< typename T, typename S >
+    std::future< void > loadChunk(Offset const&,
+                                  Extent const&,
+                                  std::shared_ptr< S > data,
+                                  T S::* member,
+                                  double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of a chunk into device memory, e.g. of a GPU.
+     *
+     * The chunk is read into a host buffer of memory.staging on the next Series::flush()
+     * and copied to the device with memory.toDevice right after, by the thread processing the read.
+     *
+     * @param   data    Device pointer to at least as many elements as the chunk contains.
+     * @return  Future that becomes ready once data has been filled (or holds the exception that interrupted the read).
+     */
+    template< typename T >
+    std::future< void > loadChunk(Offset const&,
+                                  Extent const&,
+                                  T* data,
+                                  DeviceMemory const& memory,
+                                  double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of a chunk into a buffer allocated by the API.
+     *
+     * The buffer is obtained from the BufferPool of the Series if one is set (see Series::setBufferPool)
+     * and is filled on the next Series::flush().
+     * If the chunk has been loaded ahead of time (see Series::prefetch) in the stored datatype
+     * and no unit conversion is requested, the prefetched buffer is returned instead once it has been filled.
+     *
+     * @return  Buffer holding the chunk after the next flush.
+     */
+    template< typename T >
+    std::shared_ptr< T > loadChunk(Offset const&,
+                                   Extent const&,
+                                   double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of a subsampled chunk, e.g. for previews of large meshes.
+     *
+     * Within the chunk spanned by offset and extent, blocks of block[i] elements (default 1)
+     * are selected every stride[i] elements along dimension i and stored densely in data,
+     * so only the selected elements are read from the backend (currently HDF5 only).
+     * The resulting shape is given by stridedExtent().
+     *
+     * @param   data    Pre-allocated buffer of at least as many elements as the subsampled chunk contains.
+     * @return  Future that becomes ready once data has been filled (or holds the exception that interrupted the read).
+     */
+    template< typename T >
+    std::future< void > loadStridedChunk(Offset const&,
+                                         Extent const&,
+                                         Extent const& stride,
+                                         std::shared_ptr< T > data,
+                                         Extent const& block = {},
+                                         double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of a subsampled chunk into a buffer allocated by the API.
+     *
+     * @return  Buffer holding the subsampled chunk after the next flush.
+     */
+    template< typename T >
+    std::shared_ptr< T > loadStridedChunk(Offset const&,
+                                          Extent const&,
+                                          Extent const& stride,
+                                          Extent const& block = {},
+                                          double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of several chunks that are stored one after another in data.
+     *
+     * All chunks are read from the backend in a single task on the next Series::flush(),
+     * as one union selection where the backend allows it (currently HDF5 only).
+     *
+     * @param   regions Offset and extent of every chunk, in the order they are stored in data.
+     * @param   data    Pre-allocated buffer of at least as many elements as all chunks contain.
+     * @return  Future that becomes ready once data has been filled (or holds the exception that interrupted the read).
+     */
+    template< typename T >
+    std::future< void > loadChunks(std::vector< std::pair< Offset, Extent > > const& regions,
+                                   std::shared_ptr< T > data,
+                                   double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of several chunks into one buffer allocated by the API.
+     *
+     * @return  Buffer holding all chunks one after another after the next flush.
+     */
+    template< typename T >
+    std::shared_ptr< T > loadChunks(std::vector< std::pair< Offset, Extent > > const& regions,
+                                    double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of single elements, e.g. selected particles, in a single task (currently HDF5 only).
+     *
+     * @param   points  Position of every element, in the order they are stored in data.
+     * @param   data    Pre-allocated buffer of at least as many elements as points are given.
+     * @return  Future that becomes ready once data has been filled (or holds the exception that interrupted the read).
+     */
+    template< typename T >
+    std::future< void > loadPoints(std::vector< Offset > const& points,
+                                   std::shared_ptr< T > data,
+                                   double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Register a deferred read of single elements into a buffer allocated by the API.
+     *
+     * @return  Buffer holding the elements after the next flush.
+     */
+    template< typename T >
+    std::shared_ptr< T > loadPoints(std::vector< Offset > const& points,
+                                    double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Shape of a subsampled chunk, i.e. (extent[i] - block[i]) / stride[i] + 1 blocks of block[i] elements along dimension i.
+     *
+     * @throw   std::runtime_error  If the dimensionalities differ, a stride is zero, a block exceeds its stride or the extent.
+     */
+    static Extent stridedExtent(Extent const&, Extent const& stride, Extent const& block = {});
+    /** Load a chunk of a constant component as a view of its value, without allocating memory for the chunk.
+     *
+     * The value is kept since the component has been read, so no IO is performed.
+     *
+     * @param   targetUnitSI    If not NaN, the value is scaled by unitSI()/targetUnitSI.
+     * @throw   std::runtime_error  If the component is not constant.
+     */
+    template< typename T >
+    ConstantView< T > loadConstant(Offset const&,
+                                   Extent const&,
+                                   double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Load a read-only view of a chunk without copying it, if the backend allows it.
+     *
+     * For uncompressed, contiguous datasets stored in exactly the requested type (currently HDF5 files opened as read only),
+     * the view points directly into the memory-mapped file and pages are only read (and cached by the OS) on first access.
+     * Otherwise the chunk is read into a buffer allocated by the API.
+     * In both cases the chunk is available right away, Series::flush() is not required.
+     */
+    template< typename T >
+    std::shared_ptr< T const > mapChunk(Offset const&, Extent const&);
+    /** Register a chunk to be written on the next flush.
+     *
+     * The chunk is staged as selected with Series::setStagingBudget():
+     * by default, data is kept alive and must not be modified until it has been written.
+     * If staged chunks of the Series exceed the budget, the Series is flushed automatically
+     * and the chunk data is written in the background.
+     * Chunks of distinct components may be registered from several threads at the same time,
+     * also while another thread flushes the Series. The backend executes them one batch at a time.
+     */
     template< typename T >
     void storeChunk(Offset, Extent, std::shared_ptr< T >);
+    /** Register one member of a chunk of structs (array-of-structs layout) to be written on the next flush.
+     *
+     * The values are taken every sizeof(S) bytes, starting at the member of the first struct,
+     * and are gathered by the backend while writing (HDF5 through a strided memory selection),
+     * so components need not be copied out of the structs first. Staging is the same as for the overload above.
+     *
+     * @param   data    Buffer of at least as many structs as the chunk contains.
+     * @param   member  Member of S holding the values of this component, e.g. &Particle::x.
+     */
+    template< typename T, typename S >
+    void storeChunk(Offset, Extent, std::shared_ptr< S > data, T S::* member);
+    /** Register a part of a larger buffer, e.g. the interior of a patch with guard cells, to be written on the next flush.
+     *
+     * The chunk is selected from the buffer by the backend while writing (HDF5 through a memory hyperslab),
+     * so it need not be copied into a packed buffer first. Staging is the same as for storeChunk(Offset, Extent, std::shared_ptr< T >).
+     *
+     * @param   data            Row-major buffer of shape memoryExtent.
+     * @param   memoryOffset    Offset of the chunk inside the buffer.
+     * @param   memoryExtent    Shape of the whole buffer.
+     * @throw   std::runtime_error  If the chunk does not reside inside the buffer.
+     */
+    template< typename T >
+    void storeChunk(Offset, Extent, std::shared_ptr< T > data, Offset memoryOffset, Extent memoryExtent);
+    /** Register a chunk in device memory, e.g. of a GPU, to be written on the next flush.
+     *
+     * The chunk is copied to host buffers of memory.staging right away, in slabs of whole rows
+     * of at most memory.slabBytes, so data can be re-used as soon as the call returns.
+     * Each slab is staged as a chunk of its own: with a staging budget (see Series::setStagingBudget),
+     * slabs exceeding it are written in the background while the following ones are copied.
+     *
+     * @param   data    Device pointer to a row-major chunk.
+     */
+    template< typename T >
+    void storeChunk(Offset, Extent, T const* data, DeviceMemory const& memory);
+    /** Append rows to the end of a one-dimensional dataset.
+     *
+     * The component keeps track of the number of appended rows itself.
+     * The extent set with resetDataset() is only the initial capacity (which may be zero):
+     * it grows geometrically whenever an append does not fit, so the backend only resizes the dataset a logarithmic number of times.
+     * The dataset is trimmed to the number of appended rows when its Iteration is closed or the Series is destroyed.
+     * Data is staged like in storeChunk(), consecutive appends are merged into a single write on flush.
+     *
+     * @param   data    Buffer holding at least n elements.
+     * @param   n       Number of rows to append.
+     */
+    template< typename T >
+    RecordComponent& append(std::shared_ptr< T > data, uint64_t n);
+    /** @return Number of rows appended with append().
+     */
+    uint64_t getAppendedSize() const;
+    /** Keep track of the range of all values written to this component.
+     *
+     * While flushing, every written chunk is reduced to its minimum, maximum and number of NaN values.
+     * The running results are stored as the attributes "minValue", "maxValue" (both double, NaNs excluded)
+     * and "numNaN", so readers can obtain value ranges (e.g. for colormaps) without scanning the dataset.
+     *
+     * @param   enabled Compute the statistics on the following flushes.
+     * @return  Reference to modified component.
+     */
+    RecordComponent& setStatistics(bool enabled);
+#if openPMD_HAVE_MPI
+    /** Keep track of the range of all values written to this component by all ranks in comm (see setStatistics(bool)).
+     *
+     * The statistics of all ranks are combined with an MPI reduction, which makes every flush of this component collective.
+     */
+    RecordComponent& setStatistics(MPI_Comm comm);
+#endif
+    /** Keep track of the range of values in every block of blockSize consecutive elements of a one-dimensional component.
+     *
+     * Like the statistics of setStatistics(bool), the ranges are reduced from the written chunks while flushing.
+     * For particle records, they are stored as block index of the species (see ParticleSpecies::selectBlocks),
+     * so readers can skip blocks that can not match a predicate.
+     *
+     * @param   blockSize   Number of elements per block, 0 to disable the index.
+     * @return  Reference to modified component.
+     */
+    RecordComponent& setBlockIndex(uint64_t blockSize);
+#if openPMD_HAVE_MPI
+    /** Keep track of the range of values in every block, combined over all ranks in comm (see setBlockIndex(uint64_t)).
+     *
+     * The ranges of all ranks are combined with an MPI reduction, which makes every flush of the species collective.
+     */
+    RecordComponent& setBlockIndex(uint64_t blockSize, MPI_Comm comm);
+#endif
+    /** Keep a CRC32C checksum of every written chunk to detect corrupted data without a separate pass over the files.
+     *
+     * When writing, each chunk is checksummed while flushing, right before it is handed to the backend
+     * (large chunks by several threads, chunks merged into a single write share one checksum). Offset, extent and checksum of the chunks are stored as the attributes
+     * "chunkOffset", "chunkExtent" (both flattened, one value per dimension and chunk) and "chunkCRC32C".
+     * When reading, every stored chunk that lies completely inside a loaded chunk is checked against its checksum
+     * as soon as the load has completed, as long as it is loaded in the stored datatype without unit conversion.
+     * A mismatch fails the load (the Series::flush or the future of the load) with a std::runtime_error.
+     * Checksums are computed over the bytes in memory, so files must be read on a platform of the same endianness.
+     *
+     * @param   enabled Checksum the chunks of the following flushes, or verify the following loads.
+     * @return  Reference to modified component.
+     */
+    RecordComponent& setChecksums(bool enabled);
+#if openPMD_HAVE_MPI
+    /** Keep checksums of the chunks written by all ranks in comm (see setChecksums(bool)).
+     *
+     * The checksums of all ranks are gathered on every flush of this component, which makes it collective.
+     */
+    RecordComponent& setChecksums(MPI_Comm comm);
+#endif
 
     constexpr static char const * const SCALAR = "\vScalar";
 
+    RecordComponent(RecordComponent const&) = default;
+    RecordComponent(RecordComponent&&) = default;
+    RecordComponent& operator=(RecordComponent const&) = default;
+    RecordComponent& operator=(RecordComponent&&) = default;
+    virtual ~RecordComponent();
+
 protected:
     RecordComponent();
 
     void readBase();
 
-    std::queue< IOTask > m_chunks;
+    /** Merge consecutive pending chunks that form one contiguous block into a single write.
+     */
+    void coalesceChunks();
+
+    IOTaskQueue m_chunks;
+    std::size_t m_stagedBytes; /* bytes of m_chunks accounted in the WriteStaging of the IOHandler */
+    /* chunks read ahead of time by Series::prefetch, handed out by loadChunk */
+    struct Prefetched
+    {
+        Offset offset;
+        Extent extent;
+        std::shared_ptr< void > data;
+        std::shared_future< void > done;
+    };
+    std::vector< Prefetched > m_prefetched;
+    uint64_t m_appendedSize;   /* logical size along the first dimension, may be less than the extent */
+    bool m_appending;
+    bool m_extentDirty;        /* extent changed after the dataset has been created */
     Attribute m_constantValue;
+    /* running statistics of the written values, see setStatistics */
+    struct Statistics
+    {
+        bool enabled = false;
+        long double min = std::numeric_limits< long double >::max();
+        long double max = std::numeric_limits< long double >::lowest();
+        uint64_t count = 0;     /* values other than NaN */
+        uint64_t numNaN = 0;
+        uint64_t stored = 0;    /* count + numNaN when the attributes were last set */
+        uint64_t blockSize = 0;
+        std::vector< double > blockMin; /* per block of blockSize elements, NaNs excluded */
+        std::vector< double > blockMax;
+        bool blocksChanged = false;
+#if openPMD_HAVE_MPI
+        MPI_Comm comm = MPI_COMM_NULL;
+#endif
+    } m_statistics;
+    /* checksums of the written chunks, see setChecksums */
+    struct Checksums
+    {
+        bool enabled = false;
+        /* entries stored as attributes, flattened like the attributes */
+        std::vector< uint64_t > offsets;
+        std::vector< uint64_t > extents;
+        std::vector< uint32_t > values;
+        /* entries of the chunks flushed by this rank since the attributes were last set */
+        std::vector< uint64_t > pendingOffsets;
+        std::vector< uint64_t > pendingExtents;
+        std::vector< uint32_t > pendingValues;
+#if openPMD_HAVE_MPI
+        MPI_Comm comm = MPI_COMM_NULL;
+#endif
+    } m_checksums;
 
 private:
     void flush(std::string const&);
+    /** Let the next flush create the component again, for redefinitions in overwrite mode.
+     *
+     * @throws  std::runtime_error  If the Series is not in overwrite mode.
+     */
+    void redefine();
+    /** @throw std::runtime_error  If chunks of the datatype can not be written to this component at this position. */
+    void verifyStore(Datatype, Offset const&, Extent const&);
+    /** Check and stage a chunk stored in data as described by the memory layout fields of dWrite. */
+    template< typename T >
+    void storeLayout(Parameter< Operation::WRITE_DATASET > dWrite, std::shared_ptr< T > data);
+    /** Copy a chunk from device memory to the host slab by slab and stage the slabs. */
+    void storeDevice(Datatype, Offset, Extent, void const* data, DeviceMemory const&);
+    /** Queue a chunk for the next flush, flushing the Series if checkBudget and the staging budget is exceeded.
+     *
+     * @param   owned   The data of the chunk is a buffer of the API, which is not copied again with StagingMode::COPY.
+     */
+    void stageChunk(Parameter< Operation::WRITE_DATASET >, bool checkBudget = true, bool owned = false);
+    /** Replace the data of a chunk by a dense copy from the pool (plain allocation if nullptr), so the user buffer can be re-used. */
+    static void copyChunk(Parameter< Operation::WRITE_DATASET >&, auxiliary::BufferPool*);
+    /** Flush the Series (writing staged chunks in the background) if the staging budget is exceeded. */
+    void flushOverBudget();
+    /** Add the values of a chunk about to be written to the statistics. */
+    void reduceChunk(Parameter< Operation::WRITE_DATASET > const&);
+    /** Combine the statistics of all ranks if required and set them as attributes if they changed. */
+    void storeStatistics();
+    /** Gather the checksums of all ranks if required and set them as attributes if chunks have been written. */
+    void storeChecksums();
+    /** @return Check of the checksums of all stored chunks inside a chunk loaded into data, empty if none can be checked. */
+    std::function< void() > checksumVerification(Datatype, Offset const&, Extent const&, void const* data, double scale);
+    /** Write the ranges of all blocks to a two-dimensional (block, minimum/maximum) component if they changed. */
+    void storeBlockIndex(RecordComponent& index);
+    /** Shrink the extent of an appended dataset to the number of appended rows. */
+    void trimAppended();
+    /** Enqueue a read of a chunk in the stored datatype, skipped if the chunk does not reside inside the dataset. */
+    void prefetchChunk(Offset const&, Extent const&);
+    /** @return Buffer of a prefetched chunk after waiting for its read, empty if the chunk has not been prefetched. */
+    std::shared_ptr< void > takePrefetched(Offset const&, Extent const&);
     virtual void read();
+    /** @throw std::runtime_error  If chunks of the datatype can not be loaded from this component. */
+    void verifyDatatype(Datatype);
+    void verifyChunk(Datatype, Offset const&, Extent const&);
+    double scaleFactor(double targetUnitSI);
+    template< typename T >
+    static T scaledValue(Attribute const&, double scale);
 };  //RecordComponent
 
+/** View of a RecordComponent with the element type fixed at compile time, for chunk IO in hot loops.
+ *
+ * The datatype of the chunks, its compatibility with the stored datatype, the unit scaling and
+ * the value of a constant component are resolved once on creation (see RecordComponent::typed()).
+ * Chunk operations then only check that the chunk resides inside the dataset and enqueue their IO task,
+ * without dispatching on the runtime Datatype.
+ * A view must not be used after the dataset of its component has been reset or made constant.
+ */
+template< typename T >
+class TypedRecordComponent
+{
+    friend class RecordComponent;
+
+public:
+    /** @see RecordComponent::storeChunk
+     * @throw   std::runtime_error  If the stored datatype is not T or the component is constant.
+     */
+    void storeChunk(Offset, Extent, std::shared_ptr< T >);
+    /** @see RecordComponent::loadChunk(Offset const&, Extent const&, std::shared_ptr< T >, double) */
+    std::future< void > loadChunk(Offset const&, Extent const&, std::shared_ptr< T >);
+    /** @see RecordComponent::loadChunk(Offset const&, Extent const&, double) */
+    std::shared_ptr< T > loadChunk(Offset const&, Extent const&);
+
+    RecordComponent& component() { return *m_component; }
+
+private:
+    TypedRecordComponent(RecordComponent&, double scale);
+
+    void verifyBounds(Offset const&, Extent const&) const;
+
+    RecordComponent* m_component;
+    double m_scale;
+    bool m_sameType;    /* stored datatype is T, so chunks can be written */
+    bool m_isConstant;
+    T m_constantValue;  /* scaled value of a constant component */
+};  //TypedRecordComponent
+
 
 template< typename T >
 inline RecordComponent&
 RecordComponent::makeConstant(T value)
 {
     if( written )
-        throw std::runtime_error("A recordComponent can not (yet) be made constant after it has been written.");
+        redefine();
 
     m_constantValue = Attribute(value);
     m_isConstant = true;
+    setDirty();
     return *this;
 }
 
 template< typename T >
-inline void
-RecordComponent::loadChunk(Offset const& o, Extent const& e, std::unique_ptr< T[] >& data, Allocation alloc, double targetUnitSI)
+inline TypedRecordComponent< T >
+RecordComponent::typed(double targetUnitSI)
 {
-    if( !std::isnan(targetUnitSI) )
-        throw std::runtime_error("unitSI scaling during chunk loading not yet implemented");
-    Datatype dtype = determineDatatype(std::shared_ptr< T >());
-    if( dtype != getDatatype() )
-        throw std::runtime_error("Type conversion during chunk loading not yet implemented");
+    verifyDatatype(determineDatatype< T >());
+    return TypedRecordComponent< T >(*this, scaleFactor(targetUnitSI));
+}
 
-    uint8_t dim = getDimensionality();
+template< typename T >
+inline
+TypedRecordComponent< T >::TypedRecordComponent(RecordComponent& rc, double scale)
+        : m_component{&rc},
+          m_scale{scale},
+          m_sameType{rc.getDatatype() == determineDatatype< T >()},
+          m_isConstant{rc.m_isConstant},
+          m_constantValue{rc.m_isConstant ? RecordComponent::scaledValue< T >(rc.m_constantValue, scale) : T()}
+{ }
+
+template< typename T >
+inline void
+TypedRecordComponent< T >::verifyBounds(Offset const& o, Extent const& e) const
+{
+    Extent const& dse = m_component->m_dataset.extent;
+    std::size_t const dim = dse.size();
     if( e.size() != dim || o.size() != dim )
         throw std::runtime_error("Dimensionality of chunk and dataset do not match.");
-    Extent dse = getExtent();
-    for( uint8_t i = 0; i < dim; ++i )
+    for( std::size_t i = 0; i < dim; ++i )
         if( dse[i] < o[i] + e[i] )
             throw std::runtime_error("Chunk does not reside inside dataset (Dimension on index " + std::to_string(i)
                                      + " - DS: " + std::to_string(dse[i])
                                      + " - Chunk: " + std::to_string(o[i] + e[i])
                                      + ")");
+}
+
+template< typename T >
+inline void
+TypedRecordComponent< T >::storeChunk(Offset o, Extent e, std::shared_ptr< T > data)
+{
+    if( m_isConstant )
+        throw std::runtime_error("Chunks can not be written for a constant RecordComponent.");
+    if( !m_sameType )
+        throw std::runtime_error("Datatypes of chunk and dataset do not match.");
+    verifyBounds(o, e);
+
+    Parameter< Operation::WRITE_DATASET > dWrite;
+    dWrite.offset = std::move(o);
+    dWrite.extent = std::move(e);
+    dWrite.dtype = determineDatatype< T >();
+    dWrite.chunkCache = m_component->m_dataset.chunkCache;
+    dWrite.data = std::static_pointer_cast< void >(data);
+    m_component->stageChunk(std::move(dWrite));
+}
+
+template< typename T >
+inline std::future< void >
+TypedRecordComponent< T >::loadChunk(Offset const& o, Extent const& e, std::shared_ptr< T > data)
+{
+    verifyBounds(o, e);
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during deferred chunk loading.");
+
+    auto done = std::make_shared< std::promise< void > >();
+    if( m_isConstant )
+    {
+        size_t numPoints = 1;
+        for( auto const& dimensionSize : e )
+            numPoints *= dimensionSize;
+        std::fill(data.get(), data.get() + numPoints, m_constantValue);
+        done->set_value();
+    } else
+    {
+        Parameter< Operation::READ_DATASET > dRead;
+        dRead.offset = o;
+        dRead.extent = e;
+        dRead.dtype = determineDatatype< T >();
+        dRead.chunkCache = m_component->m_dataset.chunkCache;
+        dRead.data = data.get();
+        dRead.scale = m_scale;
+        dRead.buffer = std::static_pointer_cast< void >(data);
+        dRead.done = done;
+        m_component->IOHandler->enqueue(IOTask(m_component, dRead));
+    }
+    return done->get_future();
+}
+
+template< typename T >
+inline std::shared_ptr< T >
+TypedRecordComponent< T >::loadChunk(Offset const& o, Extent const& e)
+{
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : e )
+        numPoints *= dimensionSize;
+
+    auto buffer = auxiliary::allocatePtr(determineDatatype< T >(),
+                                         numPoints,
+                                         m_component->IOHandler->bufferPool.get());
+    std::function< void(void*) > del = buffer.get_deleter();
+    std::shared_ptr< T > data(static_cast< T* >(buffer.release()),
+                              [del](T* p){ del(p); });
+    loadChunk(o, e, data);
+    return data;
+}
+
+template< typename T >
+inline T
+RecordComponent::scaledValue(Attribute const& a, double scale)
+{
+    if( scale == 1. )
+        return getCast< T >(a);
+    return static_cast< T >(getCast< long double >(a) * scale);
+}
+
+template< typename T >
+inline void
+RecordComponent::loadChunk(Offset const& o, Extent const& e, std::unique_ptr< T[] >& data, Allocation alloc, double targetUnitSI)
+{
+    verifyChunk(determineDatatype(std::shared_ptr< T >()), o, e);
+    double const scale = scaleFactor(targetUnitSI);
+
     if( Allocation::API == alloc && data )
         throw std::runtime_error("Preallocated pointer passed with signaled API-allocation during chunk loading.");
     else if( Allocation::USER == alloc && !data )
@@ -118,24 +697,386 @@ RecordComponent::loadChunk(Offset const& o, Extent const& e, std::unique_ptr< T[
 
     if( m_isConstant )
     {
-        Parameter< Operation::READ_ATT > aRead;
-        aRead.name = "value";
-        IOHandler->enqueue(IOTask(this, aRead));
-        IOHandler->flush();
-        T value = Attribute(*aRead.resource).get< T >();
+        /* the value has been read along with the component */
+        T value = scaledValue< T >(m_constantValue, scale);
         std::fill(raw_ptr, raw_ptr + numPoints, value);
     } else
     {
         Parameter< Operation::READ_DATASET > dRead;
         dRead.offset = o;
         dRead.extent = e;
-        dRead.dtype = getDatatype();
+        dRead.dtype = determineDatatype< T >();
+        dRead.chunkCache = m_dataset.chunkCache;
         dRead.data = raw_ptr;
+        dRead.scale = scale;
+        dRead.finish = checksumVerification(dRead.dtype, o, e, raw_ptr, scale);
         IOHandler->enqueue(IOTask(this, dRead));
         IOHandler->flush();
     }
 }
 
+template< typename T >
+inline std::future< void >
+RecordComponent::loadChunk(Offset const& o, Extent const& e, std::shared_ptr< T > data, double targetUnitSI)
+{
+    verifyChunk(determineDatatype(data), o, e);
+    double const scale = scaleFactor(targetUnitSI);
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during deferred chunk loading.");
+
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : e )
+        numPoints *= dimensionSize;
+
+    auto done = std::make_shared< std::promise< void > >();
+    if( m_isConstant )
+    {
+        T value = scaledValue< T >(m_constantValue, scale);
+        std::fill(data.get(), data.get() + numPoints, value);
+        done->set_value();
+    } else
+    {
+        Parameter< Operation::READ_DATASET > dRead;
+        dRead.offset = o;
+        dRead.extent = e;
+        dRead.dtype = determineDatatype< T >();
+        dRead.chunkCache = m_dataset.chunkCache;
+        dRead.data = data.get();
+        dRead.scale = scale;
+        dRead.buffer = std::static_pointer_cast< void >(data);
+        dRead.finish = checksumVerification(dRead.dtype, o, e, data.get(), scale);
+        dRead.done = done;
+        IOHandler->enqueue(IOTask(this, dRead));
+    }
+    return done->get_future();
+}
+
+template< typename T, typename S >
+inline std::future< void >
+RecordComponent::loadChunk(Offset const& o, Extent const& e, std::shared_ptr< S > data, T S::* member, double targetUnitSI)
+{
+    static_assert(sizeof(S) % sizeof(T) == 0, "Size of the struct must be a multiple of the size of its member");
+    verifyChunk(determineDatatype< T >(), o, e);
+    double const scale = scaleFactor(targetUnitSI);
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during deferred chunk loading.");
+
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : e )
+        numPoints *= dimensionSize;
+
+    auto done = std::make_shared< std::promise< void > >();
+    if( m_isConstant )
+    {
+        T value = scaledValue< T >(m_constantValue, scale);
+        for( size_t i = 0; i < numPoints; ++i )
+            data.get()[i].*member = value;
+        done->set_value();
+    } else
+    {
+        Parameter< Operation::READ_DATASET > dRead;
+        dRead.offset = o;
+        dRead.extent = e;
+        dRead.dtype = determineDatatype< T >();
+        dRead.chunkCache = m_dataset.chunkCache;
+        dRead.data = &(data.get()->*member);
+        dRead.memoryStride = sizeof(S) / sizeof(T);
+        dRead.scale = scale;
+        dRead.buffer = std::static_pointer_cast< void >(data);
+        dRead.done = done;
+        IOHandler->enqueue(IOTask(this, dRead));
+    }
+    return done->get_future();
+}
+
+template< typename T >
+inline std::future< void >
+RecordComponent::loadChunk(Offset const& o, Extent const& e, T* data, DeviceMemory const& memory, double targetUnitSI)
+{
+    verifyChunk(determineDatatype< T >(), o, e);
+    double const scale = scaleFactor(targetUnitSI);
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during deferred chunk loading.");
+    if( !memory.toDevice )
+        throw std::runtime_error("Chunks can not be loaded into device memory without a copy to the device.");
+
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : e )
+        numPoints *= dimensionSize;
+
+    auto buffer = auxiliary::allocatePtr(determineDatatype< T >(),
+                                         numPoints,
+                                         memory.staging ? memory.staging.get() : IOHandler->bufferPool.get());
+    std::function< void(void*) > del = buffer.get_deleter();
+    std::shared_ptr< T > host(static_cast< T* >(buffer.release()),
+                              [del](T* p){ del(p); });
+    auto toDevice = memory.toDevice;
+    size_t const bytes = numPoints * sizeof(T);
+
+    auto done = std::make_shared< std::promise< void > >();
+    if( m_isConstant )
+    {
+        T value = scaledValue< T >(m_constantValue, scale);
+        std::fill(host.get(), host.get() + numPoints, value);
+        toDevice(data, host.get(), bytes);
+        done->set_value();
+    } else
+    {
+        Parameter< Operation::READ_DATASET > dRead;
+        dRead.offset = o;
+        dRead.extent = e;
+        dRead.dtype = determineDatatype< T >();
+        dRead.chunkCache = m_dataset.chunkCache;
+        dRead.data = host.get();
+        dRead.scale = scale;
+        dRead.buffer = std::static_pointer_cast< void >(host);
+        /* the host buffer returns to the pool once the task has been processed */
+        auto verify = checksumVerification(dRead.dtype, o, e, host.get(), scale);
+        dRead.finish = [verify, toDevice, data, host, bytes]()
+        {
+            if( verify )
+                verify();
+            toDevice(data, host.get(), bytes);
+        };
+        dRead.done = done;
+        IOHandler->enqueue(IOTask(this, dRead));
+    }
+    return done->get_future();
+}
+
+template< typename T >
+inline std::shared_ptr< T >
+RecordComponent::loadChunk(Offset const& o, Extent const& e, double targetUnitSI)
+{
+    if( std::isnan(targetUnitSI) && determineDatatype< T >() == getDatatype() )
+    {
+        std::shared_ptr< void > prefetched = takePrefetched(o, e);
+        if( prefetched )
+            return std::static_pointer_cast< T >(prefetched);
+    }
+
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : e )
+        numPoints *= dimensionSize;
+
+    auto buffer = auxiliary::allocatePtr(determineDatatype< T >(),
+                                         numPoints,
+                                         IOHandler->bufferPool.get());
+    std::function< void(void*) > del = buffer.get_deleter();
+    std::shared_ptr< T > data(static_cast< T* >(buffer.release()),
+                              [del](T* p){ del(p); });
+    loadChunk(o, e, data, targetUnitSI);
+    return data;
+}
+
+template< typename T >
+inline std::future< void >
+RecordComponent::loadStridedChunk(Offset const& o, Extent const& e, Extent const& stride, std::shared_ptr< T > data, Extent const& block, double targetUnitSI)
+{
+    verifyChunk(determineDatatype(data), o, e);
+    Extent selected = stridedExtent(e, stride, block);
+    double const scale = scaleFactor(targetUnitSI);
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during deferred chunk loading.");
+
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : selected )
+        numPoints *= dimensionSize;
+
+    auto done = std::make_shared< std::promise< void > >();
+    if( m_isConstant )
+    {
+        T value = scaledValue< T >(m_constantValue, scale);
+        std::fill(data.get(), data.get() + numPoints, value);
+        done->set_value();
+    } else
+    {
+        Parameter< Operation::READ_DATASET > dRead;
+        dRead.offset = o;
+        dRead.extent = e;
+        dRead.stride = stride;
+        dRead.block = block;
+        dRead.dtype = determineDatatype< T >();
+        dRead.chunkCache = m_dataset.chunkCache;
+        dRead.data = data.get();
+        dRead.scale = scale;
+        dRead.buffer = std::static_pointer_cast< void >(data);
+        dRead.done = done;
+        IOHandler->enqueue(IOTask(this, dRead));
+    }
+    return done->get_future();
+}
+
+template< typename T >
+inline std::shared_ptr< T >
+RecordComponent::loadStridedChunk(Offset const& o, Extent const& e, Extent const& stride, Extent const& block, double targetUnitSI)
+{
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : stridedExtent(e, stride, block) )
+        numPoints *= dimensionSize;
+
+    auto buffer = auxiliary::allocatePtr(determineDatatype< T >(),
+                                         numPoints,
+                                         IOHandler->bufferPool.get());
+    std::function< void(void*) > del = buffer.get_deleter();
+    std::shared_ptr< T > data(static_cast< T* >(buffer.release()),
+                              [del](T* p){ del(p); });
+    loadStridedChunk(o, e, stride, data, block, targetUnitSI);
+    return data;
+}
+
+template< typename T >
+inline std::future< void >
+RecordComponent::loadChunks(std::vector< std::pair< Offset, Extent > > const& regions, std::shared_ptr< T > data, double targetUnitSI)
+{
+    size_t numPoints = 0;
+    for( auto const& region : regions )
+    {
+        verifyChunk(determineDatatype(data), region.first, region.second);
+        size_t regionPoints = 1;
+        for( auto const& dimensionSize : region.second )
+            regionPoints *= dimensionSize;
+        numPoints += regionPoints;
+    }
+    double const scale = scaleFactor(targetUnitSI);
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during deferred chunk loading.");
+
+    auto done = std::make_shared< std::promise< void > >();
+    if( m_isConstant )
+    {
+        T value = scaledValue< T >(m_constantValue, scale);
+        std::fill(data.get(), data.get() + numPoints, value);
+        done->set_value();
+    } else if( numPoints == 0 )
+        done->set_value();
+    else
+    {
+        Parameter< Operation::READ_DATASET > dRead;
+        dRead.offset = regions.front().first;
+        dRead.extent = regions.front().second;
+        dRead.regions = regions;
+        dRead.dtype = determineDatatype< T >();
+        dRead.chunkCache = m_dataset.chunkCache;
+        dRead.data = data.get();
+        dRead.scale = scale;
+        dRead.buffer = std::static_pointer_cast< void >(data);
+        dRead.done = done;
+        IOHandler->enqueue(IOTask(this, dRead));
+    }
+    return done->get_future();
+}
+
+template< typename T >
+inline std::shared_ptr< T >
+RecordComponent::loadChunks(std::vector< std::pair< Offset, Extent > > const& regions, double targetUnitSI)
+{
+    size_t numPoints = 0;
+    for( auto const& region : regions )
+    {
+        size_t regionPoints = 1;
+        for( auto const& dimensionSize : region.second )
+            regionPoints *= dimensionSize;
+        numPoints += regionPoints;
+    }
+
+    auto buffer = auxiliary::allocatePtr(determineDatatype< T >(),
+                                         numPoints,
+                                         IOHandler->bufferPool.get());
+    std::function< void(void*) > del = buffer.get_deleter();
+    std::shared_ptr< T > data(static_cast< T* >(buffer.release()),
+                              [del](T* p){ del(p); });
+    loadChunks(regions, data, targetUnitSI);
+    return data;
+}
+
+template< typename T >
+inline std::future< void >
+RecordComponent::loadPoints(std::vector< Offset > const& points, std::shared_ptr< T > data, double targetUnitSI)
+{
+    std::vector< uint64_t > coordinates;
+    coordinates.reserve(points.size() * getDimensionality());
+    for( auto const& point : points )
+    {
+        verifyChunk(determineDatatype(data), point, Extent(point.size(), 1u));
+        coordinates.insert(coordinates.end(), point.begin(), point.end());
+    }
+    double const scale = scaleFactor(targetUnitSI);
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during deferred chunk loading.");
+
+    auto done = std::make_shared< std::promise< void > >();
+    if( m_isConstant )
+    {
+        T value = scaledValue< T >(m_constantValue, scale);
+        std::fill(data.get(), data.get() + points.size(), value);
+        done->set_value();
+    } else if( points.empty() )
+        done->set_value();
+    else
+    {
+        Parameter< Operation::READ_DATASET > dRead;
+        dRead.offset = points.front();
+        dRead.extent = Extent(points.front().size(), 1u);
+        dRead.points = std::move(coordinates);
+        dRead.dtype = determineDatatype< T >();
+        dRead.chunkCache = m_dataset.chunkCache;
+        dRead.data = data.get();
+        dRead.scale = scale;
+        dRead.buffer = std::static_pointer_cast< void >(data);
+        dRead.done = done;
+        IOHandler->enqueue(IOTask(this, dRead));
+    }
+    return done->get_future();
+}
+
+template< typename T >
+inline std::shared_ptr< T >
+RecordComponent::loadPoints(std::vector< Offset > const& points, double targetUnitSI)
+{
+    auto buffer = auxiliary::allocatePtr(determineDatatype< T >(),
+                                         points.size(),
+                                         IOHandler->bufferPool.get());
+    std::function< void(void*) > del = buffer.get_deleter();
+    std::shared_ptr< T > data(static_cast< T* >(buffer.release()),
+                              [del](T* p){ del(p); });
+    loadPoints(points, data, targetUnitSI);
+    return data;
+}
+
+template< typename T >
+inline ConstantView< T >
+RecordComponent::loadConstant(Offset const& o, Extent const& e, double targetUnitSI)
+{
+    if( !m_isConstant )
+        throw std::runtime_error("Only constant RecordComponents can be loaded as a constant view.");
+    verifyChunk(determineDatatype< T >(), o, e);
+    return ConstantView< T >(scaledValue< T >(m_constantValue, scaleFactor(targetUnitSI)), e);
+}
+
+template< typename T >
+inline std::shared_ptr< T const >
+RecordComponent::mapChunk(Offset const& o, Extent const& e)
+{
+    verifyChunk(determineDatatype< T >(), o, e);
+
+    if( !m_isConstant )
+    {
+        Parameter< Operation::MAP_DATASET > dMap;
+        dMap.offset = o;
+        dMap.extent = e;
+        dMap.dtype = determineDatatype< T >();
+        IOHandler->enqueue(IOTask(this, dMap));
+        IOHandler->flush();
+        if( *dMap.view )
+            return std::static_pointer_cast< T const >(*dMap.view);
+    }
+
+    std::shared_ptr< T > data = loadChunk< T >(o, e);
+    IOHandler->flush();
+    return data;
+}
+
 //template< typename T >
 //inline std::unique_ptr< T, std::function< void(T*) > >
 //RecordComponent::loadChunk(Offset o, Extent e, double targetUnitSI)
@@ -191,29 +1132,118 @@ RecordComponent::loadChunk(Offset const& o, Extent const& e, std::unique_ptr< T[
 template< typename T >
 inline void
 RecordComponent::storeChunk(Offset o, Extent e, std::shared_ptr<T> data)
+{
+    Parameter< Operation::WRITE_DATASET > dWrite;
+    dWrite.offset = std::move(o);
+    dWrite.extent = std::move(e);
+    storeLayout(std::move(dWrite), std::move(data));
+}
+
+template< typename T, typename S >
+inline void
+RecordComponent::storeChunk(Offset o, Extent e, std::shared_ptr< S > data, T S::* member)
+{
+    static_assert(sizeof(S) % sizeof(T) == 0, "Size of the struct must be a multiple of the size of its member");
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during chunk store.");
+
+    /* aliasing keeps the structs alive until the values have been written */
+    std::shared_ptr< T > values(data, &(data.get()->*member));
+    Parameter< Operation::WRITE_DATASET > dWrite;
+    dWrite.offset = std::move(o);
+    dWrite.extent = std::move(e);
+    dWrite.memoryStride = sizeof(S) / sizeof(T);
+    storeLayout(std::move(dWrite), std::move(values));
+}
+
+template< typename T >
+inline void
+RecordComponent::storeChunk(Offset o, Extent e, std::shared_ptr< T > data, Offset memoryOffset, Extent memoryExtent)
+{
+    if( memoryExtent.size() != e.size() || memoryOffset.size() != e.size() )
+        throw std::runtime_error("Dimensionality of chunk and memory buffer do not match.");
+    for( size_t i = 0; i < e.size(); ++i )
+        if( memoryExtent[i] < memoryOffset[i] + e[i] )
+            throw std::runtime_error("Chunk does not reside inside memory buffer (Dimension on index " + std::to_string(i)
+                                     + " - Buffer: " + std::to_string(memoryExtent[i])
+                                     + " - Chunk: " + std::to_string(memoryOffset[i] + e[i])
+                                     + ")");
+
+    Parameter< Operation::WRITE_DATASET > dWrite;
+    dWrite.offset = std::move(o);
+    dWrite.extent = std::move(e);
+    /* a chunk spanning the whole buffer is written like a packed one */
+    if( memoryExtent != dWrite.extent )
+    {
+        dWrite.memoryOffset = std::move(memoryOffset);
+        dWrite.memoryExtent = std::move(memoryExtent);
+    }
+    storeLayout(std::move(dWrite), std::move(data));
+}
+
+template< typename T >
+inline void
+RecordComponent::storeLayout(Parameter< Operation::WRITE_DATASET > dWrite, std::shared_ptr< T > data)
+{
+    Datatype dtype = determineDatatype(data);
+    verifyStore(dtype, dWrite.offset, dWrite.extent);
+
+    dWrite.dtype = dtype;
+    dWrite.chunkCache = m_dataset.chunkCache;
+    /* std::static_pointer_cast correctly reference-counts the pointer */
+    dWrite.data = std::static_pointer_cast< void >(data);
+    stageChunk(std::move(dWrite));
+}
+
+template< typename T >
+inline void
+RecordComponent::storeChunk(Offset o, Extent e, T const* data, DeviceMemory const& memory)
+{
+    storeDevice(determineDatatype< T >(), std::move(o), std::move(e), data, memory);
+}
+
+template< typename T >
+inline RecordComponent&
+RecordComponent::append(std::shared_ptr< T > data, uint64_t n)
 {
     if( m_isConstant )
-        throw std::runtime_error("Chunks can not be written for a constant RecordComponent.");
+        throw std::runtime_error("Rows can not be appended to a constant RecordComponent.");
     Datatype dtype = determineDatatype(data);
     if( dtype != getDatatype() )
-        throw std::runtime_error("Datatypes of chunk and dataset do not match.");
-    uint8_t dim = getDimensionality();
-    if( e.size() != dim || o.size() != dim )
-        throw std::runtime_error("Dimensionality of chunk and dataset do not match.");
-    Extent dse = getExtent();
-    for( uint8_t i = 0; i < dim; ++i )
-        if( dse[i] < o[i] + e[i] )
-            throw std::runtime_error("Chunk does not reside inside dataset (Dimension on index " + std::to_string(i)
-                                     + " - DS: " + std::to_string(dse[i])
-                                     + " - Chunk: " + std::to_string(o[i] + e[i])
-                                     + ")");
+        throw std::runtime_error("Datatypes of appended data and dataset do not match.");
+    if( getDimensionality() != 1 )
+        throw std::runtime_error("Rows can only be appended to one-dimensional datasets.");
+    if( m_dataset.fixedSize )
+        throw std::runtime_error("Rows can not be appended to a Dataset of fixed size.");
+    if( n == 0 )
+        return *this;
+
+    if( !m_appending )
+    {
+        /* an empty dataset can not hold any rows yet */
+        if( written && m_dataset.extent[0] != 0 )
+            throw std::runtime_error("Appending to a dataset that has been written without append() is not possible.");
+        m_appending = true;
+        m_appendedSize = 0;
+    }
+
+    uint64_t const size = m_appendedSize + n;
+    if( size > m_dataset.extent[0] )
+    {
+        /* amortize resizing the dataset by doubling its capacity */
+        m_dataset.extent[0] = std::max(size, 2 * m_dataset.extent[0]);
+        if( written )
+            m_extentDirty = true;
+    }
 
     Parameter< Operation::WRITE_DATASET > dWrite;
-    dWrite.offset = o;
-    dWrite.extent = e;
+    dWrite.offset = {m_appendedSize};
+    dWrite.extent = {n};
     dWrite.dtype = dtype;
-    /* std::static_pointer_cast correctly reference-counts the pointer */
+    dWrite.chunkCache = m_dataset.chunkCache;
     dWrite.data = std::static_pointer_cast< void >(data);
-    m_chunks.push(IOTask(this, dWrite));
+    m_appendedSize = size;
+    stageChunk(std::move(dWrite));
+    return *this;
 }
 } // openPMD
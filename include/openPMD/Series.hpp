@@ -20,23 +20,47 @@
  */
 #pragma once
 
+#include "openPMD/auxiliary/BufferPool.hpp"
 #include "openPMD/backend/Attributable.hpp"
 #include "openPMD/backend/Container.hpp"
 #include "openPMD/IO/AbstractIOHandler.hpp"
+#include "openPMD/IO/ADIOS/ADIOS1Transport.hpp"
+#include "openPMD/IO/HDF5/HDF5Options.hpp"
+#include "openPMD/IO/HDF5/ParallelHDF5Options.hpp"
 #include "openPMD/IO/AccessType.hpp"
+#include "openPMD/IO/DrainQueue.hpp"
 #include "openPMD/IO/Format.hpp"
 #include "openPMD/Iteration.hpp"
 #include "openPMD/IterationEncoding.hpp"
+#include "openPMD/ReadFilter.hpp"
 
 #if openPMD_HAVE_MPI
 #   include <mpi.h>
 #endif
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 
 namespace openPMD
 {
+/** Values of a selection of one record component gathered across iterations, see Series::probe.
+ */
+template< typename T >
+struct ProbeResult
+{
+    std::vector< uint64_t > iterations; //!< iterations holding the record component, in increasing order
+    std::shared_ptr< T > data;          //!< the selection of each of these iterations one after another
+};  //ProbeResult
+
 /** @brief  Root level of the openPMD hierarchy.
  *
  * Entry point and common link between all iterations of particle and mesh data.
@@ -47,23 +71,125 @@ namespace openPMD
 class Series : public Attributable
 {
     friend class Iteration;
+    friend class RecordComponent;
 
 public:
 #if openPMD_HAVE_MPI
     static Series create(std::string const& filepath,
                          MPI_Comm comm,
                          AccessType at = AccessType::CREATE);
+    /** Create a parallel ADIOS1 (.bp) Series written through a specific transport method.
+     *
+     * @param   transport   Method and parameters of ADIOS1, e.g. ADIOS1Transport::aggregate(numAggregators).
+     * @throws  std::runtime_error  If filepath does not end in .bp.
+     */
+    static Series create(std::string const& filepath,
+                         MPI_Comm comm,
+                         ADIOS1Transport const& transport,
+                         AccessType at = AccessType::CREATE);
+    /** Create a parallel HDF5 (.h5) Series with specific options, e.g. collective metadata writes, file alignment or MPI-IO hints.
+     *
+     * @param   options     Options of parallel HDF5 applied to all files of this Series.
+     * @throws  std::runtime_error  If filepath does not end in .h5.
+     */
+    static Series create(std::string const& filepath,
+                         MPI_Comm comm,
+                         ParallelHDF5Options const& options,
+                         AccessType at = AccessType::CREATE);
+    /** Create a parallel Series that is written to a staging directory first and moved to its final location in the background.
+     *
+     * See the serial variant. As files are shared by all ranks, the staging directory has to be visible to all of them
+     * (e.g. a shared burst buffer allocation), node-local storage only works with a single rank per Series.
+     * Files are moved by the first rank, the other ranks report no progress in drainStatus().
+     */
+    static Series create(std::string const& filepath,
+                         MPI_Comm comm,
+                         std::string const& stagingDirectory);
 #endif
     static Series create(std::string const& filepath,
                          AccessType at = AccessType::CREATE);
+    /** Create an HDF5 (.h5) Series with specific options, e.g. to build each file in memory and write it in one go.
+     *
+     * @param   options     Options of HDF5 applied to all files of this Series.
+     * @throws  std::runtime_error  If filepath does not end in .h5.
+     */
+    static Series create(std::string const& filepath,
+                         HDF5Options const& options,
+                         AccessType at = AccessType::CREATE);
+    /** Create a Series that is written to a staging directory first and moved to its final location in the background.
+     *
+     * Files are created in stagingDirectory (e.g. node-local NVMe or a burst buffer) instead of the directory of filepath,
+     * so flushes complete at the speed of the staging storage. Complete files are moved to the directory of filepath
+     * (e.g. on a parallel filesystem) on a background thread: in fileBased encoding the file of an iteration
+     * when the iteration is closed (Iteration::close), all other files (including the manifest) when the Series is destroyed.
+     * A file appears in the final directory only once it has been copied completely, and is removed from the staging directory afterwards.
+     * Use drainStatus() to query the progress and awaitDrain() to wait for it, the destructor waits for all files.
+     *
+     * @param   filepath            Final location of the Series.
+     * @param   stagingDirectory    Directory the files are written to until they are complete.
+     * @throws  std::runtime_error  If the filename extension is not recognized or denotes a stream (.sst, .ssc).
+     */
+    static Series create(std::string const& filepath,
+                         std::string const& stagingDirectory);
 
 #if openPMD_HAVE_MPI
     static Series read(std::string const& filepath,
                        MPI_Comm comm,
                        AccessType at = AccessType::READ_ONLY);
+    /** Read a parallel HDF5 (.h5) Series with specific options, e.g. to let only one rank per node read the metadata.
+     *
+     * @param   options     Options of parallel HDF5 applied to all files of this Series.
+     * @throws  std::runtime_error  If filepath does not end in .h5.
+     */
+    static Series read(std::string const& filepath,
+                       MPI_Comm comm,
+                       ParallelHDF5Options const& options,
+                       AccessType at = AccessType::READ_ONLY);
+    /** Read only a part of a parallel Series, see the serial variant. */
+    static Series read(std::string const& filepath,
+                       MPI_Comm comm,
+                       ReadFilter const& filter,
+                       AccessType at = AccessType::READ_ONLY);
 #endif
     static Series read(std::string const& filepath,
                        AccessType at = AccessType::READ_ONLY);
+    /** Read an HDF5 (.h5) Series with specific options, e.g. to load each file into memory up front.
+     *
+     * @param   options     Options of HDF5 applied to all files of this Series.
+     * @throws  std::runtime_error  If filepath does not end in .h5.
+     */
+    static Series read(std::string const& filepath,
+                       HDF5Options const& options,
+                       AccessType at = AccessType::READ_ONLY);
+    /** Read only a part of a Series, e.g. its fields without the particle species.
+     *
+     * Iterations, meshes, particle species and records excluded by filter are not opened
+     * and are missing from the Series as if they had not been written.
+     *
+     * @param   filter  Iteration range and include lists of the objects read.
+     * @throws  std::runtime_error  If at is not AccessType::READ_ONLY, as a partially read Series can not be extended.
+     */
+    static Series read(std::string const& filepath,
+                       ReadFilter const& filter,
+                       AccessType at = AccessType::READ_ONLY);
+
+#if openPMD_HAVE_MPI
+    static Series restart(std::string const& filepath,
+                          MPI_Comm comm);
+#endif
+    /** Open a Series written in checkpoint mode (see setCheckpointMode) as read only, to restart from it.
+     *
+     * Iterations that carry a checkpoint layout are opened along it: all groups and datasets of the iteration
+     * are opened in a single batch, instead of listing every group and reading the attributes of every record
+     * and record component one after another. Records and record components of such iterations only carry
+     * their datasets (and the values of constant components); their attributes keep the defaults of new objects
+     * (e.g. a unitSI of 1), so chunks have to be loaded in the units they are stored in. As the decomposition of a restart is known up front,
+     * each rank registers the chunks it needs with RecordComponent::loadChunk and loads them in a single flush.
+     * Iterations without a layout are read in full.
+     *
+     * @throws  std::runtime_error  If the filename extension is not recognized.
+     */
+    static Series restart(std::string const& filepath);
     ~Series();
 
     /**
@@ -233,36 +359,398 @@ public:
      */
     Series& setName(std::string const& name);
 
+    /**
+     * @return  Pool providing buffers allocated by the API, empty if plain allocation is used.
+     */
+    std::shared_ptr< auxiliary::BufferPool > bufferPool() const;
+    /** Set the pool providing buffers allocated by the API (e.g. RecordComponent::loadChunk without a user buffer).
+     *
+     * @param   pool    Pool shared by all objects in this series, empty to use plain allocation.
+     * @return  Reference to modified series.
+     */
+    Series& setBufferPool(std::shared_ptr< auxiliary::BufferPool > pool);
+    /** Size the raw data chunk cache of all datasets that do not set their own (see Dataset::setChunkCache).
+     *
+     * By default (bytes of 0), the cache of each dataset is sized to hold one slab along its slowest dimension.
+     * Only supported by the HDF5 backend, ignored by the others.
+     *
+     * @return  Reference to modified series.
+     */
+    Series& setChunkCache(std::size_t bytes, std::size_t slots = 0, double preemption = 0.75);
+    /** Choose when the storage of all datasets created from now on that do not set their own (see Dataset::setAllocation)
+     *  is allocated and filled.
+     *
+     * The defaults of the backend are used for DEFAULT. Serial HDF5 keeps the defaults of HDF5
+     * (chunks are allocated and filled when first written). Parallel HDF5 does not write fill values,
+     * as it allocates datasets early and would otherwise write every dataset twice;
+     * elements of a dataset that are never written then hold undefined values.
+     * Only supported by the HDF5 backend, ignored by the others.
+     *
+     * @return  Reference to modified series.
+     */
+    Series& setAllocation(AllocationTime time, FillTime fill = FillTime::DEFAULT);
+
+    /** Bound the memory held by chunks registered with RecordComponent::storeChunk.
+     *
+     * Once the staged chunks exceed the budget, the Series is flushed from within storeChunk.
+     * The file structure and attributes are written right away, the chunk data is written in the background
+     * (for fileBased iteration encoding, only the data of the last modified iteration).
+     * At most one such batch is in flight, so peak memory stays around twice the budget.
+     * All objects that are part of the Series at that point are written,
+     * so datasets have to be declared (RecordComponent::resetDataset) before chunks are stored into them.
+     * Errors of the background write are reported by the next flush.
+     *
+     * @param   bytes   Budget in bytes, 0 to only write on explicit flushes.
+     * @param   mode    Whether chunks are referenced (user buffers must stay unmodified until written) or copied.
+     * @return  Reference to modified series.
+     */
+    Series& setStagingBudget(std::size_t bytes, StagingMode mode = StagingMode::REFERENCE);
+    /** Maintain a manifest of the files of a fileBased Series while writing.
+     *
+     * The manifest is stored next to the files as <name>.manifest (e.g. data%T.manifest for data%T.h5)
+     * and lists the index and file of every written iteration. It is rewritten whenever a flush creates new files.
+     * When reading, the iterations are taken from the manifest if there is one, instead of listing the directory
+     * and matching every entry against the file name pattern, which is slow for directories with many files.
+     * With MPI, only the first rank writes the manifest.
+     *
+     * @param   enabled Write the manifest on the following flushes.
+     * @return  Reference to modified series.
+     */
+    Series& setManifest(bool enabled);
+    /** Write the following flushes as checkpoints, to be opened with restart().
+     *
+     * Every iteration flushed in checkpoint mode carries the attribute checkpointLayout, which lists the location
+     * of each of its record components relative to the iteration, e.g. "dataset:meshes/E/x"
+     * or "constant:particles/e/charge". The files stay valid openPMD files and can be read with read() as well.
+     *
+     * @param   enabled Record the layout of iterations on the following flushes.
+     * @throws  std::runtime_error  If the Series has been opened as read only.
+     * @return  Reference to modified series.
+     */
+    Series& setCheckpointMode(bool enabled);
+    /** Rewrite datasets and constants in place, e.g. for rolling restart files or a ring buffer of diagnostic iterations.
+     *
+     * In overwrite mode, record components that have been written can be redefined with RecordComponent::resetDataset
+     * and RecordComponent::makeConstant, instead of deleting and creating them again. When the backend creates a dataset
+     * and the file already holds one of the same datatype and dimensionality under its name, that dataset is reused
+     * (its extent adapted if needed), so neither the file grows nor is storage allocated again.
+     * Anything else stored under the name is replaced. Groups that already exist are reused as well,
+     * objects below them that are not rewritten keep their contents.
+     *
+     * @param   enabled Reuse existing objects on the following flushes.
+     * @throws  std::runtime_error  If the Series has been opened as read only or is not stored in HDF5.
+     * @return  Reference to modified series.
+     */
+    Series& setOverwriteMode(bool enabled);
+    /** Let flush() return once the structure and attributes are written, and write the chunk data in the background.
+     *
+     * Chunks that reference user buffers (StagingMode::REFERENCE) are copied into buffers of the BufferPool
+     * when they are handed over, so the user buffers can be filled with the next step right after flush() returns,
+     * while the previous step is written on the IO thread of the backend (double buffering).
+     * At most one write is in flight: the next flush, and any other call performing IO, waits for it first,
+     * which bounds the memory held by copies to one step. Use stagingStatus() to poll for completion
+     * and awaitWrites() to wait for it. Errors of the background write are reported by the next flush.
+     *
+     * Parallel HDF5 writes collectively from the IO thread only if MPI has been initialized with
+     * MPI_THREAD_MULTIPLE, otherwise the data is written before flush() returns.
+     * Backends without an IO thread always write the data before flush() returns.
+     *
+     * @param   enabled Write the data of the following flushes in the background.
+     * @throws  std::runtime_error  If the Series has been opened as read only.
+     * @return  Reference to modified series.
+     */
+    Series& setAsyncWrites(bool enabled);
+    /** Wait for the chunk data written in the background (see setAsyncWrites and setStagingBudget).
+     *
+     * @throws  Any error that interrupted the background write.
+     * @return  Reference to this series.
+     */
+    Series& awaitWrites();
+    /**
+     * @return  Chunks registered since the last flush and state of the automatic and asynchronous flushes.
+     */
+    StagingStatus stagingStatus() const;
+    /** Memory and work held until the next flush, from counters kept up to date while chunks are registered.
+     *
+     * @param   largest Maximum number of record components to report with the most staged bytes.
+     * @return  Staged chunks, enqueued operations and the components holding the most staged bytes.
+     */
+    PendingWrites pendingWrites(std::size_t largest = 8) const;
+    /** Progress of moving files from the staging directory to their final location (see create with a staging directory).
+     *
+     * @return  Files and bytes moved so far and still pending, all zero if the Series is not staged.
+     */
+    DrainStatus drainStatus() const;
+    /** Wait until all files closed so far have been moved from the staging directory to their final location.
+     *
+     * @throws  std::runtime_error  If moving a file failed, it is left in the staging directory.
+     * @return  Reference to this series.
+     */
+    Series& awaitDrain();
+
+    /** Count, transferred bytes and wall time (cumulative and as histogram) of all IO operations processed so far.
+     *
+     * Only recorded if openPMD-api is built with openPMD_USE_INSTRUMENTATION=ON, empty otherwise.
+     *
+     * @return  Statistics of every Operation that has been processed at least once.
+     */
+    std::map< Operation, OperationStatistics > ioStatistics() const;
+    /** Discard all IO statistics recorded so far.
+     *
+     * @return  Reference to modified series.
+     */
+    Series& resetIOStatistics();
+    /** Start tracing all IO operations of this series (requires openPMD_USE_INSTRUMENTATION=ON).
+     *
+     * Each processed operation becomes one event in Chrome trace event format, carrying the location of the object
+     * in the file, the transferred bytes and the times it has been enqueued, dispatched and completed.
+     *
+     * @param   filename    File the trace is written to on stopTrace() (or when the series is destroyed).
+     *                      <CODE>\%R</CODE> is replaced by the rank in MPI_COMM_WORLD (0 without MPI), which is also used as process id.
+     * @return  Reference to modified series.
+     */
+    Series& startTrace(std::string const& filename);
+    /** Write the trace started with startTrace() and stop tracing.
+     *
+     * @return  Reference to modified series.
+     */
+    Series& stopTrace();
+
     /** Execute all required remaining IO operations to write or read data.
      */
     void flush();
+    /** Execute all required remaining IO operations to write or read data without waiting for their completion.
+     *
+     * Backends that support it process the operations on a dedicated IO thread.
+     * Until the returned future is ready, neither this Series (and its contained objects)
+     * nor the contents of buffers passed to RecordComponent::storeChunk or RecordComponent::loadChunk must be accessed.
+     * Any other call that performs IO (e.g. flush()) waits for the pending operations first.
+     * In fileBased encoding, the handles of the Series are re-used for the file of each iteration,
+     * so all modified iterations but the last one are written synchronously during this call.
+     *
+     * @return  Future that becomes ready once all operations have completed
+     *          (or holds the exception that interrupted them).
+     */
+    std::future< void > flushAsync();
+    /** Move a streamed Series opened for reading to the next step written by the producer.
+     *
+     * For streaming backends (e.g. ADIOS2 SST, file extension .sst), every flush() of the writer forms one step.
+     * Advancing releases the current step, so all data has to be loaded before this call.
+     * The iterations are then re-populated from the new step.
+     * Blocks until the next step is available or the writer has closed the stream.
+     *
+     * @return  AdvanceStatus::OVER if there is no further step (always the case for file-based backends).
+     */
+    AdvanceStatus advance();
+    /** Register the iterations a writer has added to a Series opened for reading since it has been read.
+     *
+     * Only the new iterations are discovered and parsed, known iterations keep their state:
+     * in fileBased encoding new files are registered (and parsed on first access like all iterations),
+     * in groupBased encoding the new groups below the base path are opened and parsed.
+     * HDF5 files are reopened to observe the changes of the writer, ADIOS files list only what
+     * has been written when they were opened (see advance() for streams).
+     * Filtered iterations (see ReadFilter) stay excluded.
+     *
+     * @throws  std::runtime_error  If the Series has not been opened as read only,
+     *                              or it is groupBased and has been opened with MPI.
+     * @return  Reference to this series.
+     */
+    Series& refresh();
+    /** Open and parse all iterations of a fileBased Series opened for reading that have not been accessed yet.
+     *
+     * The files are opened by a pool of worker threads, each with a backend handle of its own,
+     * and parsed into their iterations concurrently, which hides the latency of opening many files
+     * (e.g. on network file systems). Iterations keep using the handle of the worker that parsed them,
+     * deferred loads are still processed by flush().
+     * If the HDF5 library is not thread-safe, the workers take turns in calling it.
+     * For ADIOS1 and Series opened with MPI or for writing, the files are parsed one after another.
+     *
+     * @param   workers Number of worker threads, 0 for the number of hardware threads.
+     * @return  Reference to this series.
+     */
+    Series& openIterations(unsigned int workers = 0);
+    /** Register a chunk to be loaded ahead of time when walking through the iterations of a Series opened for reading.
+     *
+     * Whenever an iteration is opened (explicitly or by accessing it through iterations),
+     * the following iteration is parsed and the registered chunks of it are read in the background
+     * into buffers from the BufferPool of the Series (see setBufferPool), while the current iteration is processed.
+     * RecordComponent::loadChunk without a user buffer then hands out the prefetched buffer
+     * if the same chunk is requested in the stored datatype and without unit conversion.
+     * Chunks that do not reside inside the dataset of an iteration (e.g. if the number of particles changes)
+     * and records that do not exist in an iteration are skipped.
+     *
+     * @param   path    Location of the record component relative to the iteration,
+     *                  e.g. "meshes/E/x", "particles/e/position/x", or "meshes/rho" for a scalar record.
+     * @throw   std::invalid_argument   If path does not name a mesh or particle record (component).
+     * @return  Reference to this series.
+     */
+    Series& prefetch(std::string const& path, Offset const& offset, Extent const& extent);
+    /** Stop loading chunks ahead of time, chunks that have already been requested stay available.
+     *
+     * @return  Reference to this series.
+     */
+    Series& clearPrefetch();
+    /** Gather the values of a record component in a small selection (e.g. a probe point or box) across iterations.
+     *
+     * The iterations in [first, last] that have not been accessed yet are opened like in openIterations(),
+     * concurrently where supported. Only the record holding the component is opened in each of them,
+     * and the selection of every iteration is read directly into its place in the returned buffer,
+     * by the worker that parsed the iteration. Iterations that do not hold the component are skipped.
+     *
+     * @param   path    Location of the record component relative to the iteration, see prefetch().
+     * @param   first   Index of the first iteration to gather.
+     * @param   last    Index of the last iteration to gather.
+     * @param   workers Number of worker threads, 0 for the number of hardware threads.
+     * @throw   std::invalid_argument   If path does not name a mesh or particle record (component).
+     * @throw   std::runtime_error      If the selection does not reside inside the dataset of an iteration.
+     * @return  Indices of the gathered iterations and their values,
+     *          prod(extent) values (in the layout of the dataset) for each iteration.
+     */
+    template< typename T >
+    ProbeResult< T > probe(std::string const& path,
+                           Offset const& offset,
+                           Extent const& extent,
+                           uint64_t first = 0,
+                           uint64_t last = std::numeric_limits< uint64_t >::max(),
+                           unsigned int workers = 0);
 
-    Container< Iteration, uint64_t > iterations;
+    IterationContainer iterations;
 
 private:
 #if openPMD_HAVE_MPI
     Series(std::string const& filepath,
            AccessType at,
-           MPI_Comm comm);
+           MPI_Comm comm,
+           ADIOS1Transport const* transport = nullptr,
+           ParallelHDF5Options const* hdf5Options = nullptr,
+           bool restart = false,
+           std::string const& stagingDirectory = std::string(),
+           ReadFilter const* filter = nullptr);
 #endif
     Series(std::string const& filepath,
-           AccessType at);
+           AccessType at,
+           HDF5Options const* hdf5Options = nullptr,
+           bool restart = false,
+           std::string const& stagingDirectory = std::string(),
+           ReadFilter const* filter = nullptr);
 
-    void flushFileBased();
-    void flushGroupBased();
+    std::string childName(Writable const* child) const override;
+    /** Position of an object below this Series in the object model, e.g. "iterations/100/meshes/E/x".
+     */
+    static std::string objectPath(Writable const*);
+
+    void flushEncoding();
+    /** Write the structure and attributes, then hand the chunk data to the backend without waiting for it.
+     *
+     * @param   automatic   Triggered by exceeding the staging budget (counted in StagingStatus::autoFlushes).
+     */
+    void flushStaged(bool automatic = true);
+    void awaitStaged();
+    void flushEncoding(IterationContainer::InternalContainer::iterator begin, IterationContainer::InternalContainer::iterator end);
+    void flushFileBased(IterationContainer::InternalContainer::iterator begin, IterationContainer::InternalContainer::iterator end);
+    void flushGroupBased(IterationContainer::InternalContainer::iterator begin, IterationContainer::InternalContainer::iterator end);
     void flushMeshesPath();
     void flushParticlesPath();
+    void prefetchAfter(Iteration const&);
+    void awaitPrefetch();
+    /** Open the iterations in [first, last] (see openIterations), calling visit on each of them once it has been parsed.
+     *
+     * Iterations parsed by a worker are visited by its thread, which then processes the tasks enqueued by visit.
+     * All other iterations are visited by the calling thread, their tasks are left for the next flush.
+     */
+    void openIterations(uint64_t first, uint64_t last, unsigned int workers,
+                        std::function< void(uint64_t, Iteration&) > const& visit);
+    /** Call read on the record component at path of each iteration in [first, last] that holds it, then flush. */
+    void probeIterations(std::string const& path, uint64_t first, uint64_t last, unsigned int workers,
+                         std::function< void(uint64_t, RecordComponent&) > const& read);
     void readFileBased();
+    /** Find the files of a fileBased Series by its manifest, or by the iteration regex in its directory. */
+    void listFiles(std::map< uint64_t, std::string >& files);
+    /** Register the iterations of files that are not known yet, to be parsed on first access. */
+    void registerFiles(std::map< uint64_t, std::string > const& files);
+    /** Replace the manifest by one listing all written iterations. */
+    void writeManifest();
+    /** @return True if files has been filled from a valid manifest. */
+    bool readManifest(std::map< uint64_t, std::string >& files);
+    /** Move the files of an iteration (or of a groupBased Series) from the staging directory, once they have been closed. */
+    void drain(std::string const& name);
+    /** Close all files that are still open and move them from the staging directory, along with the manifest. */
+    void drainRemaining();
     void readGroupBased();
     void readBase();
     void read();
+    /** Open and parse the iterations of a groupBased Series named by paths that are not known yet. */
+    void readIterations(std::vector< std::string > const& paths);
 
     static std::string cleanFilename(std::string, Format);
 
     constexpr static char const * const OPENPMD = "1.1.0";
     constexpr static char const * const BASEPATH = "/data/%T/";
+    constexpr static char const * const MANIFEST = "openPMD-api manifest 1";
+
+    struct ParseWorker;
+    struct PrefetchRegion
+    {
+        std::vector< std::string > path;
+        Offset offset;
+        Extent extent;
+    };
 
     IterationEncoding m_iterationEncoding;
     std::string m_name;
+    Format m_format;
+    bool m_parallel;    /* files are opened collectively, so they can not be parsed concurrently */
+    bool m_writeManifest;
+    bool m_manifestWriter;  /* not set on all but the first rank of a parallel Series */
+    bool m_checkpoint;  /* write the layout of flushed iterations, or open iterations along their layout when reading */
+    std::vector< std::shared_ptr< ParseWorker > > m_parseWorkers;   /* handles used by iterations parsed in openIterations() */
+    std::vector< PrefetchRegion > m_prefetch;
+    std::shared_future< void > m_prefetchInFlight;  /* reads ahead handed to the backend, their errors are rethrown on the next access */
+    std::shared_ptr< DrainQueue > m_drain;  /* files are created in its staging directory if set */
+    ReadFilter m_filter;    /* objects excluded by it are skipped when reading */
 };  //Series
+
+template< typename T >
+inline ProbeResult< T >
+Series::probe(std::string const& path,
+              Offset const& offset,
+              Extent const& extent,
+              uint64_t first,
+              uint64_t last,
+              unsigned int workers)
+{
+    if( offset.size() != extent.size() )
+        throw std::invalid_argument("Dimensionality of probed offset and extent do not match.");
+    uint64_t n = 1;
+    for( auto e : extent )
+        n *= e;
+
+    std::vector< uint64_t > range;
+    for( auto const& i : iterations )
+        if( i.first >= first && i.first <= last )
+            range.push_back(i.first);
+
+    ProbeResult< T > ret;
+    ret.data = std::shared_ptr< T >(new T[range.size() * n], [](T* p){ delete[] p; });
+    /* written by the workers, one element each */
+    std::vector< char > found(range.size(), 0);
+    probeIterations(path, first, last, workers, [&](uint64_t index, RecordComponent& rc)
+    {
+        std::size_t slot = std::lower_bound(range.begin(), range.end(), index) - range.begin();
+        found[slot] = 1;
+        rc.loadChunk(offset, extent, std::shared_ptr< T >(ret.data, ret.data.get() + slot * n));
+    });
+
+    /* close the gaps of iterations that do not hold the component */
+    T* data = ret.data.get();
+    for( std::size_t slot = 0; slot < range.size(); ++slot )
+        if( found[slot] )
+        {
+            std::size_t const next = ret.iterations.size();
+            if( next != slot )
+                std::copy(data + slot * n, data + (slot + 1) * n, data + next * n);
+            ret.iterations.push_back(range[slot]);
+        }
+    return ret;
+}
 } // openPMD
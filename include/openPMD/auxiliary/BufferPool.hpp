@@ -0,0 +1,224 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#if defined(__linux__)
+#   include <sys/mman.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+
+namespace openPMD
+{
+namespace auxiliary
+{
+/** Pool of aligned, reusable raw buffers.
+ *
+ * Buffers handed out by the pool return to it once their last owner releases them,
+ * so repeated allocations of the same size (e.g. reading equally sized chunks in every iteration)
+ * do not hit the system allocator again.
+ * Buffers stay valid independent of the lifetime of the pool object itself.
+ */
+class BufferPool
+{
+public:
+    /**
+     * @param   alignment       Alignment in bytes of all buffers, must be a power of two.
+     * @param   maxCachedBytes  Upper bound for the total size of released buffers kept for re-use.
+     * @param   hugePages       Advise the OS to back buffers of at least hugePageSize bytes with huge pages (Linux only).
+     */
+    explicit BufferPool(std::size_t alignment = 64u,
+                        std::size_t maxCachedBytes = std::size_t(1) << 30,
+                        bool hugePages = false)
+            : m_state{std::make_shared< State >()}
+    {
+        if( alignment == 0 || (alignment & (alignment - 1)) != 0 )
+            throw std::runtime_error("Alignment of BufferPool must be a power of two.");
+        m_state->alignment = alignment;
+        m_state->maxCachedBytes = maxCachedBytes;
+        m_state->hugePages = hugePages;
+    }
+    /** Pool of buffers obtained from a custom allocator, e.g. page-locked host memory for transfers to and from a GPU.
+     *
+     * Allocations are rounded up to multiples of alignment, the allocator has to align them itself.
+     *
+     * @param   allocate        Returns a buffer of the given size in bytes, throws (or returns nullptr) on failure.
+     * @param   release         Frees a buffer returned by allocate.
+     * @param   maxCachedBytes  Upper bound for the total size of released buffers kept for re-use.
+     */
+    BufferPool(std::function< void*(std::size_t) > allocate,
+               std::function< void(void*) > release,
+               std::size_t maxCachedBytes = std::size_t(1) << 30,
+               std::size_t alignment = 64u)
+            : BufferPool(alignment, maxCachedBytes)
+    {
+        if( !allocate || !release )
+            throw std::runtime_error("BufferPool requires both an allocation and a release function.");
+        m_state->allocateCustom = std::move(allocate);
+        m_state->releaseCustom = std::move(release);
+    }
+
+    static constexpr std::size_t hugePageSize = std::size_t(2) << 20;
+
+    /** Obtain a buffer of at least the requested size, re-using a released one if possible.
+     */
+    std::unique_ptr< void, std::function< void(void*) > >
+    allocate(std::size_t bytes)
+    {
+        std::shared_ptr< State > state = m_state;
+        std::size_t const size = state->roundUp(bytes);
+        void* data = state->take(size);
+        if( !data )
+            data = state->create(size);
+        return std::unique_ptr< void, std::function< void(void*) > >(
+                data,
+                [state, size](void* p){ state->give(p, size); });
+    }
+
+    /** Release all currently unused buffers to the system.
+     */
+    void trim()
+    {
+        m_state->trim();
+    }
+
+    /**
+     * @return  Total size in bytes of released buffers currently kept for re-use.
+     */
+    std::size_t cachedBytes() const
+    {
+        std::lock_guard< std::mutex > lock(m_state->mutex);
+        return m_state->cachedBytes;
+    }
+
+private:
+    struct State
+    {
+        ~State()
+        {
+            trim();
+        }
+
+        std::size_t roundUp(std::size_t bytes) const
+        {
+            std::size_t a = granularity(bytes);
+            return ((bytes == 0 ? 1 : bytes) + a - 1) / a * a;
+        }
+
+        std::size_t granularity(std::size_t bytes) const
+        {
+            if( hugePages && bytes >= hugePageSize && alignment < hugePageSize )
+                return hugePageSize;
+            return alignment;
+        }
+
+        void* take(std::size_t size)
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+            auto it = free.find(size);
+            if( it == free.end() )
+                return nullptr;
+            void* p = it->second;
+            free.erase(it);
+            cachedBytes -= size;
+            return p;
+        }
+
+        void* create(std::size_t size) const
+        {
+            if( allocateCustom )
+            {
+                void* p = allocateCustom(size);
+                if( !p )
+                    throw std::bad_alloc();
+                return p;
+            }
+            std::size_t const a = granularity(size);
+            /* over-allocate to align manually, remember the original address in front of the buffer */
+            char* raw = static_cast< char* >(::operator new(size + a + sizeof(void*)));
+            std::uintptr_t start = reinterpret_cast< std::uintptr_t >(raw + sizeof(void*));
+            char* aligned = reinterpret_cast< char* >((start + a - 1) / a * a);
+            reinterpret_cast< void** >(aligned)[-1] = raw;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            if( a == hugePageSize )
+                madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+            return aligned;
+        }
+
+        void destroy(void* p) const
+        {
+            if( releaseCustom )
+                releaseCustom(p);
+            else
+                ::operator delete(static_cast< void** >(p)[-1]);
+        }
+
+        void give(void* p, std::size_t size)
+        {
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+                if( cachedBytes + size <= maxCachedBytes )
+                {
+                    free.emplace(size, p);
+                    cachedBytes += size;
+                    return;
+                }
+            }
+            destroy(p);
+        }
+
+        void trim()
+        {
+            std::multimap< std::size_t, void* > released;
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+                std::swap(released, free);
+                cachedBytes = 0;
+            }
+            for( auto const& b : released )
+                destroy(b.second);
+        }
+
+        std::size_t alignment;
+        std::size_t maxCachedBytes;
+        bool hugePages;
+        std::function< void*(std::size_t) > allocateCustom;
+        std::function< void(void*) > releaseCustom;
+
+        std::mutex mutex;
+        std::multimap< std::size_t, void* > free;
+        std::size_t cachedBytes = 0;
+    };  //State
+
+    std::shared_ptr< State > m_state;
+};  //BufferPool
+} // auxiliary
+} // openPMD
@@ -0,0 +1,216 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#   define openPMD_HAVE_CRC32C_SSE42 1
+#   include <nmmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+
+namespace openPMD
+{
+namespace auxiliary
+{
+namespace detail
+{
+/* reflected Castagnoli polynomial */
+constexpr uint32_t crc32cPolynomial = 0x82F63B78u;
+
+/* tables of the slicing-by-8 software implementation */
+inline std::array< std::array< uint32_t, 256 >, 8 > const&
+crc32cTables()
+{
+    static std::array< std::array< uint32_t, 256 >, 8 > const tables = []()
+    {
+        std::array< std::array< uint32_t, 256 >, 8 > t;
+        for( uint32_t i = 0; i < 256; ++i )
+        {
+            uint32_t c = i;
+            for( int k = 0; k < 8; ++k )
+                c = (c >> 1) ^ (crc32cPolynomial & (0u - (c & 1u)));
+            t[0][i] = c;
+        }
+        for( uint32_t i = 0; i < 256; ++i )
+            for( std::size_t s = 1; s < 8; ++s )
+                t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFFu];
+        return t;
+    }();
+    return tables;
+}
+
+/* crc is the inverted running state, bytes are processed eight at a time (little endian words) */
+inline uint32_t
+crc32cSoftware(uint32_t crc, unsigned char const* p, std::size_t n)
+{
+    auto const& t = crc32cTables();
+    for( ; n >= 8; n -= 8, p += 8 )
+    {
+        uint32_t lo = crc ^ (uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24);
+        uint32_t hi = uint32_t(p[4]) | uint32_t(p[5]) << 8 | uint32_t(p[6]) << 16 | uint32_t(p[7]) << 24;
+        crc = t[7][lo & 0xFFu] ^ t[6][(lo >> 8) & 0xFFu] ^ t[5][(lo >> 16) & 0xFFu] ^ t[4][lo >> 24]
+            ^ t[3][hi & 0xFFu] ^ t[2][(hi >> 8) & 0xFFu] ^ t[1][(hi >> 16) & 0xFFu] ^ t[0][hi >> 24];
+    }
+    for( ; n > 0; --n, ++p )
+        crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFFu];
+    return crc;
+}
+
+#if openPMD_HAVE_CRC32C_SSE42
+__attribute__((target("sse4.2")))
+inline uint32_t
+crc32cHardware(uint32_t crc, unsigned char const* p, std::size_t n)
+{
+    uint64_t c = crc;
+    for( ; n >= 8; n -= 8, p += 8 )
+    {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        c = _mm_crc32_u64(c, word);
+    }
+    uint32_t c32 = static_cast< uint32_t >(c);
+    for( ; n > 0; --n, ++p )
+        c32 = _mm_crc32_u8(c32, *p);
+    return c32;
+}
+
+inline bool
+crc32cHardwareSupported()
+{
+    static bool const supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+#endif
+
+/* sum of the columns of a GF(2) matrix selected by the bits of vec */
+inline uint32_t
+gf2Times(uint32_t const* mat, uint32_t vec)
+{
+    uint32_t sum = 0;
+    for( ; vec != 0; vec >>= 1, ++mat )
+        if( vec & 1u )
+            sum ^= *mat;
+    return sum;
+}
+
+inline void
+gf2Square(uint32_t* square, uint32_t const* mat)
+{
+    for( int n = 0; n < 32; ++n )
+        square[n] = gf2Times(mat, mat[n]);
+}
+} // detail
+
+/** CRC32C (Castagnoli) checksum of bytes, e.g. to detect corrupted chunks.
+ *
+ * Uses the SSE4.2 instruction where the CPU supports it, a table-driven implementation otherwise.
+ *
+ * @param   crc Checksum of the preceding bytes, to checksum a buffer piece by piece.
+ */
+inline uint32_t
+crc32c(void const* data, std::size_t bytes, uint32_t crc = 0)
+{
+    auto const* p = static_cast< unsigned char const* >(data);
+#if openPMD_HAVE_CRC32C_SSE42
+    if( detail::crc32cHardwareSupported() )
+        return ~detail::crc32cHardware(~crc, p, bytes);
+#endif
+    return ~detail::crc32cSoftware(~crc, p, bytes);
+}
+
+/** Checksum of the concatenation of two buffers from their checksums, see crc32c().
+ *
+ * @param   second  Size in bytes of the second buffer.
+ */
+inline uint32_t
+crc32cCombine(uint32_t crcFirst, uint32_t crcSecond, std::size_t second)
+{
+    if( second == 0 )
+        return crcFirst;
+
+    /* the state is advanced by second zero bytes through repeated squaring of the one-bit operator */
+    uint32_t even[32];
+    uint32_t odd[32];
+    odd[0] = detail::crc32cPolynomial;
+    for( int n = 1; n < 32; ++n )
+        odd[n] = 1u << (n - 1);
+    detail::gf2Square(even, odd);
+    detail::gf2Square(odd, even);
+    do
+    {
+        detail::gf2Square(even, odd);
+        if( second & 1u )
+            crcFirst = detail::gf2Times(even, crcFirst);
+        second >>= 1;
+        if( second == 0 )
+            break;
+        detail::gf2Square(odd, even);
+        if( second & 1u )
+            crcFirst = detail::gf2Times(odd, crcFirst);
+        second >>= 1;
+    } while( second != 0 );
+    return crcFirst ^ crcSecond;
+}
+
+/** crc32c() of a large buffer, computed in segments by several threads and combined.
+ *
+ * @param   threads Upper bound of the number of threads, 0 for the number of hardware threads.
+ *                  Each thread checksums at least minSegment bytes.
+ */
+inline uint32_t
+crc32cParallel(void const* data, std::size_t bytes, unsigned int threads = 0,
+               std::size_t minSegment = std::size_t(8) << 20)
+{
+    if( threads == 0 )
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t const segments = std::min< std::size_t >(threads, std::max< std::size_t >(1u, bytes / minSegment));
+    if( segments <= 1 )
+        return crc32c(data, bytes);
+
+    auto const* p = static_cast< unsigned char const* >(data);
+    std::size_t const length = bytes / segments;
+    std::vector< uint32_t > crcs(segments);
+    std::vector< std::thread > pool;
+    for( std::size_t s = 1; s < segments; ++s )
+        pool.emplace_back([&crcs, p, length, bytes, segments, s]()
+        {
+            std::size_t const end = s + 1 == segments ? bytes : (s + 1) * length;
+            crcs[s] = crc32c(p + s * length, end - s * length);
+        });
+    crcs[0] = crc32c(p, length);
+    for( auto& t : pool )
+        t.join();
+
+    uint32_t crc = crcs[0];
+    for( std::size_t s = 1; s < segments; ++s )
+        crc = crc32cCombine(crc, crcs[s], (s + 1 == segments ? bytes : (s + 1) * length) - s * length);
+    return crc;
+}
+} // auxiliary
+} // openPMD
@@ -0,0 +1,322 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace openPMD
+{
+namespace auxiliary
+{
+/** Sorted associative container backed by contiguous storage.
+ *
+ * Keys are kept in a sorted vector of their own, so lookups are a binary search
+ * over contiguous memory and only the matching element is dereferenced.
+ * Every element lives in a separate node, so references and pointers to
+ * elements stay valid until that element is erased (Writables keep raw pointers
+ * to their parents). Iterators are invalidated by insertion and erasure.
+ * Appending keys in increasing order (e.g. iterations) does not shift any element.
+ *
+ * Supplies the subset of the std::map interface used by Container.
+ *
+ * @tparam Key      Type of the keys.
+ * @tparam T        Type of the mapped values.
+ * @tparam Compare  Strict weak ordering of the keys.
+ */
+template<
+        typename Key,
+        typename T,
+        typename Compare = std::less< Key >
+>
+class FlatMap
+{
+    template< bool Const >
+    class Iterator;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair< Key const, T >;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using allocator_type = std::allocator< value_type >;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using pointer = value_type*;
+    using const_pointer = value_type const*;
+    using iterator = Iterator< false >;
+    using const_iterator = Iterator< true >;
+
+private:
+    using Node = std::unique_ptr< value_type >;
+    using NodeIterator = typename std::vector< Node >::const_iterator;
+
+    template< bool Const >
+    class Iterator
+    {
+        friend class FlatMap;
+        template< bool >
+        friend class Iterator;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename FlatMap::value_type;
+        using difference_type = typename FlatMap::difference_type;
+        using reference = typename std::conditional< Const, value_type const&, value_type& >::type;
+        using pointer = typename std::conditional< Const, value_type const*, value_type* >::type;
+
+        Iterator() = default;
+        /* iterator converts to const_iterator, not vice versa */
+        template< bool C, typename = typename std::enable_if< Const && !C >::type >
+        Iterator(Iterator< C > const& other) : m_it{other.m_it} { }
+
+        reference operator*() const { return **m_it; }
+        pointer operator->() const { return m_it->get(); }
+        reference operator[](difference_type n) const { return *m_it[n]; }
+
+        Iterator& operator++() { ++m_it; return *this; }
+        Iterator operator++(int) { Iterator ret = *this; ++m_it; return ret; }
+        Iterator& operator--() { --m_it; return *this; }
+        Iterator operator--(int) { Iterator ret = *this; --m_it; return ret; }
+        Iterator& operator+=(difference_type n) { m_it += n; return *this; }
+        Iterator& operator-=(difference_type n) { m_it -= n; return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(m_it + n); }
+        Iterator operator-(difference_type n) const { return Iterator(m_it - n); }
+        friend Iterator operator+(difference_type n, Iterator const& it) { return it + n; }
+        difference_type operator-(Iterator const& other) const { return m_it - other.m_it; }
+
+        bool operator==(Iterator const& other) const { return m_it == other.m_it; }
+        bool operator!=(Iterator const& other) const { return m_it != other.m_it; }
+        bool operator<(Iterator const& other) const { return m_it < other.m_it; }
+        bool operator>(Iterator const& other) const { return m_it > other.m_it; }
+        bool operator<=(Iterator const& other) const { return m_it <= other.m_it; }
+        bool operator>=(Iterator const& other) const { return m_it >= other.m_it; }
+
+    private:
+        explicit Iterator(NodeIterator it) : m_it{it} { }
+
+        NodeIterator m_it;
+    };
+
+public:
+    FlatMap() = default;
+    FlatMap(FlatMap const& other)
+            : m_keys{other.m_keys},
+              m_compare{other.m_compare}
+    {
+        m_nodes.reserve(other.m_nodes.size());
+        for( auto const& n : other.m_nodes )
+            m_nodes.emplace_back(new value_type(*n));
+    }
+    FlatMap(FlatMap&&) = default;
+    FlatMap(std::initializer_list< value_type > ilist) { insert(ilist); }
+
+    FlatMap& operator=(FlatMap const& other)
+    {
+        if( this != &other )
+        {
+            FlatMap copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    FlatMap& operator=(FlatMap&&) = default;
+
+    iterator begin() noexcept { return iterator(m_nodes.cbegin()); }
+    const_iterator begin() const noexcept { return const_iterator(m_nodes.cbegin()); }
+    const_iterator cbegin() const noexcept { return const_iterator(m_nodes.cbegin()); }
+
+    iterator end() noexcept { return iterator(m_nodes.cend()); }
+    const_iterator end() const noexcept { return const_iterator(m_nodes.cend()); }
+    const_iterator cend() const noexcept { return const_iterator(m_nodes.cend()); }
+
+    bool empty() const noexcept { return m_nodes.empty(); }
+    size_type size() const noexcept { return m_nodes.size(); }
+
+    void reserve(size_type n)
+    {
+        m_keys.reserve(n);
+        m_nodes.reserve(n);
+    }
+
+    void clear() noexcept
+    {
+        m_keys.clear();
+        m_nodes.clear();
+    }
+
+    std::pair< iterator, bool > insert(value_type const& value) { return emplace_node(value.first, value); }
+    std::pair< iterator, bool > insert(value_type&& value) { return emplace_node(value.first, std::move(value)); }
+    template<
+            class P,
+            typename = typename std::enable_if< std::is_constructible< value_type, P&& >::value >::type
+    >
+    std::pair< iterator, bool > insert(P&& value)
+    {
+        value_type v(std::forward< P >(value));
+        return insert(std::move(v));
+    }
+    /* sorted storage makes the hint superfluous */
+    iterator insert(const_iterator, value_type const& value) { return insert(value).first; }
+    iterator insert(const_iterator, value_type&& value) { return insert(std::move(value)).first; }
+    template<
+            class P,
+            typename = typename std::enable_if< std::is_constructible< value_type, P&& >::value >::type
+    >
+    iterator insert(const_iterator, P&& value) { return insert(std::forward< P >(value)).first; }
+    template< class InputIt >
+    void insert(InputIt first, InputIt last)
+    {
+        for( ; first != last; ++first )
+            insert(*first);
+    }
+    void insert(std::initializer_list< value_type > ilist) { insert(ilist.begin(), ilist.end()); }
+
+    void swap(FlatMap& other)
+    {
+        using std::swap;
+        swap(m_keys, other.m_keys);
+        swap(m_nodes, other.m_nodes);
+        swap(m_compare, other.m_compare);
+    }
+
+    mapped_type& at(key_type const& key)
+    {
+        auto it = find(key);
+        if( it == end() )
+            throw std::out_of_range("Key not found in FlatMap.");
+        return it->second;
+    }
+    mapped_type const& at(key_type const& key) const
+    {
+        auto it = find(key);
+        if( it == end() )
+            throw std::out_of_range("Key not found in FlatMap.");
+        return it->second;
+    }
+
+    mapped_type& operator[](key_type const& key)
+    {
+        auto it = find(key);
+        if( it != end() )
+            return it->second;
+        return insert(value_type(key, T())).first->second;
+    }
+
+    size_type count(key_type const& key) const { return find(key) == end() ? 0 : 1; }
+
+    iterator find(key_type const& key)
+    {
+        return iterator(m_nodes.cbegin() + position(key));
+    }
+    const_iterator find(key_type const& key) const
+    {
+        return const_iterator(m_nodes.cbegin() + position(key));
+    }
+
+    iterator lower_bound(key_type const& key)
+    {
+        return iterator(m_nodes.cbegin() + (lower(key) - m_keys.cbegin()));
+    }
+    const_iterator lower_bound(key_type const& key) const
+    {
+        return const_iterator(m_nodes.cbegin() + (lower(key) - m_keys.cbegin()));
+    }
+
+    size_type erase(key_type const& key)
+    {
+        auto it = find(key);
+        if( it == end() )
+            return 0;
+        erase(const_iterator(it));
+        return 1;
+    }
+    iterator erase(const_iterator pos)
+    {
+        auto offset = pos.m_it - m_nodes.cbegin();
+        m_keys.erase(m_keys.begin() + offset);
+        return iterator(m_nodes.erase(m_nodes.begin() + offset));
+    }
+
+    key_compare key_comp() const { return m_compare; }
+
+private:
+    /* keys are duplicated from the nodes to keep the binary search on contiguous memory */
+    std::vector< Key > m_keys;
+    std::vector< Node > m_nodes;
+    Compare m_compare;
+
+    typename std::vector< Key >::const_iterator lower(key_type const& key) const
+    {
+        /* fast path for keys appended in increasing order */
+        if( m_keys.empty() || m_compare(m_keys.back(), key) )
+            return m_keys.cend();
+        return std::lower_bound(m_keys.cbegin(), m_keys.cend(), key, m_compare);
+    }
+
+    /** Index of the element with key equivalent to key, size() if there is none. */
+    size_type position(key_type const& key) const
+    {
+        auto it = lower(key);
+        if( it == m_keys.cend() || m_compare(key, *it) )
+            return m_keys.size();
+        return static_cast< size_type >(it - m_keys.cbegin());
+    }
+
+    template< typename V >
+    std::pair< iterator, bool > emplace_node(key_type const& key, V&& value)
+    {
+        auto it = lower(key);
+        auto offset = it - m_keys.cbegin();
+        if( it != m_keys.cend() && !m_compare(key, *it) )
+            return {iterator(m_nodes.cbegin() + offset), false};
+
+        Node n(new value_type(std::forward< V >(value)));
+        m_nodes.insert(m_nodes.begin() + offset, std::move(n));
+        try
+        {
+            m_keys.insert(m_keys.begin() + offset, (*(m_nodes.begin() + offset))->first);
+        } catch( ... )
+        {
+            m_nodes.erase(m_nodes.begin() + offset);
+            throw;
+        }
+        return {iterator(m_nodes.cbegin() + offset), true};
+    }
+};
+
+template< typename Key, typename T, typename Compare >
+inline void
+swap(FlatMap< Key, T, Compare >& a, FlatMap< Key, T, Compare >& b)
+{ a.swap(b); }
+} // auxiliary
+} // openPMD
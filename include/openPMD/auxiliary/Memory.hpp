@@ -1,10 +1,14 @@
 #pragma once
 
+#include "openPMD/auxiliary/BufferPool.hpp"
 #include "openPMD/Dataset.hpp"
 #include "openPMD/Datatype.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 
 
@@ -18,6 +22,37 @@ allocatePtr(Datatype dtype, Extent const& e);
 std::unique_ptr< void, std::function< void(void*) > >
 allocatePtr(Datatype dtype, size_t numPoints);
 
+/** Copy numPoints values of elementBytes each, stored every stride values in src, densely into dest.
+ *
+ * Used to write one member of an array of structs (see Parameter< Operation::WRITE_DATASET >::memoryStride)
+ * where the backend can not describe the layout in memory itself.
+ */
+void
+gather(void* dest, void const* src, size_t numPoints, size_t elementBytes, size_t stride);
+
+/** Copy the box of shape extent at memoryOffset inside a row-major buffer src of shape memoryExtent densely into dest.
+ *
+ * Used to write a part of a buffer (see Parameter< Operation::WRITE_DATASET >::memoryExtent)
+ * where the backend can not describe the layout in memory itself.
+ */
+void
+pack(void* dest, void const* src, size_t elementBytes, Extent const& extent, Offset const& memoryOffset, Extent const& memoryExtent);
+
+/** Reverse the order of the dimensions of a row-major buffer src of shape extent, i.e. store it column-major in dest.
+ *
+ * Used for meshes stored in the other Mesh::DataOrder than requested.
+ * Both buffers are traversed in tiles of the first and last dimension, so reads and writes stay within few cache lines.
+ */
+void
+transpose(void* dest, void const* src, size_t elementBytes, Extent const& extent);
+
+/** Allocate a buffer for numPoints values of dtype from a BufferPool.
+ *
+ * @param   pool    Pool to obtain the buffer from, plain allocation is used if nullptr.
+ */
+std::unique_ptr< void, std::function< void(void*) > >
+allocatePtr(Datatype dtype, size_t numPoints, BufferPool* pool);
+
 inline std::unique_ptr< void, std::function< void(void*) > >
 allocatePtr(Datatype dtype, Extent const& e)
 {
@@ -90,5 +125,180 @@ allocatePtr(Datatype dtype, size_t numPoints)
 
     return std::move(std::unique_ptr< void, std::function< void(void*) > >(data, del));
 }
+
+inline std::unique_ptr< void, std::function< void(void*) > >
+allocatePtr(Datatype dtype, size_t numPoints, BufferPool* pool)
+{
+    if( !pool )
+        return allocatePtr(dtype, numPoints);
+
+    return pool->allocate(toBytes(dtype) * numPoints);
+}
+namespace detail
+{
+/* the fixed size lets the compiler replace memcpy by a single move */
+template< size_t Bytes >
+inline void
+gatherValues(char* dest, char const* src, size_t numPoints, size_t strideBytes)
+{
+    for( size_t i = 0; i < numPoints; ++i )
+        std::memcpy(dest + i * Bytes, src + i * strideBytes, Bytes);
+}
+
+/* copy a rows x cols matrix with rows srcRowStride values apart into columns dstColStride values apart,
+ * in square tiles of one cache line per row */
+template< size_t Bytes >
+inline void
+transposeTiles(char* dest, char const* src, size_t rows, size_t cols, size_t srcRowStride, size_t dstColStride)
+{
+    constexpr size_t tile = Bytes < 8 ? 64 / Bytes : 8;
+    for( size_t ib = 0; ib < rows; ib += tile )
+    {
+        size_t const iEnd = std::min(ib + tile, rows);
+        for( size_t jb = 0; jb < cols; jb += tile )
+        {
+            size_t const jEnd = std::min(jb + tile, cols);
+            for( size_t i = ib; i < iEnd; ++i )
+                for( size_t j = jb; j < jEnd; ++j )
+                    std::memcpy(dest + (i + j * dstColStride) * Bytes, src + (i * srcRowStride + j) * Bytes, Bytes);
+        }
+    }
+}
+} // detail
+
+inline void
+gather(void* dest, void const* src, size_t numPoints, size_t elementBytes, size_t stride)
+{
+    char* d = static_cast< char* >(dest);
+    char const* s = static_cast< char const* >(src);
+    size_t const strideBytes = elementBytes * stride;
+    switch( elementBytes )
+    {
+        case 1:
+            detail::gatherValues< 1 >(d, s, numPoints, strideBytes);
+            break;
+        case 2:
+            detail::gatherValues< 2 >(d, s, numPoints, strideBytes);
+            break;
+        case 4:
+            detail::gatherValues< 4 >(d, s, numPoints, strideBytes);
+            break;
+        case 8:
+            detail::gatherValues< 8 >(d, s, numPoints, strideBytes);
+            break;
+        case 16:
+            detail::gatherValues< 16 >(d, s, numPoints, strideBytes);
+            break;
+        default:
+            for( size_t i = 0; i < numPoints; ++i )
+                std::memcpy(d + i * elementBytes, s + i * strideBytes, elementBytes);
+    }
+}
+
+inline void
+pack(void* dest, void const* src, size_t elementBytes, Extent const& extent, Offset const& memoryOffset, Extent const& memoryExtent)
+{
+    size_t const dim = extent.size();
+    for( auto const& dimensionSize : extent )
+        if( dimensionSize == 0 )
+            return;
+    if( dim == 0 )
+    {
+        std::memcpy(dest, src, elementBytes);
+        return;
+    }
+
+    /* rows along the fastest varying dimension are contiguous in both buffers */
+    size_t const rowBytes = extent[dim - 1] * elementBytes;
+    char* d = static_cast< char* >(dest);
+    char const* s = static_cast< char const* >(src);
+    Offset index(dim - 1, 0);
+    while( true )
+    {
+        size_t linear = 0;
+        for( size_t i = 0; i < dim; ++i )
+            linear = linear * memoryExtent[i] + memoryOffset[i] + (i + 1 < dim ? index[i] : 0);
+        std::memcpy(d, s + linear * elementBytes, rowBytes);
+        d += rowBytes;
+
+        size_t i = dim - 1;
+        while( i > 0 && ++index[i - 1] == extent[i - 1] )
+            index[--i] = 0;
+        if( i == 0 )
+            return;
+    }
+}
+
+inline void
+transpose(void* dest, void const* src, size_t elementBytes, Extent const& extent)
+{
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : extent )
+        numPoints *= dimensionSize;
+    size_t const dim = extent.size();
+    if( numPoints == 0 )
+        return;
+    if( dim < 2 )
+    {
+        std::memcpy(dest, src, numPoints * elementBytes);
+        return;
+    }
+
+    /* the first and last dimension swap places, each combination of the dimensions in between is one matrix */
+    size_t const rows = extent[0];
+    size_t const cols = extent[dim - 1];
+    size_t const srcRowStride = numPoints / rows;
+    size_t const dstColStride = numPoints / cols;
+    char* d = static_cast< char* >(dest);
+    char const* s = static_cast< char const* >(src);
+    Offset index(dim, 0);
+    while( true )
+    {
+        size_t srcOffset = 0, dstOffset = 0, srcStride = 1, dstStride = 1;
+        for( size_t k = dim - 1; k > 0; --k )
+        {
+            srcOffset += index[k] * srcStride;
+            srcStride *= extent[k];
+        }
+        for( size_t k = 0; k < dim; ++k )
+        {
+            dstOffset += index[k] * dstStride;
+            dstStride *= extent[k];
+        }
+        char* dm = d + dstOffset * elementBytes;
+        char const* sm = s + srcOffset * elementBytes;
+        switch( elementBytes )
+        {
+            case 1:
+                detail::transposeTiles< 1 >(dm, sm, rows, cols, srcRowStride, dstColStride);
+                break;
+            case 2:
+                detail::transposeTiles< 2 >(dm, sm, rows, cols, srcRowStride, dstColStride);
+                break;
+            case 4:
+                detail::transposeTiles< 4 >(dm, sm, rows, cols, srcRowStride, dstColStride);
+                break;
+            case 8:
+                detail::transposeTiles< 8 >(dm, sm, rows, cols, srcRowStride, dstColStride);
+                break;
+            case 16:
+                detail::transposeTiles< 16 >(dm, sm, rows, cols, srcRowStride, dstColStride);
+                break;
+            default:
+                for( size_t i = 0; i < rows; ++i )
+                    for( size_t j = 0; j < cols; ++j )
+                        std::memcpy(dm + (i + j * dstColStride) * elementBytes,
+                                    sm + (i * srcRowStride + j) * elementBytes,
+                                    elementBytes);
+        }
+
+        /* next combination of the dimensions in between */
+        size_t k = dim - 2;
+        while( k > 0 && ++index[k] == extent[k] )
+            index[k--] = 0;
+        if( k == 0 )
+            return;
+    }
+}
 } // auxiliary
 } // openPMD
@@ -0,0 +1,209 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "openPMD/auxiliary/Variadic.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace openPMD
+{
+namespace auxiliary
+{
+/** Append the binary representation of values to a buffer, e.g. to send them to other MPI ranks.
+ *
+ * The representation is only meant to be read by a Deserializer on the same platform.
+ */
+class Serializer
+{
+public:
+    template< typename T >
+    typename std::enable_if< std::is_arithmetic< T >::value || std::is_enum< T >::value >::type
+    write(T const& value)
+    {
+        m_buffer.append(reinterpret_cast< char const* >(&value), sizeof(T));
+    }
+
+    void write(std::string const& s)
+    {
+        write(static_cast< uint64_t >(s.size()));
+        m_buffer.append(s);
+    }
+
+    template< typename T >
+    void write(std::vector< T > const& v)
+    {
+        write(static_cast< uint64_t >(v.size()));
+        for( auto const& e : v )
+            write(e);
+    }
+
+    template< typename T, std::size_t N >
+    void write(std::array< T, N > const& a)
+    {
+        for( auto const& e : a )
+            write(e);
+    }
+
+    template< typename K, typename V >
+    void write(std::map< K, V > const& m)
+    {
+        write(static_cast< uint64_t >(m.size()));
+        for( auto const& e : m )
+        {
+            write(e.first);
+            write(e.second);
+        }
+    }
+
+    template< typename ... T >
+    void write(variadicSrc::variant< T ... > const& v)
+    {
+        write(static_cast< uint64_t >(v.index()));
+        variadicSrc::visit(Visitor{*this}, v);
+    }
+
+    std::string const& buffer() const { return m_buffer; }
+    void clear() { m_buffer.clear(); }
+
+private:
+    struct Visitor
+    {
+        Serializer& s;
+
+        template< typename T >
+        void operator()(T const& value) const { s.write(value); }
+    };
+
+    std::string m_buffer;
+};  //Serializer
+
+/** Read values in the order they were appended by a Serializer.
+ */
+class Deserializer
+{
+public:
+    explicit Deserializer(std::string buffer = std::string())
+            : m_buffer{std::move(buffer)},
+              m_pos{0}
+    { }
+
+    template< typename T >
+    typename std::enable_if< std::is_arithmetic< T >::value || std::is_enum< T >::value >::type
+    read(T& value)
+    {
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    }
+
+    void read(std::string& s)
+    {
+        uint64_t size;
+        read(size);
+        s.assign(take(size), size);
+    }
+
+    template< typename T >
+    void read(std::vector< T >& v)
+    {
+        uint64_t size;
+        read(size);
+        v.resize(size);
+        for( auto& e : v )
+            read(e);
+    }
+
+    template< typename T, std::size_t N >
+    void read(std::array< T, N >& a)
+    {
+        for( auto& e : a )
+            read(e);
+    }
+
+    template< typename K, typename V >
+    void read(std::map< K, V >& m)
+    {
+        uint64_t size;
+        read(size);
+        m.clear();
+        for( uint64_t i = 0; i < size; ++i )
+        {
+            K key;
+            read(key);
+            read(m[key]);
+        }
+    }
+
+    template< typename ... T >
+    void read(variadicSrc::variant< T ... >& v)
+    {
+        uint64_t index;
+        read(index);
+        readAlternative< 0 >(index, v);
+    }
+
+    /** @return True if all values of the buffer have been read. */
+    bool done() const { return m_pos == m_buffer.size(); }
+
+private:
+    char const* take(std::size_t bytes)
+    {
+        if( bytes > m_buffer.size() - m_pos )
+            throw std::runtime_error("Deserialization exceeds the end of the buffer.");
+        char const* ret = m_buffer.data() + m_pos;
+        m_pos += bytes;
+        return ret;
+    }
+
+    template< std::size_t I, typename ... T >
+    typename std::enable_if< (I < sizeof...(T)) >::type
+    readAlternative(uint64_t index, variadicSrc::variant< T ... >& v)
+    {
+        if( index == I )
+        {
+            typename variadicSrc::variant_alternative< I, variadicSrc::variant< T ... > >::type value;
+            read(value);
+            v.template emplace< I >(std::move(value));
+        } else
+            readAlternative< I + 1 >(index, v);
+    }
+
+    template< std::size_t I, typename ... T >
+    typename std::enable_if< (I >= sizeof...(T)) >::type
+    readAlternative(uint64_t, variadicSrc::variant< T ... >&)
+    {
+        throw std::runtime_error("Deserialization of unknown variant alternative.");
+    }
+
+    std::string m_buffer;
+    std::size_t m_pos;
+};  //Deserializer
+} // auxiliary
+} // openPMD
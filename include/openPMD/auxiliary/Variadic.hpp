@@ -29,6 +29,7 @@ namespace variadicSrc = mpark;
 #endif
 
 #include <type_traits>
+#include <utility>
 
 
 namespace openPMD
@@ -56,30 +57,51 @@ public:
      */
     Variadic(resource r)
             : dtype{static_cast<T_DTYPES>(r.index())},
-              m_data{r}
+              m_data{std::move(r)}
     { }
 
     /** Retrieve a stored specific object of known datatype with ensured type-safety.
      *
      * @throw   std::bad_variant_access if stored object is not of type U.
      * @tparam  U   Type of the object to be retrieved.
-     * @return  Copy of the retrieved object of type U.
+     * @return  Reference to the retrieved object of type U, valid as long as this object is neither modified nor destroyed.
      */
     template< typename U >
-    U get() const
+    U const& get() const &
     {
         return variadicSrc::get< U >(m_data);
     }
 
+    /** Retrieve a stored specific object of known datatype from an expiring object without copying it.
+     *
+     * @throw   std::bad_variant_access if stored object is not of type U.
+     * @tparam  U   Type of the object to be retrieved.
+     * @return  Retrieved object of type U, moved out of this object.
+     */
+    template< typename U >
+    U get() &&
+    {
+        return variadicSrc::get< U >(std::move(m_data));
+    }
+
     /** Retrieve the stored generic object.
      *
-     * @return  Copy of the stored generic object.
+     * @return  Reference to the stored generic object, valid as long as this object is neither modified nor destroyed.
      */
-    resource getResource() const
+    resource const& getResource() const &
     {
         return m_data;
     }
 
+    /** Retrieve the stored generic object from an expiring object without copying it.
+     *
+     * @return  Stored generic object, moved out of this object.
+     */
+    resource getResource() &&
+    {
+        return std::move(m_data);
+    }
+
     T_DTYPES dtype;
 
 private:
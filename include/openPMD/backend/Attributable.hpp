@@ -24,11 +24,12 @@
 #include "openPMD/backend/Attribute.hpp"
 #include "openPMD/backend/Writable.hpp"
 
+#include <algorithm>
 #include <exception>
-#include <map>
 #include <memory>
 #include <vector>
 #include <string>
+#include <utility>
 
 
 namespace openPMD
@@ -53,7 +54,22 @@ public:
  */
 class Attributable : public Writable
 {
-    using A_MAP = std::map< std::string, Attribute >;
+    /** Attribute with its name and whether it has been modified since the last flush. */
+    struct AttributeEntry
+    {
+        std::string name;
+        Attribute value;
+        bool dirty;
+    };
+    /* sorted by name in a single allocation, instead of one map node and one set node per attribute */
+    using A_MAP = std::vector< AttributeEntry >;
+    template<
+            typename T,
+            typename T_key,
+            typename T_container
+    >
+    friend class Container;
+    friend class Series;
 
 public:
     Attributable();
@@ -82,9 +98,9 @@ public:
      *
      * @throw   no_such_attribute_error If no Attribute is currently stored with the provided key.
      * @param   key Key (i.e. name) of the Attribute to retrieve value for.
-     * @return  Stored Attribute in Variadic form.
+     * @return  Stored Attribute in Variadic form, valid until the Attribute is set or deleted.
      */
-    Attribute getAttribute(std::string const& key) const;
+    Attribute const& getAttribute(std::string const& key) const;
     /** Remove Attribute of provided value both logically and physically.
      *
      * @param   key Key (i.e. name) of the Attribute to remove.
@@ -123,8 +139,23 @@ public:
     Attributable& setComment(std::string const& comment);
 
 protected:
+    /** Enqueue writing of all Attributes modified since the last flush and mark them as unmodified.
+     *
+     * @note    If the object has not been written yet, all Attributes are written.
+     */
     void flushAttributes();
+    /** Enqueue writing of Attributes without changing their modification state.
+     *
+     * @param   all     true to write all Attributes (e.g. into a new file), false to only write modified Attributes.
+     */
+    void enqueueAttributes(bool all);
+    /** Mark all Attributes as unmodified.
+     */
+    void clearDirty();
     void readAttributes();
+    /** @return Name of a direct child in the object model, empty if child is none of this object.
+     */
+    virtual std::string childName(Writable const* child) const;
 
     /** Retrieve the value of a floating point Attribute of user-defined precision with ensured type-safety.
      *
@@ -160,7 +191,13 @@ protected:
     std::vector< T > readVectorFloatingpoint(std::string const& key) const;
 
 private:
-    std::shared_ptr< A_MAP > m_attributes;
+    /** @return First attribute whose name does not compare less than key. */
+    A_MAP::iterator lowerBound(std::string const& key);
+    /** @return Attribute with name key, end of the attributes if there is none. */
+    A_MAP::const_iterator findAttribute(std::string const& key) const;
+
+    /* held in place, an empty vector does not allocate */
+    A_MAP m_attributes;
 };  //Attributable
 
 void warnWrongDtype(std::string const& key,
@@ -172,22 +209,29 @@ template< typename T >
 inline bool
 Attributable::setAttribute(std::string const& key, T&& value)
 {
-    dirty = true;
-    auto it = m_attributes->lower_bound(key);
-    if( it != m_attributes->end() && !m_attributes->key_comp()(key, it->first) )
+    setDirty();
+    auto it = lowerBound(key);
+    if( it != m_attributes.end() && it->name == key )
     {
-        // key already exists in map, just replace the value
-        it->second = Attribute(value);
+        // key already exists, just replace the value
+        it->value = Attribute(std::forward< T >(value));
+        it->dirty = true;
         return true;
     } else
     {
-        // emplace a new map element for an unknown key
-        m_attributes->emplace_hint(it,
-                                   std::make_pair(key, Attribute(value)));
+        // insert a new element for an unknown key at its sorted position
+        m_attributes.insert(it, AttributeEntry{key, Attribute(std::forward< T >(value)), true});
         return false;
     }
 }
 
+inline Attributable::A_MAP::iterator
+Attributable::lowerBound(std::string const& key)
+{
+    return std::lower_bound(m_attributes.begin(), m_attributes.end(), key,
+                            [](AttributeEntry const& entry, std::string const& k){ return entry.name < k; });
+}
+
 extern template
 float
 Attributable::readFloatingpoint(std::string const& key) const;
@@ -207,7 +251,7 @@ Attributable::readFloatingpoint(std::string const& key) const
     static_assert(std::is_floating_point< T >::value, "Type of attribute must be floating point");
 
     T t{0};
-    Attribute a = getAttribute(key);
+    Attribute const& a = getAttribute(key);
     Datatype target_dtype = determineDatatype< T >();
     if( a.dtype == target_dtype )
         t = a.get< T >();
@@ -252,7 +296,7 @@ Attributable::readVectorFloatingpoint(std::string const& key) const
     static_assert(std::is_floating_point< T >::value, "Type of attribute must be floating point");
 
     std::vector< T > vt{};
-    Attribute a = getAttribute(key);
+    Attribute const& a = getAttribute(key);
     Datatype target_dtype = determineDatatype< std::vector< T > >();
     if( a.dtype == target_dtype )
         vt = a.get< std::vector< T > >();
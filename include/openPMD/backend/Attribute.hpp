@@ -25,17 +25,17 @@
 
 #include <array>
 #include <cstdint>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 #include <string>
 
 
 namespace openPMD
 {
-//TODO This might have to be a Writable
-//Reasoning - Flushes are expeted to be done often.
-//Attributes should not be written unless dirty.
-//At the moment the dirty check is done at Attributable level,
-//resulting in all of an Attributables Attributes being written to disk even if only one changes
+//Flushes are expected to be done often, so Attributes should not be written unless dirty.
+//The dirty state of each Attribute is tracked by the owning Attributable (by key),
+//so only modified Attributes are written to disk on flush.
 /** Varidic datatype supporting at least all formats for attributes specified in the openPMD standard.
  *
  * @note Extending and/or modifying the available formats requires identical
@@ -61,4 +61,38 @@ using Attribute = auxiliary::Variadic< Datatype,
                             std::vector< std::string >,
                             std::array< double, 7 >,
                             bool >;
+
+namespace detail
+{
+template< typename U >
+struct CastVisitor
+{
+    template< typename T >
+    typename std::enable_if< std::is_arithmetic< T >::value && std::is_arithmetic< U >::value, U >::type
+    operator()(T const& value) const
+    {
+        return static_cast< U >(value);
+    }
+
+    template< typename T >
+    typename std::enable_if< !(std::is_arithmetic< T >::value && std::is_arithmetic< U >::value), U >::type
+    operator()(T const&) const
+    {
+        throw std::runtime_error("Attribute can not be converted to the requested type");
+    }
+};
+} // detail
+
+/** Retrieve a scalar Attribute converted to a (possibly different) arithmetic type.
+ *
+ * @throw   std::runtime_error if either the stored or the requested type is not arithmetic.
+ * @tparam  U   Arithmetic type of the object to be retrieved.
+ * @return  Stored value converted to U.
+ */
+template< typename U >
+inline U
+getCast(Attribute const& a)
+{
+    return variadicSrc::visit(detail::CastVisitor< U >(), a.getResource());
+}
 } // openPMD
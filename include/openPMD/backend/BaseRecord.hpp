@@ -1,11 +1,14 @@
 #pragma once
 
+#include "openPMD/auxiliary/FlatMap.hpp"
 #include "openPMD/backend/Container.hpp"
 #include "openPMD/RecordComponent.hpp"
 
+#include <algorithm>
 #include <array>
 #include <string>
 #include <stdexcept>
+#include <utility>
 
 
 namespace openPMD
@@ -15,22 +18,26 @@ enum class UnitDimension : uint8_t
     L = 0, M, T, I, theta, N, J
 };
 
+/** Components of a record are visited on every flush and read, store them contiguously. */
 template< typename T_elem >
-class BaseRecord : public Container< T_elem >
+using BaseRecordContainer = Container< T_elem, std::string, auxiliary::FlatMap< std::string, T_elem > >;
+
+template< typename T_elem >
+class BaseRecord : public BaseRecordContainer< T_elem >
 {
 public:
-    using key_type = typename Container< T_elem >::key_type;
-    using mapped_type = typename Container< T_elem >::mapped_type;
-    using value_type = typename Container< T_elem >::value_type;
-    using size_type = typename Container< T_elem >::size_type;
-    using difference_type = typename Container< T_elem >::difference_type;
-    using allocator_type = typename Container< T_elem >::allocator_type;
-    using reference = typename Container< T_elem >::reference;
-    using const_reference = typename Container< T_elem >::const_reference;
-    using pointer = typename Container< T_elem >::pointer;
-    using const_pointer = typename Container< T_elem >::const_pointer;
-    using iterator = typename Container< T_elem >::iterator;
-    using const_iterator = typename Container< T_elem >::const_iterator;
+    using key_type = typename BaseRecordContainer< T_elem >::key_type;
+    using mapped_type = typename BaseRecordContainer< T_elem >::mapped_type;
+    using value_type = typename BaseRecordContainer< T_elem >::value_type;
+    using size_type = typename BaseRecordContainer< T_elem >::size_type;
+    using difference_type = typename BaseRecordContainer< T_elem >::difference_type;
+    using allocator_type = typename BaseRecordContainer< T_elem >::allocator_type;
+    using reference = typename BaseRecordContainer< T_elem >::reference;
+    using const_reference = typename BaseRecordContainer< T_elem >::const_reference;
+    using pointer = typename BaseRecordContainer< T_elem >::pointer;
+    using const_pointer = typename BaseRecordContainer< T_elem >::const_pointer;
+    using iterator = typename BaseRecordContainer< T_elem >::iterator;
+    using const_iterator = typename BaseRecordContainer< T_elem >::const_iterator;
 
     BaseRecord(BaseRecord const& b);
     virtual ~BaseRecord() { }
@@ -41,12 +48,29 @@ public:
 
     virtual std::array< double, 7 > unitDimension() const;
 
+    /** Open and read a record that has only been registered by its name while reading the Series.
+     *
+     * Records are opened on their first access through their container (operator[], at(), find() or iterating it),
+     * also if the container is const, so this is rarely needed.
+     * Does nothing for records that have been read or created already.
+     */
+    void open();
+
 protected:
     BaseRecord();
 
     void readBase();
+    /** Register a record listed while reading, it is opened on first access (see open()).
+     *
+     * @param   name    Name of the group (or dataset for scalar records) relative to the parent.
+     * @param   dataset Whether the record has been listed as a dataset, i.e. is a scalar record.
+     */
+    void defer(std::string name, bool dataset);
 
     bool m_containsScalar;
+    bool m_deferred;
+    bool m_deferredDataset;
+    std::string m_deferredName;
 
 private:
     virtual void flush(std::string const&) = 0;
@@ -56,13 +80,18 @@ private:
 
 template< typename T_elem >
 BaseRecord< T_elem >::BaseRecord(BaseRecord const& b)
-        : Container< T_elem >(b),
-          m_containsScalar{b.m_containsScalar}
+        : BaseRecordContainer< T_elem >(b),
+          m_containsScalar{b.m_containsScalar},
+          m_deferred{b.m_deferred},
+          m_deferredDataset{b.m_deferredDataset},
+          m_deferredName{b.m_deferredName}
 { }
 
 template< typename T_elem >
 BaseRecord< T_elem >::BaseRecord()
-        : m_containsScalar{false}
+        : m_containsScalar{false},
+          m_deferred{false},
+          m_deferredDataset{false}
 {
     this->setAttribute("unitDimension",
                        std::array< double, 7 >{{0., 0., 0., 0., 0., 0., 0.}});
@@ -79,11 +108,11 @@ BaseRecord< T_elem >::operator[](key_type const& key)
     else
     {
         bool scalar = (key == RecordComponent::SCALAR);
-        if( (scalar && !Container< T_elem >::empty() && !m_containsScalar) || (m_containsScalar && !scalar) )
+        if( (scalar && !BaseRecordContainer< T_elem >::empty() && !m_containsScalar) || (m_containsScalar && !scalar) )
             throw std::runtime_error("A scalar component can not be contained at "
                                              "the same time as one or more regular components.");
 
-        mapped_type & ret = Container< T_elem >::operator[](key);
+        mapped_type & ret = BaseRecordContainer< T_elem >::operator[](key);
         if( scalar )
         {
             m_containsScalar = true;
@@ -103,11 +132,11 @@ BaseRecord< T_elem >::operator[](key_type&& key)
     else
     {
         bool scalar = (key == RecordComponent::SCALAR);
-        if( (scalar && !Container< T_elem >::empty() && !m_containsScalar) || (m_containsScalar && !scalar) )
+        if( (scalar && !BaseRecordContainer< T_elem >::empty() && !m_containsScalar) || (m_containsScalar && !scalar) )
             throw std::runtime_error("A scalar component can not be contained at "
                                              "the same time as one or more regular components.");
 
-        mapped_type& ret = Container< T_elem >::operator[](std::move(key));
+        mapped_type& ret = BaseRecordContainer< T_elem >::operator[](std::move(key));
         if( scalar )
         {
             m_containsScalar = true;
@@ -124,7 +153,7 @@ BaseRecord< T_elem >::erase(key_type const& key)
     bool scalar = (key == RecordComponent::SCALAR);
     size_type res;
     if( !scalar || (scalar && this->at(key).m_isConstant) )
-        res = Container< T_elem >::erase(key);
+        res = BaseRecordContainer< T_elem >::erase(key);
     else
     {
         mapped_type& rc = this->find(RecordComponent::SCALAR)->second;
@@ -135,7 +164,7 @@ BaseRecord< T_elem >::erase(key_type const& key)
             this->IOHandler->enqueue(IOTask(&rc, dDelete));
             this->IOHandler->flush();
         }
-        res = Container< T_elem >::erase(key);
+        res = BaseRecordContainer< T_elem >::erase(key);
     }
 
     if( scalar )
@@ -154,6 +183,63 @@ BaseRecord< T_elem >::unitDimension() const
     return Attributable::getAttribute("unitDimension").template get< std::array< double, 7 > >();
 }
 
+template< typename T_elem >
+inline void
+BaseRecord< T_elem >::open()
+{
+    if( !m_deferred )
+        return;
+    m_deferred = false;
+
+    if( m_deferredDataset )
+    {
+        Parameter< Operation::OPEN_DATASET > dOpen;
+        dOpen.name = m_deferredName;
+        this->IOHandler->enqueue(IOTask(this, dOpen));
+        this->IOHandler->flush();
+        mapped_type& rc = (*this)[RecordComponent::SCALAR];
+        rc.abstractFilePosition = this->abstractFilePosition;
+        rc.parent = this->parent;
+        rc.written = false;
+        rc.resetDataset(Dataset(*dOpen.dtype, *dOpen.extent));
+        if( !dOpen.chunkSize->empty() )
+            rc.m_dataset.chunkSize = *dOpen.chunkSize;
+        rc.written = true;
+    } else
+    {
+        Parameter< Operation::OPEN_PATH > pOpen;
+        pOpen.path = m_deferredName;
+        Parameter< Operation::LIST_ATTS > aList;
+        this->IOHandler->enqueue(IOTask(this, pOpen));
+        this->IOHandler->enqueue(IOTask(this, aList));
+        this->IOHandler->flush();
+
+        auto begin = aList.attributes->begin();
+        auto end = aList.attributes->end();
+        auto value = std::find(begin, end, "value");
+        auto shape = std::find(begin, end, "shape");
+        if( value != end && shape != end )
+        {
+            mapped_type& rc = (*this)[RecordComponent::SCALAR];
+            rc.m_isConstant = true;
+            rc.parent = this->parent;
+            rc.abstractFilePosition = this->abstractFilePosition;
+        }
+    }
+    read();
+}
+
+template< typename T_elem >
+inline void
+BaseRecord< T_elem >::defer(std::string name, bool dataset)
+{
+    m_deferred = true;
+    m_deferredDataset = dataset;
+    m_deferredName = std::move(name);
+    /* this record need not be flushed before it has been opened */
+    this->written = true;
+}
+
 template< typename T_elem >
 inline void
 BaseRecord< T_elem >::readBase()
@@ -22,6 +22,11 @@ public:
 
     Datatype getDatatype();
 
+    /**
+     * @return  true if this component holds a single value for its whole extent (see RecordComponent::makeConstant).
+     */
+    bool constant() const;
+
 protected:
     BaseRecordComponent();
 
@@ -23,21 +23,89 @@
 #include "openPMD/backend/Attributable.hpp"
 
 #include <initializer_list>
+#include <iterator>
 #include <type_traits>
 #include <stdexcept>
 #include <map>
 #include <string>
+#include <utility>
 
 
 namespace openPMD
 {
+namespace detail
+{
+inline std::string
+keyName(std::string const& key)
+{
+    return key;
+}
+
+template< typename T_key >
+inline std::string
+keyName(T_key const& key)
+{
+    return std::to_string(key);
+}
+
+/** Open an element that has only been registered while reading, on its first access through a container.
+ *
+ * Specialized for records, which are listed by name and only opened and read when used (see BaseRecord::open),
+ * and for iterations of a fileBased Series, which are only parsed when used (see Iteration::open).
+ */
+template< typename T >
+inline void
+openElement(T&)
+{ }
+
+/** Iterator of a Container that opens the element it points to when it is dereferenced (see openElement).
+ *
+ * Iterating a container thus opens one element after the other, only once it is reached.
+ *
+ * @tparam T_it Iterator of the internal storage of the container.
+ */
+template< typename T_it >
+class OpeningIterator : public T_it
+{
+    using mapped_type = typename std::iterator_traits< T_it >::value_type::second_type;
+
+public:
+    using reference = typename std::iterator_traits< T_it >::reference;
+    using pointer = typename std::iterator_traits< T_it >::pointer;
+
+    OpeningIterator() = default;
+    OpeningIterator(T_it it) : T_it(it) { }
+    /* iterator converts to const_iterator, not vice versa */
+    template<
+            typename T_other,
+            typename = typename std::enable_if< std::is_convertible< T_other, T_it >::value >::type
+    >
+    OpeningIterator(OpeningIterator< T_other > const& other) : T_it(static_cast< T_other const& >(other)) { }
+
+    reference operator*() const
+    {
+        reference ret = T_it::operator*();
+        /* elements are stored mutable, opening them does not change their logical state */
+        openElement(const_cast< mapped_type& >(ret.second));
+        return ret;
+    }
+    pointer operator->() const { return &**this; }
+
+    OpeningIterator& operator++() { T_it::operator++(); return *this; }
+    OpeningIterator operator++(int) { OpeningIterator ret = *this; ++*this; return ret; }
+    OpeningIterator& operator--() { T_it::operator--(); return *this; }
+    OpeningIterator operator--(int) { OpeningIterator ret = *this; --*this; return ret; }
+};
+} // detail
+
 /** @brief Map-like container that enforces openPMD requirements and handles IO.
  *
  * @see http://en.cppreference.com/w/cpp/container/map
  *
  * @tparam T            Type of objects stored
  * @tparam T_key        Key type to look elements up by
- * @tparam T_container  Type of container used for internal storage (must supply the same type traits and interface as std::map)
+ * @tparam T_container  Type of container used for internal storage (must supply the same type traits and interface as std::map),
+ *                      e.g. auxiliary::FlatMap for containers that hold many elements and are traversed often
  */
 template<
         typename T,
@@ -64,11 +132,12 @@ public:
     using const_reference = typename InternalContainer::const_reference;
     using pointer = typename InternalContainer::pointer;
     using const_pointer = typename InternalContainer::const_pointer;
-    using iterator = typename InternalContainer::iterator;
-    using const_iterator = typename InternalContainer::const_iterator;
+    using iterator = detail::OpeningIterator< typename InternalContainer::iterator >;
+    using const_iterator = detail::OpeningIterator< typename InternalContainer::const_iterator >;
 
     virtual ~Container() { }
 
+    /** Dereferencing an iterator opens an element that has only been registered while reading (see detail::openElement). */
     iterator begin() noexcept { return m_container.begin(); }
     const_iterator begin() const noexcept { return m_container.begin(); }
     const_iterator cbegin() const noexcept { return m_container.cbegin(); }
@@ -96,18 +165,28 @@ public:
 
     std::pair< iterator, bool > insert(value_type const& value) { return m_container.insert(value); }
     template< class P >
-    std::pair< iterator, bool > insert(P&& value) { return m_container.insert(value); }
+    std::pair< iterator, bool > insert(P&& value) { return m_container.insert(std::forward< P >(value)); }
     iterator insert(const_iterator hint, value_type const& value) { return m_container.insert(hint, value); }
     template< class P >
-    iterator insert(const_iterator hint, P&& value) { return m_container.insert(hint, value); }
+    iterator insert(const_iterator hint, P&& value) { return m_container.insert(hint, std::forward< P >(value)); }
     template< class InputIt >
     void insert(InputIt first, InputIt last) { m_container.insert(first, last); }
     void insert(std::initializer_list< value_type > ilist) { m_container.insert(ilist); }
 
     void swap(Container & other) { m_container.swap(other.m_container); }
 
-    mapped_type& at(key_type const& key) { return m_container.at(key); }
-    mapped_type const& at(key_type const& key) const { return m_container.at(key); }
+    mapped_type& at(key_type const& key)
+    {
+        mapped_type& ret = m_container.at(key);
+        detail::openElement(ret);
+        return ret;
+    }
+    mapped_type const& at(key_type const& key) const
+    {
+        mapped_type const& ret = m_container.at(key);
+        detail::openElement(const_cast< mapped_type& >(ret));
+        return ret;
+    }
 
     /** Access the value that is mapped to a key equivalent to key, creating it if such key does not exist already.
      *
@@ -118,13 +197,17 @@ public:
     {
         auto it = m_container.find(key);
         if( it != m_container.end() )
+        {
+            detail::openElement(it->second);
             return it->second;
-        else
+        } else
         {
             T t = T();
             t.IOHandler = IOHandler;
             t.parent = this;
-            return m_container.insert({key, std::move(t)}).first->second;
+            mapped_type& ret = m_container.insert({key, std::move(t)}).first->second;
+            ret.setDirty();
+            return ret;
         }
     }
     /** Access the value that is mapped to a key equivalent to key, creating it if such key does not exist already.
@@ -136,20 +219,36 @@ public:
     {
         auto it = m_container.find(key);
         if( it != m_container.end() )
+        {
+            detail::openElement(it->second);
             return it->second;
-        else
+        } else
         {
             T t = T();
             t.IOHandler = IOHandler;
             t.parent = this;
-            return m_container.insert({std::move(key), std::move(t)}).first->second;
+            mapped_type& ret = m_container.insert({std::move(key), std::move(t)}).first->second;
+            ret.setDirty();
+            return ret;
         }
     }
 
     size_type count(key_type const& key) const { return m_container.count(key); }
 
-    iterator find(key_type const& key) { return m_container.find(key); }
-    const_iterator find(key_type const& key) const { return m_container.find(key); }
+    iterator find(key_type const& key)
+    {
+        auto it = m_container.find(key);
+        if( it != m_container.end() )
+            detail::openElement(it->second);
+        return it;
+    }
+    const_iterator find(key_type const& key) const
+    {
+        auto it = m_container.find(key);
+        if( it != m_container.end() )
+            detail::openElement(const_cast< mapped_type& >(it->second));
+        return it;
+    }
 
     /** Remove a single element from the container and (if written) from disk.
      *
@@ -192,10 +291,24 @@ protected:
             Parameter< Operation::CREATE_PATH > pCreate;
             pCreate.path = path;
             IOHandler->enqueue(IOTask(this, pCreate));
-            IOHandler->flush();
         }
 
         flushAttributes();
     }
+
+    std::string childName(Writable const* child) const override
+    {
+        for( auto const& entry : m_container )
+            if( static_cast< Writable const* >(&entry.second) == child )
+                return detail::keyName(entry.first);
+        /* elements may attach their own children here, e.g. the component of a scalar record, named like the element */
+        for( auto const& entry : m_container )
+        {
+            auto element = dynamic_cast< Attributable const* >(static_cast< Writable const* >(&entry.second));
+            if( element && !element->childName(child).empty() )
+                return detail::keyName(entry.first);
+        }
+        return std::string();
+    }
 };
 } // openPMD
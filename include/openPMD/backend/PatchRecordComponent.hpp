@@ -4,8 +4,12 @@
 #include "openPMD/backend/GenericPatchData.hpp"
 #include "openPMD/backend/PatchPosition.hpp"
 
+#include <memory>
+#include <queue>
 #include <unordered_map>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 
 namespace openPMD
@@ -32,7 +36,38 @@ private:
     PatchRecordComponent();
 
     void flush(std::string const&);
+    /** Write the value of one patch into a dataset holding numPatches values on the next flush.
+     */
+    template< typename T >
+    void store(uint64_t patch, uint64_t numPatches, T value);
 
+    IOTaskQueue m_chunks;
     std::unordered_map< PatchPosition, GenericPatchData > m_data;
+
+protected:
+    /** Values read from file, one per patch, converted to double for patch selection. */
+    std::vector< double > m_values;
 };  //PatchRecordComponent
+
+
+template< typename T >
+inline void
+PatchRecordComponent::store(uint64_t patch, uint64_t numPatches, T value)
+{
+    Datatype dtype = determineDatatype< T >();
+    if( m_dataset.dtype == Datatype::UNDEFINED )
+    {
+        m_dataset = Dataset(dtype, {numPatches});
+        m_dataset.setChunkSize({numPatches});
+    } else if( m_dataset.dtype != dtype || m_dataset.extent != Extent{numPatches} )
+        throw std::runtime_error("All patches of a patch record component must have the same datatype and number of patches.");
+
+    Parameter< Operation::WRITE_DATASET > dWrite;
+    dWrite.offset = {patch};
+    dWrite.extent = {1};
+    dWrite.dtype = dtype;
+    dWrite.data = std::make_shared< T >(value);
+    m_chunks.push(IOTask(this, dWrite));
+    setDirty();
+}
 } // openPMD
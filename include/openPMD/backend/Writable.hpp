@@ -46,22 +46,31 @@ class Writable
     >
     friend class Container;
     friend class Iteration;
+    friend class RecordComponent;
+    friend class Series;
     friend class ADIOS1IOHandlerImpl;
     friend class ParallelADIOS1IOHandlerImpl;
     friend class ADIOS2IOHandlerImpl;
     friend class HDF5IOHandlerImpl;
     friend class ParallelHDF5IOHandlerImpl;
     friend std::string concrete_h5_file_position(Writable*);
+    friend std::string concrete_bp1_file_position(Writable*);
+    friend std::string concrete_bp2_file_position(Writable*);
 
 public:
     Writable();
     virtual ~Writable();
 
 protected:
+    /** Flag this object as modified and all objects above it as containing modified objects.
+     */
+    void setDirty();
+
     std::shared_ptr< AbstractFilePosition > abstractFilePosition;
     Writable* parent;
     std::shared_ptr< AbstractIOHandler > IOHandler;
     bool dirty;
+    bool dirtyRecursive; /* this object or an object below it has been modified since it was last flushed */
     bool written;
 };
 } // openPMD
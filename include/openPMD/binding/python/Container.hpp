@@ -0,0 +1,60 @@
+/* Copyright 2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+
+namespace openPMD
+{
+namespace python
+{
+/** Give a bound Container the interface of a Python mapping.
+ *
+ * Elements are returned by reference and keep their container alive.
+ * As in C++, accessing a missing key creates the element.
+ */
+template< typename Container, typename Class >
+inline Class&
+addContainerMethods(Class& cl)
+{
+    namespace py = pybind11;
+    using Key = typename Container::key_type;
+    using Element = typename Container::mapped_type;
+
+    cl.def("__getitem__",
+           [](Container& c, Key const& key) -> Element& { return c[key]; },
+           py::return_value_policy::reference_internal)
+      .def("__delitem__",
+           [](Container& c, Key const& key)
+           {
+               if( c.erase(key) == 0 )
+                   throw py::key_error();
+           })
+      .def("__contains__", [](Container const& c, Key const& key){ return c.count(key) != 0; })
+      .def("__len__", [](Container const& c){ return c.size(); })
+      .def("__iter__",
+           [](Container const& c){ return py::make_key_iterator(c.begin(), c.end()); },
+           py::keep_alive< 0, 1 >());
+    return cl;
+}
+} // python
+} // openPMD
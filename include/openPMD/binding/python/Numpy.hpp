@@ -0,0 +1,154 @@
+/* Copyright 2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "openPMD/Datatype.hpp"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <stdexcept>
+#include <string>
+
+
+namespace openPMD
+{
+namespace python
+{
+/** Invoke action.template call< T >() with the C++ type T of elements of Datatype dt.
+ *
+ * @throws  std::runtime_error  If dt is no scalar type numpy arrays can hold.
+ */
+template< typename Action >
+inline void
+switchArrayType(Datatype dt, Action& action)
+{
+    using DT = Datatype;
+    switch( dt )
+    {
+        case DT::CHAR:
+            action.template call< char >();
+            break;
+        case DT::UCHAR:
+            action.template call< unsigned char >();
+            break;
+        case DT::INT16:
+            action.template call< int16_t >();
+            break;
+        case DT::INT32:
+            action.template call< int32_t >();
+            break;
+        case DT::INT64:
+            action.template call< int64_t >();
+            break;
+        case DT::UINT16:
+            action.template call< uint16_t >();
+            break;
+        case DT::UINT32:
+            action.template call< uint32_t >();
+            break;
+        case DT::UINT64:
+            action.template call< uint64_t >();
+            break;
+        case DT::FLOAT:
+            action.template call< float >();
+            break;
+        case DT::DOUBLE:
+            action.template call< double >();
+            break;
+        case DT::LONG_DOUBLE:
+            action.template call< long double >();
+            break;
+        case DT::BOOL:
+            action.template call< bool >();
+            break;
+        default:
+            throw std::runtime_error("Datatype can not be held by numpy arrays");
+    }
+}
+
+/** Datatype of the elements of a numpy array.
+ *
+ * @throws  std::runtime_error  If the elements are no scalars in native byte order.
+ */
+inline Datatype
+toDatatype(pybind11::dtype const& dt)
+{
+    if( !dt.attr("isnative").cast< bool >() )
+        throw std::runtime_error("Only numpy arrays in native byte order are supported");
+
+    using DT = Datatype;
+    size_t const size = static_cast< size_t >(dt.itemsize());
+    switch( dt.kind() )
+    {
+        case 'b':
+            return DT::BOOL;
+        case 'i':
+            switch( size )
+            {
+                case 1: return DT::CHAR;
+                case 2: return DT::INT16;
+                case 4: return DT::INT32;
+                case 8: return DT::INT64;
+            }
+            break;
+        case 'u':
+            switch( size )
+            {
+                case 1: return DT::UCHAR;
+                case 2: return DT::UINT16;
+                case 4: return DT::UINT32;
+                case 8: return DT::UINT64;
+            }
+            break;
+        case 'f':
+            if( size == sizeof(float) )
+                return DT::FLOAT;
+            if( size == sizeof(double) )
+                return DT::DOUBLE;
+            if( size == sizeof(long double) )
+                return DT::LONG_DOUBLE;
+            break;
+    }
+    throw std::runtime_error("Unsupported numpy dtype " + pybind11::str(dt).cast< std::string >());
+}
+
+struct ToDtype
+{
+    pybind11::dtype dtype;
+
+    template< typename T >
+    void call() { dtype = pybind11::dtype::of< T >(); }
+};
+
+/** Numpy dtype of the elements of Datatype dt.
+ *
+ * @throws  std::runtime_error  If dt is no scalar type numpy arrays can hold.
+ */
+inline pybind11::dtype
+toDtype(Datatype dt)
+{
+    ToDtype action;
+    switchArrayType(dt, action);
+    return action.dtype;
+}
+} // python
+} // openPMD
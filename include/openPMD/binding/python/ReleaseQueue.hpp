@@ -0,0 +1,72 @@
+/* Copyright 2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <mutex>
+#include <vector>
+
+
+namespace openPMD
+{
+namespace python
+{
+/** References to arrays passed to store_chunk whose chunks have been released by the API.
+ *
+ * Chunks may be released on any thread, e.g. the IO thread of an asynchronous flush.
+ * Taking the GIL there deadlocks if a Python thread holds it while waiting for that thread (e.g. in ~Series),
+ * so the references are only queued and dropped later by a thread that holds the GIL.
+ */
+class ReleaseQueue
+{
+public:
+    static ReleaseQueue& instance()
+    {
+        static ReleaseQueue queue;
+        return queue;
+    }
+
+    /** Take over a reference, safe without the GIL. */
+    void push(pybind11::object* reference)
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        m_references.push_back(reference);
+    }
+
+    /** Drop all queued references, the GIL must be held. */
+    void drain()
+    {
+        std::vector< pybind11::object* > references;
+        {
+            std::lock_guard< std::mutex > lock(m_mutex);
+            std::swap(references, m_references);
+        }
+        for( auto r : references )
+            delete r;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector< pybind11::object* > m_references;
+};  //ReleaseQueue
+} // python
+} // openPMD
@@ -20,5 +20,6 @@
  */
 #pragma once
 
+#include "openPMD/Decomposition.hpp"
 #include "openPMD/Series.hpp"
 #include "openPMD/version.hpp"
@@ -1,6 +1,12 @@
 #include "openPMD/Dataset.hpp"
+#include "openPMD/auxiliary/StringManip.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <sstream>
 
 
 namespace openPMD
@@ -15,6 +21,8 @@ Dataset::Dataset(Datatype d, Extent e)
 Dataset&
 Dataset::extend(Extent newExtents)
 {
+    if( fixedSize )
+        throw std::runtime_error("A Dataset of fixed size can not be extended");
     if( newExtents.size() != rank )
         throw std::runtime_error("Dimensionality of extended Dataset must match the original dimensionality");
     for( size_t i = 0; i < newExtents.size(); ++i )
@@ -38,13 +46,72 @@ Dataset::setChunkSize(std::vector< size_t > const& cs)
     return *this;
 }
 
+Dataset&
+Dataset::setAutoChunking(size_t targetChunkBytes, AccessPattern pattern)
+{
+    if( rank == 0 )
+        return *this;
+
+    uint64_t const targetPoints = std::max< uint64_t >(1u, targetChunkBytes / toBytes(dtype));
+
+    /* halve the largest dimension of a chunk spanning the extent until it fits */
+    auto fit = [](Extent chunk, uint64_t maxPoints)
+    {
+        for( auto& c : chunk )
+            c = std::max< uint64_t >(c, 1u);
+        auto points = [&chunk](){
+            uint64_t p = 1;
+            for( auto const& c : chunk )
+                p *= c;
+            return p;
+        };
+        while( points() > maxPoints )
+        {
+            auto largest = std::max_element(chunk.begin(), chunk.end());
+            if( *largest == 1 )
+                break;
+            *largest = (*largest + 1) / 2;
+        }
+        return chunk;
+    };
+
+    Extent cs;
+    if( pattern == AccessPattern::SLICES && rank > 1 )
+    {
+        /* a slice covers as few chunks as possible, whole planes are stacked only if they are small */
+        Extent plane = fit(Extent(extent.begin() + 1, extent.end()), targetPoints);
+        uint64_t planePoints = 1;
+        for( auto const& c : plane )
+            planePoints *= c;
+        cs.push_back(std::min< uint64_t >(std::max< uint64_t >(extent[0], 1u),
+                                          std::max< uint64_t >(targetPoints / planePoints, 1u)));
+        cs.insert(cs.end(), plane.begin(), plane.end());
+    } else
+        cs = fit(extent, targetPoints);
+
+    chunkSize = cs;
+    return *this;
+}
+
 Dataset&
 Dataset::setCompression(std::string const& format, uint8_t const level)
 {
-    if( (format == "zlib" || format == "gzip" || format == "deflate")
-        && level > 9 )
-        throw std::runtime_error("Compression level out of range for " + format);
-    else
+    if( format == "zlib" || format == "gzip" || format == "deflate" )
+    {
+        if( level > 9 )
+            throw std::runtime_error("Compression level out of range for " + format);
+    } else if( auxiliary::starts_with(format, "blosc") )
+    {
+        if( format != "blosc" && format != "blosc-blosclz" && format != "blosc-lz4"
+            && format != "blosc-lz4hc" && format != "blosc-zlib" && format != "blosc-zstd" )
+            throw std::runtime_error("Unknown Blosc compressor " + format);
+        if( level > 9 )
+            throw std::runtime_error("Compression level out of range for " + format);
+    } else if( format == "zstd" )
+    {
+        if( level < 1 || level > 22 )
+            throw std::runtime_error("Compression level out of range for " + format);
+    } else if( format != "lz4" )
         std::cerr << "Unknown compression format " << format
                   << ". This might mean that compression will not be enabled."
                   << std::endl;
@@ -53,10 +120,69 @@ Dataset::setCompression(std::string const& format, uint8_t const level)
     return *this;
 }
 
+Dataset&
+Dataset::setCompression(std::string const& format, std::string const& mode, double parameter)
+{
+    if( format == "zfp" )
+    {
+        if( mode != "accuracy" && mode != "rate" && mode != "precision" )
+            throw std::runtime_error("Unknown mode " + mode + " for " + format);
+        if( mode == "precision" && (parameter < 1. || parameter > 64. || parameter != std::floor(parameter)) )
+            throw std::runtime_error("Precision out of range for " + format);
+    } else if( format == "sz" )
+    {
+        if( mode != "abs" && mode != "rel" && mode != "pw_rel" )
+            throw std::runtime_error("Unknown mode " + mode + " for " + format);
+    } else
+        throw std::runtime_error("Unknown lossy compression format " + format);
+    if( !(parameter > 0.) || std::isinf(parameter) )
+        throw std::runtime_error("Parameter of lossy compression must be finite and positive");
+
+    std::ostringstream s;
+    s << format << ':' << mode << ':'
+      << std::setprecision(std::numeric_limits< double >::max_digits10) << parameter;
+    compression = s.str();
+    return *this;
+}
+
 Dataset&
 Dataset::setCustomTransform(std::string const& parameter)
 {
     transform = parameter;
     return *this;
 }
+
+Dataset&
+Dataset::setChunkCache(std::size_t bytes, std::size_t slots, double preemption)
+{
+    if( !(preemption >= 0. && preemption <= 1.) )
+        throw std::runtime_error("Chunk cache preemption must be in [0, 1]");
+
+    chunkCache.bytes = bytes;
+    chunkCache.slots = slots;
+    chunkCache.preemption = preemption;
+    return *this;
+}
+
+Dataset&
+Dataset::setFixedSize(bool fixed)
+{
+    fixedSize = fixed;
+    return *this;
+}
+
+Dataset&
+Dataset::setAllocation(AllocationTime time, FillTime fill)
+{
+    allocation.time = time;
+    allocation.fill = fill;
+    return *this;
+}
+
+Dataset&
+Dataset::setTransfer(Transfer t)
+{
+    transfer = t;
+    return *this;
+}
 } // openPMD
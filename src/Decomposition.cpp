@@ -0,0 +1,176 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/Decomposition.hpp"
+#include "openPMD/ParticleSpecies.hpp"
+#include "openPMD/RecordComponent.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+
+namespace openPMD
+{
+std::vector< PatchPosition >
+decompose(ParticleSpecies& species, uint64_t numRanks, double tolerance)
+{
+    if( numRanks == 0 )
+        throw std::runtime_error("Decomposition requires at least one rank.");
+
+    /* ranges may end at the boundaries of all patches */
+    std::vector< uint64_t > boundaries;
+    uint64_t numParticles = 0;
+    ParticlePatches const& patches = species.particlePatches;
+    for( size_t i = 0; i < patches.numPatches(); ++i )
+    {
+        PatchPosition const& pos = patches.position(i);
+        boundaries.push_back(pos.numParticlesOffset);
+        boundaries.push_back(pos.numParticlesOffset + pos.numParticles);
+        numParticles = std::max(numParticles, pos.numParticlesOffset + pos.numParticles);
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+
+    if( boundaries.empty() )
+        for( auto& record : species )
+            for( auto& component : record.second )
+            {
+                Extent e = component.second.getExtent();
+                if( !e.empty() )
+                    numParticles = std::max(numParticles, e[0]);
+            }
+
+    double const balanced = static_cast< double >(numParticles) / numRanks;
+    std::vector< PatchPosition > ret;
+    ret.reserve(numRanks);
+    uint64_t begin = 0;
+    for( uint64_t rank = 1; rank <= numRanks; ++rank )
+    {
+        uint64_t end = numParticles;
+        if( rank < numRanks )
+        {
+            uint64_t ideal = static_cast< uint64_t >(std::llround(rank * balanced));
+            end = ideal;
+
+            /* nearest patch boundary not before the start of this range */
+            auto next = std::lower_bound(boundaries.begin(), boundaries.end(), ideal);
+            uint64_t nearest = 0;
+            double distance = std::numeric_limits< double >::infinity();
+            if( next != boundaries.end() )
+            {
+                nearest = *next;
+                distance = static_cast< double >(*next - ideal);
+            }
+            if( next != boundaries.begin() && *(next - 1) >= begin && static_cast< double >(ideal - *(next - 1)) < distance )
+            {
+                nearest = *(next - 1);
+                distance = static_cast< double >(ideal - nearest);
+            }
+            if( distance <= tolerance * balanced )
+                end = nearest;
+            end = std::max(end, begin);
+        }
+        ret.emplace_back(end - begin, begin);
+        begin = end;
+    }
+    return ret;
+}
+
+std::vector< std::pair< Offset, Extent > >
+decompose(RecordComponent& rc, uint64_t numRanks)
+{
+    if( numRanks == 0 )
+        throw std::runtime_error("Decomposition requires at least one rank.");
+
+    Extent extent = rc.getExtent();
+    Extent chunk = rc.getChunkSize();
+    if( chunk.size() != extent.size() )
+        chunk = extent;
+    size_t const dims = extent.size();
+
+    std::vector< uint64_t > numChunks(dims);
+    for( size_t d = 0; d < dims; ++d )
+    {
+        chunk[d] = std::max< uint64_t >(chunk[d], 1u);
+        numChunks[d] = (extent[d] + chunk[d] - 1) / chunk[d];
+    }
+
+    /* distribute the prime factors of numRanks, largest first, to the dimension with most chunks per block,
+     * a factor that does not fit into any dimension is reduced to what fits and leaves ranks without a block */
+    std::vector< uint64_t > factors;
+    uint64_t n = numRanks;
+    for( uint64_t p = 2; p * p <= n; ++p )
+        while( n % p == 0 )
+        {
+            factors.push_back(p);
+            n /= p;
+        }
+    if( n > 1 )
+        factors.push_back(n);
+    std::sort(factors.begin(), factors.end(), std::greater< uint64_t >());
+
+    std::vector< uint64_t > grid(dims, 1);
+    uint64_t numBlocks = 1;
+    for( uint64_t f : factors )
+    {
+        size_t best = dims;
+        uint64_t most = 1;
+        for( size_t d = 0; d < dims; ++d )
+        {
+            uint64_t perBlock = numChunks[d] / grid[d];
+            if( perBlock > most )
+            {
+                best = d;
+                most = perBlock;
+            }
+        }
+        if( best == dims )
+            break;
+        f = std::min(f, most);
+        grid[best] *= f;
+        numBlocks *= f;
+    }
+
+    std::vector< std::pair< Offset, Extent > > ret;
+    ret.reserve(numRanks);
+    for( uint64_t rank = 0; rank < numRanks; ++rank )
+    {
+        Offset o(dims, 0);
+        Extent e(dims, 0);
+        if( rank < numBlocks )
+        {
+            uint64_t index = rank;
+            for( size_t d = dims; d-- > 0; )
+            {
+                uint64_t block = index % grid[d];
+                index /= grid[d];
+                uint64_t first = block * numChunks[d] / grid[d];
+                uint64_t last = (block + 1) * numChunks[d] / grid[d];
+                o[d] = std::min(first * chunk[d], extent[d]);
+                e[d] = std::min(last * chunk[d], extent[d]) - o[d];
+            }
+        }
+        ret.emplace_back(std::move(o), std::move(e));
+    }
+    return ret;
+}
+} // openPMD
@@ -20,28 +20,1320 @@
  */
 #include "openPMD/IO/ADIOS/ADIOS1IOHandler.hpp"
 
+#if openPMD_HAVE_ADIOS1
+#   include "openPMD/auxiliary/Memory.hpp"
+#   include "openPMD/auxiliary/StringManip.hpp"
+#   include "openPMD/backend/Attributable.hpp"
+#   include "openPMD/IO/ADIOS/ADIOS1FilePosition.hpp"
+#   include "openPMD/IO/ADIOS/ADIOSAuxiliary.hpp"
+#   include <boost/filesystem.hpp>
+#   include <algorithm>
+#   include <array>
+#   include <cstdlib>
+#   include <exception>
+#   include <iostream>
+#   include <mutex>
+#   include <set>
+#   include <sstream>
+#   include <stack>
+#endif
+
 
 namespace openPMD
 {
 #if openPMD_HAVE_ADIOS1
-ADIOS1IOHandler::ADIOS1IOHandler(std::string const& path, AccessType at)
-        : AbstractIOHandler(path, at),
-          m_impl{new ADIOS1IOHandlerImpl(this)}
-{ }
+std::string
+concrete_bp1_file_position(Writable* w)
+{
+    std::stack< Writable* > hierarchy;
+    if( !w->abstractFilePosition )
+        w = w->parent;
+    while( w )
+    {
+        hierarchy.push(w);
+        w = w->parent;
+    }
 
-ADIOS1IOHandler::~ADIOS1IOHandler()
-{ }
+    std::string pos;
+    while( !hierarchy.empty() )
+    {
+        /* objects that have not been written yet (e.g. the Series before its file is created) have no position */
+        auto position = std::dynamic_pointer_cast< ADIOS1FilePosition >(hierarchy.top()->abstractFilePosition);
+        if( position )
+            pos += position->location;
+        hierarchy.pop();
+    }
+
+    return auxiliary::replace_all(pos, "//", "/");
+}
+
+namespace
+{
+/* ADIOS1 has to be initialized once per process, independent of the number of handlers */
+std::mutex bp1_init_mutex;
+int bp1_users = 0;
+
+void
+bp1_init(MPI_Comm comm)
+{
+    std::lock_guard< std::mutex > lock(bp1_init_mutex);
+    if( bp1_users++ == 0 )
+    {
+        if( adios_init_noxml(comm) != 0 )
+            throw std::runtime_error("Internal error: Failed to initialize ADIOS1: " + std::string(adios_errmsg()));
+        if( adios_read_init_method(ADIOS_READ_METHOD_BP, comm, "verbose=0") != 0 )
+            throw std::runtime_error("Internal error: Failed to initialize ADIOS1 reading: " + std::string(adios_errmsg()));
+    }
+}
+
+void
+bp1_finalize(MPI_Comm comm)
+{
+    std::lock_guard< std::mutex > lock(bp1_init_mutex);
+    if( --bp1_users == 0 )
+    {
+        int rank = 0;
+#   if openPMD_HAVE_MPI
+        MPI_Comm_rank(comm, &rank);
+#   else
+        (void)comm;
+#   endif
+        adios_read_finalize_method(ADIOS_READ_METHOD_BP);
+        adios_finalize(rank);
+    }
+}
+
+/** Full name of all variables and attributes residing directly inside an object, always ending in '/'. */
+std::string
+bp1_prefix(Writable* w)
+{
+    std::string prefix = concrete_bp1_file_position(w);
+    if( !auxiliary::ends_with(prefix, "/") )
+        prefix += '/';
+    return prefix;
+}
+
+/* ADIOS1 has neither a boolean type nor fixed-size arrays and does not tell a vector of one element from a single value.
+ * The openPMD datatype of such attributes and datasets is stored by name in an additional string attribute.
+ * It lives outside of "/" and is thus never listed as part of the openPMD hierarchy. */
+std::string
+bp1_dtype_marker(std::string const& fullName)
+{
+    return "__openPMD_internal" + fullName + "/dtype";
+}
+
+std::string
+bp1_dtype_name(Datatype dtype)
+{
+    std::ostringstream name;
+    name << dtype;
+    return name.str();
+}
+
+Datatype
+bp1_dtype(std::string const& name)
+{
+    for( int i = static_cast< int >(Datatype::CHAR); i <= static_cast< int >(Datatype::BOOL); ++i )
+        if( bp1_dtype_name(static_cast< Datatype >(i)) == name )
+            return static_cast< Datatype >(i);
+    return Datatype::UNDEFINED;
+}
+
+/** Whether the datatype of an attribute can not be told from its ADIOS1 type alone. */
+bool
+bp1_needs_dtype_marker(Datatype dtype)
+{
+    return dtype == Datatype::BOOL || dtype == Datatype::ARR_DBL_7
+           || (dtype >= Datatype::VEC_CHAR && dtype <= Datatype::VEC_STRING);
+}
+
+/** Datatype stored in the marker of an attribute or dataset, UNDEFINED if there is none. */
+Datatype
+bp1_marked_dtype(ADIOS_FILE* f, std::string const& fullName)
+{
+    ADIOS_DATATYPES type;
+    int size;
+    void* data;
+    if( adios_get_attr(f, bp1_dtype_marker(fullName).c_str(), &type, &size, &data) != 0 )
+        return Datatype::UNDEFINED;
+    std::shared_ptr< void > owner(data, [](void* p){ std::free(p); });
+    if( type != adios_string )
+        return Datatype::UNDEFINED;
+    return bp1_dtype(std::string(static_cast< char const* >(data)));
+}
+
+std::string
+bp1_dims(std::vector< std::uint64_t > const& v)
+{
+    std::ostringstream dims;
+    for( std::size_t i = 0; i < v.size(); ++i )
+        dims << (i == 0 ? "" : ",") << v[i];
+    return dims.str();
+}
+
+ADIOS_DATATYPES
+getBP1DataType(Datatype dt)
+{
+    using DT = Datatype;
+    switch( dt )
+    {
+        case DT::CHAR:
+        case DT::VEC_CHAR:
+            return adios_byte;
+        case DT::UCHAR:
+        case DT::VEC_UCHAR:
+        case DT::BOOL:
+            return adios_unsigned_byte;
+        case DT::INT16:
+        case DT::VEC_INT16:
+            return adios_short;
+        case DT::INT32:
+        case DT::VEC_INT32:
+            return adios_integer;
+        case DT::INT64:
+        case DT::VEC_INT64:
+            return adios_long;
+        case DT::UINT16:
+        case DT::VEC_UINT16:
+            return adios_unsigned_short;
+        case DT::UINT32:
+        case DT::VEC_UINT32:
+            return adios_unsigned_integer;
+        case DT::UINT64:
+        case DT::VEC_UINT64:
+            return adios_unsigned_long;
+        case DT::FLOAT:
+        case DT::VEC_FLOAT:
+            return adios_real;
+        case DT::DOUBLE:
+        case DT::VEC_DOUBLE:
+        case DT::ARR_DBL_7:
+            return adios_double;
+        case DT::LONG_DOUBLE:
+        case DT::VEC_LONG_DOUBLE:
+            return adios_long_double;
+        case DT::STRING:
+            return adios_string;
+        case DT::VEC_STRING:
+            return adios_string_array;
+        case DT::DATATYPE:
+        case DT::UNDEFINED:
+            break;
+    }
+    throw unsupported_data_error("Datatype not supported by ADIOS1 backend");
+}
+
+Datatype
+fromBP1DataType(ADIOS_DATATYPES t)
+{
+    using DT = Datatype;
+    switch( t )
+    {
+        case adios_byte:
+            return DT::CHAR;
+        case adios_unsigned_byte:
+            return DT::UCHAR;
+        case adios_short:
+            return DT::INT16;
+        case adios_integer:
+            return DT::INT32;
+        case adios_long:
+            return DT::INT64;
+        case adios_unsigned_short:
+            return DT::UINT16;
+        case adios_unsigned_integer:
+            return DT::UINT32;
+        case adios_unsigned_long:
+            return DT::UINT64;
+        case adios_real:
+            return DT::FLOAT;
+        case adios_double:
+            return DT::DOUBLE;
+        case adios_long_double:
+            return DT::LONG_DOUBLE;
+        case adios_string:
+            return DT::STRING;
+        case adios_string_array:
+            return DT::VEC_STRING;
+        default:
+            throw unsupported_data_error("Unsupported ADIOS1 datatype " + std::to_string(static_cast< int >(t)));
+    }
+}
+
+struct DefineAttribute
+{
+    int64_t group;
+    std::string const& name;
+    Attribute const& att;
+
+    template< typename T >
+    void scalar()
+    {
+        T value = att.get< T >();
+        define(getBP1DataType(att.dtype), 1, &value);
+    }
+
+    template< typename T >
+    void vector()
+    {
+        std::vector< T > value = att.get< std::vector< T > >();
+        define(getBP1DataType(att.dtype), static_cast< int >(value.size()), value.data());
+    }
+
+    void define(ADIOS_DATATYPES type, int nelems, void const* values)
+    {
+        if( adios_define_attribute_byvalue(group, name.c_str(), "", type, nelems, values) != 0 )
+            throw std::runtime_error("Internal error: Failed to define ADIOS1 attribute " + name + ": " + adios_errmsg());
+    }
+};
+
+void
+defineAttribute(int64_t group, std::string const& name, Attribute const& att)
+{
+    DefineAttribute define{group, name, att};
+    using DT = Datatype;
+    switch( att.dtype )
+    {
+        case DT::CHAR:
+            define.scalar< char >();
+            break;
+        case DT::UCHAR:
+            define.scalar< unsigned char >();
+            break;
+        case DT::INT16:
+            define.scalar< int16_t >();
+            break;
+        case DT::INT32:
+            define.scalar< int32_t >();
+            break;
+        case DT::INT64:
+            define.scalar< int64_t >();
+            break;
+        case DT::UINT16:
+            define.scalar< uint16_t >();
+            break;
+        case DT::UINT32:
+            define.scalar< uint32_t >();
+            break;
+        case DT::UINT64:
+            define.scalar< uint64_t >();
+            break;
+        case DT::FLOAT:
+            define.scalar< float >();
+            break;
+        case DT::DOUBLE:
+            define.scalar< double >();
+            break;
+        case DT::LONG_DOUBLE:
+            define.scalar< long double >();
+            break;
+        case DT::STRING:
+        {
+            std::string value = att.get< std::string >();
+            define.define(adios_string, 1, value.c_str());
+            break;
+        }
+        case DT::VEC_CHAR:
+            define.vector< char >();
+            break;
+        case DT::VEC_INT16:
+            define.vector< int16_t >();
+            break;
+        case DT::VEC_INT32:
+            define.vector< int32_t >();
+            break;
+        case DT::VEC_INT64:
+            define.vector< int64_t >();
+            break;
+        case DT::VEC_UCHAR:
+            define.vector< unsigned char >();
+            break;
+        case DT::VEC_UINT16:
+            define.vector< uint16_t >();
+            break;
+        case DT::VEC_UINT32:
+            define.vector< uint32_t >();
+            break;
+        case DT::VEC_UINT64:
+            define.vector< uint64_t >();
+            break;
+        case DT::VEC_FLOAT:
+            define.vector< float >();
+            break;
+        case DT::VEC_DOUBLE:
+            define.vector< double >();
+            break;
+        case DT::VEC_LONG_DOUBLE:
+            define.vector< long double >();
+            break;
+        case DT::VEC_STRING:
+        {
+            std::vector< std::string > value = att.get< std::vector< std::string > >();
+            std::vector< char const* > ptrs;
+            for( auto const& v : value )
+                ptrs.push_back(v.c_str());
+            define.define(adios_string_array, static_cast< int >(ptrs.size()), ptrs.data());
+            break;
+        }
+        case DT::ARR_DBL_7:
+        {
+            std::array< double, 7 > value = att.get< std::array< double, 7 > >();
+            define.define(adios_double, 7, value.data());
+            break;
+        }
+        case DT::BOOL:
+        {
+            unsigned char value = att.get< bool >();
+            define.define(adios_unsigned_byte, 1, &value);
+            break;
+        }
+        case DT::DATATYPE:
+        case DT::UNDEFINED:
+            throw std::runtime_error("Unknown Attribute datatype");
+    }
+}
+
+template< typename T >
+Attribute
+decodeAttribute(void const* data, int size, bool vector)
+{
+    T const* values = static_cast< T const* >(data);
+    std::size_t n = static_cast< std::size_t >(size) / sizeof(T);
+    if( n == 1 && !vector )
+        return Attribute(values[0]);
+    return Attribute(std::vector< T >(values, values + n));
+}
+
+/** Decode the attribute with the given full name from a file opened for reading.
+ *
+ * @throws  no_such_attribute_error If there is no such attribute.
+ * @throws  unsupported_data_error  If the attribute type is not part of the openPMD standard.
+ */
+Attribute
+readAttributeValue(ADIOS_FILE* f, std::string const& fullName)
+{
+    ADIOS_DATATYPES type;
+    int size;
+    void* data;
+    if( adios_get_attr(f, fullName.c_str(), &type, &size, &data) != 0 )
+        throw no_such_attribute_error(fullName);
+    std::shared_ptr< void > owner(data, [](void* p){ std::free(p); });
+
+    Datatype const dtype = bp1_marked_dtype(f, fullName);
+    bool const vector = dtype == Datatype::ARR_DBL_7 || (dtype >= Datatype::VEC_CHAR && dtype <= Datatype::VEC_STRING);
+    Attribute a(std::string{});
+    switch( type )
+    {
+        case adios_byte:
+            a = decodeAttribute< char >(data, size, vector);
+            break;
+        case adios_unsigned_byte:
+            a = decodeAttribute< unsigned char >(data, size, vector);
+            break;
+        case adios_short:
+            a = decodeAttribute< int16_t >(data, size, vector);
+            break;
+        case adios_integer:
+            a = decodeAttribute< int32_t >(data, size, vector);
+            break;
+        case adios_long:
+            a = decodeAttribute< int64_t >(data, size, vector);
+            break;
+        case adios_unsigned_short:
+            a = decodeAttribute< uint16_t >(data, size, vector);
+            break;
+        case adios_unsigned_integer:
+            a = decodeAttribute< uint32_t >(data, size, vector);
+            break;
+        case adios_unsigned_long:
+            a = decodeAttribute< uint64_t >(data, size, vector);
+            break;
+        case adios_real:
+            a = decodeAttribute< float >(data, size, vector);
+            break;
+        case adios_double:
+            a = decodeAttribute< double >(data, size, vector);
+            break;
+        case adios_long_double:
+            a = decodeAttribute< long double >(data, size, vector);
+            break;
+        case adios_string:
+            a = Attribute(std::string(static_cast< char const* >(data)));
+            break;
+        case adios_string_array:
+        {
+            char** strings = static_cast< char** >(data);
+            std::size_t n = static_cast< std::size_t >(size) / sizeof(char*);
+            std::vector< std::string > value;
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                value.emplace_back(strings[i]);
+                std::free(strings[i]);
+            }
+            a = Attribute(value);
+            break;
+        }
+        default:
+            throw unsupported_data_error("Unsupported attribute type " + std::to_string(static_cast< int >(type)));
+    }
+
+    /* restore the datatype the attribute has been written with */
+    if( dtype == Datatype::UNDEFINED || dtype == a.dtype )
+        return a;
+    if( dtype == Datatype::BOOL && a.dtype == Datatype::UCHAR )
+        return Attribute(static_cast< bool >(a.get< unsigned char >()));
+    if( dtype == Datatype::ARR_DBL_7 && a.dtype == Datatype::VEC_DOUBLE && a.get< std::vector< double > >().size() == 7 )
+    {
+        std::vector< double > v = a.get< std::vector< double > >();
+        std::array< double, 7 > arr;
+        std::copy(v.begin(), v.end(), arr.begin());
+        return Attribute(arr);
+    }
+    throw unsupported_data_error("Attribute " + fullName + " of ADIOS1 type " + std::to_string(static_cast< int >(type))
+                                 + " can not be read as " + bp1_dtype_name(dtype));
+}
+
+/** Relative names of all entries in names residing (possibly indirectly) below prefix. */
+std::vector< std::string >
+entriesBelow(std::vector< std::string > const& names, std::string const& prefix)
+{
+    std::vector< std::string > ret;
+    for( auto const& name : names )
+        if( auxiliary::starts_with(name, prefix) )
+            ret.push_back(name.substr(prefix.size()));
+    return ret;
+}
+
+struct ScheduleRead
+{
+    ADIOS_FILE* f;
+    ADIOS_SELECTION* selection;
+    std::string const& name;
+    Datatype stored;
+    Parameter< Operation::READ_DATASET > const& parameters;
+    std::function< void() > finish;
+
+    template< typename S >
+    void call()
+    {
+        Datatype requested = parameters.dtype == Datatype::BOOL ? Datatype::UCHAR : parameters.dtype;
+        if( requested == stored && parameters.scale == 1. )
+        {
+            schedule(parameters.data);
+            return;
+        }
+
+        /* ADIOS1 does not convert, stage the data in its stored type */
+        std::size_t numPoints = 1;
+        for( auto const& e : parameters.extent )
+            numPoints *= e;
+        std::shared_ptr< S > staged(new S[numPoints], [](S* p){ delete[] p; });
+        schedule(staged.get());
+
+        ConvertData< S > convert{staged, parameters.data, numPoints, parameters.scale, {}};
+        switchDatasetType(parameters.dtype, convert);
+        finish = convert.finish;
+    }
+
+    void schedule(void* data)
+    {
+        if( adios_schedule_read(f, selection, name.c_str(), 0, 1, data) != 0 )
+            throw std::runtime_error("Internal error: Failed to schedule ADIOS1 read of " + name + ": " + adios_errmsg());
+    }
+};
+} // namespace
+
+ADIOS1IOHandlerImpl::ADIOS1IOHandlerImpl(AbstractIOHandler* handler)
+        : ADIOS1IOHandlerImpl(handler, MPI_COMM_SELF)
+{
+    m_transport.method = "POSIX";
+}
+
+ADIOS1IOHandlerImpl::ADIOS1IOHandlerImpl(AbstractIOHandler* handler, MPI_Comm comm)
+        : m_comm{comm},
+          m_handler{handler}
+{
+    m_transport.method = "MPI";
+    bp1_init(m_comm);
+}
+
+ADIOS1IOHandlerImpl::~ADIOS1IOHandlerImpl()
+{
+    for( auto& f : m_files )
+    {
+        try
+        {
+            closeFile(f.first, f.second);
+        } catch( std::exception const& e )
+        {
+            std::cerr << "Internal error: Failed to close ADIOS1 file " << f.first << ": " << e.what() << '\n';
+        }
+    }
+    m_files.clear();
+
+    bp1_finalize(m_comm);
+}
 
 std::future< void >
-ADIOS1IOHandler::flush()
+ADIOS1IOHandlerImpl::flush()
 {
-    return m_impl->flush();
+    process((*m_handler).m_work.collect());
+    for( auto& f : m_files )
+        perform(f.first, f.second);
+    return std::future< void >();
+}
+
+void
+ADIOS1IOHandlerImpl::process(std::queue< IOTask >& work)
+{
+    while( !work.empty() )
+    {
+        IOTask& i = work.front();
+        auto measurement = m_handler->statistics.measure(i, concrete_bp1_file_position);
+        try
+        {
+            switch( i.operation )
+            {
+                using O = Operation;
+                case O::CREATE_FILE:
+                    createFile(i.writable, i.getParameter< O::CREATE_FILE >());
+                    break;
+                case O::CREATE_PATH:
+                    createPath(i.writable, i.getParameter< O::CREATE_PATH >());
+                    break;
+                case O::CREATE_DATASET:
+                    createDataset(i.writable, i.getParameter< O::CREATE_DATASET >());
+                    break;
+                case O::EXTEND_DATASET:
+                    extendDataset(i.writable, i.getParameter< O::EXTEND_DATASET >());
+                    break;
+                case O::OPEN_FILE:
+                    openFile(i.writable, i.getParameter< O::OPEN_FILE >());
+                    break;
+                case O::CLOSE_FILE:
+                    closeFile(i.writable, i.getParameter< O::CLOSE_FILE >());
+                    break;
+                case O::ADVANCE:
+                    advance(i.writable, i.getParameter< O::ADVANCE >());
+                    break;
+                case O::OPEN_PATH:
+                    openPath(i.writable, i.getParameter< O::OPEN_PATH >());
+                    break;
+                case O::OPEN_DATASET:
+                    openDataset(i.writable, i.getParameter< O::OPEN_DATASET >());
+                    break;
+                case O::DELETE_FILE:
+                    deleteFile(i.writable, i.getParameter< O::DELETE_FILE >());
+                    break;
+                case O::DELETE_PATH:
+                    deletePath(i.writable, i.getParameter< O::DELETE_PATH >());
+                    break;
+                case O::DELETE_DATASET:
+                    deleteDataset(i.writable, i.getParameter< O::DELETE_DATASET >());
+                    break;
+                case O::DELETE_ATT:
+                    deleteAttribute(i.writable, i.getParameter< O::DELETE_ATT >());
+                    break;
+                case O::WRITE_DATASET:
+                    writeDataset(i.writable, i.getParameter< O::WRITE_DATASET >());
+                    break;
+                case O::WRITE_ATT:
+                    writeAttribute(i.writable, i.getParameter< O::WRITE_ATT >());
+                    break;
+                case O::WRITE_ATTS:
+                    writeAttributes(i.writable, i.getParameter< O::WRITE_ATTS >());
+                    break;
+                case O::READ_DATASET:
+                {
+                    /* the promise is fulfilled by perform() once the scheduled read has completed */
+                    auto& parameter = i.getParameter< O::READ_DATASET >();
+                    try
+                    {
+                        readDataset(i.writable, parameter);
+                    } catch( ... )
+                    {
+                        if( parameter.done )
+                            parameter.done->set_exception(std::current_exception());
+                        throw;
+                    }
+                    break;
+                }
+                case O::MAP_DATASET:
+                    /* the view stays empty, the frontend falls back to READ_DATASET */
+                    break;
+                case O::READ_ATT:
+                    readAttribute(i.writable, i.getParameter< O::READ_ATT >());
+                    break;
+                case O::READ_ATTS:
+                    readAttributes(i.writable, i.getParameter< O::READ_ATTS >());
+                    break;
+                case O::LIST_PATHS:
+                    listPaths(i.writable, i.getParameter< O::LIST_PATHS >());
+                    break;
+                case O::LIST_DATASETS:
+                    listDatasets(i.writable, i.getParameter< O::LIST_DATASETS >());
+                    break;
+                case O::LIST_ATTS:
+                    listAttributes(i.writable, i.getParameter< O::LIST_ATTS >());
+                    break;
+            }
+        } catch (unsupported_data_error& e)
+        {
+            work.pop();
+            throw e;
+        }
+        work.pop();
+    }
+}
+
+void
+ADIOS1IOHandlerImpl::perform(std::string const& name, File& file)
+{
+    /* adios_open is collective, all ranks open the file with the first flush that defines its structure */
+    if( !file.reader && !file.open && (!file.chunks.empty() || !file.attributes.empty()) )
+    {
+        uint64_t bytes = 0;
+        for( auto const& c : file.chunks )
+        {
+            uint64_t n = toBytes(c.dtype);
+            for( auto const& e : c.extent )
+                n *= e;
+            bytes += n;
+        }
+
+        open(name, file);
+        /* only a hint, ADIOS1 grows its buffer for the output of later flushes as needed */
+        uint64_t totalBytes;
+        adios_group_size(file.fd, bytes, &totalBytes);
+    }
+
+    for( auto const& c : file.chunks )
+    {
+        Extent const& global = file.datasets[c.name].second;
+        int64_t var = adios_define_var(file.group,
+                                       c.name.c_str(),
+                                       "",
+                                       getBP1DataType(c.dtype),
+                                       bp1_dims(c.extent).c_str(),
+                                       bp1_dims(global).c_str(),
+                                       bp1_dims(c.offset).c_str());
+        /* the data is copied into the ADIOS1 buffer, the actual (possibly aggregated) IO happens on close */
+        if( adios_write_byid(file.fd, var, c.data.get()) != 0 )
+            throw std::runtime_error("Internal error: Failed to write ADIOS1 variable " + c.name + ": " + adios_errmsg());
+    }
+    file.chunks.clear();
+
+    if( !file.gets.empty() )
+    {
+        std::vector< PendingGet > gets;
+        std::swap(gets, file.gets);
+        try
+        {
+            if( adios_perform_reads(file.reader, 1) != 0 )
+                throw std::runtime_error("Internal error: Failed to read from ADIOS1 file " + name + ": " + adios_errmsg());
+            for( auto& g : gets )
+                if( g.finish )
+                    g.finish();
+        } catch( ... )
+        {
+            for( auto s : file.selections )
+                adios_selection_delete(s);
+            file.selections.clear();
+            for( auto& g : gets )
+                if( g.done )
+                    g.done->set_exception(std::current_exception());
+            throw;
+        }
+        for( auto s : file.selections )
+            adios_selection_delete(s);
+        file.selections.clear();
+        for( auto& g : gets )
+            if( g.done )
+                g.done->set_value();
+    }
+}
+
+std::string const&
+ADIOS1IOHandlerImpl::fileNameOf(Writable* writable)
+{
+    for( Writable* w = writable; w; w = w->parent )
+    {
+        auto it = m_fileNames.find(w);
+        if( it != m_fileNames.end() )
+            return it->second;
+    }
+    throw std::runtime_error("Internal error: Object does not reside in an open ADIOS1 file");
+}
+
+ADIOS1IOHandlerImpl::File&
+ADIOS1IOHandlerImpl::fileOf(Writable* writable)
+{
+    auto it = m_files.find(fileNameOf(writable));
+    if( it == m_files.end() )
+        throw std::runtime_error("Internal error: Object does not reside in an open ADIOS1 file");
+    return it->second;
+}
+
+std::vector< std::string >
+ADIOS1IOHandlerImpl::variableNames(File const& file) const
+{
+    std::vector< std::string > ret;
+    if( file.reader )
+        ret.assign(file.reader->var_namelist, file.reader->var_namelist + file.reader->nvars);
+    else
+        for( auto const& d : file.datasets )
+            ret.push_back(d.first);
+    return ret;
+}
+
+std::vector< std::string >
+ADIOS1IOHandlerImpl::attributeNames(File const& file) const
+{
+    std::vector< std::string > ret;
+    if( file.reader )
+        ret.assign(file.reader->attr_namelist, file.reader->attr_namelist + file.reader->nattrs);
+    else
+        for( auto const& a : file.attributes )
+            ret.push_back(a.first);
+    return ret;
+}
+
+void
+ADIOS1IOHandlerImpl::open(std::string const& name, File& file)
+{
+    if( adios_open(&file.fd, name.c_str(), name.c_str(), "w", m_comm) != 0 )
+        throw std::runtime_error("Internal error: Failed to open ADIOS1 file " + name + ": " + adios_errmsg());
+    file.open = true;
+}
+
+void
+ADIOS1IOHandlerImpl::closeFile(std::string const& name, File& file)
+{
+    perform(name, file);
+    if( file.reader )
+    {
+        adios_read_close(file.reader);
+        file.reader = nullptr;
+        return;
+    }
+
+    int status = 0;
+    if( file.open )
+    {
+        for( auto const& att : file.attributes )
+            defineAttribute(file.group, att.first, att.second);
+        status = adios_close(file.fd);
+        file.open = false;
+    }
+    adios_free_group(file.group);
+    if( status != 0 )
+        throw std::runtime_error("Internal error: Failed to close ADIOS1 file " + name + ": " + adios_errmsg());
+}
+
+void
+ADIOS1IOHandlerImpl::createFile(Writable* writable,
+                                Parameter< Operation::CREATE_FILE > const& parameters)
+{
+    if( !writable->written )
+    {
+        using namespace boost::filesystem;
+        path dir(m_handler->directory);
+        if( !exists(dir) )
+            create_directories(dir);
+
+        std::string name = m_handler->directory + parameters.name;
+        if( !auxiliary::ends_with(name, ".bp") )
+            name += ".bp";
+
+        File& file = m_files[name];
+        if( adios_declare_group(&file.group, name.c_str(), "", adios_stat_no) != 0 )
+            throw std::runtime_error("Internal error: Failed to declare ADIOS1 group: " + std::string(adios_errmsg()));
+        if( adios_select_method(file.group, m_transport.method.c_str(), m_transport.parameters.c_str(), "") != 0 )
+            throw std::runtime_error("Internal error: Failed to select ADIOS1 method " + m_transport.method + ": " + adios_errmsg());
+
+        writable->written = true;
+        writable->abstractFilePosition = std::make_shared< ADIOS1FilePosition >("/");
+
+        m_fileNames[writable] = name;
+    }
+}
+
+void
+ADIOS1IOHandlerImpl::createPath(Writable* writable,
+                                Parameter< Operation::CREATE_PATH > const& parameters)
+{
+    if( !writable->written )
+    {
+        /* Sanitize path */
+        std::string path = parameters.path;
+        if( auxiliary::starts_with(path, "/") )
+            path = auxiliary::replace_first(path, "/", "");
+        if( !auxiliary::ends_with(path, "/") )
+            path += '/';
+
+        /* groups are implicit in ADIOS1, they exist as soon as anything is written below them */
+        Writable* position;
+        if( writable->parent )
+            position = writable->parent;
+        else
+            position = writable; /* root does not have a parent but might still have to be written */
+        std::string file = fileNameOf(position);
+
+        writable->written = true;
+        writable->abstractFilePosition = std::make_shared< ADIOS1FilePosition >(path);
+
+        m_fileNames[writable] = file;
+    }
+}
+
+void
+ADIOS1IOHandlerImpl::createDataset(Writable* writable,
+                                   Parameter< Operation::CREATE_DATASET > const& parameters)
+{
+    if( !writable->written )
+    {
+        std::string name = parameters.name;
+        if( auxiliary::starts_with(name, "/") )
+            name = auxiliary::replace_first(name, "/", "");
+        if( auxiliary::ends_with(name, "/") )
+            name = auxiliary::replace_last(name, "/", "");
+
+        File& file = fileOf(writable);
+        std::string varName = bp1_prefix(writable) + name;
+
+        getBP1DataType(parameters.dtype);
+        file.datasets[varName] = std::make_pair(parameters.dtype, parameters.extent);
+        if( parameters.dtype == Datatype::BOOL )
+        {
+            std::string marker = bp1_dtype_marker(varName);
+            file.attributes.erase(marker);
+            file.attributes.emplace(marker, Attribute(bp1_dtype_name(Datatype::BOOL)));
+        }
+
+        if( !parameters.compression.empty() )
+            std::cerr << "Compression not yet implemented in ADIOS1 backend. Ignoring compression for "
+                      << varName << std::endl;
+        if( !parameters.transform.empty() )
+            std::cerr << "Custom transform not yet implemented in ADIOS1 backend." << std::endl;
+
+        writable->written = true;
+        writable->abstractFilePosition = std::make_shared< ADIOS1FilePosition >(name);
+
+        m_fileNames[writable] = fileNameOf(writable->parent ? writable->parent : writable);
+    }
+}
+
+void
+ADIOS1IOHandlerImpl::extendDataset(Writable* writable,
+                                   Parameter< Operation::EXTEND_DATASET > const& parameters)
+{
+    if( !writable->written )
+        throw std::runtime_error("Extending an unwritten Dataset is not possible.");
+
+    File& file = fileOf(writable);
+    auto it = file.datasets.find(concrete_bp1_file_position(writable));
+    if( it == file.datasets.end() )
+        throw std::runtime_error("Extending a Dataset of a file opened as read only is not possible.");
+
+    /* chunks are written with the global extent valid at the time of writing */
+    it->second.second = parameters.extent;
+}
+
+void
+ADIOS1IOHandlerImpl::openFile(Writable* writable,
+                              Parameter< Operation::OPEN_FILE > const& parameters)
+{
+    using namespace boost::filesystem;
+    path dir(m_handler->directory);
+    if( !exists(dir) )
+        throw no_such_file_error("Supplied directory is not valid: " + m_handler->directory);
+
+    std::string name = m_handler->directory + parameters.name;
+    if( !auxiliary::ends_with(name, ".bp") )
+        name += ".bp";
+
+    /* files created by this handler stay defined until explicitly closed */
+    if( !m_files.count(name) )
+    {
+        if( !exists(path(name)) )
+            throw no_such_file_error("Failed to open ADIOS1 file " + name);
+
+        AccessType at = m_handler->accessType;
+        if( at != AccessType::READ_ONLY )
+            throw std::runtime_error("Modifying an existing file is not possible with the ADIOS1 backend: " + name);
+
+        ADIOS_FILE* reader = adios_read_open_file(name.c_str(), ADIOS_READ_METHOD_BP, m_comm);
+        if( !reader )
+            throw no_such_file_error("Failed to open ADIOS1 file " + name + ": " + adios_errmsg());
+        m_files[name].reader = reader;
+    }
+
+    writable->written = true;
+    writable->abstractFilePosition = std::make_shared< ADIOS1FilePosition >("/");
+
+    m_fileNames[writable] = name;
+}
+
+void
+ADIOS1IOHandlerImpl::closeFile(Writable* writable,
+                               Parameter< Operation::CLOSE_FILE > const&)
+{
+    auto res = m_fileNames.find(writable);
+    if( res == m_fileNames.end() || !m_files.count(res->second) )
+        throw std::runtime_error("Closing a file that has not been opened is not possible.");
+    std::string name = res->second;
+
+    closeFile(name, m_files[name]);
+    m_files.erase(name);
+
+    /* forget all objects that reside in this file */
+    for( auto it = m_fileNames.begin(); it != m_fileNames.end(); )
+    {
+        if( it->second == name )
+            it = m_fileNames.erase(it);
+        else
+            ++it;
+    }
+}
+
+void
+ADIOS1IOHandlerImpl::advance(Writable*,
+                             Parameter< Operation::ADVANCE > & parameters)
+{
+    /* files are not streams, all data is available right away */
+    *parameters.status = AdvanceStatus::OVER;
+}
+
+void
+ADIOS1IOHandlerImpl::openPath(Writable* writable,
+                              Parameter< Operation::OPEN_PATH > const& parameters)
+{
+    /* Sanitize path */
+    std::string path = parameters.path;
+    if( auxiliary::starts_with(path, "/") )
+        path = auxiliary::replace_first(path, "/", "");
+    if( !auxiliary::ends_with(path, "/") )
+        path += '/';
+
+    std::string file = fileNameOf(writable->parent);
+
+    writable->written = true;
+    writable->abstractFilePosition = std::make_shared< ADIOS1FilePosition >(path);
+
+    m_fileNames[writable] = file;
+}
+
+void
+ADIOS1IOHandlerImpl::openDataset(Writable* writable,
+                                 Parameter< Operation::OPEN_DATASET > & parameters)
+{
+    /* Sanitize name */
+    std::string name = parameters.name;
+    if( auxiliary::starts_with(name, "/") )
+        name = auxiliary::replace_first(name, "/", "");
+    if( auxiliary::ends_with(name, "/") )
+        name = auxiliary::replace_last(name, "/", "");
+
+    File& file = fileOf(writable->parent);
+    std::string varName = bp1_prefix(writable->parent) + name;
+
+    if( file.reader )
+    {
+        ADIOS_VARINFO* info = adios_inq_var(file.reader, varName.c_str());
+        if( !info )
+            throw std::runtime_error("Missing dataset " + varName + ": " + adios_errmsg());
+        std::shared_ptr< ADIOS_VARINFO > owner(info, [](ADIOS_VARINFO* i){ adios_free_varinfo(i); });
+
+        Datatype d = fromBP1DataType(info->type);
+        if( d == Datatype::UCHAR && bp1_marked_dtype(file.reader, varName) == Datatype::BOOL )
+            d = Datatype::BOOL;
+        *parameters.dtype = d;
+        *parameters.extent = Extent(info->dims, info->dims + info->ndim);
+    } else
+    {
+        auto it = file.datasets.find(varName);
+        if( it == file.datasets.end() )
+            throw std::runtime_error("Missing dataset " + varName);
+        *parameters.dtype = it->second.first;
+        *parameters.extent = it->second.second;
+    }
+
+    writable->written = true;
+    writable->abstractFilePosition = std::make_shared< ADIOS1FilePosition >(name);
+
+    m_fileNames[writable] = fileNameOf(writable->parent);
+}
+
+void
+ADIOS1IOHandlerImpl::deleteFile(Writable* writable,
+                                Parameter< Operation::DELETE_FILE > const& parameters)
+{
+    if( m_handler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Deleting a file opened as read only is not possible.");
+
+    if( writable->written )
+    {
+        std::string name = m_handler->directory + parameters.name;
+        if( !auxiliary::ends_with(name, ".bp") )
+            name += ".bp";
+
+        auto it = m_files.find(name);
+        if( it != m_files.end() )
+        {
+            /* pending output is discarded */
+            it->second.chunks.clear();
+            it->second.attributes.clear();
+            closeFile(name, it->second);
+            m_files.erase(it);
+        }
+
+        using namespace boost::filesystem;
+        path file(name);
+        if( exists(file) )
+            remove_all(file);
+
+        writable->written = false;
+        writable->abstractFilePosition.reset();
+
+        m_fileNames.erase(writable);
+    }
+}
+
+void
+ADIOS1IOHandlerImpl::deletePath(Writable*,
+                                Parameter< Operation::DELETE_PATH > const&)
+{
+    throw std::runtime_error("Deleting a path is not possible with the ADIOS1 backend.");
+}
+
+void
+ADIOS1IOHandlerImpl::deleteDataset(Writable*,
+                                   Parameter< Operation::DELETE_DATASET > const&)
+{
+    throw std::runtime_error("Deleting a dataset is not possible with the ADIOS1 backend.");
+}
+
+void
+ADIOS1IOHandlerImpl::deleteAttribute(Writable*,
+                                     Parameter< Operation::DELETE_ATT > const&)
+{
+    throw std::runtime_error("Deleting an attribute is not possible with the ADIOS1 backend.");
+}
+
+void
+ADIOS1IOHandlerImpl::writeDataset(Writable* writable,
+                                  Parameter< Operation::WRITE_DATASET > const& parameters)
+{
+    File& file = fileOf(writable);
+    if( file.reader )
+        throw std::runtime_error("Writing into a file opened as read only is not possible.");
+
+    Chunk c;
+    c.name = concrete_bp1_file_position(writable);
+    c.dtype = parameters.dtype;
+    c.offset = parameters.offset;
+    c.extent = parameters.extent;
+    /* the frontend might release its reference before the file is written */
+    c.data = parameters.data;
+    if( parameters.memoryStride != 1 || !parameters.memoryExtent.empty() )
+    {
+        /* ADIOS1 writes dense buffers only, members of an array of structs or parts of a larger buffer are copied */
+        auto dense = auxiliary::allocatePtr(c.dtype, c.extent);
+        size_t numPoints = 1;
+        for( auto const& dimensionSize : c.extent )
+            numPoints *= dimensionSize;
+        if( !parameters.memoryExtent.empty() )
+            auxiliary::pack(dense.get(), parameters.data.get(), toBytes(c.dtype), c.extent, parameters.memoryOffset, parameters.memoryExtent);
+        else
+            auxiliary::gather(dense.get(), parameters.data.get(), numPoints, toBytes(c.dtype), parameters.memoryStride);
+        std::function< void(void*) > del = dense.get_deleter();
+        c.data = std::shared_ptr< void >(dense.release(), del);
+    }
+    file.chunks.push_back(c);
+}
+
+void
+ADIOS1IOHandlerImpl::writeAttribute(Writable* writable,
+                                    Parameter< Operation::WRITE_ATT > const& parameters)
+{
+    if( m_handler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Writing an attribute in a file opened as read only is not possible.");
+
+    File& file = fileOf(writable);
+    std::string name = bp1_prefix(writable) + parameters.name;
+    Attribute const att(parameters.resource);
+    file.attributes.erase(name);
+    file.attributes.emplace(name, att);
+
+    std::string marker = bp1_dtype_marker(name);
+    file.attributes.erase(marker);
+    if( bp1_needs_dtype_marker(att.dtype) )
+        file.attributes.emplace(marker, Attribute(bp1_dtype_name(att.dtype)));
+}
+
+void
+ADIOS1IOHandlerImpl::writeAttributes(Writable* writable,
+                                     Parameter< Operation::WRITE_ATTS > const& parameters)
+{
+    /* attributes are only collected in memory until the file is written, so there is nothing to share */
+    for( auto const& attribute : parameters.attributes )
+        writeAttribute(writable, attribute);
+}
+
+void
+ADIOS1IOHandlerImpl::readDataset(Writable* writable,
+                                 Parameter< Operation::READ_DATASET > & parameters)
+{
+    if( !parameters.stride.empty() )
+        throw std::runtime_error("Strided reads are not supported by the ADIOS1 backend.");
+    if( parameters.memoryStride != 1 )
+        throw std::runtime_error("Reads into strided memory are not supported by the ADIOS1 backend.");
+    if( parameters.transpose )
+        throw std::runtime_error("Transposed reads are not supported by the ADIOS1 backend.");
+    if( !parameters.regions.empty() || !parameters.points.empty() )
+        throw std::runtime_error("Multi-region and point-selection reads are not supported by the ADIOS1 backend.");
+
+    File& file = fileOf(writable);
+    if( !file.reader )
+        throw std::runtime_error("Reading from a file that has not been written yet is not possible with the ADIOS1 backend.");
+    std::string varName = concrete_bp1_file_position(writable);
+
+    ADIOS_VARINFO* info = adios_inq_var(file.reader, varName.c_str());
+    if( !info )
+        throw std::runtime_error("Internal error: Failed to find ADIOS1 variable " + varName + ": " + adios_errmsg());
+    Datatype stored = fromBP1DataType(info->type);
+    adios_free_varinfo(info);
+
+    ADIOS_SELECTION* selection = adios_selection_boundingbox(static_cast< int >(parameters.offset.size()),
+                                                             parameters.offset.data(),
+                                                             parameters.extent.data());
+    file.selections.push_back(selection);
+
+    ScheduleRead schedule{file.reader, selection, varName, stored, parameters, {}};
+    switchDatasetType(stored, schedule);
+
+    /* keep the target buffer alive until the scheduled read has been performed */
+    std::shared_ptr< void > buffer = parameters.buffer;
+    std::function< void() > convert = schedule.finish;
+    std::function< void() > finish = parameters.finish;
+    PendingGet pending;
+    pending.finish = [buffer, convert, finish]()
+    {
+        if( convert )
+            convert();
+        if( finish )
+            finish();
+    };
+    pending.done = parameters.done;
+    file.gets.push_back(pending);
+}
+
+void
+ADIOS1IOHandlerImpl::readAttribute(Writable* writable,
+                                   Parameter< Operation::READ_ATT > & parameters)
+{
+    File& file = fileOf(writable);
+    std::string name = bp1_prefix(writable) + parameters.name;
+
+    Attribute a = file.reader ? readAttributeValue(file.reader, name) : Attribute(std::string());
+    if( !file.reader )
+    {
+        auto it = file.attributes.find(name);
+        if( it == file.attributes.end() )
+            throw no_such_attribute_error(name);
+        a = it->second;
+    }
+
+    *parameters.dtype = a.dtype;
+    *parameters.resource = a.getResource();
+}
+
+void
+ADIOS1IOHandlerImpl::readAttributes(Writable* writable,
+                                    Parameter< Operation::READ_ATTS > & parameters)
+{
+    File& file = fileOf(writable);
+    std::string prefix = bp1_prefix(writable);
+
+    for( auto const& att : entriesBelow(attributeNames(file), prefix) )
+    {
+        if( auxiliary::contains(att, "/") )
+            continue;
+        if( !file.reader )
+        {
+            parameters.attributes->emplace(att, file.attributes.at(prefix + att));
+            continue;
+        }
+        try
+        {
+            parameters.attributes->emplace(att, readAttributeValue(file.reader, prefix + att));
+        } catch( unsupported_data_error const& e )
+        {
+            parameters.skipped->emplace(att, e.what());
+        }
+    }
+}
+
+void
+ADIOS1IOHandlerImpl::listPaths(Writable* writable,
+                               Parameter< Operation::LIST_PATHS > & parameters)
+{
+    File& file = fileOf(writable);
+    std::string prefix = bp1_prefix(writable);
+
+    std::set< std::string > datasets;
+    std::set< std::string > paths;
+    for( auto const& var : entriesBelow(variableNames(file), prefix) )
+    {
+        auto pos = var.find('/');
+        if( pos == std::string::npos )
+            datasets.insert(var);
+        else
+            paths.insert(var.substr(0, pos));
+    }
+    for( auto const& att : entriesBelow(attributeNames(file), prefix) )
+    {
+        auto pos = att.find('/');
+        if( pos != std::string::npos )
+            paths.insert(att.substr(0, pos));
+    }
+
+    /* attributes of datasets look like members of a path */
+    for( auto const& path : paths )
+        if( !datasets.count(path) )
+            parameters.paths->push_back(path);
+}
+
+void
+ADIOS1IOHandlerImpl::listDatasets(Writable* writable,
+                                  Parameter< Operation::LIST_DATASETS > & parameters)
+{
+    File& file = fileOf(writable);
+    std::string prefix = bp1_prefix(writable);
+
+    for( auto const& var : entriesBelow(variableNames(file), prefix) )
+        if( !auxiliary::contains(var, "/") )
+            parameters.datasets->push_back(var);
+}
+
+void
+ADIOS1IOHandlerImpl::listAttributes(Writable* writable,
+                                    Parameter< Operation::LIST_ATTS > & parameters)
+{
+    File& file = fileOf(writable);
+    std::string prefix = bp1_prefix(writable);
+
+    for( auto const& att : entriesBelow(attributeNames(file), prefix) )
+        if( !auxiliary::contains(att, "/") )
+            parameters.attributes->push_back(att);
 }
-#endif
 
-#if openPMD_HAVE_ADIOS1 && !openPMD_HAVE_MPI
 ADIOS1IOHandler::ADIOS1IOHandler(std::string const& path, AccessType at)
+#if openPMD_HAVE_MPI
+        : AbstractIOHandler(path, at, MPI_COMM_SELF),
+#else
         : AbstractIOHandler(path, at),
+#endif
           m_impl{new ADIOS1IOHandlerImpl(this)}
 { }
 
@@ -51,6 +1343,7 @@ ADIOS1IOHandler::~ADIOS1IOHandler()
 std::future< void >
 ADIOS1IOHandler::flush()
 {
+    std::lock_guard< std::recursive_mutex > lock(m_workMutex);
     return m_impl->flush();
 }
 #else
@@ -58,10 +1351,10 @@ ADIOS1IOHandler::ADIOS1IOHandler(std::string const& path, AccessType at)
 #if openPMD_HAVE_MPI
         : AbstractIOHandler(path, at, MPI_COMM_NULL)
 #else
-: AbstractIOHandler(path, at)
+        : AbstractIOHandler(path, at)
 #endif
 {
-    throw std::runtime_error("openPMD-api built without parallel ADIOS1 support");
+    throw std::runtime_error("openPMD-api built without ADIOS1 support");
 }
 
 ADIOS1IOHandler::~ADIOS1IOHandler()
@@ -20,31 +20,1329 @@
  */
 #include "openPMD/IO/ADIOS/ADIOS2IOHandler.hpp"
 
+#if openPMD_HAVE_ADIOS2
+#   include "openPMD/auxiliary/Memory.hpp"
+#   include "openPMD/auxiliary/StringManip.hpp"
+#   include "openPMD/backend/Attributable.hpp"
+#   include "openPMD/IO/ADIOS/ADIOS2FilePosition.hpp"
+#   include "openPMD/IO/ADIOS/ADIOSAuxiliary.hpp"
+#   include <boost/filesystem.hpp>
+#   include <array>
+#   include <exception>
+#   include <iostream>
+#   include <set>
+#   include <sstream>
+#   include <stack>
+#   include <stdexcept>
+#   include <vector>
+#endif
+
 
 namespace openPMD
 {
 #if openPMD_HAVE_ADIOS2
-ADIOS2IOHandler::ADIOS2IOHandler(std::string const& path, AccessType at)
-        : AbstractIOHandler(path, at),
-          m_impl{new ADIOS2IOHandlerImpl(this)}
+std::string
+concrete_bp2_file_position(Writable* w)
+{
+    std::stack< Writable* > hierarchy;
+    if( !w->abstractFilePosition )
+        w = w->parent;
+    while( w )
+    {
+        hierarchy.push(w);
+        w = w->parent;
+    }
+
+    std::string pos;
+    while( !hierarchy.empty() )
+    {
+        /* objects that have not been written yet (e.g. the Series before its file is created) have no position */
+        auto position = std::dynamic_pointer_cast< ADIOS2FilePosition >(hierarchy.top()->abstractFilePosition);
+        if( position )
+            pos += position->location;
+        hierarchy.pop();
+    }
+
+    return auxiliary::replace_all(pos, "//", "/");
+}
+
+namespace
+{
+/** Full name of all variables and attributes residing directly inside an object, always ending in '/'. */
+std::string
+bp2_prefix(Writable* w)
+{
+    std::string prefix = concrete_bp2_file_position(w);
+    if( !auxiliary::ends_with(prefix, "/") )
+        prefix += '/';
+    return prefix;
+}
+
+std::string
+bp2_attribute_name(Writable* w, std::string const& name)
+{
+    return bp2_prefix(w) + name;
+}
+
+/* ADIOS2 has neither a boolean type nor fixed-size arrays and does not tell a vector of one element from a single value.
+ * The openPMD datatype of such attributes and datasets is stored by name in an additional string attribute.
+ * It lives outside of "/" and is thus never listed as part of the openPMD hierarchy. */
+std::string
+bp2_dtype_marker(std::string const& fullName)
+{
+    return "__openPMD_internal" + fullName + "/dtype";
+}
+
+std::string
+bp2_dtype_name(Datatype dtype)
+{
+    std::ostringstream name;
+    name << dtype;
+    return name.str();
+}
+
+Datatype
+bp2_dtype(std::string const& name)
+{
+    for( int i = static_cast< int >(Datatype::CHAR); i <= static_cast< int >(Datatype::BOOL); ++i )
+        if( bp2_dtype_name(static_cast< Datatype >(i)) == name )
+            return static_cast< Datatype >(i);
+    return Datatype::UNDEFINED;
+}
+
+/** Whether the datatype of an attribute can not be told from its ADIOS2 type alone. */
+bool
+bp2_needs_dtype_marker(Datatype dtype)
+{
+    return dtype == Datatype::BOOL || dtype == Datatype::ARR_DBL_7
+           || (dtype >= Datatype::VEC_CHAR && dtype <= Datatype::VEC_STRING);
+}
+
+/** Datatype stored in the marker of an attribute or dataset, UNDEFINED if there is none. */
+Datatype
+bp2_marked_dtype(adios2::IO& io, std::string const& fullName)
+{
+    adios2::Attribute< std::string > marker = io.InquireAttribute< std::string >(bp2_dtype_marker(fullName));
+    if( !marker )
+        return Datatype::UNDEFINED;
+    return bp2_dtype(marker.Data().front());
+}
+
+/** IO object of a file, declared on first use and re-used whenever the file is opened again. */
+adios2::IO
+bp2_io(adios2::ADIOS& adios, std::string const& name)
+{
+    try
+    {
+        return adios.AtIO(name);
+    } catch( std::invalid_argument const& )
+    {
+        return adios.DeclareIO(name);
+    }
+}
+
+adios2::Dims
+bp2_dims(std::vector< std::uint64_t > const& v)
+{
+    return adios2::Dims(v.begin(), v.end());
+}
+
+/** Invoke action.template call< T >() for every type a dataset can be stored as.
+ */
+template< typename Action >
+void
+forEachDatasetType(Action& action)
+{
+    action.template call< char >();
+    action.template call< unsigned char >();
+    action.template call< int16_t >();
+    action.template call< int32_t >();
+    action.template call< int64_t >();
+    action.template call< uint16_t >();
+    action.template call< uint32_t >();
+    action.template call< uint64_t >();
+    action.template call< float >();
+    action.template call< double >();
+    action.template call< long double >();
+}
+
+/** Invoke action.template call< T >() for every type an attribute can be stored as.
+ */
+template< typename Action >
+void
+forEachAttributeType(Action& action)
+{
+    forEachDatasetType(action);
+    action.template call< std::string >();
+}
+
+struct DefineVariable
+{
+    adios2::IO& io;
+    std::string const& name;
+    adios2::Dims const& shape;
+
+    template< typename T >
+    void call()
+    {
+        io.DefineVariable< T >(name, shape, adios2::Dims(shape.size(), 0), shape);
+    }
+};
+
+struct FindVariable
+{
+    adios2::IO& io;
+    std::string const& name;
+    Datatype dtype;
+    adios2::Dims shape;
+
+    template< typename T >
+    void call()
+    {
+        if( dtype != Datatype::UNDEFINED )
+            return;
+        adios2::Variable< T > var = io.InquireVariable< T >(name);
+        if( var )
+        {
+            dtype = determineDatatype< T >();
+            shape = var.Shape();
+        }
+    }
+};
+
+struct ExtendVariable
+{
+    adios2::IO& io;
+    std::string const& name;
+    adios2::Dims const& shape;
+
+    template< typename T >
+    void call()
+    {
+        adios2::Variable< T > var = io.InquireVariable< T >(name);
+        if( !var )
+            throw std::runtime_error("Internal error: Failed to find ADIOS2 variable " + name + " during dataset extension");
+        var.SetShape(shape);
+    }
+};
+
+struct PutVariable
+{
+    adios2::IO& io;
+    adios2::Engine& engine;
+    std::string const& name;
+    Parameter< Operation::WRITE_DATASET > const& parameters;
+
+    template< typename T >
+    void call()
+    {
+        adios2::Variable< T > var = io.InquireVariable< T >(name);
+        if( !var )
+            throw std::runtime_error("Internal error: Failed to find ADIOS2 variable " + name + " during dataset write");
+        var.SetSelection({bp2_dims(parameters.offset), bp2_dims(parameters.extent)});
+        engine.Put(var, static_cast< T const* >(parameters.data.get()), adios2::Mode::Deferred);
+    }
+};
+
+struct GetVariable
+{
+    adios2::IO& io;
+    adios2::Engine& engine;
+    std::string const& name;
+    Parameter< Operation::READ_DATASET > const& parameters;
+    std::function< void() > finish;
+
+    template< typename S >
+    void call()
+    {
+        adios2::Variable< S > var = io.InquireVariable< S >(name);
+        if( !var )
+            throw std::runtime_error("Internal error: Failed to find ADIOS2 variable " + name + " during dataset read");
+        var.SetSelection({bp2_dims(parameters.offset), bp2_dims(parameters.extent)});
+
+        Datatype requested = parameters.dtype == Datatype::BOOL ? Datatype::UCHAR : parameters.dtype;
+        if( requested == determineDatatype< S >() && parameters.scale == 1. )
+        {
+            engine.Get(var, static_cast< S* >(parameters.data), adios2::Mode::Deferred);
+            return;
+        }
+
+        /* ADIOS2 does not convert, stage the data in its stored type */
+        std::size_t numPoints = 1;
+        for( auto const& e : parameters.extent )
+            numPoints *= e;
+        std::shared_ptr< S > staged(new S[numPoints], [](S* p){ delete[] p; });
+        engine.Get(var, staged.get(), adios2::Mode::Deferred);
+
+        ConvertData< S > convert{staged, parameters.data, numPoints, parameters.scale, {}};
+        switchDatasetType(parameters.dtype, convert);
+        finish = convert.finish;
+    }
+};
+
+/** Wrap a single value into a vector of one element, if it is of type T. */
+struct WrapInVector
+{
+    Attribute const& value;
+    bool found;
+    Attribute::resource vector;
+
+    template< typename T >
+    void call()
+    {
+        if( found || value.dtype != determineDatatype< T >() )
+            return;
+        found = true;
+        vector = std::vector< T >{value.get< T >()};
+    }
+};
+
+struct ReadAttribute
+{
+    adios2::IO& io;
+    std::string const& name;
+    bool found;
+    Attribute::resource value;
+
+    template< typename T >
+    void call()
+    {
+        if( found )
+            return;
+        adios2::Attribute< T > att = io.InquireAttribute< T >(name);
+        if( !att )
+            return;
+        found = true;
+        std::vector< T > data = att.Data();
+        if( att.IsValue() )
+            value = data.front();
+        else
+            value = data;
+    }
+};
+
+template< typename T >
+void
+defineAttribute(adios2::IO& io, std::string const& name, T const& value)
+{
+    io.RemoveAttribute(name);
+    io.DefineAttribute< T >(name, value);
+}
+
+template< typename T >
+void
+defineAttribute(adios2::IO& io, std::string const& name, std::vector< T > const& value)
+{
+    io.RemoveAttribute(name);
+    io.DefineAttribute< T >(name, value.data(), value.size());
+}
+
+/** Decode the attribute with the given full name.
+ *
+ * @throws  no_such_attribute_error If there is no such attribute.
+ * @throws  unsupported_data_error  If the attribute type is not part of the openPMD standard.
+ */
+Attribute
+readAttributeValue(adios2::IO& io, std::string const& fullName)
+{
+    ReadAttribute read{io, fullName, false, {}};
+    forEachAttributeType(read);
+    if( !read.found )
+    {
+        std::string type = io.AttributeType(fullName);
+        if( type.empty() )
+            throw no_such_attribute_error(fullName);
+        throw unsupported_data_error("Unsupported attribute type " + type);
+    }
+
+    /* restore the datatype the attribute has been written with */
+    Attribute a(read.value);
+    Datatype const dtype = bp2_marked_dtype(io, fullName);
+    if( dtype == Datatype::UNDEFINED || dtype == a.dtype )
+        return a;
+    if( dtype == Datatype::BOOL && a.dtype == Datatype::UCHAR )
+        return Attribute(static_cast< bool >(a.get< unsigned char >()));
+    if( dtype == Datatype::ARR_DBL_7 && a.dtype == Datatype::VEC_DOUBLE && a.get< std::vector< double > >().size() == 7 )
+    {
+        std::vector< double > v = a.get< std::vector< double > >();
+        std::array< double, 7 > arr;
+        std::copy(v.begin(), v.end(), arr.begin());
+        return Attribute(arr);
+    }
+    WrapInVector wrap{a, false, {}};
+    forEachAttributeType(wrap);
+    if( wrap.found && Attribute(wrap.vector).dtype == dtype )
+        return Attribute(wrap.vector);
+    throw unsupported_data_error("Attribute " + fullName + " of type " + io.AttributeType(fullName)
+                                 + " can not be read as " + bp2_dtype_name(dtype));
+}
+
+/** Relative names of all entries of a variable or attribute map residing (possibly indirectly) below prefix. */
+std::vector< std::string >
+entriesBelow(std::map< std::string, adios2::Params > const& available, std::string const& prefix)
+{
+    std::vector< std::string > ret;
+    for( auto const& entry : available )
+        if( auxiliary::starts_with(entry.first, prefix) )
+            ret.push_back(entry.first.substr(prefix.size()));
+    return ret;
+}
+} // namespace
+
+namespace
+{
+std::string
+bp2_file_suffix(std::string const& engineType)
+{
+    if( engineType == "SST" )
+        return ".sst";
+    if( engineType == "SSC" )
+        return ".ssc";
+    return ".bp";
+}
+} // namespace
+
+ADIOS2IOHandlerImpl::ADIOS2IOHandlerImpl(AbstractIOHandler* handler, std::string engineType)
+        : m_ADIOS{},
+          m_engineType{std::move(engineType)},
+          m_fileSuffix{bp2_file_suffix(m_engineType)},
+          m_streaming{m_engineType == "SST" || m_engineType == "SSC"},
+          m_handler{handler}
 { }
 
-ADIOS2IOHandler::~ADIOS2IOHandler()
+#if openPMD_HAVE_MPI
+ADIOS2IOHandlerImpl::ADIOS2IOHandlerImpl(AbstractIOHandler* handler, MPI_Comm comm, std::string engineType)
+        : m_ADIOS{comm},
+          m_engineType{std::move(engineType)},
+          m_fileSuffix{bp2_file_suffix(m_engineType)},
+          m_streaming{m_engineType == "SST" || m_engineType == "SSC"},
+          m_handler{handler}
 { }
+#endif
+
+ADIOS2IOHandlerImpl::~ADIOS2IOHandlerImpl()
+{
+    for( auto& f : m_files )
+    {
+        try
+        {
+            closeEngine(f.second);
+        } catch( std::exception const& e )
+        {
+            std::cerr << "Internal error: Failed to close ADIOS2 file " << f.first << ": " << e.what() << '\n';
+        }
+    }
+}
 
 std::future< void >
-ADIOS2IOHandler::flush()
+ADIOS2IOHandlerImpl::flush()
 {
-    return m_impl->flush();
+    process((*m_handler).m_work.collect());
+    for( auto& f : m_files )
+    {
+        perform(f.second);
+        if( m_streaming && !f.second.reading && f.second.stepOpen )
+        {
+            f.second.engine.EndStep();
+            f.second.stepOpen = false;
+        }
+    }
+    return std::future< void >();
 }
 
-#endif
+void
+ADIOS2IOHandlerImpl::process(std::queue< IOTask >& work)
+{
+    while( !work.empty() )
+    {
+        IOTask& i = work.front();
+        auto measurement = m_handler->statistics.measure(i, concrete_bp2_file_position);
+        try
+        {
+            switch( i.operation )
+            {
+                using O = Operation;
+                case O::CREATE_FILE:
+                    createFile(i.writable, i.getParameter< O::CREATE_FILE >());
+                    break;
+                case O::CREATE_PATH:
+                    createPath(i.writable, i.getParameter< O::CREATE_PATH >());
+                    break;
+                case O::CREATE_DATASET:
+                    createDataset(i.writable, i.getParameter< O::CREATE_DATASET >());
+                    break;
+                case O::EXTEND_DATASET:
+                    extendDataset(i.writable, i.getParameter< O::EXTEND_DATASET >());
+                    break;
+                case O::OPEN_FILE:
+                    openFile(i.writable, i.getParameter< O::OPEN_FILE >());
+                    break;
+                case O::CLOSE_FILE:
+                    closeFile(i.writable, i.getParameter< O::CLOSE_FILE >());
+                    break;
+                case O::ADVANCE:
+                    advance(i.writable, i.getParameter< O::ADVANCE >());
+                    break;
+                case O::OPEN_PATH:
+                    openPath(i.writable, i.getParameter< O::OPEN_PATH >());
+                    break;
+                case O::OPEN_DATASET:
+                    openDataset(i.writable, i.getParameter< O::OPEN_DATASET >());
+                    break;
+                case O::DELETE_FILE:
+                    deleteFile(i.writable, i.getParameter< O::DELETE_FILE >());
+                    break;
+                case O::DELETE_PATH:
+                    deletePath(i.writable, i.getParameter< O::DELETE_PATH >());
+                    break;
+                case O::DELETE_DATASET:
+                    deleteDataset(i.writable, i.getParameter< O::DELETE_DATASET >());
+                    break;
+                case O::DELETE_ATT:
+                    deleteAttribute(i.writable, i.getParameter< O::DELETE_ATT >());
+                    break;
+                case O::WRITE_DATASET:
+                    writeDataset(i.writable, i.getParameter< O::WRITE_DATASET >());
+                    break;
+                case O::WRITE_ATT:
+                    writeAttribute(i.writable, i.getParameter< O::WRITE_ATT >());
+                    break;
+                case O::WRITE_ATTS:
+                    writeAttributes(i.writable, i.getParameter< O::WRITE_ATTS >());
+                    break;
+                case O::READ_DATASET:
+                {
+                    /* the promise is fulfilled by perform() once the deferred Get has completed */
+                    auto& parameter = i.getParameter< O::READ_DATASET >();
+                    try
+                    {
+                        readDataset(i.writable, parameter);
+                    } catch( ... )
+                    {
+                        if( parameter.done )
+                            parameter.done->set_exception(std::current_exception());
+                        throw;
+                    }
+                    break;
+                }
+                case O::MAP_DATASET:
+                    /* the view stays empty, the frontend falls back to READ_DATASET */
+                    break;
+                case O::READ_ATT:
+                    readAttribute(i.writable, i.getParameter< O::READ_ATT >());
+                    break;
+                case O::READ_ATTS:
+                    readAttributes(i.writable, i.getParameter< O::READ_ATTS >());
+                    break;
+                case O::LIST_PATHS:
+                    listPaths(i.writable, i.getParameter< O::LIST_PATHS >());
+                    break;
+                case O::LIST_DATASETS:
+                    listDatasets(i.writable, i.getParameter< O::LIST_DATASETS >());
+                    break;
+                case O::LIST_ATTS:
+                    listAttributes(i.writable, i.getParameter< O::LIST_ATTS >());
+                    break;
+            }
+        } catch (unsupported_data_error& e)
+        {
+            work.pop();
+            throw e;
+        }
+        work.pop();
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::perform(File& file)
+{
+    if( !file.puts.empty() )
+    {
+        file.engine.PerformPuts();
+        file.puts.clear();
+    }
+
+    if( !file.gets.empty() )
+    {
+        std::vector< PendingGet > gets;
+        std::swap(gets, file.gets);
+        try
+        {
+            file.engine.PerformGets();
+            for( auto& g : gets )
+                if( g.finish )
+                    g.finish();
+        } catch( ... )
+        {
+            for( auto& g : gets )
+                if( g.done )
+                    g.done->set_exception(std::current_exception());
+            throw;
+        }
+        for( auto& g : gets )
+            if( g.done )
+                g.done->set_value();
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::beginStep(File& file)
+{
+    if( m_streaming && !file.reading && !file.stepOpen )
+    {
+        file.engine.BeginStep();
+        file.stepOpen = true;
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::closeEngine(File& file)
+{
+    perform(file);
+    if( file.stepOpen )
+    {
+        file.engine.EndStep();
+        file.stepOpen = false;
+    }
+    file.engine.Close();
+}
+
+void
+ADIOS2IOHandlerImpl::releaseFile(std::string const& name)
+{
+    auto it = m_files.find(name);
+    if( it == m_files.end() )
+        return;
+
+    File& file = it->second;
+    closeEngine(file);
+    /* the IO is kept for opening the file again, but must not carry over the variables and attributes */
+    file.io.RemoveAllVariables();
+    file.io.RemoveAllAttributes();
+    m_files.erase(it);
+
+    /* forget all objects that reside in this file */
+    for( auto f = m_fileNames.begin(); f != m_fileNames.end(); )
+    {
+        if( f->second == name )
+            f = m_fileNames.erase(f);
+        else
+            ++f;
+    }
+}
+
+std::string const&
+ADIOS2IOHandlerImpl::fileNameOf(Writable* writable)
+{
+    for( Writable* w = writable; w; w = w->parent )
+    {
+        auto it = m_fileNames.find(w);
+        if( it != m_fileNames.end() )
+            return it->second;
+    }
+    throw std::runtime_error("Internal error: Object does not reside in an open ADIOS2 file");
+}
+
+ADIOS2IOHandlerImpl::File&
+ADIOS2IOHandlerImpl::fileOf(Writable* writable)
+{
+    auto it = m_files.find(fileNameOf(writable));
+    if( it == m_files.end() )
+        throw std::runtime_error("Internal error: Object does not reside in an open ADIOS2 file");
+    return it->second;
+}
+
+void
+ADIOS2IOHandlerImpl::createFile(Writable* writable,
+                                Parameter< Operation::CREATE_FILE > const& parameters)
+{
+    if( !writable->written )
+    {
+        using namespace boost::filesystem;
+        path dir(m_handler->directory);
+        if( !exists(dir) )
+            create_directories(dir);
+
+        std::string name = m_handler->directory + parameters.name;
+        if( !auxiliary::ends_with(name, m_fileSuffix) )
+            name += m_fileSuffix;
+
+        File file;
+        file.io = bp2_io(m_ADIOS, name);
+        file.io.SetEngine(m_engineType);
+        file.engine = file.io.Open(name, adios2::Mode::Write);
+        file.reading = false;
+        file.stepOpen = false;
+        m_files[name] = file;
+
+        writable->written = true;
+        writable->abstractFilePosition = std::make_shared< ADIOS2FilePosition >("/");
+
+        m_fileNames[writable] = name;
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::createPath(Writable* writable,
+                                Parameter< Operation::CREATE_PATH > const& parameters)
+{
+    if( !writable->written )
+    {
+        /* Sanitize path */
+        std::string path = parameters.path;
+        if( auxiliary::starts_with(path, "/") )
+            path = auxiliary::replace_first(path, "/", "");
+        if( !auxiliary::ends_with(path, "/") )
+            path += '/';
+
+        /* groups are implicit in ADIOS2, they exist as soon as anything is written below them */
+        Writable* position;
+        if( writable->parent )
+            position = writable->parent;
+        else
+            position = writable; /* root does not have a parent but might still have to be written */
+        std::string file = fileNameOf(position);
+
+        writable->written = true;
+        writable->abstractFilePosition = std::make_shared< ADIOS2FilePosition >(path);
 
-#if openPMD_HAVE_ADIOS2 && !openPMD_HAVE_MPI
-ADIOS2IOHandler::ADIOS2IOHandler(std::string const& path, AccessType at)
+        m_fileNames[writable] = file;
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::addOperation(adios2::IO& io, std::string const& varName, Datatype dtype, std::string const& compression)
+{
+    std::vector< std::string > args = auxiliary::split(compression, ":");
+    std::string const& format = args[0];
+    if( (format != "zfp" && format != "sz") || args.size() != 3 )
+    {
+        std::cerr << "Compression format " << format << " not yet implemented in ADIOS2 backend. Ignoring compression for "
+                  << varName << std::endl;
+        return;
+    }
+    if( dtype != Datatype::FLOAT && dtype != Datatype::DOUBLE )
+    {
+        std::cerr << "Lossy compression format " << format
+                  << " only applies to floating point datasets. Ignoring compression for "
+                  << varName << std::endl;
+        return;
+    }
+
+    /* map the modes of Dataset::setCompression to the parameters of the ADIOS2 operators */
+    std::string const& mode = args[1];
+    std::string const& parameter = args[2];
+    adios2::Params params;
+    if( format == "zfp" )
+        params[mode] = parameter;
+    else if( mode == "abs" )
+        params["accuracy"] = parameter;
+    else if( mode == "rel" )
+    {
+        params["mode"] = "REL";
+        params["rel"] = parameter;
+    } else
+    {
+        params["mode"] = "PW_REL";
+        params["pw"] = parameter;
+    }
+
+    try
+    {
+        adios2::Operator op = m_ADIOS.InquireOperator(format);
+        if( !op )
+            op = m_ADIOS.DefineOperator(format, format);
+        if( dtype == Datatype::FLOAT )
+            io.InquireVariable< float >(varName).AddOperation(op, params);
+        else
+            io.InquireVariable< double >(varName).AddOperation(op, params);
+    } catch( std::invalid_argument const& e )
+    {
+        std::cerr << "ADIOS2 operator for compression format " << format << " not available ("
+                  << e.what() << "). Data will not be compressed!" << std::endl;
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::createDataset(Writable* writable,
+                                   Parameter< Operation::CREATE_DATASET > const& parameters)
+{
+    if( !writable->written )
+    {
+        std::string name = parameters.name;
+        if( auxiliary::starts_with(name, "/") )
+            name = auxiliary::replace_first(name, "/", "");
+        if( auxiliary::ends_with(name, "/") )
+            name = auxiliary::replace_last(name, "/", "");
+
+        File& file = fileOf(writable);
+        std::string varName = bp2_prefix(writable) + name;
+
+        adios2::Dims shape = bp2_dims(parameters.extent);
+        DefineVariable define{file.io, varName, shape};
+        switchDatasetType(parameters.dtype, define);
+        if( parameters.dtype == Datatype::BOOL )
+            defineAttribute(file.io, bp2_dtype_marker(varName), bp2_dtype_name(Datatype::BOOL));
+
+        if( !parameters.compression.empty() )
+            addOperation(file.io, varName, parameters.dtype, parameters.compression);
+        if( !parameters.transform.empty() )
+            std::cerr << "Custom transform not yet implemented in ADIOS2 backend." << std::endl;
+
+        writable->written = true;
+        writable->abstractFilePosition = std::make_shared< ADIOS2FilePosition >(name);
+
+        m_fileNames[writable] = fileNameOf(writable->parent ? writable->parent : writable);
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::extendDataset(Writable* writable,
+                                   Parameter< Operation::EXTEND_DATASET > const& parameters)
+{
+    if( !writable->written )
+        throw std::runtime_error("Extending an unwritten Dataset is not possible.");
+
+    File& file = fileOf(writable);
+    std::string varName = concrete_bp2_file_position(writable);
+
+    FindVariable find{file.io, varName, Datatype::UNDEFINED, {}};
+    forEachDatasetType(find);
+    if( find.dtype == Datatype::UNDEFINED )
+        throw std::runtime_error("Internal error: Failed to find ADIOS2 variable " + varName + " during dataset extension");
+
+    adios2::Dims shape = bp2_dims(parameters.extent);
+    ExtendVariable extend{file.io, varName, shape};
+    switchDatasetType(find.dtype, extend);
+}
+
+void
+ADIOS2IOHandlerImpl::openFile(Writable* writable,
+                              Parameter< Operation::OPEN_FILE > const& parameters)
+{
+    using namespace boost::filesystem;
+    path dir(m_handler->directory);
+    if( !exists(dir) )
+        throw no_such_file_error("Supplied directory is not valid: " + m_handler->directory);
+
+    std::string name = m_handler->directory + parameters.name;
+    if( !auxiliary::ends_with(name, m_fileSuffix) )
+        name += m_fileSuffix;
+
+    /* files created by this handler stay open until explicitly closed */
+    if( !m_files.count(name) )
+    {
+        /* streams are only connected on opening, possibly waiting for the writer */
+        if( !m_streaming && !exists(path(name)) )
+            throw no_such_file_error("Failed to open ADIOS2 file " + name);
+
+        AccessType at = m_handler->accessType;
+        if( at != AccessType::READ_ONLY )
+            throw std::runtime_error("Modifying an existing file is not possible with the ADIOS2 backend: " + name);
+
+        File file;
+        file.io = bp2_io(m_ADIOS, name);
+        file.io.SetEngine(m_engineType);
+        file.engine = file.io.Open(name, adios2::Mode::Read);
+        file.reading = true;
+        file.stepOpen = false;
+        if( m_streaming )
+        {
+            if( file.engine.BeginStep(adios2::StepMode::Read, -1.f) != adios2::StepStatus::OK )
+                throw no_such_file_error("Stream ended before its first step: " + name);
+            file.stepOpen = true;
+        }
+        m_files[name] = file;
+    }
+
+    writable->written = true;
+    writable->abstractFilePosition = std::make_shared< ADIOS2FilePosition >("/");
+
+    m_fileNames[writable] = name;
+}
+
+void
+ADIOS2IOHandlerImpl::closeFile(Writable* writable,
+                               Parameter< Operation::CLOSE_FILE > const&)
+{
+    std::string name;
+    for( Writable* w = writable; w && name.empty(); w = w->parent )
+    {
+        auto res = m_fileNames.find(w);
+        if( res != m_fileNames.end() )
+            name = res->second;
+    }
+    if( name.empty() || !m_files.count(name) )
+        throw std::runtime_error("Closing a file that has not been opened is not possible.");
+
+    /* the engine writes (or releases) the file on closing, not only when the handler is destroyed */
+    releaseFile(name);
+}
+
+void
+ADIOS2IOHandlerImpl::advance(Writable* writable,
+                             Parameter< Operation::ADVANCE > & parameters)
+{
+    if( !m_streaming )
+    {
+        /* all steps of a file are accessible at once */
+        *parameters.status = AdvanceStatus::OVER;
+        return;
+    }
+
+    File& file = fileOf(writable);
+    perform(file);
+    if( file.stepOpen )
+    {
+        file.engine.EndStep();
+        file.stepOpen = false;
+    }
+
+    if( file.reading )
+    {
+        /* blocks until the writer has finished its next step or closed the stream */
+        if( file.engine.BeginStep(adios2::StepMode::Read, -1.f) == adios2::StepStatus::OK )
+        {
+            file.stepOpen = true;
+            *parameters.status = AdvanceStatus::OK;
+        } else
+            *parameters.status = AdvanceStatus::OVER;
+    } else
+        *parameters.status = AdvanceStatus::OK;
+}
+
+void
+ADIOS2IOHandlerImpl::openPath(Writable* writable,
+                              Parameter< Operation::OPEN_PATH > const& parameters)
+{
+    /* Sanitize path */
+    std::string path = parameters.path;
+    if( auxiliary::starts_with(path, "/") )
+        path = auxiliary::replace_first(path, "/", "");
+    if( !auxiliary::ends_with(path, "/") )
+        path += '/';
+
+    std::string file = fileNameOf(writable->parent);
+
+    writable->written = true;
+    writable->abstractFilePosition = std::make_shared< ADIOS2FilePosition >(path);
+
+    m_fileNames[writable] = file;
+}
+
+void
+ADIOS2IOHandlerImpl::openDataset(Writable* writable,
+                                 Parameter< Operation::OPEN_DATASET > & parameters)
+{
+    /* Sanitize name */
+    std::string name = parameters.name;
+    if( auxiliary::starts_with(name, "/") )
+        name = auxiliary::replace_first(name, "/", "");
+    if( auxiliary::ends_with(name, "/") )
+        name = auxiliary::replace_last(name, "/", "");
+
+    File& file = fileOf(writable->parent);
+    std::string varName = bp2_prefix(writable->parent) + name;
+
+    FindVariable find{file.io, varName, Datatype::UNDEFINED, {}};
+    forEachDatasetType(find);
+    if( find.dtype == Datatype::UNDEFINED )
+        throw std::runtime_error("Unknown dataset type or missing dataset " + varName);
+    if( find.dtype == Datatype::UCHAR && bp2_marked_dtype(file.io, varName) == Datatype::BOOL )
+        find.dtype = Datatype::BOOL;
+
+    *parameters.dtype = find.dtype;
+    *parameters.extent = Extent(find.shape.begin(), find.shape.end());
+
+    writable->written = true;
+    writable->abstractFilePosition = std::make_shared< ADIOS2FilePosition >(name);
+
+    m_fileNames[writable] = fileNameOf(writable->parent);
+}
+
+void
+ADIOS2IOHandlerImpl::deleteFile(Writable* writable,
+                                Parameter< Operation::DELETE_FILE > const& parameters)
+{
+    if( m_handler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Deleting a file opened as read only is not possible.");
+
+    if( writable->written )
+    {
+        std::string name = m_handler->directory + parameters.name;
+        if( !auxiliary::ends_with(name, m_fileSuffix) )
+            name += m_fileSuffix;
+
+        releaseFile(name);
+
+        using namespace boost::filesystem;
+        path file(name);
+        if( !exists(file) )
+            throw std::runtime_error("File does not exist: " + name);
+
+        /* BP files may be directories */
+        remove_all(file);
+
+        writable->written = false;
+        writable->abstractFilePosition.reset();
+
+        m_fileNames.erase(writable);
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::deletePath(Writable* writable,
+                                Parameter< Operation::DELETE_PATH > const&)
+{
+    if( m_handler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Deleting a path in a file opened as read only is not possible.");
+
+    if( writable->written )
+    {
+        File& file = fileOf(writable);
+        std::string prefix = bp2_prefix(writable);
+
+        for( auto const& var : entriesBelow(file.io.AvailableVariables(), prefix) )
+            file.io.RemoveVariable(prefix + var);
+        for( auto const& att : entriesBelow(file.io.AvailableAttributes(), prefix) )
+            file.io.RemoveAttribute(prefix + att);
+
+        writable->written = false;
+        writable->abstractFilePosition.reset();
+
+        m_fileNames.erase(writable);
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::deleteDataset(Writable* writable,
+                                   Parameter< Operation::DELETE_DATASET > const&)
+{
+    if( m_handler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Deleting a path in a file opened as read only is not possible.");
+
+    if( writable->written )
+    {
+        File& file = fileOf(writable);
+        std::string varName = concrete_bp2_file_position(writable);
+        file.io.RemoveVariable(varName);
+        file.io.RemoveAttribute(bp2_dtype_marker(varName));
+
+        std::string prefix = varName + '/';
+        for( auto const& att : entriesBelow(file.io.AvailableAttributes(), prefix) )
+            file.io.RemoveAttribute(prefix + att);
+
+        writable->written = false;
+        writable->abstractFilePosition.reset();
+
+        m_fileNames.erase(writable);
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::deleteAttribute(Writable* writable,
+                                     Parameter< Operation::DELETE_ATT > const& parameters)
+{
+    if( m_handler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Deleting an attribute in a file opened as read only is not possible.");
+
+    if( writable->written )
+    {
+        File& file = fileOf(writable);
+        std::string name = bp2_attribute_name(writable, parameters.name);
+        file.io.RemoveAttribute(name);
+        file.io.RemoveAttribute(bp2_dtype_marker(name));
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::writeDataset(Writable* writable,
+                                  Parameter< Operation::WRITE_DATASET > const& parameters)
+{
+    File& file = fileOf(writable);
+    if( file.reading )
+        throw std::runtime_error("Writing into a file opened as read only is not possible.");
+
+    beginStep(file);
+    std::string varName = concrete_bp2_file_position(writable);
+    Parameter< Operation::WRITE_DATASET > dense = parameters;
+    if( parameters.memoryStride != 1 || !parameters.memoryExtent.empty() )
+    {
+        /* ADIOS2 puts dense buffers only, members of an array of structs or parts of a larger buffer are copied */
+        auto buffer = auxiliary::allocatePtr(parameters.dtype, parameters.extent);
+        size_t numPoints = 1;
+        for( auto const& dimensionSize : parameters.extent )
+            numPoints *= dimensionSize;
+        if( !parameters.memoryExtent.empty() )
+            auxiliary::pack(buffer.get(), parameters.data.get(), toBytes(parameters.dtype),
+                            parameters.extent, parameters.memoryOffset, parameters.memoryExtent);
+        else
+            auxiliary::gather(buffer.get(), parameters.data.get(), numPoints, toBytes(parameters.dtype), parameters.memoryStride);
+        std::function< void(void*) > del = buffer.get_deleter();
+        dense.data = std::shared_ptr< void >(buffer.release(), del);
+        dense.memoryStride = 1;
+        dense.memoryExtent.clear();
+        dense.memoryOffset.clear();
+    }
+    PutVariable put{file.io, file.engine, varName, dense};
+    switchDatasetType(parameters.dtype, put);
+
+    /* the frontend might release its reference before the deferred Put is performed */
+    file.puts.push_back(dense.data);
+}
+
+void
+ADIOS2IOHandlerImpl::writeAttribute(Writable* writable,
+                                    Parameter< Operation::WRITE_ATT > const& parameters)
+{
+    if( m_handler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Writing an attribute in a file opened as read only is not possible.");
+
+    File& file = fileOf(writable);
+    beginStep(file);
+    adios2::IO& io = file.io;
+    std::string name = bp2_attribute_name(writable, parameters.name);
+    io.RemoveAttribute(bp2_dtype_marker(name));
+
+    using DT = Datatype;
+    Attribute const att(parameters.resource);
+    switch( parameters.dtype )
+    {
+        case DT::CHAR:
+            defineAttribute(io, name, att.get< char >());
+            break;
+        case DT::UCHAR:
+            defineAttribute(io, name, att.get< unsigned char >());
+            break;
+        case DT::INT16:
+            defineAttribute(io, name, att.get< int16_t >());
+            break;
+        case DT::INT32:
+            defineAttribute(io, name, att.get< int32_t >());
+            break;
+        case DT::INT64:
+            defineAttribute(io, name, att.get< int64_t >());
+            break;
+        case DT::UINT16:
+            defineAttribute(io, name, att.get< uint16_t >());
+            break;
+        case DT::UINT32:
+            defineAttribute(io, name, att.get< uint32_t >());
+            break;
+        case DT::UINT64:
+            defineAttribute(io, name, att.get< uint64_t >());
+            break;
+        case DT::FLOAT:
+            defineAttribute(io, name, att.get< float >());
+            break;
+        case DT::DOUBLE:
+            defineAttribute(io, name, att.get< double >());
+            break;
+        case DT::LONG_DOUBLE:
+            defineAttribute(io, name, att.get< long double >());
+            break;
+        case DT::STRING:
+            defineAttribute(io, name, att.get< std::string >());
+            break;
+        case DT::VEC_CHAR:
+            defineAttribute(io, name, att.get< std::vector< char > >());
+            break;
+        case DT::VEC_INT16:
+            defineAttribute(io, name, att.get< std::vector< int16_t > >());
+            break;
+        case DT::VEC_INT32:
+            defineAttribute(io, name, att.get< std::vector< int32_t > >());
+            break;
+        case DT::VEC_INT64:
+            defineAttribute(io, name, att.get< std::vector< int64_t > >());
+            break;
+        case DT::VEC_UCHAR:
+            defineAttribute(io, name, att.get< std::vector< unsigned char > >());
+            break;
+        case DT::VEC_UINT16:
+            defineAttribute(io, name, att.get< std::vector< uint16_t > >());
+            break;
+        case DT::VEC_UINT32:
+            defineAttribute(io, name, att.get< std::vector< uint32_t > >());
+            break;
+        case DT::VEC_UINT64:
+            defineAttribute(io, name, att.get< std::vector< uint64_t > >());
+            break;
+        case DT::VEC_FLOAT:
+            defineAttribute(io, name, att.get< std::vector< float > >());
+            break;
+        case DT::VEC_DOUBLE:
+            defineAttribute(io, name, att.get< std::vector< double > >());
+            break;
+        case DT::VEC_LONG_DOUBLE:
+            defineAttribute(io, name, att.get< std::vector< long double > >());
+            break;
+        case DT::VEC_STRING:
+            defineAttribute(io, name, att.get< std::vector< std::string > >());
+            break;
+        case DT::ARR_DBL_7:
+        {
+            std::array< double, 7 > arr = att.get< std::array< double, 7 > >();
+            defineAttribute(io, name, std::vector< double >(arr.begin(), arr.end()));
+            break;
+        }
+        case DT::BOOL:
+            defineAttribute(io, name, static_cast< unsigned char >(att.get< bool >()));
+            break;
+        case DT::UNDEFINED:
+        case DT::DATATYPE:
+            throw std::runtime_error("Unknown Attribute datatype");
+    }
+    if( bp2_needs_dtype_marker(parameters.dtype) )
+        defineAttribute(io, bp2_dtype_marker(name), bp2_dtype_name(parameters.dtype));
+}
+
+void
+ADIOS2IOHandlerImpl::writeAttributes(Writable* writable,
+                                     Parameter< Operation::WRITE_ATTS > const& parameters)
+{
+    /* attributes are defined on the IO and only written with the next step, so there is nothing to share */
+    for( auto const& attribute : parameters.attributes )
+        writeAttribute(writable, attribute);
+}
+
+void
+ADIOS2IOHandlerImpl::readDataset(Writable* writable,
+                                 Parameter< Operation::READ_DATASET > & parameters)
+{
+    if( !parameters.stride.empty() )
+        throw std::runtime_error("Strided reads are not supported by the ADIOS2 backend.");
+    if( parameters.memoryStride != 1 )
+        throw std::runtime_error("Reads into strided memory are not supported by the ADIOS2 backend.");
+    if( parameters.transpose )
+        throw std::runtime_error("Transposed reads are not supported by the ADIOS2 backend.");
+    if( !parameters.regions.empty() || !parameters.points.empty() )
+        throw std::runtime_error("Multi-region and point-selection reads are not supported by the ADIOS2 backend.");
+
+    File& file = fileOf(writable);
+    std::string varName = concrete_bp2_file_position(writable);
+
+    FindVariable find{file.io, varName, Datatype::UNDEFINED, {}};
+    forEachDatasetType(find);
+    if( find.dtype == Datatype::UNDEFINED )
+        throw std::runtime_error("Internal error: Failed to find ADIOS2 variable " + varName + " during dataset read");
+
+    GetVariable get{file.io, file.engine, varName, parameters, {}};
+    switchDatasetType(find.dtype, get);
+
+    /* keep the target buffer alive until the deferred Get has been performed */
+    std::shared_ptr< void > buffer = parameters.buffer;
+    std::function< void() > convert = get.finish;
+    std::function< void() > finish = parameters.finish;
+    PendingGet pending;
+    pending.finish = [buffer, convert, finish]()
+    {
+        if( convert )
+            convert();
+        if( finish )
+            finish();
+    };
+    pending.done = parameters.done;
+    file.gets.push_back(pending);
+}
+
+void
+ADIOS2IOHandlerImpl::readAttribute(Writable* writable,
+                                   Parameter< Operation::READ_ATT > & parameters)
+{
+    File& file = fileOf(writable);
+    Attribute a = readAttributeValue(file.io, bp2_attribute_name(writable, parameters.name));
+
+    *parameters.dtype = a.dtype;
+    *parameters.resource = a.getResource();
+}
+
+void
+ADIOS2IOHandlerImpl::readAttributes(Writable* writable,
+                                    Parameter< Operation::READ_ATTS > & parameters)
+{
+    File& file = fileOf(writable);
+    std::string prefix = bp2_prefix(writable);
+
+    for( auto const& att : entriesBelow(file.io.AvailableAttributes(), prefix) )
+    {
+        if( auxiliary::contains(att, "/") )
+            continue;
+        try
+        {
+            parameters.attributes->emplace(att, readAttributeValue(file.io, prefix + att));
+        } catch( unsupported_data_error const& e )
+        {
+            parameters.skipped->emplace(att, e.what());
+        }
+    }
+}
+
+void
+ADIOS2IOHandlerImpl::listPaths(Writable* writable,
+                               Parameter< Operation::LIST_PATHS > & parameters)
+{
+    File& file = fileOf(writable);
+    std::string prefix = bp2_prefix(writable);
+
+    std::set< std::string > datasets;
+    std::set< std::string > paths;
+    for( auto const& var : entriesBelow(file.io.AvailableVariables(), prefix) )
+    {
+        auto pos = var.find('/');
+        if( pos == std::string::npos )
+            datasets.insert(var);
+        else
+            paths.insert(var.substr(0, pos));
+    }
+    for( auto const& att : entriesBelow(file.io.AvailableAttributes(), prefix) )
+    {
+        auto pos = att.find('/');
+        if( pos != std::string::npos )
+            paths.insert(att.substr(0, pos));
+    }
+
+    /* attributes of datasets look like members of a path */
+    for( auto const& path : paths )
+        if( !datasets.count(path) )
+            parameters.paths->push_back(path);
+}
+
+void
+ADIOS2IOHandlerImpl::listDatasets(Writable* writable,
+                                  Parameter< Operation::LIST_DATASETS > & parameters)
+{
+    File& file = fileOf(writable);
+    std::string prefix = bp2_prefix(writable);
+
+    for( auto const& var : entriesBelow(file.io.AvailableVariables(), prefix) )
+        if( !auxiliary::contains(var, "/") )
+            parameters.datasets->push_back(var);
+}
+
+void
+ADIOS2IOHandlerImpl::listAttributes(Writable* writable,
+                                    Parameter< Operation::LIST_ATTS > & parameters)
+{
+    File& file = fileOf(writable);
+    std::string prefix = bp2_prefix(writable);
+
+    for( auto const& att : entriesBelow(file.io.AvailableAttributes(), prefix) )
+        if( !auxiliary::contains(att, "/") )
+            parameters.attributes->push_back(att);
+}
+
+ADIOS2IOHandler::ADIOS2IOHandler(std::string const& path, AccessType at, std::string const& engineType)
         : AbstractIOHandler(path, at),
-          m_impl{new ADIOS2IOHandlerImpl(this)}
+          m_impl{new ADIOS2IOHandlerImpl(this, engineType)}
+{ }
+
+#if openPMD_HAVE_MPI
+ADIOS2IOHandler::ADIOS2IOHandler(std::string const& path, AccessType at, MPI_Comm comm, std::string const& engineType)
+        : AbstractIOHandler(path, at, comm),
+          m_impl{new ADIOS2IOHandlerImpl(this, comm, engineType)}
 { }
+#endif
 
 ADIOS2IOHandler::~ADIOS2IOHandler()
 { }
@@ -52,18 +1350,23 @@ ADIOS2IOHandler::~ADIOS2IOHandler()
 std::future< void >
 ADIOS2IOHandler::flush()
 {
+    std::lock_guard< std::recursive_mutex > lock(m_workMutex);
     return m_impl->flush();
 }
 #else
-ADIOS2IOHandler::ADIOS2IOHandler(std::string const& path, AccessType at)
+ADIOS2IOHandler::ADIOS2IOHandler(std::string const& path, AccessType at, std::string const&)
+        : AbstractIOHandler(path, at)
+{
+    throw std::runtime_error("openPMD-api built without ADIOS2 support");
+}
+
 #if openPMD_HAVE_MPI
-        : AbstractIOHandler(path, at, MPI_COMM_NULL)
-#else
-: AbstractIOHandler(path, at)
-#endif
+ADIOS2IOHandler::ADIOS2IOHandler(std::string const& path, AccessType at, MPI_Comm comm, std::string const&)
+        : AbstractIOHandler(path, at, comm)
 {
-    throw std::runtime_error("openPMD-api built without parallel ADIOS2 support");
+    throw std::runtime_error("openPMD-api built without ADIOS2 support");
 }
+#endif
 
 ADIOS2IOHandler::~ADIOS2IOHandler()
 { }
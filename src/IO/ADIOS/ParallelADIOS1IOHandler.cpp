@@ -24,29 +24,48 @@
 namespace openPMD
 {
 #if openPMD_HAVE_ADIOS1 && openPMD_HAVE_MPI
-ParallelHDF5IOHandler::ParallelHDF5IOHandler(std::string const& path,
-                                             AccessType at,
-                                             MPI_Comm comm)
+ParallelADIOS1IOHandlerImpl::ParallelADIOS1IOHandlerImpl(AbstractIOHandler* handler,
+                                                         MPI_Comm comm)
+        : ADIOS1IOHandlerImpl{handler, comm},
+          m_mpiComm{comm}
+{ }
+
+ParallelADIOS1IOHandlerImpl::~ParallelADIOS1IOHandlerImpl()
+{ }
+
+ParallelADIOS1IOHandler::ParallelADIOS1IOHandler(std::string const& path,
+                                                 AccessType at,
+                                                 MPI_Comm comm)
         : AbstractIOHandler(path, at, comm),
-          m_impl{new ParallelHDF5IOHandlerImpl(this, comm)}
+          m_impl{new ParallelADIOS1IOHandlerImpl(this, comm)}
 { }
 
-ParallelHDF5IOHandler::~ParallelHDF5IOHandler()
+ParallelADIOS1IOHandler::~ParallelADIOS1IOHandler()
 { }
 
 std::future< void >
-ParallelHDF5IOHandler::flush()
+ParallelADIOS1IOHandler::flush()
 {
+    std::lock_guard< std::recursive_mutex > lock(m_workMutex);
     return m_impl->flush();
 }
+
+void
+ParallelADIOS1IOHandler::setTransport(ADIOS1Transport const& transport)
+{
+    m_impl->m_transport = transport;
+}
 #else
+#   if openPMD_HAVE_MPI
+ParallelADIOS1IOHandler::ParallelADIOS1IOHandler(std::string const& path,
+                                                 AccessType at,
+                                                 MPI_Comm comm)
+        : AbstractIOHandler(path, at, comm)
+#   else
 ParallelADIOS1IOHandler::ParallelADIOS1IOHandler(std::string const& path,
                                                  AccessType at)
-#if openPMD_HAVE_MPI
-        : AbstractIOHandler(path, at, MPI_COMM_NULL)
-#else
-: AbstractIOHandler(path, at)
-#endif
+        : AbstractIOHandler(path, at)
+#   endif
 {
     throw std::runtime_error("openPMD-api built without parallel ADIOS1 support");
 }
@@ -59,5 +78,9 @@ ParallelADIOS1IOHandler::flush()
 {
     return std::future< void >();
 }
+
+void
+ParallelADIOS1IOHandler::setTransport(ADIOS1Transport const&)
+{ }
 #endif
 } // openPMD
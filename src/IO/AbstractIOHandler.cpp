@@ -19,10 +19,15 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 #include "openPMD/IO/AbstractIOHandler.hpp"
+#include "openPMD/IO/ADIOS/ADIOS1IOHandler.hpp"
+#include "openPMD/IO/ADIOS/ParallelADIOS1IOHandler.hpp"
+#include "openPMD/IO/ADIOS/ADIOS2IOHandler.hpp"
 #include "openPMD/IO/HDF5/HDF5IOHandler.hpp"
 #include "openPMD/IO/HDF5/ParallelHDF5IOHandler.hpp"
 
+#include <exception>
 #include <iostream>
+#include <utility>
 
 
 namespace openPMD
@@ -40,10 +45,17 @@ AbstractIOHandler::createIOHandler(std::string const& path,
         case Format::HDF5:
             ret = std::make_shared< ParallelHDF5IOHandler >(path, at, comm);
             break;
-        case Format::ADIOS1:
         case Format::ADIOS2:
-            std::cerr << "Backend not yet working. Your IO operations will be NOOPS!" << std::endl;
-            ret = std::make_shared< DummyIOHandler >(path, at);
+            ret = std::make_shared< ADIOS2IOHandler >(path, at, comm);
+            break;
+        case Format::ADIOS2_SST:
+            ret = std::make_shared< ADIOS2IOHandler >(path, at, comm, "SST");
+            break;
+        case Format::ADIOS2_SSC:
+            ret = std::make_shared< ADIOS2IOHandler >(path, at, comm, "SSC");
+            break;
+        case Format::ADIOS1:
+            ret = std::make_shared< ParallelADIOS1IOHandler >(path, at, comm);
             break;
         default:
             ret = std::make_shared< DummyIOHandler >(path, at);
@@ -71,10 +83,17 @@ AbstractIOHandler::createIOHandler(std::string const& path,
         case Format::HDF5:
             ret = std::make_shared< HDF5IOHandler >(path, at);
             break;
-        case Format::ADIOS1:
         case Format::ADIOS2:
-            std::cerr << "Backend not yet working. Your IO operations will be NOOPS!" << std::endl;
-            ret = std::make_shared< DummyIOHandler >(path, at);
+            ret = std::make_shared< ADIOS2IOHandler >(path, at);
+            break;
+        case Format::ADIOS2_SST:
+            ret = std::make_shared< ADIOS2IOHandler >(path, at, "SST");
+            break;
+        case Format::ADIOS2_SSC:
+            ret = std::make_shared< ADIOS2IOHandler >(path, at, "SSC");
+            break;
+        case Format::ADIOS1:
+            ret = std::make_shared< ADIOS1IOHandler >(path, at);
             break;
         default:
             ret = std::make_shared< DummyIOHandler >(path, at);
@@ -96,7 +115,26 @@ AbstractIOHandler::~AbstractIOHandler()
 void
 AbstractIOHandler::enqueue(IOTask const& i)
 {
-    m_work.push(i);
+    IOTask task(i);
+#if openPMD_HAVE_INSTRUMENTATION
+    task.enqueued = std::chrono::steady_clock::now();
+#endif
+    m_work.push(std::move(task));
+}
+
+std::future< void >
+AbstractIOHandler::flushAsync()
+{
+    std::promise< void > done;
+    try
+    {
+        flush();
+        done.set_value();
+    } catch( ... )
+    {
+        done.set_exception(std::current_exception());
+    }
+    return done.get_future();
 }
 
 DummyIOHandler::DummyIOHandler(std::string const& path, AccessType at)
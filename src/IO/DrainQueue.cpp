@@ -0,0 +1,220 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/IO/DrainQueue.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace openPMD
+{
+namespace
+{
+constexpr std::size_t DRAIN_BLOCK = 16u * 1024u * 1024u;
+
+std::uint64_t
+stagedSize(boost::filesystem::path const& p)
+{
+    namespace fs = boost::filesystem;
+    if( !fs::is_directory(p) )
+        return fs::file_size(p);
+
+    std::uint64_t size = 0;
+    for( fs::recursive_directory_iterator it(p), end; it != end; ++it )
+        if( fs::is_regular_file(it->path()) )
+            size += fs::file_size(it->path());
+    return size;
+}
+} // namespace
+
+DrainQueue::DrainQueue(std::string stagingDirectory, std::string targetDirectory)
+        : m_staging{std::move(stagingDirectory)},
+          m_target{std::move(targetDirectory)}
+{
+    boost::filesystem::create_directories(m_staging);
+    boost::filesystem::create_directories(m_target);
+    m_worker = std::thread(&DrainQueue::work, this);
+}
+
+DrainQueue::~DrainQueue()
+{
+    {
+        std::unique_lock< std::mutex > lock(m_mutex);
+        m_cv.wait(lock, [this]{ return m_pending.empty() && !m_busy; });
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_worker.join();
+
+    if( m_error )
+    {
+        try
+        {
+            std::rethrow_exception(m_error);
+        } catch( std::exception const& e )
+        {
+            std::cerr << "Files of the staging directory " << m_staging
+                      << " could not be drained: " << e.what() << std::endl;
+        }
+    }
+}
+
+void
+DrainQueue::add(std::string const& name)
+{
+    std::uint64_t const size = stagedSize(m_staging + name);
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        m_pending.emplace_back(name, size);
+        ++m_status.pendingFiles;
+        m_status.pendingBytes += size;
+    }
+    m_cv.notify_all();
+}
+
+void
+DrainQueue::await()
+{
+    std::unique_lock< std::mutex > lock(m_mutex);
+    m_cv.wait(lock, [this]{ return m_pending.empty() && !m_busy; });
+    if( m_error )
+    {
+        std::exception_ptr error;
+        std::swap(error, m_error);
+        std::rethrow_exception(error);
+    }
+}
+
+DrainStatus
+DrainQueue::status() const
+{
+    std::lock_guard< std::mutex > lock(m_mutex);
+    return m_status;
+}
+
+void
+DrainQueue::work()
+{
+    std::unique_lock< std::mutex > lock(m_mutex);
+    while( true )
+    {
+        m_cv.wait(lock, [this]{ return m_stop || !m_pending.empty(); });
+        if( m_pending.empty() )
+            return;
+
+        std::string name = std::move(m_pending.front().first);
+        m_current = m_pending.front().second;
+        m_pending.pop_front();
+        m_busy = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try
+        {
+            move(name);
+        } catch( ... )
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        /* the staged size is an estimate if the file has been modified after it was added */
+        m_status.pendingBytes -= m_current;
+        m_current = 0;
+        --m_status.pendingFiles;
+        if( error )
+        {
+            if( !m_error )
+                m_error = error;
+        } else
+            ++m_status.drainedFiles;
+        m_busy = false;
+        m_cv.notify_all();
+    }
+}
+
+void
+DrainQueue::move(std::string const& name)
+{
+    namespace fs = boost::filesystem;
+    fs::path const source(m_staging + name);
+    fs::path const destination(m_target + name);
+    fs::path const partial(m_target + name + ".draining");
+
+    std::vector< std::pair< fs::path, fs::path > > files;
+    if( fs::is_directory(source) )
+    {
+        fs::remove_all(partial);
+        fs::create_directories(partial);
+        for( fs::recursive_directory_iterator it(source), end; it != end; ++it )
+        {
+            fs::path const to = partial / fs::relative(it->path(), source);
+            if( fs::is_directory(it->path()) )
+                fs::create_directories(to);
+            else
+                files.emplace_back(it->path(), to);
+        }
+    } else
+        files.emplace_back(source, partial);
+
+    std::vector< char > buffer(DRAIN_BLOCK);
+    for( auto const& f : files )
+    {
+        std::ifstream in(f.first.string(), std::ios::binary);
+        std::ofstream out(f.second.string(), std::ios::binary | std::ios::trunc);
+        if( !in || !out )
+            throw std::runtime_error("Failed to drain " + f.first.string() + " to " + f.second.string());
+        while( in )
+        {
+            in.read(buffer.data(), buffer.size());
+            std::streamsize const n = in.gcount();
+            if( n <= 0 )
+                break;
+            out.write(buffer.data(), n);
+            if( !out )
+                throw std::runtime_error("Failed to write " + f.second.string());
+
+            std::uint64_t const copied = static_cast< std::uint64_t >(n);
+            std::uint64_t const counted = std::min(copied, m_current);
+            std::lock_guard< std::mutex > lock(m_mutex);
+            m_current -= counted;
+            m_status.pendingBytes -= counted;
+            m_status.drainedBytes += copied;
+        }
+        if( in.bad() )
+            throw std::runtime_error("Failed to read " + f.first.string());
+        out.close();
+        if( !out )
+            throw std::runtime_error("Failed to write " + f.second.string());
+    }
+
+    /* files staged once more (e.g. a re-written manifest) replace the drained ones */
+    fs::remove_all(destination);
+    fs::rename(partial, destination);
+    fs::remove_all(source);
+}
+} // openPMD
@@ -22,18 +22,60 @@
 
 
 #if defined(openPMD_HAVE_HDF5)
+#   include "openPMD/auxiliary/Memory.hpp"
+#   include "openPMD/auxiliary/Serialization.hpp"
 #   include "openPMD/auxiliary/StringManip.hpp"
 #   include "openPMD/backend/Attribute.hpp"
 #   include "openPMD/IO/IOTask.hpp"
 #   include "openPMD/IO/HDF5/HDF5Auxiliary.hpp"
 #   include "openPMD/IO/HDF5/HDF5FilePosition.hpp"
+#   if openPMD_HAVE_HDF5_ZLIB
+#       include <zlib.h>
+#   endif
+
+/* identifiers of dynamically loaded filter plugins registered with The HDF Group */
+#   ifndef H5Z_FILTER_BLOSC
+#       define H5Z_FILTER_BLOSC 32001
+#   endif
+#   ifndef H5Z_FILTER_LZ4
+#       define H5Z_FILTER_LZ4 32004
+#   endif
+#   ifndef H5Z_FILTER_ZSTD
+#       define H5Z_FILTER_ZSTD 32015
+#   endif
+#   ifndef H5Z_FILTER_ZFP
+#       define H5Z_FILTER_ZFP 32013
+#   endif
+#   ifndef H5Z_FILTER_SZ
+#       define H5Z_FILTER_SZ 32017
+#   endif
 #endif
 
 #include <boost/filesystem.hpp>
 
+#if defined(__linux__) || defined(__APPLE__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
 #include <future>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stack>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace openPMD
@@ -45,12 +87,34 @@ namespace openPMD
 #       define ASSERT(CONDITION, TEXT) do{ (void)sizeof(CONDITION); } while( 0 )
 #   endif
 
+/* datasets of fixed size up to this size are stored in their object header, which holds at most 64 KiB */
+constexpr hsize_t compactDatasetBytes = hsize_t(16) << 10;
+
 HDF5IOHandlerImpl::HDF5IOHandlerImpl(AbstractIOHandler* handler)
-        : m_datasetTransferProperty{H5P_DEFAULT},
+        : m_maxDatasetHandles{128},
+          m_maxChunkCacheBytes{size_t(64) << 20},
+          m_datasetTransferProperty{H5P_DEFAULT},
           m_fileAccessProperty{H5P_DEFAULT},
+          m_fileCreationProperty{H5P_DEFAULT},
+          m_groupCreationProperty{H5P_DEFAULT},
           m_H5T_BOOL_ENUM{H5Tenum_create(H5T_NATIVE_INT8)},
+          m_persistOnFlush{false},
+          m_persistThreads{0},
+          m_filterThreads{0},
+          m_metadataSnapshots{false},
           m_handler{handler}
 {
+    /* all fixed types are immutable, so they are built once and shared by all operations */
+    m_H5Types.fill(-1);
+    for( std::size_t i = 0; i < m_H5Types.size(); ++i )
+    {
+        Attribute a(0);
+        a.dtype = static_cast< Datatype >(i);
+        if( a.dtype == Datatype::STRING || a.dtype == Datatype::VEC_STRING )
+            continue;
+        m_H5Types[i] = getH5DataType(a);
+        ASSERT(m_H5Types[i] >= 0, "Internal error: Failed to create HDF5 datatype");
+    }
     ASSERT(m_H5T_BOOL_ENUM >= 0, "Internal error: Failed to create HDF5 enum");
     std::string t{"TRUE"};
     std::string f{"FALSE"};
@@ -65,18 +129,49 @@ HDF5IOHandlerImpl::HDF5IOHandlerImpl(AbstractIOHandler* handler)
 
 HDF5IOHandlerImpl::~HDF5IOHandlerImpl()
 {
+    releaseDatasetHandles();
+
     herr_t status;
     status = H5Tclose(m_H5T_BOOL_ENUM);
     if( status < 0 )
         std::cerr << "Internal error: Failed to close HDF5 enum\n";
+    for( hid_t type : m_H5Types )
+        if( type >= 0 && H5Tclose(type) < 0 )
+            std::cerr << "Internal error: Failed to close HDF5 datatype\n";
+    for( auto const& type : m_stringTypes )
+        if( H5Tclose(type.second) < 0 )
+            std::cerr << "Internal error: Failed to close HDF5 string datatype\n";
+    for( auto& snapshot : m_snapshots )
+        if( snapshot.second.dirty )
+            saveSnapshot(snapshot.second);
     while( !m_openFileIDs.empty() )
     {
         auto file = m_openFileIDs.begin();
+        if( m_persistThreads > 0 && m_handler->accessType != AccessType::READ_ONLY )
+        {
+            try
+            {
+                persistImage(*file);
+            } catch( std::exception const& e )
+            {
+                std::cerr << "Internal error: Failed to persist HDF5 file: " << e.what() << '\n';
+            }
+        }
         status = H5Fclose(*file);
         if( status < 0 )
             std::cerr << "Internal error: Failed to close HDF5 file (serial)\n";
         m_openFileIDs.erase(file);
     }
+    while( !m_pendingImages.empty() )
+    {
+        try
+        {
+            awaitImages();
+        } catch( std::exception const& e )
+        {
+            std::cerr << "Internal error: " << e.what() << '\n';
+        }
+    }
     if( m_datasetTransferProperty != H5P_DEFAULT )
     {
         status = H5Pclose(m_datasetTransferProperty);
@@ -89,87 +184,840 @@ HDF5IOHandlerImpl::~HDF5IOHandlerImpl()
         if( status < 0 )
             std::cerr << "Internal error: Failed to close HDF5 file access property\n";
     }
+    if( m_fileCreationProperty != H5P_DEFAULT && H5Pclose(m_fileCreationProperty) < 0 )
+        std::cerr << "Internal error: Failed to close HDF5 file creation property\n";
+    if( m_groupCreationProperty != H5P_DEFAULT && H5Pclose(m_groupCreationProperty) < 0 )
+        std::cerr << "Internal error: Failed to close HDF5 group creation property\n";
+}
+
+HDF5IOHandlerImpl::DatasetHandle&
+HDF5IOHandlerImpl::datasetHandle(Writable* writable, hid_t file, ChunkCache const* cache)
+{
+    ChunkCache const requested = cache && cache->bytes > 0 ? *cache : m_handler->chunkCache;
+    auto sameCache = [&requested](ChunkCache const& c)
+    {
+        return c.bytes == requested.bytes && c.slots == requested.slots && c.preemption == requested.preemption;
+    };
+
+    auto it = m_datasetHandles.find(writable);
+    if( it != m_datasetHandles.end() )
+    {
+        if( it->second.position == writable->abstractFilePosition && it->second.file == file
+            && (!cache || sameCache(it->second.cache)) )
+        {
+            m_datasetHandleLRU.splice(m_datasetHandleLRU.begin(), m_datasetHandleLRU, it->second.lru);
+            return it->second;
+        }
+        releaseDatasetHandle(writable);
+    }
+
+    while( m_datasetHandles.size() >= m_maxDatasetHandles )
+        releaseDatasetHandle(m_datasetHandleLRU.back());
+
+    DatasetHandle h;
+    h.position = writable->abstractFilePosition;
+    h.file = file;
+    h.cache = requested;
+    h.dataset = H5Dopen(file,
+                        concrete_h5_file_position(writable).c_str(),
+                        H5P_DEFAULT);
+    ASSERT(h.dataset >= 0, "Internal error: Failed to open HDF5 dataset " + concrete_h5_file_position(writable));
+    h.dataspace = H5Dget_space(h.dataset);
+    ASSERT(h.dataspace >= 0, "Internal error: Failed to get HDF5 dataset file space");
+
+    /* the default chunk cache (1 MiB) can not hold the chunks touched by a single slab of large-chunked datasets,
+     * in which case every access decompresses and re-reads chunks, so re-open with a matching cache */
+    hid_t access = chunkCacheProperty(h.dataset, h.dataspace, requested);
+    if( access != H5P_DEFAULT )
+    {
+        herr_t status;
+        status = H5Sclose(h.dataspace);
+        ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset file space");
+        status = H5Dclose(h.dataset);
+        ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset");
+        h.dataset = H5Dopen(file,
+                            concrete_h5_file_position(writable).c_str(),
+                            access);
+        ASSERT(h.dataset >= 0, "Internal error: Failed to open HDF5 dataset " + concrete_h5_file_position(writable));
+        h.dataspace = H5Dget_space(h.dataset);
+        ASSERT(h.dataspace >= 0, "Internal error: Failed to get HDF5 dataset file space");
+        status = H5Pclose(access);
+        ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset access property");
+    }
+    m_datasetHandleLRU.push_front(writable);
+    h.lru = m_datasetHandleLRU.begin();
+
+    return m_datasetHandles.insert({writable, h}).first->second;
+}
+
+hid_t
+HDF5IOHandlerImpl::memoryType(Datatype dtype)
+{
+    switch( dtype )
+    {
+        using DT = Datatype;
+        case DT::LONG_DOUBLE:
+        case DT::DOUBLE:
+        case DT::FLOAT:
+        case DT::INT16:
+        case DT::INT32:
+        case DT::INT64:
+        case DT::UINT16:
+        case DT::UINT32:
+        case DT::UINT64:
+        case DT::CHAR:
+        case DT::UCHAR:
+        case DT::BOOL:
+            break;
+        case DT::UNDEFINED:
+            throw std::runtime_error("Unknown Attribute datatype");
+        case DT::DATATYPE:
+            throw std::runtime_error("Meta-Datatype leaked into IO");
+        default:
+            throw std::runtime_error("Datatype not implemented in HDF5 IO");
+    }
+
+    return m_H5Types[static_cast< std::size_t >(dtype)];
+}
+
+hid_t
+HDF5IOHandlerImpl::attributeType(Attribute const& att)
+{
+    using DT = Datatype;
+    switch( att.dtype )
+    {
+        case DT::BOOL:
+            return m_H5T_BOOL_ENUM;
+        case DT::STRING:
+            return stringType(att.get< std::string >().size());
+        case DT::VEC_STRING:
+        {
+            size_t max_len = 0;
+            for( std::string const& s : att.get< std::vector< std::string > >() )
+                max_len = std::max(max_len, s.size());
+            return stringType(max_len);
+        }
+        case DT::DATATYPE:
+            throw std::runtime_error("Meta-Datatype leaked into IO");
+        case DT::UNDEFINED:
+            throw std::runtime_error("Unknown Attribute datatype");
+        default:
+            if( static_cast< std::size_t >(att.dtype) >= m_H5Types.size() )
+                throw std::runtime_error("Datatype not implemented in HDF5 IO");
+            return m_H5Types[static_cast< std::size_t >(att.dtype)];
+    }
+}
+
+hid_t
+HDF5IOHandlerImpl::stringType(std::size_t length)
+{
+    auto it = m_stringTypes.find(length);
+    if( it != m_stringTypes.end() )
+        return it->second;
+
+    hid_t type = H5Tcopy(H5T_C_S1);
+    ASSERT(type >= 0, "Internal error: Failed to create HDF5 string datatype");
+    H5Tset_size(type, length);
+    m_stringTypes.emplace(length, type);
+    return type;
+}
+
+hid_t
+HDF5IOHandlerImpl::chunkCacheProperty(hid_t dataset, hid_t dataspace, ChunkCache const& cache)
+{
+    hid_t creation = H5Dget_create_plist(dataset);
+    ASSERT(creation >= 0, "Internal error: Failed to get HDF5 dataset creation property");
+    hid_t access = H5P_DEFAULT;
+    if( H5Pget_layout(creation) == H5D_CHUNKED )
+    {
+        int ndims = H5Sget_simple_extent_ndims(dataspace);
+        std::vector< hsize_t > dims(ndims, 0);
+        std::vector< hsize_t > chunk(ndims, 0);
+        H5Sget_simple_extent_dims(dataspace, dims.data(), nullptr);
+        H5Pget_chunk(creation, ndims, chunk.data());
+
+        hid_t type = H5Dget_type(dataset);
+        size_t chunkBytes = H5Tget_size(type);
+        H5Tclose(type);
+        /* chunks intersected by a slab at a single index of the slowest dimension */
+        size_t slabChunks = 1;
+        for( int i = 0; i < ndims; ++i )
+        {
+            chunkBytes *= chunk[i];
+            if( i > 0 && chunk[i] > 0 )
+                slabChunks *= (dims[i] + chunk[i] - 1) / chunk[i];
+        }
+
+        bool const explicitCache = cache.bytes > 0;
+        size_t const cacheBytes = explicitCache ? cache.bytes : std::min(slabChunks * chunkBytes, m_maxChunkCacheBytes);
+        if( explicitCache || cacheBytes > H5D_CHUNK_CACHE_NBYTES_DEFAULT )
+        {
+            size_t const cacheChunks = std::max< size_t >(cacheBytes / std::max< size_t >(chunkBytes, 1u), 1u);
+            access = H5Pcreate(H5P_DATASET_ACCESS);
+            ASSERT(access >= 0, "Internal error: Failed to create HDF5 dataset access property");
+            /* about 100 hash slots per cached chunk keep collisions rare */
+            herr_t status = H5Pset_chunk_cache(access,
+                                               cache.slots > 0 ? cache.slots : std::max< size_t >(100u * cacheChunks + 1u, 521u),
+                                               cacheBytes,
+                                               explicitCache ? cache.preemption : H5D_CHUNK_CACHE_W0_DEFAULT);
+            if( status < 0 )
+                throw std::runtime_error("Invalid HDF5 chunk cache of " + std::to_string(cacheBytes) + " bytes");
+        }
+    }
+    herr_t status = H5Pclose(creation);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset creation property");
+    return access;
+}
+
+void
+HDF5IOHandlerImpl::releaseDatasetHandle(Writable* writable)
+{
+    auto it = m_datasetHandles.find(writable);
+    if( it == m_datasetHandles.end() )
+        return;
+
+    herr_t status;
+    status = H5Sclose(it->second.dataspace);
+    if( status < 0 )
+        std::cerr << "Internal error: Failed to close HDF5 dataset file space\n";
+    status = H5Dclose(it->second.dataset);
+    if( status < 0 )
+        std::cerr << "Internal error: Failed to close HDF5 dataset\n";
+
+    m_datasetHandleLRU.erase(it->second.lru);
+    m_datasetHandles.erase(it);
+}
+
+void
+HDF5IOHandlerImpl::releaseDatasetHandles()
+{
+    while( !m_datasetHandleLRU.empty() )
+        releaseDatasetHandle(m_datasetHandleLRU.front());
+}
+
+void
+HDF5IOHandlerImpl::releaseDatasetHandles(hid_t file)
+{
+    auto it = m_datasetHandleLRU.begin();
+    while( it != m_datasetHandleLRU.end() )
+    {
+        Writable* w = *it;
+        ++it;
+        if( m_datasetHandles.at(w).file == file )
+            releaseDatasetHandle(w);
+    }
+}
+
+namespace
+{
+herr_t
+listLinkCallback(hid_t group, char const* name, H5L_info_t const*, void* data)
+{
+    auto& listing = *static_cast< HDF5IOHandlerImpl::GroupListing* >(data);
+    /* links that can not be resolved (e.g. dangling soft links) are neither groups nor datasets */
+    H5O_type_t const type = h5_object_type(group, name);
+    if( type == H5O_TYPE_GROUP )
+        listing.paths.emplace_back(name);
+    else if( type == H5O_TYPE_DATASET )
+        listing.datasets.emplace_back(name);
+    return 0;
+}
+} // namespace
+
+HDF5IOHandlerImpl::GroupListing const&
+HDF5IOHandlerImpl::groupListing(Writable* writable, hid_t file)
+{
+    std::pair< hid_t, std::string > key{file, concrete_h5_file_position(writable)};
+    auto it = m_groupListings.find(key);
+    if( it != m_groupListings.end() )
+        return it->second;
+
+    hid_t node_id = H5Gopen(file,
+                            key.second.c_str(),
+                            H5P_DEFAULT);
+    ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during group listing");
+
+    GroupListing listing;
+    herr_t status = H5Literate(node_id,
+                               H5_INDEX_NAME,
+                               H5_ITER_INC,
+                               nullptr,
+                               listLinkCallback,
+                               &listing);
+    ASSERT(status >= 0, "Internal error: Failed to iterate HDF5 group " + key.second + " during group listing");
+
+    status = H5Gclose(node_id);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 group " + key.second + " during group listing");
+
+    return m_groupListings.emplace(std::move(key), std::move(listing)).first->second;
+}
+
+void
+HDF5IOHandlerImpl::releaseGroupListings(hid_t file)
+{
+    for( auto it = m_groupListings.begin(); it != m_groupListings.end(); )
+    {
+        if( it->first.first == file )
+            it = m_groupListings.erase(it);
+        else
+            ++it;
+    }
+}
+
+hid_t
+HDF5IOHandlerImpl::refreshFile(hid_t file)
+{
+    releaseGroupListings(file);
+    /* files opened for writing are up to date, as this handler writes them */
+    if( m_handler->accessType != AccessType::READ_ONLY )
+        return file;
+
+    ssize_t length = H5Fget_name(file, nullptr, 0);
+    ASSERT(length >= 0, "Internal error: Failed to get HDF5 file name during refresh");
+    std::vector< char > name(length + 1);
+    H5Fget_name(file, name.data(), length + 1);
+
+    releaseDatasetHandles(file);
+    /* a file that is still written is no longer answered from its snapshot */
+    auto snapshot = m_fileSnapshots.find(file);
+    if( snapshot != m_fileSnapshots.end() )
+    {
+        if( snapshot->second->dirty )
+            saveSnapshot(*snapshot->second);
+        m_fileSnapshots.erase(snapshot);
+    }
+
+    herr_t status = H5Fclose(file);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 file during refresh");
+    m_openFileIDs.erase(file);
+
+    hid_t refreshed = H5Fopen(name.data(), H5F_ACC_RDONLY, m_fileAccessProperty);
+    if( refreshed < 0 )
+        throw no_such_file_error("Failed to reopen HDF5 file " + std::string(name.data()));
+    m_openFileIDs.insert(refreshed);
+    for( auto& f : m_fileIDs )
+        if( f.second == file )
+            f.second = refreshed;
+    return refreshed;
+}
+
+namespace
+{
+constexpr char const* snapshotMagic = "openPMD-api snapshot 1";
+
+/** Take the results of a metadata read from a snapshot, or execute it and add its results. */
+template< typename F_Execute, typename F_Store, typename F_Load >
+void
+replayOrRecord(HDF5IOHandlerImpl::Snapshot& snapshot, std::string const& key,
+               F_Execute execute, F_Store store, F_Load load)
+{
+    auto entry = snapshot.entries.find(key);
+    if( entry != snapshot.entries.end() )
+    {
+        auxiliary::Deserializer d(entry->second);
+        load(d);
+        return;
+    }
+
+    execute();
+    auxiliary::Serializer s;
+    store(s);
+    snapshot.entries.emplace(key, s.buffer());
+    snapshot.dirty = true;
+}
+} // namespace
+
+void
+HDF5IOHandlerImpl::openSnapshot(hid_t file, std::string const& name)
+{
+    auto it = m_snapshots.find(name);
+    if( it == m_snapshots.end() )
+    {
+        using namespace boost::filesystem;
+        path const h5(name);
+        Snapshot snapshot;
+        snapshot.path = (h5.parent_path() / ".openPMD-snapshots" / (h5.filename().string() + ".snapshot")).string();
+        snapshot.modified = static_cast< int64_t >(last_write_time(h5));
+        snapshot.size = static_cast< uint64_t >(file_size(h5));
+        snapshot.dirty = false;
+
+        std::ifstream in(snapshot.path, std::ios::binary);
+        if( in )
+        {
+            std::string buffer((std::istreambuf_iterator< char >(in)), std::istreambuf_iterator< char >());
+            try
+            {
+                auxiliary::Deserializer d(std::move(buffer));
+                std::string magic;
+                int64_t modified;
+                uint64_t size;
+                d.read(magic);
+                d.read(modified);
+                d.read(size);
+                /* a modified file is traversed again */
+                if( magic == snapshotMagic && modified == snapshot.modified && size == snapshot.size )
+                    d.read(snapshot.entries);
+            } catch( std::exception const& )
+            {
+                snapshot.entries.clear();
+            }
+        }
+        it = m_snapshots.emplace(name, std::move(snapshot)).first;
+    }
+    m_fileSnapshots[file] = &it->second;
+}
+
+void
+HDF5IOHandlerImpl::saveSnapshot(Snapshot& snapshot)
+{
+    auxiliary::Serializer s;
+    s.write(std::string(snapshotMagic));
+    s.write(snapshot.modified);
+    s.write(snapshot.size);
+    s.write(snapshot.entries);
+
+    using namespace boost::filesystem;
+    boost::system::error_code ec;
+    path const target(snapshot.path);
+    create_directories(target.parent_path(), ec);
+    /* replaced in one step, as other readers of the same file might save their snapshot concurrently */
+    path tmp = target;
+    tmp += "." + unique_path().string();
+    {
+        std::ofstream out(tmp.string(), std::ios::binary | std::ios::trunc);
+        out.write(s.buffer().data(), static_cast< std::streamsize >(s.buffer().size()));
+        if( !out )
+        {
+            out.close();
+            remove(tmp, ec);
+            return;
+        }
+    }
+    rename(tmp, target, ec);
+    if( ec )
+        remove(tmp, ec);
+    snapshot.dirty = false;
+}
+
+bool
+HDF5IOHandlerImpl::snapshotted(IOTask& task)
+{
+    using O = Operation;
+    Writable* location;
+    switch( task.operation )
+    {
+        case O::OPEN_PATH:
+        case O::OPEN_DATASET:
+            location = task.writable->parent;
+            break;
+        case O::LIST_PATHS:
+            if( task.getParameter< O::LIST_PATHS >().refresh )
+                return false;
+            location = task.writable;
+            break;
+        case O::READ_ATT:
+        case O::READ_ATTS:
+        case O::LIST_DATASETS:
+        case O::LIST_ATTS:
+            location = task.writable;
+            break;
+        default:
+            return false;
+    }
+    auto file = m_fileIDs.find(location);
+    if( file == m_fileIDs.end() )
+        return false;
+    auto snapshot = m_fileSnapshots.find(file->second);
+    if( snapshot == m_fileSnapshots.end() )
+        return false;
+
+    Writable* writable = task.writable;
+    std::string key = std::to_string(static_cast< int >(task.operation)) + '\n' + concrete_h5_file_position(location) + '\n';
+    switch( task.operation )
+    {
+        case O::OPEN_PATH:
+        {
+            auto& parameters = task.getParameter< O::OPEN_PATH >();
+            replayOrRecord(*snapshot->second, key + parameters.path,
+                           [&]{ openPath(writable, parameters); },
+                           [](auxiliary::Serializer&){ },
+                           [&](auxiliary::Deserializer&){ replayOpen(writable, parameters.path); });
+            break;
+        }
+        case O::OPEN_DATASET:
+        {
+            auto& parameters = task.getParameter< O::OPEN_DATASET >();
+            replayOrRecord(*snapshot->second, key + parameters.name,
+                           [&]{ openDataset(writable, parameters); },
+                           [&](auxiliary::Serializer& s)
+                           {
+                               s.write(*parameters.dtype);
+                               s.write(*parameters.extent);
+                               s.write(*parameters.chunkSize);
+                           },
+                           [&](auxiliary::Deserializer& d)
+                           {
+                               d.read(*parameters.dtype);
+                               d.read(*parameters.extent);
+                               d.read(*parameters.chunkSize);
+                               replayOpen(writable, parameters.name);
+                           });
+            break;
+        }
+        case O::READ_ATT:
+        {
+            auto& parameters = task.getParameter< O::READ_ATT >();
+            replayOrRecord(*snapshot->second, key + parameters.name,
+                           [&]{ readAttribute(writable, parameters); },
+                           [&](auxiliary::Serializer& s){ s.write(*parameters.resource); },
+                           [&](auxiliary::Deserializer& d)
+                           {
+                               d.read(*parameters.resource);
+                               *parameters.dtype = Attribute(*parameters.resource).dtype;
+                           });
+            break;
+        }
+        case O::READ_ATTS:
+        {
+            auto& parameters = task.getParameter< O::READ_ATTS >();
+            replayOrRecord(*snapshot->second, key,
+                           [&]{ readAttributes(writable, parameters); },
+                           [&](auxiliary::Serializer& s)
+                           {
+                               s.write(static_cast< uint64_t >(parameters.attributes->size()));
+                               for( auto const& a : *parameters.attributes )
+                               {
+                                   s.write(a.first);
+                                   s.write(a.second.getResource());
+                               }
+                               s.write(*parameters.skipped);
+                           },
+                           [&](auxiliary::Deserializer& d)
+                           {
+                               uint64_t size;
+                               d.read(size);
+                               for( uint64_t i = 0; i < size; ++i )
+                               {
+                                   std::string name;
+                                   Attribute::resource resource;
+                                   d.read(name);
+                                   d.read(resource);
+                                   parameters.attributes->emplace(std::move(name), Attribute(std::move(resource)));
+                               }
+                               d.read(*parameters.skipped);
+                           });
+            break;
+        }
+        case O::LIST_PATHS:
+        {
+            auto& parameters = task.getParameter< O::LIST_PATHS >();
+            replayOrRecord(*snapshot->second, key,
+                           [&]{ listPaths(writable, parameters); },
+                           [&](auxiliary::Serializer& s){ s.write(*parameters.paths); },
+                           [&](auxiliary::Deserializer& d){ d.read(*parameters.paths); });
+            break;
+        }
+        case O::LIST_DATASETS:
+        {
+            auto& parameters = task.getParameter< O::LIST_DATASETS >();
+            replayOrRecord(*snapshot->second, key,
+                           [&]{ listDatasets(writable, parameters); },
+                           [&](auxiliary::Serializer& s){ s.write(*parameters.datasets); },
+                           [&](auxiliary::Deserializer& d){ d.read(*parameters.datasets); });
+            break;
+        }
+        case O::LIST_ATTS:
+        {
+            auto& parameters = task.getParameter< O::LIST_ATTS >();
+            replayOrRecord(*snapshot->second, key,
+                           [&]{ listAttributes(writable, parameters); },
+                           [&](auxiliary::Serializer& s){ s.write(*parameters.attributes); },
+                           [&](auxiliary::Deserializer& d){ d.read(*parameters.attributes); });
+            break;
+        }
+        default:
+            return false;
+    }
+    return true;
+}
+
+void
+HDF5IOHandlerImpl::replayOpen(Writable* writable, std::string name)
+{
+    /* Sanitize name */
+    if( auxiliary::starts_with(name, "/") )
+        name = auxiliary::replace_first(name, "/", "");
+    if( !auxiliary::ends_with(name, "/") )
+        name += '/';
+
+    writable->written = true;
+    writable->abstractFilePosition = make_h5_file_position(name, writable->parent);
+
+    m_fileIDs[writable] = m_fileIDs.at(writable->parent);
 }
 
 std::future< void >
 HDF5IOHandlerImpl::flush()
 {
-    while( !(*m_handler).m_work.empty() )
+    process((*m_handler).m_work.collect());
+    return std::future< void >();
+}
+
+void
+HDF5IOHandlerImpl::setOptions(HDF5Options const& options)
+{
+    m_metadataSnapshots = options.metadataSnapshots;
+    m_filterThreads = options.filterThreads;
+    setAttributeStorage(options.attributeStorage);
+    if( !options.inMemory )
+        return;
+
+    herr_t status;
+    if( m_fileAccessProperty == H5P_DEFAULT )
+    {
+        m_fileAccessProperty = H5Pcreate(H5P_FILE_ACCESS);
+        ASSERT(m_fileAccessProperty >= 0, "Internal error: Failed to create HDF5 file access property");
+    }
+    size_t const increment = options.memoryIncrement > 0 ? static_cast< size_t >(options.memoryIncrement) : size_t(1) << 20;
+    /* the backing store persists the memory image of written files when they are closed,
+     * unless persistImage() writes it in the background */
+    m_persistThreads = options.persistOnFlush ? 0 : options.persistThreads;
+    status = H5Pset_fapl_core(m_fileAccessProperty, increment, m_persistThreads > 0 ? 0 : 1);
+    ASSERT(status >= 0, "Internal error: Failed to set HDF5 core driver");
+    if( options.persistOnFlush )
+    {
+        /* only pages modified since the last flush are written */
+        status = H5Pset_core_write_tracking(m_fileAccessProperty, 1, increment);
+        ASSERT(status >= 0, "Internal error: Failed to set HDF5 core driver write tracking");
+    }
+    m_persistOnFlush = options.persistOnFlush;
+}
+
+void
+HDF5IOHandlerImpl::setAttributeStorage(HDF5AttributeStorage const& storage)
+{
+    if( storage.minDense > storage.maxCompact )
+        throw std::runtime_error("Invalid HDF5 attribute storage: minDense (" + std::to_string(storage.minDense)
+                                 + ") exceeds maxCompact (" + std::to_string(storage.maxCompact) + ")");
+
+    for( hid_t* property : {&m_fileCreationProperty, &m_groupCreationProperty} )
+        if( *property != H5P_DEFAULT )
+        {
+            herr_t closed = H5Pclose(*property);
+            ASSERT(closed >= 0, "Internal error: Failed to close HDF5 object creation property");
+            *property = H5P_DEFAULT;
+        }
+    m_attributeStorage = storage;
+    bool const custom = storage.dense || storage.maxCompact > 0 || storage.trackCreationOrder;
+
+    /* attribute storage is only configurable in object headers of the HDF5 1.8 format, which are not used by default */
+    if( m_fileAccessProperty == H5P_DEFAULT )
     {
-        IOTask& i = (*m_handler).m_work.front();
+        if( !custom )
+            return;
+        m_fileAccessProperty = H5Pcreate(H5P_FILE_ACCESS);
+        ASSERT(m_fileAccessProperty >= 0, "Internal error: Failed to create HDF5 file access property");
+    }
+#if H5_VERSION_GE(1, 10, 2)
+    H5F_libver_t const low = custom ? H5F_LIBVER_V18 : H5F_LIBVER_EARLIEST;
+#else
+    H5F_libver_t const low = custom ? H5F_LIBVER_LATEST : H5F_LIBVER_EARLIEST;
+#endif
+    herr_t status = H5Pset_libver_bounds(m_fileAccessProperty, low, H5F_LIBVER_LATEST);
+    ASSERT(status >= 0, "Internal error: Failed to set HDF5 file format bounds");
+    if( !custom )
+        return;
+
+    /* the root group of a file is created with the file, from its creation property */
+    m_fileCreationProperty = H5Pcreate(H5P_FILE_CREATE);
+    ASSERT(m_fileCreationProperty >= 0, "Internal error: Failed to create HDF5 file creation property");
+    m_groupCreationProperty = H5Pcreate(H5P_GROUP_CREATE);
+    ASSERT(m_groupCreationProperty >= 0, "Internal error: Failed to create HDF5 group creation property");
+    applyAttributeStorage(m_fileCreationProperty);
+    applyAttributeStorage(m_groupCreationProperty);
+}
+
+void
+HDF5IOHandlerImpl::applyAttributeStorage(hid_t objectCreationProperty) const
+{
+    herr_t status;
+    if( m_attributeStorage.dense )
+    {
+        status = H5Pset_attr_phase_change(objectCreationProperty, 0, 0);
+        ASSERT(status >= 0, "Internal error: Failed to set HDF5 dense attribute storage");
+    } else if( m_attributeStorage.maxCompact > 0 )
+    {
+        status = H5Pset_attr_phase_change(objectCreationProperty, m_attributeStorage.maxCompact, m_attributeStorage.minDense);
+        if( status < 0 )
+            throw std::runtime_error("Invalid HDF5 attribute storage thresholds " + std::to_string(m_attributeStorage.maxCompact)
+                                     + "/" + std::to_string(m_attributeStorage.minDense));
+    }
+    if( m_attributeStorage.trackCreationOrder )
+    {
+        status = H5Pset_attr_creation_order(objectCreationProperty, H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED);
+        ASSERT(status >= 0, "Internal error: Failed to set HDF5 attribute creation order");
+    }
+}
+
+void
+HDF5IOHandlerImpl::process(std::queue< IOTask >& work)
+{
+    /* report failed background writes of earlier batches */
+    for( auto image = m_pendingImages.begin(); image != m_pendingImages.end(); )
+    {
+        if( image->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready )
+        {
+            ++image;
+            continue;
+        }
+        std::future< void > done = std::move(image->second);
+        image = m_pendingImages.erase(image);
+        done.get();
+    }
+
+    /* settles the batch even if a task fails, e.g. so that no other rank is left waiting in a collective call */
+    struct BatchGuard
+    {
+        HDF5IOHandlerImpl* impl;
+        bool completed;
+        ~BatchGuard() { if( !completed ) impl->abortBatch(); }
+    } batch{this, false};
+
+    while( !work.empty() )
+    {
+        IOTask& i = work.front();
+        auto measurement = m_handler->statistics.measure(i, concrete_h5_file_position);
         try
         {
+            if( !m_fileSnapshots.empty() && snapshotted(i) )
+            {
+                work.pop();
+                continue;
+            }
             switch( i.operation )
             {
                 using O = Operation;
                 case O::CREATE_FILE:
-                    createFile(i.writable, i.parameter);
+                    createFile(i.writable, i.getParameter< O::CREATE_FILE >());
                     break;
                 case O::CREATE_PATH:
-                    createPath(i.writable, i.parameter);
+                    createPath(i.writable, i.getParameter< O::CREATE_PATH >());
                     break;
                 case O::CREATE_DATASET:
-                    createDataset(i.writable, i.parameter);
+                    createDataset(i.writable, i.getParameter< O::CREATE_DATASET >());
                     break;
                 case O::EXTEND_DATASET:
-                    extendDataset(i.writable, i.parameter);
+                    extendDataset(i.writable, i.getParameter< O::EXTEND_DATASET >());
                     break;
                 case O::OPEN_FILE:
-                    openFile(i.writable, i.parameter);
+                    openFile(i.writable, i.getParameter< O::OPEN_FILE >());
+                    break;
+                case O::CLOSE_FILE:
+                    closeFile(i.writable, i.getParameter< O::CLOSE_FILE >());
+                    break;
+                case O::ADVANCE:
+                    advance(i.writable, i.getParameter< O::ADVANCE >());
                     break;
                 case O::OPEN_PATH:
-                    openPath(i.writable, i.parameter);
+                    openPath(i.writable, i.getParameter< O::OPEN_PATH >());
                     break;
                 case O::OPEN_DATASET:
-                    openDataset(i.writable, i.parameter);
+                    openDataset(i.writable, i.getParameter< O::OPEN_DATASET >());
                     break;
                 case O::DELETE_FILE:
-                    deleteFile(i.writable, i.parameter);
+                    deleteFile(i.writable, i.getParameter< O::DELETE_FILE >());
                     break;
                 case O::DELETE_PATH:
-                    deletePath(i.writable, i.parameter);
+                    deletePath(i.writable, i.getParameter< O::DELETE_PATH >());
                     break;
                 case O::DELETE_DATASET:
-                    deleteDataset(i.writable, i.parameter);
+                    deleteDataset(i.writable, i.getParameter< O::DELETE_DATASET >());
                     break;
                 case O::DELETE_ATT:
-                    deleteAttribute(i.writable, i.parameter);
+                    deleteAttribute(i.writable, i.getParameter< O::DELETE_ATT >());
                     break;
                 case O::WRITE_DATASET:
-                    writeDataset(i.writable, i.parameter);
+                    writeDataset(i.writable, i.getParameter< O::WRITE_DATASET >());
                     break;
                 case O::WRITE_ATT:
-                    writeAttribute(i.writable, i.parameter);
+                    writeAttribute(i.writable, i.getParameter< O::WRITE_ATT >());
+                    break;
+                case O::WRITE_ATTS:
+                    writeAttributes(i.writable, i.getParameter< O::WRITE_ATTS >());
                     break;
                 case O::READ_DATASET:
-                    readDataset(i.writable, i.parameter);
+                {
+                    auto& parameter = i.getParameter< O::READ_DATASET >();
+                    try
+                    {
+                        readDataset(i.writable, parameter);
+                        if( parameter.finish )
+                            parameter.finish();
+                    } catch( unsupported_data_error& )
+                    {
+                        if( parameter.done )
+                            parameter.done->set_exception(std::current_exception());
+                        throw;
+                    } catch( ... )
+                    {
+                        if( parameter.done )
+                            parameter.done->set_exception(std::current_exception());
+                        /* the failure has been handed to the reader, the read is not attempted again */
+                        work.pop();
+                        throw;
+                    }
+                    if( parameter.done )
+                        parameter.done->set_value();
+                    break;
+                }
+                case O::MAP_DATASET:
+                    mapDataset(i.writable, i.getParameter< O::MAP_DATASET >());
                     break;
                 case O::READ_ATT:
-                    readAttribute(i.writable, i.parameter);
+                    readAttribute(i.writable, i.getParameter< O::READ_ATT >());
+                    break;
+                case O::READ_ATTS:
+                    readAttributes(i.writable, i.getParameter< O::READ_ATTS >());
                     break;
                 case O::LIST_PATHS:
-                    listPaths(i.writable, i.parameter);
+                    listPaths(i.writable, i.getParameter< O::LIST_PATHS >());
                     break;
                 case O::LIST_DATASETS:
-                    listDatasets(i.writable, i.parameter);
+                    listDatasets(i.writable, i.getParameter< O::LIST_DATASETS >());
                     break;
                 case O::LIST_ATTS:
-                    listAttributes(i.writable, i.parameter);
+                    listAttributes(i.writable, i.getParameter< O::LIST_ATTS >());
                     break;
             }
         } catch (unsupported_data_error& e)
         {
-            (*m_handler).m_work.pop();
+            work.pop();
             throw e;
         }
-        (*m_handler).m_work.pop();
+        work.pop();
     }
-    return std::future< void >();
+    completeBatch();
+    batch.completed = true;
+
+    if( m_persistOnFlush && m_handler->accessType != AccessType::READ_ONLY )
+        for( hid_t file : m_openFileIDs )
+        {
+            herr_t status = H5Fflush(file, H5F_SCOPE_LOCAL);
+            ASSERT(status >= 0, "Internal error: Failed to flush HDF5 file");
+        }
 }
 
+void
+HDF5IOHandlerImpl::completeBatch()
+{ }
+
+void
+HDF5IOHandlerImpl::abortBatch()
+{ }
+
 void
 HDF5IOHandlerImpl::createFile(Writable* writable,
-                              ArgumentMap const& parameters)
+                              Parameter< Operation::CREATE_FILE > const& parameters)
 {
     if( !writable->written )
     {
@@ -179,12 +1027,13 @@ HDF5IOHandlerImpl::createFile(Writable* writable,
             create_directories(dir);
 
         /* Create a new file using current properties. */
-        std::string name = m_handler->directory + parameters.at("name").get< std::string >();
+        std::string name = m_handler->directory + parameters.name;
         if( !auxiliary::ends_with(name, ".h5") )
             name += ".h5";
+        awaitImages(name);
         hid_t id = H5Fcreate(name.c_str(),
                              H5F_ACC_TRUNC,
-                             H5P_DEFAULT,
+                             m_fileCreationProperty,
                              m_fileAccessProperty);
         ASSERT(id >= 0, "Internal error: Failed to create HDF5 file");
 
@@ -196,14 +1045,33 @@ HDF5IOHandlerImpl::createFile(Writable* writable,
     }
 }
 
+namespace
+{
+/** Remove the link name from group unless it refers to an object of type keep (e.g. in overwrite mode).
+ *
+ * @return  True if an object of type keep is linked as name.
+ */
+bool
+keepLinked(hid_t group, std::string const& name, H5O_type_t keep)
+{
+    if( H5Lexists(group, name.c_str(), H5P_DEFAULT) <= 0 )
+        return false;
+    if( h5_object_type(group, name.c_str()) == keep )
+        return true;
+    herr_t status = H5Ldelete(group, name.c_str(), H5P_DEFAULT);
+    ASSERT(status == 0, "Internal error: Failed to replace HDF5 object " + name);
+    return false;
+}
+} // namespace
+
 void
 HDF5IOHandlerImpl::createPath(Writable* writable,
-                              ArgumentMap const& parameters)
+                              Parameter< Operation::CREATE_PATH > const& parameters)
 {
     if( !writable->written )
     {
         /* Sanitize path */
-        std::string path = parameters.at("path").get< std::string >();
+        std::string path = parameters.path;
         if( auxiliary::starts_with(path, "/") )
             path = auxiliary::replace_first(path, "/", "");
         if( !auxiliary::ends_with(path, "/") )
@@ -226,11 +1094,17 @@ HDF5IOHandlerImpl::createPath(Writable* writable,
         groups.push(node_id);
         for( std::string const& folder : auxiliary::split(path, "/", false) )
         {
-            hid_t group_id = H5Gcreate(groups.top(),
-                                       folder.c_str(),
-                                       H5P_DEFAULT,
-                                       H5P_DEFAULT,
-                                       H5P_DEFAULT);
+            hid_t group_id;
+            if( m_handler->overwrite && keepLinked(groups.top(), folder, H5O_TYPE_GROUP) )
+                group_id = H5Gopen(groups.top(),
+                                   folder.c_str(),
+                                   H5P_DEFAULT);
+            else
+                group_id = H5Gcreate(groups.top(),
+                                     folder.c_str(),
+                                     H5P_DEFAULT,
+                                     m_groupCreationProperty,
+                                     H5P_DEFAULT);
             ASSERT(group_id >= 0, "Internal error: Failed to create HDF5 group during path creation");
             groups.push(group_id);
         }
@@ -245,19 +1119,20 @@ HDF5IOHandlerImpl::createPath(Writable* writable,
         }
 
         writable->written = true;
-        writable->abstractFilePosition = std::make_shared< HDF5FilePosition >(path);
+        writable->abstractFilePosition = make_h5_file_position(path, writable->parent);
 
         m_fileIDs[writable] = res->second;
+        releaseGroupListings(res->second);
     }
 }
 
 void
 HDF5IOHandlerImpl::createDataset(Writable* writable,
-                                 ArgumentMap const& parameters)
+                                 Parameter< Operation::CREATE_DATASET > const& parameters)
 {
     if( !writable->written )
     {
-        std::string name = parameters.at("name").get< std::string >();
+        std::string name = parameters.name;
         if( auxiliary::starts_with(name, "/") )
             name = auxiliary::replace_first(name, "/", "");
         if( auxiliary::ends_with(name, "/") )
@@ -273,7 +1148,7 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
                                 H5P_DEFAULT);
         ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset creation");
 
-        Datatype d = parameters.at("dtype").get< Datatype >();
+        Datatype d = parameters.dtype;
         if( d == Datatype::UNDEFINED )
         {
             // TODO handle unknown dtype
@@ -284,34 +1159,186 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
         a.dtype = d;
         std::vector< hsize_t > dims;
         std::vector< hsize_t > maxdims;
-        for( auto const& val : parameters.at("extent").get< Extent >() )
+        for( auto const& val : parameters.extent )
         {
             dims.push_back(static_cast< hsize_t >(val));
-            maxdims.push_back(H5S_UNLIMITED);
+            maxdims.push_back(parameters.fixedSize ? static_cast< hsize_t >(val) : H5S_UNLIMITED);
+        }
+
+        if( m_handler->overwrite )
+        {
+            /* a redefined component may still hold a handle of the dataset it replaces */
+            releaseDatasetHandle(writable);
+            if( reuseDataset(node_id, name, d, dims, parameters.fixedSize) )
+            {
+                herr_t status = H5Gclose(node_id);
+                ASSERT(status == 0, "Internal error: Failed to close HDF5 group during dataset creation");
+
+                writable->written = true;
+                writable->abstractFilePosition = make_h5_file_position(name, writable->parent);
+
+                m_fileIDs[writable] = res->second;
+                releaseGroupListings(res->second);
+                return;
+            }
         }
 
         hid_t space = H5Screate_simple(dims.size(), dims.data(), maxdims.data());
 
         std::vector< hsize_t > chunkDims;
-        for( auto const& val : parameters.at("chunkSize").get< Extent >() )
+        for( auto const& val : parameters.chunkSize )
             chunkDims.push_back(static_cast< hsize_t >(val));
 
-        /* enable chunking on the created dataspace */
+        /* only extendable and compressed datasets need chunks (and a chunk index),
+         * datasets of fixed size are stored contiguously, or in the object header if they are small */
         hid_t datasetCreationProperty = H5Pcreate(H5P_DATASET_CREATE);
         herr_t status;
-        status = H5Pset_chunk(datasetCreationProperty, chunkDims.size(), chunkDims.data());
-        ASSERT(status == 0, "Internal error: Failed to set chunk size during dataset creation");
+        H5D_layout_t layout = H5D_CHUNKED;
+        if( parameters.fixedSize && parameters.compression.empty() )
+        {
+            hsize_t bytes = toBytes(d);
+            for( auto const& val : dims )
+                bytes *= val;
+            layout = bytes <= compactDatasetBytes ? H5D_COMPACT : H5D_CONTIGUOUS;
+            status = H5Pset_layout(datasetCreationProperty, layout);
+            ASSERT(status == 0, "Internal error: Failed to set layout during dataset creation");
+        } else
+        {
+            status = H5Pset_chunk(datasetCreationProperty, chunkDims.size(), chunkDims.data());
+            ASSERT(status == 0, "Internal error: Failed to set chunk size during dataset creation");
+        }
+        applyAttributeStorage(datasetCreationProperty);
+
+        /* the dataset overrides the Series, which overrides the handler */
+        Allocation allocation = parameters.allocation;
+        if( allocation.time == AllocationTime::DEFAULT )
+            allocation.time = m_handler->allocation.time != AllocationTime::DEFAULT
+                              ? m_handler->allocation.time : m_defaultAllocation.time;
+        if( allocation.fill == FillTime::DEFAULT )
+            allocation.fill = m_handler->allocation.fill != FillTime::DEFAULT
+                              ? m_handler->allocation.fill : m_defaultAllocation.fill;
+        /* compact datasets are always allocated along with their object header */
+        switch( layout == H5D_COMPACT ? AllocationTime::DEFAULT : allocation.time )
+        {
+            case AllocationTime::EARLY:
+                status = H5Pset_alloc_time(datasetCreationProperty, H5D_ALLOC_TIME_EARLY);
+                break;
+            case AllocationTime::INCREMENTAL:
+                status = H5Pset_alloc_time(datasetCreationProperty, H5D_ALLOC_TIME_INCR);
+                break;
+            case AllocationTime::LATE:
+                status = H5Pset_alloc_time(datasetCreationProperty, H5D_ALLOC_TIME_LATE);
+                break;
+            case AllocationTime::DEFAULT:
+                break;
+        }
+        ASSERT(status >= 0, "Internal error: Failed to set allocation time during dataset creation");
+        if( allocation.fill != FillTime::DEFAULT )
+        {
+            status = H5Pset_fill_time(datasetCreationProperty,
+                                      allocation.fill == FillTime::NEVER ? H5D_FILL_TIME_NEVER : H5D_FILL_TIME_ALLOC);
+            ASSERT(status >= 0, "Internal error: Failed to set fill time during dataset creation");
+        }
 
-        std::string const& compression = parameters.at("compression").get< std::string >();
+        std::string const& compression = parameters.compression;
         if( !compression.empty() )
         {
             std::vector< std::string > args = auxiliary::split(compression, ":");
             std::string const& format = args[0];
+            auto setPlugin = [&](H5Z_filter_t filter, std::vector< unsigned int > const& cd_values)
+            {
+                if( H5Zfilter_avail(filter) > 0 )
+                {
+                    status = H5Pset_filter(datasetCreationProperty,
+                                           filter,
+                                           H5Z_FLAG_OPTIONAL,
+                                           cd_values.size(),
+                                           cd_values.data());
+                    ASSERT(status == 0, "Internal error: Failed to set " + format + " compression during dataset creation");
+                } else
+                    std::cerr << "HDF5 filter plugin for compression format " << format
+                              << " not found (see HDF5_PLUGIN_PATH). Data will not be compressed!"
+                              << std::endl;
+            };
             if( (format == "zlib" || format == "gzip" || format == "deflate")
                 && args.size() == 2 )
             {
                 status = H5Pset_deflate(datasetCreationProperty, std::stoi(args[1]));
                 ASSERT(status == 0, "Internal error: Failed to set deflate compression during dataset creation");
+            } else if( (auxiliary::starts_with(format, "blosc") || format == "lz4" || format == "zstd")
+                       && args.size() == 2 )
+            {
+                H5Z_filter_t filter;
+                std::vector< unsigned int > cd_values;
+                int const level = std::stoi(args[1]);
+                if( format == "lz4" )
+                {
+                    filter = H5Z_FILTER_LZ4;
+                    cd_values = {0u};   /* default block size */
+                } else if( format == "zstd" )
+                {
+                    filter = H5Z_FILTER_ZSTD;
+                    cd_values = {static_cast< unsigned int >(level)};
+                } else
+                {
+                    /* Blosc codes: blosclz, lz4, lz4hc, snappy, zlib, zstd */
+                    std::vector< std::string > const codecs{"blosclz", "lz4", "lz4hc", "snappy", "zlib", "zstd"};
+                    std::string const codec = format == "blosc" ? "lz4" : format.substr(std::string("blosc-").size());
+                    unsigned int code = std::find(codecs.begin(), codecs.end(), codec) - codecs.begin();
+                    filter = H5Z_FILTER_BLOSC;
+                    /* the first four values are filled by the filter itself, then level, byte-shuffle, compressor */
+                    cd_values = {0u, 0u, 0u, 0u, static_cast< unsigned int >(level), 1u, code};
+                }
+
+                setPlugin(filter, cd_values);
+            } else if( (format == "zfp" || format == "sz") && args.size() == 3 )
+            {
+                std::string const& mode = args[1];
+                double const parameter = std::stod(args[2]);
+                /* doubles are passed as two unsigned ints, in memory order for ZFP and most significant half first for SZ */
+                unsigned int halves[2];
+                static_assert(sizeof(halves) == sizeof(double), "Filter parameters hold a double in two unsigned ints");
+                std::memcpy(halves, &parameter, sizeof(double));
+                uint64_t bits;
+                std::memcpy(&bits, &parameter, sizeof(double));
+                unsigned int const high = static_cast< unsigned int >(bits >> 32);
+                unsigned int const low = static_cast< unsigned int >(bits & 0xffffffffu);
+
+                if( d != Datatype::FLOAT && d != Datatype::DOUBLE )
+                    std::cerr << "Lossy compression format " << format
+                              << " only applies to floating point datasets. Data will not be compressed!"
+                              << std::endl;
+                else if( format == "zfp" )
+                {
+                    /* generic interface of H5Z-ZFP: mode, unused, mode parameter */
+                    if( mode == "rate" )
+                        setPlugin(H5Z_FILTER_ZFP, {1u, 0u, halves[0], halves[1]});
+                    else if( mode == "precision" )
+                        setPlugin(H5Z_FILTER_ZFP, {2u, 0u, static_cast< unsigned int >(parameter)});
+                    else
+                        setPlugin(H5Z_FILTER_ZFP, {3u, 0u, halves[0], halves[1]});
+                } else
+                {
+                    /* error configuration of H5Z-SZ: mode, then absolute, relative, point-wise relative bound and PSNR */
+                    std::vector< unsigned int > cd_values(9, 0u);
+                    if( mode == "abs" )
+                    {
+                        cd_values[0] = 0u;
+                        cd_values[1] = high;
+                        cd_values[2] = low;
+                    } else if( mode == "rel" )
+                    {
+                        cd_values[0] = 1u;
+                        cd_values[3] = high;
+                        cd_values[4] = low;
+                    } else
+                    {
+                        cd_values[0] = 10u;
+                        cd_values[5] = high;
+                        cd_values[6] = low;
+                    }
+                    setPlugin(H5Z_FILTER_SZ, cd_values);
+                }
             } else if( format == "szip" || format == "nbit" || format == "scaleoffset" )
                 std::cerr << "Compression format " << format
                           << " not yet implemented. Data will not be compressed!"
@@ -322,13 +1349,12 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
                           << std::endl;
         }
 
-        std::string const& transform = parameters.at("transform").get< std::string >();
+        std::string const& transform = parameters.transform;
         if( !transform.empty() )
             std::cerr << "Custom transform not yet implemented in HDF5 backend."
                       << std::endl;
 
-        hid_t datatype = getH5DataType(a);
-        ASSERT(datatype >= 0, "Internal error: Failed to get HDF5 datatype during dataset creation");
+        hid_t datatype = memoryType(a.dtype);
         hid_t group_id = H5Dcreate(node_id,
                                    name.c_str(),
                                    datatype,
@@ -336,12 +1362,18 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
                                    H5P_DEFAULT,
                                    datasetCreationProperty,
                                    H5P_DEFAULT);
+        /* e.g. parallel HDF5 may not support the requested allocation time */
+        if( group_id < 0 && layout != H5D_COMPACT && allocation.time != AllocationTime::DEFAULT )
+        {
+            H5Pclose(datasetCreationProperty);
+            H5Sclose(space);
+            H5Gclose(node_id);
+            throw std::runtime_error("Failed to create HDF5 dataset " + name + " with the requested allocation time");
+        }
         ASSERT(group_id >= 0, "Internal error: Failed to create HDF5 group during dataset creation");
 
         status = H5Dclose(group_id);
         ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset during dataset creation");
-        status = H5Tclose(datatype);
-        ASSERT(status == 0, "Internal error: Failed to close HDF5 datatype during dataset creation");
         status = H5Pclose(datasetCreationProperty);
         ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset creation property during dataset creation");
         status = H5Sclose(space);
@@ -350,55 +1382,111 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
         ASSERT(status == 0, "Internal error: Failed to close HDF5 group during dataset creation");
 
         writable->written = true;
-        writable->abstractFilePosition = std::make_shared< HDF5FilePosition >(name);
+        writable->abstractFilePosition = make_h5_file_position(name, writable->parent);
 
         m_fileIDs[writable] = res->second;
+        releaseGroupListings(res->second);
+    }
+}
+
+bool
+HDF5IOHandlerImpl::reuseDataset(hid_t group, std::string const& name, Datatype dtype, std::vector< hsize_t > const& dims,
+                                bool fixedSize)
+{
+    if( !keepLinked(group, name, H5O_TYPE_DATASET) )
+        return false;
+
+    hid_t dataset_id = H5Dopen(group, name.c_str(), H5P_DEFAULT);
+    ASSERT(dataset_id >= 0, "Internal error: Failed to open HDF5 dataset " + name + " for reuse");
+    hid_t stored_type = H5Dget_type(dataset_id);
+    ASSERT(stored_type >= 0, "Internal error: Failed to get HDF5 datatype of dataset " + name);
+    hid_t file_space = H5Dget_space(dataset_id);
+    ASSERT(file_space >= 0, "Internal error: Failed to get HDF5 dataset file space of " + name);
+
+    /* extendable datasets created by this API are chunked without a maximum extent, so any extent of the same rank fits,
+     * datasets of fixed size are only reused as they are */
+    bool compatible = H5Tequal(stored_type, memoryType(dtype)) > 0 &&
+                      H5Sget_simple_extent_ndims(file_space) == static_cast< int >(dims.size());
+    herr_t status;
+    if( compatible )
+    {
+        std::vector< hsize_t > stored(dims.size());
+        std::vector< hsize_t > maxdims(dims.size());
+        H5Sget_simple_extent_dims(file_space, stored.data(), maxdims.data());
+        if( fixedSize )
+            compatible = maxdims == dims;
+        else
+            compatible = std::all_of(maxdims.begin(), maxdims.end(), [](hsize_t m){ return m == H5S_UNLIMITED; });
+        if( compatible && stored != dims )
+        {
+            status = H5Dset_extent(dataset_id, dims.data());
+            ASSERT(status == 0, "Internal error: Failed to set the extent of reused HDF5 dataset " + name);
+        }
+    }
+
+    status = H5Sclose(file_space);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset file space of " + name);
+    status = H5Tclose(stored_type);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 datatype of dataset " + name);
+    status = H5Dclose(dataset_id);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset " + name);
+
+    if( !compatible )
+    {
+        status = H5Ldelete(group, name.c_str(), H5P_DEFAULT);
+        ASSERT(status == 0, "Internal error: Failed to replace HDF5 dataset " + name);
     }
+    return compatible;
 }
 
 void
 HDF5IOHandlerImpl::extendDataset(Writable* writable,
-                                 ArgumentMap const& parameters)
+                                 Parameter< Operation::EXTEND_DATASET > const& parameters)
 {
     if( !writable->written )
         throw std::runtime_error("Extending an unwritten Dataset is not possible.");
 
-    auto res = m_fileIDs.find(writable->parent);
-    hid_t node_id, dataset_id;
-    node_id = H5Gopen(res->second,
-                      concrete_h5_file_position(writable->parent).c_str(),
-                      H5P_DEFAULT);
-    ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset extension");
+    /* the cached file space does not reflect the new extent */
+    releaseDatasetHandle(writable);
 
-    /* Sanitize name */
-    std::string name = parameters.at("name").get< std::string >();
-    if( auxiliary::starts_with(name, "/") )
-        name = auxiliary::replace_first(name, "/", "");
-    if( !auxiliary::ends_with(name, "/") )
-        name += '/';
+    auto res = m_fileIDs.find(writable);
+    if( res == m_fileIDs.end() )
+        res = m_fileIDs.find(writable->parent);
 
-    dataset_id = H5Dopen(node_id,
-                         name.c_str(),
-                         H5P_DEFAULT);
+    /* the dataset is located by its file position,
+     * the name of scalar record components is not part of the path */
+    hid_t dataset_id = H5Dopen(res->second,
+                               concrete_h5_file_position(writable).c_str(),
+                               H5P_DEFAULT);
     ASSERT(dataset_id >= 0, "Internal error: Failed to open HDF5 dataset during dataset extension");
 
     std::vector< hsize_t > size;
-    for( auto const& val : parameters.at("extent").get< Extent >() )
+    for( auto const& val : parameters.extent )
         size.push_back(static_cast< hsize_t >(val));
 
     herr_t status;
+    hid_t space = H5Dget_space(dataset_id);
+    std::vector< hsize_t > maxdims(size.size());
+    H5Sget_simple_extent_dims(space, nullptr, maxdims.data());
+    status = H5Sclose(space);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataspace during dataset extension");
+    for( std::size_t i = 0; i < size.size(); ++i )
+        if( size[i] > maxdims[i] )
+        {
+            H5Dclose(dataset_id);
+            throw std::runtime_error("Dataset " + concrete_h5_file_position(writable) + " has a fixed size and can not be extended");
+        }
+
     status = H5Dset_extent(dataset_id, size.data());
     ASSERT(status == 0, "Internal error: Failed to extend HDF5 dataset during dataset extension");
 
     status = H5Dclose(dataset_id);
     ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset during dataset extension");
-    status = H5Gclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close HDF5 group during dataset extension");
 }
 
 void
 HDF5IOHandlerImpl::openFile(Writable* writable,
-                            ArgumentMap const& parameters)
+                            Parameter< Operation::OPEN_FILE > const& parameters)
 {
     //TODO check if file already open
     //not possible with current implementation
@@ -408,7 +1496,7 @@ HDF5IOHandlerImpl::openFile(Writable* writable,
     if( !exists(dir) )
         throw no_such_file_error("Supplied directory is not valid: " + m_handler->directory);
 
-    std::string name = m_handler->directory + parameters.at("name").get< std::string >();
+    std::string name = m_handler->directory + parameters.name;
     if( !auxiliary::ends_with(name, ".h5") )
         name += ".h5";
 
@@ -420,6 +1508,7 @@ HDF5IOHandlerImpl::openFile(Writable* writable,
         flags = H5F_ACC_RDWR;
     else
         throw std::runtime_error("Unknown file AccessType");
+    awaitImages(name);
     hid_t file_id;
     file_id = H5Fopen(name.c_str(),
                       flags,
@@ -433,11 +1522,57 @@ HDF5IOHandlerImpl::openFile(Writable* writable,
     m_fileIDs.erase(writable);
     m_fileIDs.insert({writable, file_id});
     m_openFileIDs.insert(file_id);
+
+    if( m_metadataSnapshots && at == AccessType::READ_ONLY )
+        openSnapshot(file_id, name);
+}
+
+void
+HDF5IOHandlerImpl::closeFile(Writable* writable,
+                             Parameter< Operation::CLOSE_FILE > const&)
+{
+    auto res = m_fileIDs.find(writable);
+    if( res == m_fileIDs.end() )
+        throw std::runtime_error("Closing a file that has not been opened is not possible.");
+    hid_t file_id = res->second;
+
+    releaseDatasetHandles(file_id);
+    releaseGroupListings(file_id);
+    auto snapshot = m_fileSnapshots.find(file_id);
+    if( snapshot != m_fileSnapshots.end() )
+    {
+        if( snapshot->second->dirty )
+            saveSnapshot(*snapshot->second);
+        m_fileSnapshots.erase(snapshot);
+    }
+    if( m_persistThreads > 0 && m_handler->accessType != AccessType::READ_ONLY )
+        persistImage(file_id);
+
+    herr_t status = H5Fclose(file_id);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 file");
+    m_openFileIDs.erase(file_id);
+
+    /* forget all objects that reside in this file */
+    for( auto it = m_fileIDs.begin(); it != m_fileIDs.end(); )
+    {
+        if( it->second == file_id )
+            it = m_fileIDs.erase(it);
+        else
+            ++it;
+    }
+}
+
+void
+HDF5IOHandlerImpl::advance(Writable*,
+                           Parameter< Operation::ADVANCE > & parameters)
+{
+    /* files are not streams, all data is available right away */
+    *parameters.status = AdvanceStatus::OVER;
 }
 
 void
 HDF5IOHandlerImpl::openPath(Writable* writable,
-                            ArgumentMap const& parameters)
+                            Parameter< Operation::OPEN_PATH > const& parameters)
 {
     auto res = m_fileIDs.find(writable->parent);
     hid_t node_id, path_id;
@@ -447,7 +1582,7 @@ HDF5IOHandlerImpl::openPath(Writable* writable,
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during path opening");
 
     /* Sanitize path */
-    std::string path = parameters.at("path").get< std::string >();
+    std::string path = parameters.path;
     if( auxiliary::starts_with(path, "/") )
         path = auxiliary::replace_first(path, "/", "");
     if( !auxiliary::ends_with(path, "/") )
@@ -465,7 +1600,7 @@ HDF5IOHandlerImpl::openPath(Writable* writable,
     ASSERT(status == 0, "Internal error: Failed to close HDF5 group during path opening");
 
     writable->written = true;
-    writable->abstractFilePosition = std::make_shared< HDF5FilePosition >(path);
+    writable->abstractFilePosition = make_h5_file_position(path, writable->parent);
 
     m_fileIDs.erase(writable);
     m_fileIDs.insert({writable, res->second});
@@ -473,7 +1608,7 @@ HDF5IOHandlerImpl::openPath(Writable* writable,
 
 void
 HDF5IOHandlerImpl::openDataset(Writable* writable,
-                               std::map< std::string, ParameterArgument > & parameters)
+                               Parameter< Operation::OPEN_DATASET > & parameters)
 {
     auto res = m_fileIDs.find(writable->parent);
     hid_t node_id, dataset_id;
@@ -483,7 +1618,7 @@ HDF5IOHandlerImpl::openDataset(Writable* writable,
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset opening");
 
     /* Sanitize name */
-    std::string name = parameters.at("name").get< std::string >();
+    std::string name = parameters.name;
     if( auxiliary::starts_with(name, "/") )
         name = auxiliary::replace_first(name, "/", "");
     if( !auxiliary::ends_with(name, "/") )
@@ -531,7 +1666,7 @@ HDF5IOHandlerImpl::openDataset(Writable* writable,
     } else
         throw std::runtime_error("Unsupported dataset class");
 
-    auto dtype = parameters.at("dtype").get< std::shared_ptr< Datatype > >();
+    auto dtype = parameters.dtype;
     *dtype = d;
 
     int ndims = H5Sget_simple_extent_ndims(dataset_space);
@@ -544,10 +1679,22 @@ HDF5IOHandlerImpl::openDataset(Writable* writable,
     Extent e;
     for( auto const& val : dims )
         e.push_back(val);
-    auto extent = parameters.at("extent").get< std::shared_ptr< Extent > >();
+    auto extent = parameters.extent;
     *extent = e;
 
     herr_t status;
+    hid_t dataset_cpl = H5Dget_create_plist(dataset_id);
+    ASSERT(dataset_cpl >= 0, "Internal error: Failed to obtain HDF5 dataset creation property list during dataset opening");
+    parameters.chunkSize->clear();
+    if( H5Pget_layout(dataset_cpl) == H5D_CHUNKED )
+    {
+        std::vector< hsize_t > chunk_dims(ndims, 0);
+        H5Pget_chunk(dataset_cpl, ndims, chunk_dims.data());
+        for( auto const& val : chunk_dims )
+            parameters.chunkSize->push_back(val);
+    }
+    status = H5Pclose(dataset_cpl);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset creation property list during dataset opening");
     status = H5Sclose(dataset_space);
     ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset space during dataset opening");
     status = H5Tclose(dataset_type);
@@ -558,38 +1705,43 @@ HDF5IOHandlerImpl::openDataset(Writable* writable,
     ASSERT(status == 0, "Internal error: Failed to close HDF5 group during dataset opening");
 
     writable->written = true;
-    writable->abstractFilePosition = std::make_shared< HDF5FilePosition >(name);
+    writable->abstractFilePosition = make_h5_file_position(name, writable->parent);
 
     m_fileIDs[writable] = res->second;
 }
 
 void
 HDF5IOHandlerImpl::deleteFile(Writable* writable,
-                              ArgumentMap const& parameters)
+                              Parameter< Operation::DELETE_FILE > const& parameters)
 {
     if( m_handler->accessType == AccessType::READ_ONLY )
         throw std::runtime_error("Deleting a file opened as read only is not possible.");
 
     if( writable->written )
     {
+        releaseDatasetHandles();
+
         hid_t file_id = m_fileIDs[writable];
         herr_t status = H5Fclose(file_id);
         ASSERT(status == 0, "Internal error: Failed to close HDF5 file during file deletion");
 
-        std::string name = m_handler->directory + parameters.at("name").get< std::string >();
+        std::string name = m_handler->directory + parameters.name;
         if( !auxiliary::ends_with(name, ".h5") )
             name += ".h5";
+        awaitImages(name);
 
         using namespace boost::filesystem;
         path file(name);
-        if( !exists(file) )
+        /* without backing store, a file that has not been closed before only existed in memory */
+        if( exists(file) )
+            remove(file);
+        else if( m_persistThreads == 0 )
             throw std::runtime_error("File does not exist: " + name);
 
-        remove(file);
-
         writable->written = false;
         writable->abstractFilePosition.reset();
 
+        releaseGroupListings(file_id);
         m_openFileIDs.erase(file_id);
         m_fileIDs.erase(writable);
     }
@@ -597,7 +1749,7 @@ HDF5IOHandlerImpl::deleteFile(Writable* writable,
 
 void
 HDF5IOHandlerImpl::deletePath(Writable* writable,
-                              ArgumentMap const& parameters)
+                              Parameter< Operation::DELETE_PATH > const& parameters)
 {
     if( m_handler->accessType == AccessType::READ_ONLY )
         throw std::runtime_error("Deleting a path in a file opened as read only is not possible.");
@@ -605,12 +1757,15 @@ HDF5IOHandlerImpl::deletePath(Writable* writable,
     if( writable->written )
     {
         /* Sanitize path */
-        std::string path = parameters.at("path").get< std::string >();
+        std::string path = parameters.path;
         if( auxiliary::starts_with(path, "/") )
             path = auxiliary::replace_first(path, "/", "");
         if( !auxiliary::ends_with(path, "/") )
             path += '/';
 
+        /* datasets below the path are not tracked individually */
+        releaseDatasetHandles();
+
         /* Open H5Object to delete in
          * Ugly hack: H5Ldelete can't delete "."
          *            Work around this by deleting from the parent
@@ -623,11 +1778,12 @@ HDF5IOHandlerImpl::deletePath(Writable* writable,
                                 H5P_DEFAULT);
         ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during path deletion");
 
-        path += static_cast< HDF5FilePosition* >(writable->abstractFilePosition.get())->location;
+        path += static_cast< HDF5FilePosition* >(writable->abstractFilePosition.get())->location();
         herr_t status = H5Ldelete(node_id,
                                   path.c_str(),
                                   H5P_DEFAULT);
         ASSERT(status == 0, "Internal error: Failed to delete HDF5 group");
+        releaseGroupListings(res->second);
 
         status = H5Gclose(node_id);
         ASSERT(status == 0, "Internal error: Failed to close HDF5 group during path deletion");
@@ -641,7 +1797,7 @@ HDF5IOHandlerImpl::deletePath(Writable* writable,
 
 void
 HDF5IOHandlerImpl::deleteDataset(Writable* writable,
-                                 ArgumentMap const& parameters)
+                                 Parameter< Operation::DELETE_DATASET > const& parameters)
 {
     if( m_handler->accessType == AccessType::READ_ONLY )
         throw std::runtime_error("Deleting a path in a file opened as read only is not possible.");
@@ -649,12 +1805,14 @@ HDF5IOHandlerImpl::deleteDataset(Writable* writable,
     if( writable->written )
     {
         /* Sanitize name */
-        std::string name = parameters.at("name").get< std::string >();
+        std::string name = parameters.name;
         if( auxiliary::starts_with(name, "/") )
             name = auxiliary::replace_first(name, "/", "");
         if( !auxiliary::ends_with(name, "/") )
             name += '/';
 
+        releaseDatasetHandle(writable);
+
         /* Open H5Object to delete in
          * Ugly hack: H5Ldelete can't delete "."
          *            Work around this by deleting from the parent
@@ -667,11 +1825,12 @@ HDF5IOHandlerImpl::deleteDataset(Writable* writable,
                                 H5P_DEFAULT);
         ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset deletion");
 
-        name += static_cast< HDF5FilePosition* >(writable->abstractFilePosition.get())->location;
+        name += static_cast< HDF5FilePosition* >(writable->abstractFilePosition.get())->location();
         herr_t status = H5Ldelete(node_id,
                                   name.c_str(),
                                   H5P_DEFAULT);
         ASSERT(status == 0, "Internal error: Failed to delete HDF5 group");
+        releaseGroupListings(res->second);
 
         status = H5Gclose(node_id);
         ASSERT(status == 0, "Internal error: Failed to close HDF5 group during dataset deletion");
@@ -685,14 +1844,14 @@ HDF5IOHandlerImpl::deleteDataset(Writable* writable,
 
 void
 HDF5IOHandlerImpl::deleteAttribute(Writable* writable,
-                                   ArgumentMap const& parameters)
+                                   Parameter< Operation::DELETE_ATT > const& parameters)
 {
     if( m_handler->accessType == AccessType::READ_ONLY )
         throw std::runtime_error("Deleting an attribute in a file opened as read only is not possible.");
 
     if( writable->written )
     {
-        std::string name = parameters.at("name").get< std::string >();
+        std::string name = parameters.name;
 
         /* Open H5Object to delete in */
         auto res = m_fileIDs.find(writable);
@@ -712,31 +1871,276 @@ HDF5IOHandlerImpl::deleteAttribute(Writable* writable,
     }
 }
 
+namespace
+{
+/** Memory space of numPoints values found every stride values, e.g. one member of an array of structs. */
+hid_t
+stridedMemorySpace(hsize_t numPoints, hsize_t stride)
+{
+    hsize_t dims = numPoints == 0 ? 0 : (numPoints - 1) * stride + 1;
+    hid_t memspace = H5Screate_simple(1, &dims, nullptr);
+    ASSERT(memspace >= 0, "Internal error: Failed to create strided memory space");
+    if( numPoints != 0 && stride != 1 )
+    {
+        hsize_t start = 0;
+        herr_t status = H5Sselect_hyperslab(memspace, H5S_SELECT_SET, &start, &stride, &numPoints, nullptr);
+        ASSERT(status == 0, "Internal error: Failed to select strided memory space");
+    }
+    return memspace;
+}
+
+#if openPMD_HAVE_HDF5_ZLIB && H5_VERSION_GE(1, 10, 3)
+/** Chunks of a deflate-compressed dataset covered by a region aligned to them. */
+struct DeflateChunks
+{
+    std::vector< hsize_t > chunk;   /* shape of the chunks of the dataset */
+    std::vector< hsize_t > count;   /* number of chunks along each dimension of the region */
+    std::size_t number;
+    std::size_t elementBytes;
+    std::size_t chunkBytes;
+    int level;
+
+    /** Index of chunk i of the region along each dimension, relative to the first one. */
+    std::vector< hsize_t > coordinates(std::size_t i) const
+    {
+        std::vector< hsize_t > c(count.size());
+        for( std::size_t d = count.size(); d-- > 0; )
+        {
+            c[d] = i % count[d];
+            i /= count[d];
+        }
+        return c;
+    }
+};
+
+/** @return False if the dataset is not compressed only with deflate, the region is not aligned to its chunks
+ *          (except where it ends with the dataset) or the file type differs from memoryType.
+ */
+bool
+deflateChunks(hid_t dataset, hid_t filespace, hid_t memoryType,
+              Offset const& offset, Extent const& extent, DeflateChunks& chunks)
+{
+    int const rank = H5Sget_simple_extent_ndims(filespace);
+    if( rank <= 0 || static_cast< std::size_t >(rank) != extent.size() )
+        return false;
+    std::vector< hsize_t > dims(rank);
+    H5Sget_simple_extent_dims(filespace, dims.data(), nullptr);
+
+    hid_t fileType = H5Dget_type(dataset);
+    bool const sameType = H5Tequal(fileType, memoryType) > 0;
+    herr_t status = H5Tclose(fileType);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 datatype");
+    if( !sameType )
+        return false;
+
+    hid_t creation = H5Dget_create_plist(dataset);
+    ASSERT(creation >= 0, "Internal error: Failed to get HDF5 dataset creation property");
+    bool deflate = H5Pget_layout(creation) == H5D_CHUNKED && H5Pget_nfilters(creation) == 1;
+    unsigned int level = 0;
+    chunks.chunk.resize(rank);
+    if( deflate )
+    {
+        unsigned int flags;
+        std::size_t numValues = 1;
+        unsigned int config;
+        deflate = H5Pget_filter2(creation, 0, &flags, &numValues, &level, 0, nullptr, &config) == H5Z_FILTER_DEFLATE
+                  && H5Pget_chunk(creation, rank, chunks.chunk.data()) == rank;
+    }
+    status = H5Pclose(creation);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset creation property");
+    if( !deflate )
+        return false;
+
+    chunks.count.resize(rank);
+    chunks.number = 1;
+    chunks.elementBytes = H5Tget_size(memoryType);
+    chunks.chunkBytes = chunks.elementBytes;
+    chunks.level = static_cast< int >(level);
+    for( int d = 0; d < rank; ++d )
+    {
+        hsize_t const c = chunks.chunk[d];
+        if( extent[d] == 0 || offset[d] % c != 0 || (extent[d] % c != 0 && offset[d] + extent[d] != dims[d]) )
+            return false;
+        chunks.count[d] = (extent[d] + c - 1) / c;
+        chunks.number *= chunks.count[d];
+        chunks.chunkBytes *= c;
+    }
+    return true;
+}
+
+/** Copy a box of shape box from src (row-major of shape srcDims, box at srcStart) into dst (shape dstDims, box at dstStart). */
+void
+copyBox(char* dst, std::vector< hsize_t > const& dstDims, std::vector< hsize_t > const& dstStart,
+        char const* src, std::vector< hsize_t > const& srcDims, std::vector< hsize_t > const& srcStart,
+        std::vector< hsize_t > const& box, std::size_t elementBytes)
+{
+    std::size_t const rank = box.size();
+    std::size_t const row = box[rank - 1] * elementBytes;
+    std::vector< hsize_t > index(rank, 0);
+    while( true )
+    {
+        std::size_t s = 0;
+        std::size_t d = 0;
+        for( std::size_t k = 0; k < rank; ++k )
+        {
+            s = s * srcDims[k] + srcStart[k] + index[k];
+            d = d * dstDims[k] + dstStart[k] + index[k];
+        }
+        std::memcpy(dst + d * elementBytes, src + s * elementBytes, row);
+
+        /* next row, the last dimension is copied as a whole */
+        std::size_t k = rank - 1;
+        for( ; k > 0; --k )
+        {
+            if( ++index[k - 1] < box[k - 1] )
+                break;
+            index[k - 1] = 0;
+        }
+        if( k == 0 )
+            return;
+    }
+}
+
+/** Run work(i) for all i < n on threads and io(i) on the calling thread in increasing order of i,
+ *  with at most window items between the two at any time.
+ *
+ * @param   ioFirst     io(i) precedes work(i) (e.g. reading a chunk before decompressing it), otherwise it follows.
+ */
+void
+pipeline(std::size_t n, unsigned int threads, std::size_t window, bool ioFirst,
+         std::function< void(std::size_t) > const& io, std::function< void(std::size_t) > const& work)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector< char > worked(n, 0);
+    std::size_t claimed = 0;
+    std::size_t ioDone = 0;
+    std::size_t workDone = 0;
+    std::exception_ptr error;
+
+    auto worker = [&]()
+    {
+        std::unique_lock< std::mutex > lock(mutex);
+        while( true )
+        {
+            cv.wait(lock, [&]{ return error || claimed == n || (ioFirst ? claimed < ioDone : claimed < ioDone + window); });
+            if( error || claimed == n )
+                return;
+            std::size_t const i = claimed++;
+            lock.unlock();
+            try
+            {
+                work(i);
+            } catch( ... )
+            {
+                lock.lock();
+                error = std::current_exception();
+                cv.notify_all();
+                return;
+            }
+            lock.lock();
+            worked[i] = 1;
+            ++workDone;
+            cv.notify_all();
+        }
+    };
+    std::vector< std::thread > pool;
+    for( unsigned int t = 0; t < std::min< std::size_t >(threads, n); ++t )
+        pool.emplace_back(worker);
+
+    try
+    {
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+                cv.wait(lock, [&]{ return error || (ioFirst ? i < workDone + window : worked[i] != 0); });
+                if( error )
+                    break;
+            }
+            io(i);
+            std::lock_guard< std::mutex > lock(mutex);
+            ++ioDone;
+            cv.notify_all();
+        }
+    } catch( ... )
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+        error = std::current_exception();
+        cv.notify_all();
+    }
+    for( auto& t : pool )
+        t.join();
+    if( error )
+        std::rethrow_exception(error);
+}
+#endif
+} // namespace
+
 void
 HDF5IOHandlerImpl::writeDataset(Writable* writable,
-                                ArgumentMap const& parameters)
+                                Parameter< Operation::WRITE_DATASET > const& parameters)
+{
+    writeChunk(writable, parameters, m_datasetTransferProperty);
+}
+
+void
+HDF5IOHandlerImpl::writeChunk(Writable* writable,
+                              Parameter< Operation::WRITE_DATASET > const& parameters,
+                              hid_t transferProperty)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
 
-    hid_t dataset_id, filespace, memspace;
+    DatasetHandle& handle = datasetHandle(writable, res->second, &parameters.chunkCache);
+    writeChunk(handle.dataset, handle.dataspace, parameters, transferProperty);
+
+    m_fileIDs[writable] = res->second;
+}
+
+void
+HDF5IOHandlerImpl::writeChunk(hid_t dataset_id,
+                              hid_t filespace,
+                              Parameter< Operation::WRITE_DATASET > const& parameters,
+                              hid_t transferProperty)
+{
+    hid_t memspace;
     herr_t status;
-    dataset_id = H5Dopen(res->second,
-                         concrete_h5_file_position(writable).c_str(),
-                         H5P_DEFAULT);
-    ASSERT(dataset_id >= 0, "Internal error: Failed to open HDF5 dataset during dataset write");
+
+    if( m_filterThreads > 0 && parameters.memoryExtent.empty() && parameters.memoryStride == 1
+        && writeChunksDirect(dataset_id, memoryType(parameters.dtype), parameters.offset, parameters.extent, parameters.data.get()) )
+        return;
 
     std::vector< hsize_t > start;
-    for( auto const& val : parameters.at("offset").get< Offset >() )
+    for( auto const& val : parameters.offset )
         start.push_back(static_cast< hsize_t >(val));
     std::vector< hsize_t > stride(start.size(), 1); /* contiguous region */
     std::vector< hsize_t > count(start.size(), 1); /* single region */
     std::vector< hsize_t > block;
-    for( auto const& val : parameters.at("extent").get< Extent >() )
+    hsize_t numPoints = 1;
+    for( auto const& val : parameters.extent )
+    {
         block.push_back(static_cast< hsize_t >(val));
-    memspace = H5Screate_simple(block.size(), block.data(), nullptr);
-    filespace = H5Dget_space(dataset_id);
+        numPoints *= static_cast< hsize_t >(val);
+    }
+    /* HDF5 gathers members of an array of structs or parts of a larger buffer itself */
+    if( !parameters.memoryExtent.empty() )
+    {
+        std::vector< hsize_t > dims(parameters.memoryExtent.begin(), parameters.memoryExtent.end());
+        std::vector< hsize_t > memoryStart(parameters.memoryOffset.begin(), parameters.memoryOffset.end());
+        memspace = H5Screate_simple(dims.size(), dims.data(), nullptr);
+        status = H5Sselect_hyperslab(memspace,
+                                     H5S_SELECT_SET,
+                                     memoryStart.data(),
+                                     stride.data(),
+                                     count.data(),
+                                     block.data());
+        ASSERT(status == 0, "Internal error: Failed to select memory hyperslab during dataset write");
+    } else if( parameters.memoryStride != 1 )
+        memspace = stridedMemorySpace(numPoints, parameters.memoryStride);
+    else
+        memspace = H5Screate_simple(block.size(), block.data(), nullptr);
     status = H5Sselect_hyperslab(filespace,
                                  H5S_SELECT_SET,
                                  start.data(),
@@ -745,75 +2149,244 @@ HDF5IOHandlerImpl::writeDataset(Writable* writable,
                                  block.data());
     ASSERT(status == 0, "Internal error: Failed to select hyperslab during dataset write");
 
-    std::shared_ptr< void > data = parameters.at("data").get< std::shared_ptr< void > >();
+    std::shared_ptr< void > const& data = parameters.data;
 
-    Attribute a(0);
-    a.dtype = parameters.at("dtype").get< Datatype >();
-    hid_t dataType = getH5DataType(a);
-    ASSERT(dataType >= 0, "Internal error: Failed to get HDF5 datatype during dataset write");
-    switch( a.dtype )
-    {
-        using DT = Datatype;
-        case DT::DOUBLE:
-        case DT::FLOAT:
-        case DT::INT16:
-        case DT::INT32:
-        case DT::INT64:
-        case DT::UINT16:
-        case DT::UINT32:
-        case DT::UINT64:
-        case DT::CHAR:
-        case DT::UCHAR:
-        case DT::BOOL:
-            status = H5Dwrite(dataset_id,
-                              dataType,
-                              memspace,
-                              filespace,
-                              m_datasetTransferProperty,
-                              data.get());
-            ASSERT(status == 0, "Internal error: Failed to write dataset " + concrete_h5_file_position(writable));
-            break;
-        case DT::UNDEFINED:
-            throw std::runtime_error("Unknown Attribute datatype");
-        case DT::DATATYPE:
-            throw std::runtime_error("Meta-Datatype leaked into IO");
-        default:
-            throw std::runtime_error("Datatype not implemented in HDF5 IO");
-    }
-    status = H5Tclose(dataType);
-    ASSERT(status == 0, "Internal error: Failed to close dataset datatype during dataset write");
-    status = H5Sclose(filespace);
-    ASSERT(status == 0, "Internal error: Failed to close dataset file space during dataset write");
+    hid_t dataType = memoryType(parameters.dtype);
+    status = H5Dwrite(dataset_id,
+                      dataType,
+                      memspace,
+                      filespace,
+                      transferProperty,
+                      data.get());
+    ASSERT(status == 0, "Internal error: Failed to write dataset");
     status = H5Sclose(memspace);
     ASSERT(status == 0, "Internal error: Failed to close dataset memory space during dataset write");
-    status = H5Dclose(dataset_id);
-    ASSERT(status == 0, "Internal error: Failed to close dataset " + concrete_h5_file_position(writable) + " during dataset write");
+}
+
+bool
+HDF5IOHandlerImpl::writeChunksDirect(hid_t dataset, hid_t memoryType,
+                                     Offset const& offset, Extent const& extent, void const* data)
+{
+#if openPMD_HAVE_HDF5_ZLIB && H5_VERSION_GE(1, 10, 3)
+    hid_t filespace = H5Dget_space(dataset);
+    DeflateChunks chunks;
+    bool const direct = deflateChunks(dataset, filespace, memoryType, offset, extent, chunks);
+    herr_t status = H5Sclose(filespace);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataspace during dataset write");
+    if( !direct )
+        return false;
+
+    std::vector< hsize_t > const region(extent.begin(), extent.end());
+    std::vector< hsize_t > const origin(region.size(), 0);
+    std::vector< std::vector< char > > compressed(chunks.number);
+    std::vector< uint32_t > skipped(chunks.number, 0);   /* filter masks */
+    auto compress = [&](std::size_t i)
+    {
+        std::vector< hsize_t > start = chunks.coordinates(i);
+        std::vector< hsize_t > box(start.size());
+        for( std::size_t d = 0; d < start.size(); ++d )
+        {
+            start[d] *= chunks.chunk[d];
+            box[d] = std::min(chunks.chunk[d], region[d] - start[d]);
+        }
+        /* edge chunks reaching beyond the dataset are padded */
+        std::vector< char > raw(chunks.chunkBytes, 0);
+        copyBox(raw.data(), chunks.chunk, origin, static_cast< char const* >(data), region, start, box, chunks.elementBytes);
+
+        std::vector< char >& out = compressed[i];
+        uLongf bytes = compressBound(static_cast< uLong >(raw.size()));
+        out.resize(bytes);
+        int const result = compress2(reinterpret_cast< Bytef* >(out.data()), &bytes,
+                                     reinterpret_cast< Bytef const* >(raw.data()), static_cast< uLong >(raw.size()),
+                                     chunks.level);
+        /* like the optional deflate filter of HDF5, incompressible chunks are stored as they are */
+        if( result == Z_OK && bytes < raw.size() )
+            out.resize(bytes);
+        else
+        {
+            out = std::move(raw);
+            skipped[i] = 1u;
+        }
+    };
+    auto write = [&](std::size_t i)
+    {
+        std::vector< hsize_t > position = chunks.coordinates(i);
+        for( std::size_t d = 0; d < position.size(); ++d )
+            position[d] = offset[d] + position[d] * chunks.chunk[d];
+        herr_t written = H5Dwrite_chunk(dataset, H5P_DEFAULT, skipped[i], position.data(),
+                                        compressed[i].size(), compressed[i].data());
+        if( written < 0 )
+            throw std::runtime_error("Internal error: Failed to write chunk of HDF5 dataset");
+        std::vector< char >().swap(compressed[i]);
+    };
+    pipeline(chunks.number, m_filterThreads, 4u * m_filterThreads, false, write, compress);
+    return true;
+#else
+    (void)dataset; (void)memoryType; (void)offset; (void)extent; (void)data;
+    return false;
+#endif
+}
+
+bool
+HDF5IOHandlerImpl::readChunksDirect(hid_t dataset, hid_t memoryType,
+                                    Offset const& offset, Extent const& extent, void* data)
+{
+#if openPMD_HAVE_HDF5_ZLIB && H5_VERSION_GE(1, 10, 3)
+    hid_t filespace = H5Dget_space(dataset);
+    DeflateChunks chunks;
+    bool const direct = deflateChunks(dataset, filespace, memoryType, offset, extent, chunks);
+    herr_t status = H5Sclose(filespace);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataspace during dataset read");
+    if( !direct )
+        return false;
+
+    /* chunks that have never been written hold the fill value, only HDF5 knows it */
+    std::vector< std::vector< hsize_t > > positions(chunks.number);
+    std::vector< hsize_t > stored(chunks.number);
+    for( std::size_t i = 0; i < chunks.number; ++i )
+    {
+        positions[i] = chunks.coordinates(i);
+        for( std::size_t d = 0; d < positions[i].size(); ++d )
+            positions[i][d] = offset[d] + positions[i][d] * chunks.chunk[d];
+        herr_t found = -1;
+        /* a missing chunk is no error worth reporting */
+        H5E_BEGIN_TRY
+        {
+            found = H5Dget_chunk_storage_size(dataset, positions[i].data(), &stored[i]);
+        } H5E_END_TRY;
+        if( found < 0 || stored[i] == 0 )
+            return false;
+    }
 
-    m_fileIDs[writable] = res->second;
+    std::vector< hsize_t > const region(extent.begin(), extent.end());
+    std::vector< hsize_t > const origin(region.size(), 0);
+    std::vector< std::vector< char > > compressed(chunks.number);
+    std::vector< uint32_t > skipped(chunks.number, 0);
+    auto read = [&](std::size_t i)
+    {
+        compressed[i].resize(stored[i]);
+        herr_t readStatus = H5Dread_chunk(dataset, H5P_DEFAULT, positions[i].data(), &skipped[i], compressed[i].data());
+        if( readStatus < 0 )
+            throw std::runtime_error("Internal error: Failed to read chunk of HDF5 dataset");
+    };
+    auto decompress = [&](std::size_t i)
+    {
+        std::vector< char > raw;
+        if( skipped[i] & 1u )
+            raw = std::move(compressed[i]);
+        else
+        {
+            raw.resize(chunks.chunkBytes);
+            uLongf bytes = static_cast< uLongf >(raw.size());
+            int const result = uncompress(reinterpret_cast< Bytef* >(raw.data()), &bytes,
+                                          reinterpret_cast< Bytef const* >(compressed[i].data()),
+                                          static_cast< uLong >(compressed[i].size()));
+            std::vector< char >().swap(compressed[i]);
+            if( result != Z_OK || bytes != raw.size() )
+                throw std::runtime_error("Failed to decompress chunk of HDF5 dataset (corrupted file?)");
+        }
+        if( raw.size() != chunks.chunkBytes )
+            throw std::runtime_error("Unexpected size of unfiltered chunk of HDF5 dataset");
+
+        std::vector< hsize_t > start = chunks.coordinates(i);
+        std::vector< hsize_t > box(start.size());
+        for( std::size_t d = 0; d < start.size(); ++d )
+        {
+            start[d] *= chunks.chunk[d];
+            box[d] = std::min(chunks.chunk[d], region[d] - start[d]);
+        }
+        copyBox(static_cast< char* >(data), region, start, raw.data(), chunks.chunk, origin, box, chunks.elementBytes);
+    };
+    pipeline(chunks.number, m_filterThreads, 4u * m_filterThreads, true, read, decompress);
+    return true;
+#else
+    (void)dataset; (void)memoryType; (void)offset; (void)extent; (void)data;
+    return false;
+#endif
 }
 
 void
 HDF5IOHandlerImpl::writeAttribute(Writable* writable,
-                                          ArgumentMap const& parameters)
+                                          Parameter< Operation::WRITE_ATT > const& parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
-    hid_t node_id, attribute_id;
-    node_id = H5Oopen(res->second,
-                      concrete_h5_file_position(writable).c_str(),
-                      H5P_DEFAULT);
+    hid_t node_id = H5Oopen(res->second,
+                            concrete_h5_file_position(writable).c_str(),
+                            H5P_DEFAULT);
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 object during attribute write");
-    std::string name = parameters.at("name").get< std::string >();
-    Attribute const att(parameters.at("attribute").get< Attribute::resource >());
-    Datatype dtype = parameters.at("dtype").get< Datatype >();
+    writeAttributeValue(node_id, writable, parameters);
+    herr_t status = H5Oclose(node_id);
+    ASSERT(status == 0, "Internal error: Failed to close " + concrete_h5_file_position(writable) + " during attribute write");
+
+    m_fileIDs[writable] = res->second;
+}
+
+void
+HDF5IOHandlerImpl::writeAttributes(Writable* writable,
+                                   Parameter< Operation::WRITE_ATTS > const& parameters)
+{
+    if( parameters.attributes.empty() )
+        return;
+
+    auto res = m_fileIDs.find(writable);
+    if( res == m_fileIDs.end() )
+        res = m_fileIDs.find(writable->parent);
+    /* the object (and its header) is opened once for all attributes */
+    hid_t node_id = H5Oopen(res->second,
+                            concrete_h5_file_position(writable).c_str(),
+                            H5P_DEFAULT);
+    ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 object during attribute write");
+    try
+    {
+        for( auto const& attribute : parameters.attributes )
+            writeAttributeValue(node_id, writable, attribute);
+    } catch( ... )
+    {
+        H5Oclose(node_id);
+        throw;
+    }
+    herr_t status = H5Oclose(node_id);
+    ASSERT(status == 0, "Internal error: Failed to close " + concrete_h5_file_position(writable) + " during attribute write");
+
+    m_fileIDs[writable] = res->second;
+}
+
+void
+HDF5IOHandlerImpl::writeAttributeValue(hid_t node_id, Writable* writable,
+                                       Parameter< Operation::WRITE_ATT > const& parameters)
+{
+    /* only named in the error messages of debug builds */
+    (void)writable;
+    hid_t attribute_id;
+    std::string name = parameters.name;
+    Attribute const att(parameters.resource);
+    Datatype dtype = parameters.dtype;
     herr_t status;
-    hid_t dataType;
-    if( dtype == Datatype::BOOL )
-        dataType = m_H5T_BOOL_ENUM;
-    else
-        dataType = getH5DataType(att);
-    ASSERT(dataType >= 0, "Internal error: Failed to get HDF5 datatype during attribute write");
+    hid_t dataType = attributeType(att);
+    if( H5Aexists(node_id, name.c_str()) > 0 )
+    {
+        /* an attribute of another size or type (e.g. a growing vector) can not be written in place */
+        hid_t existing = H5Aopen(node_id, name.c_str(), H5P_DEFAULT);
+        ASSERT(existing >= 0, "Internal error: Failed to open HDF5 attribute during attribute write");
+        hid_t existingSpace = H5Aget_space(existing);
+        hid_t existingType = H5Aget_type(existing);
+        hid_t dataspace = getH5DataSpace(att);
+        bool const matches = H5Tequal(existingType, dataType) > 0
+                             && H5Sget_simple_extent_type(existingSpace) == H5Sget_simple_extent_type(dataspace)
+                             && H5Sget_simple_extent_npoints(existingSpace) == H5Sget_simple_extent_npoints(dataspace);
+        status = H5Sclose(dataspace);
+        status |= H5Tclose(existingType);
+        status |= H5Sclose(existingSpace);
+        status |= H5Aclose(existing);
+        ASSERT(status == 0, "Internal error: Failed to close HDF5 attribute during attribute write");
+        if( !matches )
+        {
+            status = H5Adelete(node_id, name.c_str());
+            ASSERT(status == 0, "Internal error: Failed to delete HDF5 attribute during attribute write");
+        }
+    }
     if( H5Aexists(node_id, name.c_str()) == 0 )
     {
         hid_t dataspace = getH5DataSpace(att);
@@ -995,59 +2568,239 @@ HDF5IOHandlerImpl::writeAttribute(Writable* writable,
     }
     ASSERT(status == 0, "Internal error: Failed to write attribute " + name + " at " + concrete_h5_file_position(writable));
 
-    if( dataType != m_H5T_BOOL_ENUM )
+    status = H5Aclose(attribute_id);
+    ASSERT(status == 0, "Internal error: Failed to close attribute " + name + " at " + concrete_h5_file_position(writable) + " during attribute write");
+}
+
+void
+HDF5IOHandlerImpl::readDataset(Writable* writable,
+                               Parameter< Operation::READ_DATASET > & parameters)
+{
+    auto res = m_fileIDs.find(writable);
+    if( res == m_fileIDs.end() )
+        res = m_fileIDs.find(writable->parent);
+    DatasetHandle& handle = datasetHandle(writable, res->second, &parameters.chunkCache);
+    hid_t dataset_id = handle.dataset;
+    hid_t filespace = handle.dataspace;
+    herr_t status;
+
+    /* the memory type may differ from the file type, HDF5 converts between numeric types while reading */
+    hid_t dataType = memoryType(parameters.dtype);
+
+    /* scaling is fused into the type conversion of the read via a data transform */
+    hid_t transferProperty = m_datasetTransferProperty;
+    if( parameters.scale != 1. )
     {
-        status = H5Tclose(dataType);
-        ASSERT(status == 0, "Internal error: Failed to close HDF5 datatype during Attribute write");
+        transferProperty = m_datasetTransferProperty == H5P_DEFAULT
+                           ? H5Pcreate(H5P_DATASET_XFER)
+                           : H5Pcopy(m_datasetTransferProperty);
+        ASSERT(transferProperty >= 0, "Internal error: Failed to create dataset transfer property during dataset read");
+        std::ostringstream expression;
+        expression << std::setprecision(std::numeric_limits< double >::max_digits10)
+                   << "x*" << parameters.scale;
+        status = H5Pset_data_transform(transferProperty, expression.str().c_str());
+        ASSERT(status == 0, "Internal error: Failed to set data transform during dataset read");
     }
 
-    status = H5Aclose(attribute_id);
-    ASSERT(status == 0, "Internal error: Failed to close attribute " + name + " at " + concrete_h5_file_position(writable) + " during attribute write");
-    status = H5Oclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close " + concrete_h5_file_position(writable) + " during attribute write");
+    /* the file space is selected beforehand, the selected elements are stored densely (or every memoryStride values) in memory */
+    auto read = [&](hsize_t numPoints, void* data)
+    {
+        hid_t memspace = stridedMemorySpace(numPoints, parameters.memoryStride);
+        herr_t readStatus = H5Dread(dataset_id,
+                                    dataType,
+                                    memspace,
+                                    filespace,
+                                    transferProperty,
+                                    data);
+        ASSERT(readStatus == 0, "Internal error: Failed to read dataset");
+        readStatus = H5Sclose(memspace);
+        ASSERT(readStatus == 0, "Internal error: Failed to close dataset memory space during dataset read");
+    };
+    auto selectBox = [&](H5S_seloper_t op, Offset const& offset, Extent const& extent)
+    {
+        std::vector< hsize_t > start(offset.begin(), offset.end());
+        std::vector< hsize_t > block(extent.begin(), extent.end());
+        std::vector< hsize_t > ones(start.size(), 1);
+        herr_t selectStatus = H5Sselect_hyperslab(filespace, op, start.data(), ones.data(), ones.data(), block.data());
+        ASSERT(selectStatus == 0, "Internal error: Failed to select hyperslab during dataset read");
+    };
+    auto numPointsOf = [](Extent const& extent)
+    {
+        hsize_t numPoints = 1;
+        for( auto const& val : extent )
+            numPoints *= static_cast< hsize_t >(val);
+        return numPoints;
+    };
 
-    m_fileIDs[writable] = res->second;
+    if( !parameters.points.empty() )
+    {
+        /* point selections keep the order of the coordinates */
+        std::vector< hsize_t > coordinates(parameters.points.begin(), parameters.points.end());
+        hsize_t numPoints = coordinates.size() / static_cast< size_t >(H5Sget_simple_extent_ndims(filespace));
+        status = H5Sselect_elements(filespace, H5S_SELECT_SET, numPoints, coordinates.data());
+        ASSERT(status == 0, "Internal error: Failed to select elements during dataset read");
+        read(numPoints, parameters.data);
+    } else if( !parameters.regions.empty() )
+    {
+        auto const& regions = parameters.regions;
+        /* a union of hyperslabs is read in row-major order of the file,
+         * which only matches the order of the boxes if the last element of each box precedes the first one of the next */
+        std::vector< hsize_t > dims(regions.front().first.size());
+        H5Sget_simple_extent_dims(filespace, dims.data(), nullptr);
+        auto linear = [&dims](Offset const& o, Extent const* e)
+        {
+            hsize_t index = 0;
+            for( size_t i = 0; i < dims.size(); ++i )
+                index = index * dims[i] + o[i] + (e ? (*e)[i] - 1 : 0);
+            return index;
+        };
+        bool ordered = true;
+        for( size_t r = 1; r < regions.size() && ordered; ++r )
+            ordered = linear(regions[r - 1].first, &regions[r - 1].second) < linear(regions[r].first, nullptr);
+
+        if( ordered )
+        {
+            hsize_t numPoints = 0;
+            for( size_t r = 0; r < regions.size(); ++r )
+            {
+                selectBox(r == 0 ? H5S_SELECT_SET : H5S_SELECT_OR, regions[r].first, regions[r].second);
+                numPoints += numPointsOf(regions[r].second);
+            }
+            read(numPoints, parameters.data);
+        } else
+        {
+            char* data = static_cast< char* >(parameters.data);
+            for( auto const& region : regions )
+            {
+                selectBox(H5S_SELECT_SET, region.first, region.second);
+                read(numPointsOf(region.second), data);
+                data += numPointsOf(region.second) * toBytes(parameters.dtype) * parameters.memoryStride;
+            }
+        }
+    } else
+    {
+        std::vector< hsize_t > start;
+        for( auto const& val : parameters.offset )
+            start.push_back(static_cast<hsize_t>(val));
+        std::vector< hsize_t > stride(start.size(), 1); /* contiguous region */
+        std::vector< hsize_t > count(start.size(), 1); /* single region */
+        std::vector< hsize_t > block;
+        for( auto const& val : parameters.extent )
+            block.push_back(static_cast< hsize_t >(val));
+        hsize_t numPoints = numPointsOf(parameters.extent);
+        if( !parameters.stride.empty() )
+        {
+            /* blocks every stride elements inside the region */
+            numPoints = 1;
+            for( size_t i = 0; i < start.size(); ++i )
+            {
+                hsize_t b = parameters.block.empty() ? 1 : static_cast< hsize_t >(parameters.block[i]);
+                stride[i] = static_cast< hsize_t >(parameters.stride[i]);
+                count[i] = (block[i] - b) / stride[i] + 1;
+                block[i] = b;
+                numPoints *= count[i] * b;
+            }
+        }
+        status = H5Sselect_hyperslab(filespace,
+                                     H5S_SELECT_SET,
+                                     start.data(),
+                                     stride.data(),
+                                     count.data(),
+                                     block.data());
+        ASSERT(status == 0, "Internal error: Failed to select hyperslab during dataset read");
+        if( parameters.transpose )
+        {
+            /* HDF5 selections keep the order of the dimensions, so the chunk is transposed after reading */
+            Extent selected;
+            for( size_t i = 0; i < start.size(); ++i )
+                selected.push_back(count[i] * block[i]);
+            auto buffer = auxiliary::allocatePtr(parameters.dtype, numPoints);
+            read(numPoints, buffer.get());
+            auxiliary::transpose(parameters.data, buffer.get(), toBytes(parameters.dtype), selected);
+        } else if( !(m_filterThreads > 0 && parameters.stride.empty() && parameters.memoryStride == 1
+                     && transferProperty == m_datasetTransferProperty
+                     && readChunksDirect(dataset_id, dataType, parameters.offset, parameters.extent, parameters.data)) )
+            read(numPoints, parameters.data);
+    }
+
+    if( transferProperty != m_datasetTransferProperty )
+    {
+        status = H5Pclose(transferProperty);
+        ASSERT(status == 0, "Internal error: Failed to close dataset transfer property during dataset read");
+    }
 }
 
 void
-HDF5IOHandlerImpl::readDataset(Writable* writable,
-                               std::map< std::string, ParameterArgument > & parameters)
+HDF5IOHandlerImpl::mapDataset(Writable* writable,
+                              Parameter< Operation::MAP_DATASET > & parameters)
 {
+#if defined(__linux__) || defined(__APPLE__)
+    /* data written in this session might still reside in the HDF5 cache */
+    if( m_handler->accessType != AccessType::READ_ONLY )
+        return;
+
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
-    hid_t dataset_id, memspace, filespace;
+    DatasetHandle& handle = datasetHandle(writable, res->second);
+    hid_t dataset_id = handle.dataset;
     herr_t status;
-    dataset_id = H5Dopen(res->second,
-                         concrete_h5_file_position(writable).c_str(),
-                         H5P_DEFAULT);
-    ASSERT(dataset_id >= 0, "Internal error: Failed to open HDF5 dataset during dataset read");
 
-    std::vector< hsize_t > start;
-    for( auto const& val : parameters.at("offset").get< Offset >() )
-        start.push_back(static_cast<hsize_t>(val));
-    std::vector< hsize_t > stride(start.size(), 1); /* contiguous region */
-    std::vector< hsize_t > count(start.size(), 1); /* single region */
-    std::vector< hsize_t > block;
-    for( auto const& val : parameters.at("extent").get< Extent >() )
-        block.push_back(static_cast< hsize_t >(val));
-    memspace = H5Screate_simple(block.size(), block.data(), nullptr);
-    filespace = H5Dget_space(dataset_id);
-    status = H5Sselect_hyperslab(filespace,
-                                 H5S_SELECT_SET,
-                                 start.data(),
-                                 stride.data(),
-                                 count.data(),
-                                 block.data());
-    ASSERT(status == 0, "Internal error: Failed to select hyperslab during dataset read");
+    /* only files accessed through the default POSIX driver map 1:1 to the file on disk */
+    hid_t fileAccess = H5Fget_access_plist(handle.file);
+    ASSERT(fileAccess >= 0, "Internal error: Failed to get file access property during dataset map");
+    bool const posix = H5Pget_driver(fileAccess) == H5FD_SEC2;
+    status = H5Pclose(fileAccess);
+    ASSERT(status == 0, "Internal error: Failed to close file access property during dataset map");
+    if( !posix )
+        return;
 
-    void* data = parameters.at("data").get< void* >();
+    int ndims = H5Sget_simple_extent_ndims(handle.dataspace);
+    std::vector< hsize_t > dims(ndims, 0);
+    status = H5Sget_simple_extent_dims(handle.dataspace, dims.data(), nullptr);
+    ASSERT(status == ndims, "Internal error: Failed to get dimensions during dataset map");
+
+    /* contiguous layout implies the absence of filters, an undefined offset means there is no storage yet */
+    haddr_t address = HADDR_UNDEF;
+    hid_t datasetCreate = H5Dget_create_plist(dataset_id);
+    ASSERT(datasetCreate >= 0, "Internal error: Failed to get dataset creation property during dataset map");
+    H5D_layout_t const layout = H5Pget_layout(datasetCreate);
+    if( layout == H5D_CONTIGUOUS )
+        address = H5Dget_offset(dataset_id);
+#if H5_VERSION_GE(1, 10, 5)
+    /* datasets written with the default chunk size consist of a single chunk, which is laid out like a contiguous dataset */
+    else if( layout == H5D_CHUNKED && H5Pget_nfilters(datasetCreate) == 0 )
+    {
+        std::vector< hsize_t > chunk(ndims, 0);
+        hsize_t numChunks = 0;
+        hid_t space = H5Dget_space(dataset_id);
+        ASSERT(space >= 0, "Internal error: Failed to get dataspace during dataset map");
+        if( H5Pget_chunk(datasetCreate, ndims, chunk.data()) == ndims
+            && chunk == dims
+            && H5Dget_num_chunks(dataset_id, space, &numChunks) >= 0
+            && numChunks == 1 )
+        {
+            unsigned filterMask = 0;
+            hsize_t chunkBytes = 0;
+            if( H5Dget_chunk_info(dataset_id, space, 0, nullptr, &filterMask, &address, &chunkBytes) < 0 )
+                address = HADDR_UNDEF;
+        }
+        status = H5Sclose(space);
+        ASSERT(status == 0, "Internal error: Failed to close dataspace during dataset map");
+    }
+#endif
+    status = H5Pclose(datasetCreate);
+    ASSERT(status == 0, "Internal error: Failed to close dataset creation property during dataset map");
+    if( address == HADDR_UNDEF )
+        return;
 
+    /* the bytes in the file have to be valid values of the requested type as they are */
     Attribute a(0);
-    a.dtype = parameters.at("dtype").get< Datatype >();
+    a.dtype = parameters.dtype;
     switch( a.dtype )
     {
         using DT = Datatype;
+        case DT::LONG_DOUBLE:
         case DT::DOUBLE:
         case DT::FLOAT:
         case DT::INT16:
@@ -1060,36 +2813,83 @@ HDF5IOHandlerImpl::readDataset(Writable* writable,
         case DT::UCHAR:
         case DT::BOOL:
             break;
-        case DT::UNDEFINED:
-            throw std::runtime_error("Unknown Attribute datatype");
-        case DT::DATATYPE:
-            throw std::runtime_error("Meta-Datatype leaked into IO");
         default:
-            throw std::runtime_error("Datatype not implemented in HDF5 IO");
+            return;
     }
-    hid_t dataType = getH5DataType(a);
-    ASSERT(dataType >= 0, "Internal error: Failed to get HDF5 datatype during dataset read");
-    status = H5Dread(dataset_id,
-                     dataType,
-                     memspace,
-                     filespace,
-                     m_datasetTransferProperty,
-                     data);
-    ASSERT(status == 0, "Internal error: Failed to read dataset");
-
-    status = H5Tclose(dataType);
-    ASSERT(status == 0, "Internal error: Failed to close dataset datatype during dataset read");
-    status = H5Sclose(filespace);
-    ASSERT(status == 0, "Internal error: Failed to close dataset file space during dataset read");
-    status = H5Sclose(memspace);
-    ASSERT(status == 0, "Internal error: Failed to close dataset memory space during dataset read");
-    status = H5Dclose(dataset_id);
-    ASSERT(status == 0, "Internal error: Failed to close dataset during dataset read");
+    hid_t memType = memoryType(a.dtype);
+    hid_t fileType = H5Dget_type(dataset_id);
+    ASSERT(fileType >= 0, "Internal error: Failed to get HDF5 file datatype during dataset map");
+    bool const sameType = H5Tequal(memType, fileType) > 0;
+    std::size_t const typeSize = H5Tget_size(memType);
+    status = H5Tclose(fileType);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 file datatype during dataset map");
+    if( !sameType )
+        return;
+
+    /* row-major: leading dimensions of extent 1, then one partial dimension, then only complete dimensions */
+    if( parameters.offset.size() != dims.size() || parameters.extent.size() != dims.size() )
+        return;
+    std::size_t partial = 0;
+    for( std::size_t d = dims.size(); d-- > 0; )
+        if( parameters.offset[d] != 0 || parameters.extent[d] != dims[d] )
+        {
+            partial = d;
+            break;
+        }
+    for( std::size_t d = 0; d < partial; ++d )
+        if( parameters.extent[d] != 1 )
+            return;
+
+    uint64_t first = 0;
+    uint64_t numPoints = 1;
+    for( std::size_t d = 0; d < dims.size(); ++d )
+    {
+        first = first * dims[d] + parameters.offset[d];
+        numPoints *= parameters.extent[d];
+    }
+    if( numPoints == 0 )
+        return;
+
+    /* addresses are relative to the end of the user block */
+    hid_t fileCreate = H5Fget_create_plist(handle.file);
+    ASSERT(fileCreate >= 0, "Internal error: Failed to get file creation property during dataset map");
+    hsize_t userBlock = 0;
+    status = H5Pget_userblock(fileCreate, &userBlock);
+    ASSERT(status == 0, "Internal error: Failed to get user block size during dataset map");
+    status = H5Pclose(fileCreate);
+    ASSERT(status == 0, "Internal error: Failed to close file creation property during dataset map");
+
+    ssize_t nameLength = H5Fget_name(handle.file, nullptr, 0);
+    ASSERT(nameLength >= 0, "Internal error: Failed to get file name during dataset map");
+    std::vector< char > name(nameLength + 1, '\0');
+    H5Fget_name(handle.file, name.data(), name.size());
+
+    uint64_t const begin = userBlock + address + first * typeSize;
+    uint64_t const length = numPoints * typeSize;
+    uint64_t const page = static_cast< uint64_t >(sysconf(_SC_PAGESIZE));
+    uint64_t const mapBegin = begin / page * page;
+    std::size_t const mapLength = static_cast< std::size_t >(begin - mapBegin + length);
+
+    int fd = open(name.data(), O_RDONLY);
+    if( fd < 0 )
+        return;
+    void* mapping = mmap(nullptr, mapLength, PROT_READ, MAP_SHARED, fd, static_cast< off_t >(mapBegin));
+    close(fd);
+    if( mapping == MAP_FAILED )
+        return;
+
+    /* pages are faulted in on first access, the mapping outlives the file handle */
+    std::shared_ptr< void const > base(mapping, [mapLength](void const* p){ munmap(const_cast< void* >(p), mapLength); });
+    *parameters.view = std::shared_ptr< void const >(base, static_cast< char const* >(mapping) + (begin - mapBegin));
+#else
+    (void)writable;
+    (void)parameters;
+#endif
 }
 
 void
 HDF5IOHandlerImpl::readAttribute(Writable* writable,
-                                 std::map< std::string, ParameterArgument >& parameters)
+                                 Parameter< Operation::READ_ATT > & parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
@@ -1101,12 +2901,91 @@ HDF5IOHandlerImpl::readAttribute(Writable* writable,
                      concrete_h5_file_position(writable).c_str(),
                      H5P_DEFAULT);
     ASSERT(obj_id >= 0, "Internal error: Failed to open HDF5 object during attribute read");
-    std::string const & attr_name = parameters.at("name").get< std::string >();
+    std::string const & attr_name = parameters.name;
     attr_id = H5Aopen(obj_id,
                       attr_name.c_str(),
                       H5P_DEFAULT);
     ASSERT(attr_id >= 0, "Internal error: Failed to open HDF5 attribute during attribute read");
 
+    Attribute a = readAttributeValue(attr_id, attr_name, writable);
+
+    auto dtype = parameters.dtype;
+    *dtype = a.dtype;
+    auto resource = parameters.resource;
+    *resource = a.getResource();
+
+    status = H5Aclose(attr_id);
+    ASSERT(status == 0, "Internal error: Failed to close attribute " + attr_name + " at " + concrete_h5_file_position(writable) + " during attribute read");
+    status = H5Oclose(obj_id);
+    ASSERT(status == 0, "Internal error: Failed to close " + concrete_h5_file_position(writable) + " during attribute read");
+}
+
+void
+HDF5IOHandlerImpl::persistImage(hid_t file)
+{
+    herr_t status = H5Fflush(file, H5F_SCOPE_LOCAL);
+    ASSERT(status >= 0, "Internal error: Failed to flush HDF5 file");
+    ssize_t length = H5Fget_name(file, nullptr, 0);
+    ASSERT(length >= 0, "Internal error: Failed to get HDF5 file name");
+    std::vector< char > buffer(static_cast< size_t >(length) + 1);
+    H5Fget_name(file, buffer.data(), buffer.size());
+    std::string name(buffer.data());
+
+    ssize_t size = H5Fget_file_image(file, nullptr, 0);
+    if( size < 0 )
+        throw std::runtime_error("Internal error: Failed to get memory image of HDF5 file " + name);
+    std::vector< char > image(static_cast< size_t >(size));
+    size = H5Fget_file_image(file, image.data(), image.size());
+    if( size < 0 )
+        throw std::runtime_error("Internal error: Failed to get memory image of HDF5 file " + name);
+
+    /* the oldest write is the most likely to have completed */
+    while( m_pendingImages.size() >= m_persistThreads )
+    {
+        std::future< void > done = std::move(m_pendingImages.front().second);
+        m_pendingImages.pop_front();
+        done.get();
+    }
+    /* plain file IO, not serialized with the HDF5 library */
+    m_pendingImages.emplace_back(
+        name,
+        std::async(std::launch::async,
+                   [](std::string const& n, std::vector< char > const& i)
+                   {
+                       std::ofstream out(n, std::ios::binary | std::ios::trunc);
+                       out.write(i.data(), static_cast< std::streamsize >(i.size()));
+                       out.close();
+                       if( !out )
+                           throw std::runtime_error("Failed to write HDF5 file " + n);
+                   },
+                   name,
+                   std::move(image)));
+}
+
+void
+HDF5IOHandlerImpl::awaitImages(std::string const& name)
+{
+    for( auto image = m_pendingImages.begin(); image != m_pendingImages.end(); )
+    {
+        if( !name.empty() && image->first != name )
+        {
+            ++image;
+            continue;
+        }
+        std::future< void > done = std::move(image->second);
+        image = m_pendingImages.erase(image);
+        done.get();
+    }
+}
+
+Attribute
+HDF5IOHandlerImpl::readAttributeValue(hid_t attr_id,
+                                      std::string const& attr_name,
+                                      Writable* writable)
+{
+    /* only named in the error messages of debug builds */
+    (void)writable;
+    herr_t status;
     hid_t attr_type, attr_space;
     attr_type = H5Aget_type(attr_id);
     attr_space = H5Aget_space(attr_id);
@@ -1378,83 +3257,106 @@ HDF5IOHandlerImpl::readAttribute(Writable* writable,
     status = H5Sclose(attr_space);
     ASSERT(status == 0, "Internal error: Failed to close attribute file space during attribute read");
 
-    auto dtype = parameters.at("dtype").get< std::shared_ptr< Datatype > >();
-    *dtype = a.dtype;
-    auto resource = parameters.at("resource").get< std::shared_ptr< Attribute::resource > >();
-    *resource = a.getResource();
+    return a;
+}
 
-    status = H5Aclose(attr_id);
-    ASSERT(status == 0, "Internal error: Failed to close attribute " + attr_name + " at " + concrete_h5_file_position(writable) + " during attribute read");
-    status = H5Oclose(obj_id);
-    ASSERT(status == 0, "Internal error: Failed to close " + concrete_h5_file_position(writable) + " during attribute read");
+namespace
+{
+struct AttributeIteration
+{
+    HDF5IOHandlerImpl* impl;
+    Writable* writable;
+    Parameter< Operation::READ_ATTS >* parameters;
+    std::exception_ptr error;
+};
+
+herr_t
+readAttributeCallback(hid_t location, char const* name, H5A_info_t const*, void* data)
+{
+    auto& it = *static_cast< AttributeIteration* >(data);
+    hid_t attr_id = H5Aopen(location, name, H5P_DEFAULT);
+    if( attr_id < 0 )
+        return -1;
+
+    herr_t result = 0;
+    try
+    {
+        it.parameters->attributes->emplace(name, it.impl->readAttributeValue(attr_id, name, it.writable));
+    } catch( unsupported_data_error const& e )
+    {
+        it.parameters->skipped->emplace(name, e.what());
+    } catch( ... )
+    {
+        it.error = std::current_exception();
+        result = -1;
+    }
+
+    if( H5Aclose(attr_id) < 0 )
+        result = -1;
+    return result;
 }
+} // namespace
 
 void
-HDF5IOHandlerImpl::listPaths(Writable* writable,
-                             std::map< std::string, ParameterArgument > & parameters)
+HDF5IOHandlerImpl::readAttributes(Writable* writable,
+                                  Parameter< Operation::READ_ATTS > & parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
-    hid_t node_id = H5Gopen(res->second,
-                            concrete_h5_file_position(writable).c_str(),
-                            H5P_DEFAULT);
-    ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during path listing");
 
-    H5G_info_t group_info;
-    herr_t status = H5Gget_info(node_id, &group_info);
-    ASSERT(status == 0, "Internal error: Failed to get HDF5 group info for " + concrete_h5_file_position(writable) + " during path listing");
-
-    auto paths = parameters.at("paths").get< std::shared_ptr< std::vector< std::string > > >();
-    for( hsize_t i = 0; i < group_info.nlinks; ++i )
-    {
-        if( H5G_GROUP == H5Gget_objtype_by_idx(node_id, i) )
-        {
-            ssize_t name_length = H5Gget_objname_by_idx(node_id, i, nullptr, 0);
-            std::vector< char > name(name_length+1);
-            H5Gget_objname_by_idx(node_id, i, name.data(), name_length+1);
-            paths->push_back(std::string(name.data(), name_length));
-        }
-    }
+    hid_t obj_id;
+    herr_t status;
+    obj_id = H5Oopen(res->second,
+                     concrete_h5_file_position(writable).c_str(),
+                     H5P_DEFAULT);
+    ASSERT(obj_id >= 0, "Internal error: Failed to open HDF5 object during attribute read");
 
-    status = H5Gclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close HDF5 group " + concrete_h5_file_position(writable) + " during path listing");
+    AttributeIteration it{this, writable, &parameters, nullptr};
+    status = H5Aiterate2(obj_id,
+                         H5_INDEX_NAME,
+                         H5_ITER_NATIVE,
+                         nullptr,
+                         readAttributeCallback,
+                         &it);
+
+    herr_t close_status = H5Oclose(obj_id);
+    if( it.error )
+        std::rethrow_exception(it.error);
+    ASSERT(status >= 0, "Internal error: Failed to iterate attributes at " + concrete_h5_file_position(writable) + " during attribute read");
+    ASSERT(close_status == 0, "Internal error: Failed to close " + concrete_h5_file_position(writable) + " during attribute read");
 }
 
 void
-HDF5IOHandlerImpl::listDatasets(Writable* writable,
-                                std::map< std::string, ParameterArgument >& parameters)
+HDF5IOHandlerImpl::listPaths(Writable* writable,
+                             Parameter< Operation::LIST_PATHS > & parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
-    hid_t node_id = H5Gopen(res->second,
-                            concrete_h5_file_position(writable).c_str(),
-                            H5P_DEFAULT);
-    ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset listing");
 
-    H5G_info_t group_info;
-    herr_t status = H5Gget_info(node_id, &group_info);
-    ASSERT(status == 0, "Internal error: Failed to get HDF5 group info for " + concrete_h5_file_position(writable) + " during dataset listing");
+    hid_t file = res->second;
+    if( parameters.refresh )
+        file = refreshFile(file);
 
-    auto datasets = parameters.at("datasets").get< std::shared_ptr< std::vector< std::string > > >();
-    for( hsize_t i = 0; i < group_info.nlinks; ++i )
-    {
-        if( H5G_DATASET == H5Gget_objtype_by_idx(node_id, i) )
-        {
-            ssize_t name_length = H5Gget_objname_by_idx(node_id, i, nullptr, 0);
-            std::vector< char > name(name_length+1);
-            H5Gget_objname_by_idx(node_id, i, name.data(), name_length+1);
-            datasets->push_back(std::string(name.data(), name_length));
-        }
-    }
+    auto const& paths = groupListing(writable, file).paths;
+    parameters.paths->insert(parameters.paths->end(), paths.begin(), paths.end());
+}
 
-    status = H5Gclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close HDF5 group " + concrete_h5_file_position(writable) + " during dataset listing");
+void
+HDF5IOHandlerImpl::listDatasets(Writable* writable,
+                                Parameter< Operation::LIST_DATASETS > & parameters)
+{
+    auto res = m_fileIDs.find(writable);
+    if( res == m_fileIDs.end() )
+        res = m_fileIDs.find(writable->parent);
+
+    auto const& datasets = groupListing(writable, res->second).datasets;
+    parameters.datasets->insert(parameters.datasets->end(), datasets.begin(), datasets.end());
 }
 
 void HDF5IOHandlerImpl::listAttributes(Writable* writable,
-                                       std::map< std::string, ParameterArgument >& parameters)
+                                       Parameter< Operation::LIST_ATTS > & parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
@@ -1470,7 +3372,7 @@ void HDF5IOHandlerImpl::listAttributes(Writable* writable,
     status = H5Oget_info(node_id, &object_info);
     ASSERT(status == 0, "Internal error: Failed to get HDF5 object info for " + concrete_h5_file_position(writable) + " during attribute listing");
 
-    auto strings = parameters.at("attributes").get< std::shared_ptr< std::vector< std::string > > >();
+    auto strings = parameters.attributes;
     for( hsize_t i = 0; i < object_info.num_attrs; ++i )
     {
         ssize_t name_length = H5Aget_name_by_idx(node_id,
@@ -1499,19 +3401,120 @@ void HDF5IOHandlerImpl::listAttributes(Writable* writable,
 #endif
 
 #if defined(openPMD_HAVE_HDF5)
+std::mutex&
+HDF5IOHandlerImpl::libraryMutex()
+{
+    static std::mutex m;
+    return m;
+}
+
 HDF5IOHandler::HDF5IOHandler(std::string const& path, AccessType at)
         : AbstractIOHandler(path, at),
-          m_impl{new HDF5IOHandlerImpl(this)}
+          m_impl{new HDF5IOHandlerImpl(this)},
+          m_busy{false},
+          m_stop{false}
 { }
 
 HDF5IOHandler::~HDF5IOHandler()
-{ }
+{
+    if( m_worker.joinable() )
+    {
+        {
+            std::lock_guard< std::mutex > lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_worker.join();
+    }
+}
 
 std::future< void >
 HDF5IOHandler::flush()
 {
+    std::lock_guard< std::recursive_mutex > lock(m_workMutex);
+    /* the HDF5 library is only ever accessed from one thread at a time */
+    wait();
+#if !defined(H5_HAVE_THREADSAFE)
+    std::lock_guard< std::mutex > library(HDF5IOHandlerImpl::libraryMutex());
+#endif
     return m_impl->flush();
 }
+
+void
+HDF5IOHandler::setOptions(HDF5Options const& options)
+{
+    wait();
+#if !defined(H5_HAVE_THREADSAFE)
+    std::lock_guard< std::mutex > library(HDF5IOHandlerImpl::libraryMutex());
+#endif
+    m_impl->setOptions(options);
+    m_options = options;
+}
+
+HDF5Options const&
+HDF5IOHandler::options() const
+{
+    return m_options;
+}
+
+std::future< void >
+HDF5IOHandler::flushAsync()
+{
+    Batch batch;
+    {
+        std::lock_guard< std::recursive_mutex > work(m_workMutex);
+        std::swap(batch.tasks, m_work.collect());
+    }
+    std::future< void > ret = batch.done.get_future();
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        if( !m_worker.joinable() )
+            m_worker = std::thread(&HDF5IOHandler::work, this);
+        m_batches.push(std::move(batch));
+    }
+    m_cv.notify_all();
+    return ret;
+}
+
+void
+HDF5IOHandler::wait()
+{
+    std::unique_lock< std::mutex > lock(m_mutex);
+    m_cv.wait(lock, [this]{ return m_batches.empty() && !m_busy; });
+}
+
+void
+HDF5IOHandler::work()
+{
+    std::unique_lock< std::mutex > lock(m_mutex);
+    while( true )
+    {
+        m_cv.wait(lock, [this]{ return m_stop || !m_batches.empty(); });
+        if( m_batches.empty() )
+            return;
+
+        Batch batch = std::move(m_batches.front());
+        m_batches.pop();
+        m_busy = true;
+        lock.unlock();
+
+        try
+        {
+#if !defined(H5_HAVE_THREADSAFE)
+            std::lock_guard< std::mutex > library(HDF5IOHandlerImpl::libraryMutex());
+#endif
+            m_impl->process(batch.tasks);
+            batch.done.set_value();
+        } catch( ... )
+        {
+            batch.done.set_exception(std::current_exception());
+        }
+
+        lock.lock();
+        m_busy = false;
+        m_cv.notify_all();
+    }
+}
 #else
 HDF5IOHandler::HDF5IOHandler(std::string const& path, AccessType at)
         : AbstractIOHandler(path, at)
@@ -1527,5 +3530,21 @@ HDF5IOHandler::flush()
 {
     return std::future< void >();
 }
+
+std::future< void >
+HDF5IOHandler::flushAsync()
+{
+    return std::future< void >();
+}
+
+void
+HDF5IOHandler::setOptions(HDF5Options const&)
+{ }
+
+HDF5Options const&
+HDF5IOHandler::options() const
+{
+    return m_options;
+}
 #endif
 } // openPMD
@@ -22,11 +22,17 @@
 
 #if openPMD_HAVE_HDF5 && openPMD_HAVE_MPI
 #   include "openPMD/auxiliary/StringManip.hpp"
+#   include "openPMD/IO/HDF5/HDF5Auxiliary.hpp"
 #   include <mpi.h>
 #   include <boost/filesystem.hpp>
 #endif
 
+#include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <iostream>
+#include <tuple>
+#include <utility>
 
 
 namespace openPMD
@@ -43,36 +49,154 @@ ParallelHDF5IOHandler::ParallelHDF5IOHandler(std::string const& path,
                                              AccessType at,
                                              MPI_Comm comm)
         : AbstractIOHandler(path, at, comm),
-          m_impl{new ParallelHDF5IOHandlerImpl(this, comm)}
+          m_impl{new ParallelHDF5IOHandlerImpl(this, comm)},
+          m_busy{false},
+          m_stop{false}
 { }
 
 ParallelHDF5IOHandler::~ParallelHDF5IOHandler()
-{ }
+{
+    if( m_worker.joinable() )
+    {
+        {
+            std::lock_guard< std::mutex > lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_worker.join();
+    }
+}
 
 std::future< void >
 ParallelHDF5IOHandler::flush()
 {
+    std::lock_guard< std::recursive_mutex > lock(m_workMutex);
+    /* the HDF5 library is only ever accessed from one thread at a time */
+    wait();
+#if !defined(H5_HAVE_THREADSAFE)
+    std::lock_guard< std::mutex > library(HDF5IOHandlerImpl::libraryMutex());
+#endif
     return m_impl->flush();
 }
 
+std::future< void >
+ParallelHDF5IOHandler::flushAsync()
+{
+    int threadLevel;
+    MPI_Query_thread(&threadLevel);
+    Batch batch;
+    {
+        std::lock_guard< std::recursive_mutex > work(m_workMutex);
+        /* without MPI_THREAD_MULTIPLE, MPI calls of the IO thread must not overlap with those of the application,
+         * metadata broadcasts rely on the order of operations that flush() establishes */
+        if( threadLevel < MPI_THREAD_MULTIPLE || m_impl->broadcastsMetadata() )
+            return AbstractIOHandler::flushAsync();
+        std::swap(batch.tasks, m_work.collect());
+    }
+    std::future< void > ret = batch.done.get_future();
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        if( !m_worker.joinable() )
+            m_worker = std::thread(&ParallelHDF5IOHandler::work, this);
+        m_batches.push(std::move(batch));
+    }
+    m_cv.notify_all();
+    return ret;
+}
+
+void
+ParallelHDF5IOHandler::setOptions(ParallelHDF5Options const& options)
+{
+    wait();
+    m_impl->setOptions(options);
+}
+
+void
+ParallelHDF5IOHandler::wait()
+{
+    std::unique_lock< std::mutex > lock(m_mutex);
+    m_cv.wait(lock, [this]{ return m_batches.empty() && !m_busy; });
+}
+
+void
+ParallelHDF5IOHandler::work()
+{
+    std::unique_lock< std::mutex > lock(m_mutex);
+    while( true )
+    {
+        m_cv.wait(lock, [this]{ return m_stop || !m_batches.empty(); });
+        if( m_batches.empty() )
+            return;
+
+        Batch batch = std::move(m_batches.front());
+        m_batches.pop();
+        m_busy = true;
+        lock.unlock();
+
+        try
+        {
+#if !defined(H5_HAVE_THREADSAFE)
+            std::lock_guard< std::mutex > library(HDF5IOHandlerImpl::libraryMutex());
+#endif
+            m_impl->process(batch.tasks);
+            batch.done.set_value();
+        } catch( ... )
+        {
+            batch.done.set_exception(std::current_exception());
+        }
+
+        lock.lock();
+        m_busy = false;
+        m_cv.notify_all();
+    }
+}
+
 ParallelHDF5IOHandlerImpl::ParallelHDF5IOHandlerImpl(AbstractIOHandler* handler,
                                                      MPI_Comm comm)
         : HDF5IOHandlerImpl{handler},
           m_mpiComm{comm},
-          m_mpiInfo{MPI_INFO_NULL} /* MPI 3.0+: MPI_INFO_ENV */
+          m_mpiInfo{MPI_INFO_NULL}, /* MPI 3.0+: MPI_INFO_ENV */
+          m_broadcastMetadata{false},
+          m_metadataComm{MPI_COMM_NULL},
+          m_metadataRank{0},
+          m_subfileComm{MPI_COMM_NULL},
+          m_subfileIndex{0},
+          m_defaultTransfer{Transfer::COLLECTIVE},
+          m_batchSettling{false}
 {
     m_datasetTransferProperty = H5Pcreate(H5P_DATASET_XFER);
+    m_independentTransferProperty = H5Pcreate(H5P_DATASET_XFER);
     m_fileAccessProperty = H5Pcreate(H5P_FILE_ACCESS);
     herr_t status;
     status = H5Pset_dxpl_mpio(m_datasetTransferProperty, H5FD_MPIO_COLLECTIVE);
     ASSERT(status >= 0, "Internal error: Failed to set HDF5 dataset transfer property");
+    status = H5Pset_dxpl_mpio(m_independentTransferProperty, H5FD_MPIO_INDEPENDENT);
+    ASSERT(status >= 0, "Internal error: Failed to set HDF5 dataset transfer property");
     status = H5Pset_fapl_mpio(m_fileAccessProperty, m_mpiComm, m_mpiInfo);
     ASSERT(status >= 0, "Internal error: Failed to set HDF5 file access property");
+    /* datasets are allocated early in parallel, filling them would write each of them twice */
+    m_defaultAllocation.fill = FillTime::NEVER;
 }
 
 ParallelHDF5IOHandlerImpl::~ParallelHDF5IOHandlerImpl()
 {
+    releaseDatasetHandles();
+
     herr_t status;
+    for( auto& subfile : m_subfiles )
+    {
+        releaseGroupListings(subfile.first);
+        status = H5Fclose(subfile.first);
+        if( status < 0 )
+            std::cerr << "Internal error: Failed to close HDF5 subfile (parallel)\n";
+        m_openFileIDs.erase(subfile.first);
+        /* the index is written collectively, which may no longer be possible here (e.g. after MPI_Finalize) */
+        if( subfile.second.modified )
+            std::cerr << "The index of HDF5 subfiles " << subfile.second.index
+                      << " lacks the last changes, flush the Series before it is destroyed\n";
+    }
+    m_subfiles.clear();
+
     while( !m_openFileIDs.empty() )
     {
         auto file = m_openFileIDs.begin();
@@ -81,6 +205,1232 @@ ParallelHDF5IOHandlerImpl::~ParallelHDF5IOHandlerImpl()
             std::cerr << "Internal error: Failed to close HDF5 file (parallel)\n";
         m_openFileIDs.erase(file);
     }
+
+    status = H5Pclose(m_independentTransferProperty);
+    if( status < 0 )
+        std::cerr << "Internal error: Failed to close HDF5 dataset transfer property (parallel)\n";
+
+    if( m_metadataComm != MPI_COMM_NULL )
+        MPI_Comm_free(&m_metadataComm);
+    if( m_subfileComm != MPI_COMM_NULL )
+        MPI_Comm_free(&m_subfileComm);
+    if( m_mpiInfo != MPI_INFO_NULL )
+        MPI_Info_free(&m_mpiInfo);
+}
+
+void
+ParallelHDF5IOHandlerImpl::setOptions(ParallelHDF5Options const& options)
+{
+    using MR = ParallelHDF5Options::MetadataReaders;
+    if( options.collectiveMetadataOps && options.metadataReaders != MR::ALL )
+        throw std::runtime_error("Collective metadata operations require all ranks to read the metadata");
+
+    if( options.transfer == Transfer::DEFAULT )
+        throw std::runtime_error("The transfer of a parallel HDF5 Series must be COLLECTIVE or INDEPENDENT");
+
+    setAttributeStorage(options.attributeStorage);
+    m_defaultTransfer = options.transfer;
+    herr_t status;
+    if( !options.mpiHints.empty() )
+    {
+        if( m_mpiInfo != MPI_INFO_NULL )
+            MPI_Info_free(&m_mpiInfo);
+        MPI_Info_create(&m_mpiInfo);
+        for( auto const& hint : options.mpiHints )
+            MPI_Info_set(m_mpiInfo, hint.first.c_str(), hint.second.c_str());
+        status = H5Pset_fapl_mpio(m_fileAccessProperty, m_mpiComm, m_mpiInfo);
+        ASSERT(status >= 0, "Internal error: Failed to set HDF5 file access property");
+    }
+    if( options.collectiveMetadataOps || options.collectiveMetadataWrite )
+    {
+#if H5_VERSION_GE(1, 10, 0)
+        status = H5Pset_all_coll_metadata_ops(m_fileAccessProperty, options.collectiveMetadataOps);
+        ASSERT(status >= 0, "Internal error: Failed to set HDF5 collective metadata reads");
+        status = H5Pset_coll_metadata_write(m_fileAccessProperty, options.collectiveMetadataWrite);
+        ASSERT(status >= 0, "Internal error: Failed to set HDF5 collective metadata writes");
+#else
+        throw std::runtime_error("Collective metadata operations require HDF5 1.10 or newer");
+#endif
+    }
+    if( options.alignment > 0 )
+    {
+        status = H5Pset_alignment(m_fileAccessProperty, options.alignmentThreshold, options.alignment);
+        if( status < 0 )
+            throw std::runtime_error("Invalid HDF5 file alignment " + std::to_string(options.alignment));
+    }
+    if( options.metadataBlockSize > 0 )
+    {
+        status = H5Pset_meta_block_size(m_fileAccessProperty, options.metadataBlockSize);
+        ASSERT(status >= 0, "Internal error: Failed to set HDF5 metadata block size");
+    }
+    if( options.metadataCacheSize > 0 )
+    {
+        H5AC_cache_config_t config;
+        config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+        status = H5Pget_mdc_config(m_fileAccessProperty, &config);
+        ASSERT(status >= 0, "Internal error: Failed to get HDF5 metadata cache configuration");
+        config.set_initial_size = true;
+        config.initial_size = options.metadataCacheSize;
+        config.min_size = std::min< size_t >(config.min_size, options.metadataCacheSize);
+        config.max_size = std::max< size_t >(config.max_size, options.metadataCacheSize);
+        status = H5Pset_mdc_config(m_fileAccessProperty, &config);
+        if( status < 0 )
+            throw std::runtime_error("Invalid HDF5 metadata cache size " + std::to_string(options.metadataCacheSize));
+    }
+
+    if( m_subfileComm != MPI_COMM_NULL )
+        MPI_Comm_free(&m_subfileComm);
+    using SF = ParallelHDF5Options::Subfiles;
+    if( options.subfiles != SF::NONE && m_handler->accessType != AccessType::READ_ONLY )
+    {
+        if( m_handler->accessType != AccessType::CREATE )
+            throw std::runtime_error("Subfiles can only be written when creating a Series");
+#if !H5_VERSION_GE(1, 10, 0)
+        throw std::runtime_error("Subfiles require HDF5 1.10 or newer");
+#endif
+        if( options.subfiles == SF::PER_GROUP && options.ranksPerSubfile == 0 )
+            throw std::runtime_error("Subfiles per group of ranks require a positive number of ranks per subfile");
+
+        int rank;
+        MPI_Comm_rank(m_mpiComm, &rank);
+        int mpi_status;
+        if( options.subfiles == SF::PER_NODE )
+            mpi_status = MPI_Comm_split_type(m_mpiComm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &m_subfileComm);
+        else
+            mpi_status = MPI_Comm_split(m_mpiComm, static_cast< int >(rank / options.ranksPerSubfile), rank, &m_subfileComm);
+        if( mpi_status != MPI_SUCCESS )
+            throw std::runtime_error("Failed to create the communicator of parallel HDF5 subfiles");
+
+        /* number the groups by their first rank */
+        int groupRank;
+        MPI_Comm_rank(m_subfileComm, &groupRank);
+        int leader = groupRank == 0 ? 1 : 0;
+        MPI_Exscan(&leader, &m_subfileIndex, 1, MPI_INT, MPI_SUM, m_mpiComm);
+        if( rank == 0 )
+            m_subfileIndex = 0; /* undefined on the first rank */
+        MPI_Bcast(&m_subfileIndex, 1, MPI_INT, 0, m_subfileComm);
+
+        status = H5Pset_fapl_mpio(m_fileAccessProperty, m_subfileComm, m_mpiInfo);
+        ASSERT(status >= 0, "Internal error: Failed to set HDF5 file access property");
+    }
+
+    if( m_metadataComm != MPI_COMM_NULL )
+        MPI_Comm_free(&m_metadataComm);
+
+    /* written files are modified collectively, so only read only metadata can be shared */
+    m_broadcastMetadata = options.metadataReaders != MR::ALL && m_handler->accessType == AccessType::READ_ONLY;
+    if( !m_broadcastMetadata )
+        return;
+
+    int mpi_status;
+    if( options.metadataReaders == MR::ONE_PER_NODE )
+    {
+        int rank;
+        MPI_Comm_rank(m_mpiComm, &rank);
+        mpi_status = MPI_Comm_split_type(m_mpiComm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &m_metadataComm);
+    } else
+        mpi_status = MPI_Comm_dup(m_mpiComm, &m_metadataComm);
+    if( mpi_status != MPI_SUCCESS )
+        throw std::runtime_error("Failed to create the communicator of parallel HDF5 metadata readers");
+    MPI_Comm_rank(m_metadataComm, &m_metadataRank);
+}
+
+namespace
+{
+bool
+isMetadataRead(Operation o)
+{
+    switch( o )
+    {
+        using O = Operation;
+        case O::OPEN_PATH:
+        case O::OPEN_DATASET:
+        case O::READ_ATT:
+        case O::READ_ATTS:
+        case O::LIST_PATHS:
+        case O::LIST_DATASETS:
+        case O::LIST_ATTS:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void
+broadcast(std::string& buffer, MPI_Comm comm)
+{
+    uint64_t size = buffer.size();
+    MPI_Bcast(&size, 1, MPI_UINT64_T, 0, comm);
+    buffer.resize(size);
+    for( uint64_t pos = 0; pos < size; )
+    {
+        int count = static_cast< int >(std::min< uint64_t >(size - pos, INT_MAX));
+        MPI_Bcast(&buffer[pos], count, MPI_CHAR, 0, comm);
+        pos += count;
+    }
+}
+
+enum class ReplayStatus : uint8_t
+{
+    OK,
+    UNSUPPORTED_DATA,
+    ERROR
+};
+
+/** Concatenation of the buffers of all ranks in comm, in the order of their ranks. */
+std::vector< std::string >
+allgather(std::string const& buffer, MPI_Comm comm)
+{
+    int size;
+    MPI_Comm_size(comm, &size);
+    int const length = static_cast< int >(buffer.size());
+    std::vector< int > lengths(size);
+    MPI_Allgather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, comm);
+    std::vector< int > displacements(size, 0);
+    for( int r = 1; r < size; ++r )
+        displacements[r] = displacements[r - 1] + lengths[r - 1];
+    std::string gathered(displacements.back() + lengths.back(), '\0');
+    MPI_Allgatherv(const_cast< char* >(buffer.data()), length, MPI_CHAR,
+                   &gathered[0], lengths.data(), displacements.data(), MPI_CHAR, comm);
+
+    std::vector< std::string > buffers;
+    for( int r = 0; r < size; ++r )
+        buffers.push_back(gathered.substr(displacements[r], lengths[r]));
+    return buffers;
+}
+
+std::string
+fileName(hid_t file)
+{
+    ssize_t length = H5Fget_name(file, nullptr, 0);
+    if( length < 0 )
+        throw std::runtime_error("Internal error: Failed to get HDF5 file name");
+    std::vector< char > name(length + 1);
+    H5Fget_name(file, name.data(), length + 1);
+    return std::string(name.data(), length);
+}
+} // namespace
+
+std::future< void >
+ParallelHDF5IOHandlerImpl::flush()
+{
+    /* any operation may change a subfile, its index is updated at the end of the batch */
+    if( m_handler->m_work.size() > 0 )
+        for( auto& subfile : m_subfiles )
+            subfile.second.modified = true;
+
+    if( !m_broadcastMetadata )
+        return HDF5IOHandlerImpl::flush();
+
+    auto& work = m_handler->m_work.collect();
+    while( !work.empty() )
+    {
+        /* split off the leading run of either metadata reads or other operations */
+        bool const metadata = isMetadataRead(work.front().operation);
+        std::queue< IOTask > run;
+        while( !work.empty() && isMetadataRead(work.front().operation) == metadata )
+        {
+            run.push(std::move(work.front()));
+            work.pop();
+        }
+
+        bool const reader = metadata && m_metadataRank == 0;
+        if( metadata && !reader )
+        {
+            std::string buffer;
+            broadcast(buffer, m_metadataComm);
+            m_metadataReplay = auxiliary::Deserializer(std::move(buffer));
+        }
+
+        try
+        {
+            process(run);
+        } catch( ... )
+        {
+            /* keep the outstanding operations in order, as if the run had been processed in place */
+            while( !work.empty() )
+            {
+                run.push(std::move(work.front()));
+                work.pop();
+            }
+            std::swap(work, run);
+            if( reader )
+            {
+                std::string buffer = m_metadataLog.buffer();
+                m_metadataLog.clear();
+                broadcast(buffer, m_metadataComm);
+            }
+            throw;
+        }
+
+        if( reader )
+        {
+            std::string buffer = m_metadataLog.buffer();
+            m_metadataLog.clear();
+            broadcast(buffer, m_metadataComm);
+        }
+    }
+
+    return std::future< void >();
+}
+
+bool
+ParallelHDF5IOHandlerImpl::broadcastsMetadata() const
+{
+    return m_broadcastMetadata;
+}
+
+template< typename F_Execute, typename F_Store, typename F_Load >
+void
+ParallelHDF5IOHandlerImpl::broadcastable(F_Execute execute, F_Store store, F_Load load)
+{
+    if( !m_broadcastMetadata )
+    {
+        execute();
+        return;
+    }
+
+    if( m_metadataRank == 0 )
+    {
+        try
+        {
+            execute();
+        } catch( unsupported_data_error const& e )
+        {
+            m_metadataLog.write(ReplayStatus::UNSUPPORTED_DATA);
+            m_metadataLog.write(std::string(e.what()));
+            throw;
+        } catch( std::exception const& e )
+        {
+            m_metadataLog.write(ReplayStatus::ERROR);
+            m_metadataLog.write(std::string(e.what()));
+            throw;
+        }
+        m_metadataLog.write(ReplayStatus::OK);
+        store(m_metadataLog);
+    } else
+    {
+        ReplayStatus status;
+        m_metadataReplay.read(status);
+        if( status != ReplayStatus::OK )
+        {
+            std::string what;
+            m_metadataReplay.read(what);
+            if( status == ReplayStatus::UNSUPPORTED_DATA )
+                throw unsupported_data_error(what);
+            throw std::runtime_error(what);
+        }
+        load(m_metadataReplay);
+    }
+}
+
+namespace
+{
+/** Absolute path of a dataset without trailing slash, as listed when traversing a file. */
+std::string
+datasetKey(std::string path)
+{
+    path = auxiliary::replace_all(path, "//", "/");
+    if( auxiliary::ends_with(path, "/") )
+        path.pop_back();
+    if( !auxiliary::starts_with(path, "/") )
+        path.insert(0, "/");
+    return path;
+}
+
+/** Group at the root of each subfile holding the datasets that store the written regions. */
+constexpr char const* storageGroup = ".subfile_storage";
+
+/** One region of a dataset written by some rank to a subfile. */
+struct SubfileRegion
+{
+    uint64_t index;         /* of the subfile */
+    std::string subfile;
+    Offset offset;
+    Extent extent;
+    std::string storage;    /* dataset of the subfile holding the region */
+    Offset storageOffset;
+    Extent storageExtent;
+};
+using SubfileRegions = std::map< std::string, std::vector< SubfileRegion > >;
+
+herr_t
+collectLinkCallback(hid_t, char const* name, H5L_info_t const*, void* data)
+{
+    static_cast< std::vector< std::string >* >(data)->emplace_back(name);
+    return 0;
+}
+
+herr_t
+copyAttributeCallback(hid_t location, char const* name, H5A_info_t const*, void* data)
+{
+    hid_t target = *static_cast< hid_t* >(data);
+    hid_t attr = H5Aopen(location, name, H5P_DEFAULT);
+    if( attr < 0 )
+        return -1;
+    hid_t type = H5Aget_type(attr);
+    hid_t space = H5Aget_space(attr);
+    std::vector< char > buffer(H5Tget_size(type) * std::max< hssize_t >(H5Sget_simple_extent_npoints(space), 1));
+    herr_t status = H5Aread(attr, type, buffer.data());
+    if( status >= 0 )
+    {
+        hid_t copy = H5Acreate(target, name, type, space, H5P_DEFAULT, H5P_DEFAULT);
+        status = copy < 0 ? -1 : H5Awrite(copy, type, buffer.data());
+        if( copy >= 0 )
+            H5Aclose(copy);
+        if( H5Tdetect_class(type, H5T_VLEN) > 0 || H5Tis_variable_str(type) > 0 )
+            H5Dvlen_reclaim(type, space, H5P_DEFAULT, buffer.data());
+    }
+    H5Sclose(space);
+    H5Tclose(type);
+    H5Aclose(attr);
+    return status < 0 ? -1 : 0;
+}
+
+void
+copyAttributes(hid_t source, hid_t target, std::string const& path)
+{
+    herr_t status = H5Aiterate2(source,
+                                H5_INDEX_NAME,
+                                H5_ITER_NATIVE,
+                                nullptr,
+                                copyAttributeCallback,
+                                &target);
+    if( status < 0 )
+        throw std::runtime_error("Failed to copy the attributes of " + path + " into the index of HDF5 subfiles");
+}
+
+/** Create a virtual dataset gathering the regions written to the subfiles. */
+void
+createVirtualDataset(hid_t source, hid_t target, std::string const& name, std::string const& path,
+                     SubfileRegions const& regions, std::map< std::string, Extent > const& extents)
+{
+    hid_t dataset = H5Dopen(source, name.c_str(), H5P_DEFAULT);
+    if( dataset < 0 )
+        throw std::runtime_error("Failed to open " + path + " in HDF5 subfile");
+    hid_t type = H5Dget_type(dataset);
+    hid_t space = H5Dget_space(dataset);
+    int const rank = H5Sget_simple_extent_ndims(space);
+    std::vector< hsize_t > dims(std::max(rank, 0));
+    H5Sget_simple_extent_dims(space, dims.data(), nullptr);
+    /* the dataset in the subfile holds no elements, the index gets the extent requested for it */
+    auto extent = extents.find(path);
+    if( extent != extents.end() && extent->second.size() == dims.size() )
+        dims.assign(extent->second.begin(), extent->second.end());
+    hid_t virtualSpace = H5Screate_simple(rank, dims.data(), nullptr);
+    hid_t property = H5Pcreate(H5P_DATASET_CREATE);
+
+    herr_t status = 0;
+    auto res = regions.find(path);
+    if( res != regions.end() )
+        for( auto const& r : res->second )
+        {
+            if( r.offset.size() != static_cast< std::size_t >(rank)
+                || std::find(r.extent.begin(), r.extent.end(), 0u) != r.extent.end() )
+                continue;
+            /* regions beyond a dataset that has been shrunk after writing them are dropped */
+            bool inside = true;
+            for( int d = 0; d < rank; ++d )
+                inside = inside && r.offset[d] + r.extent[d] <= dims[d];
+            if( !inside )
+                continue;
+            std::vector< hsize_t > start(r.offset.begin(), r.offset.end());
+            std::vector< hsize_t > count(r.extent.begin(), r.extent.end());
+            std::vector< hsize_t > storageStart(r.storageOffset.begin(), r.storageOffset.end());
+            std::vector< hsize_t > storageDims(r.storageExtent.begin(), r.storageExtent.end());
+            status = H5Sselect_hyperslab(virtualSpace, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr);
+            if( status < 0 )
+                break;
+            hid_t storageSpace = H5Screate_simple(rank, storageDims.data(), nullptr);
+            status = H5Sselect_hyperslab(storageSpace, H5S_SELECT_SET, storageStart.data(), nullptr, count.data(), nullptr);
+            if( status >= 0 )
+                status = H5Pset_virtual(property, virtualSpace, r.subfile.c_str(), r.storage.c_str(), storageSpace);
+            H5Sclose(storageSpace);
+            if( status < 0 )
+                break;
+        }
+    H5Sselect_all(virtualSpace);
+
+    hid_t copy = -1;
+    if( status >= 0 )
+        copy = H5Dcreate(target, name.c_str(), type, virtualSpace, H5P_DEFAULT, property, H5P_DEFAULT);
+    H5Pclose(property);
+    H5Sclose(virtualSpace);
+    H5Sclose(space);
+    H5Tclose(type);
+    if( copy < 0 )
+    {
+        H5Dclose(dataset);
+        throw std::runtime_error("Failed to create the virtual dataset " + path + " in the index of HDF5 subfiles");
+    }
+    try
+    {
+        copyAttributes(dataset, copy, path);
+    } catch( ... )
+    {
+        H5Dclose(copy);
+        H5Dclose(dataset);
+        throw;
+    }
+    H5Dclose(copy);
+    H5Dclose(dataset);
+}
+
+/** Recreate the groups below a group of a subfile, with virtual datasets in place of its datasets. */
+void
+copyGroup(hid_t source, hid_t target, std::string const& path,
+          SubfileRegions const& regions, std::map< std::string, Extent > const& extents)
+{
+    copyAttributes(source, target, path);
+
+    std::vector< std::string > names;
+    herr_t status = H5Literate(source, H5_INDEX_NAME, H5_ITER_INC, nullptr, collectLinkCallback, &names);
+    if( status < 0 )
+        throw std::runtime_error("Failed to iterate " + path + " in HDF5 subfile");
+    for( auto const& name : names )
+    {
+        if( path == "/" && name == storageGroup )
+            continue;
+        std::string const childPath = (path == "/" ? path : path + "/") + name;
+        H5O_type_t const type = h5_object_type(source, name.c_str());
+        if( type == H5O_TYPE_DATASET )
+            createVirtualDataset(source, target, name, childPath, regions, extents);
+        else if( type == H5O_TYPE_GROUP )
+        {
+            hid_t sourceGroup = H5Gopen(source, name.c_str(), H5P_DEFAULT);
+            hid_t targetGroup = H5Gcreate(target, name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            if( sourceGroup < 0 || targetGroup < 0 )
+            {
+                if( sourceGroup >= 0 )
+                    H5Gclose(sourceGroup);
+                if( targetGroup >= 0 )
+                    H5Gclose(targetGroup);
+                throw std::runtime_error("Failed to copy the group " + childPath + " into the index of HDF5 subfiles");
+            }
+            try
+            {
+                copyGroup(sourceGroup, targetGroup, childPath, regions, extents);
+            } catch( ... )
+            {
+                H5Gclose(targetGroup);
+                H5Gclose(sourceGroup);
+                throw;
+            }
+            H5Gclose(targetGroup);
+            H5Gclose(sourceGroup);
+        }
+    }
+}
+} // namespace
+
+void
+ParallelHDF5IOHandlerImpl::createFile(Writable* writable,
+                                      Parameter< Operation::CREATE_FILE > const& parameters)
+{
+    if( m_subfileComm == MPI_COMM_NULL || writable->written )
+    {
+        HDF5IOHandlerImpl::createFile(writable, parameters);
+        return;
+    }
+
+    using namespace boost::filesystem;
+    std::string name = parameters.name;
+    if( !auxiliary::ends_with(name, ".h5") )
+        name += ".h5";
+    path const index(name);
+    std::string const subfiles = index.stem().string() + "_subfiles";
+
+    Subfile subfile;
+    subfile.index = m_handler->directory + name;
+    subfile.name = subfiles + "/" + std::to_string(m_subfileIndex) + ".h5";
+
+    /* concurrent creation of the directory by several ranks is fine as long as it exists afterwards */
+    path const dir = path(m_handler->directory) / index.parent_path() / subfiles;
+    boost::system::error_code ec;
+    create_directories(dir, ec);
+    if( !exists(dir) )
+        throw std::runtime_error("Failed to create the directory of HDF5 subfiles " + dir.string());
+
+    Parameter< Operation::CREATE_FILE > subfileParameters = parameters;
+    subfileParameters.name = (index.parent_path() / subfile.name).string();
+    HDF5IOHandlerImpl::createFile(writable, subfileParameters);
+
+    m_subfiles.emplace(m_fileIDs.at(writable), std::move(subfile));
+}
+
+void
+ParallelHDF5IOHandlerImpl::closeFile(Writable* writable,
+                                     Parameter< Operation::CLOSE_FILE > const& parameters)
+{
+    settleBatch(false);
+
+    auto file = m_fileIDs.find(writable);
+    auto subfile = file == m_fileIDs.end() ? m_subfiles.end() : m_subfiles.find(file->second);
+
+    HDF5IOHandlerImpl::closeFile(writable, parameters);
+
+    if( subfile != m_subfiles.end() )
+    {
+        Subfile closed = std::move(subfile->second);
+        m_subfiles.erase(subfile);
+        writeSubfileIndex(closed);
+    }
+}
+
+void
+ParallelHDF5IOHandlerImpl::createDataset(Writable* writable,
+                                         Parameter< Operation::CREATE_DATASET > const& parameters)
+{
+    auto subfile = m_subfiles.end();
+    if( !writable->written )
+        subfile = m_subfiles.find(fileOf(writable));
+    if( subfile == m_subfiles.end() )
+    {
+        HDF5IOHandlerImpl::createDataset(writable, parameters);
+        return;
+    }
+
+    /* nothing is allocated for a dataset without elements, the regions written to it are stored by completeBatch() */
+    Parameter< Operation::CREATE_DATASET > empty = parameters;
+    empty.extent = Extent(parameters.extent.size(), 0u);
+    HDF5IOHandlerImpl::createDataset(writable, empty);
+    subfile->second.extents[datasetKey(concrete_h5_file_position(writable))] = {parameters.extent, parameters.fixedSize};
+}
+
+void
+ParallelHDF5IOHandlerImpl::extendDataset(Writable* writable,
+                                         Parameter< Operation::EXTEND_DATASET > const& parameters)
+{
+    auto subfile = m_subfiles.end();
+    if( writable->written )
+        subfile = m_subfiles.find(fileOf(writable));
+    if( subfile == m_subfiles.end() )
+    {
+        HDF5IOHandlerImpl::extendDataset(writable, parameters);
+        return;
+    }
+
+    auto& extent = subfile->second.extents[datasetKey(concrete_h5_file_position(writable))];
+    if( extent.second )
+        for( std::size_t i = 0; i < parameters.extent.size() && i < extent.first.size(); ++i )
+            if( parameters.extent[i] > extent.first[i] )
+                throw std::runtime_error("Dataset " + concrete_h5_file_position(writable) + " has a fixed size and can not be extended");
+    extent.first = parameters.extent;
+}
+
+void
+ParallelHDF5IOHandlerImpl::writeDataset(Writable* writable,
+                                        Parameter< Operation::WRITE_DATASET > const& parameters)
+{
+    Transfer transfer = parameters.transfer == Transfer::DEFAULT ? m_defaultTransfer : parameters.transfer;
+    hid_t file = fileOf(writable);
+    if( m_subfiles.count(file) == 1 )
+    {
+        hid_t property = transfer == Transfer::INDEPENDENT ? m_independentTransferProperty : m_datasetTransferProperty;
+        m_subfileWrites[{fileName(file), datasetKey(concrete_h5_file_position(writable))}]
+            .push_back(DeferredWrite{writable, parameters, property, std::string()});
+    } else if( transfer == Transfer::INDEPENDENT )
+        writeChunk(writable, parameters, m_independentTransferProperty);
+    else if( m_defaultTransfer == Transfer::INDEPENDENT )
+        /* flushes are not synchronized, the application writes these chunks in lockstep */
+        writeChunk(writable, parameters, m_datasetTransferProperty);
+    else
+        m_collectiveWrites[{fileName(file), concrete_h5_file_position(writable)}]
+            .push_back(DeferredWrite{writable, parameters, m_datasetTransferProperty, std::string()});
+}
+
+void
+ParallelHDF5IOHandlerImpl::completeBatch()
+{
+    settleBatch(false);
+    indexSubfiles();
+}
+
+void
+ParallelHDF5IOHandlerImpl::abortBatch()
+{
+    /* the failure happened after the ranks have exchanged the outcome of the batch, no one is left waiting */
+    if( m_batchSettling )
+    {
+        m_batchSettling = false;
+        m_collectiveWrites.clear();
+        m_subfileWrites.clear();
+        return;
+    }
+    try
+    {
+        settleBatch(true);
+    } catch( std::exception const& e )
+    {
+        std::cerr << "Failed to settle the collective writes of a failed flush: " << e.what() << std::endl;
+    } catch( ... )
+    {
+        std::cerr << "Failed to settle the collective writes of a failed flush" << std::endl;
+    }
+    m_batchSettling = false;
+}
+
+void
+ParallelHDF5IOHandlerImpl::settleBatch(bool failed)
+{
+    if( m_handler->accessType == AccessType::READ_ONLY
+        || (m_defaultTransfer != Transfer::COLLECTIVE && m_subfileComm == MPI_COMM_NULL) )
+        return;
+
+    /* the writes are taken first, so a failing one is not issued again by the next batch */
+    DeferredWrites writes;
+    std::swap(writes, m_collectiveWrites);
+    DeferredWrites subfileWrites;
+    std::swap(subfileWrites, m_subfileWrites);
+
+    int anyFailed = failed;
+    int status = MPI_Allreduce(MPI_IN_PLACE, &anyFailed, 1, MPI_INT, MPI_LOR, m_mpiComm);
+    if( status != MPI_SUCCESS )
+        throw std::runtime_error("Internal error: Failed to agree on the outcome of the collective writes");
+    /* all ranks know the outcome of the batch, a failure from here on needs no announcement */
+    m_batchSettling = true;
+    /* a partial batch is not written by any rank */
+    if( anyFailed )
+    {
+        if( failed )
+            return;
+        throw std::runtime_error("Collective writes have been dropped, as another rank failed during the flush");
+    }
+
+    if( m_subfileComm != MPI_COMM_NULL )
+        storeInSubfiles(std::move(subfileWrites), writes);
+    writeCollectively(writes);
+    m_batchSettling = false;
+}
+
+void
+ParallelHDF5IOHandlerImpl::storeInSubfiles(DeferredWrites&& subfileWrites, DeferredWrites& collective)
+{
+    auxiliary::Serializer s;
+    s.write(static_cast< uint64_t >(subfileWrites.size()));
+    for( auto const& dataset : subfileWrites )
+    {
+        s.write(dataset.first.first);
+        s.write(dataset.first.second);
+        s.write(static_cast< uint64_t >(dataset.second.size()));
+        for( auto const& w : dataset.second )
+        {
+            s.write(w.parameters.offset);
+            s.write(w.parameters.extent);
+        }
+    }
+
+    /* the bounding box (lower and upper corner) of the non-empty regions of each dataset written by the group */
+    std::map< std::pair< std::string, std::string >, std::pair< Offset, Offset > > boxes;
+    for( auto& buffer : allgather(s.buffer(), m_subfileComm) )
+    {
+        auxiliary::Deserializer d(std::move(buffer));
+        uint64_t numDatasets;
+        d.read(numDatasets);
+        for( uint64_t i = 0; i < numDatasets; ++i )
+        {
+            std::pair< std::string, std::string > key;
+            uint64_t numWrites;
+            d.read(key.first);
+            d.read(key.second);
+            d.read(numWrites);
+            for( uint64_t j = 0; j < numWrites; ++j )
+            {
+                Offset offset;
+                Extent extent;
+                d.read(offset);
+                d.read(extent);
+                if( std::find(extent.begin(), extent.end(), 0u) != extent.end() )
+                    continue;
+                auto box = boxes.find(key);
+                if( box == boxes.end() )
+                {
+                    Offset upper(offset.size());
+                    for( std::size_t k = 0; k < offset.size(); ++k )
+                        upper[k] = offset[k] + extent[k];
+                    boxes.emplace(key, std::make_pair(offset, upper));
+                    continue;
+                }
+                for( std::size_t k = 0; k < offset.size() && k < box->second.first.size(); ++k )
+                {
+                    box->second.first[k] = std::min(box->second.first[k], offset[k]);
+                    box->second.second[k] = std::max(box->second.second[k], offset[k] + extent[k]);
+                }
+            }
+        }
+    }
+
+    std::map< std::string, hid_t > files;
+    for( auto const& subfile : m_subfiles )
+        files[fileName(subfile.first)] = subfile.first;
+
+    /* all ranks of the group create the same datasets in the same order */
+    for( auto const& box : boxes )
+    {
+        hid_t file = files.at(box.first.first);
+        Subfile& subfile = m_subfiles.at(file);
+        std::string const& path = box.first.second;
+        std::string const storage = "/" + std::string(storageGroup) + "/" + std::to_string(subfile.storages++);
+        Offset const& lower = box.second.first;
+        Extent storageExtent(lower.size());
+        for( std::size_t k = 0; k < lower.size(); ++k )
+            storageExtent[k] = box.second.second[k] - lower[k];
+
+        htri_t exists = H5Lexists(file, storageGroup, H5P_DEFAULT);
+        if( exists == 0 )
+        {
+            hid_t group = H5Gcreate(file, storageGroup, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            if( group < 0 )
+                throw std::runtime_error("Failed to create the group of stored regions in HDF5 subfile");
+            H5Gclose(group);
+        } else if( exists < 0 )
+            throw std::runtime_error("Failed to find the group of stored regions in HDF5 subfile");
+
+        /* the regions are stored like the dataset would be, only with the extent of their bounding box */
+        hid_t dataset = H5Dopen(file, path.c_str(), H5P_DEFAULT);
+        if( dataset < 0 )
+            throw std::runtime_error("Failed to open " + path + " in HDF5 subfile");
+        hid_t type = H5Dget_type(dataset);
+        hid_t property = H5Dget_create_plist(dataset);
+        std::vector< hsize_t > dims(storageExtent.begin(), storageExtent.end());
+        herr_t status = 0;
+        if( H5Pget_layout(property) == H5D_CHUNKED )
+        {
+            std::vector< hsize_t > chunk(dims.size());
+            if( H5Pget_chunk(property, static_cast< int >(chunk.size()), chunk.data()) == static_cast< int >(chunk.size()) )
+            {
+                for( std::size_t k = 0; k < chunk.size(); ++k )
+                    chunk[k] = std::min(chunk[k], dims[k]);
+                status = H5Pset_chunk(property, static_cast< int >(chunk.size()), chunk.data());
+            }
+        } else
+            status = H5Pset_layout(property, H5D_CONTIGUOUS);
+        hid_t space = H5Screate_simple(static_cast< int >(dims.size()), dims.data(), nullptr);
+        hid_t stored = status < 0 ? -1 : H5Dcreate(file, storage.c_str(), type, space, H5P_DEFAULT, property, H5P_DEFAULT);
+        H5Sclose(space);
+        H5Pclose(property);
+        H5Tclose(type);
+        H5Dclose(dataset);
+        if( stored < 0 )
+            throw std::runtime_error("Failed to create " + storage + " for the regions of " + path + " in HDF5 subfile");
+        H5Dclose(stored);
+
+        auto local = subfileWrites.find(box.first);
+        if( local == subfileWrites.end() )
+            continue;
+        auto& regions = subfile.regions[path];
+        for( auto& w : local->second )
+        {
+            Offset const& offset = w.parameters.offset;
+            Extent const& extent = w.parameters.extent;
+            if( std::find(extent.begin(), extent.end(), 0u) != extent.end() )
+                continue;
+            Offset storageOffset(offset.size());
+            for( std::size_t k = 0; k < offset.size(); ++k )
+                storageOffset[k] = offset[k] - lower[k];
+
+            /* merge consecutive writes continuing the previous region along the first dimension */
+            StoredRegion* last = regions.empty() ? nullptr : &regions.back();
+            if( last && last->storage == storage && !offset.empty() && last->offset.size() == offset.size()
+                && offset[0] == last->offset[0] + last->extent[0]
+                && std::equal(last->offset.begin() + 1, last->offset.end(), offset.begin() + 1)
+                && std::equal(last->extent.begin() + 1, last->extent.end(), extent.begin() + 1) )
+                last->extent[0] += extent[0];
+            else
+                regions.push_back(StoredRegion{offset, extent, storage, storageOffset, storageExtent});
+
+            w.parameters.offset = storageOffset;
+            w.storage = storage;
+            if( w.transferProperty == m_independentTransferProperty )
+                writeStored(w);
+            else
+                collective[{box.first.first, storage}].push_back(std::move(w));
+        }
+    }
+}
+
+void
+ParallelHDF5IOHandlerImpl::writeCollectively(DeferredWrites const& writes)
+{
+    auxiliary::Serializer s;
+    s.write(static_cast< uint64_t >(writes.size()));
+    for( auto const& dataset : writes )
+    {
+        s.write(dataset.first.first);
+        s.write(dataset.first.second);
+        s.write(static_cast< uint64_t >(dataset.second.size()));
+    }
+
+    /* the largest number of writes of any rank to each dataset */
+    std::map< std::pair< std::string, std::string >, uint64_t > counts;
+    for( auto& buffer : allgather(s.buffer(), m_mpiComm) )
+    {
+        auxiliary::Deserializer d(std::move(buffer));
+        uint64_t numDatasets;
+        d.read(numDatasets);
+        for( uint64_t i = 0; i < numDatasets; ++i )
+        {
+            std::pair< std::string, std::string > key;
+            uint64_t count;
+            d.read(key.first);
+            d.read(key.second);
+            d.read(count);
+            uint64_t& max = counts[key];
+            max = std::max(max, count);
+        }
+    }
+
+    for( auto const& dataset : counts )
+    {
+        uint64_t written = 0;
+        auto local = writes.find(dataset.first);
+        if( local != writes.end() )
+            for( auto const& w : local->second )
+            {
+                if( w.storage.empty() )
+                    writeChunk(w.writable, w.parameters, w.transferProperty);
+                else
+                    writeStored(w);
+                ++written;
+            }
+        if( written < dataset.second )
+            writeEmpty(dataset.first.first, dataset.first.second, dataset.second - written);
+    }
+}
+
+void
+ParallelHDF5IOHandlerImpl::writeEmpty(std::string const& name, std::string const& path, uint64_t count)
+{
+    /* ranks of other subfile groups do not take part in writes to this file */
+    auto file = std::find_if(m_openFileIDs.begin(), m_openFileIDs.end(),
+                             [&name](hid_t f){ return fileName(f) == name; });
+    if( file == m_openFileIDs.end() )
+        return;
+
+    hid_t dataset_id = H5Dopen(*file, path.c_str(), H5P_DEFAULT);
+    if( dataset_id < 0 )
+        throw std::runtime_error("Internal error: Failed to open HDF5 dataset " + path + " during empty collective write");
+    hid_t filespace = H5Dget_space(dataset_id);
+    hid_t type = H5Dget_type(dataset_id);
+    hsize_t const one = 1;
+    hid_t memspace = H5Screate_simple(1, &one, nullptr);
+    herr_t status = H5Sselect_none(filespace);
+    ASSERT(status == 0, "Internal error: Failed to select nothing during empty collective write");
+    status = H5Sselect_none(memspace);
+    ASSERT(status == 0, "Internal error: Failed to select nothing during empty collective write");
+
+    /* nothing is read from the buffer, it only has to be valid */
+    std::vector< char > dummy(H5Tget_size(type));
+    for( uint64_t i = 0; i < count && status >= 0; ++i )
+        status = H5Dwrite(dataset_id, type, memspace, filespace, m_datasetTransferProperty, dummy.data());
+
+    H5Sclose(memspace);
+    H5Tclose(type);
+    H5Sclose(filespace);
+    H5Dclose(dataset_id);
+    if( status < 0 )
+        throw std::runtime_error("Internal error: Failed to take part in collective write to HDF5 dataset " + path);
+}
+
+void
+ParallelHDF5IOHandlerImpl::writeStored(DeferredWrite const& w)
+{
+    hid_t dataset = H5Dopen(fileOf(w.writable), w.storage.c_str(), H5P_DEFAULT);
+    if( dataset < 0 )
+        throw std::runtime_error("Internal error: Failed to open " + w.storage + " in HDF5 subfile");
+    hid_t filespace = H5Dget_space(dataset);
+    try
+    {
+        writeChunk(dataset, filespace, w.parameters, w.transferProperty);
+    } catch( ... )
+    {
+        H5Sclose(filespace);
+        H5Dclose(dataset);
+        throw;
+    }
+    H5Sclose(filespace);
+    H5Dclose(dataset);
+}
+
+hid_t
+ParallelHDF5IOHandlerImpl::fileOf(Writable* writable) const
+{
+    auto file = m_fileIDs.find(writable);
+    if( file == m_fileIDs.end() )
+        file = m_fileIDs.find(writable->parent);
+    if( file == m_fileIDs.end() )
+        throw std::runtime_error("Internal error: Unknown file of dataset " + concrete_h5_file_position(writable));
+    return file->second;
+}
+
+void
+ParallelHDF5IOHandlerImpl::indexSubfiles()
+{
+    if( m_subfiles.empty() )
+        return;
+
+    /* the same subfiles are open on all ranks, in the order of their index on all of them */
+    std::map< std::string, hid_t > files;
+    for( auto const& subfile : m_subfiles )
+        files[subfile.second.index] = subfile.first;
+    /* data may have been written by some ranks only */
+    std::vector< int > modified;
+    for( auto const& file : files )
+        modified.push_back(m_subfiles.at(file.second).modified);
+    int status = MPI_Allreduce(MPI_IN_PLACE, modified.data(), static_cast< int >(modified.size()),
+                               MPI_INT, MPI_LOR, m_mpiComm);
+    if( status != MPI_SUCCESS )
+        throw std::runtime_error("Internal error: Failed to agree on the modified HDF5 subfiles");
+
+    std::size_t i = 0;
+    for( auto const& file : files )
+    {
+        if( !modified[i++] )
+            continue;
+
+        hid_t const id = file.second;
+        std::string const name = fileName(id);
+        releaseDatasetHandles(id);
+        releaseGroupListings(id);
+        herr_t closed = H5Fclose(id);
+        m_openFileIDs.erase(id);
+        Subfile subfile = std::move(m_subfiles.at(id));
+        m_subfiles.erase(id);
+        if( closed < 0 )
+            throw std::runtime_error("Internal error: Failed to close HDF5 subfile " + name + " for writing its index");
+
+        writeSubfileIndex(subfile);
+
+        hid_t reopened = H5Fopen(name.c_str(), H5F_ACC_RDWR, m_fileAccessProperty);
+        if( reopened < 0 )
+            throw std::runtime_error("Failed to open HDF5 subfile " + name + " again after writing its index");
+        m_openFileIDs.insert(reopened);
+        for( auto& f : m_fileIDs )
+            if( f.second == id )
+                f.second = reopened;
+        subfile.modified = false;
+        m_subfiles.emplace(reopened, std::move(subfile));
+    }
+}
+
+void
+ParallelHDF5IOHandlerImpl::writeSubfileIndex(Subfile const& subfile)
+{
+    auxiliary::Serializer s;
+    s.write(static_cast< uint64_t >(m_subfileIndex));
+    s.write(subfile.name);
+    s.write(static_cast< uint64_t >(subfile.extents.size()));
+    for( auto const& dataset : subfile.extents )
+    {
+        s.write(dataset.first);
+        s.write(dataset.second.first);
+    }
+    s.write(static_cast< uint64_t >(subfile.regions.size()));
+    for( auto const& dataset : subfile.regions )
+    {
+        s.write(dataset.first);
+        s.write(static_cast< uint64_t >(dataset.second.size()));
+        for( auto const& r : dataset.second )
+        {
+            s.write(r.offset);
+            s.write(r.extent);
+            s.write(r.storage);
+            s.write(r.storageOffset);
+            s.write(r.storageExtent);
+        }
+    }
+
+    int rank, size;
+    MPI_Comm_rank(m_mpiComm, &rank);
+    MPI_Comm_size(m_mpiComm, &size);
+    int const length = static_cast< int >(s.buffer().size());
+    std::vector< int > lengths(rank == 0 ? size : 0);
+    MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, m_mpiComm);
+    std::vector< int > displacements(lengths.size(), 0);
+    for( std::size_t i = 1; i < lengths.size(); ++i )
+        displacements[i] = displacements[i - 1] + lengths[i - 1];
+    std::string gathered(rank == 0 ? displacements.back() + lengths.back() : 0, '\0');
+    MPI_Gatherv(const_cast< char* >(s.buffer().data()), length, MPI_CHAR,
+                &gathered[0], lengths.data(), displacements.data(), MPI_CHAR,
+                0, m_mpiComm);
+
+    /* the first rank reports the outcome, so that all ranks fail together */
+    std::string error;
+    if( rank == 0 )
+    {
+        SubfileRegions regions;
+        std::map< std::string, Extent > extents;
+        for( int r = 0; r < size; ++r )
+        {
+            auxiliary::Deserializer d(gathered.substr(displacements[r], lengths[r]));
+            uint64_t index;
+            std::string name;
+            uint64_t numDatasets;
+            d.read(index);
+            d.read(name);
+            d.read(numDatasets);
+            for( uint64_t i = 0; i < numDatasets; ++i )
+            {
+                std::string dataset;
+                d.read(dataset);
+                d.read(extents[dataset]);
+            }
+            d.read(numDatasets);
+            for( uint64_t i = 0; i < numDatasets; ++i )
+            {
+                std::string dataset;
+                uint64_t numRegions;
+                d.read(dataset);
+                d.read(numRegions);
+                auto& datasetRegions = regions[dataset];
+                for( uint64_t j = 0; j < numRegions; ++j )
+                {
+                    SubfileRegion region{index, name, {}, {}, {}, {}, {}};
+                    d.read(region.offset);
+                    d.read(region.extent);
+                    d.read(region.storage);
+                    d.read(region.storageOffset);
+                    d.read(region.storageExtent);
+                    datasetRegions.push_back(std::move(region));
+                }
+            }
+        }
+        /* the mappings of each virtual dataset in the order of the subfiles, independent of the ranks writing them */
+        for( auto& dataset : regions )
+            std::stable_sort(dataset.second.begin(), dataset.second.end(),
+                             [](SubfileRegion const& a, SubfileRegion const& b)
+                             { return std::tie(a.index, a.offset) < std::tie(b.index, b.offset); });
+
+        using namespace boost::filesystem;
+        std::string const source = (path(subfile.index).parent_path() / subfile.name).string();
+        hid_t sourceFile = H5Fopen(source.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        hid_t indexFile = H5Fcreate(subfile.index.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+        if( sourceFile < 0 || indexFile < 0 )
+            error = "Failed to open " + source + " or create " + subfile.index;
+        else
+        {
+            hid_t sourceRoot = H5Gopen(sourceFile, "/", H5P_DEFAULT);
+            hid_t indexRoot = H5Gopen(indexFile, "/", H5P_DEFAULT);
+            try
+            {
+                copyGroup(sourceRoot, indexRoot, "/", regions, extents);
+            } catch( std::exception const& e )
+            {
+                error = e.what();
+            }
+            H5Gclose(indexRoot);
+            H5Gclose(sourceRoot);
+        }
+        if( indexFile >= 0 )
+            H5Fclose(indexFile);
+        if( sourceFile >= 0 )
+            H5Fclose(sourceFile);
+    }
+
+    /* the index must exist on return on all ranks, e.g. for reading the Series right away */
+    broadcast(error, m_mpiComm);
+    if( !error.empty() )
+        throw std::runtime_error(error);
+}
+
+void
+ParallelHDF5IOHandlerImpl::openPath(Writable* writable,
+                                    Parameter< Operation::OPEN_PATH > const& parameters)
+{
+    broadcastable([&]{ HDF5IOHandlerImpl::openPath(writable, parameters); },
+                  [](auxiliary::Serializer&){ },
+                  [&](auxiliary::Deserializer&){ replayOpen(writable, parameters.path); });
+}
+
+void
+ParallelHDF5IOHandlerImpl::openDataset(Writable* writable,
+                                       Parameter< Operation::OPEN_DATASET > & parameters)
+{
+    broadcastable([&]{ HDF5IOHandlerImpl::openDataset(writable, parameters); },
+                  [&](auxiliary::Serializer& s)
+                  {
+                      s.write(*parameters.dtype);
+                      s.write(*parameters.extent);
+                      s.write(*parameters.chunkSize);
+                  },
+                  [&](auxiliary::Deserializer& d)
+                  {
+                      d.read(*parameters.dtype);
+                      d.read(*parameters.extent);
+                      d.read(*parameters.chunkSize);
+                      replayOpen(writable, parameters.name);
+                  });
+}
+
+void
+ParallelHDF5IOHandlerImpl::readAttribute(Writable* writable,
+                                         Parameter< Operation::READ_ATT > & parameters)
+{
+    broadcastable([&]{ HDF5IOHandlerImpl::readAttribute(writable, parameters); },
+                  [&](auxiliary::Serializer& s){ s.write(*parameters.resource); },
+                  [&](auxiliary::Deserializer& d)
+                  {
+                      d.read(*parameters.resource);
+                      *parameters.dtype = Attribute(*parameters.resource).dtype;
+                  });
+}
+
+void
+ParallelHDF5IOHandlerImpl::readAttributes(Writable* writable,
+                                          Parameter< Operation::READ_ATTS > & parameters)
+{
+    broadcastable([&]{ HDF5IOHandlerImpl::readAttributes(writable, parameters); },
+                  [&](auxiliary::Serializer& s)
+                  {
+                      s.write(static_cast< uint64_t >(parameters.attributes->size()));
+                      for( auto const& a : *parameters.attributes )
+                      {
+                          s.write(a.first);
+                          s.write(a.second.getResource());
+                      }
+                      s.write(*parameters.skipped);
+                  },
+                  [&](auxiliary::Deserializer& d)
+                  {
+                      uint64_t size;
+                      d.read(size);
+                      for( uint64_t i = 0; i < size; ++i )
+                      {
+                          std::string name;
+                          Attribute::resource resource;
+                          d.read(name);
+                          d.read(resource);
+                          parameters.attributes->emplace(std::move(name), Attribute(std::move(resource)));
+                      }
+                      d.read(*parameters.skipped);
+                  });
+}
+
+void
+ParallelHDF5IOHandlerImpl::listPaths(Writable* writable,
+                                     Parameter< Operation::LIST_PATHS > & parameters)
+{
+    broadcastable([&]{ HDF5IOHandlerImpl::listPaths(writable, parameters); },
+                  [&](auxiliary::Serializer& s){ s.write(*parameters.paths); },
+                  [&](auxiliary::Deserializer& d){ d.read(*parameters.paths); });
+}
+
+void
+ParallelHDF5IOHandlerImpl::listDatasets(Writable* writable,
+                                        Parameter< Operation::LIST_DATASETS > & parameters)
+{
+    broadcastable([&]{ HDF5IOHandlerImpl::listDatasets(writable, parameters); },
+                  [&](auxiliary::Serializer& s){ s.write(*parameters.datasets); },
+                  [&](auxiliary::Deserializer& d){ d.read(*parameters.datasets); });
+}
+
+void
+ParallelHDF5IOHandlerImpl::listAttributes(Writable* writable,
+                                          Parameter< Operation::LIST_ATTS > & parameters)
+{
+    broadcastable([&]{ HDF5IOHandlerImpl::listAttributes(writable, parameters); },
+                  [&](auxiliary::Serializer& s){ s.write(*parameters.attributes); },
+                  [&](auxiliary::Deserializer& d){ d.read(*parameters.attributes); });
 }
 #else
 ParallelHDF5IOHandler::ParallelHDF5IOHandler(std::string const& path,
@@ -98,5 +1448,15 @@ ParallelHDF5IOHandler::flush()
 {
     return std::future< void >();
 }
+
+std::future< void >
+ParallelHDF5IOHandler::flushAsync()
+{
+    return std::future< void >();
+}
+
+void
+ParallelHDF5IOHandler::setOptions(ParallelHDF5Options const&)
+{ }
 #endif
 } // openPMD
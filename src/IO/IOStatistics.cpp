@@ -0,0 +1,312 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/IO/IOStatistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace openPMD
+{
+constexpr std::size_t OperationStatistics::numBins;
+
+std::map< Operation, OperationStatistics >
+IOStatistics::snapshot() const
+{
+    std::lock_guard< std::mutex > lock(m_mutex);
+    return m_operations;
+}
+
+void
+IOStatistics::reset()
+{
+    std::lock_guard< std::mutex > lock(m_mutex);
+    m_operations.clear();
+}
+
+namespace
+{
+uint64_t
+chunkBytes(Datatype dtype, Extent const& extent)
+{
+    uint64_t bytes = toBytes(dtype);
+    for( auto const& e : extent )
+        bytes *= e;
+    return bytes;
+}
+} // namespace
+
+uint64_t
+IOStatistics::transferredBytes(IOTask const& task)
+{
+    using O = Operation;
+    switch( task.operation )
+    {
+        case O::WRITE_DATASET:
+        {
+            auto const& p = task.getParameter< O::WRITE_DATASET >();
+            return chunkBytes(p.dtype, p.extent);
+        }
+        case O::READ_DATASET:
+        {
+            auto const& p = task.getParameter< O::READ_DATASET >();
+            if( !p.points.empty() )
+                return chunkBytes(p.dtype, {p.points.size() / std::max< size_t >(p.offset.size(), 1u)});
+            if( !p.regions.empty() )
+            {
+                uint64_t bytes = 0;
+                for( auto const& region : p.regions )
+                    bytes += chunkBytes(p.dtype, region.second);
+                return bytes;
+            }
+            if( p.stride.empty() )
+                return chunkBytes(p.dtype, p.extent);
+            /* only the selected blocks are transferred */
+            Extent selected;
+            for( size_t i = 0; i < p.extent.size(); ++i )
+            {
+                uint64_t const b = p.block.empty() ? 1u : p.block[i];
+                selected.push_back(((p.extent[i] - b) / p.stride[i] + 1) * b);
+            }
+            return chunkBytes(p.dtype, selected);
+        }
+        case O::MAP_DATASET:
+        {
+            auto const& p = task.getParameter< O::MAP_DATASET >();
+            return chunkBytes(p.dtype, p.extent);
+        }
+        default:
+            return 0;
+    }
+}
+
+#if openPMD_HAVE_INSTRUMENTATION
+void
+IOStatistics::record(Measurement& m, std::chrono::steady_clock::time_point end)
+{
+    std::chrono::duration< double > const d = end - m.m_start;
+    double const seconds = d.count();
+    std::size_t bin = 0;
+    double const microseconds = seconds * 1e6;
+    if( microseconds >= 1. )
+        bin = std::min< std::size_t >(static_cast< std::size_t >(std::log2(microseconds)) + 1u,
+                                      OperationStatistics::numBins - 1u);
+
+    std::lock_guard< std::mutex > lock(m_mutex);
+    OperationStatistics& s = m_operations[m.m_operation];
+    ++s.count;
+    s.bytes += m.m_bytes;
+    s.seconds += seconds;
+    ++s.histogram[bin];
+
+    if( m_tracing )
+        m_events.push_back(Event{m.m_operation,
+                                 std::move(m.m_path),
+                                 m.m_bytes,
+                                 m.m_enqueued,
+                                 m.m_start,
+                                 end,
+                                 std::this_thread::get_id()});
+}
+#endif
+
+IOStatistics::~IOStatistics()
+{
+    try
+    {
+        stopTrace();
+    } catch( std::exception const& e )
+    {
+        std::cerr << "Failed to write IO trace: " << e.what() << std::endl;
+    }
+}
+
+void
+IOStatistics::startTrace(std::string const& filename, int pid)
+{
+#if openPMD_HAVE_INSTRUMENTATION
+    stopTrace();
+    std::lock_guard< std::mutex > lock(m_mutex);
+    m_traceFile = filename;
+    m_tracePid = pid;
+    m_traceStart = std::chrono::steady_clock::now();
+    m_tracing = true;
+#else
+    (void)filename;
+    (void)pid;
+    throw std::runtime_error("IO tracing requires openPMD-api to be built with openPMD_USE_INSTRUMENTATION=ON");
+#endif
+}
+
+namespace
+{
+std::string
+escapeJSON(std::string const& s)
+{
+    std::ostringstream ret;
+    for( char c : s )
+    {
+        if( c == '"' || c == '\\' )
+            ret << '\\' << c;
+        else if( static_cast< unsigned char >(c) < 0x20 )
+            ret << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast< int >(c) << std::dec;
+        else
+            ret << c;
+    }
+    return ret.str();
+}
+} // namespace
+
+void
+IOStatistics::stopTrace()
+{
+    std::vector< Event > events;
+    std::string filename;
+    std::chrono::steady_clock::time_point origin;
+    int pid;
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        if( !m_tracing )
+            return;
+        m_tracing = false;
+        std::swap(events, m_events);
+        filename = m_traceFile;
+        origin = m_traceStart;
+        pid = m_tracePid;
+    }
+
+    std::ofstream out(filename);
+    if( !out )
+        throw std::runtime_error("Failed to open IO trace file " + filename);
+
+    /* threads are numbered in order of their first event, the thread starting the trace is not necessarily 0 */
+    std::map< std::thread::id, int > threads;
+    auto micros = [&origin](std::chrono::steady_clock::time_point t)
+    {
+        return std::chrono::duration< double, std::micro >(t - origin).count();
+    };
+
+    out << std::fixed << std::setprecision(3) << "{\"traceEvents\": [";
+    for( std::size_t i = 0; i < events.size(); ++i )
+    {
+        Event const& e = events[i];
+        auto tid = threads.emplace(e.thread, static_cast< int >(threads.size())).first->second;
+        std::ostringstream name;
+        name << e.operation;
+        out << (i == 0 ? "\n" : ",\n")
+            << "{\"name\": \"" << name.str() << "\", \"cat\": \"openPMD\", \"ph\": \"X\""
+            << ", \"pid\": " << pid << ", \"tid\": " << tid
+            << ", \"ts\": " << micros(e.start) << ", \"dur\": " << micros(e.end) - micros(e.start)
+            << ", \"args\": {\"path\": \"" << escapeJSON(e.path) << "\""
+            << ", \"bytes\": " << e.bytes
+            << ", \"enqueued\": " << micros(e.enqueued)
+            << ", \"queued\": " << micros(e.start) - micros(e.enqueued) << "}}";
+    }
+    out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    if( !out )
+        throw std::runtime_error("Failed to write IO trace file " + filename);
+}
+} // openPMD
+
+std::ostream&
+std::operator<<(std::ostream& os, openPMD::Operation o)
+{
+    using O = openPMD::Operation;
+    switch( o )
+    {
+        case O::CREATE_FILE:
+            os << "CREATE_FILE";
+            break;
+        case O::OPEN_FILE:
+            os << "OPEN_FILE";
+            break;
+        case O::CLOSE_FILE:
+            os << "CLOSE_FILE";
+            break;
+        case O::DELETE_FILE:
+            os << "DELETE_FILE";
+            break;
+        case O::ADVANCE:
+            os << "ADVANCE";
+            break;
+        case O::CREATE_PATH:
+            os << "CREATE_PATH";
+            break;
+        case O::OPEN_PATH:
+            os << "OPEN_PATH";
+            break;
+        case O::DELETE_PATH:
+            os << "DELETE_PATH";
+            break;
+        case O::LIST_PATHS:
+            os << "LIST_PATHS";
+            break;
+        case O::CREATE_DATASET:
+            os << "CREATE_DATASET";
+            break;
+        case O::EXTEND_DATASET:
+            os << "EXTEND_DATASET";
+            break;
+        case O::OPEN_DATASET:
+            os << "OPEN_DATASET";
+            break;
+        case O::DELETE_DATASET:
+            os << "DELETE_DATASET";
+            break;
+        case O::WRITE_DATASET:
+            os << "WRITE_DATASET";
+            break;
+        case O::READ_DATASET:
+            os << "READ_DATASET";
+            break;
+        case O::MAP_DATASET:
+            os << "MAP_DATASET";
+            break;
+        case O::LIST_DATASETS:
+            os << "LIST_DATASETS";
+            break;
+        case O::DELETE_ATT:
+            os << "DELETE_ATT";
+            break;
+        case O::WRITE_ATT:
+            os << "WRITE_ATT";
+            break;
+        case O::WRITE_ATTS:
+            os << "WRITE_ATTS";
+            break;
+        case O::READ_ATT:
+            os << "READ_ATT";
+            break;
+        case O::READ_ATTS:
+            os << "READ_ATTS";
+            break;
+        case O::LIST_ATTS:
+            os << "LIST_ATTS";
+            break;
+    }
+    return os;
+}
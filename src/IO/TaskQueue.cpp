@@ -0,0 +1,75 @@
+/* Copyright 2017-2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/IO/TaskQueue.hpp"
+
+#include <utility>
+
+
+namespace openPMD
+{
+TaskQueue::~TaskQueue()
+{
+    collect();
+}
+
+void
+TaskQueue::push(IOTask task)
+{
+    Node* node = new Node{std::move(task), m_pushed.load(std::memory_order_relaxed)};
+    m_numPushed.fetch_add(1, std::memory_order_relaxed);
+    while( !m_pushed.compare_exchange_weak(node->next, node,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed) )
+        ;
+}
+
+std::queue< IOTask >&
+TaskQueue::collect()
+{
+    /* there is only one consumer, so taking the whole list can not suffer from ABA */
+    Node* node = m_pushed.exchange(nullptr, std::memory_order_acquire);
+    Node* fifo = nullptr;
+    std::size_t numTaken = 0;
+    while( node )
+    {
+        Node* next = node->next;
+        node->next = fifo;
+        fifo = node;
+        node = next;
+        ++numTaken;
+    }
+    m_numPushed.fetch_sub(numTaken, std::memory_order_relaxed);
+    while( fifo )
+    {
+        Node* next = fifo->next;
+        m_collected.push(std::move(fifo->task));
+        delete fifo;
+        fifo = next;
+    }
+    return m_collected;
+}
+
+std::size_t
+TaskQueue::size() const
+{
+    return m_numPushed.load(std::memory_order_relaxed) + m_collected.size();
+}
+} // openPMD
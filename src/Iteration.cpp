@@ -23,12 +23,19 @@
 #include "openPMD/Iteration.hpp"
 #include "openPMD/Series.hpp"
 
+#include <algorithm>
+#include <set>
+
 
 namespace openPMD
 {
 Iteration::Iteration()
         : meshes{Container< Mesh >()},
-          particles{Container< ParticleSpecies >()}
+          particles{Container< ParticleSpecies >()},
+          m_index{0},
+          m_parsed{true},
+          m_closed{false},
+          m_prefetched{false}
 {
     setTime(static_cast< double >(0));
     setDt(static_cast< double >(1));
@@ -38,7 +45,12 @@ Iteration::Iteration()
 Iteration::Iteration(Iteration const& i)
         : Attributable{i},
           meshes{i.meshes},
-          particles{i.particles}
+          particles{i.particles},
+          m_index{i.m_index},
+          m_fileName{i.m_fileName},
+          m_parsed{i.m_parsed},
+          m_closed{i.m_closed},
+          m_prefetched{i.m_prefetched}
 {
     IOHandler = i.IOHandler;
     parent = i.parent;
@@ -81,6 +93,157 @@ Iteration::setTimeUnitSI(double timeUnitSI)
     return *this;
 }
 
+Iteration&
+Iteration::open()
+{
+    if( m_closed )
+        throw std::runtime_error("A closed iteration can not be accessed again in a Series opened for writing.");
+
+    parse();
+    series()->prefetchAfter(*this);
+    return *this;
+}
+
+void
+Iteration::parse()
+{
+    if( m_parsed )
+        return;
+
+    /* re-use the handles of the Series and its iterations container,
+     * as was done when registering the iteration */
+    Series* s = series();
+    readFile(s, &s->iterations, m_index);
+}
+
+Series*
+Iteration::series() const
+{
+    Series* s = parent ? dynamic_cast< Series* >(parent->parent) : nullptr;
+    if( !s )
+        throw std::runtime_error("Only an iteration contained in the iterations of a Series can be opened.");
+    return s;
+}
+
+void
+Iteration::readFile(Writable* file, Writable* iterationsGroup, uint64_t index)
+{
+    Writable *w = this;
+    while( w->parent )
+        w = w->parent;
+    Series* s = dynamic_cast<Series *>(w);
+
+    Parameter< Operation::OPEN_FILE > fOpen;
+    fOpen.name = m_fileName;
+    IOHandler->enqueue(IOTask(file, fOpen));
+
+    Parameter< Operation::OPEN_PATH > pOpen;
+    pOpen.path = auxiliary::replace_first(s->basePath(), "/%T/", "");
+    IOHandler->enqueue(IOTask(iterationsGroup, pOpen));
+
+    Parameter< Operation::OPEN_PATH > pOpenIteration;
+    pOpenIteration.path = std::to_string(index);
+    IOHandler->enqueue(IOTask(this, pOpenIteration));
+    IOHandler->flush();
+
+    read();
+    m_parsed = true;
+}
+
+Iteration&
+Iteration::close()
+{
+    if( m_closed )
+        return *this;
+
+    if( IOHandler->accessType == AccessType::READ_ONLY )
+    {
+        if( m_fileName.empty() )
+            throw std::runtime_error("Only iterations of a fileBased Series opened for reading can be closed.");
+        if( !m_parsed )
+            return *this;
+
+        Parameter< Operation::CLOSE_FILE > fClose;
+        IOHandler->enqueue(IOTask(this, fClose));
+        IOHandler->flush();
+        m_parsed = false;
+        m_prefetched = false;
+    } else
+    {
+        Writable *w = this;
+        while( w->parent )
+            w = w->parent;
+        Series* s = dynamic_cast<Series *>(w);
+
+        /* everything written so far has to reach the file before the tree is released */
+        trimAppended();
+        flush();
+
+        /* in groupBased encoding, the file is shared with all other iterations */
+        if( written && s->iterationEncoding() == IterationEncoding::fileBased )
+        {
+            Parameter< Operation::CLOSE_FILE > fClose;
+            IOHandler->enqueue(IOTask(this, fClose));
+            IOHandler->flush();
+
+            if( s->m_drain )
+                for( auto const& i : s->iterations )
+                    if( &i.second == this )
+                        s->drain(auxiliary::replace_first(s->iterationFormat(), "%T", std::to_string(i.first)));
+        }
+        m_closed = true;
+    }
+
+    meshes.written = false;
+    meshes.clear_unchecked();
+    particles.written = false;
+    particles.clear_unchecked();
+
+    return *this;
+}
+
+Iteration&
+Iteration::flush()
+{
+    if( m_closed )
+        throw std::runtime_error("A closed iteration can not be flushed.");
+
+    if( IOHandler->accessType == AccessType::READ_ONLY )
+    {
+        /* deferred reads (e.g. RecordComponent::loadChunk into a std::shared_ptr) */
+        IOHandler->flush();
+        return *this;
+    }
+
+    Writable *w = this;
+    while( w->parent )
+        w = w->parent;
+    Series* s = dynamic_cast<Series *>(w);
+
+    auto it = s->iterations.m_container.begin();
+    while( &it->second != this )
+        ++it;
+
+    /* also waits for a previous asynchronous flush to complete */
+    s->awaitStaged();
+    IOHandler->flush();
+    s->flushEncoding(it, std::next(it));
+    IOHandler->flush();
+    return *this;
+}
+
+bool
+Iteration::parsed() const
+{
+    return m_parsed;
+}
+
+bool
+Iteration::closed() const
+{
+    return m_closed;
+}
+
 void
 Iteration::flushFileBased(uint64_t i)
 {
@@ -91,18 +254,15 @@ Iteration::flushFileBased(uint64_t i)
         Parameter< Operation::CREATE_FILE > fCreate;
         fCreate.name = auxiliary::replace_first(s->iterationFormat(), "%T", std::to_string(i));
         IOHandler->enqueue(IOTask(s, fCreate));
-        IOHandler->flush();
 
         /* create basePath */
         Parameter< Operation::CREATE_PATH > pCreate;
         pCreate.path = auxiliary::replace_first(s->basePath(), "%T/", "");
         IOHandler->enqueue(IOTask(&s->iterations, pCreate));
-        IOHandler->flush();
 
         /* create iteration path */
         pCreate.path = std::to_string(i);
         IOHandler->enqueue(IOTask(this, pCreate));
-        IOHandler->flush();
     } else
     {
         /* open file */
@@ -110,21 +270,18 @@ Iteration::flushFileBased(uint64_t i)
         Parameter< Operation::OPEN_FILE > fOpen;
         fOpen.name = auxiliary::replace_last(s->iterationFormat(), "%T", std::to_string(i));
         IOHandler->enqueue(IOTask(s, fOpen));
-        IOHandler->flush();
 
         /* open basePath */
         Parameter< Operation::OPEN_PATH > pOpen;
         pOpen.path = auxiliary::replace_first(s->basePath(), "%T/", "");
         IOHandler->enqueue(IOTask(&s->iterations, pOpen));
-        IOHandler->flush();
 
         /* open iteration path */
         pOpen.path = std::to_string(i);
         IOHandler->enqueue(IOTask(this, pOpen));
-        IOHandler->flush();
     }
 
-    flush();
+    flushContents();
 }
 
 void
@@ -136,14 +293,13 @@ Iteration::flushGroupBased(uint64_t i)
         Parameter< Operation::CREATE_PATH > pCreate;
         pCreate.path = std::to_string(i);
         IOHandler->enqueue(IOTask(this, pCreate));
-        IOHandler->flush();
     }
 
-    flush();
+    flushContents();
 }
 
 void
-Iteration::flush()
+Iteration::flushContents()
 {
     /* Find the root point [Series] of this file,
      * meshesPath and particlesPath are stored there */
@@ -159,7 +315,8 @@ Iteration::flush()
             s->setMeshesPath("meshes/");
         s->flushMeshesPath();
         meshes.flush(s->meshesPath());
-        for( auto& m : meshes )
+        /* meshes that have not been opened since reading are not opened for flushing */
+        for( auto& m : meshes.m_container )
             m.second.flush(m.first);
     }
 
@@ -174,7 +331,56 @@ Iteration::flush()
             species.second.flush(species.first);
     }
 
+    if( s->m_checkpoint )
+    {
+        std::vector< std::string > layout = checkpointLayout();
+        if( !layout.empty()
+            && (!containsAttribute("checkpointLayout")
+                || getAttribute("checkpointLayout").get< std::vector< std::string > >() != layout) )
+            setAttribute("checkpointLayout", std::move(layout));
+    }
+
     flushAttributes();
+    dirtyRecursive = false;
+}
+
+void
+Iteration::trimAppended()
+{
+    for( auto& m : meshes )
+        for( auto& c : m.second )
+        {
+            RecordComponent& rc = c.second;
+            rc.trimAppended();
+        }
+    for( auto& species : particles )
+        for( auto& r : species.second )
+            for( auto& c : r.second )
+                c.second.trimAppended();
+}
+
+std::vector< std::string >
+Iteration::checkpointLayout() const
+{
+    Writable const *w = this;
+    while( w->parent )
+        w = w->parent;
+    Series const* s = dynamic_cast<Series const *>(w);
+
+    std::vector< std::string > layout;
+    auto add = [&layout](RecordComponent const& rc, std::string path)
+    {
+        layout.push_back((rc.constant() ? "constant:" : "dataset:") + path);
+    };
+    for( auto const& m : meshes )
+        for( auto const& c : m.second )
+            add(c.second, s->meshesPath() + m.first + (c.first == RecordComponent::SCALAR ? "" : "/" + c.first));
+    for( auto const& species : particles )
+        for( auto const& r : species.second )
+            for( auto const& c : r.second )
+                add(c.second, s->particlesPath() + species.first + "/" + r.first
+                              + (c.first == RecordComponent::SCALAR ? "" : "/" + c.first));
+    return layout;
 }
 
 void
@@ -183,6 +389,23 @@ Iteration::read()
     /* allow all attributes to be set */
     written = false;
 
+    /* Find the root point [Series] of this file,
+     * meshesPath and particlesPath are stored there */
+    Writable *w = this;
+    while( w->parent )
+        w = w->parent;
+    Series* s = dynamic_cast<Series *>(w);
+
+    if( s->m_checkpoint )
+    {
+        readAttributes();
+        if( containsAttribute("checkpointLayout") )
+        {
+            readCheckpoint(getAttribute("checkpointLayout").get< std::vector< std::string > >());
+            return;
+        }
+    }
+
     using DT = Datatype;
     Parameter< Operation::READ_ATT > aRead;
 
@@ -214,13 +437,6 @@ Iteration::read()
     else
         throw std::runtime_error("Unexpected Attribute datatype for 'timeUnitSI'");
 
-    /* Find the root point [Series] of this file,
-     * meshesPath and particlesPath are stored there */
-    Writable *w = this;
-    while( w->parent )
-        w = w->parent;
-    Series* s = dynamic_cast<Series *>(w);
-
     Parameter< Operation::LIST_PATHS > pList;
     std::string version = s->openPMD();
     bool hasMeshes = false;
@@ -246,6 +462,9 @@ Iteration::read()
         hasMeshes = s->containsAttribute("meshesPath");
         hasParticles = s->containsAttribute("particlesPath");
     }
+    /* groups excluded by the filter of the Series are not even opened */
+    hasMeshes = hasMeshes && !s->m_filter.skipMeshes;
+    hasParticles = hasParticles && !s->m_filter.skipParticles;
 
     if( hasMeshes )
     {
@@ -257,54 +476,20 @@ Iteration::read()
 
         meshes.readAttributes();
 
-        /* obtain all non-scalar meshes */
+        /* obtain all non-scalar meshes, they are opened on first access */
         IOHandler->enqueue(IOTask(&meshes, pList));
         IOHandler->flush();
-
-        Parameter< Operation::LIST_ATTS > aList;
         for( auto const& mesh_name : *pList.paths )
-        {
-            Mesh& m = meshes[mesh_name];
-            pOpen.path = mesh_name;
-            aList.attributes->clear();
-            IOHandler->enqueue(IOTask(&m, pOpen));
-            IOHandler->enqueue(IOTask(&m, aList));
-            IOHandler->flush();
-
-            auto begin = aList.attributes->begin();
-            auto end = aList.attributes->end();
-            auto value = std::find(begin, end, "value");
-            auto shape = std::find(begin, end, "shape");
-            if( value != end && shape != end )
-            {
-                MeshRecordComponent& mrc = m[MeshRecordComponent::SCALAR];
-                mrc.m_isConstant = true;
-                mrc.parent = m.parent;
-                mrc.abstractFilePosition = m.abstractFilePosition;
-            }
-            m.read();
-        }
+            if( s->m_filter.includesMesh(mesh_name) )
+                meshes[mesh_name].defer(mesh_name, false);
 
         /* obtain all scalar meshes */
         Parameter< Operation::LIST_DATASETS > dList;
         IOHandler->enqueue(IOTask(&meshes, dList));
         IOHandler->flush();
-
-        Parameter< Operation::OPEN_DATASET > dOpen;
         for( auto const& mesh_name : *dList.datasets )
-        {
-            Mesh& m = meshes[mesh_name];
-            dOpen.name = mesh_name;
-            IOHandler->enqueue(IOTask(&m, dOpen));
-            IOHandler->flush();
-            MeshRecordComponent& mrc = m[MeshRecordComponent::SCALAR];
-            mrc.abstractFilePosition = m.abstractFilePosition;
-            mrc.parent = m.parent;
-            mrc.written = false;
-            mrc.resetDataset(Dataset(*dOpen.dtype, *dOpen.extent));
-            mrc.written = true;
-            m.read();
-        }
+            if( s->m_filter.includesMesh(mesh_name) )
+                meshes[mesh_name].defer(mesh_name, true);
     }
 
     if( hasParticles )
@@ -324,22 +509,217 @@ Iteration::read()
 
         for( auto const& species_name : *pList.paths )
         {
+            if( !s->m_filter.includesSpecies(species_name) )
+                continue;
             ParticleSpecies& p = particles[species_name];
             pOpen.path = species_name;
             IOHandler->enqueue(IOTask(&p, pOpen));
             IOHandler->flush();
-            p.read();
+            p.read(s->m_filter);
         }
     }
 
     readAttributes();
 
+    /* a restarted checkpoint is written with the layout of all its records */
+    if( s->m_checkpoint )
+    {
+        for( auto& m : meshes )
+            m.second.open();
+        for( auto& species : particles )
+            for( auto& r : species.second )
+                r.second.open();
+    }
+
+    /* this file need not be flushed */
+    meshes.written = true;
+    particles.written = true;
+    written = true;
+}
+
+void
+Iteration::readCheckpoint(std::vector< std::string > const& layout)
+{
+    Writable *w = this;
+    while( w->parent )
+        w = w->parent;
+    Series* s = dynamic_cast<Series *>(w);
+
+    std::string const meshesPath = s->containsAttribute("meshesPath") ? s->meshesPath() : std::string();
+    std::string const particlesPath = s->containsAttribute("particlesPath") ? s->particlesPath() : std::string();
+
+    meshes.clear_unchecked();
+    particles.clear_unchecked();
+
+    /* every group is opened once, before the objects inside of it */
+    std::set< Writable* > opened;
+    Parameter< Operation::OPEN_PATH > pOpen;
+    auto openPath = [&](Writable* writable, std::string const& path)
+    {
+        if( !opened.insert(writable).second )
+            return;
+        pOpen.path = path;
+        IOHandler->enqueue(IOTask(writable, pOpen));
+    };
+
+    struct Component
+    {
+        Writable* record;   /* scalar components are opened on their record */
+        RecordComponent* rc;
+        bool scalar;
+        bool constant;
+        Parameter< Operation::OPEN_DATASET > dOpen;
+    };
+    std::vector< Component > components;
+    components.reserve(layout.size());
+    std::vector< Writable* > records;
+
+    for( auto const& entry : layout )
+    {
+        bool constant;
+        std::string path;
+        if( auxiliary::starts_with(entry, "dataset:") )
+        {
+            constant = false;
+            path = entry.substr(std::string("dataset:").size());
+        } else if( auxiliary::starts_with(entry, "constant:") )
+        {
+            constant = true;
+            path = entry.substr(std::string("constant:").size());
+        } else
+            throw std::runtime_error("Unexpected entry in checkpointLayout: " + entry);
+
+        Component c;
+        std::string recordName;
+        std::string componentName;
+        if( !meshesPath.empty() && auxiliary::starts_with(path, meshesPath) )
+        {
+            auto names = auxiliary::split(path.substr(meshesPath.size()), "/");
+            if( names.empty() || names.size() > 2 )
+                throw std::runtime_error("Unexpected mesh in checkpointLayout: " + entry);
+            openPath(&meshes, meshesPath);
+            Mesh& m = meshes[names[0]];
+            c.scalar = names.size() == 1;
+            c.rc = &m[c.scalar ? MeshRecordComponent::SCALAR : names[1]];
+            c.record = &m;
+            recordName = names[0];
+            componentName = names.back();
+        } else if( !particlesPath.empty() && auxiliary::starts_with(path, particlesPath) )
+        {
+            auto names = auxiliary::split(path.substr(particlesPath.size()), "/");
+            if( names.size() < 2 || names.size() > 3 )
+                throw std::runtime_error("Unexpected particle record in checkpointLayout: " + entry);
+            openPath(&particles, particlesPath);
+            ParticleSpecies& species = particles[names[0]];
+            openPath(&species, names[0]);
+            Record& r = species[names[1]];
+            c.scalar = names.size() == 2;
+            c.rc = &r[c.scalar ? RecordComponent::SCALAR : names[2]];
+            c.record = &r;
+            recordName = names[1];
+            componentName = names.back();
+        } else
+            throw std::runtime_error("Unexpected path in checkpointLayout: " + entry);
+        c.constant = constant;
+
+        if( c.scalar )
+        {
+            /* the record is the group holding the constant or the dataset itself */
+            if( constant )
+                openPath(c.record, recordName);
+            else
+            {
+                c.dOpen.name = recordName;
+                IOHandler->enqueue(IOTask(c.record, c.dOpen));
+            }
+        } else
+        {
+            openPath(c.record, recordName);
+            if( constant )
+                openPath(c.rc, componentName);
+            else
+            {
+                c.dOpen.name = componentName;
+                IOHandler->enqueue(IOTask(c.rc, c.dOpen));
+            }
+        }
+        if( std::find(records.begin(), records.end(), c.record) == records.end() )
+            records.push_back(c.record);
+        components.push_back(std::move(c));
+    }
+    IOHandler->flush();
+
+    for( auto& c : components )
+    {
+        RecordComponent& rc = *c.rc;
+        if( c.scalar )
+        {
+            rc.parent = c.record->parent;
+            rc.abstractFilePosition = c.record->abstractFilePosition;
+        }
+        if( c.constant )
+        {
+            /* the value and shape are attributes of the component */
+            rc.m_isConstant = true;
+            rc.read();
+        } else
+        {
+            rc.written = false;
+            rc.resetDataset(Dataset(*c.dOpen.dtype, *c.dOpen.extent));
+            if( !c.dOpen.chunkSize->empty() )
+                rc.m_dataset.chunkSize = *c.dOpen.chunkSize;
+            rc.written = true;
+        }
+    }
+
     /* this file need not be flushed */
+    for( auto record : records )
+        record->written = true;
+    for( auto& species : particles )
+        species.second.written = true;
     meshes.written = true;
     particles.written = true;
     written = true;
 }
 
+std::string
+Iteration::childName(Writable const* child) const
+{
+    if( child == &meshes )
+        return "meshes";
+    if( child == &particles )
+        return "particles";
+    return std::string();
+}
+
+
+IterationContainer::mapped_type&
+IterationContainer::at(key_type const& key)
+{
+    return m_container.at(key).open();
+}
+
+IterationContainer::mapped_type const&
+IterationContainer::at(key_type const& key) const
+{
+    return m_container.at(key);
+}
+
+IterationContainer::mapped_type&
+IterationContainer::operator[](key_type const& key)
+{
+    mapped_type& ret = BaseContainer::operator[](key);
+    ret.m_index = key;
+    return ret.open();
+}
+
+IterationContainer::mapped_type&
+IterationContainer::operator[](key_type&& key)
+{
+    mapped_type& ret = BaseContainer::operator[](key);
+    ret.m_index = key;
+    return ret.open();
+}
 
 template
 float Iteration::time< float >() const;
@@ -182,21 +182,37 @@ Mesh::setTimeOffset(T to)
 void
 Mesh::flush(std::string const& name)
 {
-    if( !written )
+    /* records that have not been opened since reading are unmodified */
+    if( m_deferred )
+        return;
+
+    /* a scalar component redefined in overwrite mode is created again under the name of the record */
+    bool const redefined = written && m_containsScalar && !at(RecordComponent::SCALAR).written;
+    if( redefined )
+    {
+        /* read along with a constant, written from the new definition of the component */
+        deleteAttribute("value");
+        deleteAttribute("shape");
+    }
+    if( !written || redefined )
     {
         if( m_containsScalar )
         {
             MeshRecordComponent& r = at(RecordComponent::SCALAR);
             r.parent = parent;
             r.flush(name);
+            /* sync point: the position of the scalar component is shared */
+            IOHandler->flush();
             abstractFilePosition = r.abstractFilePosition;
             written = true;
+            /* the attributes are lost if the dataset has been replaced */
+            if( redefined )
+                enqueueAttributes(true);
         } else
         {
             Parameter< Operation::CREATE_PATH > pCreate;
             pCreate.path = name;
             IOHandler->enqueue(IOTask(this, pCreate));
-            IOHandler->flush();
             for( auto& comp : *this )
                 comp.second.parent = this;
         }
@@ -331,6 +347,8 @@ Mesh::read()
             IOHandler->flush();
             rc.written = false;
             rc.resetDataset(Dataset(*dOpen.dtype, *dOpen.extent));
+            if( !dOpen.chunkSize->empty() )
+                rc.m_dataset.chunkSize = *dOpen.chunkSize;
             rc.written = true;
             rc.read();
         }
@@ -1,4 +1,5 @@
 #include "openPMD/ParticlePatches.hpp"
+#include "openPMD/auxiliary/Memory.hpp"
 
 
 namespace openPMD
@@ -21,6 +22,79 @@ ParticlePatches::operator[](ParticlePatches::key_type&& key)
     return Container< PatchRecord >::operator[](key);
 }
 
+size_t
+ParticlePatches::numPatches() const
+{
+    return m_patchPositions.size();
+}
+
+PatchPosition const&
+ParticlePatches::position(size_t patch) const
+{
+    return m_patchPositions.at(patch);
+}
+
+std::vector< size_t >
+ParticlePatches::select(std::map< std::string, std::pair< double, double > > const& region) const
+{
+    std::vector< bool > overlaps(numPatches(), true);
+    if( !region.empty() )
+    {
+        auto offset = find("offset");
+        auto extent = find("extent");
+        if( offset == end() || extent == end() )
+            throw std::runtime_error("Spatial patch selection requires the patch records offset and extent.");
+
+        for( auto const& interval : region )
+        {
+            auto o = offset->second.find(interval.first);
+            auto e = extent->second.find(interval.first);
+            if( o == offset->second.end() || e == extent->second.end() )
+                throw std::runtime_error("No patch offset and extent for component " + interval.first);
+            if( o->second.m_values.size() != numPatches() || e->second.m_values.size() != numPatches() )
+                throw std::runtime_error("Number of patch offsets and extents differs from number of patches for component " + interval.first);
+
+            for( size_t i = 0; i < numPatches(); ++i )
+            {
+                double lower = o->second.m_values[i];
+                double upper = lower + e->second.m_values[i];
+                if( lower >= interval.second.second || upper <= interval.second.first )
+                    overlaps[i] = false;
+            }
+        }
+    }
+
+    std::vector< size_t > ret;
+    for( size_t i = 0; i < overlaps.size(); ++i )
+        if( overlaps[i] )
+            ret.push_back(i);
+    return ret;
+}
+
+ParticlePatches&
+ParticlePatches::storePatch(uint64_t patch,
+                            uint64_t numPatches,
+                            PatchPosition const& position,
+                            std::map< std::string, std::pair< double, double > > const& bounds)
+{
+    if( patch >= numPatches )
+        throw std::runtime_error("Patch index exceeds the number of patches.");
+
+    Container< PatchRecord >::operator[]("numParticles")[RecordComponent::SCALAR].store(patch, numPatches, position.numParticles);
+    Container< PatchRecord >::operator[]("numParticlesOffset")[RecordComponent::SCALAR].store(patch, numPatches, position.numParticlesOffset);
+    if( !bounds.empty() )
+    {
+        (*this)["offset"].setUnitDimension({{UnitDimension::L, 1}});
+        (*this)["extent"].setUnitDimension({{UnitDimension::L, 1}});
+    }
+    for( auto const& interval : bounds )
+    {
+        (*this)["offset"][interval.first].store(patch, numPatches, interval.second.first);
+        (*this)["extent"][interval.first].store(patch, numPatches, interval.second.second - interval.second.first);
+    }
+    return *this;
+}
+
 void
 ParticlePatches::read()
 {
@@ -66,7 +140,7 @@ ParticlePatches::read()
         dRead.offset = {0};
 
         size_t numPoints = dRead.extent[0];
-        std::unique_ptr< uint64_t > data(new uint64_t[numPoints]);
+        auto data = auxiliary::allocatePtr(dRead.dtype, numPoints, IOHandler->bufferPool.get());
         dRead.data = data.get();
         IOHandler->enqueue(IOTask(&pr, dRead));
         IOHandler->flush();
@@ -1,83 +1,90 @@
 #include "openPMD/auxiliary/StringManip.hpp"
 #include "openPMD/ParticleSpecies.hpp"
 
+#include <algorithm>
+#include <thread>
+
 
 namespace openPMD
 {
 ParticleSpecies::ParticleSpecies() = default;
 
+#if openPMD_HAVE_MPI
+uint64_t
+ParticleSpecies::storeLocalPatch(MPI_Comm comm,
+                                 uint64_t numParticles,
+                                 std::map< std::string, std::pair< double, double > > const& bounds)
+{
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    uint64_t numParticlesOffset = 0;
+    MPI_Exscan(&numParticles, &numParticlesOffset, 1, MPI_UINT64_T, MPI_SUM, comm);
+    /* the result of MPI_Exscan is undefined on the first rank */
+    if( rank == 0 )
+        numParticlesOffset = 0;
+
+    particlePatches.storePatch(static_cast< uint64_t >(rank),
+                               static_cast< uint64_t >(size),
+                               PatchPosition(numParticles, numParticlesOffset),
+                               bounds);
+    return numParticlesOffset;
+}
+#endif
+
 void
-ParticleSpecies::read()
+ParticleSpecies::read(ReadFilter const& filter)
 {
     /* allow all attributes to be set */
     written = false;
 
     clear_unchecked();
 
-    /* obtain all non-scalar records */
+    readRecords(*this, filter);
+    readAttributes();
+
+    /* this file need not be flushed */
+    written = true;
+}
+
+void
+ParticleSpecies::readRecords(Container< Record >& records, ReadFilter const& filter)
+{
+    /* obtain all non-scalar records, records are opened on first access */
     Parameter< Operation::LIST_PATHS > pList;
-    IOHandler->enqueue(IOTask(this, pList));
+    IOHandler->enqueue(IOTask(&records, pList));
     IOHandler->flush();
 
     Parameter< Operation::OPEN_PATH > pOpen;
-    Parameter< Operation::LIST_ATTS > aList;
     for( auto const& record_name : *pList.paths )
     {
-        if( record_name == "particlePatches" )
+        if( &records == this && record_name == "particlePatches" )
         {
             pOpen.path = "particlePatches";
             IOHandler->enqueue(IOTask(&particlePatches, pOpen));
             IOHandler->flush();
             particlePatches.read();
-        } else
+        } else if( &records == this && record_name == "blockIndex" )
         {
-            Record& r = (*this)[record_name];
-            pOpen.path = record_name;
-            aList.attributes->clear();
-            IOHandler->enqueue(IOTask(&r, pOpen));
-            IOHandler->enqueue(IOTask(&r, aList));
+            pOpen.path = "blockIndex";
+            IOHandler->enqueue(IOTask(&blockIndex, pOpen));
             IOHandler->flush();
-
-            auto begin = aList.attributes->begin();
-            auto end = aList.attributes->end();
-            auto value = std::find(begin, end, "value");
-            auto shape = std::find(begin, end, "shape");
-            if( value != end && shape != end )
-            {
-                RecordComponent& rc = r[RecordComponent::SCALAR];
-                rc.m_isConstant = true;
-                rc.parent = r.parent;
-                rc.abstractFilePosition = r.abstractFilePosition;
-            }
-            r.read();
-        }
+            blockIndex.written = false;
+            blockIndex.clear_unchecked();
+            readRecords(blockIndex, filter);
+            blockIndex.written = true;
+        } else if( filter.includesRecord(record_name) )
+            records[record_name].defer(record_name, false);
     }
 
     /* obtain all scalar records */
     Parameter< Operation::LIST_DATASETS > dList;
-    IOHandler->enqueue(IOTask(this, dList));
+    IOHandler->enqueue(IOTask(&records, dList));
     IOHandler->flush();
-
-    Parameter< Operation::OPEN_DATASET > dOpen;
     for( auto const& record_name : *dList.datasets )
-    {
-        Record& r = (*this)[record_name];
-        dOpen.name = record_name;
-        IOHandler->enqueue(IOTask(&r, dOpen));
-        IOHandler->flush();
-        RecordComponent& rc = r[RecordComponent::SCALAR];
-        rc.abstractFilePosition = r.abstractFilePosition;
-        rc.parent = r.parent;
-        rc.written = false;
-        rc.resetDataset(Dataset(*dOpen.dtype, *dOpen.extent));
-        rc.written = true;
-        r.read();
-    }
-
-    readAttributes();
-
-    /* this file need not be flushed */
-    written = true;
+        if( filter.includesRecord(record_name) )
+            records[record_name].defer(record_name, true);
 }
 
 void
@@ -85,12 +92,215 @@ ParticleSpecies::flush(std::string const& path)
 {
     Container< Record >::flush(path);
 
-    for( auto& record : *this )
+    /* records that have not been opened since reading are not opened for flushing */
+    for( auto& record : m_container )
         record.second.flush(record.first);
 
     particlePatches.flush("particlePatches");
     for( auto& patch : particlePatches )
         patch.second.flush(patch.first);
+
+    /* the ranges have been reduced while flushing the records above */
+    for( auto& record : m_container )
+        for( auto& component : record.second )
+            if( component.second.m_statistics.blockSize != 0 )
+                component.second.storeBlockIndex(blockIndex[record.first][component.first]);
+    if( !blockIndex.empty() )
+    {
+        blockIndex.flush("blockIndex");
+        for( auto& record : blockIndex.m_container )
+            record.second.flush(record.first);
+    }
+}
+
+std::string
+ParticleSpecies::childName(Writable const* child) const
+{
+    if( child == &particlePatches )
+        return "particlePatches";
+    if( child == &blockIndex )
+        return "blockIndex";
+    return Container< Record >::childName(child);
+}
+
+namespace
+{
+/* "record/component" or "record" for scalar records */
+std::pair< std::string, std::string >
+splitComponent(std::string const& component)
+{
+    auto slash = component.find('/');
+    if( slash == std::string::npos )
+        return {component, RecordComponent::SCALAR};
+    return {component.substr(0, slash), component.substr(slash + 1)};
+}
+} // namespace
+
+RecordComponent&
+ParticleSpecies::component(std::string const& component)
+{
+    auto name = splitComponent(component);
+    auto r = find(name.first);
+    if( r == end() || r->second.count(name.second) == 0 )
+        throw std::runtime_error("No record component " + component + " in particle species");
+    return r->second.at(name.second);
+}
+
+std::vector< std::pair< Offset, Extent > >
+ParticleSpecies::selectBlocks(std::string const& component, std::pair< double, double > const& range)
+{
+    auto name = splitComponent(component);
+    auto r = blockIndex.find(name.first);
+    if( r == blockIndex.end() || r->second.count(name.second) == 0 )
+        throw std::runtime_error("No block index for record component " + component);
+
+    RecordComponent& index = r->second.at(name.second);
+    uint64_t blockSize = index.getAttribute("blockSize").get< uint64_t >();
+    uint64_t numBlocks = index.getExtent()[0];
+    uint64_t numElements = this->component(component).getExtent()[0];
+    std::shared_ptr< double > ranges = index.loadChunk< double >({0, 0}, {numBlocks, 2});
+    IOHandler->flush();
+
+    std::vector< std::pair< Offset, Extent > > ret;
+    for( uint64_t b = 0; b < numBlocks && b * blockSize < numElements; ++b )
+    {
+        if( ranges.get()[2 * b + 1] < range.first || ranges.get()[2 * b] >= range.second )
+            continue;
+        uint64_t first = b * blockSize;
+        uint64_t last = std::min(numElements, first + blockSize);
+        if( !ret.empty() && ret.back().first[0] + ret.back().second[0] == first )
+            ret.back().second[0] += last - first;
+        else
+            ret.push_back({{first}, {last - first}});
+    }
+    return ret;
+}
+
+namespace
+{
+using Runs = std::vector< std::pair< Offset, Extent > >;
+
+/* both lists hold disjoint runs in ascending order */
+Runs
+intersect(Runs const& a, Runs const& b)
+{
+    Runs ret;
+    size_t i = 0, j = 0;
+    while( i < a.size() && j < b.size() )
+    {
+        uint64_t aEnd = a[i].first[0] + a[i].second[0];
+        uint64_t bEnd = b[j].first[0] + b[j].second[0];
+        uint64_t first = std::max(a[i].first[0], b[j].first[0]);
+        uint64_t last = std::min(aEnd, bEnd);
+        if( first < last )
+            ret.push_back({{first}, {last - first}});
+        if( aEnd < bEnd )
+            ++i;
+        else
+            ++j;
+    }
+    return ret;
+}
+} // namespace
+
+std::vector< uint64_t >
+ParticleSpecies::selectParticles(std::map< std::string, std::pair< double, double > > const& ranges,
+                                 unsigned int workers,
+                                 uint64_t batchSize)
+{
+    if( ranges.empty() )
+        throw std::runtime_error("Particle selection requires at least one record component.");
+    if( batchSize == 0 )
+        throw std::runtime_error("Particle selection requires a non-zero batch size.");
+
+    std::vector< RecordComponent* > components;
+    std::vector< std::pair< double, double > > intervals;
+    uint64_t numParticles = 0;
+    for( auto const& range : ranges )
+    {
+        RecordComponent& rc = component(range.first);
+        if( rc.getDimensionality() != 1 )
+            throw std::runtime_error("Particle selection requires one-dimensional record components: " + range.first);
+        if( components.empty() )
+            numParticles = rc.getExtent()[0];
+        else if( rc.getExtent()[0] != numParticles )
+            throw std::runtime_error("Particle selection requires record components of equal extent: " + range.first);
+        components.push_back(&rc);
+        intervals.push_back(range.second);
+    }
+
+    /* candidates that the block indices do not rule out */
+    Runs candidates;
+    if( numParticles > 0 )
+        candidates.push_back({{0}, {numParticles}});
+    for( auto const& range : ranges )
+    {
+        auto name = splitComponent(range.first);
+        if( blockIndex.count(name.first) != 0 && blockIndex.at(name.first).count(name.second) != 0 )
+            candidates = intersect(candidates, selectBlocks(range.first, range.second));
+    }
+
+    if( workers == 0 )
+        workers = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector< uint64_t > ret;
+    size_t run = 0;
+    uint64_t consumed = 0;   /* particles of candidates[run] in previous batches */
+    while( run < candidates.size() )
+    {
+        /* split the candidates into batches of at most batchSize particles */
+        Runs batch;
+        uint64_t batchParticles = 0;
+        while( run < candidates.size() && batchParticles < batchSize )
+        {
+            uint64_t offset = candidates[run].first[0] + consumed;
+            uint64_t n = std::min(candidates[run].second[0] - consumed, batchSize - batchParticles);
+            batch.push_back({{offset}, {n}});
+            batchParticles += n;
+            consumed += n;
+            if( consumed == candidates[run].second[0] )
+            {
+                ++run;
+                consumed = 0;
+            }
+        }
+
+        std::vector< std::shared_ptr< double > > values;
+        for( RecordComponent* rc : components )
+            values.push_back(rc->loadChunks< double >(batch));
+        IOHandler->flush();
+
+        /* comparisons without branches are vectorized, threads only pay off for large batches */
+        std::vector< unsigned char > mask(batchParticles, 1u);
+        auto evaluate = [&](uint64_t begin, uint64_t end)
+        {
+            for( size_t c = 0; c < values.size(); ++c )
+            {
+                double const* v = values[c].get();
+                double const lower = intervals[c].first;
+                double const upper = intervals[c].second;
+                unsigned char* m = mask.data();
+                for( uint64_t i = begin; i < end; ++i )
+                    m[i] &= static_cast< unsigned char >((v[i] >= lower) & (v[i] < upper));
+            }
+        };
+        uint64_t const minPerThread = uint64_t(1) << 16;
+        unsigned int threads = static_cast< unsigned int >(std::min< uint64_t >(workers, std::max< uint64_t >(1u, batchParticles / minPerThread)));
+        std::vector< std::thread > pool;
+        uint64_t const slice = (batchParticles + threads - 1) / threads;
+        for( unsigned int t = 1; t < threads; ++t )
+            pool.emplace_back(evaluate, std::min(batchParticles, t * slice), std::min(batchParticles, (t + 1) * slice));
+        evaluate(0, std::min(batchParticles, slice));
+        for( auto& t : pool )
+            t.join();
+
+        uint64_t position = 0;
+        for( auto const& region : batch )
+            for( uint64_t i = 0; i < region.second[0]; ++i, ++position )
+                if( mask[position] )
+                    ret.push_back(region.first[0] + i);
+    }
+    return ret;
 }
 
 template<>
@@ -111,6 +321,8 @@ Container< ParticleSpecies >::operator[](Container< ParticleSpecies >::key_type
         ret["positionOffset"].setUnitDimension({{UnitDimension::L, 1}});
         ret.particlePatches.parent = &ret;
         ret.particlePatches.IOHandler = ret.IOHandler;
+        ret.blockIndex.parent = &ret;
+        ret.blockIndex.IOHandler = ret.IOHandler;
         return ret;
     }
 }
@@ -133,6 +345,8 @@ Container< ParticleSpecies >::operator[](Container< ParticleSpecies >::key_type
         ret["positionOffset"].setUnitDimension({{UnitDimension::L, 1}});
         ret.particlePatches.parent = &ret;
         ret.particlePatches.IOHandler = ret.IOHandler;
+        ret.blockIndex.parent = &ret;
+        ret.blockIndex.IOHandler = ret.IOHandler;
         return ret;
     }
 }
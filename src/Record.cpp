@@ -1,6 +1,8 @@
 #include "openPMD/Record.hpp"
 
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 
 namespace openPMD
@@ -26,24 +28,61 @@ Record::setUnitDimension(std::map< UnitDimension, double > const& udim)
     return *this;
 }
 
+void
+Record::verifyComponents(std::vector< RecordComponent* > const& components, Offset const& o, Extent const& e)
+{
+    if( components.empty() )
+        return;
+
+    Extent const& dse = components.front()->m_dataset.extent;
+    std::size_t const dim = dse.size();
+    if( e.size() != dim || o.size() != dim )
+        throw std::runtime_error("Dimensionality of chunk and dataset do not match.");
+    for( std::size_t i = 0; i < dim; ++i )
+        if( dse[i] < o[i] + e[i] )
+            throw std::runtime_error("Chunk does not reside inside dataset (Dimension on index " + std::to_string(i)
+                                     + " - DS: " + std::to_string(dse[i])
+                                     + " - Chunk: " + std::to_string(o[i] + e[i])
+                                     + ")");
+    for( auto rc : components )
+        if( rc->m_dataset.extent != dse )
+            throw std::runtime_error("Chunks of several components can only be stored or loaded together if the extents of the components match.");
+}
+
 void
 Record::flush(std::string const& name)
 {
-    if( !written )
+    /* records that have not been opened since reading are unmodified */
+    if( m_deferred )
+        return;
+
+    /* a scalar component redefined in overwrite mode is created again under the name of the record */
+    bool const redefined = written && m_containsScalar && !at(RecordComponent::SCALAR).written;
+    if( redefined )
+    {
+        /* read along with a constant, written from the new definition of the component */
+        deleteAttribute("value");
+        deleteAttribute("shape");
+    }
+    if( !written || redefined )
     {
         if( m_containsScalar )
         {
             RecordComponent& r = at(RecordComponent::SCALAR);
             r.parent = parent;
             r.flush(name);
+            /* sync point: the position of the scalar component is shared */
+            IOHandler->flush();
             abstractFilePosition = r.abstractFilePosition;
             written = true;
+            /* the attributes are lost if the dataset has been replaced */
+            if( redefined )
+                enqueueAttributes(true);
         } else
         {
             Parameter< Operation::CREATE_PATH > pCreate;
             pCreate.path = name;
             IOHandler->enqueue(IOTask(this, pCreate));
-            IOHandler->flush();
             for( auto& comp : *this )
                 comp.second.parent = this;
         }
@@ -96,6 +135,8 @@ Record::read()
             IOHandler->flush();
             rc.written = false;
             rc.resetDataset(Dataset(*dOpen.dtype, *dOpen.extent));
+            if( !dOpen.chunkSize->empty() )
+                rc.m_dataset.chunkSize = *dOpen.chunkSize;
             rc.written = true;
             rc.read();
         }
@@ -1,17 +1,42 @@
 #include "openPMD/RecordComponent.hpp"
+#include "openPMD/auxiliary/Checksum.hpp"
+#include "openPMD/Series.hpp"
 
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <vector>
 
 
 namespace openPMD
 {
 RecordComponent::RecordComponent()
-        : m_constantValue{-1}
+        : m_stagedBytes{0},
+          m_appendedSize{0},
+          m_appending{false},
+          m_extentDirty{false},
+          m_constantValue{-1}
 {
     setUnitSI(1);
     resetDataset(Dataset(Datatype::CHAR, {1}));
 }
 
+RecordComponent::~RecordComponent()
+{
+    if( m_stagedBytes == 0 || !IOHandler )
+        return;
+    /* chunks of a removed component are never written */
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    WriteStaging& staging = IOHandler->staging;
+    auto staged = staging.components.find(this);
+    if( staged == staging.components.end() )
+        return;
+    staging.bytes -= std::min(staging.bytes, staged->second.bytes);
+    staging.chunks -= std::min(staging.chunks, staged->second.chunks);
+    staging.components.erase(staged);
+}
+
 RecordComponent&
 RecordComponent::setUnitSI(double usi)
 {
@@ -23,10 +48,43 @@ RecordComponent&
 RecordComponent::resetDataset(Dataset d)
 {
     if( written )
-        throw std::runtime_error("A Records Dataset can not (yet) be changed after it has been written.");
+    {
+        redefine();
+        m_isConstant = false;
+    }
 
     m_dataset = d;
-    dirty = true;
+    setDirty();
+    return *this;
+}
+
+void
+RecordComponent::redefine()
+{
+    if( !IOHandler->overwrite )
+        throw std::runtime_error("A recordComponent can not be redefined after it has been written, unless the Series is in overwrite mode.");
+    if( !m_chunks.empty() )
+        throw std::runtime_error("A recordComponent can not be redefined while chunks are staged for it.");
+
+    /* the backend reuses the dataset (or group of a constant) in the file if possible */
+    written = false;
+    abstractFilePosition.reset();
+    /* read along with a constant, written from the new definition by flush() */
+    deleteAttribute("value");
+    deleteAttribute("shape");
+}
+
+RecordComponent&
+RecordComponent::setChunkCache(std::size_t bytes, std::size_t slots, double preemption)
+{
+    m_dataset.setChunkCache(bytes, slots, preemption);
+    return *this;
+}
+
+RecordComponent&
+RecordComponent::setTransfer(Transfer transfer)
+{
+    m_dataset.setTransfer(transfer);
     return *this;
 }
 
@@ -42,6 +100,42 @@ RecordComponent::getExtent()
     return m_dataset.extent;
 }
 
+Extent
+RecordComponent::getChunkSize()
+{
+    return m_dataset.chunkSize;
+}
+
+Extent
+RecordComponent::stridedExtent(Extent const& e, Extent const& stride, Extent const& block)
+{
+    if( stride.size() != e.size() || (!block.empty() && block.size() != e.size()) )
+        throw std::runtime_error("Dimensionality of chunk, stride and block do not match.");
+
+    Extent selected;
+    for( size_t i = 0; i < e.size(); ++i )
+    {
+        uint64_t const b = block.empty() ? 1u : block[i];
+        if( stride[i] == 0 || b == 0 || b > stride[i] || b > e[i] )
+            throw std::runtime_error("Stride and block must be non-zero and blocks must not exceed the stride or extent (Dimension on index "
+                                     + std::to_string(i) + ")");
+        selected.push_back(((e[i] - b) / stride[i] + 1) * b);
+    }
+    return selected;
+}
+
+namespace
+{
+/* target size of the chunks of datasets created with an extent of zero */
+constexpr size_t growingChunkBytes = size_t(64) << 10;
+} // namespace
+
+uint64_t
+RecordComponent::getAppendedSize() const
+{
+    return m_appendedSize;
+}
+
 void
 RecordComponent::flush(std::string const& name)
 {
@@ -56,36 +150,786 @@ RecordComponent::flush(std::string const& name)
             aWrite.name = "value";
             aWrite.dtype = m_constantValue.dtype;
             aWrite.resource = m_constantValue.getResource();
-            IOHandler->enqueue(IOTask(this, aWrite));
+            IOHandler->enqueue(IOTask(this, std::move(aWrite)));
             aWrite.name = "shape";
             Attribute a(getExtent());
             aWrite.dtype = a.dtype;
-            aWrite.resource = a.getResource();
-            IOHandler->enqueue(IOTask(this, aWrite));
+            aWrite.resource = std::move(a).getResource();
+            IOHandler->enqueue(IOTask(this, std::move(aWrite)));
         } else
         {
             Parameter< Operation::CREATE_DATASET > dCreate;
             dCreate.name = name;
             dCreate.extent = getExtent();
             dCreate.dtype = getDatatype();
+            /* empty datasets can only grow, chunks of size zero are not possible */
+            for( auto& c : m_dataset.chunkSize )
+                if( c == 0 )
+                    c = std::max< uint64_t >(1u, growingChunkBytes / toBytes(getDatatype()));
             dCreate.chunkSize = m_dataset.chunkSize;
             dCreate.compression = m_dataset.compression;
             dCreate.transform = m_dataset.transform;
+            dCreate.allocation = m_dataset.allocation;
+            dCreate.fixedSize = m_dataset.fixedSize;
             IOHandler->enqueue(IOTask(this, dCreate));
         }
-        IOHandler->flush();
+    } else if( m_extentDirty )
+    {
+        /* chunks staged since the last flush may reside in the new part of the dataset */
+        Parameter< Operation::EXTEND_DATASET > dExtend;
+        dExtend.name = name;
+        dExtend.extent = getExtent();
+        IOHandler->enqueue(IOTask(this, dExtend));
     }
+    m_extentDirty = false;
+
+    WriteStaging& staging = IOHandler->staging;
+    staging.bytes -= std::min(staging.bytes, m_stagedBytes);
+    staging.chunks -= std::min(staging.chunks, m_chunks.size());
+    staging.components.erase(this);
+    m_stagedBytes = 0;
 
+    coalesceChunks();
     while( !m_chunks.empty() )
     {
+        auto& dWrite = m_chunks.front().getParameter< Operation::WRITE_DATASET >();
+        dWrite.transfer = m_dataset.transfer;
+        if( m_statistics.enabled || m_statistics.blockSize != 0 || m_checksums.enabled )
+            reduceChunk(dWrite);
         IOHandler->enqueue(m_chunks.front());
         m_chunks.pop();
-        IOHandler->flush();
     }
+    if( m_statistics.enabled )
+        storeStatistics();
+    if( m_checksums.enabled )
+        storeChecksums();
 
     flushAttributes();
 }
 
+RecordComponent&
+RecordComponent::setStatistics(bool enabled)
+{
+    m_statistics.enabled = enabled;
+    return *this;
+}
+
+#if openPMD_HAVE_MPI
+RecordComponent&
+RecordComponent::setStatistics(MPI_Comm comm)
+{
+    m_statistics.enabled = true;
+    m_statistics.comm = comm;
+    return *this;
+}
+#endif
+
+RecordComponent&
+RecordComponent::setBlockIndex(uint64_t blockSize)
+{
+    m_statistics.blockSize = blockSize;
+    return *this;
+}
+
+#if openPMD_HAVE_MPI
+RecordComponent&
+RecordComponent::setBlockIndex(uint64_t blockSize, MPI_Comm comm)
+{
+    m_statistics.blockSize = blockSize;
+    m_statistics.comm = comm;
+    return *this;
+}
+#endif
+
+RecordComponent&
+RecordComponent::setChecksums(bool enabled)
+{
+    m_checksums.enabled = enabled;
+    return *this;
+}
+
+#if openPMD_HAVE_MPI
+RecordComponent&
+RecordComponent::setChecksums(MPI_Comm comm)
+{
+    m_checksums.enabled = true;
+    m_checksums.comm = comm;
+    return *this;
+}
+#endif
+
+namespace
+{
+/* NaNs fail every comparison, so they are only counted and the loop needs no branches to be vectorized */
+template< typename T >
+void
+reduceValues(void const* buffer, size_t numPoints, long double& min, long double& max, uint64_t& count, uint64_t& numNaN)
+{
+    T const* data = static_cast< T const* >(buffer);
+    T localMin = std::numeric_limits< T >::max();
+    T localMax = std::numeric_limits< T >::lowest();
+    uint64_t localNaN = 0;
+    for( size_t i = 0; i < numPoints; ++i )
+    {
+        T const v = data[i];
+        localNaN += (v != v);
+        localMin = v < localMin ? v : localMin;
+        localMax = v > localMax ? v : localMax;
+    }
+
+    if( numPoints > localNaN )
+    {
+        min = std::min(min, static_cast< long double >(localMin));
+        max = std::max(max, static_cast< long double >(localMax));
+    }
+    count += numPoints - localNaN;
+    numNaN += localNaN;
+}
+} // namespace
+
+namespace
+{
+void
+reduceValues(Datatype dtype, void const* data, size_t numPoints, long double& min, long double& max, uint64_t& count, uint64_t& numNaN)
+{
+    using DT = Datatype;
+    switch( dtype )
+    {
+        case DT::CHAR:
+            reduceValues< char >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::UCHAR:
+            reduceValues< unsigned char >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::INT16:
+            reduceValues< int16_t >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::INT32:
+            reduceValues< int32_t >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::INT64:
+            reduceValues< int64_t >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::UINT16:
+            reduceValues< uint16_t >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::UINT32:
+            reduceValues< uint32_t >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::UINT64:
+            reduceValues< uint64_t >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::FLOAT:
+            reduceValues< float >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::DOUBLE:
+            reduceValues< double >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::LONG_DOUBLE:
+            reduceValues< long double >(data, numPoints, min, max, count, numNaN);
+            break;
+        case DT::BOOL:
+            reduceValues< bool >(data, numPoints, min, max, count, numNaN);
+            break;
+        default:
+            throw std::runtime_error("Statistics can only be computed for numeric datatypes.");
+    }
+}
+
+/* true if the values of a chunk are stored one after another in its data */
+bool
+isDense(Parameter< Operation::WRITE_DATASET > const& chunk)
+{
+    return chunk.memoryStride == 1 && chunk.memoryExtent.empty();
+}
+
+/* copy the numPoints values of a chunk densely into dest, e.g. from a member of an array of structs or a part of a larger buffer */
+void
+copyDense(void* dest, Parameter< Operation::WRITE_DATASET > const& chunk, size_t numPoints)
+{
+    size_t const bytes = toBytes(chunk.dtype);
+    if( !chunk.memoryExtent.empty() )
+        auxiliary::pack(dest, chunk.data.get(), bytes, chunk.extent, chunk.memoryOffset, chunk.memoryExtent);
+    else if( chunk.memoryStride != 1 )
+        auxiliary::gather(dest, chunk.data.get(), numPoints, bytes, chunk.memoryStride);
+    else
+        std::memcpy(dest, chunk.data.get(), numPoints * bytes);
+}
+} // namespace
+
+void
+RecordComponent::reduceChunk(Parameter< Operation::WRITE_DATASET > const& chunk)
+{
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : chunk.extent )
+        numPoints *= dimensionSize;
+
+    /* members of an array of structs or parts of larger buffers are reduced from a dense copy */
+    void const* values = chunk.data.get();
+    std::unique_ptr< void, std::function< void(void*) > > dense;
+    if( !isDense(chunk) )
+    {
+        dense = auxiliary::allocatePtr(chunk.dtype, numPoints, IOHandler->bufferPool.get());
+        copyDense(dense.get(), chunk, numPoints);
+        values = dense.get();
+    }
+
+    if( m_checksums.enabled )
+    {
+        /* while the chunk is still in cache from being staged */
+        Checksums& c = m_checksums;
+        c.pendingOffsets.insert(c.pendingOffsets.end(), chunk.offset.begin(), chunk.offset.end());
+        c.pendingExtents.insert(c.pendingExtents.end(), chunk.extent.begin(), chunk.extent.end());
+        c.pendingValues.push_back(auxiliary::crc32cParallel(values, numPoints * toBytes(chunk.dtype)));
+    }
+
+    Statistics& s = m_statistics;
+    if( s.enabled )
+        reduceValues(chunk.dtype, values, numPoints, s.min, s.max, s.count, s.numNaN);
+    if( s.blockSize == 0 || numPoints == 0 )
+        return;
+
+    if( chunk.offset.size() != 1 )
+        throw std::runtime_error("Block indices can only be kept for one-dimensional datasets.");
+    uint64_t const begin = chunk.offset[0];
+    uint64_t const end = begin + chunk.extent[0];
+    uint64_t const numBlocks = (end + s.blockSize - 1) / s.blockSize;
+    if( s.blockMin.size() < numBlocks )
+    {
+        s.blockMin.resize(numBlocks, std::numeric_limits< double >::max());
+        s.blockMax.resize(numBlocks, std::numeric_limits< double >::lowest());
+    }
+
+    char const* data = static_cast< char const* >(values);
+    size_t const bytes = toBytes(chunk.dtype);
+    for( uint64_t b = begin / s.blockSize; b < numBlocks; ++b )
+    {
+        uint64_t const first = std::max(begin, b * s.blockSize);
+        uint64_t const last = std::min(end, (b + 1) * s.blockSize);
+        long double min = s.blockMin[b];
+        long double max = s.blockMax[b];
+        uint64_t count = 0, numNaN = 0;
+        reduceValues(chunk.dtype, data + (first - begin) * bytes, last - first, min, max, count, numNaN);
+        s.blockMin[b] = static_cast< double >(min);
+        s.blockMax[b] = static_cast< double >(max);
+    }
+    s.blocksChanged = true;
+}
+
+void
+RecordComponent::storeStatistics()
+{
+    Statistics const& s = m_statistics;
+    long double min = s.min;
+    long double max = s.max;
+    uint64_t count = s.count;
+    uint64_t numNaN = s.numNaN;
+#if openPMD_HAVE_MPI
+    if( s.comm != MPI_COMM_NULL )
+    {
+        MPI_Allreduce(&s.min, &min, 1, MPI_LONG_DOUBLE, MPI_MIN, s.comm);
+        MPI_Allreduce(&s.max, &max, 1, MPI_LONG_DOUBLE, MPI_MAX, s.comm);
+        MPI_Allreduce(&s.count, &count, 1, MPI_UINT64_T, MPI_SUM, s.comm);
+        MPI_Allreduce(&s.numNaN, &numNaN, 1, MPI_UINT64_T, MPI_SUM, s.comm);
+    }
+#endif
+
+    /* chunks are only ever added, so the statistics changed iff more values have been seen */
+    if( count + numNaN == s.stored )
+        return;
+    m_statistics.stored = count + numNaN;
+    if( count > 0 )
+    {
+        setAttribute("minValue", static_cast< double >(min));
+        setAttribute("maxValue", static_cast< double >(max));
+    }
+    setAttribute("numNaN", numNaN);
+}
+
+void
+RecordComponent::storeChecksums()
+{
+    Checksums& c = m_checksums;
+    size_t const dim = getDimensionality();
+#if openPMD_HAVE_MPI
+    if( c.comm != MPI_COMM_NULL )
+    {
+        int size;
+        MPI_Comm_size(c.comm, &size);
+        int local = static_cast< int >(c.pendingValues.size());
+        std::vector< int > counts(size);
+        MPI_Allgather(&local, 1, MPI_INT, counts.data(), 1, MPI_INT, c.comm);
+        std::vector< int > displs(size, 0);
+        for( int r = 1; r < size; ++r )
+            displs[r] = displs[r - 1] + counts[r - 1];
+        size_t const total = static_cast< size_t >(displs[size - 1] + counts[size - 1]);
+
+        std::vector< uint32_t > values(total);
+        MPI_Allgatherv(c.pendingValues.data(), local, MPI_UINT32_T,
+                       values.data(), counts.data(), displs.data(), MPI_UINT32_T, c.comm);
+        for( int r = 0; r < size; ++r )
+        {
+            counts[r] *= static_cast< int >(dim);
+            displs[r] *= static_cast< int >(dim);
+        }
+        std::vector< uint64_t > offsets(total * dim);
+        std::vector< uint64_t > extents(total * dim);
+        MPI_Allgatherv(c.pendingOffsets.data(), local * static_cast< int >(dim), MPI_UINT64_T,
+                       offsets.data(), counts.data(), displs.data(), MPI_UINT64_T, c.comm);
+        MPI_Allgatherv(c.pendingExtents.data(), local * static_cast< int >(dim), MPI_UINT64_T,
+                       extents.data(), counts.data(), displs.data(), MPI_UINT64_T, c.comm);
+        c.pendingValues = std::move(values);
+        c.pendingOffsets = std::move(offsets);
+        c.pendingExtents = std::move(extents);
+    }
+#endif
+    if( c.pendingValues.empty() )
+        return;
+
+    for( size_t n = 0; n < c.pendingValues.size(); ++n )
+    {
+        auto offset = c.pendingOffsets.begin() + n * dim;
+        auto extent = c.pendingExtents.begin() + n * dim;
+        /* a chunk written again (e.g. in overwrite mode) replaces the checksum of the previous one */
+        size_t existing = c.values.size();
+        for( size_t m = c.values.size(); m-- > 0; )
+            if( std::equal(offset, offset + dim, c.offsets.begin() + m * dim)
+                && std::equal(extent, extent + dim, c.extents.begin() + m * dim) )
+            {
+                existing = m;
+                break;
+            }
+        if( existing == c.values.size() )
+        {
+            c.offsets.insert(c.offsets.end(), offset, offset + dim);
+            c.extents.insert(c.extents.end(), extent, extent + dim);
+            c.values.push_back(c.pendingValues[n]);
+        } else
+            c.values[existing] = c.pendingValues[n];
+    }
+    c.pendingOffsets.clear();
+    c.pendingExtents.clear();
+    c.pendingValues.clear();
+
+    setAttribute("chunkOffset", c.offsets);
+    setAttribute("chunkExtent", c.extents);
+    setAttribute("chunkCRC32C", c.values);
+}
+
+std::function< void() >
+RecordComponent::checksumVerification(Datatype dtype, Offset const& o, Extent const& e, void const* data, double scale)
+{
+    /* converted or scaled values differ from the written bytes */
+    if( !m_checksums.enabled || dtype != getDatatype() || scale != 1.
+        || !containsAttribute("chunkCRC32C") || !containsAttribute("chunkOffset") || !containsAttribute("chunkExtent") )
+        return {};
+
+    std::vector< uint64_t > offsets = getAttribute("chunkOffset").get< std::vector< uint64_t > >();
+    std::vector< uint64_t > extents = getAttribute("chunkExtent").get< std::vector< uint64_t > >();
+    std::vector< uint32_t > values = getAttribute("chunkCRC32C").get< std::vector< uint32_t > >();
+    size_t const dim = o.size();
+    if( offsets.size() != values.size() * dim || extents.size() != values.size() * dim )
+        throw std::runtime_error("Checksum attributes of the record component are inconsistent.");
+
+    /* chunks inside the loaded one, as offset relative to it, extent and checksum */
+    struct Covered
+    {
+        Offset offset;
+        Extent extent;
+        uint32_t crc;
+    };
+    std::vector< Covered > covered;
+    for( size_t n = 0; n < values.size(); ++n )
+    {
+        Covered c{Offset(dim), Extent(dim), values[n]};
+        bool inside = true;
+        for( size_t i = 0; i < dim && inside; ++i )
+        {
+            uint64_t const begin = offsets[n * dim + i];
+            uint64_t const end = begin + extents[n * dim + i];
+            inside = begin >= o[i] && end <= o[i] + e[i];
+            c.offset[i] = begin - o[i];
+            c.extent[i] = extents[n * dim + i];
+        }
+        if( inside )
+            covered.push_back(std::move(c));
+    }
+    if( covered.empty() )
+        return {};
+
+    size_t const bytes = toBytes(dtype);
+    std::shared_ptr< auxiliary::BufferPool > pool = IOHandler->bufferPool;
+    return [covered, o, e, data, bytes, dtype, pool]()
+    {
+        for( auto const& c : covered )
+        {
+            size_t numPoints = 1;
+            for( auto const& dimensionSize : c.extent )
+                numPoints *= dimensionSize;
+            uint32_t crc;
+            if( c.extent == e )
+                crc = auxiliary::crc32cParallel(data, numPoints * bytes);
+            else
+            {
+                auto dense = auxiliary::allocatePtr(dtype, numPoints, pool.get());
+                auxiliary::pack(dense.get(), data, bytes, c.extent, c.offset, e);
+                crc = auxiliary::crc32cParallel(dense.get(), numPoints * bytes);
+            }
+            if( crc != c.crc )
+            {
+                std::string offset;
+                for( size_t i = 0; i < o.size(); ++i )
+                    offset += (i == 0 ? "" : ", ") + std::to_string(o[i] + c.offset[i]);
+                throw std::runtime_error("Checksum mismatch in the chunk written at offset {" + offset + "}.");
+            }
+        }
+    };
+}
+
+void
+RecordComponent::storeBlockIndex(RecordComponent& index)
+{
+    Statistics& s = m_statistics;
+    int changed = s.blocksChanged ? 1 : 0;
+    bool store = true;
+#if openPMD_HAVE_MPI
+    if( s.comm != MPI_COMM_NULL )
+    {
+        /* min and max are idempotent, the local ranges may be replaced by the combined ones */
+        uint64_t numBlocks = s.blockMin.size();
+        MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_LOR, s.comm);
+        MPI_Allreduce(MPI_IN_PLACE, &numBlocks, 1, MPI_UINT64_T, MPI_MAX, s.comm);
+        s.blockMin.resize(numBlocks, std::numeric_limits< double >::max());
+        s.blockMax.resize(numBlocks, std::numeric_limits< double >::lowest());
+        MPI_Allreduce(MPI_IN_PLACE, s.blockMin.data(), static_cast< int >(numBlocks), MPI_DOUBLE, MPI_MIN, s.comm);
+        MPI_Allreduce(MPI_IN_PLACE, s.blockMax.data(), static_cast< int >(numBlocks), MPI_DOUBLE, MPI_MAX, s.comm);
+        /* the combined index is identical on all ranks */
+        int rank;
+        MPI_Comm_rank(s.comm, &rank);
+        store = rank == 0;
+    }
+#endif
+    if( !changed )
+        return;
+    s.blocksChanged = false;
+
+    uint64_t const numBlocks = s.blockMin.size();
+    if( !index.written )
+    {
+        index.resetDataset(Dataset(Datatype::DOUBLE, {numBlocks, 2}));
+        index.setAttribute("blockSize", s.blockSize);
+    } else if( index.m_dataset.extent[0] < numBlocks )
+    {
+        index.m_dataset.extent[0] = numBlocks;
+        index.m_extentDirty = true;
+    }
+    if( !store )
+        return;
+
+    std::shared_ptr< double > ranges(new double[2 * numBlocks], [](double* p){ delete[] p; });
+    for( uint64_t b = 0; b < numBlocks; ++b )
+    {
+        ranges.get()[2 * b] = s.blockMin[b];
+        ranges.get()[2 * b + 1] = s.blockMax[b];
+    }
+    index.storeChunk({0, 0}, {numBlocks, 2}, ranges);
+}
+
+void
+RecordComponent::verifyDatatype(Datatype dtype)
+{
+    /* the backend converts between all numeric types while reading */
+    auto numeric = []( Datatype d ){ return d != Datatype::BOOL && d < Datatype::STRING; };
+    if( dtype != getDatatype() && !(numeric(dtype) && numeric(getDatatype())) )
+        throw std::runtime_error("Type conversion during chunk loading is only supported between numeric types");
+}
+
+void
+RecordComponent::verifyChunk(Datatype dtype, Offset const& o, Extent const& e)
+{
+    verifyDatatype(dtype);
+
+    uint8_t dim = getDimensionality();
+    if( e.size() != dim || o.size() != dim )
+        throw std::runtime_error("Dimensionality of chunk and dataset do not match.");
+    Extent dse = getExtent();
+    for( uint8_t i = 0; i < dim; ++i )
+        if( dse[i] < o[i] + e[i] )
+            throw std::runtime_error("Chunk does not reside inside dataset (Dimension on index " + std::to_string(i)
+                                     + " - DS: " + std::to_string(dse[i])
+                                     + " - Chunk: " + std::to_string(o[i] + e[i])
+                                     + ")");
+}
+
+void
+RecordComponent::verifyStore(Datatype dtype, Offset const& o, Extent const& e)
+{
+    if( m_isConstant )
+        throw std::runtime_error("Chunks can not be written for a constant RecordComponent.");
+    if( dtype != getDatatype() )
+        throw std::runtime_error("Datatypes of chunk and dataset do not match.");
+    uint8_t dim = getDimensionality();
+    if( e.size() != dim || o.size() != dim )
+        throw std::runtime_error("Dimensionality of chunk and dataset do not match.");
+    Extent dse = getExtent();
+    for( uint8_t i = 0; i < dim; ++i )
+        if( dse[i] < o[i] + e[i] )
+            throw std::runtime_error("Chunk does not reside inside dataset (Dimension on index " + std::to_string(i)
+                                     + " - DS: " + std::to_string(dse[i])
+                                     + " - Chunk: " + std::to_string(o[i] + e[i])
+                                     + ")");
+}
+
+void
+RecordComponent::storeDevice(Datatype dtype, Offset o, Extent e, void const* data, DeviceMemory const& memory)
+{
+    verifyStore(dtype, o, e);
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during chunk store.");
+    if( !memory.toHost )
+        throw std::runtime_error("Chunks can not be stored from device memory without a copy to the host.");
+
+    size_t rowPoints = 1;
+    for( size_t i = 1; i < e.size(); ++i )
+        rowPoints *= e[i];
+    size_t const rowBytes = rowPoints * toBytes(dtype);
+    uint64_t const slabRows = rowBytes == 0
+                              ? e[0]
+                              : std::max< uint64_t >(1u, memory.slabBytes / rowBytes);
+    auxiliary::BufferPool* pool = memory.staging ? memory.staging.get() : IOHandler->bufferPool.get();
+    char const* device = static_cast< char const* >(data);
+
+    for( uint64_t row = 0; row < e[0]; row += slabRows )
+    {
+        uint64_t const rows = std::min(slabRows, e[0] - row);
+        auto buffer = auxiliary::allocatePtr(dtype, rows * rowPoints, pool);
+        memory.toHost(buffer.get(), device + row * rowBytes, rows * rowBytes);
+
+        Parameter< Operation::WRITE_DATASET > dWrite;
+        dWrite.offset = o;
+        dWrite.offset[0] += row;
+        dWrite.extent = e;
+        dWrite.extent[0] = rows;
+        dWrite.dtype = dtype;
+        dWrite.chunkCache = m_dataset.chunkCache;
+        std::function< void(void*) > del = buffer.get_deleter();
+        dWrite.data = std::shared_ptr< void >(buffer.release(), del);
+        /* a slab over the budget is written in the background while the next one is copied */
+        stageChunk(std::move(dWrite), true, true);
+    }
+}
+
+namespace
+{
+/* staging costs a copy, merging only pays off for small chunks */
+constexpr size_t maxCoalescedBytes = size_t(4) << 20;
+
+size_t
+chunkBytes(Parameter< Operation::WRITE_DATASET > const& chunk)
+{
+    size_t bytes = toBytes(chunk.dtype);
+    for( auto const& dimensionSize : chunk.extent )
+        bytes *= dimensionSize;
+    return bytes;
+}
+
+/* true if b continues a along the slowest varying dimension,
+ * i.e. both chunks form one contiguous row-major block */
+bool
+abuts(Parameter< Operation::WRITE_DATASET > const& a,
+      Parameter< Operation::WRITE_DATASET > const& b)
+{
+    if( a.dtype != b.dtype || a.offset.size() != b.offset.size() || a.offset.empty() )
+        return false;
+    for( size_t i = 1; i < a.offset.size(); ++i )
+        if( a.offset[i] != b.offset[i] || a.extent[i] != b.extent[i] )
+            return false;
+    return a.offset[0] + a.extent[0] == b.offset[0];
+}
+} // namespace
+
+void
+RecordComponent::stageChunk(Parameter< Operation::WRITE_DATASET > dWrite, bool checkBudget, bool owned)
+{
+    /* other threads may stage chunks of other components, flush the Series or enqueue reads meanwhile */
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    WriteStaging& staging = IOHandler->staging;
+    size_t bytes = chunkBytes(dWrite);
+    if( staging.mode == StagingMode::COPY && !owned )
+        copyChunk(dWrite, IOHandler->bufferPool.get());
+
+    m_chunks.push(IOTask(this, std::move(dWrite)));
+    m_stagedBytes += bytes;
+    staging.bytes += bytes;
+    ++staging.chunks;
+    WriteStaging::Staged& staged = staging.components[this];
+    staged.bytes += bytes;
+    ++staged.chunks;
+    setDirty();
+
+    if( checkBudget )
+        flushOverBudget();
+}
+
+void
+RecordComponent::copyChunk(Parameter< Operation::WRITE_DATASET >& dWrite, auxiliary::BufferPool* pool)
+{
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : dWrite.extent )
+        numPoints *= dimensionSize;
+    auto buffer = auxiliary::allocatePtr(dWrite.dtype, numPoints, pool);
+    copyDense(buffer.get(), dWrite, numPoints);
+    std::function< void(void*) > del = buffer.get_deleter();
+    dWrite.data = std::shared_ptr< void >(buffer.release(), del);
+    dWrite.memoryStride = 1;
+    dWrite.memoryExtent.clear();
+    dWrite.memoryOffset.clear();
+}
+
+void
+RecordComponent::flushOverBudget()
+{
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    WriteStaging& staging = IOHandler->staging;
+    if( staging.budget != 0 && staging.bytes > staging.budget )
+    {
+        Writable* w = this;
+        while( w->parent )
+            w = w->parent;
+        /* components that are not part of a Series yet are written with it later */
+        if( Series* s = dynamic_cast< Series* >(w) )
+            s->flushStaged();
+    }
+}
+
+void
+RecordComponent::trimAppended()
+{
+    if( !m_appending || m_dataset.extent[0] == m_appendedSize )
+        return;
+
+    m_dataset.extent[0] = m_appendedSize;
+    if( written )
+        m_extentDirty = true;
+    setDirty();
+}
+
+void
+RecordComponent::prefetchChunk(Offset const& o, Extent const& e)
+{
+    if( m_isConstant || o.size() != getDimensionality() || e.size() != getDimensionality() )
+        return;
+    /* e.g. the number of particles changes between iterations */
+    Extent dse = getExtent();
+    size_t numPoints = 1;
+    for( uint8_t i = 0; i < getDimensionality(); ++i )
+    {
+        if( dse[i] < o[i] + e[i] )
+            return;
+        numPoints *= e[i];
+    }
+    for( auto const& p : m_prefetched )
+        if( p.offset == o && p.extent == e )
+            return;
+
+    auto buffer = auxiliary::allocatePtr(getDatatype(), numPoints, IOHandler->bufferPool.get());
+    std::function< void(void*) > del = buffer.get_deleter();
+    std::shared_ptr< void > data(buffer.release(), del);
+
+    Parameter< Operation::READ_DATASET > dRead;
+    dRead.offset = o;
+    dRead.extent = e;
+    dRead.dtype = getDatatype();
+    dRead.chunkCache = m_dataset.chunkCache;
+    dRead.data = data.get();
+    dRead.buffer = data;
+    dRead.done = std::make_shared< std::promise< void > >();
+    m_prefetched.push_back({o, e, data, dRead.done->get_future().share()});
+    IOHandler->enqueue(IOTask(this, std::move(dRead)));
+}
+
+std::shared_ptr< void >
+RecordComponent::takePrefetched(Offset const& o, Extent const& e)
+{
+    auto it = std::find_if(m_prefetched.begin(), m_prefetched.end(),
+                           [&o, &e](Prefetched const& p){ return p.offset == o && p.extent == e; });
+    if( it == m_prefetched.end() )
+        return std::shared_ptr< void >();
+
+    Prefetched p = std::move(*it);
+    m_prefetched.erase(it);
+    /* rethrows the error of the read */
+    p.done.get();
+    return p.data;
+}
+
+void
+RecordComponent::coalesceChunks()
+{
+    using WriteParameter = Parameter< Operation::WRITE_DATASET >;
+    IOTaskQueue coalesced;
+    std::vector< WriteParameter > run;
+
+    auto finishRun = [&]()
+    {
+        if( run.size() == 1 )
+            coalesced.push(IOTask(this, run.front()));
+        else if( run.size() > 1 )
+        {
+            WriteParameter merged = run.front();
+            merged.memoryStride = 1;
+            merged.memoryExtent.clear();
+            merged.memoryOffset.clear();
+            for( size_t i = 1; i < run.size(); ++i )
+                merged.extent[0] += run[i].extent[0];
+
+            size_t numPoints = 1;
+            for( auto const& dimensionSize : merged.extent )
+                numPoints *= dimensionSize;
+            auto buffer = auxiliary::allocatePtr(merged.dtype, numPoints, IOHandler->bufferPool.get());
+            char* dest = static_cast< char* >(buffer.get());
+            for( auto const& chunk : run )
+            {
+                size_t bytes = chunkBytes(chunk);
+                copyDense(dest, chunk, bytes / toBytes(chunk.dtype));
+                dest += bytes;
+            }
+            std::function< void(void*) > del = buffer.get_deleter();
+            merged.data = std::shared_ptr< void >(buffer.release(), del);
+            coalesced.push(IOTask(this, merged));
+        }
+        run.clear();
+    };
+
+    size_t runBytes = 0;
+    while( !m_chunks.empty() )
+    {
+        WriteParameter const& chunk = m_chunks.front().getParameter< Operation::WRITE_DATASET >();
+        size_t bytes = chunkBytes(chunk);
+        if( run.empty() || !abuts(run.back(), chunk) || runBytes + bytes > maxCoalescedBytes )
+        {
+            finishRun();
+            runBytes = 0;
+        }
+        run.push_back(chunk);
+        runBytes += bytes;
+        m_chunks.pop();
+    }
+    finishRun();
+
+    std::swap(m_chunks, coalesced);
+}
+
+double
+RecordComponent::scaleFactor(double targetUnitSI)
+{
+    if( std::isnan(targetUnitSI) )
+        return 1.;
+    if( targetUnitSI == 0. || std::isinf(targetUnitSI) )
+        throw std::runtime_error("targetUnitSI for chunk loading must be finite and non-zero.");
+    return unitSI() / targetUnitSI;
+}
+
 void
 RecordComponent::read()
 {
@@ -20,26 +20,101 @@
  */
 #include "openPMD/auxiliary/StringManip.hpp"
 #include "openPMD/IO/AbstractIOHandler.hpp"
+#include "openPMD/IO/ADIOS/ParallelADIOS1IOHandler.hpp"
+#include "openPMD/IO/HDF5/HDF5IOHandler.hpp"
+#include "openPMD/IO/HDF5/ParallelHDF5IOHandler.hpp"
 #include "openPMD/Series.hpp"
 
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <queue>
 #include <regex>
+#include <utility>
+#include <vector>
 
 
 namespace openPMD
 {
+struct Series::ParseWorker
+{
+    std::shared_ptr< AbstractIOHandler > IOHandler;
+    /* stand-ins for the Series and its iterations container,
+     * so that workers never share a Writable that is modified by the backend */
+    Writable file;
+    Writable iterationsGroup;
+};
+
 void
 check_extension(std::string const& filepath)
 {
     if( !auxiliary::ends_with(filepath, ".h5") &&
         !auxiliary::ends_with(filepath, ".bp") &&
+        !auxiliary::ends_with(filepath, ".sst") &&
+        !auxiliary::ends_with(filepath, ".ssc") &&
         !auxiliary::ends_with(filepath, ".dummy") )
         throw std::runtime_error("File format not recognized. "
                                  "Did you append a correct filename extension?");
 }
 
+void
+check_staging(std::string const& filepath, std::string const& stagingDirectory)
+{
+    if( stagingDirectory.empty() )
+        throw std::runtime_error("The staging directory of a Series must not be empty.");
+    if( auxiliary::ends_with(filepath, ".sst") || auxiliary::ends_with(filepath, ".ssc") )
+        throw std::runtime_error("Streams can not be written to a staging directory.");
+}
+
+std::vector< std::string >
+component_path(std::string const& path)
+{
+    std::vector< std::string > segments;
+    for( auto const& segment : auxiliary::split(path, "/") )
+        if( !segment.empty() )
+            segments.push_back(segment);
+
+    bool const mesh = segments.size() >= 2 && segments.size() <= 3 && segments[0] == "meshes";
+    bool const particle = segments.size() >= 3 && segments.size() <= 4 && segments[0] == "particles";
+    if( !mesh && !particle )
+        throw std::invalid_argument("Path must name a mesh or particle record (component): " + path);
+    return segments;
+}
+
+RecordComponent*
+find_component(Iteration& i, std::vector< std::string > const& p)
+{
+    if( p[0] == "meshes" )
+    {
+        auto m = i.meshes.find(p[1]);
+        if( m != i.meshes.end() )
+        {
+            auto c = m->second.find(p.size() == 3 ? p[2] : RecordComponent::SCALAR);
+            if( c != m->second.end() )
+                return &c->second;
+        }
+    } else
+    {
+        auto species = i.particles.find(p[1]);
+        if( species != i.particles.end() )
+        {
+            auto r = species->second.find(p[2]);
+            if( r != species->second.end() )
+            {
+                auto c = r->second.find(p.size() == 4 ? p[3] : RecordComponent::SCALAR);
+                if( c != r->second.end() )
+                    return &c->second;
+            }
+        }
+    }
+    return nullptr;
+}
+
 #if openPMD_HAVE_MPI
 Series
 Series::create(std::string const& filepath,
@@ -53,6 +128,47 @@ Series::create(std::string const& filepath,
 
     return Series(filepath, at, comm);
 }
+
+Series
+Series::create(std::string const& filepath,
+               MPI_Comm comm,
+               ADIOS1Transport const& transport,
+               AccessType at)
+{
+    if( AccessType::READ_ONLY == at )
+        throw std::runtime_error("Access type not supported in create-API.");
+
+    if( !auxiliary::ends_with(filepath, ".bp") )
+        throw std::runtime_error("ADIOS1 transport methods require a filename ending in .bp");
+
+    return Series(filepath, at, comm, &transport);
+}
+
+Series
+Series::create(std::string const& filepath,
+               MPI_Comm comm,
+               ParallelHDF5Options const& options,
+               AccessType at)
+{
+    if( AccessType::READ_ONLY == at )
+        throw std::runtime_error("Access type not supported in create-API.");
+
+    if( !auxiliary::ends_with(filepath, ".h5") )
+        throw std::runtime_error("Parallel HDF5 options require a filename ending in .h5");
+
+    return Series(filepath, at, comm, nullptr, &options);
+}
+
+Series
+Series::create(std::string const& filepath,
+               MPI_Comm comm,
+               std::string const& stagingDirectory)
+{
+    check_extension(filepath);
+    check_staging(filepath, stagingDirectory);
+
+    return Series(filepath, AccessType::CREATE, comm, nullptr, nullptr, false, stagingDirectory);
+}
 #endif
 
 Series
@@ -67,6 +183,43 @@ Series::create(std::string const& filepath,
     return Series(filepath, at);
 }
 
+Series
+Series::create(std::string const& filepath,
+               HDF5Options const& options,
+               AccessType at)
+{
+    if( AccessType::READ_ONLY == at )
+        throw std::runtime_error("Access type not supported in create-API.");
+
+    if( !auxiliary::ends_with(filepath, ".h5") )
+        throw std::runtime_error("HDF5 options require a filename ending in .h5");
+
+    return Series(filepath, at, &options);
+}
+
+Series
+Series::read(std::string const& filepath,
+             ReadFilter const& filter,
+             AccessType at)
+{
+    if( AccessType::READ_ONLY != at )
+        throw std::runtime_error("A filtered Series can only be opened as read only.");
+
+    check_extension(filepath);
+
+    return Series(filepath, at, nullptr, false, std::string(), &filter);
+}
+
+Series
+Series::create(std::string const& filepath,
+               std::string const& stagingDirectory)
+{
+    check_extension(filepath);
+    check_staging(filepath, stagingDirectory);
+
+    return Series(filepath, AccessType::CREATE, nullptr, false, stagingDirectory);
+}
+
 #if openPMD_HAVE_MPI
 Series
 Series::read(std::string const& filepath,
@@ -80,6 +233,35 @@ Series::read(std::string const& filepath,
 
     return Series(filepath, at, comm);
 }
+
+Series
+Series::read(std::string const& filepath,
+             MPI_Comm comm,
+             ParallelHDF5Options const& options,
+             AccessType at)
+{
+    if( AccessType::CREATE == at )
+        throw std::runtime_error("Access type not supported in read-API.");
+
+    if( !auxiliary::ends_with(filepath, ".h5") )
+        throw std::runtime_error("Parallel HDF5 options require a filename ending in .h5");
+
+    return Series(filepath, at, comm, nullptr, &options);
+}
+
+Series
+Series::read(std::string const& filepath,
+             MPI_Comm comm,
+             ReadFilter const& filter,
+             AccessType at)
+{
+    if( AccessType::READ_ONLY != at )
+        throw std::runtime_error("A filtered Series can only be opened as read only.");
+
+    check_extension(filepath);
+
+    return Series(filepath, at, comm, nullptr, nullptr, false, std::string(), &filter);
+}
 #endif
 
 Series
@@ -94,13 +276,60 @@ Series::read(std::string const& filepath,
     return Series(filepath, at);
 }
 
+Series
+Series::read(std::string const& filepath,
+             HDF5Options const& options,
+             AccessType at)
+{
+    if( AccessType::CREATE == at )
+        throw std::runtime_error("Access type not supported in read-API.");
+
+    if( !auxiliary::ends_with(filepath, ".h5") )
+        throw std::runtime_error("HDF5 options require a filename ending in .h5");
+
+    return Series(filepath, at, &options);
+}
+
+
+#if openPMD_HAVE_MPI
+Series
+Series::restart(std::string const& filepath,
+                MPI_Comm comm)
+{
+    check_extension(filepath);
+
+    return Series(filepath, AccessType::READ_ONLY, comm, nullptr, nullptr, true);
+}
+#endif
+
+Series
+Series::restart(std::string const& filepath)
+{
+    check_extension(filepath);
+
+    return Series(filepath, AccessType::READ_ONLY, nullptr, true);
+}
+
 
 #if openPMD_HAVE_MPI
 Series::Series(std::string const& filepath,
                AccessType at,
-               MPI_Comm comm)
-        : iterations{Container< Iteration, uint64_t >()}
+               MPI_Comm comm,
+               ADIOS1Transport const* transport,
+               ParallelHDF5Options const* hdf5Options,
+               bool restart,
+               std::string const& stagingDirectory,
+               ReadFilter const* filter)
+        : iterations{IterationContainer()},
+          m_parallel{true},
+          m_writeManifest{false},
+          m_manifestWriter{true},
+          m_checkpoint{restart}
 {
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    m_manifestWriter = rank == 0;
+
     std::string path;
     std::string name;
     auto const pos = filepath.find_last_of('/');
@@ -115,6 +344,15 @@ Series::Series(std::string const& filepath,
         name = filepath.substr(pos + 1);
     }
 
+    if( !stagingDirectory.empty() )
+    {
+        std::string staging = stagingDirectory;
+        if( !auxiliary::ends_with(staging, "/") )
+            staging += '/';
+        m_drain = std::make_shared< DrainQueue >(staging, path);
+        path = staging;
+    }
+
     IterationEncoding ie;
     if( std::string::npos != name.find("%T") )
         ie = IterationEncoding::fileBased;
@@ -124,8 +362,18 @@ Series::Series(std::string const& filepath,
     Format f;
     if( auxiliary::ends_with(name, ".h5") )
         f = Format::HDF5;
+    else if( auxiliary::ends_with(name, ".bp") && transport )
+        f = Format::ADIOS1;
     else if( auxiliary::ends_with(name, ".bp") )
+#if openPMD_HAVE_ADIOS2
+        f = Format::ADIOS2;
+#else
         f = Format::ADIOS1;
+#endif
+    else if( auxiliary::ends_with(name, ".sst") )
+        f = Format::ADIOS2_SST;
+    else if( auxiliary::ends_with(name, ".ssc") )
+        f = Format::ADIOS2_SSC;
     else
     {
         if( !auxiliary::ends_with(name, ".dummy") )
@@ -136,10 +384,15 @@ Series::Series(std::string const& filepath,
     }
 
     IOHandler = AbstractIOHandler::createIOHandler(path, at, f, comm);
+    if( transport )
+        std::static_pointer_cast< ParallelADIOS1IOHandler >(IOHandler)->setTransport(*transport);
+    if( hdf5Options )
+        std::static_pointer_cast< ParallelHDF5IOHandler >(IOHandler)->setOptions(*hdf5Options);
     iterations.IOHandler = IOHandler;
     iterations.parent = this;
 
     m_name = cleanFilename(name, f);
+    m_format = f;
 
     switch( at )
     {
@@ -156,6 +409,8 @@ Series::Series(std::string const& filepath,
         case AccessType::READ_ONLY:
         case AccessType::READ_WRITE:
         {
+            if( filter )
+                m_filter = *filter;
             if( auxiliary::contains(m_name, "%T") )
                 readFileBased();
             else
@@ -167,8 +422,16 @@ Series::Series(std::string const& filepath,
 #endif
 
 Series::Series(std::string const& filepath,
-               AccessType at)
-        : iterations{Container< Iteration, uint64_t >()}
+               AccessType at,
+               HDF5Options const* hdf5Options,
+               bool restart,
+               std::string const& stagingDirectory,
+               ReadFilter const* filter)
+        : iterations{IterationContainer()},
+          m_parallel{false},
+          m_writeManifest{false},
+          m_manifestWriter{true},
+          m_checkpoint{restart}
 {
     std::string path;
     std::string name;
@@ -184,6 +447,15 @@ Series::Series(std::string const& filepath,
         name = filepath.substr(pos + 1);
     }
 
+    if( !stagingDirectory.empty() )
+    {
+        std::string staging = stagingDirectory;
+        if( !auxiliary::ends_with(staging, "/") )
+            staging += '/';
+        m_drain = std::make_shared< DrainQueue >(staging, path);
+        path = staging;
+    }
+
     IterationEncoding ie;
     if( std::string::npos != name.find("%T") )
         ie = IterationEncoding::fileBased;
@@ -194,7 +466,15 @@ Series::Series(std::string const& filepath,
     if( auxiliary::ends_with(name, ".h5") )
         f = Format::HDF5;
     else if( auxiliary::ends_with(name, ".bp") )
+#if openPMD_HAVE_ADIOS2
+        f = Format::ADIOS2;
+#else
         f = Format::ADIOS1;
+#endif
+    else if( auxiliary::ends_with(name, ".sst") )
+        f = Format::ADIOS2_SST;
+    else if( auxiliary::ends_with(name, ".ssc") )
+        f = Format::ADIOS2_SSC;
     else
     {
         if( !auxiliary::ends_with(name, ".dummy") )
@@ -205,10 +485,13 @@ Series::Series(std::string const& filepath,
     }
 
     IOHandler = AbstractIOHandler::createIOHandler(path, at, f);
+    if( hdf5Options )
+        std::static_pointer_cast< HDF5IOHandler >(IOHandler)->setOptions(*hdf5Options);
     iterations.IOHandler = IOHandler;
     iterations.parent = this;
 
     m_name = cleanFilename(name, f);
+    m_format = f;
 
     switch( at )
     {
@@ -225,6 +508,8 @@ Series::Series(std::string const& filepath,
         case AccessType::READ_ONLY:
         case AccessType::READ_WRITE:
         {
+            if( filter )
+                m_filter = *filter;
             if( auxiliary::contains(m_name, "%T") )
                 readFileBased();
             else
@@ -236,8 +521,19 @@ Series::Series(std::string const& filepath,
 
 Series::~Series()
 {
+    /* errors of reads ahead of an iteration that has not been accessed are dropped */
+    if( m_prefetchInFlight.valid() )
+        m_prefetchInFlight.wait();
+    m_prefetchInFlight = std::shared_future< void >();
+    if( IOHandler->accessType != AccessType::READ_ONLY )
+        for( auto& i : iterations.m_container )
+            if( !i.second.closed() )
+                i.second.trimAppended();
     flush();
     IOHandler->flush();
+    /* copies of the Series share the staged files, the last one moves them */
+    if( m_drain && m_drain.use_count() == 1 )
+        drainRemaining();
 }
 
 std::string
@@ -292,8 +588,8 @@ Series::meshesPath() const
 Series&
 Series::setMeshesPath(std::string const& mp)
 {
-    if( std::any_of(iterations.begin(), iterations.end(),
-                    [](Container< Iteration, uint64_t >::value_type const& i){ return i.second.meshes.written; }) )
+    if( std::any_of(iterations.m_container.begin(), iterations.m_container.end(),
+                    [](IterationContainer::value_type const& i){ return i.second.meshes.written; }) )
         throw std::runtime_error("A files meshesPath can not (yet) be changed after it has been written.");
 
     if( auxiliary::ends_with(mp, "/") )
@@ -313,8 +609,8 @@ Series::particlesPath() const
 Series&
 Series::setParticlesPath(std::string const& pp)
 {
-    if( std::any_of(iterations.begin(), iterations.end(),
-                    [](Container< Iteration, uint64_t >::value_type const& i){ return i.second.particles.written; }) )
+    if( std::any_of(iterations.m_container.begin(), iterations.m_container.end(),
+                    [](IterationContainer::value_type const& i){ return i.second.particles.written; }) )
         throw std::runtime_error("A files particlesPath can not (yet) be changed after it has been written.");
 
     if( auxiliary::ends_with(pp, "/") )
@@ -472,33 +768,604 @@ Series::setName(std::string const& n)
     return *this;
 }
 
+std::shared_ptr< auxiliary::BufferPool >
+Series::bufferPool() const
+{
+    return IOHandler->bufferPool;
+}
+
+Series&
+Series::setBufferPool(std::shared_ptr< auxiliary::BufferPool > pool)
+{
+    IOHandler->bufferPool = std::move(pool);
+    return *this;
+}
+
+Series&
+Series::setChunkCache(std::size_t bytes, std::size_t slots, double preemption)
+{
+    if( !(preemption >= 0. && preemption <= 1.) )
+        throw std::runtime_error("Chunk cache preemption must be in [0, 1]");
+
+    ChunkCache cache;
+    cache.bytes = bytes;
+    cache.slots = slots;
+    cache.preemption = preemption;
+    IOHandler->chunkCache = cache;
+    /* iterations opened by openIterations() are read through the handlers of the workers */
+    for( auto const& worker : m_parseWorkers )
+        worker->IOHandler->chunkCache = cache;
+    return *this;
+}
+
+Series&
+Series::setAllocation(AllocationTime time, FillTime fill)
+{
+    IOHandler->allocation.time = time;
+    IOHandler->allocation.fill = fill;
+    return *this;
+}
+
+std::map< Operation, OperationStatistics >
+Series::ioStatistics() const
+{
+    return IOHandler->statistics.snapshot();
+}
+
+Series&
+Series::resetIOStatistics()
+{
+    IOHandler->statistics.reset();
+    return *this;
+}
+
+Series&
+Series::startTrace(std::string const& filename)
+{
+    int rank = 0;
+#if openPMD_HAVE_MPI
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if( initialized )
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+    IOHandler->statistics.startTrace(auxiliary::replace_all(filename, "%R", std::to_string(rank)), rank);
+    return *this;
+}
+
+Series&
+Series::stopTrace()
+{
+    IOHandler->statistics.stopTrace();
+    return *this;
+}
+
+Series&
+Series::setManifest(bool enabled)
+{
+    if( enabled && m_iterationEncoding != IterationEncoding::fileBased )
+        throw std::runtime_error("A manifest can only be written for fileBased iteration encoding");
+    m_writeManifest = enabled;
+    return *this;
+}
+
+Series&
+Series::setCheckpointMode(bool enabled)
+{
+    if( IOHandler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Checkpoint mode can only be set for Series opened for writing, open checkpoints with Series::restart");
+    m_checkpoint = enabled;
+    return *this;
+}
+
+Series&
+Series::setOverwriteMode(bool enabled)
+{
+    if( IOHandler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Overwrite mode can only be set for Series opened for writing.");
+    if( m_format != Format::HDF5 )
+        throw std::runtime_error("Overwrite mode is only supported by the HDF5 backends.");
+    IOHandler->overwrite = enabled;
+    return *this;
+}
+
+Series&
+Series::setStagingBudget(std::size_t bytes, StagingMode mode)
+{
+    IOHandler->staging.budget = bytes;
+    IOHandler->staging.mode = mode;
+    return *this;
+}
+
+Series&
+Series::setAsyncWrites(bool enabled)
+{
+    if( IOHandler->accessType == AccessType::READ_ONLY )
+        throw std::runtime_error("Asynchronous writes require a Series opened for writing");
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    IOHandler->staging.async = enabled;
+    return *this;
+}
+
+Series&
+Series::awaitWrites()
+{
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    awaitStaged();
+    return *this;
+}
+
+StagingStatus
+Series::stagingStatus() const
+{
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    WriteStaging const& staging = IOHandler->staging;
+    bool flushing = staging.inFlight.valid() &&
+                    staging.inFlight.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    return StagingStatus{staging.budget, staging.bytes, staging.chunks, staging.autoFlushes, flushing};
+}
+
+PendingWrites
+Series::pendingWrites(std::size_t largest) const
+{
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    WriteStaging const& staging = IOHandler->staging;
+    PendingWrites ret{staging.bytes, staging.chunks, IOHandler->m_work.size(), {}};
+
+    using Entry = std::pair< Writable const*, WriteStaging::Staged >;
+    std::vector< Entry > components(staging.components.begin(), staging.components.end());
+    auto const end = components.begin() + std::min(largest, components.size());
+    std::partial_sort(components.begin(), end, components.end(),
+                      [](Entry const& a, Entry const& b){ return a.second.bytes > b.second.bytes; });
+    /* only the reported components are located in the object model, by walking up from each of them */
+    for( auto c = components.begin(); c != end; ++c )
+        ret.largest.push_back(PendingComponent{objectPath(c->first), c->second.bytes, c->second.chunks});
+    return ret;
+}
+
+std::string
+Series::childName(Writable const* child) const
+{
+    if( child == &iterations )
+        return "iterations";
+    return std::string();
+}
+
+std::string
+Series::objectPath(Writable const* w)
+{
+    std::string path;
+    for( ; w->parent; w = w->parent )
+    {
+        auto parent = dynamic_cast< Attributable const* >(w->parent);
+        std::string name = parent ? parent->childName(w) : std::string();
+        path = path.empty() ? name : name + '/' + path;
+    }
+    return path;
+}
+
+DrainStatus
+Series::drainStatus() const
+{
+    if( !m_drain )
+        return DrainStatus{0, 0, 0, 0};
+    return m_drain->status();
+}
+
+Series&
+Series::awaitDrain()
+{
+    if( m_drain )
+        m_drain->await();
+    return *this;
+}
+
 void
 Series::flush()
 {
+    /* serialized with chunks staged by other threads */
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    if( IOHandler->staging.async && IOHandler->accessType != AccessType::READ_ONLY )
+    {
+        flushStaged(false);
+        return;
+    }
+
     if( IOHandler->accessType == AccessType::READ_WRITE ||
         IOHandler->accessType == AccessType::CREATE )
     {
-        switch( m_iterationEncoding )
+        awaitStaged();
+        /* also waits for a previous asynchronous flush to complete */
+        IOHandler->flush();
+
+        flushEncoding();
+
+        /* all output tasks of the traversal above are only enqueued,
+         * they are executed in a single batch here */
+        IOHandler->flush();
+    } else
+    {
+        awaitPrefetch();
+        /* deferred reads (e.g. RecordComponent::loadChunk into a std::shared_ptr) */
+        IOHandler->flush();
+        for( auto const& worker : m_parseWorkers )
+            worker->IOHandler->flush();
+    }
+}
+
+std::future< void >
+Series::flushAsync()
+{
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    if( IOHandler->accessType == AccessType::READ_WRITE ||
+        IOHandler->accessType == AccessType::CREATE )
+    {
+        /* the traversal relies on state assigned by the backend,
+         * so a previous asynchronous flush has to complete first */
+        awaitStaged();
+        IOHandler->flush();
+
+        flushEncoding();
+
+        return IOHandler->flushAsync();
+    }
+
+    /* iterations parsed by openIterations() are read synchronously */
+    for( auto const& worker : m_parseWorkers )
+        worker->IOHandler->flush();
+    return IOHandler->flushAsync();
+}
+
+Series&
+Series::openIterations(unsigned int workers)
+{
+    openIterations(0, std::numeric_limits< uint64_t >::max(), workers, nullptr);
+    return *this;
+}
+
+void
+Series::openIterations(uint64_t first, uint64_t last, unsigned int workers,
+                       std::function< void(uint64_t, Iteration&) > const& visit)
+{
+    std::vector< std::pair< uint64_t, Iteration* > > pending;
+    for( auto& i : iterations.m_container )
+    {
+        if( i.first < first || i.first > last )
+            continue;
+        if( !i.second.m_parsed && !i.second.m_fileName.empty() )
+            pending.emplace_back(i.first, &i.second);
+        else if( visit )
+            visit(i.first, i.second);
+    }
+    if( pending.empty() )
+        return;
+
+    if( workers == 0 )
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    workers = static_cast< unsigned int >(std::min< std::size_t >(workers, pending.size()));
+
+    /* ADIOS1 keeps global state, streams and parallel Series can not open files independently */
+    bool const concurrent = workers > 1
+                            && !m_parallel
+                            && IOHandler->accessType == AccessType::READ_ONLY
+                            && (m_format == Format::HDF5 || m_format == Format::ADIOS2);
+    if( !concurrent )
+    {
+        for( auto& p : pending )
+        {
+            p.second->open();
+            if( visit )
+                visit(p.first, *p.second);
+        }
+        return;
+    }
+
+    /* objects created while parsing flag their ancestors, which are shared by all workers */
+    dirtyRecursive = true;
+    iterations.dirtyRecursive = true;
+
+    std::vector< std::shared_ptr< ParseWorker > > pool;
+    for( unsigned int w = 0; w < workers; ++w )
+    {
+        auto worker = std::make_shared< ParseWorker >();
+        worker->IOHandler = AbstractIOHandler::createIOHandler(IOHandler->directory, IOHandler->accessType, m_format);
+        worker->IOHandler->bufferPool = IOHandler->bufferPool;
+        worker->IOHandler->chunkCache = IOHandler->chunkCache;
+        if( m_format == Format::HDF5 )
+            std::static_pointer_cast< HDF5IOHandler >(worker->IOHandler)->setOptions(
+                std::static_pointer_cast< HDF5IOHandler >(IOHandler)->options());
+        worker->file.IOHandler = worker->IOHandler;
+        worker->file.parent = this;
+        worker->iterationsGroup.IOHandler = worker->IOHandler;
+        worker->iterationsGroup.parent = &worker->file;
+        pool.push_back(worker);
+    }
+
+    std::atomic< std::size_t > next{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto parse = [&](ParseWorker& worker)
+    {
+        std::size_t p;
+        while( (p = next++) < pending.size() )
         {
-            using IE = IterationEncoding;
-            case IE::fileBased:
-                flushFileBased();
-                break;
-            case IE::groupBased:
-                flushGroupBased();
-                break;
+            Iteration& i = *pending[p].second;
+            i.IOHandler = worker.IOHandler;
+            i.meshes.IOHandler = worker.IOHandler;
+            i.particles.IOHandler = worker.IOHandler;
+            i.parent = &worker.iterationsGroup;
+            try
+            {
+                i.readFile(&worker.file, &worker.iterationsGroup, pending[p].first);
+                if( visit )
+                {
+                    visit(pending[p].first, i);
+                    worker.IOHandler->flush();
+                }
+            } catch( ... )
+            {
+                std::lock_guard< std::mutex > lock(errorMutex);
+                if( !error )
+                    error = std::current_exception();
+                next = pending.size();
+            }
+            i.parent = &iterations;
         }
+    };
+
+    std::vector< std::thread > threads;
+    for( unsigned int w = 1; w < workers; ++w )
+        threads.emplace_back(parse, std::ref(*pool[w]));
+    parse(*pool[0]);
+    for( auto& t : threads )
+        t.join();
+
+    m_parseWorkers.insert(m_parseWorkers.end(), pool.begin(), pool.end());
+    if( error )
+        std::rethrow_exception(error);
+}
+
+void
+Series::probeIterations(std::string const& path, uint64_t first, uint64_t last, unsigned int workers,
+                        std::function< void(uint64_t, RecordComponent&) > const& read)
+{
+    std::vector< std::string > const segments = component_path(path);
+    openIterations(first, last, workers, [&](uint64_t index, Iteration& i)
+    {
+        /* records are opened on access, so only the probed one is parsed */
+        if( RecordComponent* rc = find_component(i, segments) )
+            read(index, *rc);
+    });
+    /* reads of iterations that had been parsed before */
+    flush();
+}
+
+Series&
+Series::prefetch(std::string const& path, Offset const& offset, Extent const& extent)
+{
+    std::vector< std::string > segments = component_path(path);
+    if( offset.size() != extent.size() )
+        throw std::invalid_argument("Dimensionality of prefetched offset and extent do not match.");
+
+    m_prefetch.push_back({segments, offset, extent});
+    return *this;
+}
+
+Series&
+Series::clearPrefetch()
+{
+    m_prefetch.clear();
+    return *this;
+}
+
+void
+Series::prefetchAfter(Iteration const& current)
+{
+    awaitPrefetch();
+    if( m_prefetch.empty() || IOHandler->accessType != AccessType::READ_ONLY )
+        return;
+
+    auto it = iterations.m_container.find(current.m_index);
+    if( it == iterations.m_container.end() || ++it == iterations.m_container.end() )
+        return;
+    Iteration& next = it->second;
+    if( next.m_prefetched || next.m_closed )
+        return;
+
+    next.parse();
+    next.m_prefetched = true;
+
+    /* tasks the user has enqueued so far are set aside, so that only the reads ahead are handed to the backend */
+    std::lock_guard< std::recursive_mutex > lock(next.IOHandler->m_workMutex);
+    std::queue< IOTask > queued;
+    std::swap(queued, next.IOHandler->m_work.collect());
+
+    for( auto const& region : m_prefetch )
+        if( RecordComponent* rc = find_component(next, region.path) )
+            rc->prefetchChunk(region.offset, region.extent);
+
+    /* the reads overlap with the processing of the current iteration */
+    m_prefetchInFlight = next.IOHandler->flushAsync().share();
+
+    /* the set aside tasks stay ahead of those enqueued in the meantime */
+    std::queue< IOTask >& work = next.IOHandler->m_work.collect();
+    while( !work.empty() )
+    {
+        queued.push(std::move(work.front()));
+        work.pop();
+    }
+    std::swap(work, queued);
+}
+
+void
+Series::awaitPrefetch()
+{
+    /* rethrows errors of the previous reads ahead, once */
+    std::shared_future< void > inFlight = std::move(m_prefetchInFlight);
+    if( inFlight.valid() )
+        inFlight.get();
+}
+
+AdvanceStatus
+Series::advance()
+{
+    if( IOHandler->accessType != AccessType::READ_ONLY )
+        throw std::runtime_error("Only a Series opened as read only can be advanced. "
+                                 "Writers start a new step with every flush.");
+    if( m_iterationEncoding == IterationEncoding::fileBased )
+        return AdvanceStatus::OVER;
+
+    Parameter< Operation::ADVANCE > adv;
+    IOHandler->enqueue(IOTask(this, adv));
+    IOHandler->flush();
+
+    if( *adv.status == AdvanceStatus::OK )
+    {
+        /* allow all attributes to be set */
+        written = false;
+        iterations.written = false;
+        iterations.clear_unchecked();
+
+        read();
+
+        iterations.written = true;
+        written = true;
+    }
+
+    return *adv.status;
+}
+
+Series&
+Series::refresh()
+{
+    if( IOHandler->accessType != AccessType::READ_ONLY )
+        throw std::runtime_error("Only a Series opened as read only can be refreshed. "
+                                 "Writers know their iterations.");
+
+    if( auxiliary::contains(m_name, "%T") )
+    {
+        /* without any file at opening, the Series itself has not been read yet */
+        if( !containsAttribute("iterationEncoding") )
+        {
+            readFileBased();
+            return *this;
+        }
+
+        std::map< uint64_t, std::string > files;
+        listFiles(files);
+        registerFiles(files);
+        return *this;
+    }
+
+    if( m_parallel )
+        throw std::runtime_error("A groupBased Series opened with MPI can not be refreshed.");
+
+    Parameter< Operation::LIST_PATHS > pList;
+    pList.refresh = true;
+    IOHandler->enqueue(IOTask(&iterations, pList));
+    IOHandler->flush();
+
+    readIterations(*pList.paths);
+    return *this;
+}
+
+void
+Series::flushStaged(bool automatic)
+{
+    std::lock_guard< std::recursive_mutex > lock(IOHandler->m_workMutex);
+    awaitStaged();
+    IOHandler->flush();
+
+    flushEncoding();
+
+    /* the backend updates the frontend objects while creating them in the file,
+     * so only the chunk data may be written while the user continues */
+    std::queue< IOTask > data;
+    std::queue< IOTask > structure;
+    std::queue< IOTask >& work = IOHandler->m_work.collect();
+    while( !work.empty() )
+    {
+        if( work.front().operation == Operation::WRITE_DATASET )
+            data.push(std::move(work.front()));
+        else
+            structure.push(std::move(work.front()));
+        work.pop();
+    }
+    std::swap(work, structure);
+    IOHandler->flush();
+
+    /* the second buffer of double buffering, user buffers are free once this returns */
+    if( IOHandler->staging.async && IOHandler->staging.mode == StagingMode::REFERENCE )
+    {
+        std::queue< IOTask > copied;
+        while( !data.empty() )
+        {
+            RecordComponent::copyChunk(data.front().getParameter< Operation::WRITE_DATASET >(),
+                                       IOHandler->bufferPool.get());
+            copied.push(std::move(data.front()));
+            data.pop();
+        }
+        std::swap(data, copied);
+    }
+
+    std::swap(work, data);
+    IOHandler->staging.inFlight = IOHandler->flushAsync();
+    if( automatic )
+        ++IOHandler->staging.autoFlushes;
+}
+
+void
+Series::awaitStaged()
+{
+    /* rethrows errors of the background write */
+    std::future< void >& inFlight = IOHandler->staging.inFlight;
+    if( inFlight.valid() )
+        inFlight.get();
+}
+
+void
+Series::flushEncoding()
+{
+    flushEncoding(iterations.m_container.begin(), iterations.m_container.end());
+}
+
+void
+Series::flushEncoding(IterationContainer::InternalContainer::iterator begin, IterationContainer::InternalContainer::iterator end)
+{
+    switch( m_iterationEncoding )
+    {
+        using IE = IterationEncoding;
+        case IE::fileBased:
+            flushFileBased(begin, end);
+            break;
+        case IE::groupBased:
+            flushGroupBased(begin, end);
+            break;
     }
 }
 
 void
-Series::flushFileBased()
+Series::flushFileBased(IterationContainer::InternalContainer::iterator begin, IterationContainer::InternalContainer::iterator end)
 {
     if( iterations.empty() )
         throw std::runtime_error("fileBased output can not be written with no iterations.");
 
-    for( auto& i : iterations )
+    bool created = false;
+    for( auto it = begin; it != end; ++it )
     {
+        auto& i = *it;
+        /* iterations that have not been opened are unmodified,
+         * closed iterations have been written completely */
+        if( !i.second.parsed() || i.second.closed() )
+            continue;
+        /* files of unmodified iterations are not re-opened,
+         * unless the attributes of the Series have to be updated in them */
+        if( i.second.written && !i.second.dirtyRecursive && !dirty )
+            continue;
+
+        bool const newFile = !i.second.written;
+        created |= newFile;
+
         /* as there is only one series,
          * emulate the file belonging to each iteration as not yet written */
         written = false;
@@ -508,34 +1375,140 @@ Series::flushFileBased()
 
         iterations.flush(auxiliary::replace_first(basePath(), "%T/", ""));
 
-        if( dirty )
+        /* a new file needs all attributes of the Series,
+         * existing ones only the modified attributes
+         * (which stay flagged until all iterations have been updated) */
+        if( newFile )
+            enqueueAttributes(true);
+        else if( dirty )
+            enqueueAttributes(false);
+
+        /* sync point: the next iteration re-uses the Series and its
+         * iterations container as handles for a different file
+         * (so only the last file is left to an asynchronous flush) */
+        IOHandler->flush();
+    }
+
+    if( created && m_writeManifest && m_manifestWriter )
+        writeManifest();
+
+    /* modified attributes of the Series stay flagged until all files have been updated */
+    if( begin == iterations.m_container.begin() && end == iterations.m_container.end() )
+        clearDirty();
+}
+
+void
+Series::writeManifest()
+{
+    std::string const manifest = IOHandler->directory + m_name + ".manifest";
+    /* replaced in one step, so readers never see a partial manifest */
+    std::string const tmp = manifest + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        out << MANIFEST << '\n';
+        for( auto const& i : iterations )
         {
-            flushAttributes();
-            /* manually flag the Series dirty
-             * until all iterations have been updated */
-            dirty = true;
+            if( !i.second.written )
+                continue;
+            std::string const& fileName = i.second.m_fileName;
+            out << i.first << ' '
+                << (fileName.empty() ? auxiliary::replace_first(iterationFormat(), "%T", std::to_string(i.first)) : fileName)
+                << '\n';
         }
+        if( !out )
+            throw std::runtime_error("Failed to write the manifest " + tmp);
+    }
+    boost::filesystem::rename(tmp, manifest);
+}
+
+void
+Series::drain(std::string const& name)
+{
+    if( !m_drain || !m_manifestWriter )
+        return;
+
+    std::string suffix;
+    switch( m_format )
+    {
+        case Format::HDF5:
+            suffix = ".h5";
+            break;
+        case Format::ADIOS1:
+        case Format::ADIOS2:
+            suffix = ".bp";
+            break;
+        default:
+            break;
+    }
+    /* companion files (subfiles of parallel HDF5, metadata directories of ADIOS) first,
+     * so the file that references them appears last in the final directory */
+    for( auto const& file : {name + "_subfiles", name + suffix + ".dir", name + suffix} )
+        if( boost::filesystem::exists(m_drain->stagingDirectory() + file) )
+            m_drain->add(file);
+}
+
+void
+Series::drainRemaining()
+{
+    /* files still open are closed (collectively with MPI) before they are moved */
+    if( m_iterationEncoding == IterationEncoding::fileBased )
+    {
+        for( auto& i : iterations.m_container )
+            if( i.second.written && !i.second.closed() )
+                i.second.close();
+    } else if( written )
+    {
+        Parameter< Operation::CLOSE_FILE > fClose;
+        IOHandler->enqueue(IOTask(this, fClose));
+        IOHandler->flush();
+        drain(m_name);
     }
-    dirty = false;
+
+    std::string const manifest = m_name + ".manifest";
+    if( m_manifestWriter && boost::filesystem::exists(m_drain->stagingDirectory() + manifest) )
+        m_drain->add(manifest);
+}
+
+bool
+Series::readManifest(std::map< uint64_t, std::string >& files)
+{
+    std::ifstream in(IOHandler->directory + m_name + ".manifest");
+    std::string line;
+    if( !std::getline(in, line) || line != MANIFEST )
+        return false;
+
+    std::map< uint64_t, std::string > listed;
+    while( std::getline(in, line) )
+    {
+        auto const space = line.find(' ');
+        if( space == std::string::npos || space == 0 || space + 1 == line.size() )
+            return false;
+        listed[std::stoull(line.substr(0, space))] = line.substr(space + 1);
+    }
+    files = std::move(listed);
+    return true;
 }
 
 void
-Series::flushGroupBased()
+Series::flushGroupBased(IterationContainer::InternalContainer::iterator begin, IterationContainer::InternalContainer::iterator end)
 {
     if( !written )
     {
         Parameter< Operation::CREATE_FILE > fCreate;
         fCreate.name = m_name;
         IOHandler->enqueue(IOTask(this, fCreate));
-        IOHandler->flush();
     }
 
     if( !iterations.written )
         iterations.parent = this;
     iterations.flush(auxiliary::replace_first(basePath(), "%T/", ""));
 
-    for( auto& i : iterations )
+    for( auto it = begin; it != end; ++it )
     {
+        auto& i = *it;
+        /* unmodified iterations need not be visited */
+        if( i.second.closed() || (i.second.written && !i.second.dirtyRecursive) )
+            continue;
         if( !i.second.written )
             i.second.parent = &iterations;
         i.second.flushGroupBased(i.first);
@@ -550,11 +1523,10 @@ Series::flushMeshesPath()
     //TODO fileBased
     Parameter< Operation::WRITE_ATT > aWrite;
     aWrite.name = "meshesPath";
-    Attribute a = getAttribute("meshesPath");
+    Attribute const& a = getAttribute("meshesPath");
     aWrite.resource = a.getResource();
     aWrite.dtype = a.dtype;
-    IOHandler->enqueue(IOTask(this, aWrite));
-    IOHandler->flush();
+    IOHandler->enqueue(IOTask(this, std::move(aWrite)));
 }
 
 void
@@ -563,70 +1535,75 @@ Series::flushParticlesPath()
     //TODO fileBased
     Parameter< Operation::WRITE_ATT > aWrite;
     aWrite.name = "particlesPath";
-    Attribute a = getAttribute("particlesPath");
+    Attribute const& a = getAttribute("particlesPath");
     aWrite.resource = a.getResource();
     aWrite.dtype = a.dtype;
-    IOHandler->enqueue(IOTask(this, aWrite));
-    IOHandler->flush();
+    IOHandler->enqueue(IOTask(this, std::move(aWrite)));
 }
 
 void
 Series::readFileBased()
 {
-    std::regex pattern(auxiliary::replace_first(m_name, "%T", "[[:digit:]]+"));
-
-    Parameter< Operation::OPEN_FILE > fOpen;
-    Parameter< Operation::READ_ATT > aRead;
+    std::map< uint64_t, std::string > files;
+    listFiles(files);
 
-    using namespace boost::filesystem;
-    path dir = path(IOHandler->directory);
-    if( !exists(dir) )
-        throw no_such_file_error("Supplied directory is not valid: " + IOHandler->directory);
-    for( path const& entry : directory_iterator(dir) )
+    if( !files.empty() )
     {
-        if( std::regex_search(entry.filename().string(), pattern) )
-        {
-            fOpen.name = entry.filename().string();
-            IOHandler->enqueue(IOTask(this, fOpen));
-            IOHandler->flush();
-            iterations.parent = this;
+        /* the attributes of the Series are read from the first file */
+        Parameter< Operation::OPEN_FILE > fOpen;
+        fOpen.name = files.begin()->second;
+        IOHandler->enqueue(IOTask(this, fOpen));
+        IOHandler->flush();
+        iterations.parent = this;
 
-            /* allow all attributes to be set */
-            written = false;
+        /* allow all attributes to be set */
+        written = false;
 
-            readBase();
+        readBase();
 
-            using DT = Datatype;
-            aRead.name = "iterationEncoding";
-            IOHandler->enqueue(IOTask(this, aRead));
-            IOHandler->flush();
-            if( *aRead.dtype == DT::STRING )
+        using DT = Datatype;
+        Parameter< Operation::READ_ATT > aEncoding;
+        aEncoding.name = "iterationEncoding";
+        IOHandler->enqueue(IOTask(this, aEncoding));
+        Parameter< Operation::READ_ATT > aFormat;
+        aFormat.name = "iterationFormat";
+        IOHandler->enqueue(IOTask(this, aFormat));
+        IOHandler->flush();
+        if( *aEncoding.dtype == DT::STRING )
+        {
+            std::string encoding = Attribute(*aEncoding.resource).get< std::string >();
+            if( encoding == "fileBased" )
+                m_iterationEncoding = IterationEncoding::fileBased;
+            else if( encoding == "groupBased" )
             {
-                std::string encoding = Attribute(*aRead.resource).get< std::string >();
-                if( encoding == "fileBased" )
-                    m_iterationEncoding = IterationEncoding::fileBased;
-                else if( encoding == "groupBased" )
-                {
-                    m_iterationEncoding = IterationEncoding::groupBased;
-                    std::cerr << "Series constructor called with iteration regex '%T' suggests loading a "
-                              << "time series with fileBased iteration encoding. Loaded file is groupBased.\n";
-                } else
-                    throw std::runtime_error("Unknown iterationEncoding: " + encoding);
-                setAttribute("iterationEncoding", encoding);
-            }
-            else
-                throw std::runtime_error("Unexpected Attribute datatype for 'iterationEncoding'");
+                m_iterationEncoding = IterationEncoding::groupBased;
+                std::cerr << "Series constructor called with iteration regex '%T' suggests loading a "
+                          << "time series with fileBased iteration encoding. Loaded file is groupBased.\n";
+            } else
+                throw std::runtime_error("Unknown iterationEncoding: " + encoding);
+            setAttribute("iterationEncoding", encoding);
+        }
+        else
+            throw std::runtime_error("Unexpected Attribute datatype for 'iterationEncoding'");
 
-            aRead.name = "iterationFormat";
-            IOHandler->enqueue(IOTask(this, aRead));
-            IOHandler->flush();
-            if( *aRead.dtype == DT::STRING )
-                setIterationFormat(Attribute(*aRead.resource).get< std::string >());
-            else
-                throw std::runtime_error("Unexpected Attribute datatype for 'iterationFormat'");
+        if( *aFormat.dtype == DT::STRING )
+            setIterationFormat(Attribute(*aFormat.resource).get< std::string >());
+        else
+            throw std::runtime_error("Unexpected Attribute datatype for 'iterationFormat'");
 
-            read();
-        }
+        Parameter< Operation::OPEN_PATH > pOpen;
+        std::string version = openPMD();
+        if( version == "1.0.0" || version == "1.0.1" || version == "1.1.0" )
+            pOpen.path = auxiliary::replace_first(basePath(), "/%T/", "");
+        else
+            throw std::runtime_error("Unknown openPMD version - " + version);
+        IOHandler->enqueue(IOTask(&iterations, pOpen));
+        IOHandler->flush();
+
+        iterations.readAttributes();
+        readAttributes();
+
+        registerFiles(files);
     }
 
     /* this file need not be flushed */
@@ -634,6 +1611,45 @@ Series::readFileBased()
     written = true;
 }
 
+void
+Series::listFiles(std::map< uint64_t, std::string >& files)
+{
+    using namespace boost::filesystem;
+    path dir = path(IOHandler->directory);
+    if( !exists(dir) )
+        throw no_such_file_error("Supplied directory is not valid: " + IOHandler->directory);
+
+    /* listing and matching large directories is slow, the manifest of the writer lists the files right away */
+    if( readManifest(files) )
+        return;
+
+    std::regex pattern(auxiliary::replace_first(m_name, "%T", "([[:digit:]]+)"));
+    for( path const& entry : directory_iterator(dir) )
+    {
+        std::string filename = entry.filename().string();
+        std::smatch match;
+        if( std::regex_search(filename, match, pattern) )
+            files[std::stoull(match[1])] = filename;
+    }
+}
+
+void
+Series::registerFiles(std::map< uint64_t, std::string > const& files)
+{
+    /* iterations are only registered by the index in their file name,
+     * each file is opened and parsed on first access (see Iteration::open),
+     * the files of filtered iterations are never opened */
+    for( auto const& file : files )
+    {
+        if( !m_filter.includesIteration(file.first) || iterations.count(file.first) == 1 )
+            continue;
+        Iteration& i = iterations[file.first];
+        i.m_fileName = file.second;
+        i.m_parsed = false;
+        i.written = true;
+    }
+}
+
 void
 Series::readGroupBased()
 {
@@ -692,39 +1708,41 @@ void
 Series::readBase()
 {
     using DT = Datatype;
-    Parameter< Operation::READ_ATT > aRead;
-
-    aRead.name = "openPMD";
-    IOHandler->enqueue(IOTask(this, aRead));
+    /* the mandatory attributes are independent of each other,
+     * so they are requested in a single batch */
+    Parameter< Operation::READ_ATT > aOpenPMD;
+    aOpenPMD.name = "openPMD";
+    IOHandler->enqueue(IOTask(this, aOpenPMD));
+    Parameter< Operation::READ_ATT > aExtension;
+    aExtension.name = "openPMDextension";
+    IOHandler->enqueue(IOTask(this, aExtension));
+    Parameter< Operation::READ_ATT > aBasePath;
+    aBasePath.name = "basePath";
+    IOHandler->enqueue(IOTask(this, aBasePath));
+    Parameter< Operation::LIST_ATTS > aList;
+    IOHandler->enqueue(IOTask(this, aList));
     IOHandler->flush();
-    if( *aRead.dtype == DT::STRING )
-        setOpenPMD(Attribute(*aRead.resource).get< std::string >());
+
+    if( *aOpenPMD.dtype == DT::STRING )
+        setOpenPMD(Attribute(*aOpenPMD.resource).get< std::string >());
     else
         throw std::runtime_error("Unexpected Attribute datatype for 'openPMD'");
 
-    aRead.name = "openPMDextension";
-    IOHandler->enqueue(IOTask(this, aRead));
-    IOHandler->flush();
-    if( *aRead.dtype == DT::UINT32 )
-        setOpenPMDextension(Attribute(*aRead.resource).get< uint32_t >());
+    if( *aExtension.dtype == DT::UINT32 )
+        setOpenPMDextension(Attribute(*aExtension.resource).get< uint32_t >());
     else
         throw std::runtime_error("Unexpected Attribute datatype for 'openPMDextension'");
 
-    aRead.name = "basePath";
-    IOHandler->enqueue(IOTask(this, aRead));
-    IOHandler->flush();
-    if( *aRead.dtype == DT::STRING )
-        setAttribute("basePath", Attribute(*aRead.resource).get< std::string >());
+    if( *aBasePath.dtype == DT::STRING )
+        setAttribute("basePath", Attribute(*aBasePath.resource).get< std::string >());
     else
         throw std::runtime_error("Unexpected Attribute datatype for 'basePath'");
 
-    Parameter< Operation::LIST_ATTS > aList;
-    IOHandler->enqueue(IOTask(this, aList));
-    IOHandler->flush();
+    Parameter< Operation::READ_ATT > aRead;
     if( std::count(aList.attributes->begin(), aList.attributes->end(), "meshesPath") == 1 )
     {
         /* allow setting the meshes path after completed IO */
-        for( auto& it : iterations )
+        for( auto& it : iterations.m_container )
             it.second.meshes.written = false;
 
         aRead.name = "meshesPath";
@@ -735,14 +1753,14 @@ Series::readBase()
         else
             throw std::runtime_error("Unexpected Attribute datatype for 'meshesPath'");
 
-        for( auto& it : iterations )
+        for( auto& it : iterations.m_container )
             it.second.meshes.written = true;
     }
 
     if( std::count(aList.attributes->begin(), aList.attributes->end(), "particlesPath") == 1 )
     {
         /* allow setting the meshes path after completed IO */
-        for( auto& it : iterations )
+        for( auto& it : iterations.m_container )
             it.second.particles.written = false;
 
         aRead.name = "particlesPath";
@@ -753,7 +1771,7 @@ Series::readBase()
         else
             throw std::runtime_error("Unexpected Attribute datatype for 'particlesPath'");
 
-        for( auto& it : iterations )
+        for( auto& it : iterations.m_container )
             it.second.particles.written = true;
     }
 }
@@ -777,16 +1795,26 @@ Series::read()
     IOHandler->enqueue(IOTask(&iterations, pList));
     IOHandler->flush();
 
-    for( auto const& it : *pList.paths )
+    readIterations(*pList.paths);
+
+    readAttributes();
+}
+
+void
+Series::readIterations(std::vector< std::string > const& paths)
+{
+    Parameter< Operation::OPEN_PATH > pOpen;
+    for( auto const& it : paths )
     {
-        Iteration& i = iterations[std::stoull(it)];
+        uint64_t const index = std::stoull(it);
+        if( !m_filter.includesIteration(index) || iterations.count(index) == 1 )
+            continue;
+        Iteration& i = iterations[index];
         pOpen.path = it;
         IOHandler->enqueue(IOTask(&i, pOpen));
         IOHandler->flush();
         i.read();
     }
-
-    readAttributes();
 }
 
 std::string
@@ -801,6 +1829,12 @@ Series::cleanFilename(std::string s, Format f)
         case Format::ADIOS2:
             s = auxiliary::replace_last(s, ".bp", "");
             break;
+        case Format::ADIOS2_SST:
+            s = auxiliary::replace_last(s, ".sst", "");
+            break;
+        case Format::ADIOS2_SSC:
+            s = auxiliary::replace_last(s, ".ssc", "");
+            break;
         case Format::DUMMY:
             s = auxiliary::replace_last(s, ".dummy", "");
             break;
@@ -21,24 +21,23 @@
 #include "openPMD/backend/Attributable.hpp"
 #include "openPMD/auxiliary/StringManip.hpp"
 
+#include <algorithm>
 #include <iostream>
-#include <set>
 
 
 namespace openPMD
 {
 Attributable::Attributable()
-        : m_attributes{std::make_shared< A_MAP >()}
 { }
 
 Attributable::Attributable(Attributable const& rhs)
-// Deep-copy the entries in the Attribute map since the lifetime of the rhs does not end
+// Deep-copy the Attributes since the lifetime of the rhs does not end
         : Writable{rhs},
-          m_attributes{std::make_shared< A_MAP >(*rhs.m_attributes)}
+          m_attributes{rhs.m_attributes}
 { }
 
 Attributable::Attributable(Attributable&& rhs)
-// Take ownership of the Attribute map pointer since the lifetime of the rhs does end
+// Take over the storage of the Attributes since the lifetime of the rhs does end
         : Writable{rhs},
           m_attributes{std::move(rhs.m_attributes)}
 { }
@@ -61,12 +60,12 @@ Attributable::operator=(Attributable&& a)
     return *this;
 }
 
-Attribute
+Attribute const&
 Attributable::getAttribute(std::string const& key) const
 {
-    auto it = m_attributes->find(key);
-    if( it != m_attributes->cend() )
-        return it->second;
+    auto it = findAttribute(key);
+    if( it != m_attributes.cend() )
+        return it->value;
 
     throw no_such_attribute_error(key);
 }
@@ -77,14 +76,14 @@ Attributable::deleteAttribute(std::string const& key)
     if( AccessType::READ_ONLY == IOHandler->accessType )
         throw std::runtime_error("Can not delete an Attribute in a read-only Series.");
 
-    auto it = m_attributes->find(key);
-    if( it != m_attributes->end() )
+    auto it = lowerBound(key);
+    if( it != m_attributes.end() && it->name == key )
     {
         Parameter< Operation::DELETE_ATT > aDelete;
         aDelete.name = key;
         IOHandler->enqueue(IOTask(this, aDelete));
         IOHandler->flush();
-        m_attributes->erase(it);
+        m_attributes.erase(it);
         return true;
     }
     return false;
@@ -94,9 +93,9 @@ std::vector< std::string >
 Attributable::attributes() const
 {
     std::vector< std::string > ret;
-    ret.reserve(m_attributes->size());
-    for( auto const& entry : *m_attributes )
-        ret.emplace_back(entry.first);
+    ret.reserve(m_attributes.size());
+    for( auto const& entry : m_attributes )
+        ret.emplace_back(entry.name);
 
     return ret;
 }
@@ -104,13 +103,13 @@ Attributable::attributes() const
 size_t
 Attributable::numAttributes() const
 {
-    return m_attributes->size();
+    return m_attributes.size();
 }
 
 bool
 Attributable::containsAttribute(std::string const &key) const
 {
-    return m_attributes->find(key) != m_attributes->end();
+    return findAttribute(key) != m_attributes.end();
 }
 
 std::string
@@ -129,147 +128,94 @@ Attributable::setComment(std::string const& c)
 void
 Attributable::flushAttributes()
 {
-    if( dirty )
+    if( !written )
+        enqueueAttributes(true);
+    else if( dirty )
+        enqueueAttributes(false);
+
+    clearDirty();
+}
+
+void
+Attributable::enqueueAttributes(bool all)
+{
+    /* one task for all attributes, so backends access the object only once */
+    Parameter< Operation::WRITE_ATTS > aWrite;
+    for( auto const& att : m_attributes )
     {
-        Parameter< Operation::WRITE_ATT > aWrite;
-        for( std::string const & att_name : attributes() )
-        {
-            aWrite.name = att_name;
-            aWrite.resource = getAttribute(att_name).getResource();
-            aWrite.dtype = getAttribute(att_name).dtype;
-            IOHandler->enqueue(IOTask(this, aWrite));
-            IOHandler->flush();
-        }
-
-        dirty = false;
+        if( !all && !att.dirty )
+            continue;
+
+        Parameter< Operation::WRITE_ATT > attribute;
+        attribute.name = att.name;
+        attribute.resource = att.value.getResource();
+        attribute.dtype = att.value.dtype;
+        aWrite.attributes.push_back(std::move(attribute));
     }
+
+    if( !aWrite.attributes.empty() )
+        IOHandler->enqueue(IOTask(this, std::move(aWrite)));
+}
+
+Attributable::A_MAP::const_iterator
+Attributable::findAttribute(std::string const& key) const
+{
+    auto it = std::lower_bound(m_attributes.begin(), m_attributes.end(), key,
+                               [](AttributeEntry const& entry, std::string const& k){ return entry.name < k; });
+    if( it != m_attributes.end() && it->name == key )
+        return it;
+    return m_attributes.end();
+}
+
+std::string
+Attributable::childName(Writable const*) const
+{
+    return std::string();
+}
+
+void
+Attributable::clearDirty()
+{
+    for( auto& att : m_attributes )
+        att.dirty = false;
+    dirty = false;
 }
 
 void
 Attributable::readAttributes()
 {
-    Parameter< Operation::LIST_ATTS > aList;
-    IOHandler->enqueue(IOTask(this, aList));
+    Parameter< Operation::READ_ATTS > aRead;
+    IOHandler->enqueue(IOTask(this, aRead));
     IOHandler->flush();
-    std::vector< std::string > written_attributes = attributes();
-
-    /* std::set_difference requires sorted ranges */
-    std::sort(aList.attributes->begin(), aList.attributes->end());
-    std::sort(written_attributes.begin(), written_attributes.end());
 
-    std::set< std::string > attributes;
-    std::set_difference(aList.attributes->begin(), aList.attributes->end(),
-                        written_attributes.begin(), written_attributes.end(),
-                        std::inserter(attributes, attributes.begin()));
+    for( auto const& skipped : *aRead.skipped )
+        std::cerr << "Skipping non-standard attribute "
+                  << auxiliary::strip(skipped.first, {'\0'}) << " ("
+                  << skipped.second
+                  << ")\n";
 
     using DT = Datatype;
-    Parameter< Operation::READ_ATT > aRead;
 
-    for( auto const& att_name : attributes )
+    for( auto& read : *aRead.attributes )
     {
-        aRead.name = att_name;
-        std::string att = auxiliary::strip(att_name, {'\0'});
-        IOHandler->enqueue(IOTask(this, aRead));
-        try
-        {
-            IOHandler->flush();
-        } catch( unsupported_data_error e )
-        {
-            std::cerr << "Skipping non-standard attribute "
-                      << att << " ("
-                      << e.what()
-                      << ")\n";
+        std::string att = auxiliary::strip(read.first, {'\0'});
+        /* attributes already present in memory take precedence */
+        if( containsAttribute(read.first) )
             continue;
-        }
-        Attribute a(*aRead.resource);
-        switch( *aRead.dtype )
-        {
-            case DT::CHAR:
-                setAttribute(att, a.get< char >());
-                break;
-            case DT::UCHAR:
-                setAttribute(att, a.get< unsigned char >());
-                break;
-            case DT::INT16:
-                setAttribute(att, a.get< int16_t >());
-                break;
-            case DT::INT32:
-                setAttribute(att, a.get< int32_t >());
-                break;
-            case DT::INT64:
-                setAttribute(att, a.get< int64_t >());
-                break;
-            case DT::UINT16:
-                setAttribute(att, a.get< uint16_t >());
-                break;
-            case DT::UINT32:
-                setAttribute(att, a.get< uint32_t >());
-                break;
-            case DT::UINT64:
-                setAttribute(att, a.get< uint64_t >());
-                break;
-            case DT::FLOAT:
-                setAttribute(att, a.get< float >());
-                break;
-            case DT::DOUBLE:
-                setAttribute(att, a.get< double >());
-                break;
-            case DT::LONG_DOUBLE:
-                setAttribute(att, a.get< long double >());
-                break;
-            case DT::STRING:
-                setAttribute(att, a.get< std::string >());
-                break;
-            case DT::VEC_CHAR:
-                setAttribute(att, a.get< std::vector< char > >());
-                break;
-            case DT::VEC_INT16:
-                setAttribute(att, a.get< std::vector< int16_t > >());
-                break;
-            case DT::VEC_INT32:
-                setAttribute(att, a.get< std::vector< int32_t > >());
-                break;
-            case DT::VEC_INT64:
-                setAttribute(att, a.get< std::vector< int64_t > >());
-                break;
-            case DT::VEC_UCHAR:
-                setAttribute(att, a.get< std::vector< unsigned char > >());
-                break;
-            case DT::VEC_UINT16:
-                setAttribute(att, a.get< std::vector< uint16_t > >());
-                break;
-            case DT::VEC_UINT32:
-                setAttribute(att, a.get< std::vector< uint32_t > >());
-                break;
-            case DT::VEC_UINT64:
-                setAttribute(att, a.get< std::vector< uint64_t > >());
-                break;
-            case DT::VEC_FLOAT:
-                setAttribute(att, a.get< std::vector< float > >());
-                break;
-            case DT::VEC_DOUBLE:
-                setAttribute(att, a.get< std::vector< double > >());
-                break;
-            case DT::VEC_LONG_DOUBLE:
-                setAttribute(att, a.get< std::vector< long double > >());
-                break;
-            case DT::VEC_STRING:
-                setAttribute(att, a.get< std::vector< std::string > >());
-                break;
-            case DT::ARR_DBL_7:
-                setAttribute(att, a.get< std::array< double, 7 > >());
-                break;
-            case DT::BOOL:
-                setAttribute(att, a.get< bool >());
-                break;
-            case DT::DATATYPE:
-            case DT::UNDEFINED:
-                throw std::runtime_error("Invalid Attribute datatype during read");
-        }
+
+        if( read.second.dtype == DT::DATATYPE || read.second.dtype == DT::UNDEFINED )
+            throw std::runtime_error("Invalid Attribute datatype during read");
+
+        /* the read values are not needed anymore, so take them over instead of copying */
+        auto it = lowerBound(att);
+        if( it != m_attributes.end() && it->name == att )
+            it->value = std::move(read.second);
+        else
+            m_attributes.insert(it, AttributeEntry{std::move(att), std::move(read.second), false});
     }
 
     IOHandler->flush();
-    dirty = false;
+    clearDirty();
 }
 
 void warnWrongDtype(std::string const& key,
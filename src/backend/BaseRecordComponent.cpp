@@ -29,4 +29,10 @@ BaseRecordComponent::getDatatype()
 {
     return m_dataset.dtype;
 }
+
+bool
+BaseRecordComponent::constant() const
+{
+    return m_isConstant;
+}
 } // openPMD
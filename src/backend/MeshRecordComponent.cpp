@@ -28,6 +28,12 @@ MeshRecordComponent::read()
         setPosition(a.get< std::vector< double > >());
     else if( *aRead.dtype == DT::VEC_LONG_DOUBLE )
         setPosition(a.get< std::vector< long double > >());
+    else if( *aRead.dtype == DT::FLOAT )
+        setPosition(std::vector< float >({a.get< float >()}));
+    else if( *aRead.dtype == DT::DOUBLE )
+        setPosition(std::vector< double >({a.get< double >()}));
+    else if( *aRead.dtype == DT::LONG_DOUBLE )
+        setPosition(std::vector< long double >({a.get< long double >()}));
     else
         throw std::runtime_error( "Unexpected Attribute datatype for 'position'");
 
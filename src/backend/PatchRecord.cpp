@@ -1,4 +1,3 @@
-#include "openPMD/auxiliary/Memory.hpp"
 #include "openPMD/backend/PatchRecord.hpp"
 
 
@@ -23,7 +22,23 @@ PatchRecord::PatchRecord()
 void
 PatchRecord::flush(std::string const& path)
 {
-    Container< PatchRecordComponent >::flush(path);
+    if( m_containsScalar )
+    {
+        /* numParticles and numParticlesOffset are datasets directly inside particlePatches */
+        PatchRecordComponent& r = at(RecordComponent::SCALAR);
+        if( !written )
+        {
+            r.parent = parent;
+            r.flush(path);
+            IOHandler->flush();
+            abstractFilePosition = r.abstractFilePosition;
+            written = true;
+        } else
+            r.flush(path);
+        return;
+    }
+
+    BaseRecordContainer< PatchRecordComponent >::flush(path);
 
     for( auto& comp : *this )
         comp.second.flush(comp.first);
@@ -45,15 +60,33 @@ PatchRecord::read()
         IOHandler->enqueue(IOTask(&prc, dOpen));
         IOHandler->flush();
 
-        dRead.dtype = *dOpen.dtype;
+        dRead.dtype = Datatype::DOUBLE;
         dRead.extent = *dOpen.extent;
         dRead.offset = {0};
 
-        size_t numPoints = dRead.extent[0];
-        auto data = auxiliary::allocatePtr(dRead.dtype, numPoints);
-        dRead.data = data.get();
+        prc.m_values.resize(dRead.extent[0]);
+        dRead.data = prc.m_values.data();
         IOHandler->enqueue(IOTask(&prc, dRead));
         IOHandler->flush();
+
     }
+
+    /* allow all attributes to be set */
+    written = false;
+
+    /* unlike BaseRecord::readBase, do not require a timeOffset */
+    Parameter< Operation::READ_ATT > aRead;
+    aRead.name = "unitDimension";
+    IOHandler->enqueue(IOTask(this, aRead));
+    IOHandler->flush();
+    if( *aRead.dtype == Datatype::ARR_DBL_7 )
+        setAttribute("unitDimension", Attribute(*aRead.resource).get< std::array< double, 7 > >());
+    else
+        throw std::runtime_error("Unexpected Attribute datatype for 'unitDimension'");
+
+    readAttributes();
+
+    /* this file need not be flushed */
+    written = true;
 }
 } // openPMD
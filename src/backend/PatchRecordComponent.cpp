@@ -28,13 +28,29 @@ PatchRecordComponent::flush(std::string const& name)
     {
         Parameter< Operation::CREATE_DATASET > dCreate;
         dCreate.name = name;
-        dCreate.extent = {1};
+        if( m_dataset.extent.empty() )
+        {
+            dCreate.extent = {1};
+            dCreate.chunkSize = {1};
+        } else
+        {
+            dCreate.extent = m_dataset.extent;
+            dCreate.chunkSize = m_dataset.chunkSize;
+        }
         dCreate.dtype = getDatatype();
-        dCreate.chunkSize = {1};
         dCreate.compression = m_dataset.compression;
         dCreate.transform = m_dataset.transform;
+        dCreate.allocation = m_dataset.allocation;
+        dCreate.fixedSize = m_dataset.fixedSize;
         IOHandler->enqueue(IOTask(this, dCreate));
     }
-    IOHandler->flush();
+
+    while( !m_chunks.empty() )
+    {
+        IOHandler->enqueue(m_chunks.front());
+        m_chunks.pop();
+    }
+
+    flushAttributes();
 }
 } // openPMD
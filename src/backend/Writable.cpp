@@ -9,9 +9,22 @@ Writable::Writable()
           parent{nullptr},
           IOHandler{nullptr},
           dirty{true},
+          dirtyRecursive{true},
           written{false}
 { }
 
 Writable::~Writable()
 { }
+
+void
+Writable::setDirty()
+{
+    dirty = true;
+    /* objects are flagged before they are linked into the hierarchy,
+     * so ancestors are always visited instead of stopping at the first flagged one;
+     * flagged ancestors are not written again, iterations may be parsed concurrently */
+    for( Writable* w = this; w; w = w->parent )
+        if( !w->dirtyRecursive )
+            w->dirtyRecursive = true;
+}
 } // openPMD
@@ -0,0 +1,48 @@
+/* Copyright 2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/Dataset.hpp"
+#include "openPMD/binding/python/Numpy.hpp"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+using namespace openPMD;
+
+
+void init_Dataset(py::module& m)
+{
+    py::class_< Dataset >(m, "Dataset")
+        .def(py::init< Datatype, Extent >(), py::arg("dtype"), py::arg("extent"))
+        .def(py::init([](py::dtype const& dt, Extent const& extent)
+                      { return Dataset(python::toDatatype(dt), extent); }),
+             py::arg("dtype"), py::arg("extent"))
+        .def_readonly("extent", &Dataset::extent)
+        .def_readonly("rank", &Dataset::rank)
+        .def_property_readonly("dtype", [](Dataset const& d){ return python::toDtype(d.dtype); })
+        .def("set_chunk_size", &Dataset::setChunkSize)
+        .def("set_compression", &Dataset::setCompression)
+        .def("__repr__",
+             [](Dataset const& d)
+             {
+                 return "<openPMD.Dataset of rank " + std::to_string(d.rank) + ">";
+             });
+}
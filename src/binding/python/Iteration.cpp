@@ -0,0 +1,72 @@
+/* Copyright 2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/Iteration.hpp"
+#include "openPMD/binding/python/Container.hpp"
+#include "openPMD/binding/python/ReleaseQueue.hpp"
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+using namespace openPMD;
+
+
+namespace
+{
+/** Run an operation that writes chunks without the GIL, then drop the arrays it has released. */
+Iteration&
+withoutGIL(Iteration& i, Iteration& (Iteration::*operation)())
+{
+    {
+        py::gil_scoped_release release;
+        (i.*operation)();
+    }
+    python::ReleaseQueue::instance().drain();
+    return i;
+}
+} // namespace
+
+void init_Iteration(py::module& m)
+{
+    py::class_< Container< Mesh > > meshes(m, "Mesh_Container");
+    python::addContainerMethods< Container< Mesh > >(meshes);
+    py::class_< Container< ParticleSpecies > > particles(m, "Particle_Container");
+    python::addContainerMethods< Container< ParticleSpecies > >(particles);
+
+    py::class_< Iteration >(m, "Iteration")
+        .def_property("time", &Iteration::time< double >,
+                      [](Iteration& i, double time){ i.setTime(time); })
+        .def_property("dt", &Iteration::dt< double >,
+                      [](Iteration& i, double dt){ i.setDt(dt); })
+        .def_property("time_unit_SI", &Iteration::timeUnitSI,
+                      [](Iteration& i, double timeUnitSI){ i.setTimeUnitSI(timeUnitSI); })
+        .def_property_readonly("meshes",
+                               [](Iteration& i) -> Container< Mesh >& { return i.meshes; },
+                               py::return_value_policy::reference_internal)
+        .def_property_readonly("particles",
+                               [](Iteration& i) -> Container< ParticleSpecies >& { return i.particles; },
+                               py::return_value_policy::reference_internal)
+        .def_property_readonly("closed", &Iteration::closed)
+        .def("open", &Iteration::open, py::return_value_policy::reference)
+        .def("close", [](Iteration& i) -> Iteration& { return withoutGIL(i, &Iteration::close); },
+             py::return_value_policy::reference)
+        .def("flush", [](Iteration& i) -> Iteration& { return withoutGIL(i, &Iteration::flush); },
+             py::return_value_policy::reference);
+}
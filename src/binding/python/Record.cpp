@@ -0,0 +1,54 @@
+/* Copyright 2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/Mesh.hpp"
+#include "openPMD/ParticleSpecies.hpp"
+#include "openPMD/Record.hpp"
+#include "openPMD/binding/python/Container.hpp"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+using namespace openPMD;
+
+
+void init_Record(py::module& m)
+{
+    py::class_< Mesh > mesh(m, "Mesh");
+    python::addContainerMethods< Mesh >(mesh)
+        .def_property("axis_labels", &Mesh::axisLabels,
+                      [](Mesh& mesh, std::vector< std::string > labels){ mesh.setAxisLabels(labels); })
+        .def_property("grid_spacing", &Mesh::gridSpacing< double >,
+                      [](Mesh& mesh, std::vector< double > spacing){ mesh.setGridSpacing(spacing); })
+        .def_property("grid_global_offset", &Mesh::gridGlobalOffset,
+                      [](Mesh& mesh, std::vector< double > offset){ mesh.setGridGlobalOffset(offset); })
+        .def_property("grid_unit_SI", &Mesh::gridUnitSI,
+                      [](Mesh& mesh, double unitSI){ mesh.setGridUnitSI(unitSI); });
+
+    py::class_< Record > record(m, "Record");
+    python::addContainerMethods< Record >(record);
+
+    py::class_< ParticleSpecies > species(m, "Particle_Species");
+    python::addContainerMethods< ParticleSpecies >(species);
+}
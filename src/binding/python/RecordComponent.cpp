@@ -0,0 +1,205 @@
+/* Copyright 2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/RecordComponent.hpp"
+#include "openPMD/backend/MeshRecordComponent.hpp"
+#include "openPMD/binding/python/Numpy.hpp"
+#include "openPMD/binding/python/ReleaseQueue.hpp"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+using namespace openPMD;
+
+
+namespace
+{
+/** Wrap a buffer allocated by the API in a numpy array sharing its ownership, without copying it. */
+template< typename T >
+py::array
+wrap(std::shared_ptr< T > data, std::vector< py::ssize_t > const& shape)
+{
+    auto owner = new std::shared_ptr< T >(std::move(data));
+    py::capsule base(owner, [](void* o){ delete static_cast< std::shared_ptr< T >* >(o); });
+    return py::array_t< T >(shape, owner->get(), base);
+}
+
+struct StoreChunk
+{
+    RecordComponent& rc;
+    py::array const& a;
+    Offset const& offset;
+    Extent const& extent;
+
+    template< typename T >
+    void call()
+    {
+        /* the array stays referenced until the chunk has been written,
+         * the reference is dropped by a thread holding the GIL (see ReleaseQueue) */
+        auto owner = new py::object(a);
+        std::shared_ptr< T > data(static_cast< T* >(const_cast< void* >(a.data())),
+                                  [owner](T*){ python::ReleaseQueue::instance().push(owner); });
+        rc.storeChunk(offset, extent, std::move(data));
+    }
+};
+
+struct LoadChunk
+{
+    RecordComponent& rc;
+    Offset const& offset;
+    Extent const& extent;
+    Extent const& stride;
+    std::vector< py::ssize_t > const& shape;
+    py::array result;
+
+    template< typename T >
+    void call()
+    {
+        /* read into a buffer of the API (pooled if the Series has a BufferPool), filled on the next flush */
+        std::shared_ptr< T > data = stride.empty()
+                                    ? rc.loadChunk< T >(offset, extent)
+                                    : rc.loadStridedChunk< T >(offset, extent, stride);
+        result = wrap(std::move(data), shape);
+    }
+};
+
+void
+storeChunk(RecordComponent& rc, py::array const& a, Offset offset)
+{
+    python::ReleaseQueue::instance().drain();
+    if( !(a.flags() & py::array::c_style) )
+        throw std::runtime_error("Only C-contiguous arrays can be stored without copying, "
+                                 "use numpy.ascontiguousarray to store a strided view");
+    Datatype const dtype = python::toDatatype(a.dtype());
+    Extent extent(a.shape(), a.shape() + a.ndim());
+    if( offset.empty() )
+        offset = Offset(extent.size(), 0u);
+
+    StoreChunk action{rc, a, offset, extent};
+    python::switchArrayType(dtype, action);
+}
+
+py::array
+loadChunk(RecordComponent& rc, Offset offset, Extent extent)
+{
+    Extent const dse = rc.getExtent();
+    if( offset.empty() )
+        offset = Offset(dse.size(), 0u);
+    if( extent.empty() )
+        for( size_t i = 0; i < dse.size() && i < offset.size(); ++i )
+            extent.push_back(dse[i] - offset[i]);
+
+    std::vector< py::ssize_t > shape(extent.begin(), extent.end());
+    Extent const stride;
+    LoadChunk action{rc, offset, extent, stride, shape, py::array()};
+    python::switchArrayType(rc.getDatatype(), action);
+    return action.result;
+}
+
+/** Read the selection of a numpy-style index, e.g. rc[::4, 10:20], reading only the selected elements.
+ *
+ * Slices with steps are read with RecordComponent::loadStridedChunk, integers drop their dimension.
+ */
+py::array
+loadSelection(RecordComponent& rc, py::object const& index)
+{
+    py::tuple selection = py::isinstance< py::tuple >(index) ? py::tuple(index) : py::make_tuple(index);
+    Extent const dse = rc.getExtent();
+    if( selection.size() > dse.size() )
+        throw py::index_error("Too many indices for a component of rank " + std::to_string(dse.size()));
+
+    Offset offset;
+    Extent extent;
+    Extent stride;
+    std::vector< py::ssize_t > shape;
+    bool strided = false;
+    for( size_t i = 0; i < dse.size(); ++i )
+    {
+        size_t start = 0, stop = dse[i], step = 1, length = dse[i];
+        py::object item = i < selection.size() ? py::object(selection[i]) : py::none();
+        if( py::isinstance< py::slice >(item) )
+        {
+            if( !py::slice(item).compute(dse[i], &start, &stop, &step, &length) )
+                throw py::error_already_set();
+            if( static_cast< py::ssize_t >(step) <= 0 )
+                throw py::index_error("Only positive slice steps are supported");
+            shape.push_back(static_cast< py::ssize_t >(length));
+        } else if( !item.is_none() )
+        {
+            auto position = item.cast< py::ssize_t >();
+            if( position < 0 )
+                position += static_cast< py::ssize_t >(dse[i]);
+            if( position < 0 || static_cast< uint64_t >(position) >= dse[i] )
+                throw py::index_error("Index " + std::to_string(position) + " is out of bounds for dimension " + std::to_string(i));
+            start = static_cast< size_t >(position);
+            length = 1;
+        } else
+            shape.push_back(static_cast< py::ssize_t >(length));
+
+        offset.push_back(start);
+        /* the selected blocks span from the first to the last selected element */
+        extent.push_back(length == 0 ? 0 : (length - 1) * step + 1);
+        stride.push_back(step);
+        strided = strided || step != 1;
+    }
+    if( !strided )
+        stride.clear();
+
+    LoadChunk action{rc, offset, extent, stride, shape, py::array()};
+    python::switchArrayType(rc.getDatatype(), action);
+    return action.result;
+}
+} // namespace
+
+void init_RecordComponent(py::module& m)
+{
+    py::class_< RecordComponent > rc(m, "Record_Component");
+    rc.attr("SCALAR") = py::str(RecordComponent::SCALAR);
+    rc
+        .def_property("unit_SI", &RecordComponent::unitSI,
+                      [](RecordComponent& c, double unitSI){ c.setUnitSI(unitSI); })
+        .def_property_readonly("shape", &RecordComponent::getExtent)
+        .def_property_readonly("ndim", [](RecordComponent& c){ return static_cast< int >(c.getDimensionality()); })
+        .def_property_readonly("dtype", [](RecordComponent& c){ return python::toDtype(c.getDatatype()); })
+        .def("reset_dataset",
+             [](RecordComponent& c, Dataset const& d){ c.resetDataset(d); },
+             py::arg("dataset"))
+
+        .def("store_chunk", &storeChunk,
+             "Register a C-contiguous array to be written at offset (the origin by default) on the next flush.\n"
+             "The array is referenced, not copied, and must not be modified until it has been written.",
+             py::arg("array"), py::arg("offset") = Offset())
+        .def("load_chunk", &loadChunk,
+             "Register a read of a chunk (the whole dataset by default) into a new array, filled on the next flush.",
+             py::arg("offset") = Offset(), py::arg("extent") = Extent())
+        .def("__getitem__", &loadSelection,
+             "Register a read of a numpy-style selection into a new array, filled on the next flush.");
+
+    py::class_< MeshRecordComponent, RecordComponent >(m, "Mesh_Record_Component")
+        .def_property("position", &MeshRecordComponent::position< double >,
+                      [](MeshRecordComponent& c, std::vector< double > position){ c.setPosition(position); });
+}
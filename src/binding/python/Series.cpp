@@ -0,0 +1,112 @@
+/* Copyright 2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/Series.hpp"
+#include "openPMD/binding/python/Container.hpp"
+#include "openPMD/binding/python/ReleaseQueue.hpp"
+
+#include <pybind11/pybind11.h>
+
+#include <memory>
+#include <string>
+
+namespace py = pybind11;
+using namespace openPMD;
+
+
+namespace
+{
+/** Destroy a Series without the GIL, as it may wait for its IO threads, then drop the arrays it has released. */
+struct DeleteSeries
+{
+    void operator()(Series* s) const
+    {
+        {
+            py::gil_scoped_release release;
+            delete s;
+        }
+        python::ReleaseQueue::instance().drain();
+    }
+};
+using SeriesHolder = std::unique_ptr< Series, DeleteSeries >;
+
+/* the objects of a Series refer to its address, so it is constructed in place and never copied */
+SeriesHolder
+createSeries(std::string const& filepath, AccessType at)
+{
+    return SeriesHolder(new Series(Series::create(filepath, at)));
+}
+
+SeriesHolder
+readSeries(std::string const& filepath, AccessType at)
+{
+    return SeriesHolder(new Series(Series::read(filepath, at)));
+}
+
+void
+flushSeries(Series& s)
+{
+    {
+        py::gil_scoped_release release;
+        s.flush();
+    }
+    python::ReleaseQueue::instance().drain();
+}
+} // namespace
+
+void init_Series(py::module& m)
+{
+    py::class_< IterationContainer > iterations(m, "Iteration_Container");
+    python::addContainerMethods< IterationContainer >(iterations);
+
+    py::class_< Series, SeriesHolder >(m, "Series")
+        .def_static("create", &createSeries,
+                    py::arg("filepath"), py::arg("access_type") = AccessType::CREATE)
+        .def_static("read", &readSeries,
+                    py::arg("filepath"), py::arg("access_type") = AccessType::READ_ONLY)
+
+        .def_property("author", &Series::author,
+                      [](Series& s, std::string const& value){ s.setAuthor(value); })
+        .def_property("software", &Series::software,
+                      [](Series& s, std::string const& value){ s.setSoftware(value); })
+        .def_property("software_version", &Series::softwareVersion,
+                      [](Series& s, std::string const& value){ s.setSoftwareVersion(value); })
+        .def_property("date", &Series::date,
+                      [](Series& s, std::string const& value){ s.setDate(value); })
+        .def_property("machine", &Series::machine,
+                      [](Series& s, std::string const& value){ s.setMachine(value); })
+        .def_property("iteration_encoding", &Series::iterationEncoding,
+                      [](Series& s, IterationEncoding value){ s.setIterationEncoding(value); })
+        .def_property("iteration_format", &Series::iterationFormat,
+                      [](Series& s, std::string const& value){ s.setIterationFormat(value); })
+        .def_property("name", &Series::name,
+                      [](Series& s, std::string const& value){ s.setName(value); })
+        .def_property_readonly("openPMD", &Series::openPMD)
+
+        .def_property_readonly("iterations",
+                               [](Series& s) -> IterationContainer& { return s.iterations; },
+                               py::return_value_policy::reference_internal)
+
+        .def("flush", &flushSeries)
+        .def("open_iterations",
+             [](Series& s, unsigned int workers){ s.openIterations(workers); },
+             py::arg("workers") = 0u,
+             py::call_guard< py::gil_scoped_release >());
+}
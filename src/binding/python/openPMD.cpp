@@ -0,0 +1,74 @@
+/* Copyright 2018 Fabian Koller
+ *
+ * This file is part of openPMD-api.
+ *
+ * openPMD-api is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * openPMD-api is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with openPMD-api.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "openPMD/openPMD.hpp"
+#include "openPMD/binding/python/ReleaseQueue.hpp"
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+using namespace openPMD;
+
+
+void init_Dataset(py::module&);
+void init_Series(py::module&);
+void init_Iteration(py::module&);
+void init_Record(py::module&);
+void init_RecordComponent(py::module&);
+
+PYBIND11_MODULE(openPMD, m)
+{
+    m.doc() = "Python bindings of openPMD-api, exchanging chunks with numpy arrays without copying";
+
+    py::enum_< AccessType >(m, "Access_Type")
+        .value("read_only", AccessType::READ_ONLY)
+        .value("read_write", AccessType::READ_WRITE)
+        .value("create", AccessType::CREATE);
+
+    py::enum_< IterationEncoding >(m, "Iteration_Encoding")
+        .value("file_based", IterationEncoding::fileBased)
+        .value("group_based", IterationEncoding::groupBased);
+
+    py::enum_< Datatype >(m, "Datatype")
+        .value("CHAR", Datatype::CHAR)
+        .value("UCHAR", Datatype::UCHAR)
+        .value("INT16", Datatype::INT16)
+        .value("INT32", Datatype::INT32)
+        .value("INT64", Datatype::INT64)
+        .value("UINT16", Datatype::UINT16)
+        .value("UINT32", Datatype::UINT32)
+        .value("UINT64", Datatype::UINT64)
+        .value("FLOAT", Datatype::FLOAT)
+        .value("DOUBLE", Datatype::DOUBLE)
+        .value("LONG_DOUBLE", Datatype::LONG_DOUBLE)
+        .value("BOOL", Datatype::BOOL)
+        .value("UNDEFINED", Datatype::UNDEFINED);
+
+    /* referenced by the signatures of the classes below */
+    init_Dataset(m);
+    init_RecordComponent(m);
+    init_Record(m);
+    init_Iteration(m);
+    init_Series(m);
+
+    /* arrays released after the last call into the module */
+    py::module::import("atexit").attr("register")(
+        py::cpp_function([](){ python::ReleaseQueue::instance().drain(); }));
+}
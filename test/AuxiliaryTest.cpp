@@ -2,8 +2,14 @@
 
 /* make Writable::parent visible for hierarchy check */
 #define protected public
+#include "openPMD/auxiliary/BufferPool.hpp"
+#include "openPMD/auxiliary/Checksum.hpp"
+#include "openPMD/auxiliary/FlatMap.hpp"
+#include "openPMD/auxiliary/Memory.hpp"
+#include "openPMD/auxiliary/Serialization.hpp"
 #include "openPMD/auxiliary/StringManip.hpp"
 #include "openPMD/auxiliary/Variadic.hpp"
+#include "openPMD/backend/Attribute.hpp"
 #include "openPMD/backend/Container.hpp"
 #include "openPMD/backend/Writable.hpp"
 #include "openPMD/IO/AbstractIOHandler.hpp"
@@ -13,6 +19,12 @@ using namespace openPMD;
 
 #include <boost/test/included/unit_test.hpp>
 
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
 
 BOOST_AUTO_TEST_CASE(string_test)
 {
@@ -54,6 +66,114 @@ BOOST_AUTO_TEST_CASE(string_test)
     BOOST_TEST(expected3 == split("/path/to/relevant/data/", "/"));
 }
 
+BOOST_AUTO_TEST_CASE(buffer_pool_test)
+{
+    using namespace auxiliary;
+
+    BufferPool pool(256, 1024);
+    void* first;
+    {
+        auto b = pool.allocate(100);
+        first = b.get();
+        BOOST_TEST(reinterpret_cast< std::uintptr_t >(b.get()) % 256 == 0);
+        BOOST_TEST(pool.cachedBytes() == 0);
+    }
+    BOOST_TEST(pool.cachedBytes() == 256);
+
+    /* same size class is re-used */
+    {
+        auto b = pool.allocate(200);
+        BOOST_TEST(b.get() == first);
+        BOOST_TEST(pool.cachedBytes() == 0);
+    }
+
+    /* released buffers beyond the limit are freed */
+    {
+        auto b = pool.allocate(2048);
+        BOOST_TEST(reinterpret_cast< std::uintptr_t >(b.get()) % 256 == 0);
+    }
+    BOOST_TEST(pool.cachedBytes() == 256);
+
+    /* buffers outlive the pool */
+    std::unique_ptr< void, std::function< void(void*) > > survivor;
+    {
+        BufferPool temporary;
+        survivor = temporary.allocate(8);
+    }
+    static_cast< char* >(survivor.get())[7] = 'a';
+    survivor.reset();
+
+    pool.trim();
+    BOOST_TEST(pool.cachedBytes() == 0);
+
+    BOOST_CHECK_THROW(BufferPool(3), std::runtime_error);
+
+    /* custom allocator, e.g. for page-locked memory */
+    std::size_t allocated = 0, released = 0;
+    {
+        BufferPool custom([&allocated](std::size_t bytes){ ++allocated; return ::operator new(bytes); },
+                          [&released](void* p){ ++released; ::operator delete(p); },
+                          1024);
+        custom.allocate(100);
+        custom.allocate(100);
+        BOOST_TEST(allocated == 1);
+        BOOST_TEST(custom.cachedBytes() == 128);
+        custom.allocate(4096);
+        BOOST_TEST(released == 1);
+    }
+    BOOST_TEST(allocated == 2);
+    BOOST_TEST(released == 2);
+    BOOST_CHECK_THROW(BufferPool(nullptr, [](void*){}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(checksum_test)
+{
+    using namespace auxiliary;
+
+    std::string const check = "123456789";
+    BOOST_TEST(crc32c(check.data(), check.size()) == 0xE3069283u);
+    BOOST_TEST(auxiliary::detail::crc32cSoftware(~0u, reinterpret_cast< unsigned char const* >(check.data()), check.size()) == ~0xE3069283u);
+    BOOST_TEST(crc32c(check.data() + 4, 5, crc32c(check.data(), 4)) == 0xE3069283u);
+
+    std::vector< unsigned char > data(100003);
+    for( std::size_t i = 0; i < data.size(); ++i )
+        data[i] = static_cast< unsigned char >(i * 7919u >> 3);
+    uint32_t const whole = crc32c(data.data(), data.size());
+    BOOST_TEST(crc32cCombine(crc32c(data.data(), 777), crc32c(data.data() + 777, data.size() - 777), data.size() - 777) == whole);
+    BOOST_TEST(crc32cParallel(data.data(), data.size(), 4, 1000) == whole);
+    BOOST_TEST(crc32cParallel(data.data(), data.size()) == whole);
+}
+
+BOOST_AUTO_TEST_CASE(transpose_test)
+{
+    using namespace auxiliary;
+
+    /* larger than a tile in the first and last dimension */
+    Extent const e{19, 3, 37};
+    std::vector< double > src(19 * 3 * 37);
+    for( std::size_t i = 0; i < src.size(); ++i )
+        src[i] = static_cast< double >(i);
+    std::vector< double > dest(src.size());
+    transpose(dest.data(), src.data(), sizeof(double), e);
+    for( std::size_t i = 0; i < e[0]; ++i )
+        for( std::size_t j = 0; j < e[1]; ++j )
+            for( std::size_t k = 0; k < e[2]; ++k )
+                BOOST_TEST(dest[(k * e[1] + j) * e[0] + i] == src[(i * e[1] + j) * e[2] + k]);
+
+    /* transposing twice with the reversed shape restores the buffer */
+    std::vector< double > back(src.size());
+    transpose(back.data(), dest.data(), sizeof(double), Extent{37, 3, 19});
+    BOOST_TEST(back == src);
+
+    /* element sizes without a dedicated kernel */
+    struct Triple { char c[3]; };
+    std::vector< Triple > t{{{'a', 'b', 'c'}}, {{'d', 'e', 'f'}}, {{'g', 'h', 'i'}}, {{'j', 'k', 'l'}}, {{'m', 'n', 'o'}}, {{'p', 'q', 'r'}}};
+    std::vector< Triple > tt(t.size());
+    transpose(tt.data(), t.data(), sizeof(Triple), Extent{2, 3});
+    BOOST_TEST(tt[1].c[0] == 'j');
+    BOOST_TEST(tt[2].c[2] == 'f');
+}
+
 BOOST_AUTO_TEST_CASE(container_default_test)
 {
     struct S : public Writable
@@ -161,6 +281,42 @@ BOOST_AUTO_TEST_CASE(container_access_test)
     BOOST_TEST(c.size() == 0);
 }
 
+BOOST_AUTO_TEST_CASE(container_flatmap_test)
+{
+    using FlatContainer = Container< Widget, uint64_t, auxiliary::FlatMap< uint64_t, Widget > >;
+    FlatContainer c = FlatContainer();
+    c.IOHandler = AbstractIOHandler::createIOHandler("", AccessType::CREATE, Format::DUMMY);
+
+    Widget& w = c[100];
+    for( uint64_t i : {50, 300, 200, 0, 400} )
+        c[i] = Widget(0);
+    BOOST_TEST(c.size() == 6);
+    /* references survive insertions in front of them */
+    BOOST_TEST(&w == &c[100]);
+    BOOST_TEST(w.parent == &c);
+
+    std::vector< uint64_t > keys;
+    for( auto const& e : c )
+        keys.push_back(e.first);
+    BOOST_TEST((keys == std::vector< uint64_t >{0, 50, 100, 200, 300, 400}));
+
+    BOOST_TEST(c.count(200) == 1);
+    BOOST_TEST(c.count(250) == 0);
+    BOOST_TEST((c.find(250) == c.end()));
+    BOOST_TEST(c.find(300)->first == 300);
+    BOOST_CHECK_THROW(c.at(250), std::out_of_range);
+
+    BOOST_TEST(c.erase(50) == true);
+    BOOST_TEST(c.erase(50) == false);
+    BOOST_TEST(&w == &c.at(100));
+    BOOST_TEST(c.begin()->first == 0);
+    BOOST_TEST(std::next(c.begin())->first == 100);
+
+    FlatContainer copy = c;
+    BOOST_TEST(copy.size() == 5);
+    BOOST_TEST(&copy.at(100) != &w);
+}
+
 BOOST_AUTO_TEST_CASE(attributable_default_test)
 {
     Attributable a = Attributable();
@@ -198,6 +354,13 @@ BOOST_AUTO_TEST_CASE(attributable_access_test)
     a.setAttribute("array", arr);
     BOOST_TEST(a.numAttributes() == 2);
     BOOST_TEST(variadicSrc::get< array_t >(a.get("array")) == arr);
+
+    Attribute const& ref = a.getAttribute("key");
+    BOOST_TEST(&ref == &a.getAttribute("key"));
+    BOOST_TEST(&ref.get< std::string >() == &a.getAttribute("key").get< std::string >());
+    Attribute moved(std::string("moved"));
+    BOOST_TEST(std::move(moved).get< std::string >() == "moved");
+
     BOOST_TEST(a.deleteAttribute("nonExistentKey") == false);
     BOOST_TEST(a.numAttributes() == 2);
     BOOST_TEST(a.deleteAttribute("key") == true);
@@ -241,3 +404,101 @@ BOOST_AUTO_TEST_CASE(dot_test)
     BOOST_TEST(d.att3() == "30");
 
 }
+
+BOOST_AUTO_TEST_CASE(serialization_test)
+{
+    using namespace auxiliary;
+
+    std::map< std::string, std::string > skipped{{"a", "unsupported"}, {"", ""}};
+    Serializer s;
+    s.write(Datatype::UINT64);
+    s.write(Extent{3, 0, 7});
+    s.write(std::vector< std::string >{"meshes", "", "particles"});
+    s.write(skipped);
+    s.write(Attribute(std::array< double, 7 >{{1., 0., -2., 0., 0., 0., 0.5}}).getResource());
+    s.write(Attribute(std::vector< long double >{1.5L, 2.5L}).getResource());
+    s.write(Attribute(std::string("string")).getResource());
+    s.write(Attribute(true).getResource());
+
+    Deserializer d(s.buffer());
+    Datatype dtype;
+    d.read(dtype);
+    BOOST_TEST((dtype == Datatype::UINT64));
+    Extent e;
+    d.read(e);
+    BOOST_TEST((e == Extent{3, 0, 7}));
+    std::vector< std::string > paths;
+    d.read(paths);
+    BOOST_TEST((paths == std::vector< std::string >{"meshes", "", "particles"}));
+    std::map< std::string, std::string > m;
+    d.read(m);
+    BOOST_TEST((m == skipped));
+
+    Attribute::resource r;
+    d.read(r);
+    BOOST_TEST((Attribute(r).dtype == Datatype::ARR_DBL_7));
+    BOOST_TEST((Attribute(r).get< std::array< double, 7 > >() == std::array< double, 7 >{{1., 0., -2., 0., 0., 0., 0.5}}));
+    d.read(r);
+    BOOST_TEST((Attribute(r).get< std::vector< long double > >() == std::vector< long double >{1.5L, 2.5L}));
+    d.read(r);
+    BOOST_TEST(Attribute(r).get< std::string >() == "string");
+    d.read(r);
+    BOOST_TEST((Attribute(r).dtype == Datatype::BOOL));
+    BOOST_TEST(Attribute(r).get< bool >());
+    BOOST_TEST(d.done());
+
+    BOOST_CHECK_THROW(d.read(dtype), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(task_queue_test)
+{
+    TaskQueue queue;
+    BOOST_TEST(queue.collect().empty());
+
+    /* the Writable of each task identifies its producer, the offset its position */
+    std::vector< Writable > producers(4);
+    uint64_t const perProducer = 1000;
+    std::vector< std::thread > threads;
+    for( auto& w : producers )
+        threads.emplace_back([&queue, &w, perProducer]()
+        {
+            for( uint64_t i = 0; i < perProducer; ++i )
+            {
+                Parameter< Operation::WRITE_DATASET > p;
+                p.offset = {i};
+                queue.push(IOTask(&w, std::move(p)));
+            }
+        });
+
+    /* consume while the producers are still pushing */
+    std::map< Writable*, uint64_t > next;
+    std::size_t consumed = 0;
+    auto consume = [&]()
+    {
+        std::queue< IOTask >& work = queue.collect();
+        while( !work.empty() )
+        {
+            uint64_t offset = work.front().getParameter< Operation::WRITE_DATASET >().offset[0];
+            BOOST_TEST(offset == next[work.front().writable]++);
+            ++consumed;
+            work.pop();
+        }
+    };
+    while( consumed < producers.size() * perProducer / 2 )
+        consume();
+    for( auto& t : threads )
+        t.join();
+    consume();
+    BOOST_TEST(consumed == producers.size() * perProducer);
+
+    /* tasks left by the consumer stay ahead of the ones pushed later */
+    Parameter< Operation::WRITE_DATASET > p;
+    p.offset = {1};
+    queue.push(IOTask(&producers[0], p));
+    queue.collect();
+    p.offset = {2};
+    queue.push(IOTask(&producers[0], p));
+    std::queue< IOTask >& work = queue.collect();
+    BOOST_TEST(work.size() == 2);
+    BOOST_TEST(work.front().getParameter< Operation::WRITE_DATASET >().offset[0] == 1u);
+}
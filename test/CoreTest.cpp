@@ -413,3 +413,127 @@ BOOST_AUTO_TEST_CASE(structure_test)
     BOOST_TEST(scalar_rc.parent == static_cast< Writable* >(&o.iterations[1].particles["P"]));
     BOOST_TEST(o.iterations[1].particles["P"]["PR2"][RecordComponent::SCALAR].parent == static_cast< Writable* >(&o.iterations[1].particles["P"]));
 }
+
+BOOST_AUTO_TEST_CASE(chunk_coalescing_test)
+{
+    Series o = Series::create("./MyOutput_%T.dummy");
+    MeshRecordComponent& rc = o.iterations[1].meshes["E"]["x"];
+    rc.resetDataset(Dataset(Datatype::DOUBLE, {8, 4}));
+
+    std::vector< std::shared_ptr< double > > rows;
+    for( uint64_t row = 0; row < 8; ++row )
+    {
+        rows.emplace_back(new double[4], [](double* d){ delete[] d; });
+        for( int i = 0; i < 4; ++i )
+            rows.back().get()[i] = 10. * row + i;
+    }
+
+    /* rows 0-3 abut, row 5 leaves a gap, rows 6-7 abut again */
+    for( uint64_t row : {0, 1, 2, 3, 5, 6, 7} )
+        rc.storeChunk({row, 0}, {1, 4}, rows[row]);
+    /* a partial row can not be merged */
+    rc.storeChunk({4, 0}, {1, 2}, rows[4]);
+
+    rc.coalesceChunks();
+    BOOST_TEST(rc.m_chunks.size() == 3u);
+
+    auto const& first = rc.m_chunks.front().getParameter< Operation::WRITE_DATASET >();
+    BOOST_TEST(first.offset == Offset({0, 0}));
+    BOOST_TEST(first.extent == Extent({4, 4}));
+    double const* merged = static_cast< double const* >(first.data.get());
+    for( int i = 0; i < 16; ++i )
+        BOOST_TEST(merged[i] == 10. * (i / 4) + i % 4);
+    rc.m_chunks.pop();
+
+    auto const& second = rc.m_chunks.front().getParameter< Operation::WRITE_DATASET >();
+    BOOST_TEST(second.offset == Offset({5, 0}));
+    BOOST_TEST(second.extent == Extent({3, 4}));
+    rc.m_chunks.pop();
+
+    auto const& third = rc.m_chunks.front().getParameter< Operation::WRITE_DATASET >();
+    BOOST_TEST(third.offset == Offset({4, 0}));
+    BOOST_TEST(third.extent == Extent({1, 2}));
+    BOOST_TEST(third.data.get() == static_cast< void* >(rows[4].get()));
+}
+
+BOOST_AUTO_TEST_CASE(dataset_auto_chunking_test)
+{
+    /* fits entirely */
+    Dataset small(Datatype::DOUBLE, {10, 10});
+    small.setAutoChunking();
+    BOOST_TEST(small.chunkSize == Extent({10, 10}));
+
+    /* blocks shrink the largest (and among those the slowest) dimension first */
+    Dataset blocks(Datatype::DOUBLE, {512, 512, 512});
+    blocks.setAutoChunking(1u << 20);
+    BOOST_TEST(blocks.chunkSize == Extent({32, 64, 64}));
+
+    /* slices keep the slowest dimension thin */
+    Dataset slices(Datatype::FLOAT, {512, 512, 512});
+    slices.setAutoChunking(1u << 20, Dataset::AccessPattern::SLICES);
+    BOOST_TEST(slices.chunkSize == Extent({1, 512, 512}));
+
+    /* small planes are stacked up to the target size */
+    Dataset planes(Datatype::DOUBLE, {1000, 8, 8});
+    planes.setAutoChunking(1u << 12, Dataset::AccessPattern::SLICES);
+    BOOST_TEST(planes.chunkSize == Extent({8, 8, 8}));
+
+    /* empty dimensions still yield a valid chunk */
+    Dataset empty(Datatype::INT32, {0});
+    empty.setAutoChunking();
+    BOOST_TEST(empty.chunkSize == Extent({1}));
+}
+
+BOOST_AUTO_TEST_CASE(particle_decomposition_test)
+{
+    Series o = Series::create("./MyOutput_%T.dummy");
+    ParticleSpecies& e = o.iterations[1].particles["e"];
+
+    /* without patches, particles are split evenly */
+    e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {10}));
+    std::vector< PatchPosition > even = decompose(e, 3);
+    BOOST_TEST((even == std::vector< PatchPosition >{{3, 0}, {4, 3}, {3, 7}}));
+
+    /* ranges end at nearby patch boundaries */
+    e.particlePatches.m_patchPositions = {{24, 0}, {27, 24}, {23, 51}, {26, 74}};
+    std::vector< PatchPosition > aligned = decompose(e, 4);
+    BOOST_TEST((aligned == std::vector< PatchPosition >{{24, 0}, {27, 24}, {23, 51}, {26, 74}}));
+
+    /* large patches are split to keep the balance */
+    e.particlePatches.m_patchPositions = {{90, 0}, {10, 90}};
+    std::vector< PatchPosition > split = decompose(e, 2);
+    BOOST_TEST((split == std::vector< PatchPosition >{{50, 0}, {50, 50}}));
+    std::vector< PatchPosition > tolerant = decompose(e, 2, 1.);
+    BOOST_TEST((tolerant == std::vector< PatchPosition >{{90, 0}, {10, 90}}));
+
+    BOOST_CHECK_THROW(decompose(e, 0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(mesh_decomposition_test)
+{
+    Series o = Series::create("./MyOutput_%T.dummy");
+    MeshRecordComponent& rc = o.iterations[1].meshes["E"]["x"];
+
+    /* blocks of whole chunks along the only chunked dimension */
+    rc.resetDataset(Dataset(Datatype::DOUBLE, {100, 64}).setChunkSize({10, 64}));
+    auto slabs = decompose(rc, 4);
+    BOOST_TEST(slabs.size() == 4);
+    BOOST_TEST((slabs[1].first == Offset{20, 0}));
+    BOOST_TEST((slabs[1].second == Extent{30, 64}));
+    BOOST_TEST((slabs[3].first == Offset{70, 0}));
+    BOOST_TEST((slabs[3].second == Extent{30, 64}));
+
+    /* ranks are spread over all dimensions, in row-major order */
+    rc.resetDataset(Dataset(Datatype::DOUBLE, {64, 64}).setChunkSize({16, 16}));
+    auto blocks = decompose(rc, 4);
+    BOOST_TEST((blocks[1].first == Offset{0, 32}));
+    BOOST_TEST((blocks[1].second == Extent{32, 32}));
+    BOOST_TEST((blocks[2].first == Offset{32, 0}));
+
+    /* surplus ranks get empty blocks */
+    rc.resetDataset(Dataset(Datatype::DOUBLE, {20}).setChunkSize({10}));
+    auto surplus = decompose(rc, 3);
+    BOOST_TEST((surplus[1].first == Offset{10}));
+    BOOST_TEST((surplus[1].second == Extent{10}));
+    BOOST_TEST((surplus[2].second == Extent{0}));
+}
@@ -4,10 +4,15 @@
 #define BOOST_TEST_NO_MAIN
 #define BOOST_TEST_MODULE libopenpmd_parallel_io_test
 
+/* make PatchRecordComponent::m_values visible for hdf5_patch_write_test */
+#define protected public
 #include "openPMD/openPMD.hpp"
+#undef protected
 using namespace openPMD;
 
 #include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <fstream>
 #if openPMD_HAVE_MPI
 #   include <mpi.h>
 
@@ -121,6 +126,234 @@ BOOST_AUTO_TEST_CASE(hdf5_write_test)
 
     o.flush();
 }
+
+BOOST_AUTO_TEST_CASE(hdf5_patch_write_test)
+{
+    int mpi_s{-1};
+    int mpi_r{-1};
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_s);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_r);
+    uint64_t mpi_size = static_cast<uint64_t>(mpi_s);
+    uint64_t mpi_rank = static_cast<uint64_t>(mpi_r);
+
+    /* rank r holds r + 1 particles with x in [r, r + 1) */
+    uint64_t numParticles = mpi_rank + 1;
+    uint64_t numParticlesGlobal = mpi_size * (mpi_size + 1) / 2;
+    {
+        Series o = Series::create("../samples/parallel_patch.h5", MPI_COMM_WORLD);
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+
+        uint64_t offset = e.storeLocalPatch(MPI_COMM_WORLD, numParticles, {{"x", {double(mpi_rank), double(mpi_rank + 1)}}});
+        BOOST_TEST(offset == mpi_rank * (mpi_rank + 1) / 2);
+
+        std::shared_ptr< double > x(new double[numParticles], [](double* d){ delete[] d; });
+        std::fill(x.get(), x.get() + numParticles, mpi_rank + 0.5);
+        e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {numParticlesGlobal}));
+        e["position"]["x"].storeChunk({offset}, {numParticles}, x);
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {numParticlesGlobal}));
+        e["positionOffset"]["x"].makeConstant(0.);
+        o.flush();
+    }
+
+    Series o = Series::read("../samples/parallel_patch.h5", MPI_COMM_WORLD);
+    ParticleSpecies& e = o.iterations[1].particles["e"];
+    BOOST_TEST(e.particlePatches.numPatches() == mpi_size);
+    BOOST_TEST(e.particlePatches.position(mpi_rank).numParticles == numParticles);
+    /* every rank sees the patches stored by all ranks */
+    auto const& offsets = e.particlePatches["offset"]["x"].m_values;
+    auto const& extents = e.particlePatches["extent"]["x"].m_values;
+    BOOST_TEST(offsets.size() == mpi_size);
+    BOOST_TEST(extents.size() == mpi_size);
+    for( uint64_t r = 0; r < std::min< uint64_t >(mpi_size, offsets.size()); ++r )
+    {
+        BOOST_TEST(e.particlePatches.position(r).numParticles == r + 1);
+        BOOST_TEST(e.particlePatches.position(r).numParticlesOffset == r * (r + 1) / 2);
+        BOOST_TEST(offsets[r] == static_cast< double >(r));
+        BOOST_TEST(extents[r] == 1.);
+    }
+
+    std::map< std::string, std::pair< double, double > > region{{"x", {mpi_rank + 0.25, mpi_rank + 0.75}}};
+    BOOST_TEST((e.particlePatches.select(region) == std::vector< size_t >{mpi_rank}));
+    auto patch = e.loadPatches< double >(region);
+    o.flush();
+    for( uint64_t i = 0; i < numParticles; ++i )
+        BOOST_TEST(patch["position/x"].get()[i] == mpi_rank + 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_broadcast_metadata_test)
+{
+    int mpi_s{-1};
+    int mpi_r{-1};
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_s);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_r);
+    uint64_t mpi_size = static_cast<uint64_t>(mpi_s);
+    uint64_t mpi_rank = static_cast<uint64_t>(mpi_r);
+    {
+        Series o = Series::create("../samples/parallel_broadcast.h5", MPI_COMM_WORLD);
+        o.setAuthor("Parallel HDF5");
+        Mesh& rho = o.iterations[1].meshes["rho"];
+        rho.setGridSpacing(std::vector< double >{0.5});
+        std::shared_ptr< double > value(new double(static_cast< double >(mpi_rank)));
+        rho[MeshRecordComponent::SCALAR].resetDataset(Dataset(Datatype::DOUBLE, {mpi_size}));
+        rho[MeshRecordComponent::SCALAR].storeChunk({mpi_rank}, {1}, value);
+        o.flush();
+    }
+
+    using MR = ParallelHDF5Options::MetadataReaders;
+    for( auto readers : {MR::ONE, MR::ONE_PER_NODE} )
+    {
+        ParallelHDF5Options options;
+        options.metadataReaders = readers;
+        Series o = Series::read("../samples/parallel_broadcast.h5", MPI_COMM_WORLD, options);
+        BOOST_TEST(o.author() == "Parallel HDF5");
+        BOOST_TEST(o.iterations.size() == 1);
+        Mesh& rho = o.iterations[1].meshes["rho"];
+        BOOST_TEST((rho.gridSpacing< double >() == std::vector< double >{0.5}));
+        MeshRecordComponent& scalar = rho[MeshRecordComponent::SCALAR];
+        BOOST_TEST((scalar.getExtent() == Extent{mpi_size}));
+
+        std::unique_ptr< double[] > data;
+        scalar.loadChunk({mpi_rank}, {1}, data);
+        o.flush();
+        BOOST_TEST(data[0] == static_cast< double >(mpi_rank));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_tuning_options_test)
+{
+    int mpi_s{-1};
+    int mpi_r{-1};
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_s);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_r);
+    uint64_t mpi_size = static_cast<uint64_t>(mpi_s);
+    uint64_t mpi_rank = static_cast<uint64_t>(mpi_r);
+
+    ParallelHDF5Options options;
+    options.collectiveMetadataOps = true;
+    options.collectiveMetadataWrite = true;
+    options.alignment = 1u << 20;
+    options.alignmentThreshold = 1u << 16;
+    options.metadataBlockSize = 1u << 16;
+    options.metadataCacheSize = 8u << 20;
+    options.mpiHints = {{"cb_nodes", "1"}, {"romio_cb_write", "enable"}};
+    {
+        Series o = Series::create("../samples/parallel_tuning.h5", MPI_COMM_WORLD, options);
+        std::shared_ptr< double > value(new double(static_cast< double >(mpi_rank)));
+        auto& x = o.iterations[1].particles["e"]["position"]["x"];
+        x.resetDataset(Dataset(Datatype::DOUBLE, {mpi_size}));
+        x.storeChunk({mpi_rank}, {1}, value);
+        o.flush();
+    }
+
+    Series o = Series::read("../samples/parallel_tuning.h5", MPI_COMM_WORLD, options);
+    auto& x = o.iterations[1].particles["e"]["position"]["x"];
+    std::unique_ptr< double[] > data;
+    x.loadChunk({mpi_rank}, {1}, data);
+    o.flush();
+    BOOST_TEST(data[0] == static_cast< double >(mpi_rank));
+
+    options.metadataReaders = ParallelHDF5Options::MetadataReaders::ONE;
+    BOOST_CHECK_THROW(Series::read("../samples/parallel_tuning.h5", MPI_COMM_WORLD, options), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_subfiles_test)
+{
+    int mpi_s{-1};
+    int mpi_r{-1};
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_s);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_r);
+    uint64_t mpi_size = static_cast<uint64_t>(mpi_s);
+    uint64_t mpi_rank = static_cast<uint64_t>(mpi_r);
+
+    using SF = ParallelHDF5Options::Subfiles;
+    for( auto subfiles : {SF::PER_GROUP, SF::PER_NODE} )
+    {
+        ParallelHDF5Options options;
+        options.subfiles = subfiles;
+        options.ranksPerSubfile = 2;
+        {
+            Series o = Series::create("../samples/parallel_subfiles.h5", MPI_COMM_WORLD, options);
+            o.setAuthor("Parallel HDF5");
+            auto& x = o.iterations[1].particles["e"]["position"]["x"];
+            x.resetDataset(Dataset(Datatype::DOUBLE, {2 * mpi_size}));
+            std::shared_ptr< double > values(new double[2], [](double* p){ delete[] p; });
+            values.get()[0] = values.get()[1] = static_cast< double >(mpi_rank);
+            x.storeChunk({2 * mpi_rank}, {1}, values);
+            o.flush();
+            /* a later flush stores its regions next to the earlier ones and updates the index */
+            x.storeChunk({2 * mpi_rank + 1}, {1}, std::shared_ptr< double >(values, values.get() + 1));
+            o.flush();
+        }
+        if( subfiles == SF::PER_GROUP )
+            BOOST_TEST(std::ifstream("../samples/parallel_subfiles_subfiles/" + std::to_string((mpi_size - 1) / 2) + ".h5").good());
+
+        /* the reader sees one ordinary file */
+        Series o = Series::read("../samples/parallel_subfiles.h5", MPI_COMM_WORLD);
+        BOOST_TEST(o.author() == "Parallel HDF5");
+        auto& x = o.iterations[1].particles["e"]["position"]["x"];
+        BOOST_TEST((x.getExtent() == Extent{2 * mpi_size}));
+        std::unique_ptr< double[] > data;
+        x.loadChunk({0}, {2 * mpi_size}, data);
+        o.flush();
+        for( uint64_t i = 0; i < 2 * mpi_size; ++i )
+            BOOST_TEST(data[i] == static_cast< double >(i / 2));
+    }
+
+    ParallelHDF5Options options;
+    options.subfiles = SF::PER_GROUP;
+    BOOST_CHECK_THROW(Series::create("../samples/parallel_subfiles_invalid.h5", MPI_COMM_WORLD, options), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_transfer_test)
+{
+    int mpi_s{-1};
+    int mpi_r{-1};
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_s);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_r);
+    uint64_t mpi_size = static_cast<uint64_t>(mpi_s);
+    uint64_t mpi_rank = static_cast<uint64_t>(mpi_r);
+
+    /* only even ranks hold two particles each, odd ranks store nothing */
+    uint64_t const numParticles = (mpi_size + 1) / 2 * 2;
+    {
+        Series o = Series::create("../samples/parallel_transfer.h5", MPI_COMM_WORLD);
+        auto& e = o.iterations[1].particles["e"];
+        auto& x = e["position"]["x"];
+        x.resetDataset(Dataset(Datatype::DOUBLE, {numParticles}));
+        auto& id = e["id"][RecordComponent::SCALAR];
+        id.resetDataset(Dataset(Datatype::UINT64, {numParticles}).setTransfer(Transfer::INDEPENDENT));
+        if( mpi_rank % 2 == 0 )
+        {
+            std::shared_ptr< double > positions(new double[2], [](double* p){ delete[] p; });
+            std::shared_ptr< uint64_t > ids(new uint64_t[2], [](uint64_t* p){ delete[] p; });
+            for( uint64_t i = 0; i < 2; ++i )
+            {
+                positions.get()[i] = static_cast< double >(mpi_rank + i);
+                ids.get()[i] = mpi_rank + i;
+            }
+            x.storeChunk({mpi_rank}, {2}, positions);
+            id.storeChunk({mpi_rank}, {2}, ids);
+        }
+        o.flush();
+    }
+
+    Series o = Series::read("../samples/parallel_transfer.h5", MPI_COMM_WORLD);
+    auto& e = o.iterations[1].particles["e"];
+    std::unique_ptr< double[] > positions;
+    std::unique_ptr< uint64_t[] > ids;
+    e["position"]["x"].loadChunk({0}, {numParticles}, positions);
+    e["id"][RecordComponent::SCALAR].loadChunk({0}, {numParticles}, ids);
+    o.flush();
+    for( uint64_t i = 0; i < numParticles; ++i )
+    {
+        BOOST_TEST(positions[i] == static_cast< double >(i));
+        BOOST_TEST(ids[i] == i);
+    }
+
+    ParallelHDF5Options options;
+    options.transfer = Transfer::DEFAULT;
+    BOOST_CHECK_THROW(Series::create("../samples/parallel_transfer_invalid.h5", MPI_COMM_WORLD, options), std::runtime_error);
+}
 #else
 BOOST_AUTO_TEST_CASE(no_parallel_hdf5)
 {
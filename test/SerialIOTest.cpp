@@ -6,8 +6,23 @@
 #undef protected
 using namespace openPMD;
 
+#include "openPMD/auxiliary/StringManip.hpp"
+
 #include <boost/test/included/unit_test.hpp>
 
+#if openPMD_HAVE_HDF5
+#   include "openPMD/IO/HDF5/HDF5Auxiliary.hpp"
+#   include <hdf5.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <thread>
+
 #if defined(openPMD_HAVE_HDF5)
 BOOST_AUTO_TEST_CASE(git_hdf5_sample_structure_test)
 {
@@ -774,40 +789,61 @@ BOOST_AUTO_TEST_CASE(hdf5_dtype_test)
 
 BOOST_AUTO_TEST_CASE(hdf5_write_test)
 {
-    Series o = Series::create("../samples/serial_write.h5");
+    {
+        Series o = Series::create("../samples/serial_write.h5");
 
-    o.setAuthor("Serial HDF5");
-    ParticleSpecies& e = o.iterations[1].particles["e"];
+        o.setAuthor("Serial HDF5");
+        ParticleSpecies& e = o.iterations[1].particles["e"];
 
-    std::vector< double > position_global(4);
-    double pos{0.};
-    std::generate(position_global.begin(), position_global.end(), [&pos]{ return pos++; });
-    std::shared_ptr< double > position_local(new double);
-    e["position"]["x"].resetDataset(Dataset(determineDatatype(position_local), {4}));
+        std::vector< double > position_global(4);
+        double pos{0.};
+        std::generate(position_global.begin(), position_global.end(), [&pos]{ return pos++; });
+        std::shared_ptr< double > position_local(new double);
+        e["position"]["x"].resetDataset(Dataset(determineDatatype(position_local), {4}));
 
-    for( uint64_t i = 0; i < 4; ++i )
-    {
-        *position_local = position_global[i];
-        e["position"]["x"].storeChunk({i}, {1}, position_local);
-        o.flush();
-    }
+        for( uint64_t i = 0; i < 4; ++i )
+        {
+            *position_local = position_global[i];
+            e["position"]["x"].storeChunk({i}, {1}, position_local);
+            o.flush();
+        }
 
-    std::vector< uint64_t > positionOffset_global(4);
-    uint64_t posOff{0};
-    std::generate(positionOffset_global.begin(), positionOffset_global.end(), [&posOff]{ return posOff++; });
-    std::shared_ptr< uint64_t > positionOffset_local(new uint64_t);
-    e["positionOffset"]["x"].resetDataset(Dataset(determineDatatype(positionOffset_local), {4}));
+        std::vector< uint64_t > positionOffset_global(4);
+        uint64_t posOff{0};
+        std::generate(positionOffset_global.begin(), positionOffset_global.end(), [&posOff]{ return posOff++; });
+        std::shared_ptr< uint64_t > positionOffset_local(new uint64_t);
+        e["positionOffset"]["x"].resetDataset(Dataset(determineDatatype(positionOffset_local), {4}));
+
+        for( uint64_t i = 0; i < 4; ++i )
+        {
+            *positionOffset_local = positionOffset_global[i];
+            e["positionOffset"]["x"].storeChunk({i}, {1}, positionOffset_local);
+            o.flush();
+        }
 
-    for( uint64_t i = 0; i < 4; ++i )
-    {
-        *positionOffset_local = positionOffset_global[i];
-        e["positionOffset"]["x"].storeChunk({i}, {1}, positionOffset_local);
         o.flush();
     }
 
-    o.flush();
-
-    //TODO close file, read back, verify
+    Series i = Series::read("../samples/serial_write.h5");
+    BOOST_TEST(i.author() == "Serial HDF5");
+    BOOST_TEST(i.iterations.size() == 1);
+    BOOST_TEST(i.iterations.count(1) == 1);
+
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+    BOOST_TEST(e.count("position") == 1);
+    BOOST_TEST(e.count("positionOffset") == 1);
+    BOOST_TEST(e["position"]["x"].getExtent() == Extent{4});
+    BOOST_TEST(e["positionOffset"]["x"].getExtent() == Extent{4});
+
+    std::unique_ptr< double[] > position;
+    e["position"]["x"].loadChunk({0}, {4}, position);
+    std::unique_ptr< uint64_t[] > positionOffset;
+    e["positionOffset"]["x"].loadChunk({0}, {4}, positionOffset);
+    for( uint64_t j = 0; j < 4; ++j )
+    {
+        BOOST_TEST(position[j] == static_cast< double >(j));
+        BOOST_TEST(positionOffset[j] == j);
+    }
 }
 
 BOOST_AUTO_TEST_CASE(hdf5_fileBased_write_test)
@@ -897,136 +933,3300 @@ BOOST_AUTO_TEST_CASE(hdf5_fileBased_write_test)
     //TODO close file, read back, verify
 }
 
-BOOST_AUTO_TEST_CASE(hdf5_bool_test)
+BOOST_AUTO_TEST_CASE(hdf5_fileBased_lazy_read_test)
 {
     {
-        Series o = Series::create("../samples/serial_bool.h5");
+        Series o = Series::create("../samples/serial_fileBased_lazy%T.h5");
+        o.setAuthor("Lazy HDF5");
 
-        o.setAttribute("Bool attribute (true)", true);
-        o.setAttribute("Bool attribute (false)", false);
+        for( uint64_t it = 1; it <= 3; ++it )
+        {
+            std::shared_ptr< double > data(new double[4], [](double* d){ delete[] d; });
+            for( uint64_t j = 0; j < 4; ++j )
+                data.get()[j] = 10. * it + j;
+
+            o.iterations[it].setTime(static_cast< double >(it));
+            RecordComponent& x = o.iterations[it].particles["e"]["position"]["x"];
+            x.resetDataset(Dataset(determineDatatype(data), {4}));
+            x.storeChunk({0}, {4}, data);
+            o.flush();
+        }
     }
+
+    Series i = Series::read("../samples/serial_fileBased_lazy%T.h5");
+    /* const access inspects iterations without parsing them */
+    IterationContainer const& registered = i.iterations;
+    BOOST_TEST(i.author() == "Lazy HDF5");
+    BOOST_TEST(registered.size() == 3);
+    for( auto const& it : registered )
+        BOOST_TEST(!it.second.parsed());
+
+    /* access parses exactly the requested iteration */
+    Iteration& it2 = i.iterations[2];
+    BOOST_TEST(it2.parsed());
+    BOOST_TEST(!registered.find(1)->second.parsed());
+    BOOST_TEST(!registered.find(3)->second.parsed());
+    BOOST_TEST(it2.time< double >() == 2.);
+
+    std::unique_ptr< double[] > data;
+    it2.particles["e"]["position"]["x"].loadChunk({0}, {4}, data);
+    for( uint64_t j = 0; j < 4; ++j )
+        BOOST_TEST(data[j] == 20. + j);
+
+    it2.close();
+    BOOST_TEST(!it2.parsed());
+    BOOST_TEST(it2.particles.empty());
+
+    /* a closed iteration can be opened again */
+    it2.open();
+    BOOST_TEST(it2.parsed());
+    data.reset();
+    it2.particles["e"]["position"]["x"].loadChunk({0}, {4}, data);
+    for( uint64_t j = 0; j < 4; ++j )
+        BOOST_TEST(data[j] == 20. + j);
+
+    Iteration& it3 = i.iterations.at(3);
+    BOOST_TEST(it3.parsed());
+    data.reset();
+    it3.particles["e"]["position"]["x"].loadChunk({0}, {4}, data);
+    for( uint64_t j = 0; j < 4; ++j )
+        BOOST_TEST(data[j] == 30. + j);
+
+    /* a copy knows which iteration it has been registered as */
+    Iteration it1 = registered.find(1)->second;
+    BOOST_TEST(!it1.parsed());
+    it1.open();
+    BOOST_TEST(it1.parsed());
+    BOOST_TEST(it1.time< double >() == 1.);
+    data.reset();
+    it1.particles["e"]["position"]["x"].loadChunk({0}, {4}, data);
+    for( uint64_t j = 0; j < 4; ++j )
+        BOOST_TEST(data[j] == 10. + j);
+
+    /* iterating parses each iteration when it is reached */
+    Series r = Series::read("../samples/serial_fileBased_lazy%T.h5");
+    IterationContainer const& unparsed = r.iterations;
+    for( auto& it : r.iterations )
     {
-        Series o = Series::read("../samples/serial_bool.h5");
+        BOOST_TEST(it.second.parsed());
+        BOOST_TEST(it.second.time< double >() == static_cast< double >(it.first));
+        BOOST_TEST(it.second.particles["e"]["position"]["x"].getExtent() == Extent{4});
+        if( it.first < 3 )
+            BOOST_TEST(!unparsed.find(it.first + 1)->second.parsed());
+        it.second.close();
+    }
+    auto it = r.iterations.begin();
+    ++it;
+    BOOST_TEST(!unparsed.find(2)->second.parsed());
+    BOOST_TEST(it->second.parsed());
+}
 
-        auto attrs = o.attributes();
-        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "Bool attribute (true)") == 1);
-        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "Bool attribute (false)") == 1);
-        BOOST_TEST(o.getAttribute("Bool attribute (true)").get< bool >() == true);
-        BOOST_TEST(o.getAttribute("Bool attribute (false)").get< bool >() == false);
+BOOST_AUTO_TEST_CASE(hdf5_fileBased_concurrent_open_test)
+{
+    {
+        Series o = Series::create("../samples/serial_fileBased_concurrent%T.h5");
+        for( uint64_t it = 1; it <= 8; ++it )
+        {
+            std::shared_ptr< double > data(new double[4], [](double* d){ delete[] d; });
+            for( uint64_t j = 0; j < 4; ++j )
+                data.get()[j] = 10. * it + j;
+
+            o.iterations[it].setTime(static_cast< double >(it));
+            RecordComponent& x = o.iterations[it].particles["e"]["position"]["x"];
+            x.resetDataset(Dataset(determineDatatype(data), {4}));
+            x.storeChunk({0}, {4}, data);
+            MeshRecordComponent& rho = o.iterations[it].meshes["rho"][MeshRecordComponent::SCALAR];
+            rho.resetDataset(Dataset(determineDatatype(data), {2, 2}));
+            rho.storeChunk({0, 0}, {2, 2}, data);
+            o.flush();
+        }
+    }
+
+    Series i = Series::read("../samples/serial_fileBased_concurrent%T.h5");
+    i.iterations.at(3);
+    i.openIterations(3);
+    IterationContainer const& parsed = i.iterations;
+    for( auto const& it : parsed )
+    {
+        BOOST_TEST(it.second.parsed());
+        BOOST_TEST(it.second.time< double >() == static_cast< double >(it.first));
+    }
+
+    /* deferred loads of iterations parsed by different workers */
+    std::vector< std::shared_ptr< double > > loaded;
+    for( auto& it : i.iterations )
+    {
+        loaded.push_back(it.second.meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0, 0}, {2, 2}));
+        loaded.push_back(it.second.particles["e"]["position"]["x"].loadChunk< double >({0}, {4}));
     }
+    i.flush();
+    for( uint64_t it = 1; it <= 8; ++it )
+        for( uint64_t j = 0; j < 4; ++j )
+        {
+            BOOST_TEST(loaded[2 * (it - 1)].get()[j] == 10. * it + j);
+            BOOST_TEST(loaded[2 * (it - 1) + 1].get()[j] == 10. * it + j);
+        }
+
+    Iteration& it5 = i.iterations[5];
+    it5.close();
+    BOOST_TEST(!it5.parsed());
+    it5.open();
+    std::unique_ptr< double[] > data;
+    it5.particles["e"]["position"]["x"].loadChunk({0}, {4}, data);
+    for( uint64_t j = 0; j < 4; ++j )
+        BOOST_TEST(data[j] == 50. + j);
 }
 
-BOOST_AUTO_TEST_CASE(hdf5_patch_test)
+BOOST_AUTO_TEST_CASE(hdf5_prefetch_test)
 {
-    Series o = Series::create("../samples/serial_patch.h5");
+    {
+        Series o = Series::create("../samples/serial_prefetch%T.h5");
+        for( uint64_t it = 1; it <= 4; ++it )
+        {
+            std::shared_ptr< double > data(new double[6], [](double* d){ delete[] d; });
+            for( uint64_t j = 0; j < 6; ++j )
+                data.get()[j] = 10. * it + j;
+
+            MeshRecordComponent& rho = o.iterations[it].meshes["rho"][MeshRecordComponent::SCALAR];
+            rho.resetDataset(Dataset(determineDatatype(data), {2, 3}));
+            rho.storeChunk({0, 0}, {2, 3}, data);
+            /* a growing number of particles */
+            RecordComponent& x = o.iterations[it].particles["e"]["position"]["x"];
+            x.resetDataset(Dataset(determineDatatype(data), {it + 2}));
+            x.storeChunk({0}, {it + 2}, data);
+            o.flush();
+        }
+    }
 
-    o.iterations[1].particles["e"].particlePatches["offset"]["x"].setUnitSI(42);
+    Series i = Series::read("../samples/serial_prefetch%T.h5");
+    BOOST_CHECK_THROW(i.prefetch("fields/rho", {0}, {1}), std::invalid_argument);
+    i.setBufferPool(std::make_shared< auxiliary::BufferPool >());
+    i.prefetch("meshes/rho", {0, 0}, {2, 3})
+     .prefetch("particles/e/position/x", {1}, {4});
+
+    for( auto& entry : i.iterations )
+    {
+        uint64_t const it = entry.first;
+        Iteration& iteration = i.iterations[it];
+        /* the following iteration is parsed and read ahead */
+        if( it < 4 )
+            BOOST_TEST(static_cast< IterationContainer const& >(i.iterations).find(it + 1)->second.parsed());
+
+        std::shared_ptr< double > rho = iteration.meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0, 0}, {2, 3});
+        /* prefetched chunks are filled without a flush */
+        if( it > 1 )
+            BOOST_TEST(rho.get()[5] == 10. * it + 5);
+        std::shared_ptr< double > x;
+        if( it >= 3 )
+            x = iteration.particles["e"]["position"]["x"].loadChunk< double >({1}, {4});
+        i.flush();
+        for( uint64_t j = 0; j < 6; ++j )
+            BOOST_TEST(rho.get()[j] == 10. * it + j);
+        if( x )
+            for( uint64_t j = 0; j < 4; ++j )
+                BOOST_TEST(x.get()[j] == 10. * it + j + 1);
+        iteration.close();
+    }
+
+    /* reads enqueued by the user are not handed to the backend along with the reads ahead */
+    Series r = Series::read("../samples/serial_prefetch%T.h5");
+    r.iterations[2];
+    r.iterations[3];
+    r.prefetch("meshes/rho", {0, 0}, {2, 3});
+    std::shared_ptr< double > rho = r.iterations[2].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0, 0}, {1, 3});
+    BOOST_TEST(r.pendingWrites().queuedTasks == 1);
+    r.iterations[2];
+    BOOST_TEST(r.pendingWrites().queuedTasks == 1);
+    r.flush();
+    BOOST_TEST(r.pendingWrites().queuedTasks == 0);
+    for( uint64_t j = 0; j < 3; ++j )
+        BOOST_TEST(rho.get()[j] == 20. + j);
+    std::shared_ptr< double > prefetched = r.iterations[3].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0, 0}, {2, 3});
+    BOOST_TEST(prefetched.get()[5] == 35.);
 }
 
-BOOST_AUTO_TEST_CASE(hdf5_deletion_test)
+BOOST_AUTO_TEST_CASE(hdf5_probe_test)
 {
-    Series o = Series::create("../samples/serial_deletion.h5");
+    {
+        Series o = Series::create("../samples/serial_probe%T.h5");
+        for( uint64_t it = 1; it <= 6; ++it )
+        {
+            std::shared_ptr< double > data(new double[12], [](double* d){ delete[] d; });
+            for( uint64_t j = 0; j < 12; ++j )
+                data.get()[j] = 100. * it + j;
+
+            /* iteration 4 holds no density */
+            if( it != 4 )
+            {
+                MeshRecordComponent& rho = o.iterations[it].meshes["rho"][MeshRecordComponent::SCALAR];
+                rho.resetDataset(Dataset(determineDatatype(data), {3, 4}));
+                rho.storeChunk({0, 0}, {3, 4}, data);
+            }
+            MeshRecordComponent& ex = o.iterations[it].meshes["E"]["x"];
+            ex.resetDataset(Dataset(determineDatatype(data), {12}));
+            ex.storeChunk({0}, {12}, data);
+            o.flush();
+        }
+    }
 
+    Series i = Series::read("../samples/serial_probe%T.h5");
+    BOOST_CHECK_THROW(i.probe< double >("fields/rho", {0}, {1}), std::invalid_argument);
+    BOOST_CHECK_THROW(i.probe< double >("meshes/rho", {0}, {1, 1}), std::invalid_argument);
 
-    o.setAttribute("removed",
-                   "this attribute will be removed after being written to disk");
-    o.flush();
+    /* iteration 1 has been parsed before, the others by the workers */
+    i.iterations[1];
+    ProbeResult< double > rho = i.probe< double >("meshes/rho", {1, 2}, {2, 1}, 0, 5, 2);
+    BOOST_TEST((rho.iterations == std::vector< uint64_t >{1, 2, 3, 5}));
+    for( std::size_t k = 0; k < rho.iterations.size(); ++k )
+    {
+        double const base = 100. * rho.iterations[k];
+        BOOST_TEST(rho.data.get()[2 * k] == base + 6);
+        BOOST_TEST(rho.data.get()[2 * k + 1] == base + 10);
+    }
 
-    o.deleteAttribute("removed");
-    o.flush();
+    /* records that have not been probed are still available */
+    ProbeResult< float > ex = i.probe< float >("meshes/E/x", {11}, {1}, 3);
+    BOOST_TEST((ex.iterations == std::vector< uint64_t >{3, 4, 5, 6}));
+    for( std::size_t k = 0; k < ex.iterations.size(); ++k )
+        BOOST_TEST(ex.data.get()[k] == 100.f * ex.iterations[k] + 11);
+    BOOST_TEST(i.iterations[4].meshes.size() == 1);
+}
 
-    ParticleSpecies& e = o.iterations[1].particles["e"];
-    e.erase("deletion");
-    o.flush();
+BOOST_AUTO_TEST_CASE(hdf5_read_filter_test)
+{
+    for( std::string name : {"../samples/serial_filter_fileBased%T.h5", "../samples/serial_filter_groupBased.h5"} )
+    {
+        {
+            Series o = Series::create(name);
+            for( uint64_t it = 1; it <= 4; ++it )
+            {
+                std::shared_ptr< double > data(new double[4], [](double* d){ delete[] d; });
+                for( uint64_t j = 0; j < 4; ++j )
+                    data.get()[j] = 10. * it + j;
+
+                Iteration& iteration = o.iterations[it];
+                for( std::string mesh : {"E", "B"} )
+                {
+                    MeshRecordComponent& x = iteration.meshes[mesh]["x"];
+                    x.resetDataset(Dataset(determineDatatype(data), {4}));
+                    x.storeChunk({0}, {4}, data);
+                }
+                for( std::string species : {"e", "ions"} )
+                    for( std::string record : {"position", "momentum"} )
+                    {
+                        RecordComponent& x = iteration.particles[species][record]["x"];
+                        x.resetDataset(Dataset(determineDatatype(data), {4}));
+                        x.storeChunk({0}, {4}, data);
+                    }
+                o.flush();
+            }
+        }
 
-    e["deletion_scalar"][RecordComponent::SCALAR].resetDataset(Dataset(Datatype::DOUBLE, {1}));
-    o.flush();
+        ReadFilter fields;
+        fields.meshes = {"E"};
+        fields.skipParticles = true;
+        fields.firstIteration = 2;
+        fields.lastIteration = 3;
+        BOOST_CHECK_THROW(Series::read(name, fields, AccessType::READ_WRITE), std::runtime_error);
+
+        Series i = Series::read(name, fields);
+        BOOST_TEST(i.iterations.size() == 2);
+        BOOST_TEST(i.iterations.count(1) == 0);
+        BOOST_TEST(i.iterations.count(4) == 0);
+        for( uint64_t it = 2; it <= 3; ++it )
+        {
+            Iteration& iteration = i.iterations[it];
+            BOOST_TEST(iteration.meshes.size() == 1);
+            BOOST_TEST(iteration.meshes.count("E") == 1);
+            BOOST_TEST(iteration.particles.empty());
+
+            auto data = iteration.meshes["E"]["x"].loadChunk< double >({1}, {1});
+            i.flush();
+            BOOST_TEST(*data == 10. * it + 1);
+        }
 
-    e["deletion_scalar"].erase(RecordComponent::SCALAR);
-    o.flush();
+        ReadFilter particles;
+        particles.skipMeshes = true;
+        particles.species = {"ions"};
+        particles.records = {"momentum"};
+        Series p = Series::read(name, particles);
+        BOOST_TEST(p.iterations.size() == 4);
+        Iteration& iteration = p.iterations[4];
+        BOOST_TEST(iteration.meshes.empty());
+        BOOST_TEST(iteration.particles.size() == 1);
+        BOOST_TEST(iteration.particles["ions"].size() == 1);
+        auto data = iteration.particles["ions"]["momentum"]["x"].loadChunk< double >({3}, {1});
+        p.flush();
+        BOOST_TEST(*data == 43.);
+    }
+}
 
-    e.erase("deletion_scalar");
-    o.flush();
+BOOST_AUTO_TEST_CASE(hdf5_close_iteration_test)
+{
+    for( std::string name : {"../samples/serial_close_fileBased%T.h5", "../samples/serial_close_groupBased.h5"} )
+    {
+        {
+            Series o = Series::create(name);
+            for( uint64_t it = 1; it <= 3; ++it )
+            {
+                std::shared_ptr< double > data(new double[4], [](double* d){ delete[] d; });
+                for( uint64_t j = 0; j < 4; ++j )
+                    data.get()[j] = 10. * it + j;
+
+                Iteration& iteration = o.iterations[it];
+                RecordComponent& x = iteration.particles["e"]["position"]["x"];
+                x.resetDataset(Dataset(determineDatatype(data), {4}));
+                x.storeChunk({0}, {4}, data);
+                iteration.close();
+                BOOST_TEST(iteration.closed());
+                BOOST_TEST(iteration.particles.empty());
+            }
+            BOOST_TEST(o.iterations.size() == 3);
+            BOOST_CHECK_THROW(o.iterations[2], std::runtime_error);
+            o.flush();
+        }
 
-    double value = 0.;
-    e["deletion_scalar_constant"][RecordComponent::SCALAR].resetDataset(Dataset(Datatype::DOUBLE, {1}));
-    e["deletion_scalar_constant"][RecordComponent::SCALAR].makeConstant(value);
-    o.flush();
+        Series i = Series::read(name);
+        BOOST_TEST(i.iterations.size() == 3);
+        for( uint64_t it = 1; it <= 3; ++it )
+        {
+            std::unique_ptr< double[] > data;
+            i.iterations[it].particles["e"]["position"]["x"].loadChunk({0}, {4}, data);
+            for( uint64_t j = 0; j < 4; ++j )
+                BOOST_TEST(data[j] == 10. * it + j);
+        }
+    }
+}
 
-    e["deletion_scalar_constant"].erase(RecordComponent::SCALAR);
-    o.flush();
+BOOST_AUTO_TEST_CASE(hdf5_flush_iteration_test)
+{
+    for( std::string name : {"../samples/serial_flush_fileBased%T.h5", "../samples/serial_flush_groupBased.h5"} )
+    {
+        auto chunk = [](double value)
+        {
+            std::shared_ptr< double > data(new double[4], [](double* d){ delete[] d; });
+            std::fill(data.get(), data.get() + 4, value);
+            return data;
+        };
+
+        {
+            Series o = Series::create(name);
+            for( uint64_t it = 1; it <= 3; ++it )
+            {
+                RecordComponent& x = o.iterations[it].particles["e"]["position"]["x"];
+                x.resetDataset(Dataset(Datatype::DOUBLE, {8}));
+                x.storeChunk({0}, {4}, chunk(static_cast< double >(it)));
+            }
+            o.flush();
+            for( auto const& i : o.iterations )
+                BOOST_TEST(!i.second.dirtyRecursive);
+
+            /* only the modified iteration is flagged */
+            o.iterations[2].particles["e"]["position"]["x"].storeChunk({4}, {4}, chunk(20.));
+            BOOST_TEST(o.iterations.find(2)->second.dirtyRecursive);
+            BOOST_TEST(!o.iterations.find(1)->second.dirtyRecursive);
+            BOOST_TEST(!o.iterations.find(3)->second.dirtyRecursive);
+            o.iterations[2].flush();
+            BOOST_TEST(!o.iterations.find(2)->second.dirtyRecursive);
+
+            /* a new iteration can be written on its own */
+            RecordComponent& x = o.iterations[4].particles["e"]["position"]["x"];
+            x.resetDataset(Dataset(Datatype::DOUBLE, {8}));
+            x.storeChunk({0}, {8}, std::shared_ptr< double >(new double[8](), [](double* d){ delete[] d; }));
+            o.iterations[4].setTime(4.);
+            o.iterations[4].flush();
+            BOOST_TEST(!o.iterations.find(4)->second.dirtyRecursive);
+
+            o.iterations[3].particles["e"]["position"]["x"].storeChunk({4}, {4}, chunk(30.));
+            o.flush();
+        }
+
+        Series i = Series::read(name);
+        BOOST_TEST(i.iterations.size() == 4);
+        BOOST_TEST(i.iterations[4].time< double >() == 4.);
+        for( uint64_t it = 2; it <= 3; ++it )
+        {
+            std::unique_ptr< double[] > data;
+            i.iterations[it].particles["e"]["position"]["x"].loadChunk({0}, {8}, data);
+            for( uint64_t j = 0; j < 8; ++j )
+                BOOST_TEST(data[j] == (j < 4 ? 1. : 10.) * it);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_lazy_records_test)
+{
+    {
+        Series o = Series::create("../samples/serial_lazy_records.h5");
+        Iteration& it = o.iterations[1];
+        std::shared_ptr< double > data(new double[6], [](double* d){ delete[] d; });
+        for( int i = 0; i < 6; ++i )
+            data.get()[i] = i;
+        Dataset d(Datatype::DOUBLE, {2, 3});
+        for( auto const& c : {"x", "y"} )
+        {
+            it.meshes["E"][c].resetDataset(d);
+            it.meshes["E"][c].storeChunk({0, 0}, {2, 3}, data);
+        }
+        it.meshes["rho"][MeshRecordComponent::SCALAR].resetDataset(d);
+        it.meshes["rho"][MeshRecordComponent::SCALAR].storeChunk({0, 0}, {2, 3}, data);
+        it.meshes["B"][MeshRecordComponent::SCALAR].makeConstant(3.);
+        it.meshes["B"][MeshRecordComponent::SCALAR].resetDataset(d);
+        it.meshes["B"].setGridSpacing(std::vector< double >{0.5, 0.25});
+
+        ParticleSpecies& e = it.particles["e"];
+        Dataset p(Datatype::DOUBLE, {6});
+        e["position"]["x"].resetDataset(p);
+        e["position"]["x"].storeChunk({0}, {6}, data);
+        e["positionOffset"]["x"].makeConstant(0.);
+        e["positionOffset"]["x"].resetDataset(p);
+        e["weighting"][RecordComponent::SCALAR].resetDataset(p);
+        e["weighting"][RecordComponent::SCALAR].storeChunk({0}, {6}, data);
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_lazy_records.h5");
+#if openPMD_HAVE_INSTRUMENTATION
+    /* records are only listed while reading */
+    BOOST_TEST(i.ioStatistics().count(Operation::OPEN_DATASET) == 0);
+#endif
+    Iteration& it = i.iterations[1];
+    BOOST_TEST(it.meshes.size() == 3);
+    BOOST_TEST(it.particles["e"].size() == 3);
+
+    /* records are opened on first access */
+    MeshRecordComponent& rho = it.meshes["rho"][MeshRecordComponent::SCALAR];
+    BOOST_TEST((rho.getExtent() == Extent{2, 3}));
+    std::shared_ptr< double > loaded = rho.loadChunk< double >({1, 0}, {1, 3});
+    i.flush();
+    BOOST_TEST(loaded.get()[2] == 5.);
+
+    auto B = it.meshes.find("B");
+    BOOST_REQUIRE(B != it.meshes.end());
+    BOOST_TEST(B->second.containsAttribute("gridSpacing"));
+    BOOST_TEST(B->second.at(MeshRecordComponent::SCALAR).constant());
+
+    BOOST_TEST(it.meshes.at("E").size() == 2);
+    BOOST_TEST((it.meshes.at("E")["y"].getExtent() == Extent{2, 3}));
+
+    /* as does iterating their container */
+    std::vector< std::string > components;
+    for( auto const& record : it.particles["e"] )
+        for( auto const& component : record.second )
+            components.push_back(record.first + "/" + component.first);
+    BOOST_TEST((components == std::vector< std::string >{"position/x", "positionOffset/x", std::string("weighting/") + RecordComponent::SCALAR}));
+    BOOST_TEST(it.particles["e"]["weighting"][RecordComponent::SCALAR].getExtent()[0] == 6);
+    BOOST_TEST(it.particles["e"]["position"].unitDimension()[static_cast< uint8_t >(UnitDimension::L)] == 1.);
+
+    /* also when they are reached through a const container */
+    Series j = Series::read("../samples/serial_lazy_records.h5");
+    Iteration const& constIteration = j.iterations[1];
+    BOOST_TEST(constIteration.meshes.at("E").size() == 2);
+    BOOST_TEST(constIteration.meshes.find("B")->second.at(MeshRecordComponent::SCALAR).constant());
+    for( auto const& record : constIteration.particles.at("e") )
+        BOOST_TEST(record.second.size() == 1);
+    BOOST_TEST(!constIteration.particles.at("e").at("weighting").at(RecordComponent::SCALAR).constant());
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_pending_writes_test)
+{
+    Series o = Series::create("../samples/serial_pending.h5");
+    PendingWrites pending = o.pendingWrites();
+    BOOST_TEST(pending.stagedBytes == 0);
+    BOOST_TEST(pending.largest.empty());
+
+    std::shared_ptr< double > data(new double[16], [](double* d){ delete[] d; });
+    std::iota(data.get(), data.get() + 16, 0.);
+    MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+    rho.resetDataset(Dataset(Datatype::DOUBLE, {16}));
+    rho.storeChunk({0}, {16}, data);
+    RecordComponent& x = o.iterations[2].particles["e"]["position"]["x"];
+    x.resetDataset(Dataset(Datatype::DOUBLE, {16}));
+    x.storeChunk({0}, {4}, data);
+    x.storeChunk({4}, {4}, data);
+
+    pending = o.pendingWrites(1);
+    BOOST_TEST(pending.stagedBytes == 24 * sizeof(double));
+    BOOST_TEST(pending.stagedChunks == 3);
+    BOOST_REQUIRE(pending.largest.size() == 1);
+    BOOST_TEST(pending.largest[0].path == "iterations/1/meshes/rho");
+    BOOST_TEST(pending.largest[0].bytes == 16 * sizeof(double));
+    pending = o.pendingWrites();
+    BOOST_REQUIRE(pending.largest.size() == 2);
+    BOOST_TEST(pending.largest[1].path == "iterations/2/particles/e/position/x");
+    BOOST_TEST(pending.largest[1].chunks == 2);
+
+    /* removed components are no longer accounted */
+    o.iterations[2].particles["e"].erase("position");
+    BOOST_TEST(o.pendingWrites().stagedChunks == 1);
 
-    e.erase("deletion_scalar_constant");
+    o.flush();
+    pending = o.pendingWrites();
+    BOOST_TEST(pending.stagedBytes == 0);
+    BOOST_TEST(pending.queuedTasks == 0);
+    BOOST_TEST(pending.largest.empty());
+
+    /* structure and attributes are enqueued by the flush itself, reads right away */
+    rho.loadChunk< double >({0}, {16});
+    BOOST_TEST(o.pendingWrites().queuedTasks > 0);
     o.flush();
 }
 
-BOOST_AUTO_TEST_CASE(hdf5_110_optional_paths)
+BOOST_AUTO_TEST_CASE(hdf5_staging_budget_test)
 {
-    try
     {
+        Series o = Series::create("../samples/serial_staging.h5");
+        StagingStatus status = o.stagingStatus();
+        BOOST_TEST(status.budget == 0);
+        BOOST_TEST(status.stagedBytes == 0);
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        for( std::string dim : {"x", "y", "z"} )
+            e["position"][dim].resetDataset(Dataset(Datatype::DOUBLE, {16}));
+
+        /* without a budget, chunks are referenced until the explicit flush */
+        std::shared_ptr< double > x(new double[16], [](double* d){ delete[] d; });
+        std::iota(x.get(), x.get() + 16, 0.);
+        e["position"]["x"].storeChunk({0}, {16}, x);
+        status = o.stagingStatus();
+        BOOST_TEST(status.stagedBytes == 16 * sizeof(double));
+        BOOST_TEST(status.stagedChunks == 1);
+        o.flush();
+        BOOST_TEST(o.stagingStatus().stagedBytes == 0);
+
+        /* copied chunks free the user buffer right away, exceeding the budget flushes */
+        o.setStagingBudget(8 * sizeof(double), StagingMode::COPY);
+        std::shared_ptr< double > buffer(new double[8], [](double* d){ delete[] d; });
+        for( uint64_t chunk = 0; chunk < 2; ++chunk )
+            for( std::string dim : {"y", "z"} )
+            {
+                std::fill(buffer.get(), buffer.get() + 8, static_cast< double >(chunk + 1));
+                e["position"][dim].storeChunk({8 * chunk}, {8}, buffer);
+                std::fill(buffer.get(), buffer.get() + 8, -1.);
+            }
+        status = o.stagingStatus();
+        BOOST_TEST(status.budget == 8 * sizeof(double));
+        BOOST_TEST(status.autoFlushes == 2);
+        BOOST_TEST(status.stagedBytes <= status.budget);
+        o.flush();
+        BOOST_TEST(!o.stagingStatus().flushing);
+        BOOST_TEST(o.stagingStatus().stagedChunks == 0);
+    }
+
+    Series i = Series::read("../samples/serial_staging.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+    std::unique_ptr< double[] > data;
+    e["position"]["x"].loadChunk({0}, {16}, data);
+    for( uint64_t j = 0; j < 16; ++j )
+        BOOST_TEST(data[j] == static_cast< double >(j));
+    for( std::string dim : {"y", "z"} )
+    {
+        data.reset();
+        e["position"][dim].loadChunk({0}, {16}, data);
+        for( uint64_t j = 0; j < 16; ++j )
+            BOOST_TEST(data[j] == static_cast< double >(j / 8 + 1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_device_memory_test)
+{
+    /* "device" memory that is only accessed through the copies */
+    std::vector< double > device(6 * 5);
+    std::iota(device.begin(), device.end(), 0.);
+    std::size_t copiesToHost = 0, copiesToDevice = 0, pinned = 0;
+    DeviceMemory memory;
+    memory.toHost = [&copiesToHost](void* host, void const* d, std::size_t bytes){ ++copiesToHost; std::memcpy(host, d, bytes); };
+    memory.toDevice = [&copiesToDevice](void* d, void const* host, std::size_t bytes){ ++copiesToDevice; std::memcpy(d, host, bytes); };
+    memory.staging = std::make_shared< auxiliary::BufferPool >(
+            [&pinned](std::size_t bytes){ ++pinned; return ::operator new(bytes); },
+            [](void* p){ ::operator delete(p); });
+    /* two rows per slab */
+    memory.slabBytes = 2 * 5 * sizeof(double);
+
+    {
+        Series o = Series::create("../samples/serial_device_memory.h5");
+        o.setStagingBudget(4 * 5 * sizeof(double), StagingMode::COPY);
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(Datatype::DOUBLE, {6, 5}));
+        rho.storeChunk({0, 0}, {6, 5}, device.data(), memory);
+        BOOST_TEST(copiesToHost == 3);
+        /* the third slab exceeds the budget */
+        BOOST_TEST(o.stagingStatus().autoFlushes == 1);
+        BOOST_CHECK_THROW(rho.storeChunk({0, 0}, {6, 5}, static_cast< float const* >(nullptr), memory), std::runtime_error);
+        MeshRecordComponent& phi = o.iterations[1].meshes["phi"][MeshRecordComponent::SCALAR];
+        phi.makeConstant(2.5);
+        phi.resetDataset(Dataset(Datatype::DOUBLE, {6, 5}));
+        o.flush();
+        /* one host buffer for each slab, none for the copies of StagingMode::COPY */
+        BOOST_TEST(pinned == 3);
+    }
+
+    Series i = Series::read("../samples/serial_device_memory.h5");
+    std::vector< double > loaded(3 * 5, -1.);
+    auto done = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk({2, 0}, {3, 5}, loaded.data(), memory);
+    BOOST_TEST(copiesToDevice == 0);
+    i.flush();
+    done.get();
+    BOOST_TEST(copiesToDevice == 1);
+    for( std::size_t j = 0; j < loaded.size(); ++j )
+        BOOST_TEST(loaded[j] == device[2 * 5 + j]);
+
+    std::vector< double > constant(4);
+    i.iterations[1].meshes["phi"][MeshRecordComponent::SCALAR].loadChunk({1, 1}, {2, 2}, constant.data(), memory).get();
+    for( double v : constant )
+        BOOST_TEST(v == 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_checksum_test)
+{
+    {
+        Series o = Series::create("../samples/serial_checksum.h5");
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(Datatype::DOUBLE, {4, 8}));
+        rho.setChecksums(true);
+        for( uint64_t row : {0, 2} )
         {
-            Series s = Series::read("../samples/issue-sample/no_fields/data%T.h5");
-            auto attrs = s.attributes();
-            BOOST_TEST(std::count(attrs.begin(), attrs.end(), "meshesPath") == 1);
-            BOOST_TEST(std::count(attrs.begin(), attrs.end(), "particlesPath") == 1);
-            BOOST_TEST(s.iterations[400].meshes.size() == 0);
-            BOOST_TEST(s.iterations[400].particles.size() == 1);
+            std::shared_ptr< double > data(new double[16], [](double* d){ delete[] d; });
+            for( uint64_t j = 0; j < 16; ++j )
+                data.get()[j] = 1000. + 16. * row + j + 0.125;
+            rho.storeChunk({row, 0}, {2, 8}, data);
+            /* chunks of the same flush would be merged into one write */
+            o.flush();
+        }
+        BOOST_TEST(rho.getAttribute("chunkCRC32C").get< std::vector< uint32_t > >().size() == 2);
+        BOOST_TEST((rho.getAttribute("chunkOffset").get< std::vector< uint64_t > >() == std::vector< uint64_t >{0, 0, 2, 0}));
+    }
+
+    {
+        Series i = Series::read("../samples/serial_checksum.h5");
+        MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.setChecksums(true);
+        /* both chunks at once, one chunk exactly, and a chunk too small to be checked */
+        auto all = rho.loadChunk< double >({0, 0}, {4, 8});
+        auto second = rho.loadChunk< double >({2, 0}, {2, 8});
+        auto part = rho.loadChunk< double >({1, 1}, {2, 2});
+        i.flush();
+        BOOST_TEST(all.get()[31] == 1047.125);
+        BOOST_TEST(second.get()[0] == 1032.125);
+        /* converted values are not checked */
+        auto converted = rho.loadChunk< float >({0, 0}, {4, 8});
+        i.flush();
+    }
+
+    /* corrupt one value in the file */
+    {
+        std::fstream f("../samples/serial_checksum.h5", std::ios::in | std::ios::out | std::ios::binary);
+        std::vector< char > bytes((std::istreambuf_iterator< char >(f)), std::istreambuf_iterator< char >());
+        double const value = 1000. + 16. * 2 + 5 + 0.125;
+        char pattern[sizeof(double)];
+        std::memcpy(pattern, &value, sizeof(double));
+        auto at = std::search(bytes.begin(), bytes.end(), pattern, pattern + sizeof(double));
+        BOOST_REQUIRE(at != bytes.end());
+        double const corrupted = -1.;
+        f.clear();
+        f.seekp(at - bytes.begin());
+        f.write(reinterpret_cast< char const* >(&corrupted), sizeof(double));
+    }
+
+    Series i = Series::read("../samples/serial_checksum.h5");
+    MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+    /* without verification, the corrupted value is loaded */
+    auto unchecked = rho.loadChunk< double >({2, 0}, {2, 8});
+    i.flush();
+    BOOST_TEST(unchecked.get()[5] == -1.);
+
+    rho.setChecksums(true);
+    auto first = rho.loadChunk< double >({0, 0}, {2, 8});
+    i.flush();
+    std::shared_ptr< double > second(new double[16], [](double* d){ delete[] d; });
+    auto done = rho.loadChunk({2, 0}, {2, 8}, second);
+    BOOST_CHECK_THROW(i.flush(), std::runtime_error);
+    BOOST_CHECK_THROW(done.get(), std::runtime_error);
+    std::unique_ptr< double[] > all;
+    BOOST_CHECK_THROW(rho.loadChunk({0, 0}, {4, 8}, all), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_append_test)
+{
+    {
+        Series o = Series::create("../samples/serial_append.h5");
+        for( uint64_t it : {1, 2} )
+        {
+            RecordComponent& id = o.iterations[it].particles["e"]["id"][RecordComponent::SCALAR];
+            id.resetDataset(Dataset(Datatype::UINT64, {0}));
         }
 
+        RecordComponent& id = o.iterations[1].particles["e"]["id"][RecordComponent::SCALAR];
+        uint64_t next = 0;
+        for( uint64_t step = 0; step < 10; ++step )
         {
-            Series s = Series::read("../samples/issue-sample/no_particles/data%T.h5");
-            auto attrs = s.attributes();
-            BOOST_TEST(std::count(attrs.begin(), attrs.end(), "meshesPath") == 1);
-            BOOST_TEST(std::count(attrs.begin(), attrs.end(), "particlesPath") == 1);
-            BOOST_TEST(s.iterations[400].meshes.size() == 2);
-            BOOST_TEST(s.iterations[400].particles.size() == 0);
+            std::shared_ptr< uint64_t > rows(new uint64_t[3], [](uint64_t* d){ delete[] d; });
+            std::iota(rows.get(), rows.get() + 3, next);
+            id.append(rows, 3);
+            next += 3;
+            /* rows appended after the dataset has been created grow it on the next flush */
+            if( step % 4 == 3 )
+                o.flush();
         }
-    } catch (no_such_file_error& e)
+        BOOST_TEST(id.getAppendedSize() == 30);
+        BOOST_TEST(id.getExtent()[0] >= 30);
+        o.iterations[1].close();
+
+        /* trimmed when the Series is destroyed */
+        std::shared_ptr< uint64_t > rows(new uint64_t[5], [](uint64_t* d){ delete[] d; });
+        std::iota(rows.get(), rows.get() + 5, 100);
+        o.iterations[2].particles["e"]["id"][RecordComponent::SCALAR].append(rows, 5);
+        o.flush();
+        o.iterations[2].particles["e"]["id"][RecordComponent::SCALAR].append(rows, 2);
+
+        RecordComponent& pos = o.iterations[2].particles["e"]["position"]["x"];
+        pos.resetDataset(Dataset(Datatype::UINT64, {2, 2}));
+        BOOST_CHECK_THROW(pos.append(rows, 1), std::runtime_error);
+    }
+
+    Series i = Series::read("../samples/serial_append.h5");
+    RecordComponent& first = i.iterations[1].particles["e"]["id"][RecordComponent::SCALAR];
+    BOOST_TEST(first.getExtent() == Extent{30});
+    std::unique_ptr< uint64_t[] > data;
+    first.loadChunk({0}, {30}, data);
+    for( uint64_t j = 0; j < 30; ++j )
+        BOOST_TEST(data[j] == j);
+
+    RecordComponent& second = i.iterations[2].particles["e"]["id"][RecordComponent::SCALAR];
+    BOOST_TEST(second.getExtent() == Extent{7});
+    data.reset();
+    second.loadChunk({0}, {7}, data);
+    for( uint64_t j = 0; j < 7; ++j )
+        BOOST_TEST(data[j] == 100 + j % 5);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_deferred_load_test)
+{
     {
-        std::cerr << "issue sample not accessible. (" << e.what() << ")\n";
+        Series o = Series::create("../samples/serial_deferred_load.h5");
+
+        std::shared_ptr< double > data(new double[10], [](double* d){ delete[] d; });
+        for( int i = 0; i < 10; ++i )
+            data.get()[i] = i;
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        for( auto const& c : {"x", "y", "z"} )
+        {
+            e["position"][c].resetDataset(Dataset(determineDatatype(data), {10}));
+            e["position"][c].storeChunk({0}, {10}, data);
+        }
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {10}));
+        e["positionOffset"]["x"].makeConstant(42.);
+        o.flush();
     }
 
+    Series i = Series::read("../samples/serial_deferred_load.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+
+    std::vector< std::shared_ptr< double > > buffers;
+    std::vector< std::future< void > > loads;
+    for( auto const& c : {"x", "y", "z"} )
     {
-        Series s = Series::create("../samples/no_meshes_1.1.0_compliant.h5");
-        s.iterations[1].particles["foo"];
+        buffers.emplace_back(new double[5], [](double* d){ delete[] d; });
+        loads.push_back(e["position"][c].loadChunk({5}, {5}, buffers.back()));
     }
+    /* reads are only performed on flush */
+    for( auto& l : loads )
+        BOOST_TEST((l.wait_for(std::chrono::seconds(0)) == std::future_status::timeout));
 
+    std::shared_ptr< double > offset(new double[3], [](double* d){ delete[] d; });
+    std::future< void > constant = e["positionOffset"]["x"].loadChunk({0}, {3}, offset);
+
+    i.flush();
+    for( std::size_t b = 0; b < buffers.size(); ++b )
     {
-        Series s = Series::create("../samples/no_particles_1.1.0_compliant.h5");
-        s.iterations[1].meshes["foo"];
+        loads[b].get();
+        for( int j = 0; j < 5; ++j )
+            BOOST_TEST(buffers[b].get()[j] == static_cast< double >(5 + j));
     }
+    constant.get();
+    for( int j = 0; j < 3; ++j )
+        BOOST_TEST(offset.get()[j] == 42.);
+}
 
+BOOST_AUTO_TEST_CASE(hdf5_pooled_load_test)
+{
     {
-        Series s = Series::read("../samples/no_meshes_1.1.0_compliant.h5");
-        auto attrs = s.attributes();
-        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "meshesPath") == 0);
-        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "particlesPath") == 1);
-        BOOST_TEST(s.iterations[1].meshes.size() == 0);
-        BOOST_TEST(s.iterations[1].particles.size() == 1);
+        Series o = Series::create("../samples/serial_pooled_load.h5");
+
+        std::shared_ptr< double > data(new double[10], [](double* d){ delete[] d; });
+        for( int i = 0; i < 10; ++i )
+            data.get()[i] = i;
+
+        for( uint64_t it = 1; it <= 3; ++it )
+        {
+            RecordComponent& x = o.iterations[it].particles["e"]["position"]["x"];
+            x.resetDataset(Dataset(determineDatatype(data), {10}));
+            x.storeChunk({0}, {10}, data);
+        }
+        o.flush();
     }
 
+    Series i = Series::read("../samples/serial_pooled_load.h5");
+    auto pool = std::make_shared< auxiliary::BufferPool >();
+    i.setBufferPool(pool);
+    BOOST_TEST(i.bufferPool() == pool);
+
+    double* previous = nullptr;
+    for( auto& it : i.iterations )
     {
-        Series s = Series::read("../samples/no_particles_1.1.0_compliant.h5");
-        auto attrs = s.attributes();
-        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "meshesPath") == 1);
-        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "particlesPath") == 0);
-        BOOST_TEST(s.iterations[1].meshes.size() == 1);
-        BOOST_TEST(s.iterations[1].particles.size() == 0);
+        RecordComponent& x = it.second.particles["e"]["position"]["x"];
+        std::shared_ptr< double > data = x.loadChunk< double >({2}, {8});
+        i.flush();
+        for( int j = 0; j < 8; ++j )
+            BOOST_TEST(data.get()[j] == static_cast< double >(2 + j));
+
+        /* equally sized chunks re-use the released buffer */
+        if( previous )
+            BOOST_TEST(data.get() == previous);
+        previous = data.get();
     }
+    BOOST_TEST(pool->cachedBytes() > 0u);
 }
-#else
-BOOST_AUTO_TEST_CASE(no_serial_hdf5)
+
+BOOST_AUTO_TEST_CASE(hdf5_load_conversion_test)
 {
-    BOOST_TEST(true);
+    {
+        Series o = Series::create("../samples/serial_load_conversion.h5");
+
+        std::shared_ptr< double > data(new double[6], [](double* d){ delete[] d; });
+        for( int i = 0; i < 6; ++i )
+            data.get()[i] = 1.5 * i;
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["position"]["x"].resetDataset(Dataset(determineDatatype(data), {6}));
+        e["position"]["x"].storeChunk({0}, {6}, data);
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::INT32, {6}));
+        e["positionOffset"]["x"].makeConstant(int32_t(7));
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_load_conversion.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+
+    std::unique_ptr< float[] > f;
+    e["position"]["x"].loadChunk({0}, {6}, f);
+    for( int j = 0; j < 6; ++j )
+        BOOST_TEST(f[j] == 1.5f * j);
+
+    std::unique_ptr< int64_t[] > l;
+    e["position"]["x"].loadChunk({2}, {2}, l);
+    BOOST_TEST(l[0] == 3);
+    BOOST_TEST(l[1] == 4);
+
+    std::unique_ptr< double[] > d;
+    e["positionOffset"]["x"].loadChunk({0}, {6}, d);
+    for( int j = 0; j < 6; ++j )
+        BOOST_TEST(d[j] == 7.);
+
+    std::unique_ptr< bool[] > b;
+    BOOST_CHECK_THROW(e["position"]["x"].loadChunk({0}, {6}, b), std::runtime_error);
 }
-#endif
-#if defined(openPMD_HAVE_ADIOS1)
-BOOST_AUTO_TEST_CASE(adios_write_test)
+
+BOOST_AUTO_TEST_CASE(hdf5_constant_view_test)
 {
-    Output o = Output("../samples/serial_write.bp");
+    {
+        Series o = Series::create("../samples/serial_constant_view.h5");
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["charge"][RecordComponent::SCALAR].resetDataset(Dataset(Datatype::DOUBLE, {1000000000}));
+        e["charge"][RecordComponent::SCALAR].makeConstant(-1.6e-19);
+        e["charge"][RecordComponent::SCALAR].setUnitSI(2.);
+        e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {4}));
+        std::shared_ptr< double > data(new double[4], [](double* d){ delete[] d; });
+        std::fill(data.get(), data.get() + 4, 0.);
+        e["position"]["x"].storeChunk({0}, {4}, data);
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_constant_view.h5");
+    RecordComponent& charge = i.iterations[1].particles["e"]["charge"][RecordComponent::SCALAR];
+    BOOST_TEST(charge.constant());
+
+    ConstantView< double > view = charge.loadConstant< double >({0}, {1000000000});
+    BOOST_TEST(view.size() == 1000000000u);
+    BOOST_TEST(view.extent() == Extent{1000000000});
+    BOOST_TEST(view.value() == -1.6e-19);
+    BOOST_TEST(view[999999999] == -1.6e-19);
+    BOOST_TEST(charge.loadConstant< double >({0}, {1}, 1.).value() == -3.2e-19);
+    BOOST_CHECK_THROW(charge.loadConstant< double >({1}, {1000000000}), std::runtime_error);
+
+    /* the buffered load uses the value read along with the component */
+    std::unique_ptr< float[] > f;
+    charge.loadChunk({10}, {4}, f);
+    for( int j = 0; j < 4; ++j )
+        BOOST_TEST(f[j] == -1.6e-19f);
+
+    RecordComponent& x = i.iterations[1].particles["e"]["position"]["x"];
+    BOOST_TEST(!x.constant());
+    BOOST_CHECK_THROW(x.loadConstant< double >({0}, {4}), std::runtime_error);
 }
-#else
-BOOST_AUTO_TEST_CASE(no_serial_adios1)
+
+BOOST_AUTO_TEST_CASE(hdf5_strided_load_test)
+{
+    {
+        Series o = Series::create("../samples/serial_strided_load.h5");
+        std::shared_ptr< double > data(new double[512], [](double* d){ delete[] d; });
+        std::iota(data.get(), data.get() + 512, 0.);
+
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(determineDatatype(data), {8, 8, 8}));
+        rho.storeChunk({0, 0, 0}, {8, 8, 8}, data);
+        MeshRecordComponent& phi = o.iterations[1].meshes["phi"][MeshRecordComponent::SCALAR];
+        phi.resetDataset(Dataset(Datatype::DOUBLE, {8, 8, 8}));
+        phi.makeConstant(3.);
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_strided_load.h5");
+    MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+    auto index = [](uint64_t x, uint64_t y, uint64_t z){ return static_cast< double >(64 * x + 8 * y + z); };
+
+    /* every 4th cell starting at 1 */
+    BOOST_TEST(RecordComponent::stridedExtent({7, 7, 7}, {4, 4, 4}) == Extent({2, 2, 2}));
+    std::shared_ptr< double > every = rho.loadStridedChunk< double >({1, 1, 1}, {7, 7, 7}, {4, 4, 4});
+    /* blocks of 2 x 1 x 8 cells every 4 x 2 x 8 cells */
+    BOOST_TEST(RecordComponent::stridedExtent({8, 8, 8}, {4, 2, 8}, {2, 1, 8}) == Extent({4, 4, 8}));
+    std::shared_ptr< float > blocks = rho.loadStridedChunk< float >({0, 0, 0}, {8, 8, 8}, {4, 2, 8}, {2, 1, 8});
+    std::shared_ptr< double > constant = i.iterations[1].meshes["phi"][MeshRecordComponent::SCALAR].loadStridedChunk< double >({0, 0, 0}, {8, 8, 8}, {8, 8, 8});
+    i.flush();
+
+    for( uint64_t x = 0; x < 2; ++x )
+        for( uint64_t y = 0; y < 2; ++y )
+            for( uint64_t z = 0; z < 2; ++z )
+                BOOST_TEST(every.get()[4 * x + 2 * y + z] == index(1 + 4 * x, 1 + 4 * y, 1 + 4 * z));
+    for( uint64_t x = 0; x < 4; ++x )
+        for( uint64_t y = 0; y < 4; ++y )
+            for( uint64_t z = 0; z < 8; ++z )
+                BOOST_TEST(blocks.get()[32 * x + 8 * y + z] == static_cast< float >(index(4 * (x / 2) + x % 2, 2 * y, z)));
+    BOOST_TEST(constant.get()[0] == 3.);
+
+    BOOST_CHECK_THROW(rho.loadStridedChunk< double >({0, 0, 0}, {8, 8, 8}, {0, 1, 1}), std::runtime_error);
+    BOOST_CHECK_THROW(rho.loadStridedChunk< double >({0, 0, 0}, {8, 8, 8}, {2, 2, 2}, {4, 1, 1}), std::runtime_error);
+    BOOST_CHECK_THROW(rho.loadStridedChunk< double >({0, 0, 0}, {8, 8, 8}, {2, 2}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_multi_region_load_test)
+{
+    {
+        Series o = Series::create("../samples/serial_multi_region_load.h5");
+        std::shared_ptr< double > data(new double[64], [](double* d){ delete[] d; });
+        std::iota(data.get(), data.get() + 64, 0.);
+
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(determineDatatype(data), {8, 8}));
+        rho.storeChunk({0, 0}, {8, 8}, data);
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["position"]["x"].resetDataset(Dataset(determineDatatype(data), {64}));
+        e["position"]["x"].storeChunk({0}, {64}, data);
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::INT32, {64}));
+        e["positionOffset"]["x"].makeConstant(int32_t(3));
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_multi_region_load.h5");
+    MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+
+    /* particles in arbitrary order */
+    std::shared_ptr< double > points = e["position"]["x"].loadPoints< double >({{42}, {3}, {63}, {3}, {0}});
+    /* boxes in file order, read as one selection */
+    std::shared_ptr< double > ordered = e["position"]["x"].loadChunks< double >({{{2}, {3}}, {{10}, {2}}, {{60}, {4}}});
+    /* boxes side by side and out of order */
+    std::shared_ptr< float > interleaved = rho.loadChunks< float >({{{4, 4}, {2, 2}}, {{0, 0}, {2, 2}}, {{0, 2}, {2, 1}}});
+    std::shared_ptr< int32_t > constant = e["positionOffset"]["x"].loadPoints< int32_t >({{1}, {5}});
+    i.flush();
+
+    std::vector< double > expectedPoints{42, 3, 63, 3, 0};
+    for( size_t p = 0; p < expectedPoints.size(); ++p )
+        BOOST_TEST(points.get()[p] == expectedPoints[p]);
+    std::vector< double > expectedOrdered{2, 3, 4, 10, 11, 60, 61, 62, 63};
+    for( size_t p = 0; p < expectedOrdered.size(); ++p )
+        BOOST_TEST(ordered.get()[p] == expectedOrdered[p]);
+    std::vector< float > expectedInterleaved{36, 37, 44, 45, 0, 1, 8, 9, 2, 10};
+    for( size_t p = 0; p < expectedInterleaved.size(); ++p )
+        BOOST_TEST(interleaved.get()[p] == expectedInterleaved[p]);
+    BOOST_TEST(constant.get()[0] == 3);
+    BOOST_TEST(constant.get()[1] == 3);
+
+    BOOST_CHECK_THROW(e["position"]["x"].loadPoints< double >({{64}}), std::runtime_error);
+    BOOST_CHECK_THROW(rho.loadPoints< double >({{1}}), std::runtime_error);
+    BOOST_CHECK_THROW(rho.loadChunks< double >({{{0, 0}, {2, 2}}, {{7, 7}, {2, 2}}}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_statistics_test)
+{
+    {
+        Series o = Series::create("../samples/serial_statistics.h5");
+        std::shared_ptr< double > data(new double[8], [](double* d){ delete[] d; });
+        std::iota(data.get(), data.get() + 8, -3.);
+        data.get()[2] = std::numeric_limits< double >::quiet_NaN();
+
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(determineDatatype(data), {16}));
+        rho.setStatistics(true);
+        rho.storeChunk({0}, {8}, data);
+        o.flush();
+        BOOST_TEST(rho.getAttribute("minValue").get< double >() == -3.);
+        BOOST_TEST(rho.getAttribute("maxValue").get< double >() == 4.);
+        BOOST_TEST(rho.getAttribute("numNaN").get< uint64_t >() == 1u);
+
+        /* the statistics cover all chunks written so far */
+        std::shared_ptr< double > more(new double[8], [](double* d){ delete[] d; });
+        std::iota(more.get(), more.get() + 8, 10.);
+        rho.storeChunk({8}, {8}, more);
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        std::shared_ptr< int32_t > ids(new int32_t[4], [](int32_t* d){ delete[] d; });
+        std::iota(ids.get(), ids.get() + 4, 7);
+        e["id"][RecordComponent::SCALAR].resetDataset(Dataset(determineDatatype(ids), {4}));
+        e["id"][RecordComponent::SCALAR].setStatistics(true);
+        e["id"][RecordComponent::SCALAR].storeChunk({0}, {4}, ids);
+        e["position"]["x"].resetDataset(Dataset(determineDatatype(more), {8}));
+        e["position"]["x"].storeChunk({0}, {8}, more);
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_statistics.h5");
+    MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+    BOOST_TEST(rho.getAttribute("minValue").get< double >() == -3.);
+    BOOST_TEST(rho.getAttribute("maxValue").get< double >() == 17.);
+    BOOST_TEST(rho.getAttribute("numNaN").get< uint64_t >() == 1u);
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+    BOOST_TEST(e["id"][RecordComponent::SCALAR].getAttribute("minValue").get< double >() == 7.);
+    BOOST_TEST(e["id"][RecordComponent::SCALAR].getAttribute("maxValue").get< double >() == 10.);
+    BOOST_TEST(e["id"][RecordComponent::SCALAR].getAttribute("numNaN").get< uint64_t >() == 0u);
+    BOOST_TEST(!e["position"]["x"].containsAttribute("minValue"));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_block_index_test)
+{
+    {
+        Series o = Series::create("../samples/serial_block_index.h5");
+        std::shared_ptr< double > momentum(new double[100], [](double* d){ delete[] d; });
+        for( int p = 0; p < 100; ++p )
+            momentum.get()[p] = p % 10;
+        /* a few high-energy particles */
+        momentum.get()[23] = 50.;
+        momentum.get()[71] = 60.;
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["momentum"]["x"].resetDataset(Dataset(determineDatatype(momentum), {100}));
+        e["momentum"]["x"].setBlockIndex(16);
+        /* blocks are reduced across chunk boundaries */
+        e["momentum"]["x"].storeChunk({0}, {40}, std::shared_ptr< double >(momentum, momentum.get()));
+        o.flush();
+        e["momentum"]["x"].storeChunk({40}, {60}, std::shared_ptr< double >(momentum, momentum.get() + 40));
+        std::shared_ptr< uint64_t > ids(new uint64_t[100], [](uint64_t* d){ delete[] d; });
+        std::iota(ids.get(), ids.get() + 100, 0u);
+        e["id"][RecordComponent::SCALAR].resetDataset(Dataset(determineDatatype(ids), {100}));
+        e["id"][RecordComponent::SCALAR].setBlockIndex(32);
+        e["id"][RecordComponent::SCALAR].storeChunk({0}, {100}, ids);
+        o.flush();
+
+        BOOST_TEST(e.blockIndex["momentum"]["x"].getExtent() == Extent({7, 2}));
+    }
+
+    Series i = Series::read("../samples/serial_block_index.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+    BOOST_TEST(e.count("blockIndex") == 0u);
+    BOOST_TEST(e.blockIndex["momentum"]["x"].getAttribute("blockSize").get< uint64_t >() == 16u);
+
+    auto blocks = e.selectBlocks("momentum/x", {20., std::numeric_limits< double >::infinity()});
+    BOOST_REQUIRE(blocks.size() == 2u);
+    BOOST_TEST(blocks[0].first == Offset({16}));
+    BOOST_TEST(blocks[0].second == Extent({16}));
+    BOOST_TEST(blocks[1].first == Offset({64}));
+    BOOST_TEST(blocks[1].second == Extent({16}));
+    std::shared_ptr< double > candidates = e["momentum"]["x"].loadChunks< double >(blocks);
+    i.flush();
+    BOOST_TEST(candidates.get()[23 - 16] == 50.);
+    BOOST_TEST(candidates.get()[16 + 71 - 64] == 60.);
+
+    /* consecutive blocks are merged and the last one is clipped to the dataset */
+    auto all = e.selectBlocks("momentum/x", {0., 10.});
+    BOOST_REQUIRE(all.size() == 1u);
+    BOOST_TEST(all[0].second == Extent({100}));
+    auto late = e.selectBlocks("id", {70., 200.});
+    BOOST_REQUIRE(late.size() == 1u);
+    BOOST_TEST(late[0].first == Offset({64}));
+    BOOST_TEST(late[0].second == Extent({36}));
+    BOOST_CHECK_THROW(e.selectBlocks("position/x", {0., 1.}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_particle_query_test)
+{
+    {
+        Series o = Series::create("../samples/serial_particle_query.h5");
+        std::shared_ptr< double > momentum(new double[1000], [](double* d){ delete[] d; });
+        std::shared_ptr< float > weighting(new float[1000], [](float* d){ delete[] d; });
+        for( int p = 0; p < 1000; ++p )
+        {
+            momentum.get()[p] = p % 100;
+            weighting.get()[p] = static_cast< float >(p % 7);
+        }
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["momentum"]["x"].resetDataset(Dataset(determineDatatype(momentum), {1000}));
+        e["momentum"]["x"].setBlockIndex(50);
+        e["momentum"]["x"].storeChunk({0}, {1000}, momentum);
+        e["weighting"][RecordComponent::SCALAR].resetDataset(Dataset(determineDatatype(weighting), {1000}));
+        e["weighting"][RecordComponent::SCALAR].storeChunk({0}, {1000}, weighting);
+        e["position"]["x"].resetDataset(Dataset(determineDatatype(momentum), {1000}));
+        e["position"]["x"].storeChunk({0}, {1000}, momentum);
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::INT32, {1000}));
+        e["positionOffset"]["x"].makeConstant(int32_t(2));
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_particle_query.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+
+    std::vector< uint64_t > expected;
+    for( uint64_t p = 0; p < 1000; ++p )
+        if( p % 100 >= 95 && p % 7 >= 3 )
+            expected.push_back(p);
+
+    /* small batches split the candidate blocks */
+    std::vector< uint64_t > selected = e.selectParticles({{"momentum/x", {95., 200.}}, {"weighting", {3., 7.}}}, 4, 30);
+    BOOST_TEST(selected == expected);
+    BOOST_TEST(e.selectParticles({{"momentum/x", {95., 200.}}, {"weighting", {3., 7.}}}) == expected);
+    BOOST_TEST(e.selectParticles({{"momentum/x", {200., 300.}}}).empty());
+
+    auto particles = e.loadParticles< double >(selected);
+    i.flush();
+    BOOST_TEST(particles.size() == 4u);
+    for( size_t p = 0; p < selected.size(); ++p )
+    {
+        BOOST_TEST(particles["momentum/x"].get()[p] == static_cast< double >(selected[p] % 100));
+        BOOST_TEST(particles["weighting"].get()[p] == static_cast< double >(selected[p] % 7));
+        BOOST_TEST(particles["positionOffset/x"].get()[p] == 2.);
+    }
+
+    BOOST_CHECK_THROW(e.selectParticles({{"momentum/y", {0., 1.}}}), std::runtime_error);
+    BOOST_CHECK_THROW(e.selectParticles({}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_load_unitSI_test)
+{
+    {
+        Series o = Series::create("../samples/serial_load_unitSI.h5");
+
+        std::shared_ptr< double > data(new double[4], [](double* d){ delete[] d; });
+        for( int i = 0; i < 4; ++i )
+            data.get()[i] = i;
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["position"]["x"].resetDataset(Dataset(determineDatatype(data), {4}));
+        e["position"]["x"].storeChunk({0}, {4}, data);
+        e["position"]["x"].setUnitSI(2.);
+        e["position"]["y"].resetDataset(Dataset(determineDatatype(data), {4}));
+        e["position"]["y"].storeChunk({0}, {4}, data);
+        e["position"]["y"].setUnitSI(1.e-5);
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::INT32, {4}));
+        e["positionOffset"]["x"].makeConstant(int32_t(3));
+        e["positionOffset"]["x"].setUnitSI(2.);
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_load_unitSI.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+
+    std::unique_ptr< double[] > d;
+    e["position"]["x"].loadChunk({0}, {4}, d, RecordComponent::Allocation::AUTO, 0.5);
+    for( int j = 0; j < 4; ++j )
+        BOOST_TEST(d[j] == 4. * j);
+
+    /* scaling and type conversion in one read */
+    std::shared_ptr< float > f = e["position"]["y"].loadChunk< float >({0}, {4}, 1.e-6);
+    std::shared_ptr< int64_t > l = e["positionOffset"]["x"].loadChunk< int64_t >({0}, {4}, 1.);
+    i.flush();
+    for( int j = 0; j < 4; ++j )
+    {
+        BOOST_TEST(std::abs(f.get()[j] - 10.f * j) < 1.e-5f);
+        BOOST_TEST(l.get()[j] == 6);
+    }
+
+    /* NaN leaves the values untouched */
+    d.reset();
+    e["position"]["x"].loadChunk({0}, {4}, d);
+    for( int j = 0; j < 4; ++j )
+        BOOST_TEST(d[j] == static_cast< double >(j));
+
+    BOOST_CHECK_THROW(e["position"]["x"].loadChunk({0}, {4}, d, RecordComponent::Allocation::USER, 0.), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_map_test)
+{
+    Extent const extent{4, 8, 8};
+    {
+        Series o = Series::create("../samples/serial_map.h5");
+
+        std::shared_ptr< double > data(new double[4 * 8 * 8], [](double* p){ delete[] p; });
+        for( int i = 0; i < 4 * 8 * 8; ++i )
+            data.get()[i] = i;
+
+        /* default chunk size: a single chunk covering the dataset */
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(Datatype::DOUBLE, extent));
+        rho.storeChunk({0, 0, 0}, extent, data);
+
+        MeshRecordComponent& j = o.iterations[1].meshes["j"][MeshRecordComponent::SCALAR];
+        j.resetDataset(Dataset(Datatype::DOUBLE, extent).setChunkSize({1, 8, 8}));
+        j.storeChunk({0, 0, 0}, extent, data);
+        o.flush();
+    }
+
+    /* views stay valid after the file has been closed */
+    std::shared_ptr< double const > view;
+    {
+        Series i = Series::read("../samples/serial_map.h5");
+        view = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR].mapChunk< double >({0, 0, 0}, Extent{4, 8, 8});
+    }
+    for( int k = 0; k < 4 * 8 * 8; ++k )
+        BOOST_TEST(view.get()[k] == static_cast< double >(k));
+
+    Series i = Series::read("../samples/serial_map.h5");
+    MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+    MeshRecordComponent& j = i.iterations[1].meshes["j"][MeshRecordComponent::SCALAR];
+
+    /* contiguous in the file: whole planes, and a part of a single row */
+    std::shared_ptr< double const > planes = rho.mapChunk< double >({1, 0, 0}, {2, 8, 8});
+    for( int k = 0; k < 2 * 8 * 8; ++k )
+        BOOST_TEST(planes.get()[k] == static_cast< double >(64 + k));
+    std::shared_ptr< double const > row = rho.mapChunk< double >({3, 5, 2}, {1, 1, 4});
+    for( int k = 0; k < 4; ++k )
+        BOOST_TEST(row.get()[k] == static_cast< double >(3 * 64 + 5 * 8 + 2 + k));
+
+    /* strided selections, conversions and multiple chunks are read into a buffer instead */
+    std::shared_ptr< double const > block = rho.mapChunk< double >({0, 2, 0}, {2, 2, 8});
+    for( int k = 0; k < 2; ++k )
+        for( int l = 0; l < 16; ++l )
+            BOOST_TEST(block.get()[k * 16 + l] == static_cast< double >(k * 64 + 16 + l));
+    std::shared_ptr< float const > converted = rho.mapChunk< float >({0, 0, 0}, extent);
+    for( int k = 0; k < 4 * 8 * 8; ++k )
+        BOOST_TEST(converted.get()[k] == static_cast< float >(k));
+    std::shared_ptr< double const > chunked = j.mapChunk< double >({0, 0, 0}, extent);
+    for( int k = 0; k < 4 * 8 * 8; ++k )
+        BOOST_TEST(chunked.get()[k] == static_cast< double >(k));
+
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_fixed_size_test)
+{
+    Extent const extent{16, 16, 16};
+    std::shared_ptr< double > data(new double[16 * 16 * 16], [](double* p){ delete[] p; });
+    std::iota(data.get(), data.get() + 16 * 16 * 16, 0.);
+    {
+        Series o = Series::create("../samples/serial_fixed_size.h5");
+        Mesh& fields = o.iterations[1].meshes["E"];
+        fields["x"].resetDataset(Dataset(Datatype::DOUBLE, extent).setFixedSize());
+        fields["y"].resetDataset(Dataset(Datatype::DOUBLE, {4}).setFixedSize());
+        fields["z"].resetDataset(Dataset(Datatype::DOUBLE, extent).setFixedSize().setCompression("zlib", 1));
+        fields["x"].storeChunk({0, 0, 0}, extent, data);
+        fields["y"].storeChunk({0}, {4}, data);
+        fields["z"].storeChunk({0, 0, 0}, extent, data);
+        o.flush();
+
+        BOOST_CHECK_THROW(Dataset(Datatype::DOUBLE, {4}).setFixedSize().extend({8}), std::runtime_error);
+        RecordComponent& ids = o.iterations[1].particles["e"]["id"][RecordComponent::SCALAR];
+        ids.resetDataset(Dataset(Datatype::DOUBLE, {0}).setFixedSize());
+        BOOST_CHECK_THROW(ids.append(data, 4), std::runtime_error);
+        ids.resetDataset(Dataset(Datatype::DOUBLE, {4}).setFixedSize());
+        ids.storeChunk({0}, {4}, data);
+    }
+
+    /* contiguous, compact and (compressed) chunked */
+    hid_t file = H5Fopen("../samples/serial_fixed_size.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    BOOST_REQUIRE(file >= 0);
+    for( auto const& expected : std::vector< std::pair< std::string, H5D_layout_t > >{
+             {"x", H5D_CONTIGUOUS}, {"y", H5D_COMPACT}, {"z", H5D_CHUNKED}} )
+    {
+        hid_t dataset = H5Dopen(file, ("/data/1/meshes/E/" + expected.first).c_str(), H5P_DEFAULT);
+        hid_t creation = H5Dget_create_plist(dataset);
+        BOOST_TEST(H5Pget_layout(creation) == expected.second);
+        H5Pclose(creation);
+        H5Dclose(dataset);
+    }
+    H5Fclose(file);
+
+    Series i = Series::read("../samples/serial_fixed_size.h5");
+    Mesh& fields = i.iterations[1].meshes["E"];
+    std::shared_ptr< double const > x = fields["x"].mapChunk< double >({2, 0, 0}, {2, 16, 16});
+    auto y = fields["y"].loadChunk< double >({0}, {4});
+    auto z = fields["z"].loadChunk< double >({0, 0, 0}, extent);
+    auto ids = i.iterations[1].particles["e"]["id"][RecordComponent::SCALAR].loadChunk< double >({0}, {4});
+    i.flush();
+    for( int k = 0; k < 2 * 16 * 16; ++k )
+        BOOST_TEST(x.get()[k] == static_cast< double >(2 * 16 * 16 + k));
+    for( int k = 0; k < 4; ++k )
+    {
+        BOOST_TEST(y.get()[k] == static_cast< double >(k));
+        BOOST_TEST(ids.get()[k] == static_cast< double >(k));
+    }
+    for( int k = 0; k < 16 * 16 * 16; ++k )
+        BOOST_TEST(z.get()[k] == static_cast< double >(k));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_io_statistics_test)
+{
+    Series o = Series::create("../samples/serial_io_statistics.h5");
+    std::shared_ptr< double > data(new double[8], [](double* p){ delete[] p; });
+    for( int i = 0; i < 8; ++i )
+        data.get()[i] = i;
+    RecordComponent& x = o.iterations[1].particles["e"]["position"]["x"];
+    x.resetDataset(Dataset(determineDatatype(data), {8}));
+    x.storeChunk({0}, {4}, data);
+    o.flush();
+    x.storeChunk({4}, {4}, std::shared_ptr< double >(data, data.get() + 4));
+    o.flush();
+
+    std::map< Operation, OperationStatistics > stats = o.ioStatistics();
+#if openPMD_HAVE_INSTRUMENTATION
+    BOOST_TEST(stats.count(Operation::CREATE_FILE) == 1);
+    BOOST_TEST(stats.at(Operation::CREATE_DATASET).count == 1);
+    BOOST_TEST(stats.at(Operation::WRITE_ATTS).count > 0);
+    OperationStatistics const& w = stats.at(Operation::WRITE_DATASET);
+    BOOST_TEST(w.count == 2);
+    BOOST_TEST(w.bytes == 8 * sizeof(double));
+    BOOST_TEST(w.seconds >= 0.);
+    uint64_t binned = 0;
+    for( auto n : w.histogram )
+        binned += n;
+    BOOST_TEST(binned == w.count);
+
+    o.resetIOStatistics();
+    BOOST_TEST(o.ioStatistics().empty());
+#else
+    BOOST_TEST(stats.empty());
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_io_trace_test)
+{
+    Series o = Series::create("../samples/serial_io_trace.h5");
+#if openPMD_HAVE_INSTRUMENTATION
+    o.startTrace("../samples/serial_io_trace_%R.json");
+    std::shared_ptr< double > data(new double[8], [](double* p){ delete[] p; });
+    RecordComponent& x = o.iterations[1].particles["e"]["position"]["x"];
+    x.resetDataset(Dataset(determineDatatype(data), {8}));
+    x.storeChunk({0}, {8}, data);
+    o.flush();
+    o.stopTrace();
+
+    std::ifstream in("../samples/serial_io_trace_0.json");
+    std::string trace((std::istreambuf_iterator< char >(in)), std::istreambuf_iterator< char >());
+    BOOST_TEST(auxiliary::starts_with(trace, "{\"traceEvents\": ["));
+    /* the Series has no position before its file is created, the event carries the one it has afterwards */
+    auto const createFile = trace.find("\"name\": \"CREATE_FILE\"");
+    BOOST_REQUIRE(createFile != std::string::npos);
+    std::string const event = trace.substr(createFile, trace.find('\n', createFile) - createFile);
+    BOOST_TEST(auxiliary::contains(event, "\"path\": \"/\", "));
+    BOOST_TEST(auxiliary::contains(trace, "\"name\": \"WRITE_DATASET\""));
+    BOOST_TEST(auxiliary::contains(trace, "\"path\": \"/data/1/particles/e/position/x\", \"bytes\": 64"));
+#else
+    BOOST_CHECK_THROW(o.startTrace("../samples/serial_io_trace_%R.json"), std::runtime_error);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_coalesced_write_test)
+{
+    {
+        Series o = Series::create("../samples/serial_coalesced_write.h5");
+        RecordComponent& x = o.iterations[1].particles["e"]["position"]["x"];
+        x.resetDataset(Dataset(Datatype::DOUBLE, {20}));
+
+        /* tiles written out of order, only abutting neighbours are merged */
+        for( uint64_t tile : {0, 1, 3, 2} )
+        {
+            std::shared_ptr< double > data(new double[5], [](double* d){ delete[] d; });
+            for( uint64_t i = 0; i < 5; ++i )
+                data.get()[i] = static_cast< double >(5 * tile + i);
+            x.storeChunk({5 * tile}, {5}, data);
+        }
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_coalesced_write.h5");
+    std::unique_ptr< double[] > data;
+    i.iterations[1].particles["e"]["position"]["x"].loadChunk({0}, {20}, data);
+    for( int j = 0; j < 20; ++j )
+        BOOST_TEST(data[j] == static_cast< double >(j));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_auto_chunking_test)
+{
+    Extent const extent{16, 64, 64};
+    {
+        Series o = Series::create("../samples/serial_auto_chunking.h5");
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+
+        Dataset d(Datatype::DOUBLE, extent);
+        d.setAutoChunking(1u << 14, Dataset::AccessPattern::SLICES);
+        rho.resetDataset(d);
+
+        std::shared_ptr< double > data(new double[16 * 64 * 64], [](double* p){ delete[] p; });
+        for( int i = 0; i < 16 * 64 * 64; ++i )
+            data.get()[i] = i;
+        rho.storeChunk({0, 0, 0}, extent, data);
+
+        /* a target larger than the dataset yields a single chunk */
+        MeshRecordComponent& j = o.iterations[1].meshes["j"][MeshRecordComponent::SCALAR];
+        Dataset large(Datatype::DOUBLE, extent);
+        large.setAutoChunking(1u << 21);
+        BOOST_TEST(large.chunkSize == Extent({16, 64, 64}));
+        j.resetDataset(large);
+        j.storeChunk({0, 0, 0}, extent, data);
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_auto_chunking.h5");
+    MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+    BOOST_TEST(rho.getExtent() == extent);
+    BOOST_TEST(rho.getChunkSize() == Extent({1, 32, 64}));
+    auto slabs = decompose(rho, 4);
+    BOOST_TEST((slabs[1].first == Offset{4, 0, 0}));
+    BOOST_TEST((slabs[1].second == Extent{4, 64, 64}));
+    std::unique_ptr< double[] > block;
+    i.iterations[1].meshes["j"][MeshRecordComponent::SCALAR].loadChunk({3, 0, 0}, {1, 64, 64}, block);
+    for( int j = 0; j < 64 * 64; ++j )
+        BOOST_TEST(block[j] == static_cast< double >(3 * 64 * 64 + j));
+    for( uint64_t plane : {0, 7, 15} )
+    {
+        std::unique_ptr< double[] > slice;
+        rho.loadChunk({plane, 0, 0}, {1, 64, 64}, slice);
+        for( int j = 0; j < 64 * 64; ++j )
+            BOOST_TEST(slice[j] == static_cast< double >(plane * 64 * 64 + j));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_chunk_cache_test)
+{
+    Extent const extent{32, 32, 32};
+    std::shared_ptr< double > data(new double[32 * 32 * 32], [](double* p){ delete[] p; });
+    std::iota(data.get(), data.get() + 32 * 32 * 32, 0.);
+    {
+        Series o = Series::create("../samples/serial_chunk_cache.h5");
+        o.setChunkCache(1u << 16, 0, 1.);
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        Dataset d(Datatype::DOUBLE, extent);
+        d.setChunkSize({8, 8, 8});
+        d.setCompression("zlib", 1);
+        d.setChunkCache(size_t(4) << 20, 12421, 0.);
+        rho.resetDataset(d);
+        rho.storeChunk({0, 0, 0}, extent, data);
+        MeshRecordComponent& phi = o.iterations[1].meshes["phi"][MeshRecordComponent::SCALAR];
+        phi.resetDataset(d);
+        phi.storeChunk({0, 0, 0}, extent, data);
+        o.flush();
+
+        BOOST_CHECK_THROW(d.setChunkCache(1u << 20, 0, 1.5), std::runtime_error);
+        BOOST_CHECK_THROW(o.setChunkCache(1u << 20, 0, -1.), std::runtime_error);
+    }
+
+    Series i = Series::read("../samples/serial_chunk_cache.h5");
+    i.setChunkCache(1u << 20);
+    MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+    std::shared_ptr< double > every = rho.loadStridedChunk< double >({0, 0, 0}, extent, {2, 2, 2});
+    i.flush();
+    /* a cache holding the whole dataset, the cached handle is re-opened with it */
+    rho.setChunkCache(size_t(1) << 20, 0, 0.5);
+    std::shared_ptr< double > again = rho.loadStridedChunk< double >({0, 0, 0}, extent, {2, 2, 2});
+    std::shared_ptr< double > slice = i.iterations[1].meshes["phi"][MeshRecordComponent::SCALAR].loadChunk< double >({5, 0, 0}, {1, 32, 32});
+    i.flush();
+
+    for( uint64_t x = 0; x < 16; ++x )
+        for( uint64_t y = 0; y < 16; ++y )
+            for( uint64_t z = 0; z < 16; ++z )
+            {
+                double expected = static_cast< double >(2 * x * 32 * 32 + 2 * y * 32 + 2 * z);
+                BOOST_TEST(every.get()[(x * 16 + y) * 16 + z] == expected);
+                BOOST_TEST(again.get()[(x * 16 + y) * 16 + z] == expected);
+            }
+    for( int j = 0; j < 32 * 32; ++j )
+        BOOST_TEST(slice.get()[j] == static_cast< double >(5 * 32 * 32 + j));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_dataset_handle_test)
+{
+    auto openDatasets = [](){ return H5Fget_obj_count(H5F_OBJ_ALL, H5F_OBJ_DATASET); };
+    ssize_t const before = openDatasets();
+    {
+        Series o = Series::create("../samples/serial_dataset_handles.h5");
+        RecordComponent& x = o.iterations[1].particles["e"]["position"]["x"];
+        x.resetDataset(Dataset(Datatype::DOUBLE, {0}));
+        for( uint64_t j = 0; j < 6; ++j )
+        {
+            /* the cached file space follows the growth of the dataset */
+            x.append(std::make_shared< double >(static_cast< double >(j)), 1);
+            o.flush();
+            /* the dataset stays open across the chunks written to it */
+            BOOST_TEST(openDatasets() == before + 1);
+        }
+
+        /* the number of cached datasets is bounded */
+        for( int j = 0; j < 200; ++j )
+        {
+            RecordComponent& c = o.iterations[1].meshes["m" + std::to_string(j)][MeshRecordComponent::SCALAR];
+            c.resetDataset(Dataset(Datatype::INT32, {1}));
+            c.storeChunk({0}, {1}, std::make_shared< int32_t >(j));
+        }
+        o.flush();
+        BOOST_TEST(openDatasets() > before + 1);
+        BOOST_TEST(openDatasets() <= before + 128);
+    }
+    /* closing the file closes its cached datasets */
+    BOOST_TEST(openDatasets() == before);
+
+    Series i = Series::read("../samples/serial_dataset_handles.h5");
+    RecordComponent& x = i.iterations[1].particles["e"]["position"]["x"];
+    BOOST_TEST(x.getExtent()[0] >= 6);
+    std::unique_ptr< double[] > data;
+    x.loadChunk({0}, {6}, data);
+    i.flush();
+    for( uint64_t j = 0; j < 6; ++j )
+        BOOST_TEST(data[j] == static_cast< double >(j));
+    std::shared_ptr< int32_t > last = i.iterations[1].meshes["m199"][MeshRecordComponent::SCALAR].loadChunk< int32_t >({0}, {1});
+    i.flush();
+    BOOST_TEST(*last == 199);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_allocation_test)
+{
+    auto fileSize = [](std::string const& name)
+    {
+        std::ifstream f(name, std::ios::binary | std::ios::ate);
+        return f ? static_cast< long >(f.tellg()) : -1l;
+    };
+    long const bytes = 256 * 256 * 8;
+    std::shared_ptr< double > data(new double[64 * 256], [](double* d){ delete[] d; });
+    std::iota(data.get(), data.get() + 64 * 256, 0.);
+    Dataset d(Datatype::DOUBLE, {256, 256});
+    d.setChunkSize({64, 256});
+
+    /* chunks are allocated as they are written */
+    {
+        Series o = Series::create("../samples/serial_allocation_default.h5");
+        o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR].resetDataset(d);
+        o.flush();
+    }
+    BOOST_TEST(fileSize("../samples/serial_allocation_default.h5") < bytes);
+
+    for( bool series : {false, true} )
+    {
+        std::string const name = series ? "../samples/serial_allocation_series.h5" : "../samples/serial_allocation_early.h5";
+        {
+            Series o = Series::create(name);
+            Dataset early = d;
+            if( series )
+                o.setAllocation(AllocationTime::EARLY, FillTime::ALLOCATION);
+            else
+                early.setAllocation(AllocationTime::EARLY, FillTime::ALLOCATION);
+            MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+            rho.resetDataset(early);
+            o.flush();
+            BOOST_TEST(fileSize(name) >= bytes);
+            rho.storeChunk({64, 0}, {64, 256}, data);
+            o.flush();
+        }
+
+        Series i = Series::read(name);
+        auto loaded = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0, 0}, {256, 256});
+        i.flush();
+        for( int j = 0; j < 256 * 256; ++j )
+            BOOST_TEST(loaded.get()[j] == (j >= 64 * 256 && j < 128 * 256 ? static_cast< double >(j - 64 * 256) : 0.));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_in_memory_test)
+{
+    auto fileSize = [](std::string const& name)
+    {
+        std::ifstream f(name, std::ios::binary | std::ios::ate);
+        return f ? static_cast< long >(f.tellg()) : -1l;
+    };
+    std::shared_ptr< double > data(new double[100], [](double* d){ delete[] d; });
+    std::iota(data.get(), data.get() + 100, 0.);
+
+    HDF5Options options;
+    options.inMemory = true;
+    options.memoryIncrement = 1u << 16;
+    {
+        Series o = Series::create("../samples/serial_in_memory.h5", options);
+        for( uint64_t it = 0; it < 20; ++it )
+        {
+            MeshRecordComponent& rho = o.iterations[it].meshes["rho"][MeshRecordComponent::SCALAR];
+            rho.resetDataset(Dataset(determineDatatype(data), {100}));
+            rho.storeChunk({0}, {100}, data);
+            o.flush();
+        }
+    }
+    /* the memory image has been written when the file was closed */
+    BOOST_TEST(fileSize("../samples/serial_in_memory.h5") > 0);
+
+    options.persistOnFlush = true;
+    {
+        Series o = Series::create("../samples/serial_in_memory_persisted.h5", options);
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(determineDatatype(data), {100}));
+        rho.storeChunk({0}, {100}, data);
+        o.flush();
+    }
+    Series persisted = Series::read("../samples/serial_in_memory_persisted.h5");
+    BOOST_TEST(persisted.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR].getExtent() == Extent({100}));
+
+    Series i = Series::read("../samples/serial_in_memory.h5", options);
+    BOOST_TEST(i.iterations.size() == 20u);
+    std::shared_ptr< double > loaded = i.iterations[19].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0}, {100});
+    i.flush();
+    for( int j = 0; j < 100; ++j )
+        BOOST_TEST(loaded.get()[j] == static_cast< double >(j));
+
+    BOOST_CHECK_THROW(Series::create("../samples/serial_in_memory.bp", options), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_persist_threads_test)
+{
+    HDF5Options options;
+    options.inMemory = true;
+    options.persistThreads = 4;
+    {
+        Series o = Series::create("../samples/serial_persist_threads%T.h5", options);
+        for( uint64_t it = 0; it < 16; ++it )
+        {
+            std::shared_ptr< double > data(new double[1000], [](double* d){ delete[] d; });
+            for( int j = 0; j < 1000; ++j )
+                data.get()[j] = static_cast< double >(it * 1000 + j);
+            MeshRecordComponent& rho = o.iterations[it].meshes["rho"][MeshRecordComponent::SCALAR];
+            rho.resetDataset(Dataset(Datatype::DOUBLE, {1000}));
+            rho.storeChunk({0}, {1000}, data);
+            /* the file is written in the background while the next iteration is built */
+            o.iterations[it].close();
+        }
+    }
+
+    Series i = Series::read("../samples/serial_persist_threads%T.h5");
+    BOOST_TEST(i.iterations.size() == 16u);
+    for( uint64_t it = 0; it < 16; ++it )
+    {
+        std::shared_ptr< double > loaded = i.iterations[it].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0}, {1000});
+        i.flush();
+        BOOST_TEST(loaded.get()[999] == static_cast< double >(it * 1000 + 999));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_filter_threads_test)
+{
+    auto fileSize = [](std::string const& name)
+    {
+        std::ifstream f(name, std::ios::binary | std::ios::ate);
+        return f ? static_cast< long >(f.tellg()) : -1l;
+    };
+    std::shared_ptr< double > data(new double[50 * 30], [](double* d){ delete[] d; });
+    for( int j = 0; j < 50 * 30; ++j )
+        data.get()[j] = static_cast< double >(j % 7);
+    auto at = [&data](uint64_t row, uint64_t column){ return data.get()[row * 30 + column]; };
+    auto part = [&data](uint64_t firstRow){ return std::shared_ptr< double >(data, data.get() + firstRow * 30); };
+
+    HDF5Options options;
+    options.filterThreads = 4;
+    {
+        Series o = Series::create("../samples/serial_filter_threads.h5", options);
+        Dataset d(Datatype::DOUBLE, {50, 30});
+        d.setChunkSize({16, 8});
+        d.setCompression("zlib", 4);
+        Mesh& E = o.iterations[1].meshes["E"];
+        for( std::string c : {"x", "y", "z", "w"} )
+            E[c].resetDataset(d);
+        /* aligned to the chunks (including the edge chunks ending with the dataset) */
+        E["x"].storeChunk({0, 0}, {50, 30}, data);
+        /* chunks abutting in one flush would be written as one */
+        E["y"].storeChunk({0, 0}, {16, 30}, data);
+        o.flush();
+        E["y"].storeChunk({16, 0}, {34, 30}, part(16));
+        /* not aligned, filtered by HDF5 */
+        E["z"].storeChunk({0, 0}, {10, 30}, data);
+        o.flush();
+        E["z"].storeChunk({10, 0}, {40, 30}, part(10));
+        /* half of the chunks hold the fill value */
+        E["w"].storeChunk({0, 0}, {32, 30}, data);
+        o.flush();
+    }
+    BOOST_TEST(fileSize("../samples/serial_filter_threads.h5") < 4l * 50 * 30 * 8);
+
+    /* the same file as written by HDF5 */
+    for( bool threads : {false, true} )
+    {
+        Series i = threads ? Series::read("../samples/serial_filter_threads.h5", options)
+                           : Series::read("../samples/serial_filter_threads.h5");
+        Mesh& E = i.iterations[1].meshes["E"];
+        std::map< std::string, std::shared_ptr< double > > full;
+        for( std::string c : {"x", "y", "z", "w"} )
+            full[c] = E[c].loadChunk< double >({0, 0}, {50, 30});
+        auto aligned = E["x"].loadChunk< double >({16, 8}, {16, 8});
+        auto unaligned = E["y"].loadChunk< double >({3, 5}, {7, 9});
+        i.flush();
+
+        for( uint64_t row = 0; row < 50; ++row )
+            for( uint64_t column = 0; column < 30; ++column )
+            {
+                for( std::string c : {"x", "y", "z"} )
+                    BOOST_TEST(full[c].get()[row * 30 + column] == at(row, column));
+                BOOST_TEST(full["w"].get()[row * 30 + column] == (row < 32 ? at(row, column) : 0.));
+            }
+        for( uint64_t row = 0; row < 16; ++row )
+            for( uint64_t column = 0; column < 8; ++column )
+                BOOST_TEST(aligned.get()[row * 8 + column] == at(16 + row, 8 + column));
+        for( uint64_t row = 0; row < 7; ++row )
+            for( uint64_t column = 0; column < 9; ++column )
+                BOOST_TEST(unaligned.get()[row * 9 + column] == at(3 + row, 5 + column));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_typed_view_test)
+{
+    {
+        Series o = Series::create("../samples/serial_typed_view.h5");
+        auto& x = o.iterations[1].particles["e"]["position"]["x"];
+        x.resetDataset(Dataset(Datatype::FLOAT, {64}));
+        x.setUnitSI(0.5);
+        auto& y = o.iterations[1].particles["e"]["position"]["y"];
+        y.resetDataset(Dataset(Datatype::FLOAT, {64}));
+        y.makeConstant(2.f);
+        y.setUnitSI(0.5);
+        TypedRecordComponent< float > view = x.typed< float >();
+        for( uint64_t i = 0; i < 64; i += 16 )
+        {
+            std::shared_ptr< float > chunk(new float[16], [](float* p){ delete[] p; });
+            std::iota(chunk.get(), chunk.get() + 16, static_cast< float >(i));
+            view.storeChunk({i}, {16}, chunk);
+        }
+        BOOST_CHECK_THROW(view.storeChunk({60}, {16}, std::shared_ptr< float >(new float[16], [](float* p){ delete[] p; })), std::runtime_error);
+        BOOST_CHECK_THROW(x.typed< double >().storeChunk({0}, {1}, std::make_shared< double >(0.)), std::runtime_error);
+        BOOST_CHECK_THROW(x.typed< bool >(), std::runtime_error);
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_typed_view.h5");
+    auto& position = i.iterations[1].particles["e"]["position"];
+    /* loading converts to the type of the view and scales to its unit */
+    TypedRecordComponent< double > x = position["x"].typed< double >(1.);
+    TypedRecordComponent< double > y = position["y"].typed< double >(1.);
+    std::shared_ptr< double > all = x.loadChunk({0}, {64});
+    std::shared_ptr< double > part(new double[8], [](double* p){ delete[] p; });
+    x.loadChunk({8}, {8}, part);
+    std::shared_ptr< double > constant = y.loadChunk({0}, {4});
+    i.flush();
+    for( int j = 0; j < 64; ++j )
+        BOOST_TEST(all.get()[j] == 0.5 * j);
+    for( int j = 0; j < 8; ++j )
+        BOOST_TEST(part.get()[j] == 0.5 * (8 + j));
+    for( int j = 0; j < 4; ++j )
+        BOOST_TEST(constant.get()[j] == 1.);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_fileBased_manifest_test)
+{
+    {
+        Series o = Series::create("../samples/serial_manifest%T.h5");
+        o.setManifest(true);
+        for( uint64_t it = 1; it <= 3; ++it )
+        {
+            o.iterations[it].setTime(static_cast< double >(it));
+            o.flush();
+        }
+        BOOST_CHECK_THROW(Series::create("../samples/serial_manifest.h5").setManifest(true), std::runtime_error);
+    }
+    /* a file matching the pattern that has not been written by the Series */
+    std::ofstream("../samples/serial_manifest99.h5") << "no HDF5";
+
+    {
+        Series i = Series::read("../samples/serial_manifest%T.h5");
+        BOOST_TEST(i.iterations.size() == 3);
+        BOOST_TEST(i.iterations[3].time< double >() == 3.);
+    }
+
+    /* without a manifest, the directory is listed */
+    std::remove("../samples/serial_manifest%T.manifest");
+    Series i = Series::read("../samples/serial_manifest%T.h5");
+    BOOST_TEST(i.iterations.size() == 4);
+    std::remove("../samples/serial_manifest99.h5");
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_metadata_snapshot_test)
+{
+    {
+        Series o = Series::create("../samples/serial_snapshot.h5");
+        o.iterations[1].setTime(2.5);
+        MeshRecordComponent& rho = o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+        std::shared_ptr< double > data(new double[10], [](double* d){ delete[] d; });
+        for( int i = 0; i < 10; ++i )
+            data.get()[i] = i;
+        rho.resetDataset(Dataset(Datatype::DOUBLE, {10}));
+        rho.storeChunk({0}, {10}, data);
+        o.flush();
+    }
+    std::remove("../samples/.openPMD-snapshots/serial_snapshot.h5.snapshot");
+
+    HDF5Options options;
+    options.metadataSnapshots = true;
+    /* the first read records the snapshot, the second one replays it */
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        {
+            Series i = Series::read("../samples/serial_snapshot.h5", options);
+            BOOST_TEST(i.iterations[1].time< double >() == 2.5);
+            MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+            BOOST_TEST(rho.getDatatype() == Datatype::DOUBLE);
+            BOOST_TEST(rho.getExtent() == Extent{10});
+            std::unique_ptr< double[] > data;
+            rho.loadChunk({2}, {3}, data);
+            BOOST_TEST(data[0] == 2.);
+            BOOST_TEST(data[2] == 4.);
+        }
+        BOOST_TEST(std::ifstream("../samples/.openPMD-snapshots/serial_snapshot.h5.snapshot").good());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_concurrent_chunks_test)
+{
+    std::vector< std::string > const components{"x", "y", "z", "w"};
+    {
+        Series o = Series::create("../samples/serial_concurrent.h5");
+        /* small enough that automatic flushes interleave with the registration of other threads */
+        o.setStagingBudget(4000, StagingMode::COPY);
+        Mesh& E = o.iterations[1].meshes["E"];
+        for( auto const& c : components )
+            E[c].resetDataset(Dataset(Datatype::DOUBLE, {1000}));
+        o.flush();
+
+        std::vector< std::thread > threads;
+        for( std::size_t t = 0; t < components.size(); ++t )
+            threads.emplace_back([&E, &components, t]()
+            {
+                MeshRecordComponent& rc = E[components[t]];
+                for( uint64_t chunk = 0; chunk < 10; ++chunk )
+                {
+                    std::shared_ptr< double > data(new double[100], [](double* d){ delete[] d; });
+                    for( uint64_t i = 0; i < 100; ++i )
+                        data.get()[i] = static_cast< double >(t * 1000 + chunk * 100 + i);
+                    rc.storeChunk({chunk * 100}, {100}, data);
+                }
+            });
+        for( auto& thread : threads )
+            thread.join();
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_concurrent.h5");
+    Mesh& E = i.iterations[1].meshes["E"];
+    std::vector< std::shared_ptr< double > > loaded(components.size());
+    std::vector< std::thread > threads;
+    for( std::size_t t = 0; t < components.size(); ++t )
+        threads.emplace_back([&E, &components, &loaded, t]()
+        {
+            loaded[t] = E[components[t]].loadChunk< double >({0}, {1000});
+        });
+    for( auto& thread : threads )
+        thread.join();
+    i.flush();
+    for( std::size_t t = 0; t < components.size(); ++t )
+        for( uint64_t j = 0; j < 1000; ++j )
+            BOOST_TEST(loaded[t].get()[j] == static_cast< double >(t * 1000 + j));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_compression_test)
+{
+    /* compression formats with their level and the HDF5 filter id they are written with */
+    struct Codec
+    {
+        std::string name;
+        uint8_t level;
+        H5Z_filter_t filter;
+        bool available;
+    };
+    std::vector< Codec > codecs{
+        {"zlib", 6, H5Z_FILTER_DEFLATE, false},
+        {"blosc", 5, 32001, false},
+        {"blosc-zstd", 3, 32001, false},
+        {"lz4", 0, 32004, false},
+        {"zstd", 3, 32015, false}};
+    for( auto& codec : codecs )
+    {
+        codec.available = H5Zfilter_avail(codec.filter) > 0;
+        if( !codec.available )
+            BOOST_TEST_MESSAGE("Filter for " << codec.name << " not available, "
+                               "skipping the check of its filter pipeline");
+    }
+
+    {
+        Series o = Series::create("../samples/serial_compression.h5");
+
+        std::shared_ptr< double > data(new double[1000], [](double* d){ delete[] d; });
+        for( int i = 0; i < 1000; ++i )
+            data.get()[i] = i % 10;
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        for( auto const& codec : codecs )
+        {
+            Dataset d(Datatype::DOUBLE, {1000});
+            d.setChunkSize({100});
+            d.setCompression(codec.name, codec.level);
+            /* unavailable filter plugins are skipped, data is written uncompressed */
+            e[codec.name][RecordComponent::SCALAR].resetDataset(d);
+            e[codec.name][RecordComponent::SCALAR].storeChunk({0}, {1000}, data);
+        }
+        o.flush();
+    }
+
+    /* available filters are the only stage of the filter pipeline of their dataset */
+    hid_t file = H5Fopen("../samples/serial_compression.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    BOOST_REQUIRE(file >= 0);
+    for( auto const& codec : codecs )
+    {
+        hid_t dataset = H5Dopen(file, ("/data/1/particles/e/" + codec.name).c_str(), H5P_DEFAULT);
+        hid_t dcpl = H5Dget_create_plist(dataset);
+        if( codec.available )
+        {
+            BOOST_TEST(H5Pget_nfilters(dcpl) == 1);
+            unsigned int flags;
+            std::size_t numValues = 8;
+            unsigned int values[8];
+            char name[64];
+            unsigned int config;
+            BOOST_TEST(H5Pget_filter2(dcpl, 0, &flags, &numValues, values, sizeof(name), name, &config) == codec.filter);
+            /* Blosc selects its compressor by the last value, lz4 (1) unless given */
+            if( codec.filter == 32001 )
+            {
+                BOOST_REQUIRE(numValues == 7);
+                BOOST_TEST(values[6] == (codec.name == "blosc-zstd" ? 5u : 1u));
+            }
+        } else
+            BOOST_TEST(H5Pget_nfilters(dcpl) == 0);
+        H5Pclose(dcpl);
+        H5Dclose(dataset);
+    }
+    H5Fclose(file);
+
+    Series i = Series::read("../samples/serial_compression.h5");
+    for( auto const& codec : codecs )
+    {
+        std::unique_ptr< double[] > data;
+        i.iterations[1].particles["e"][codec.name][RecordComponent::SCALAR].loadChunk({0}, {1000}, data);
+        for( int j = 0; j < 1000; ++j )
+            BOOST_TEST(data[j] == static_cast< double >(j % 10));
+    }
+
+    Dataset d(Datatype::DOUBLE, {1});
+    BOOST_CHECK_THROW(d.setCompression("zlib", 10), std::runtime_error);
+    BOOST_CHECK_THROW(d.setCompression("blosc-snappy", 5), std::runtime_error);
+    BOOST_CHECK_THROW(d.setCompression("zstd", 0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_lossy_compression_test)
+{
+    double const tolerance = 1e-3;
+    /* filter plugins, each with its record component and the HDF5 filter id it registers */
+    struct Codec
+    {
+        std::string name;
+        std::string component;
+        H5Z_filter_t filter;
+        bool available;
+    };
+    std::vector< Codec > codecs{{"zfp", "x", 32013, false}, {"sz", "y", 32017, false}};
+    for( auto& codec : codecs )
+    {
+        codec.available = H5Zfilter_avail(codec.filter) > 0;
+        if( !codec.available )
+            BOOST_TEST_MESSAGE("Filter plugin " << codec.name << " not available, "
+                               "skipping the checks of its compression ratio and error bound");
+    }
+
+    {
+        Series o = Series::create("../samples/serial_lossy_compression.h5");
+
+        std::shared_ptr< double > field(new double[64 * 64], [](double* d){ delete[] d; });
+        for( int i = 0; i < 64 * 64; ++i )
+            field.get()[i] = std::sin(0.01 * i);
+        std::shared_ptr< uint64_t > ids(new uint64_t[64], [](uint64_t* d){ delete[] d; });
+        for( uint64_t i = 0; i < 64; ++i )
+            ids.get()[i] = (uint64_t(1) << 40) + i;
+
+        Mesh& E = o.iterations[1].meshes["E"];
+        Dataset zfp(Datatype::DOUBLE, {64, 64});
+        zfp.setChunkSize({32, 32});
+        zfp.setCompression("zfp", "accuracy", tolerance);
+        Dataset sz(Datatype::DOUBLE, {64, 64});
+        sz.setChunkSize({32, 32});
+        sz.setCompression("sz", "abs", tolerance);
+        /* unavailable filter plugins are skipped, data is written uncompressed */
+        E["x"].resetDataset(zfp);
+        E["x"].storeChunk({0, 0}, {64, 64}, field);
+        E["y"].resetDataset(sz);
+        E["y"].storeChunk({0, 0}, {64, 64}, field);
+
+        /* integer datasets are never compressed lossily */
+        Dataset lossless(Datatype::UINT64, {64});
+        lossless.setCompression("zfp", "rate", 8.);
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["id"][RecordComponent::SCALAR].resetDataset(lossless);
+        e["id"][RecordComponent::SCALAR].storeChunk({0}, {64}, ids);
+        o.flush();
+    }
+
+    /* compressed data takes less space than the raw values, uncompressed data exactly as much */
+    hid_t file = H5Fopen("../samples/serial_lossy_compression.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    BOOST_REQUIRE(file >= 0);
+    hsize_t const raw = 64 * 64 * sizeof(double);
+    for( auto const& codec : codecs )
+    {
+        hid_t dataset = H5Dopen(file, ("/data/1/meshes/E/" + codec.component).c_str(), H5P_DEFAULT);
+        hsize_t const stored = H5Dget_storage_size(dataset);
+        if( codec.available )
+            BOOST_TEST(stored < raw);
+        else
+            BOOST_TEST(stored == raw);
+        H5Dclose(dataset);
+    }
+    H5Fclose(file);
+
+    {
+        Series i = Series::read("../samples/serial_lossy_compression.h5");
+        std::map< std::string, std::shared_ptr< double > > loaded;
+        for( auto const& codec : codecs )
+            loaded[codec.name] = i.iterations[1].meshes["E"][codec.component].loadChunk< double >({0, 0}, {64, 64});
+        auto ids = i.iterations[1].particles["e"]["id"][RecordComponent::SCALAR].loadChunk< uint64_t >({0}, {64});
+        i.flush();
+        for( auto const& codec : codecs )
+        {
+            double maxError = 0.;
+            for( int j = 0; j < 64 * 64; ++j )
+                maxError = std::max(maxError, std::abs(loaded[codec.name].get()[j] - std::sin(0.01 * j)));
+            if( codec.available )
+                BOOST_TEST(maxError <= tolerance);
+            else
+                BOOST_TEST(maxError == 0.);
+        }
+        for( uint64_t j = 0; j < 64; ++j )
+            BOOST_TEST(ids.get()[j] == (uint64_t(1) << 40) + j);
+    }
+
+    Dataset d(Datatype::DOUBLE, {1});
+    d.setCompression("zfp", "precision", 16.);
+    BOOST_TEST(d.compression == "zfp:precision:16");
+    BOOST_CHECK_THROW(d.setCompression("zfp", "abs", 1e-3), std::runtime_error);
+    BOOST_CHECK_THROW(d.setCompression("zfp", "precision", 0.5), std::runtime_error);
+    BOOST_CHECK_THROW(d.setCompression("sz", "abs", -1.), std::runtime_error);
+    BOOST_CHECK_THROW(d.setCompression("mgard", "abs", 1e-3), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_advance_test)
+{
+    {
+        Series o = Series::create("../samples/advance.h5");
+        o.iterations[1].setTime(1.);
+        o.flush();
+        BOOST_CHECK_THROW(o.advance(), std::runtime_error);
+    }
+
+    /* files consist of a single step */
+    Series i = Series::read("../samples/advance.h5");
+    BOOST_TEST(i.iterations.count(1) == 1);
+    BOOST_TEST((i.advance() == AdvanceStatus::OVER));
+    BOOST_TEST(i.iterations.count(1) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_refresh_test)
+{
+    std::shared_ptr< double > data(new double[4]{1., 2., 3., 4.}, [](double* d){ delete[] d; });
+    auto write = [&data](Series& o, uint64_t index)
+    {
+        Iteration& it = o.iterations[index];
+        it.setTime(static_cast< double >(index));
+        MeshRecordComponent& rho = it.meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(Datatype::DOUBLE, {4}));
+        rho.storeChunk({0}, {4}, data);
+        o.flush();
+    };
+
+    {
+        Series o = Series::create("../samples/refresh.h5");
+        write(o, 1);
+        BOOST_CHECK_THROW(o.refresh(), std::runtime_error);
+
+        Series i = Series::read("../samples/refresh.h5");
+        BOOST_TEST(i.iterations.size() == 1);
+        BOOST_TEST(i.iterations[1].time< double >() == 1.);
+
+        write(o, 2);
+        write(o, 3);
+        i.refresh();
+        BOOST_TEST(i.iterations.size() == 3);
+        BOOST_TEST(i.iterations[1].time< double >() == 1.);
+        BOOST_TEST(i.iterations[3].time< double >() == 3.);
+        auto loaded = i.iterations[2].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0}, {4});
+        i.flush();
+        BOOST_TEST(std::equal(data.get(), data.get() + 4, loaded.get()));
+
+        /* nothing new */
+        i.refresh();
+        BOOST_TEST(i.iterations.size() == 3);
+    }
+
+    std::remove("../samples/refresh_1.h5");
+    std::remove("../samples/refresh_2.h5");
+    {
+        /* no file exists at opening */
+        Series i = Series::read("../samples/refresh_%T.h5");
+        BOOST_TEST(i.iterations.size() == 0);
+
+        Series o = Series::create("../samples/refresh_%T.h5");
+        write(o, 1);
+        i.refresh();
+        BOOST_TEST(i.iterations.size() == 1);
+
+        write(o, 2);
+        i.refresh();
+        BOOST_TEST(i.iterations.size() == 2);
+        auto loaded = i.iterations[2].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0}, {4});
+        i.flush();
+        BOOST_TEST(std::equal(data.get(), data.get() + 4, loaded.get()));
+    }
+
+    /* filtered iterations stay excluded */
+    ReadFilter filter;
+    filter.lastIteration = 1;
+    Series i = Series::read("../samples/refresh.h5", filter);
+    i.refresh();
+    BOOST_TEST(i.iterations.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_bool_test)
+{
+    {
+        Series o = Series::create("../samples/serial_bool.h5");
+
+        o.setAttribute("Bool attribute (true)", true);
+        o.setAttribute("Bool attribute (false)", false);
+    }
+    {
+        Series o = Series::read("../samples/serial_bool.h5");
+
+        auto attrs = o.attributes();
+        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "Bool attribute (true)") == 1);
+        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "Bool attribute (false)") == 1);
+        BOOST_TEST(o.getAttribute("Bool attribute (true)").get< bool >() == true);
+        BOOST_TEST(o.getAttribute("Bool attribute (false)").get< bool >() == false);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_attribute_dirty_test)
+{
+    {
+        Series o = Series::create("../samples/serial_dirty_%T.h5");
+        o.setAuthor("Dirty HDF5");
+        o.setAttribute("unchanged", 1);
+        o.setAttribute("changed", 1);
+        o.iterations[1].setTime(1.);
+        o.iterations[2].setTime(2.);
+        o.flush();
+
+        /* only the modified attributes are written to existing files, but into all of them */
+        o.setAttribute("changed", 2);
+        o.setAttribute("added", std::string("new"));
+        o.iterations[2].setTime(3.);
+        o.flush();
+
+        /* new files still receive all attributes */
+        o.iterations[3].setTime(4.);
+        o.flush();
+    }
+    {
+        Series i = Series::read("../samples/serial_dirty_%T.h5");
+        BOOST_TEST(i.author() == "Dirty HDF5");
+        BOOST_TEST(i.getAttribute("unchanged").get< int >() == 1);
+        BOOST_TEST(i.getAttribute("changed").get< int >() == 2);
+        BOOST_TEST(i.getAttribute("added").get< std::string >() == "new");
+        BOOST_TEST(i.iterations.size() == 3);
+        BOOST_TEST(i.iterations[1].time< double >() == 1.);
+        BOOST_TEST(i.iterations[2].time< double >() == 3.);
+        BOOST_TEST(i.iterations[3].time< double >() == 4.);
+    }
+    for( uint64_t it = 1; it <= 3; ++it )
+    {
+        Series i = Series::read("../samples/serial_dirty_" + std::to_string(it) + ".h5");
+        BOOST_TEST(i.getAttribute("changed").get< int >() == 2);
+        BOOST_TEST(i.getAttribute("added").get< std::string >() == "new");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_async_write_test)
+{
+    {
+        Series o = Series::create("../samples/serial_async_write.h5");
+
+        std::shared_ptr< double > data(new double[10], [](double* d){ delete[] d; });
+        for( int i = 0; i < 10; ++i )
+            data.get()[i] = i;
+
+        for( uint64_t it = 1; it <= 3; ++it )
+        {
+            RecordComponent& x = o.iterations[it].particles["e"]["position"]["x"];
+            x.resetDataset(Dataset(determineDatatype(data), {10}));
+            x.storeChunk({0}, {10}, data);
+
+            std::future< void > done = o.flushAsync();
+            done.get();
+        }
+
+        /* a pending asynchronous flush is completed by the next synchronous one */
+        o.setAuthor("Async HDF5");
+        std::future< void > pending = o.flushAsync();
+        o.flush();
+        BOOST_TEST((pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready));
+    }
+    {
+        Series i = Series::read("../samples/serial_async_write.h5");
+        BOOST_TEST(i.author() == "Async HDF5");
+        BOOST_TEST(i.iterations.size() == 3);
+
+        for( auto& it : i.iterations )
+        {
+            RecordComponent& x = it.second.particles["e"]["position"]["x"];
+            BOOST_TEST(x.getExtent() == Extent{10});
+            std::unique_ptr< double[] > data;
+            x.loadChunk({0}, {10}, data);
+            for( int j = 0; j < 10; ++j )
+                BOOST_TEST(data[j] == static_cast< double >(j));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_double_buffered_write_test)
+{
+    {
+        Series o = Series::create("../samples/serial_double_buffered%T.h5");
+        o.setAsyncWrites(true);
+
+        /* the buffer of the simulation, re-filled in every step */
+        std::shared_ptr< double > field(new double[1000], [](double* d){ delete[] d; });
+        for( uint64_t it = 1; it <= 4; ++it )
+        {
+            std::fill_n(field.get(), 1000, static_cast< double >(it));
+            MeshRecordComponent& rho = o.iterations[it].meshes["rho"][MeshRecordComponent::SCALAR];
+            rho.resetDataset(Dataset(Datatype::DOUBLE, {10, 100}));
+            rho.storeChunk({0, 0}, {10, 100}, field);
+            o.flush();
+
+            /* the next step is computed while the data of this one is written */
+            std::fill_n(field.get(), 1000, -1.);
+            BOOST_TEST(o.stagingStatus().stagedChunks == 0u);
+        }
+        o.awaitWrites();
+        BOOST_TEST(!o.stagingStatus().flushing);
+        BOOST_TEST(o.stagingStatus().autoFlushes == 0u);
+    }
+    {
+        Series i = Series::read("../samples/serial_double_buffered%T.h5");
+        BOOST_TEST(i.iterations.size() == 4u);
+        for( auto& it : i.iterations )
+        {
+            auto rho = it.second.open().meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0, 0}, {10, 100});
+            i.flush();
+            BOOST_TEST(rho.get()[0] == static_cast< double >(it.first));
+            BOOST_TEST(rho.get()[999] == static_cast< double >(it.first));
+        }
+        BOOST_CHECK_THROW(i.setAsyncWrites(true), std::runtime_error);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_staged_write_test)
+{
+    for( int it = 1; it <= 3; ++it )
+        std::remove(("../samples/staged/serial_staged" + std::to_string(it) + ".h5").c_str());
+    {
+        Series o = Series::create("../samples/staged/serial_staged%T.h5", "../samples/staging");
+        o.setManifest(true);
+        std::shared_ptr< double > field(new double[1000], [](double* d){ delete[] d; });
+        for( uint64_t it = 1; it <= 3; ++it )
+        {
+            std::fill_n(field.get(), 1000, static_cast< double >(it));
+            MeshRecordComponent& rho = o.iterations[it].meshes["rho"][MeshRecordComponent::SCALAR];
+            rho.resetDataset(Dataset(Datatype::DOUBLE, {10, 100}));
+            rho.storeChunk({0, 0}, {10, 100}, field);
+            o.flush();
+            BOOST_TEST(std::ifstream("../samples/staging/serial_staged" + std::to_string(it) + ".h5").good());
+            BOOST_TEST(!std::ifstream("../samples/staged/serial_staged" + std::to_string(it) + ".h5").good());
+        }
+
+        o.iterations[1].close();
+        o.iterations[2].close();
+        o.awaitDrain();
+        DrainStatus status = o.drainStatus();
+        BOOST_TEST(status.drainedFiles == 2u);
+        BOOST_TEST(status.pendingFiles == 0u);
+        BOOST_TEST(status.pendingBytes == 0u);
+        BOOST_TEST(status.drainedBytes > 16000u);
+        BOOST_TEST(std::ifstream("../samples/staged/serial_staged2.h5").good());
+        BOOST_TEST(!std::ifstream("../samples/staging/serial_staged2.h5").good());
+        BOOST_TEST(std::ifstream("../samples/staging/serial_staged3.h5").good());
+    }
+    BOOST_TEST(!std::ifstream("../samples/staging/serial_staged3.h5").good());
+    BOOST_TEST(std::ifstream("../samples/staged/serial_staged%T.manifest").good());
+    {
+        Series i = Series::read("../samples/staged/serial_staged%T.h5");
+        BOOST_TEST(i.iterations.size() == 3u);
+        for( auto& it : i.iterations )
+        {
+            auto rho = it.second.open().meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0, 0}, {10, 100});
+            i.flush();
+            BOOST_TEST(rho.get()[999] == static_cast< double >(it.first));
+        }
+        BOOST_TEST(i.drainStatus().drainedFiles == 0u);
+    }
+
+    {
+        Series o = Series::create("../samples/staged/serial_staged.h5", "../samples/staging");
+        o.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR].makeConstant(1.5);
+        o.flush();
+        BOOST_TEST(std::ifstream("../samples/staging/serial_staged.h5").good());
+    }
+    {
+        Series i = Series::read("../samples/staged/serial_staged.h5");
+        BOOST_TEST(i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR].getAttribute("value").get< double >() == 1.5);
+    }
+
+    BOOST_CHECK_THROW(Series::create("../samples/staged/serial_staged.h5", ""), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_overwrite_test)
+{
+    std::shared_ptr< double > field(new double[1000], [](double* d){ delete[] d; });
+    {
+        Series o = Series::create("../samples/serial_overwrite.h5");
+        std::fill_n(field.get(), 1000, 0.);
+        MeshRecordComponent& rho = o.iterations[0].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(Datatype::DOUBLE, {10, 100}));
+        rho.storeChunk({0, 0}, {10, 100}, field);
+        o.iterations[0].particles["e"]["charge"][RecordComponent::SCALAR].makeConstant(-1.);
+        o.flush();
+        BOOST_CHECK_THROW(rho.resetDataset(Dataset(Datatype::DOUBLE, {10, 100})), std::runtime_error);
+    }
+
+    auto fileSize = []()
+    {
+        std::ifstream f("../samples/serial_overwrite.h5", std::ios::binary | std::ios::ate);
+        return static_cast< std::size_t >(f.tellg());
+    };
+    std::size_t size = 0;
+    for( int step = 1; step <= 3; ++step )
+    {
+        {
+            Series o = Series::read("../samples/serial_overwrite.h5", AccessType::READ_WRITE);
+            o.setOverwriteMode(true);
+            std::fill_n(field.get(), 1000, static_cast< double >(step));
+            MeshRecordComponent& rho = o.iterations[0].meshes["rho"][MeshRecordComponent::SCALAR];
+            rho.resetDataset(Dataset(Datatype::DOUBLE, {10, 100}));
+            rho.storeChunk({0, 0}, {10, 100}, field);
+            o.iterations[0].particles["e"]["charge"][RecordComponent::SCALAR].makeConstant(static_cast< double >(-step));
+            o.flush();
+        }
+        if( step == 1 )
+            size = fileSize();
+        else
+            BOOST_TEST(fileSize() == size);
+    }
+    {
+        Series i = Series::read("../samples/serial_overwrite.h5");
+        auto rho = i.iterations[0].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({0, 0}, {10, 100});
+        i.flush();
+        BOOST_TEST(rho.get()[999] == 3.);
+        BOOST_TEST(i.iterations[0].particles["e"]["charge"][RecordComponent::SCALAR].getAttribute("value").get< double >() == -3.);
+        BOOST_CHECK_THROW(i.setOverwriteMode(true), std::runtime_error);
+    }
+
+    /* other extents are reused, other datatypes and constants replace the dataset */
+    {
+        Series o = Series::read("../samples/serial_overwrite.h5", AccessType::READ_WRITE);
+        o.setOverwriteMode(true);
+        MeshRecordComponent& rho = o.iterations[0].meshes["rho"][MeshRecordComponent::SCALAR];
+        rho.resetDataset(Dataset(Datatype::DOUBLE, {5, 100}));
+        rho.storeChunk({0, 0}, {5, 100}, field);
+        std::shared_ptr< float > charge(new float[4], [](float* d){ delete[] d; });
+        std::fill_n(charge.get(), 4, 2.f);
+        RecordComponent& q = o.iterations[0].particles["e"]["charge"][RecordComponent::SCALAR];
+        q.resetDataset(Dataset(Datatype::FLOAT, {4}));
+        q.storeChunk({0}, {4}, charge);
+        o.flush();
+    }
+    {
+        Series i = Series::read("../samples/serial_overwrite.h5");
+        MeshRecordComponent& rho = i.iterations[0].meshes["rho"][MeshRecordComponent::SCALAR];
+        BOOST_TEST(rho.getExtent() == Extent({5, 100}));
+        RecordComponent& q = i.iterations[0].particles["e"]["charge"][RecordComponent::SCALAR];
+        BOOST_TEST(q.getDatatype() == Datatype::FLOAT);
+        auto charge = q.loadChunk< float >({0}, {4});
+        i.flush();
+        BOOST_TEST(charge.get()[3] == 2.f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_attribute_storage_test)
+{
+    HDF5Options options;
+    options.attributeStorage.dense = true;
+    options.attributeStorage.trackCreationOrder = true;
+    {
+        Series o = Series::create("../samples/serial_dense_attributes.h5", options);
+        o.setAuthor("dense");
+        Mesh& E = o.iterations[1].meshes["E"];
+        for( int k = 0; k < 32; ++k )
+            E.setAttribute("custom" + std::to_string(k), k);
+        MeshRecordComponent& x = E["x"];
+        x.resetDataset(Dataset(Datatype::DOUBLE, {4}));
+        x.makeConstant(1.5);
+        o.flush();
+        /* attributes changed later are written again in one bulk write */
+        E.setAttribute("custom0", -1);
+        o.flush();
+    }
+    {
+        Series i = Series::read("../samples/serial_dense_attributes.h5");
+        BOOST_TEST(i.author() == "dense");
+        Mesh& E = i.iterations[1].meshes["E"];
+        BOOST_TEST(E.getAttribute("custom0").get< int >() == -1);
+        BOOST_TEST(E.getAttribute("custom31").get< int >() == 31);
+        BOOST_TEST(E["x"].getAttribute("value").get< double >() == 1.5);
+    }
+
+    options.attributeStorage = HDF5AttributeStorage();
+    options.attributeStorage.maxCompact = 4;
+    options.attributeStorage.minDense = 2;
+    {
+        Series o = Series::create("../samples/serial_phase_change.h5", options);
+        for( int k = 0; k < 8; ++k )
+            o.iterations[1].setAttribute("custom" + std::to_string(k), static_cast< double >(k));
+        o.flush();
+    }
+    Series i = Series::read("../samples/serial_phase_change.h5");
+    BOOST_TEST(i.iterations[1].getAttribute("custom7").get< double >() == 7.);
+
+    options.attributeStorage.minDense = 5;
+    BOOST_CHECK_THROW(Series::create("../samples/serial_invalid_phase_change.h5", options), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_patch_test)
+{
+    Series o = Series::create("../samples/serial_patch.h5");
+
+    o.iterations[1].particles["e"].particlePatches["offset"]["x"].setUnitSI(42);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_patch_load_test)
+{
+    {
+        Series o = Series::create("../samples/serial_patch_load.h5");
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+
+        std::shared_ptr< double > x(new double[10], [](double* d){ delete[] d; });
+        std::shared_ptr< uint64_t > id(new uint64_t[10], [](uint64_t* d){ delete[] d; });
+        for( int i = 0; i < 10; ++i )
+        {
+            x.get()[i] = i;
+            id.get()[i] = 100 + i;
+        }
+        e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {10}));
+        e["position"]["x"].storeChunk({0}, {10}, x);
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {10}));
+        e["positionOffset"]["x"].makeConstant(0.5);
+        e["id"][RecordComponent::SCALAR].resetDataset(Dataset(Datatype::UINT64, {10}));
+        e["id"][RecordComponent::SCALAR].storeChunk({0}, {10}, id);
+        o.flush();
+    }
+
+    Series o = Series::read("../samples/serial_patch_load.h5");
+    ParticleSpecies& e = o.iterations[1].particles["e"];
+    BOOST_TEST(e.particlePatches.numPatches() == 0);
+
+    /* the API does not write patches yet, so emulate three patches with x in [0, 3), [3, 7) and [7, 10) */
+    e.particlePatches.m_patchPositions = {PatchPosition(3, 0), PatchPosition(4, 3), PatchPosition(3, 7)};
+    e.particlePatches["offset"]["x"].m_values = {0., 3., 7.};
+    e.particlePatches["extent"]["x"].m_values = {3., 4., 3.};
+    BOOST_TEST(e.particlePatches.numPatches() == 3);
+    BOOST_TEST(e.particlePatches.position(1).numParticlesOffset == 3);
+    BOOST_CHECK_THROW(e.particlePatches.position(3), std::out_of_range);
+
+    auto patch = e.loadPatch< double >(1);
+    o.flush();
+    BOOST_TEST(patch.size() == 3);
+    for( int i = 0; i < 4; ++i )
+    {
+        BOOST_TEST(patch["position/x"].get()[i] == 3. + i);
+        BOOST_TEST(patch["positionOffset/x"].get()[i] == 0.5);
+        BOOST_TEST(patch["id"].get()[i] == 103. + i);
+    }
+
+    std::map< std::string, std::pair< double, double > > region{{"x", {2.5, 3.5}}};
+    BOOST_TEST((e.particlePatches.select(region) == std::vector< size_t >{0, 1}));
+    region = {{"x", {7., 100.}}};
+    BOOST_TEST((e.particlePatches.select(region) == std::vector< size_t >{2}));
+    region = {{"y", {0., 1.}}};
+    BOOST_CHECK_THROW(e.particlePatches.select(region), std::runtime_error);
+
+    region = {{"x", {2.5, 3.5}}};
+    auto ids = e.loadPatches< uint64_t >(region);
+    o.flush();
+    for( int i = 0; i < 7; ++i )
+        BOOST_TEST(ids["id"].get()[i] == static_cast< uint64_t >(100 + i));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_patch_write_test)
+{
+    {
+        Series o = Series::create("../samples/serial_patch_write.h5");
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+
+        std::shared_ptr< double > x(new double[5], [](double* d){ delete[] d; });
+        for( int i = 0; i < 5; ++i )
+            x.get()[i] = i;
+        e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {5}));
+        e["position"]["x"].storeChunk({0}, {5}, x);
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {5}));
+        e["positionOffset"]["x"].makeConstant(0.);
+
+        e.particlePatches.storePatch(1, 2, PatchPosition(3, 2), {{"x", {2., 5.}}});
+        e.particlePatches.storePatch(0, 2, PatchPosition(2, 0), {{"x", {0., 2.}}});
+        BOOST_CHECK_THROW(e.particlePatches.storePatch(2, 2, PatchPosition(0, 5)), std::runtime_error);
+        BOOST_CHECK_THROW(e.particlePatches.storePatch(0, 3, PatchPosition(2, 0)), std::runtime_error);
+        o.flush();
+    }
+
+    Series o = Series::read("../samples/serial_patch_write.h5");
+    ParticleSpecies& e = o.iterations[1].particles["e"];
+    BOOST_TEST(e.particlePatches.size() == 4);
+    BOOST_TEST(e.particlePatches.numPatches() == 2);
+    BOOST_TEST(e.particlePatches.position(1).numParticles == 3);
+    BOOST_TEST(e.particlePatches.position(1).numParticlesOffset == 2);
+    std::array< double, 7 > length{{1., 0., 0., 0., 0., 0., 0.}};
+    BOOST_TEST(e.particlePatches["offset"].unitDimension() == length);
+
+    std::map< std::string, std::pair< double, double > > region{{"x", {2.5, 3.}}};
+    BOOST_TEST((e.particlePatches.select(region) == std::vector< size_t >{1}));
+    auto patch = e.loadPatches< double >(region);
+    o.flush();
+    for( int i = 0; i < 3; ++i )
+        BOOST_TEST(patch["position/x"].get()[i] == 2. + i);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_deletion_test)
+{
+    Series o = Series::create("../samples/serial_deletion.h5");
+
+
+    o.setAttribute("removed",
+                   "this attribute will be removed after being written to disk");
+    o.flush();
+
+    o.deleteAttribute("removed");
+    o.flush();
+
+    ParticleSpecies& e = o.iterations[1].particles["e"];
+    e.erase("deletion");
+    o.flush();
+
+    e["deletion_scalar"][RecordComponent::SCALAR].resetDataset(Dataset(Datatype::DOUBLE, {1}));
+    o.flush();
+
+    e["deletion_scalar"].erase(RecordComponent::SCALAR);
+    o.flush();
+
+    e.erase("deletion_scalar");
+    o.flush();
+
+    double value = 0.;
+    e["deletion_scalar_constant"][RecordComponent::SCALAR].resetDataset(Dataset(Datatype::DOUBLE, {1}));
+    e["deletion_scalar_constant"][RecordComponent::SCALAR].makeConstant(value);
+    o.flush();
+
+    e["deletion_scalar_constant"].erase(RecordComponent::SCALAR);
+    o.flush();
+
+    e.erase("deletion_scalar_constant");
+    o.flush();
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_group_listing_test)
+{
+    auto handler = AbstractIOHandler::createIOHandler("../samples/", AccessType::CREATE, Format::HDF5);
+    Writable file, meshes, E, B, rho;
+    meshes.parent = &file;
+    E.parent = &meshes;
+    B.parent = &meshes;
+    rho.parent = &meshes;
+
+    Parameter< Operation::CREATE_FILE > createFile;
+    createFile.name = "serial_listing";
+    handler->enqueue(IOTask(&file, createFile));
+    Parameter< Operation::CREATE_PATH > createPath;
+    createPath.path = "meshes";
+    handler->enqueue(IOTask(&meshes, createPath));
+    createPath.path = "E";
+    handler->enqueue(IOTask(&E, createPath));
+    Parameter< Operation::CREATE_DATASET > createDataset;
+    createDataset.name = "rho";
+    createDataset.extent = {4};
+    createDataset.dtype = Datatype::DOUBLE;
+    createDataset.chunkSize = {4};
+    handler->enqueue(IOTask(&rho, createDataset));
+
+    auto list = [&]()
+    {
+        Parameter< Operation::LIST_PATHS > listPaths;
+        Parameter< Operation::LIST_DATASETS > listDatasets;
+        handler->enqueue(IOTask(&meshes, listPaths));
+        handler->enqueue(IOTask(&meshes, listDatasets));
+        handler->flush();
+        return std::make_pair(*listPaths.paths, *listDatasets.datasets);
+    };
+    using Listing = std::pair< std::vector< std::string >, std::vector< std::string > >;
+    BOOST_TEST((list() == Listing{{"E"}, {"rho"}}));
+    /* answered from the cached listing */
+    BOOST_TEST((list() == Listing{{"E"}, {"rho"}}));
+
+    createPath.path = "B";
+    handler->enqueue(IOTask(&B, createPath));
+    BOOST_TEST((list() == Listing{{"B", "E"}, {"rho"}}));
+
+    Parameter< Operation::DELETE_PATH > deletePath;
+    deletePath.path = ".";
+    handler->enqueue(IOTask(&E, deletePath));
+    Parameter< Operation::DELETE_DATASET > deleteDataset;
+    deleteDataset.name = ".";
+    handler->enqueue(IOTask(&rho, deleteDataset));
+    BOOST_TEST((list() == Listing{{"B"}, {}}));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_path_cache_test)
+{
+    auto handler = AbstractIOHandler::createIOHandler("../samples/", AccessType::CREATE, Format::HDF5);
+    Writable file, group, dataset;
+    group.parent = &file;
+    dataset.parent = &group;
+
+    Parameter< Operation::CREATE_FILE > createFile;
+    createFile.name = "serial_path_cache";
+    handler->enqueue(IOTask(&file, createFile));
+    Parameter< Operation::CREATE_PATH > createPath;
+    createPath.path = "a/b";
+    handler->enqueue(IOTask(&group, createPath));
+    Parameter< Operation::CREATE_DATASET > createDataset;
+    createDataset.name = "x";
+    createDataset.extent = {1};
+    createDataset.dtype = Datatype::DOUBLE;
+    createDataset.chunkSize = {1};
+    handler->enqueue(IOTask(&dataset, createDataset));
+    handler->flush();
+    BOOST_TEST(concrete_h5_file_position(&group) == "/a/b/");
+    BOOST_TEST(concrete_h5_file_position(&dataset) == "/a/b/x");
+
+    /* deleting the objects drops their resolved paths */
+    Parameter< Operation::DELETE_DATASET > deleteDataset;
+    deleteDataset.name = ".";
+    handler->enqueue(IOTask(&dataset, deleteDataset));
+    Parameter< Operation::DELETE_PATH > deletePath;
+    deletePath.path = ".";
+    handler->enqueue(IOTask(&group, deletePath));
+    handler->flush();
+    BOOST_TEST(!group.written);
+    BOOST_TEST(!dataset.written);
+    BOOST_TEST(concrete_h5_file_position(&group) == "/");
+
+    /* re-created under another name (i.e. renamed), the objects and their children resolve to the new path */
+    createPath.path = "c";
+    handler->enqueue(IOTask(&group, createPath));
+    handler->enqueue(IOTask(&dataset, createDataset));
+    Parameter< Operation::WRITE_DATASET > writeDataset;
+    writeDataset.offset = {0};
+    writeDataset.extent = {1};
+    writeDataset.dtype = Datatype::DOUBLE;
+    writeDataset.data = std::make_shared< double >(42.);
+    handler->enqueue(IOTask(&dataset, writeDataset));
+    handler->flush();
+    BOOST_TEST(concrete_h5_file_position(&group) == "/c/");
+    BOOST_TEST(concrete_h5_file_position(&dataset) == "/c/x");
+
+    Parameter< Operation::LIST_PATHS > listPaths;
+    handler->enqueue(IOTask(&file, listPaths));
+    Parameter< Operation::LIST_DATASETS > listDatasets;
+    handler->enqueue(IOTask(&group, listDatasets));
+    Parameter< Operation::READ_DATASET > readDataset;
+    readDataset.offset = {0};
+    readDataset.extent = {1};
+    readDataset.dtype = Datatype::DOUBLE;
+    double value = 0.;
+    readDataset.data = &value;
+    handler->enqueue(IOTask(&dataset, readDataset));
+    handler->flush();
+    BOOST_TEST((*listPaths.paths == std::vector< std::string >{"a", "c"}));
+    BOOST_TEST((*listDatasets.datasets == std::vector< std::string >{"x"}));
+    BOOST_TEST(value == 42.);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_record_components_test)
+{
+    {
+        Series o = Series::create("../samples/serial_record_components.h5");
+        Record& position = o.iterations[1].particles["e"]["position"];
+        for( auto const& c : {"x", "y", "z"} )
+            position[c].resetDataset(Dataset(Datatype::DOUBLE, {6}));
+
+        std::map< std::string, std::shared_ptr< double > > data;
+        for( auto const& c : {"x", "y", "z"} )
+        {
+            std::shared_ptr< double > chunk(new double[3], [](double* p){ delete[] p; });
+            for( int i = 0; i < 3; ++i )
+                chunk.get()[i] = 10. * (c[0] - 'x') + i;
+            data[c] = chunk;
+        }
+        position.storeComponents({0}, {3}, data);
+        position.storeComponents({3}, {3}, data);
+        BOOST_CHECK_THROW(position.storeComponents({4}, {3}, data), std::runtime_error);
+        std::map< std::string, std::shared_ptr< int > > wrongType{{"x", std::shared_ptr< int >(new int[3], [](int* p){ delete[] p; })}};
+        BOOST_CHECK_THROW(position.storeComponents({0}, {3}, wrongType), std::runtime_error);
+        o.flush();
+    }
+
+    {
+        Series i = Series::read("../samples/serial_record_components.h5");
+        Record& position = i.iterations[1].particles["e"]["position"];
+        auto all = position.loadComponents< double >({2}, {4});
+        auto some = position.loadComponents< float >({0}, {2}, {"z"});
+        i.flush();
+        BOOST_TEST(all.size() == 3);
+        BOOST_TEST(some.size() == 1);
+        for( auto const& c : {"x", "y", "z"} )
+        {
+            double base = 10. * (c[0] - 'x');
+            BOOST_TEST(all[c].get()[0] == base + 2);
+            BOOST_TEST(all[c].get()[1] == base);
+            BOOST_TEST(all[c].get()[3] == base + 2);
+        }
+        BOOST_TEST(some["z"].get()[1] == 21.f);
+        BOOST_CHECK_THROW(position.loadComponents< double >({4}, {4}), std::runtime_error);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_array_of_structs_test)
+{
+    struct Particle
+    {
+        double x;
+        double y;
+        int32_t id;
+    };
+    std::shared_ptr< Particle > particles(new Particle[8], [](Particle* p){ delete[] p; });
+    for( int i = 0; i < 8; ++i )
+        particles.get()[i] = Particle{1. * i, -1. * i, 100 + i};
+
+    {
+        Series o = Series::create("../samples/serial_array_of_structs.h5");
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {8}));
+        e["position"]["y"].resetDataset(Dataset(Datatype::DOUBLE, {8}));
+        e["id"][RecordComponent::SCALAR].resetDataset(Dataset(Datatype::INT32, {8}));
+        e["position"]["x"].storeChunk({0}, {8}, particles, &Particle::x);
+        /* consecutive chunks are merged into one write */
+        e["position"]["y"].storeChunk({0}, {4}, particles, &Particle::y);
+        std::shared_ptr< Particle > second(particles, particles.get() + 4);
+        e["position"]["y"].storeChunk({4}, {4}, second, &Particle::y);
+        e["id"][RecordComponent::SCALAR].setStatistics(true);
+        e["id"][RecordComponent::SCALAR].storeChunk({0}, {8}, particles, &Particle::id);
+        o.flush();
+    }
+
+    {
+        Series i = Series::read("../samples/serial_array_of_structs.h5");
+        ParticleSpecies& e = i.iterations[1].particles["e"];
+        auto x = e["position"]["x"].loadChunk< double >({0}, {8});
+        auto y = e["position"]["y"].loadChunk< double >({0}, {8});
+        auto id = e["id"][RecordComponent::SCALAR].loadChunk< int32_t >({0}, {8});
+        std::shared_ptr< Particle > read(new Particle[3](), [](Particle* p){ delete[] p; });
+        e["position"]["x"].loadChunk({2}, {3}, read, &Particle::x);
+        e["id"][RecordComponent::SCALAR].loadChunk({2}, {3}, read, &Particle::id);
+        i.flush();
+        for( int n = 0; n < 8; ++n )
+        {
+            BOOST_TEST(x.get()[n] == 1. * n);
+            BOOST_TEST(y.get()[n] == -1. * n);
+            BOOST_TEST(id.get()[n] == 100 + n);
+        }
+        for( int n = 0; n < 3; ++n )
+        {
+            BOOST_TEST(read.get()[n].x == 2. + n);
+            BOOST_TEST(read.get()[n].y == 0.);
+            BOOST_TEST(read.get()[n].id == 102 + n);
+        }
+        BOOST_TEST(e["id"][RecordComponent::SCALAR].getAttribute("maxValue").get< double >() == 107.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_guard_cells_test)
+{
+    /* two patches of 2x3 interior cells, each surrounded by one guard cell */
+    auto patch = [](double base)
+    {
+        std::shared_ptr< double > p(new double[4 * 5], [](double* d){ delete[] d; });
+        for( int i = 0; i < 4; ++i )
+            for( int j = 0; j < 5; ++j )
+                p.get()[i * 5 + j] = (i == 0 || i == 3 || j == 0 || j == 4) ? -1. : base + (i - 1) * 3 + (j - 1);
+        return p;
+    };
+
+    {
+        Series o = Series::create("../samples/serial_guard_cells.h5");
+        Mesh& E = o.iterations[1].meshes["E"];
+        E["x"].resetDataset(Dataset(Datatype::DOUBLE, {4, 3}));
+        E["y"].resetDataset(Dataset(Datatype::DOUBLE, {4, 3}));
+        E["x"].storeChunk({0, 0}, {2, 3}, patch(0.), {1, 1}, {4, 5});
+        E["x"].storeChunk({2, 0}, {2, 3}, patch(6.), {1, 1}, {4, 5});
+        BOOST_CHECK_THROW(E["x"].storeChunk({0, 0}, {2, 3}, patch(0.), {2, 3}, {4, 5}), std::runtime_error);
+        o.flush();
+
+        /* copied while staging */
+        o.setStagingBudget(1000, StagingMode::COPY);
+        E["y"].storeChunk({0, 0}, {4, 3}, patch(100.), {0, 1}, {4, 5});
+        o.flush();
+    }
+
+    {
+        Series i = Series::read("../samples/serial_guard_cells.h5");
+        Mesh& E = i.iterations[1].meshes["E"];
+        auto x = E["x"].loadChunk< double >({0, 0}, {4, 3});
+        auto y = E["y"].loadChunk< double >({0, 0}, {4, 3});
+        i.flush();
+        for( int n = 0; n < 12; ++n )
+            BOOST_TEST(x.get()[n] == 1. * n);
+        BOOST_TEST(y.get()[0] == -1.);
+        BOOST_TEST(y.get()[3] == 100.);
+        BOOST_TEST(y.get()[8] == 105.);
+        BOOST_TEST(y.get()[11] == -1.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_data_order_test)
+{
+    /* Fortran array A(4, 3, 2) */
+    std::shared_ptr< int > fortran(new int[24], [](int* p){ delete[] p; });
+    for( int i = 0; i < 24; ++i )
+        fortran.get()[i] = i;
+
+    {
+        Series o = Series::create("../samples/serial_data_order.h5");
+        Mesh& rho = o.iterations[1].meshes["rho"];
+        rho.setDataOrder(Mesh::DataOrder::C);
+        rho[RecordComponent::SCALAR].resetDataset(Dataset(Datatype::INT32, {2, 3, 4}));
+        rho.storeChunk(RecordComponent::SCALAR, {0, 0, 0}, {4, 3, 2}, fortran, Mesh::DataOrder::F);
+        o.flush();
+    }
+
+    {
+        Series i = Series::read("../samples/serial_data_order.h5");
+        Mesh& rho = i.iterations[1].meshes["rho"];
+        auto stored = rho[RecordComponent::SCALAR].loadChunk< int >({0, 0, 0}, {2, 3, 4});
+        std::shared_ptr< int > all(new int[24], [](int* p){ delete[] p; });
+        auto allDone = rho.loadChunk(RecordComponent::SCALAR, {0, 0, 0}, {4, 3, 2}, all, Mesh::DataOrder::F);
+        std::shared_ptr< double > part(new double[4], [](double* p){ delete[] p; });
+        auto partDone = rho.loadChunk(RecordComponent::SCALAR, {1, 1, 0}, {2, 2, 1}, part, Mesh::DataOrder::F);
+        i.flush();
+        allDone.get();
+        partDone.get();
+
+        /* A(k, j, i) is element (i, j, k) of the dataset */
+        for( int a = 0; a < 2; ++a )
+            for( int b = 0; b < 3; ++b )
+                for( int c = 0; c < 4; ++c )
+                    BOOST_TEST(stored.get()[(a * 3 + b) * 4 + c] == fortran.get()[(c * 3 + b) * 2 + a]);
+        for( int n = 0; n < 24; ++n )
+            BOOST_TEST(all.get()[n] == fortran.get()[n]);
+        BOOST_TEST(part.get()[0] == fortran.get()[(1 * 3 + 1) * 2 + 0]);
+        BOOST_TEST(part.get()[3] == fortran.get()[(2 * 3 + 2) * 2 + 0]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_checkpoint_test)
+{
+    std::shared_ptr< double > field(new double[12], [](double* p){ delete[] p; });
+    for( int i = 0; i < 12; ++i )
+        field.get()[i] = i;
+
+    for( std::string const name : {"../samples/serial_checkpoint.h5", "../samples/serial_checkpoint%T.h5"} )
+    {
+        {
+            Series o = Series::create(name);
+            o.setCheckpointMode(true);
+            Iteration& it = o.iterations[100];
+            Mesh& E = it.meshes["E"];
+            E.setGridSpacing(std::vector< double >{0.5, 0.5});
+            for( auto const& component : {"x", "y"} )
+            {
+                E[component].resetDataset(Dataset(Datatype::DOUBLE, {3, 4}));
+                E[component].storeChunk({0, 0}, {3, 4}, field);
+            }
+            MeshRecordComponent& rho = it.meshes["rho"][MeshRecordComponent::SCALAR];
+            rho.resetDataset(Dataset(Datatype::DOUBLE, {12}));
+            rho.storeChunk({0}, {12}, field);
+
+            ParticleSpecies& e = it.particles["e"];
+            e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {12}));
+            e["position"]["x"].storeChunk({0}, {12}, field);
+            e["positionOffset"]["x"].makeConstant(0.25);
+            e["charge"][RecordComponent::SCALAR].makeConstant(-1.);
+            e["weighting"][RecordComponent::SCALAR].resetDataset(Dataset(Datatype::DOUBLE, {12}));
+            e["weighting"][RecordComponent::SCALAR].storeChunk({0}, {12}, field);
+            o.flush();
+        }
+
+        {
+            Series r = Series::restart(name);
+            Iteration& it = r.iterations[100];
+            auto layout = it.getAttribute("checkpointLayout").get< std::vector< std::string > >();
+            BOOST_TEST(layout.size() == 7u);
+            BOOST_TEST(std::count(layout.begin(), layout.end(), "constant:particles/e/charge") == 1);
+
+            Mesh& E = it.meshes["E"];
+            BOOST_TEST(E.size() == 2u);
+            BOOST_TEST(E["y"].getExtent() == Extent({3, 4}));
+            /* attributes of records are not read on restart */
+            BOOST_TEST(E.gridSpacing< double >() == std::vector< double >{1});
+
+            /* the decomposition of the restart is known, so all chunks are loaded in one flush */
+            auto y = E["y"].loadChunk< double >({1, 0}, {2, 4});
+            auto rho = it.meshes["rho"][MeshRecordComponent::SCALAR].loadChunk< double >({4}, {2});
+            ParticleSpecies& e = it.particles["e"];
+            auto x = e["position"]["x"].loadChunk< double >({10}, {2});
+            auto w = e["weighting"][RecordComponent::SCALAR].loadChunk< double >({0}, {12});
+            r.flush();
+            BOOST_TEST(y.get()[0] == 4.);
+            BOOST_TEST(y.get()[7] == 11.);
+            BOOST_TEST(rho.get()[1] == 5.);
+            BOOST_TEST(x.get()[1] == 11.);
+            BOOST_TEST(w.get()[11] == 11.);
+            BOOST_TEST(e["charge"][RecordComponent::SCALAR].constant());
+            BOOST_TEST(e["positionOffset"]["x"].loadChunk< double >({0}, {1}).get()[0] == 0.25);
+        }
+
+        {
+            /* checkpoints remain valid openPMD files */
+            Series i = Series::read(name);
+            Mesh& E = i.iterations[100].meshes["E"];
+            BOOST_TEST(E.gridSpacing< double >() == std::vector< double >({0.5, 0.5}));
+            BOOST_TEST(i.iterations[100].particles["e"].size() == 4u);
+        }
+    }
+
+    BOOST_CHECK_THROW(Series::read("../samples/serial_checkpoint.h5").setCheckpointMode(true), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_110_optional_paths)
+{
+    try
+    {
+        {
+            Series s = Series::read("../samples/issue-sample/no_fields/data%T.h5");
+            auto attrs = s.attributes();
+            BOOST_TEST(std::count(attrs.begin(), attrs.end(), "meshesPath") == 1);
+            BOOST_TEST(std::count(attrs.begin(), attrs.end(), "particlesPath") == 1);
+            BOOST_TEST(s.iterations[400].meshes.size() == 0);
+            BOOST_TEST(s.iterations[400].particles.size() == 1);
+        }
+
+        {
+            Series s = Series::read("../samples/issue-sample/no_particles/data%T.h5");
+            auto attrs = s.attributes();
+            BOOST_TEST(std::count(attrs.begin(), attrs.end(), "meshesPath") == 1);
+            BOOST_TEST(std::count(attrs.begin(), attrs.end(), "particlesPath") == 1);
+            BOOST_TEST(s.iterations[400].meshes.size() == 2);
+            BOOST_TEST(s.iterations[400].particles.size() == 0);
+        }
+    } catch (no_such_file_error& e)
+    {
+        std::cerr << "issue sample not accessible. (" << e.what() << ")\n";
+    }
+
+    {
+        Series s = Series::create("../samples/no_meshes_1.1.0_compliant.h5");
+        s.iterations[1].particles["foo"];
+    }
+
+    {
+        Series s = Series::create("../samples/no_particles_1.1.0_compliant.h5");
+        s.iterations[1].meshes["foo"];
+    }
+
+    {
+        Series s = Series::read("../samples/no_meshes_1.1.0_compliant.h5");
+        auto attrs = s.attributes();
+        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "meshesPath") == 0);
+        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "particlesPath") == 1);
+        BOOST_TEST(s.iterations[1].meshes.size() == 0);
+        BOOST_TEST(s.iterations[1].particles.size() == 1);
+    }
+
+    {
+        Series s = Series::read("../samples/no_particles_1.1.0_compliant.h5");
+        auto attrs = s.attributes();
+        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "meshesPath") == 1);
+        BOOST_TEST(std::count(attrs.begin(), attrs.end(), "particlesPath") == 0);
+        BOOST_TEST(s.iterations[1].meshes.size() == 1);
+        BOOST_TEST(s.iterations[1].particles.size() == 0);
+    }
+}
+#else
+BOOST_AUTO_TEST_CASE(no_serial_hdf5)
+{
+    BOOST_TEST(true);
+}
+#endif
+#if defined(openPMD_HAVE_ADIOS1) && !defined(openPMD_HAVE_ADIOS2)
+BOOST_AUTO_TEST_CASE(adios_write_test)
+{
+    {
+        Series o = Series::create("../samples/serial_write.bp");
+
+        o.setAuthor("Serial ADIOS1");
+        o.iterations[1].setAttribute("flag", true);
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+
+        std::shared_ptr< double > position(new double[4], [](double* p){ delete[] p; });
+        for( uint64_t i = 0; i < 4; ++i )
+            position.get()[i] = static_cast< double >(i);
+        e["position"]["x"].resetDataset(Dataset(determineDatatype(position), {4}));
+        e["position"]["x"].storeChunk({0}, {2}, position);
+        e["position"]["x"].storeChunk({2}, {2}, std::shared_ptr< double >(position, position.get() + 2));
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_write.bp");
+    BOOST_TEST(i.author() == "Serial ADIOS1");
+    BOOST_TEST(i.iterations.size() == 1);
+    BOOST_TEST(i.iterations[1].getAttribute("flag").get< bool >() == true);
+    BOOST_TEST(i.iterations[1].particles["e"]["position"]["x"].getExtent() == Extent{4});
+
+    std::shared_ptr< float > position = i.iterations[1].particles["e"]["position"]["x"].loadChunk< float >({1}, {3});
+    i.flush();
+    for( uint64_t j = 0; j < 3; ++j )
+        BOOST_TEST(position.get()[j] == static_cast< float >(j + 1));
+}
+#else
+BOOST_AUTO_TEST_CASE(no_serial_adios1)
+{
+    BOOST_TEST(true);
+}
+#endif
+#if defined(openPMD_HAVE_ADIOS1)
+BOOST_AUTO_TEST_CASE(adios1_handler_test)
+{
+    /* .bp files select ADIOS2 if it is available, the ADIOS1 backend is used directly to test it in such builds as well */
+    {
+        auto handler = AbstractIOHandler::createIOHandler("../samples/", AccessType::CREATE, Format::ADIOS1);
+        Writable file, group, dataset;
+        group.parent = &file;
+        dataset.parent = &group;
+
+        Parameter< Operation::CREATE_FILE > createFile;
+        createFile.name = "serial_handler_adios1";
+        handler->enqueue(IOTask(&file, createFile));
+        Parameter< Operation::CREATE_PATH > createPath;
+        createPath.path = "data";
+        handler->enqueue(IOTask(&group, createPath));
+        Parameter< Operation::CREATE_DATASET > createDataset;
+        createDataset.name = "x";
+        createDataset.extent = {4};
+        createDataset.dtype = Datatype::DOUBLE;
+        handler->enqueue(IOTask(&dataset, createDataset));
+
+        /* the datatypes are restored independent of the attribute names */
+        Parameter< Operation::WRITE_ATT > writeAttribute;
+        writeAttribute.name = "dimension";
+        writeAttribute.resource = std::array< double, 7 >{{1., 0., -3., 0., 0., 0., 0.}};
+        writeAttribute.dtype = Datatype::ARR_DBL_7;
+        handler->enqueue(IOTask(&group, writeAttribute));
+        writeAttribute.name = "single";
+        writeAttribute.resource = std::vector< int32_t >{7};
+        writeAttribute.dtype = Datatype::VEC_INT32;
+        handler->enqueue(IOTask(&group, writeAttribute));
+        writeAttribute.name = "flag";
+        writeAttribute.resource = false;
+        writeAttribute.dtype = Datatype::BOOL;
+        handler->enqueue(IOTask(&group, writeAttribute));
+
+        /* both flushes write into the file opened by the first one */
+        Parameter< Operation::WRITE_DATASET > writeDataset;
+        writeDataset.offset = {0};
+        writeDataset.extent = {2};
+        writeDataset.dtype = Datatype::DOUBLE;
+        writeDataset.data = std::shared_ptr< double >(new double[2]{0., 1.}, [](double* p){ delete[] p; });
+        handler->enqueue(IOTask(&dataset, writeDataset));
+        handler->flush();
+
+        writeDataset.offset = {2};
+        writeDataset.data = std::shared_ptr< double >(new double[2]{2., 3.}, [](double* p){ delete[] p; });
+        handler->enqueue(IOTask(&dataset, writeDataset));
+        writeAttribute.resource = true;
+        handler->enqueue(IOTask(&group, writeAttribute));
+        handler->flush();
+
+        Parameter< Operation::CLOSE_FILE > closeFile;
+        handler->enqueue(IOTask(&file, closeFile));
+        handler->flush();
+    }
+
+    auto handler = AbstractIOHandler::createIOHandler("../samples/", AccessType::READ_ONLY, Format::ADIOS1);
+    Writable file, group, dataset;
+    group.parent = &file;
+    dataset.parent = &group;
+
+    Parameter< Operation::OPEN_FILE > openFile;
+    openFile.name = "serial_handler_adios1";
+    handler->enqueue(IOTask(&file, openFile));
+    Parameter< Operation::OPEN_PATH > openPath;
+    openPath.path = "data";
+    handler->enqueue(IOTask(&group, openPath));
+    Parameter< Operation::OPEN_DATASET > openDataset;
+    openDataset.name = "x";
+    handler->enqueue(IOTask(&dataset, openDataset));
+    Parameter< Operation::READ_ATT > readDimension;
+    readDimension.name = "dimension";
+    handler->enqueue(IOTask(&group, readDimension));
+    Parameter< Operation::READ_ATT > readSingle;
+    readSingle.name = "single";
+    handler->enqueue(IOTask(&group, readSingle));
+    Parameter< Operation::READ_ATT > readFlag;
+    readFlag.name = "flag";
+    handler->enqueue(IOTask(&group, readFlag));
+    Parameter< Operation::READ_DATASET > readDataset;
+    readDataset.offset = {1};
+    readDataset.extent = {3};
+    readDataset.dtype = Datatype::DOUBLE;
+    std::array< double, 3 > values{{0., 0., 0.}};
+    readDataset.data = values.data();
+    handler->enqueue(IOTask(&dataset, readDataset));
+    handler->flush();
+
+    BOOST_TEST(*openDataset.dtype == Datatype::DOUBLE);
+    BOOST_TEST((*openDataset.extent == Extent{4}));
+    BOOST_TEST(*readDimension.dtype == Datatype::ARR_DBL_7);
+    BOOST_TEST((Attribute(*readDimension.resource).get< std::array< double, 7 > >() == std::array< double, 7 >{{1., 0., -3., 0., 0., 0., 0.}}));
+    BOOST_TEST(*readSingle.dtype == Datatype::VEC_INT32);
+    BOOST_TEST((Attribute(*readSingle.resource).get< std::vector< int32_t > >() == std::vector< int32_t >{7}));
+    BOOST_TEST(*readFlag.dtype == Datatype::BOOL);
+    BOOST_TEST(Attribute(*readFlag.resource).get< bool >() == true);
+    BOOST_TEST((values == std::array< double, 3 >{{1., 2., 3.}}));
+}
+#endif
+#if defined(openPMD_HAVE_ADIOS2)
+BOOST_AUTO_TEST_CASE(adios2_write_test)
+{
+    {
+        Series o = Series::create("../samples/serial_write_adios2.bp");
+
+        o.setAuthor("Serial ADIOS2");
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+
+        std::shared_ptr< double > position(new double[4], [](double* p){ delete[] p; });
+        std::shared_ptr< uint64_t > positionOffset(new uint64_t[4], [](uint64_t* p){ delete[] p; });
+        for( uint64_t i = 0; i < 4; ++i )
+        {
+            position.get()[i] = static_cast< double >(i);
+            positionOffset.get()[i] = i;
+        }
+        e["position"]["x"].resetDataset(Dataset(determineDatatype(position), {4}));
+        e["positionOffset"]["x"].resetDataset(Dataset(determineDatatype(positionOffset), {4}));
+
+        /* two chunks per record component, all written by a single PerformPuts */
+        e["position"]["x"].storeChunk({0}, {2}, position);
+        e["position"]["x"].storeChunk({2}, {2}, std::shared_ptr< double >(position, position.get() + 2));
+        e["positionOffset"]["x"].storeChunk({0}, {4}, positionOffset);
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_write_adios2.bp");
+    BOOST_TEST(i.author() == "Serial ADIOS2");
+    BOOST_TEST(i.iterations.size() == 1);
+    BOOST_TEST(i.iterations.count(1) == 1);
+
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+    BOOST_TEST(e.count("position") == 1);
+    BOOST_TEST(e.count("positionOffset") == 1);
+    BOOST_TEST(e["position"]["x"].getExtent() == Extent{4});
+
+    std::shared_ptr< double > position = e["position"]["x"].loadChunk< double >({0}, {4});
+    std::shared_ptr< float > positionOffset = e["positionOffset"]["x"].loadChunk< float >({0}, {4});
+    i.flush();
+    for( uint64_t j = 0; j < 4; ++j )
+    {
+        BOOST_TEST(position.get()[j] == static_cast< double >(j));
+        BOOST_TEST(positionOffset.get()[j] == static_cast< float >(j));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(adios2_attribute_types_test)
+{
+    {
+        Series o = Series::create("../samples/serial_attribute_types_adios2.bp");
+        Iteration& it = o.iterations[1];
+        it.setAttribute("flag", true);
+        it.setAttribute("single", 1.5);
+        it.setAttribute("vectorOfOne", std::vector< double >{1.5});
+        it.setAttribute("stringsOfOne", std::vector< std::string >{"one"});
+        /* only the datatype decides, not the name */
+        it.setAttribute("unitDimension", std::vector< double >(7, 1.));
+        it.meshes["E"].setUnitDimension({{UnitDimension::L, 1.}, {UnitDimension::T, -1.}});
+        MeshRecordComponent& x = it.meshes["E"]["x"];
+        x.resetDataset(Dataset(Datatype::DOUBLE, {1}));
+        x.makeConstant(0.);
+        o.flush();
+    }
+
+    Series i = Series::read("../samples/serial_attribute_types_adios2.bp");
+    Iteration& it = i.iterations[1];
+    BOOST_TEST(it.getAttribute("flag").dtype == Datatype::BOOL);
+    BOOST_TEST(it.getAttribute("flag").get< bool >() == true);
+    BOOST_TEST(it.getAttribute("single").dtype == Datatype::DOUBLE);
+    BOOST_TEST(it.getAttribute("vectorOfOne").dtype == Datatype::VEC_DOUBLE);
+    BOOST_TEST((it.getAttribute("vectorOfOne").get< std::vector< double > >() == std::vector< double >{1.5}));
+    BOOST_TEST(it.getAttribute("stringsOfOne").dtype == Datatype::VEC_STRING);
+    BOOST_TEST(it.getAttribute("unitDimension").dtype == Datatype::VEC_DOUBLE);
+    BOOST_TEST(it.meshes["E"].getAttribute("unitDimension").dtype == Datatype::ARR_DBL_7);
+    BOOST_TEST(it.meshes["E"].unitDimension()[static_cast< uint8_t >(UnitDimension::T)] == -1.);
+}
+
+BOOST_AUTO_TEST_CASE(adios2_close_iteration_test)
+{
+    Series o = Series::create("../samples/serial_close_adios2_%T.bp");
+    for( uint64_t j : {1, 2} )
+    {
+        RecordComponent& x = o.iterations[j].particles["e"]["position"]["x"];
+        x.resetDataset(Dataset(Datatype::DOUBLE, {2}));
+        x.storeChunk({0}, {2}, std::shared_ptr< double >(new double[2]{double(j), double(j)}, [](double* p){ delete[] p; }));
+        o.flush();
+        o.iterations[j].close();
+
+        /* the engine has been closed, so the file is complete while the Series is still open */
+        Series i = Series::read("../samples/serial_close_adios2_" + std::to_string(j) + ".bp");
+        std::shared_ptr< double > data = i.iterations[j].particles["e"]["position"]["x"].loadChunk< double >({0}, {2});
+        i.flush();
+        BOOST_TEST(data.get()[0] == static_cast< double >(j));
+        BOOST_TEST(data.get()[1] == static_cast< double >(j));
+    }
+}
+#else
+BOOST_AUTO_TEST_CASE(no_serial_adios2)
 {
     BOOST_TEST(true);
 }
@@ -0,0 +1,81 @@
+"""
+Tests of the Python bindings of openPMD-api, run from the build directory
+with the module in PYTHONPATH.
+"""
+import sys
+import unittest
+
+import numpy as np
+
+import openPMD
+
+
+class APITest(unittest.TestCase):
+
+    def testStoreLoadWithoutCopy(self):
+        series = openPMD.Series.create("../samples/python_serial.h5")
+        series.author = "openPMD-api"
+        it = series.iterations[1]
+        it.time = 2.5
+
+        data = np.arange(24, dtype=np.float64).reshape(4, 6)
+        rho = it.meshes["rho"][openPMD.Record_Component.SCALAR]
+        rho.reset_dataset(openPMD.Dataset(data.dtype, data.shape))
+        rho.store_chunk(data)
+
+        x = it.particles["e"]["position"]["x"]
+        x.reset_dataset(openPMD.Dataset(np.dtype("int32"), [10]))
+        x.store_chunk(np.arange(5, dtype=np.int32), [5])
+        x.store_chunk(np.arange(5, dtype=np.int32), [0])
+
+        # strided views would have to be copied first
+        with self.assertRaises(RuntimeError):
+            rho.store_chunk(data[:, ::2])
+        series.flush()
+        del series
+
+        series = openPMD.Series.read("../samples/python_serial.h5")
+        self.assertEqual(series.author, "openPMD-api")
+        it = series.iterations[1]
+        self.assertEqual(it.time, 2.5)
+        rho = it.meshes["rho"][openPMD.Record_Component.SCALAR]
+        self.assertEqual(rho.shape, [4, 6])
+        self.assertEqual(rho.dtype, np.dtype("float64"))
+
+        full = rho.load_chunk()
+        block = rho.load_chunk([1, 2], [2, 3])
+        strided = rho[::2, 1::2]
+        row = rho[3]
+        x = it.particles["e"]["position"]["x"].load_chunk()
+        series.flush()
+
+        np.testing.assert_array_equal(full, data)
+        np.testing.assert_array_equal(block, data[1:3, 2:5])
+        np.testing.assert_array_equal(strided, data[::2, 1::2])
+        np.testing.assert_array_equal(row, data[3])
+        np.testing.assert_array_equal(x, np.concatenate([np.arange(5)] * 2))
+
+        # loaded arrays wrap the buffers of the library
+        self.assertFalse(full.flags.owndata)
+        self.assertIn("rho", it.meshes)
+        self.assertEqual(list(it.particles["e"]), ["position"])
+
+    def testStoredArrayReleasedByFlush(self):
+        series = openPMD.Series.create("../samples/python_release.h5")
+        data = np.arange(8, dtype=np.float64)
+        references = sys.getrefcount(data)
+
+        rho = series.iterations[1].meshes["rho"][
+            openPMD.Record_Component.SCALAR]
+        rho.reset_dataset(openPMD.Dataset(data.dtype, data.shape))
+        rho.store_chunk(data)
+        self.assertGreater(sys.getrefcount(data), references)
+
+        # the reference held for the write is dropped once it is done
+        series.flush()
+        self.assertEqual(sys.getrefcount(data), references)
+        del series
+
+
+if __name__ == '__main__':
+    unittest.main()